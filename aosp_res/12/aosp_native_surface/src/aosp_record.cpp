@@ -47,6 +47,7 @@
 #include <gui/ISurfaceComposer.h>
 #include <media/MediaCodecBuffer.h>
 #include <media/NdkMediaCodec.h>
+#include <media/NdkImageReader.h>
 #include <media/NdkMediaFormatPriv.h>
 #include <media/openmax/OMX_IVCommon.h>
 #include <media/stagefright/MediaCodec.h>
@@ -59,6 +60,8 @@
 #include <ui/DisplayMode.h>
 #include <ui/DisplayState.h>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "aosp_record.h"
 
 using android::ABuffer;
@@ -114,6 +117,7 @@ static uint32_t gVideoHeight = 0;
 static uint32_t gBitRate = 20000000;     // 20Mbps
 static float gfps = 60;                  // fps
 static uint32_t gBframes = 0;
+static RecordConfig gRecordConfig;   // 裁剪/缩放/跳帧
 static PhysicalDisplayId gPhysicalDisplayId;
 // Set by signal handler to stop recording.
 // static volatile bool gStopRequested = false;
@@ -199,7 +203,12 @@ status_t prepareEncoder(float displayFps, sp <MediaCodec> *pCodec,
     // 录制码率
     format->setInt32(KEY_BIT_RATE, gBitRate);
     // 录制帧率
-    format->setFloat(KEY_FRAME_RATE, displayFps);
+    // 跳帧: 编码器按 fps / frameSkip 丢弃多余的输入帧(max-fps-to-encoder，安卓10开始支持)
+    float encodeFps = displayFps / (float) gRecordConfig.frameSkip;
+    format->setFloat(KEY_FRAME_RATE, encodeFps);
+    if (gRecordConfig.frameSkip > 1) {
+        format->setFloat("max-fps-to-encoder", encodeFps);
+    }
 
     // 关键帧间隔时间，单位秒
     format->setInt32(KEY_I_FRAME_INTERVAL, 10);
@@ -280,57 +289,31 @@ static status_t setDisplayProjection(
         SurfaceComposerClient::Transaction &t,
         const sp <IBinder> &dpy,
         const ui::DisplayState &displayState) {
-    // Set the region of the layer stack we're interested in, which in our case is "all of it".
-    Rect layerStackRect(displayState.layerStackSpaceRect);
-
-    // We need to preserve the aspect ratio of the display.
-    float displayAspect = layerStackRect.getHeight() / static_cast<float>(layerStackRect.getWidth());
-
-
-    // Set the way we map the output onto the display surface (which will
-    // be e.g. 1280x720 for a 720p video).  The rect is interpreted
-    // post-rotation, so if the display is rotated 90 degrees we need to
-    // "pre-rotate" it by flipping width/height, so that the orientation
-    // adjustment changes it back.
-    //
-    // We might want to encode a portrait display as landscape to use more
-    // of the screen real estate.  (If players respect a 90-degree rotation
-    // hint, we can essentially get a 720x1280 video instead of 1280x720.)
-    // In that case, we swap the configured video width/height and then
-    // supply a rotation value to the display projection.
-    uint32_t videoWidth, videoHeight;
-    uint32_t outWidth, outHeight;
-    if (!gRotate) {
-        videoWidth = gVideoWidth;
-        videoHeight = gVideoHeight;
-    } else {
-        videoWidth = gVideoHeight;
-        videoHeight = gVideoWidth;
-    }
-    if (videoHeight > (uint32_t) (videoWidth * displayAspect)) {
-        // limited by narrow width; reduce height
-        outWidth = videoWidth;
-        outHeight = (uint32_t) (videoWidth * displayAspect);
-    } else {
-        // limited by short height; restrict width
-        outHeight = videoHeight;
-        outWidth = (uint32_t) (videoHeight / displayAspect);
+    // 屏幕区域(layer stack 坐标)
+    const ui::Size &layerStackSpaceRect = displayState.layerStackSpaceRect;
+    uint32_t layerStackWidth = layerStackSpaceRect.getWidth(), layerStackHeight = layerStackSpaceRect.getHeight();
+
+    // 采集区域(默认整个屏幕)以及它在输出画面中的位置，输出大小已经在 recordScreen 中确定
+    // 裁剪和缩放都由合成器完成，计算见 record_config.h
+    RecordConfig config = gRecordConfig;
+    config.videoWidth = gVideoWidth;
+    config.videoHeight = gVideoHeight;
+    RecordProjection projection;
+    if (!computeRecordProjection(config, layerStackWidth, layerStackHeight, gRotate, &projection)) {
+        fprintf(stderr, "ERROR: crop %d,%d %dx%d outside display %ux%u\n", config.cropX, config.cropY,
+                config.cropWidth, config.cropHeight, layerStackWidth, layerStackHeight);
+        return UNKNOWN_ERROR;
     }
-    uint32_t offX, offY;
-    offX = (videoWidth - outWidth) / 2;
-    offY = (videoHeight - outHeight) / 2;
-    Rect displayRect(offX, offY, offX + outWidth, offY + outHeight);
+    Rect layerStackRect(projection.layerStackRect.left, projection.layerStackRect.top,
+                        projection.layerStackRect.right, projection.layerStackRect.bottom);
+    Rect displayRect(projection.displayRect.left, projection.displayRect.top,
+                     projection.displayRect.right, projection.displayRect.bottom);
 
     if (gVerbose) {
-        if (gRotate) {
-            printf("Rotated content area is %ux%u at offset x=%d y=%d\n",
-                   outHeight, outWidth, offY, offX);
-            fflush(stdout);
-        } else {
-            printf("Content area is %ux%u at offset x=%d y=%d\n",
-                   outWidth, outHeight, offX, offY);
-            fflush(stdout);
-        }
+        printf("Content area is %dx%d at offset x=%d y=%d (crop %dx%d at %d,%d)\n",
+               displayRect.getWidth(), displayRect.getHeight(), displayRect.left, displayRect.top,
+               layerStackRect.getWidth(), layerStackRect.getHeight(), layerStackRect.left, layerStackRect.top);
+        fflush(stdout);
     }
 
     t.setDisplayProjection(dpy,
@@ -617,13 +600,16 @@ static status_t recordScreen() {
         fflush(stdout);
     }
 
-    // 编码器无法将奇数作为配置 
-    if (gVideoWidth == 0) {
-        gVideoWidth = floorToEven(layerStackSpaceRect.getWidth());
-    }
-    if (gVideoHeight == 0) {
-        gVideoHeight = floorToEven(layerStackSpaceRect.getHeight());
+    // 输出大小: 指定了就用指定的，否则为采集区域 * scale (编码器无法将奇数作为配置)
+    RecordProjection projection;
+    if (!computeRecordProjection(gRecordConfig, layerStackSpaceRect.getWidth(), layerStackSpaceRect.getHeight(),
+                                 gRotate, &projection)) {
+        fprintf(stderr, "ERROR: crop %d,%d %dx%d outside display\n", gRecordConfig.cropX, gRecordConfig.cropY,
+                gRecordConfig.cropWidth, gRecordConfig.cropHeight);
+        return UNKNOWN_ERROR;
     }
+    gVideoWidth = projection.videoWidth;
+    gVideoHeight = projection.videoHeight;
 
     // 配置并启动编码器。
     err = prepareEncoder(gfps, &encoder, &bufferProducer);
@@ -652,6 +638,206 @@ static status_t recordScreen() {
     return err;
 }
 
+/*
+ * 原始帧采集: 虚拟屏幕直接输出到 AImageReader(BufferQueue 的消费端)，不经过编码器，
+ * 调用方拿到的是 AHardwareBuffer 支撑的 RGBA/YUV 帧，读取时不做拷贝
+ *
+ * 和录屏共用投影参数(gVideoWidth/gVideoHeight/gRotate)，两者不能同时运行；
+ * 屏幕旋转后需要 stop 再重新 init
+ */
+static AImageReader *gRawReader = nullptr;
+static sp <IBinder> gRawDpy;
+static sp <ANativeWindow> gRawWindow;
+static std::mutex gRawMutex;
+static std::condition_variable gRawCond;
+static uint64_t gRawAvailable = 0;      // 消费端收到的帧数
+static bool gRawStopped = true;
+static int gRawInFlight = 0;            // 正在 AImageReader_acquireLatestImage 的线程数，stop 等它归零才删除 reader
+static int gRawAcquired = 0;            // 调用方还没 release 的帧，AImageReader_delete 会释放它们的 AImage，stop 等它归零
+static const int RAW_RELEASE_WAIT_MS = 1000;
+
+static void onRawImageAvailable(void *, AImageReader *) {
+    {
+        std::lock_guard<std::mutex> lock(gRawMutex);
+        gRawAvailable++;
+    }
+    gRawCond.notify_all();
+}
+
+bool initScreenCapture(uint32_t width, uint32_t height, int32_t format, int32_t maxImages) {
+    if (gRawReader != nullptr) {
+        fprintf(stderr, "ERROR: raw capture already running\n");
+        return false;
+    }
+    // 启动线程池,虚拟屏幕和 BufferQueue 的回调来自 surfaceflinger
+    sp <ProcessState> self = ProcessState::self();
+    self->startThreadPool();
+
+    std::optional<PhysicalDisplayId> displayId = SurfaceComposerClient::getInternalDisplayId();
+    if (!displayId) {
+        fprintf(stderr, "Failed to get token for internal display\n");
+        return false;
+    }
+    sp <IBinder> rawDisplay = SurfaceComposerClient::getPhysicalDisplayToken(*displayId);
+    if (rawDisplay == nullptr) {
+        fprintf(stderr, "ERROR: no display\n");
+        return false;
+    }
+    ui::DisplayState displayState;
+    if (SurfaceComposerClient::getDisplayState(rawDisplay, &displayState) != NO_ERROR) {
+        fprintf(stderr, "ERROR: unable to get display state\n");
+        return false;
+    }
+    uint32_t displayWidth = displayState.layerStackSpaceRect.getWidth();
+    uint32_t displayHeight = displayState.layerStackSpaceRect.getHeight();
+
+    // 原始帧采集总是投影整个屏幕
+    gRecordConfig = RecordConfig();
+    gVideoWidth = width != 0 ? width : floorToEven(displayWidth);
+    gVideoHeight = height != 0 ? height : floorToEven(displayHeight);
+    gRotate = false;
+
+    // CPU 读取用于分析，GPU 采样用于直接作为纹理显示
+    media_status_t status = AImageReader_newWithUsage(
+            (int32_t) gVideoWidth, (int32_t) gVideoHeight, format,
+            AHARDWAREBUFFER_USAGE_CPU_READ_OFTEN | AHARDWAREBUFFER_USAGE_GPU_SAMPLED_IMAGE,
+            maxImages, &gRawReader);
+    if (status != AMEDIA_OK) {
+        fprintf(stderr, "ERROR: unable to create image reader %ux%u format 0x%x (%d)\n",
+                gVideoWidth, gVideoHeight, format, status);
+        gRawReader = nullptr;
+        return false;
+    }
+    AImageReader_ImageListener listener{nullptr, onRawImageAvailable};
+    AImageReader_setImageListener(gRawReader, &listener);
+
+    ANativeWindow *readerWindow = nullptr;
+    if (AImageReader_getWindow(gRawReader, &readerWindow) != AMEDIA_OK || readerWindow == nullptr) {
+        fprintf(stderr, "ERROR: unable to get image reader window\n");
+        AImageReader_delete(gRawReader);
+        gRawReader = nullptr;
+        return false;
+    }
+    // AImageReader 的窗口就是一个 Surface，取出它的生产端交给虚拟屏幕
+    sp <IGraphicBufferProducer> producer = static_cast<Surface *>(readerWindow)->getIGraphicBufferProducer();
+    {
+        std::lock_guard<std::mutex> lock(gRawMutex);
+        gRawAvailable = 0;
+        gRawStopped = false;
+    }
+    status_t err = prepareVirtualDisplay(displayState, producer, &gRawDpy, &gRawWindow);
+    if (err != NO_ERROR) {
+        stopScreenCapture();
+        return false;
+    }
+    return true;
+}
+
+bool acquireScreenFrame(RawFrame *frame, int32_t timeoutMs) {
+    if (frame == nullptr) {
+        return false;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    AImage *image = nullptr;
+    for (;;) {
+        uint64_t seen;
+        AImageReader *reader;
+        {
+            std::lock_guard<std::mutex> lock(gRawMutex);
+            if (gRawStopped || gRawReader == nullptr) {
+                return false;
+            }
+            seen = gRawAvailable;
+            reader = gRawReader;
+            gRawInFlight++;
+        }
+        // 只取最新的一帧，积压的旧帧直接还给生产端
+        media_status_t status = AImageReader_acquireLatestImage(reader, &image);
+        std::unique_lock<std::mutex> lock(gRawMutex);
+        if (--gRawInFlight == 0 && gRawStopped) {
+            gRawCond.notify_all();
+        }
+        if (status == AMEDIA_OK) {
+            gRawAcquired++;
+            break;
+        }
+        if (status != AMEDIA_IMGREADER_NO_BUFFER_AVAILABLE) {
+            // AMEDIA_IMGREADER_MAX_IMAGES_ACQUIRED: 调用方持有的帧已经达到 maxImages
+            return false;
+        }
+        if (!gRawCond.wait_until(lock, deadline, [seen] { return gRawStopped || gRawAvailable != seen; })) {
+            return false;
+        }
+    }
+
+    memset(frame, 0, sizeof(RawFrame));
+    AImage_getHardwareBuffer(image, &frame->buffer);
+    AImage_getNumberOfPlanes(image, &frame->planeCount);
+    if (frame->planeCount > 3) {
+        frame->planeCount = 3;
+    }
+    for (int32_t i = 0; i < frame->planeCount; i++) {
+        int length = 0;
+        AImage_getPlaneData(image, i, &frame->planes[i], &length);
+        AImage_getPlaneRowStride(image, i, &frame->rowStride[i]);
+        AImage_getPlanePixelStride(image, i, &frame->pixelStride[i]);
+    }
+    int32_t imageWidth = 0, imageHeight = 0;
+    AImage_getWidth(image, &imageWidth);
+    AImage_getHeight(image, &imageHeight);
+    frame->width = (uint32_t) imageWidth;
+    frame->height = (uint32_t) imageHeight;
+    AImage_getFormat(image, &frame->format);
+    AImage_getTimestamp(image, &frame->timestampNs);
+    frame->image = image;
+    return true;
+}
+
+void releaseScreenFrame(RawFrame *frame) {
+    if (frame == nullptr || frame->image == nullptr) {
+        return;
+    }
+    AImage_delete(static_cast<AImage *>(frame->image));
+    frame->image = nullptr;
+    frame->buffer = nullptr;
+    std::lock_guard<std::mutex> lock(gRawMutex);
+    if (--gRawAcquired == 0 && gRawStopped) {
+        gRawCond.notify_all();
+    }
+}
+
+void stopScreenCapture() {
+    {
+        std::unique_lock<std::mutex> lock(gRawMutex);
+        gRawStopped = true;
+        gRawCond.notify_all();
+        // 其他线程可能还在 acquireLatestImage 里使用 reader，等它们返回后再删除
+        gRawCond.wait(lock, [] { return gRawInFlight == 0; });
+    }
+    if (gRawDpy != nullptr) {
+        SurfaceComposerClient::destroyDisplay(gRawDpy);
+        gRawDpy.clear();
+    }
+    gRawWindow.clear();
+    if (gRawReader != nullptr) {
+        // 调用方还持有的帧在 release 时会 AImage_delete，reader 要活到它们全部释放
+        int acquired;
+        {
+            std::unique_lock<std::mutex> lock(gRawMutex);
+            gRawCond.wait_for(lock, std::chrono::milliseconds(RAW_RELEASE_WAIT_MS), [] { return gRawAcquired == 0; });
+            acquired = gRawAcquired;
+        }
+        // 删除时会停掉回调线程，不能持有 onRawImageAvailable 要用的锁
+        if (acquired == 0) {
+            AImageReader_delete(gRawReader);
+        } else {
+            // 超时不删除 reader(泄漏)，之后的 release 仍然有效
+            fprintf(stderr, "ERROR: %d raw frames still acquired, image reader not deleted\n", acquired);
+        }
+        gRawReader = nullptr;
+    }
+}
+
 /*
  * Accepts a string with a bare number ("4000000") or with a single-character
  * unit ("4m").
@@ -691,7 +877,7 @@ ANativeWindow *getRecordWindow() {
 /*
  * Parses args and kicks things off.
  */
-int initScreenrecord(const char *bitRate, float fps, uint32_t videoWidth, uint32_t videoHeight) {
+int initScreenrecordConfig(const RecordConfig *config) {
     std::cout << "screenrecord" << std::endl;
     std::optional<PhysicalDisplayId> displayId = SurfaceComposerClient::getInternalDisplayId();
     if (!displayId) {
@@ -702,14 +888,14 @@ int initScreenrecord(const char *bitRate, float fps, uint32_t videoWidth, uint32
     gPhysicalDisplayId = *displayId;
 
     gVerbose = false;
-    gfps = fps;
+    gfps = config->fps;
     // 视频大小
-    gVideoWidth = videoWidth;
-    gVideoHeight = videoHeight;
+    gVideoWidth = config->videoWidth;
+    gVideoHeight = config->videoHeight;
     gSizeSpecified = false;
 
     // 码率
-    if (parseValueWithUnit(bitRate, &gBitRate) != NO_ERROR) {
+    if (parseValueWithUnit(config->bitRate, &gBitRate) != NO_ERROR) {
         return 2;
     }
 
@@ -729,7 +915,22 @@ int initScreenrecord(const char *bitRate, float fps, uint32_t videoWidth, uint32
                 gBitRate, kMinBitRate, kMaxBitRate);
         return 2;
     }
+    if (config->fps <= 0 || config->frameSkip == 0 || config->scale < 0) {
+        fprintf(stderr, "Invalid record config: fps %.2f frameSkip %u scale %.2f\n",
+                config->fps, config->frameSkip, config->scale);
+        return 2;
+    }
+    gRecordConfig = *config;
     status_t err = recordScreen();
     ALOGD(err == NO_ERROR ? "success" : "failed");
     return (int) err;
 }
+
+int initScreenrecord(const char *bitRate, float fps, uint32_t videoWidth, uint32_t videoHeight) {
+    RecordConfig config;
+    config.bitRate = bitRate;
+    config.fps = fps;
+    config.videoWidth = videoWidth;
+    config.videoHeight = videoHeight;
+    return initScreenrecordConfig(&config);
+}
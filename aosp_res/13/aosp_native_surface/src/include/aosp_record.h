@@ -17,13 +17,39 @@
 #ifndef SCREENRECORD_SCREENRECORD_H
 #define SCREENRECORD_SCREENRECORD_H
 #include <utils/Errors.h>
+#include <android/hardware_buffer.h>
+#include "record_config.h"
 
 #define kVersionMajor 1
 #define kVersionMinor 3
 
 using android::status_t;
 int initScreenrecord(const char* bitRate,float fps,uint32_t videoWidth, uint32_t videoHeight);
+int initScreenrecordConfig(const RecordConfig *config);
 void stopScreenrecord();
 ANativeWindow *getRecordWindow();
 status_t runEncoder(bool *runFlag,void callback(uint8_t*,size_t));
+
+/*
+ * 原始帧，字段含义和 AImage 一致，format 取 AIMAGE_FORMAT_RGBA_8888 或 AIMAGE_FORMAT_YUV_420_888
+ * image 是内部的 AImage，releaseScreenFrame 后所有指针失效
+ */
+struct RawFrame {
+    AHardwareBuffer *buffer;
+    uint8_t *planes[3];
+    int32_t rowStride[3];
+    int32_t pixelStride[3];
+    int32_t planeCount;
+    uint32_t width;
+    uint32_t height;
+    int32_t format;
+    int64_t timestampNs;
+    void *image;
+};
+
+bool initScreenCapture(uint32_t width, uint32_t height, int32_t format, int32_t maxImages);
+bool acquireScreenFrame(RawFrame *frame, int32_t timeoutMs);
+void releaseScreenFrame(RawFrame *frame);
+// 其他线程还持有的帧最多等1秒释放，超时则不删除 AImageReader(泄漏)，之后的 releaseScreenFrame 仍然有效
+void stopScreenCapture();
 #endif /*SCREENRECORD_SCREENRECORD_H*/
@@ -22,6 +22,13 @@ void setSurfaceWH(uint32_t width, uint32_t height);
 MDisplayInfo getDisplayInfo();
 void initRecord(const char* bitRate,float fps,
 uint32_t videoWidth, uint32_t videoHeight);
+struct RecordConfig;
+bool initRecordConfig(const RecordConfig *config);
 void stopRecord();
 NativeWindowType getRecordNativeWindow();
-void runRecord(bool *runFlag,void callback(uint8_t*,size_t));
\ No newline at end of file
+void runRecord(bool *runFlag,void callback(uint8_t*,size_t));
+struct RawFrame;
+bool initRawCapture(uint32_t width, uint32_t height, int32_t format, int32_t maxImages);
+bool acquireRawFrame(RawFrame *frame, int32_t timeoutMs);
+void releaseRawFrame(RawFrame *frame);
+void stopRawCapture();
\ No newline at end of file
@@ -0,0 +1,106 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RECORD_CONFIG_H
+#define NATIVESURFACE_RECORD_CONFIG_H
+
+#include <cstdint>
+#include <cmath>
+
+/**
+ * 录屏参数(和 aosp_res 库里的 record_config.h 一致，不能改动布局)
+ * 裁剪和缩放都在虚拟屏幕的投影里完成，由合成器(GPU)处理，编码器和分析只处理输出大小的画面
+ */
+struct RecordConfig {
+    const char *bitRate = "20m";    // 码率 <= 200M，支持 "4000000" 或 "4m"
+    float fps = 60;
+    uint32_t videoWidth = 0;        // 输出宽度，设置0为采集区域宽度 * scale
+    uint32_t videoHeight = 0;       // 输出高度，设置0为采集区域高度 * scale
+    int32_t cropX = 0;              // 采集区域(屏幕坐标)，宽高设置0表示到屏幕边缘
+    int32_t cropY = 0;
+    int32_t cropWidth = 0;
+    int32_t cropHeight = 0;
+    float scale = 1.0f;             // 输出大小未指定时的缩放
+    uint32_t frameSkip = 1;         // 每 frameSkip 帧编码一帧(编码帧率为 fps / frameSkip)
+};
+
+struct RecordRect {
+    int32_t left;
+    int32_t top;
+    int32_t right;
+    int32_t bottom;
+};
+
+struct RecordProjection {
+    RecordRect layerStackRect;      // 采集区域(屏幕坐标)
+    RecordRect displayRect;         // 采集区域在输出画面中的位置(保持宽高比居中)
+    uint32_t videoWidth;            // 输出大小(偶数，编码器不接受奇数)
+    uint32_t videoHeight;
+};
+
+/**
+ * 计算虚拟屏幕的投影，纯函数
+ * @param displayWidth 屏幕宽度(layer stack 坐标)
+ * @param displayHeight 屏幕高度
+ * @param rotate 输出旋转90度(竖屏内容编码为横屏)
+ * @return 采集区域和屏幕没有交集(或小于2x2)时返回false
+ */
+static inline bool computeRecordProjection(const RecordConfig &config, uint32_t displayWidth, uint32_t displayHeight,
+                                           bool rotate, RecordProjection *projection) {
+    if (displayWidth == 0 || displayHeight == 0) {
+        return false;
+    }
+    // 采集区域和屏幕求交
+    int64_t left = config.cropX > 0 ? config.cropX : 0;
+    int64_t top = config.cropY > 0 ? config.cropY : 0;
+    int64_t right = config.cropWidth > 0 ? (int64_t) config.cropX + config.cropWidth : (int64_t) displayWidth;
+    int64_t bottom = config.cropHeight > 0 ? (int64_t) config.cropY + config.cropHeight : (int64_t) displayHeight;
+    if (right > (int64_t) displayWidth) {
+        right = displayWidth;
+    }
+    if (bottom > (int64_t) displayHeight) {
+        bottom = displayHeight;
+    }
+    if (right - left < 2 || bottom - top < 2) {
+        return false;
+    }
+    auto cropWidth = (uint32_t) (right - left);
+    auto cropHeight = (uint32_t) (bottom - top);
+
+    // 未指定输出大小时按采集区域缩放，旋转时输出宽高互换
+    float scale = config.scale > 0.0f ? config.scale : 1.0f;
+    uint32_t scaledWidth = (uint32_t) lroundf((float) cropWidth * scale) & ~1u;
+    uint32_t scaledHeight = (uint32_t) lroundf((float) cropHeight * scale) & ~1u;
+    scaledWidth = scaledWidth < 2 ? 2 : scaledWidth;
+    scaledHeight = scaledHeight < 2 ? 2 : scaledHeight;
+    uint32_t videoWidth = config.videoWidth != 0 ? config.videoWidth : (rotate ? scaledHeight : scaledWidth);
+    uint32_t videoHeight = config.videoHeight != 0 ? config.videoHeight : (rotate ? scaledWidth : scaledHeight);
+
+    // 投影的输出矩形在旋转之后解释，旋转90度时先交换宽高；按整数比较宽高比，避免浮点取整差1像素
+    uint32_t fitWidth = rotate ? videoHeight : videoWidth;
+    uint32_t fitHeight = rotate ? videoWidth : videoHeight;
+    uint32_t outWidth, outHeight;
+    if ((uint64_t) fitHeight * cropWidth >= (uint64_t) fitWidth * cropHeight) {
+        // 宽度受限，减小高度
+        outWidth = fitWidth;
+        outHeight = (uint32_t) (((uint64_t) fitWidth * cropHeight + cropWidth / 2) / cropWidth);
+    } else {
+        // 高度受限，减小宽度
+        outHeight = fitHeight;
+        outWidth = (uint32_t) (((uint64_t) fitHeight * cropWidth + cropHeight / 2) / cropHeight);
+    }
+    outWidth = outWidth < 1 ? 1 : outWidth;
+    outHeight = outHeight < 1 ? 1 : outHeight;
+    uint32_t offX = (fitWidth - outWidth) / 2;
+    uint32_t offY = (fitHeight - outHeight) / 2;
+
+    projection->layerStackRect = {(int32_t) left, (int32_t) top, (int32_t) right, (int32_t) bottom};
+    projection->displayRect = {(int32_t) offX, (int32_t) offY, (int32_t) (offX + outWidth),
+                               (int32_t) (offY + outHeight)};
+    projection->videoWidth = videoWidth;
+    projection->videoHeight = videoHeight;
+    return true;
+}
+
+#endif //NATIVESURFACE_RECORD_CONFIG_H
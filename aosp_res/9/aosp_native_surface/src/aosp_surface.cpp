@@ -138,10 +138,30 @@ void initRecord(const char *bitRate, float fps,
     initScreenrecord(bitRate, fps, videoWidth, videoHeight);
 }
 
+bool initRecordConfig(const RecordConfig *config) {
+    return initScreenrecordConfig(config) == 0;
+}
+
 void stopRecord() {
     stopScreenrecord();
 }
 
+bool initRawCapture(uint32_t width, uint32_t height, int32_t format, int32_t maxImages) {
+    return initScreenCapture(width, height, format, maxImages);
+}
+
+bool acquireRawFrame(RawFrame *frame, int32_t timeoutMs) {
+    return acquireScreenFrame(frame, timeoutMs);
+}
+
+void releaseRawFrame(RawFrame *frame) {
+    releaseScreenFrame(frame);
+}
+
+void stopRawCapture() {
+    stopScreenCapture();
+}
+
 // void destroy1(){
 //     if (gSurfaceControl && gSurfaceControl->isValid()) {
 //         gSurfaceControl->destroy();
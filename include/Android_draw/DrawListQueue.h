@@ -0,0 +1,174 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_DRAWLISTQUEUE_H
+#define NATIVESURFACE_DRAWLISTQUEUE_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <imgui.h>
+#include <imgui_internal.h>
+
+class DrawListQueue;
+
+/**
+ * 后台线程的绘制通道
+ * 每个通道属于一个生产线程，内部三个 ImDrawList 轮换(录制中/最新完成/渲染线程正在使用)，
+ * 提交只是一次原子交换，生产线程和渲染线程互不等待
+ *
+ * 生命周期:
+ *  - begin() 到 submit() 之间返回的 ImDrawList 只能在本线程使用，submit() 之后不能再访问
+ *  - begin() 返回nullptr 表示队列还没有关联图层(或图层正在重建)，本次直接跳过
+ *  - 渲染线程一直显示最后一次提交的内容，要清空就 begin() 后直接 submit()
+ *  - 不再使用时调用 DrawListQueue::destroyChannel()，之后不能再访问通道
+ */
+class DrawListChannel {
+public:
+    /**
+     * 开始录制，返回的列表已经压入全屏裁剪矩形和字体纹理
+     */
+    ImDrawList *begin();
+
+    /**
+     * 提交本次录制的列表，替换渲染线程下一帧显示的内容
+     * 顶点超过65535且后端不支持VtxOffset时丢弃本次提交
+     */
+    void submit();
+
+    /**
+     * 把另一个ImGui上下文 Render() 出的整份 ImDrawData 合并进 begin() 返回的列表后提交(OverlayPanel 使用)
+     * 顶点和裁剪矩形平移 offset，相邻且状态相同的绘制命令合并；用户回调不会带过来
+     */
+    void submit(const ImDrawData *drawData, const ImVec2 &offset);
+
+    const char *getName() const;
+
+    int getOrder() const;
+
+private:
+    friend class DrawListQueue;
+
+    static const int READY_NEW = 4;
+
+    DrawListChannel(DrawListQueue *queue, const char *name, int order, uint32_t id);
+
+    ~DrawListChannel();
+
+    DrawListQueue *queue;
+    char name[32];
+    int order;
+    uint32_t id;
+
+    // 生产线程使用: 共享数据的副本(来自图层上下文，只读)
+    ImDrawListSharedData sharedData;
+    uint32_t sharedVersion = 0;
+    uint32_t generation = 0;
+    ImTextureID fontTexture{};
+    bool recording = false;
+
+    ImDrawList *lists[3];
+    uint32_t listGenerations[3] = {};
+    int back = 0;                       // 生产线程正在录制
+    int front = 1;                      // 渲染线程正在使用
+    std::atomic<int> ready{2};          // 最新完成的列表 | READY_NEW
+
+    std::atomic<bool> closed{false};
+    DrawListChannel *next = nullptr;
+};
+
+// 队列统计，全部为累计值
+struct DrawListQueueStats {
+    int channels = 0;                   // 当前通道数
+    uint64_t submitted = 0;             // 提交次数
+    uint64_t acquired = 0;              // 渲染线程取到新列表的次数
+    uint64_t dropped = 0;               // 顶点超限被丢弃的提交
+};
+
+/**
+ * 多生产者绘制队列
+ * 任意线程创建通道并录制 ImDrawList，图层在 endFrame() 时取出每个通道最新的列表，
+ * 追加到 ImDrawData 末尾作为前景层(按 order 从小到大，越大越靠上)
+ *
+ * 录制线程与图层共享 ImDrawListSharedData(每帧在 beginFrame 后同步一份快照)和字体图集(只读)，
+ * 录制期间不要重建字体图集。图层销毁/重建时会等待正在录制的线程提交，期间 begin() 返回nullptr
+ */
+class DrawListQueue {
+public:
+    DrawListQueue();
+
+    ~DrawListQueue();
+
+    DrawListQueue(const DrawListQueue &) = delete;
+
+    DrawListQueue &operator=(const DrawListQueue &) = delete;
+
+    /**
+     * 创建通道，任意线程可调用
+     * @param name 调试用名称
+     * @param order 同一队列内的叠放顺序
+     */
+    DrawListChannel *createChannel(const char *name, int order = 0);
+
+    /**
+     * 销毁通道，由使用通道的线程调用，实际释放在渲染线程下一次取列表时进行
+     */
+    void destroyChannel(DrawListChannel *channel);
+
+    DrawListQueueStats getStats() const;
+
+    // 以下只在渲染线程(持有图层的ImGui上下文时)调用，由 OverlayLayer 负责
+
+    /**
+     * 同步当前上下文的共享数据和字体纹理，NewFrame() 之后调用，未关联时同时完成关联
+     */
+    void updateSharedData(const ImDrawListSharedData &data, ImTextureID fontTexture);
+
+    /**
+     * 取消关联并等待正在录制的线程提交，销毁ImGui上下文前调用
+     */
+    void detach();
+
+    /**
+     * 取出每个通道最新的列表追加到 drawData 之后
+     * @return 没有可追加的列表时返回 drawData 本身，否则返回队列内部的 ImDrawData，在下一次调用前有效
+     */
+    ImDrawData *splice(ImDrawData *drawData);
+
+    /**
+     * 上一次 splice() 追加后的 ImDrawData，没有追加列表时为nullptr
+     * 队列的列表在下一次 splice() 前有效，其中ImGui自己的列表只在当帧有效
+     */
+    ImDrawData *getSplicedDrawData();
+
+private:
+    friend class DrawListChannel;
+
+    void releaseClosedChannels();
+
+    std::atomic<DrawListChannel *> channels{nullptr};
+    std::atomic<uint32_t> nextChannelId{0};
+    std::atomic<int> channelCount{0};
+
+    // 共享数据快照，渲染线程写，生产线程在 begin() 中发现版本变化时复制
+    std::mutex sharedMutex;
+    ImDrawListSharedData sharedData;
+    ImTextureID fontTexture{};
+    uint32_t generation = 0;
+    std::atomic<uint32_t> sharedVersion{0};
+    std::atomic<bool> attached{false};
+    std::atomic<int> recorders{0};
+
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> acquired{0};
+    std::atomic<uint64_t> dropped{0};
+
+    // 渲染线程使用
+    ImVector<DrawListChannel *> frameChannels;
+    ImVector<ImDrawList *> frameLists;
+    ImDrawData frameDrawData;
+    bool frameSpliced = false;
+};
+
+#endif //NATIVESURFACE_DRAWLISTQUEUE_H
@@ -0,0 +1,48 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_EGLLAYERBACKEND_H
+#define NATIVESURFACE_EGLLAYERBACKEND_H
+
+#include <EGL/egl.h>
+#include <android/native_window.h>
+#include "Android_draw/OverlayLayer.h"
+
+/**
+ * 基于 ExternFunction::createNativeWindow + EGL window surface 的图层后端
+ */
+class EglLayerBackend : public LayerBackend {
+public:
+    bool create(const LayerConfig &config, LayerBackend *share) override;
+
+    void destroy() override;
+
+    bool makeCurrent() override;
+
+    void releaseCurrent() override;
+
+    bool initImGui() override;
+
+    void shutdownImGui() override;
+
+    void newFrame(uint32_t width, uint32_t height) override;
+
+    void renderDrawData(ImDrawData *drawData, uint32_t width, uint32_t height) override;
+
+    void present() override;
+
+    ANativeWindow *getNativeWindow() const;
+
+    EGLContext getEglContext() const;
+
+private:
+    ANativeWindow *native_window = nullptr;
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLConfig config = nullptr;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext context = EGL_NO_CONTEXT;
+    bool gpuTimer = false;
+};
+
+#endif //NATIVESURFACE_EGLLAYERBACKEND_H
@@ -0,0 +1,65 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_HEADLESSLAYERBACKEND_H
+#define NATIVESURFACE_HEADLESSLAYERBACKEND_H
+
+#include <vector>
+#include <EGL/egl.h>
+#include <GLES3/gl32.h>
+#include "Android_draw/OverlayLayer.h"
+
+/**
+ * 离屏图层后端，不需要 SurfaceFlinger
+ * 优先使用 EGL_MESA_platform_surfaceless(无GPU的Linux上由llvmpipe提供)，否则退回默认display + pbuffer，
+ * 统一渲染到FBO，用于CI基准测试和截图回归
+ */
+class HeadlessLayerBackend : public LayerBackend {
+public:
+    bool create(const LayerConfig &config, LayerBackend *share) override;
+
+    void destroy() override;
+
+    bool makeCurrent() override;
+
+    void releaseCurrent() override;
+
+    bool initImGui() override;
+
+    void shutdownImGui() override;
+
+    void newFrame(uint32_t width, uint32_t height) override;
+
+    void renderDrawData(ImDrawData *drawData, uint32_t width, uint32_t height) override;
+
+    void present() override;
+
+    /**
+     * 读取最后一帧像素(RGBA, 从上到下)
+     */
+    bool readPixels(std::vector<uint8_t> &out);
+
+    uint32_t getWidth() const;
+
+    uint32_t getHeight() const;
+
+    /**
+     * present 是否 glFinish 等待渲染完成(默认只 glFlush)
+     */
+    void setFinishOnPresent(bool finish);
+
+private:
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLConfig config = nullptr;
+    EGLSurface surface = EGL_NO_SURFACE;
+    EGLContext context = EGL_NO_CONTEXT;
+    GLuint framebuffer = 0;
+    GLuint colorbuffer = 0;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    bool finishOnPresent = false;
+    bool gpuTimer = false;
+};
+
+#endif //NATIVESURFACE_HEADLESSLAYERBACKEND_H
@@ -0,0 +1,83 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_LAYERSCHEDULER_H
+#define NATIVESURFACE_LAYERSCHEDULER_H
+
+#include <cstdint>
+#include <atomic>
+
+// 图层刷新模式
+enum LayerRenderMode {
+    LayerRender_Continuous = 0, // 按固定帧率持续刷新(视频图层)
+    LayerRender_OnChange,       // 只在内容变化时刷新(静态HUD图层)
+};
+
+/**
+ * 图层刷新调度
+ * 只负责判断"什么时候该画下一帧"，不依赖EGL/窗口，Linux下可直接配合mock后端使用
+ */
+class LayerScheduler {
+public:
+    static const int64_t NEVER = INT64_MAX;
+
+    explicit LayerScheduler(LayerRenderMode mode = LayerRender_Continuous, float fps = 60.0f);
+
+    void setMode(LayerRenderMode mode);
+
+    LayerRenderMode getMode() const;
+
+    /**
+     * 设置目标帧率(Continuous模式下的刷新率，OnChange模式下dirty帧的最高刷新率)
+     * @param fps <= 0 不限帧率
+     */
+    void setFps(float fps);
+
+    float getFps() const;
+
+    /**
+     * OnChange模式下的保活刷新率，0为没有变化时完全不刷新
+     */
+    void setIdleFps(float fps);
+
+    /**
+     * 标记内容变化，OnChange模式下接下来会至少刷新frames帧
+     * (ImGui的hover/active状态通常需要多一两帧才稳定)
+     */
+    void markDirty(int frames = 2);
+
+    bool isDirty() const;
+
+    /**
+     * 当前时间点是否需要绘制
+     */
+    bool shouldRender(int64_t nowNs) const;
+
+    /**
+     * 下一次需要唤醒的时间点，NEVER 表示等待markDirty
+     */
+    int64_t nextWakeupNs(int64_t nowNs) const;
+
+    /**
+     * 一帧绘制完成后调用
+     */
+    void onFrameRendered(int64_t nowNs);
+
+    uint64_t getFrameCount() const;
+
+    static int64_t nowNs();
+
+private:
+    static int64_t intervalOf(float fps);
+
+    std::atomic<int> mode;
+    std::atomic<int64_t> frameInterval;
+    std::atomic<int64_t> idleInterval;
+    std::atomic<int> dirtyFrames;
+    std::atomic<int64_t> lastFrameNs;
+    std::atomic<int64_t> nextDeadlineNs;
+    std::atomic<uint64_t> frameCount;
+};
+
+#endif //NATIVESURFACE_LAYERSCHEDULER_H
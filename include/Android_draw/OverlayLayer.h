@@ -0,0 +1,211 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_OVERLAYLAYER_H
+#define NATIVESURFACE_OVERLAYLAYER_H
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <imgui.h>
+#include "Android_draw/LayerScheduler.h"
+
+struct ImGuInputEvent;
+
+class DrawListQueue;
+
+// 图层参数
+struct LayerConfig {
+    const char *name = "Ssage";   // surface 名称
+    uint32_t width = 0;           // 图层宽
+    uint32_t height = 0;          // 图层高
+    int32_t zOrder = 0;           // 越大越靠上，触摸事件优先分发给最上层的acceptInput图层
+    LayerRenderMode mode = LayerRender_Continuous;
+    float fps = 60.0f;            // 目标帧率
+    float idleFps = 0.0f;         // OnChange模式保活帧率
+    bool acceptInput = false;     // 是否接收触摸
+    bool sdfFont = false;         // 字体图集生成距离场字形，一套图集任意字号都清晰
+    ImFontAtlas *fonts = nullptr; // 共享的字体图集(不归图层所有)，为空时图层自己创建；已有字体时不再添加默认字体
+    bool gpuTimer = false;        // GPU计时(GL_EXT_disjoint_timer_query)，结果几帧后异步读回，驱动不支持时忽略
+    bool log = false;
+};
+
+// 一帧的渲染统计，图层同时以 "<图层名> xxx" 写入分析器计数器(PROFILE_COUNTER)
+struct LayerRenderStats {
+    uint64_t frame = 0;           // 后端渲染的帧序号
+    int drawCalls = 0;
+    int stateChanges = 0;         // 绘制之间的裁剪/纹理/uniform切换
+    int textureBinds = 0;
+    size_t bytesUploaded = 0;     // 顶点/索引 + 字体纹理
+    int userCallbacks = 0;        // ImDrawList::AddCallback 回调(视频纹理等)
+    float gpuTimeMs = -1.0f;      // 整帧GPU耗时，没有GPU计时时为-1
+    float gpuCallbackMs = -1.0f;  // 其中用户回调的GPU耗时之和
+    int gpuLatency = 0;           // GPU计时是多少帧之前的
+};
+
+/**
+ * 图层窗口/渲染后端
+ * Android下由EglLayerBackend实现(createNativeWindow + EGL)，测试时可替换为mock
+ */
+class LayerBackend {
+public:
+    virtual ~LayerBackend() = default;
+
+    /**
+     * 创建窗口与渲染上下文，创建完成后上下文在当前线程生效
+     * @param share 共享纹理的图层后端，可为空
+     */
+    virtual bool create(const LayerConfig &config, LayerBackend *share) = 0;
+
+    virtual void destroy() = 0;
+
+    virtual bool makeCurrent() = 0;
+
+    virtual void releaseCurrent() = 0;
+
+    // 以下调用时ImGui当前上下文为图层自己的上下文
+    virtual bool initImGui() = 0;
+
+    virtual void shutdownImGui() = 0;
+
+    virtual void newFrame(uint32_t width, uint32_t height) = 0;
+
+    virtual void renderDrawData(ImDrawData *drawData, uint32_t width, uint32_t height) = 0;
+
+    virtual void present() = 0;
+};
+
+/**
+ * 独立的 native surface 图层
+ * 每个图层拥有自己的窗口、EGL上下文与ImGui上下文，可以由调用方逐帧驱动(beginFrame/endFrame)，
+ * 也可以调用start()在独立线程上按LayerScheduler的节奏刷新
+ */
+class OverlayLayer {
+public:
+    typedef std::function<void(OverlayLayer &)> DrawCallback;
+
+    /**
+     * @param backend 图层后端，所有权交给图层
+     */
+    OverlayLayer(const LayerConfig &config, LayerBackend *backend);
+
+    ~OverlayLayer();
+
+    OverlayLayer(const OverlayLayer &) = delete;
+
+    OverlayLayer &operator=(const OverlayLayer &) = delete;
+
+    /**
+     * 创建窗口和上下文
+     * @param share 共享GL纹理的图层，可为空
+     */
+    bool init(OverlayLayer *share = nullptr);
+
+    void shutdown();
+
+    /**
+     * 调用方驱动: 在同一线程成对调用
+     */
+    void beginFrame();
+
+    void endFrame();
+
+    /**
+     * 在独立线程上刷新，callback在图层线程上执行，只能调用ImGui绘制
+     */
+    bool start(DrawCallback callback);
+
+    void stop();
+
+    bool isRunning() const;
+
+    /**
+     * 标记内容变化(OnChange模式下触发重绘)，任意线程可调用
+     */
+    void markDirty(int frames = 2);
+
+    void setFps(float fps);
+
+    void setMode(LayerRenderMode mode);
+
+    LayerScheduler &getScheduler();
+
+    const LayerConfig &getConfig() const;
+
+    ImGuiContext *getContext() const;
+
+    LayerBackend *getBackend() const;
+
+    uint32_t getWidth() const;
+
+    uint32_t getHeight() const;
+
+    /**
+     * 关联后台线程绘制队列，endFrame() 时把各通道最新的列表叠加在ImGui内容之上
+     * 队列不归图层所有，图层销毁时取消关联；在驱动图层的线程上调用
+     */
+    void setDrawListQueue(DrawListQueue *queue);
+
+    DrawListQueue *getDrawListQueue() const;
+
+    /**
+     * 最近一帧的渲染统计，任意线程可调用
+     * @return 还没有渲染过或后端不统计时返回false
+     */
+    bool getRenderStats(LayerRenderStats &stats) const;
+
+    /**
+     * 图层之间共享状态的锁: 字体图集(后端上传字体纹理、NewFrame/EndFrame 标记 Locked)和上下文的创建/销毁
+     * GImGui 按线程保存，各图层的 NewFrame 到 Render 之间(包括回调)不持有这把锁，可以并行；OverlayPanel 不需要持有
+     */
+    static std::recursive_mutex &imguiMutex();
+
+    /**
+     * 将触摸事件分发给最上层接收触摸的图层，并标记其重绘
+     * 事件先进入图层的队列，由图层在下一次 beginFrame() 时写入自己的 ImGuiIO
+     */
+    static void dispatchInput(const ImGuInputEvent &event);
+
+private:
+    void renderLoop();
+
+    void renderFrame();
+
+    // 把 dispatchInput 排队的触摸事件写入当前上下文的 ImGuiIO，在图层自己的线程上调用
+    void applyInput();
+
+    // 读取后端统计，保存并写入分析器计数器
+    void publishRenderStats();
+
+    static void registerLayer(OverlayLayer *layer);
+
+    static void unregisterLayer(OverlayLayer *layer);
+
+    LayerConfig config;
+    LayerBackend *backend;
+    ImGuiContext *context = nullptr;
+    ImGuiContext *prevContext = nullptr;
+    LayerScheduler scheduler;
+    DrawListQueue *drawQueue = nullptr;
+    bool initialized = false;
+
+    LayerRenderStats renderStats;
+    bool hasRenderStats = false;
+    mutable std::mutex statsMutex;
+
+    std::vector<ImGuInputEvent> pendingInput;
+    std::mutex inputMutex;
+
+    DrawCallback callback;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCond;
+};
+
+#endif //NATIVESURFACE_OVERLAYLAYER_H
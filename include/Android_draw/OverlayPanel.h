@@ -0,0 +1,107 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_OVERLAYPANEL_H
+#define NATIVESURFACE_OVERLAYPANEL_H
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <imgui.h>
+#include "Android_draw/LayerScheduler.h"
+
+class DrawListQueue;
+
+class DrawListChannel;
+
+// 面板参数
+struct PanelConfig {
+    const char *name = "panel";   // 通道名称(调试用)
+    float x = 0.0f;               // 面板在图层上的位置
+    float y = 0.0f;
+    float width = 400.0f;         // 面板的ImGui显示大小
+    float height = 300.0f;
+    int order = 0;                // 同一队列内的叠放顺序
+    LayerRenderMode mode = LayerRender_Continuous;
+    float fps = 30.0f;            // 目标帧率
+};
+
+/**
+ * 独立刷新的叠加面板
+ * 每个面板有自己的ImGui上下文(GImGui 按线程保存，见 imconfig.h)和刷新线程，与图层共享字体图集，
+ * 每帧 Render() 的结果合并成一个 ImDrawList 提交到 DrawListQueue，由图层在 endFrame() 时叠加，
+ * 面板之间、面板与图层之间都不需要 OverlayLayer::imguiMutex()
+ *
+ * 面板不接收触摸，绘制回调里只能调用ImGui绘制；图层重建期间面板跳过绘制
+ */
+class OverlayPanel {
+public:
+    typedef std::function<void(OverlayPanel &)> DrawCallback;
+
+    /**
+     * @param queue 提交绘制结果的队列
+     * @param fonts 共享的字体图集(图层使用的同一个)，面板只读
+     * @param style 初始样式，为空时使用默认深色样式
+     */
+    OverlayPanel(const PanelConfig &config, DrawListQueue *queue, ImFontAtlas *fonts,
+                 const ImGuiStyle *style = nullptr);
+
+    ~OverlayPanel();
+
+    OverlayPanel(const OverlayPanel &) = delete;
+
+    OverlayPanel &operator=(const OverlayPanel &) = delete;
+
+    /**
+     * 在独立线程上按 config.fps 刷新，callback在面板线程上执行
+     */
+    bool start(DrawCallback callback);
+
+    void stop();
+
+    bool isRunning() const;
+
+    /**
+     * 调用方驱动: 画一帧并提交，同一时间只能在一个线程调用
+     * @return 队列未关联图层(跳过本帧)时返回false
+     */
+    bool renderFrame();
+
+    void markDirty(int frames = 2);
+
+    LayerScheduler &getScheduler();
+
+    const PanelConfig &getConfig() const;
+
+    ImGuiContext *getContext() const;
+
+    // 已提交的帧数
+    uint64_t getFrameCount() const;
+
+    // 因队列未关联而跳过的帧数
+    uint64_t getSkippedCount() const;
+
+private:
+    void renderLoop();
+
+    PanelConfig config;
+    DrawListQueue *queue;
+    DrawListChannel *channel = nullptr;
+    ImGuiContext *context = nullptr;
+    LayerScheduler scheduler;
+    int64_t lastFrameNs = 0;
+    std::atomic<uint64_t> frameCount{0};
+    std::atomic<uint64_t> skippedCount{0};
+
+    DrawCallback callback;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::mutex wakeMutex;
+    std::condition_variable wakeCond;
+};
+
+#endif //NATIVESURFACE_OVERLAYPANEL_H
@@ -18,20 +18,38 @@
 #include <cstdio>
 #include <cstring>
 #include <cerrno>
-#include <android/native_window.h>
-#include <Egl/eglext.h>
+#include <EGL/eglext.h>
 #include <GLES3/gl3platform.h>
 #include <GLES3/gl3ext.h>
 #include <GLES3/gl32.h>
 
 // User libs
 //#include <touch.h>
-#include "native_surface/extern_function.h"
 #include <imgui.h>
+#if __has_include(<font/Font.h>)
 #include <font/Font.h>
+#endif
 #include <imgui_internal.h>
 #include <backends/imgui_impl_opengl3.h>
 #include <backends/imgui_impl_android.h>
+#include "Android_draw/OverlayLayer.h"
+#include "Android_draw/DrawListQueue.h"
+#include "Android_draw/OverlayPanel.h"
+#include "Profiler.h"
+#ifdef NATIVE_SURFACE_HEADLESS
+// 离屏构建(CI基准测试): 没有 SurfaceFlinger，窗口由 HeadlessLayerBackend 代替
+#include "Android_draw/HeadlessLayerBackend.h"
+
+struct MDisplayInfo {
+    uint32_t width{0};
+    uint32_t height{0};
+    uint32_t orientation{0};
+};
+#else
+#include <android/native_window.h>
+#include "native_surface/extern_function.h"
+#include "Android_draw/EglLayerBackend.h"
+#endif
 
 // namespace
 using namespace std;
@@ -40,23 +58,45 @@ using namespace std::chrono_literals;
 //extern EGLConfig config;
 //extern EGLSurface surface;
 //extern ANativeWindow *native_window;
+#ifndef NATIVE_SURFACE_HEADLESS
 extern ExternFunction externFunction;
+#endif
 //extern EGLContext context;
 // 屏幕信息
 extern MDisplayInfo displayInfo;
 extern bool g_Initialized;
 
 // Func
-bool init_egl(uint32_t _screen_x, uint32_t _screen_y, bool log = false);
-
 bool initDraw(uint32_t _screen_x, uint32_t _screen_y, bool log = false);
 
 bool initDraw(bool log = false);
 
-bool ImGui_init();
-
 void screen_config();
 
+/**
+ * 创建独立图层(独立surface、EGL上下文、ImGui上下文)
+ * @param config 图层参数，宽高为0时使用屏幕宽高
+ * @param share 共享GL纹理的图层，为空时与主图层共享
+ * @return 失败返回nullptr
+ */
+OverlayLayer *createOverlayLayer(LayerConfig config, OverlayLayer *share = nullptr);
+
+/**
+ * initDraw 创建的主图层
+ */
+OverlayLayer *getMainLayer();
+
+/**
+ * 主图层的后台线程绘制队列，工作线程创建通道后自行录制 ImDrawList，drawEnd() 时叠加在最上层
+ */
+DrawListQueue *getDrawListQueue();
+
+/**
+ * 创建叠加在主图层上的独立面板(独立ImGui上下文，共享主图层字体图集和样式)，通过 getDrawListQueue() 提交
+ * 主图层初始化后调用，面板由调用方 delete
+ */
+OverlayPanel *createOverlayPanel(const PanelConfig &config);
+
 void drawBegin();
 
 void drawEnd();
@@ -0,0 +1,55 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_TOUCHPARSER_H
+#define NATIVESURFACE_TOUCHPARSER_H
+
+#include <cstdint>
+#include <vector>
+#include <imgui.h>
+#include <backends/imgui_impl_android.h>
+
+ImVec2 rotatePointx(uint32_t orientation, ImVec2 mxy, ImVec2 wh = {0, 0});
+
+struct TouchRawEvent {
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+};
+
+/**
+ * 触摸事件解析: input_event 按 SYN_REPORT 分组，换算成屏幕坐标的 ImGuInputEvent(只处理第一个手指)
+ * 不读设备，touch_config 读 /dev/input，回放时从会话文件输入，两边走同一份逻辑
+ */
+class TouchParser {
+public:
+    /**
+     * @param touchSize 触摸屏坐标范围(EVIOCGABS 的最大值)
+     */
+    void setTouchSize(ImVec2 touchSize);
+
+    /**
+     * 当前屏幕信息(方向为1/3时宽高按横屏传入，和 displayInfo 一致)
+     */
+    void setDisplay(uint32_t width, uint32_t height, uint32_t orientation);
+
+    /**
+     * @return 收到 SYN_REPORT 并且是第一个手指时返回true，out 为转换后的事件
+     */
+    bool push(uint16_t type, uint16_t code, int32_t value, ImGuInputEvent &out);
+
+    void reset();
+
+private:
+    std::vector<TouchRawEvent> events;
+    int fingerIndex = 0;
+    int eventX = 0;
+    int eventY = 0;
+    ImVec2 touchSize{1.0f, 1.0f};
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t orientation = 0;
+};
+
+#endif //NATIVESURFACE_TOUCHPARSER_H
@@ -25,6 +25,8 @@
 #include <string>
 // User libs
 #include <draw.h>
+#include "Android_touch/TouchParser.h"
+#include "SessionFile.h"
 //#include <virtual.h>
 
 #define UNGRAB 0x0
@@ -53,9 +55,12 @@ using namespace std;
 #define NBITS(x)             ((((x)-1)/BITS_PER_LONG)+1)
 int isa_event_device(const struct dirent* dir);
 std::string getTouchScreenDevice();
-ImVec2 rotatePointx(uint32_t orientation, ImVec2 mxy, ImVec2 wh = {0, 0});
 ImVec2 getTouchScreenDimension(int fd);
 void touch_config();
 void Init_touch_config();
 void touchEnd();
+/**
+ * 把读到的触摸事件同时写进会话文件(NativeReplay 回放)，传空停止；在 Init_touch_config 之前设置
+ */
+void touchSetRecorder(SessionWriter *writer);
 #endif
\ No newline at end of file
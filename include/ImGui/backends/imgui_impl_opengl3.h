@@ -32,6 +32,28 @@ IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyFontsTexture();
 IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_CreateDeviceObjects();
 IMGUI_IMPL_API void     ImGui_ImplOpenGL3_DestroyDeviceObjects();
 
+// Size in bytes of the uploaded font atlas texture (width*height with IMGUI_USE_ALPHA8_FONT_ATLAS on ES 3.0+/GL 3.3+, width*height*4 otherwise)
+IMGUI_IMPL_API size_t   ImGui_ImplOpenGL3_GetFontsTextureBytes();
+
+// Per frame driver call counters of the current context, and optional GPU timings (GL_EXT_disjoint_timer_query, ES 3.0 only).
+// GPU results are polled a few frames later without waiting: GpuFrameLatency tells how many frames old they are.
+struct ImGui_ImplOpenGL3_FrameStats
+{
+    unsigned int    FrameIndex;             // Number of ImGui_ImplOpenGL3_RenderDrawData() calls
+    int             DrawCalls;              // glDrawElements() calls
+    int             StateChanges;           // glScissor()/glBindTexture()/glUniform() calls between draws, +1 per render state setup
+    int             TextureBinds;           // glBindTexture() calls (consecutive commands using the same texture share one)
+    size_t          BytesUploaded;          // Vertex/index data + font atlas texture uploaded since the previous frame
+    int             UserCallbacks;          // ImDrawList::AddCallback() callbacks run (excluding ImDrawCallback_ResetRenderState)
+    float           GpuTimeMs;              // GPU time of a whole frame, -1.0f when the timer is unavailable or disabled
+    float           GpuCallbackTimeMs[8];   // GPU time of each user callback in that frame
+    int             GpuCallbackCount;
+    int             GpuFrameLatency;        // How many frames before FrameIndex the GPU timings were recorded
+};
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_GetFrameStats(ImGui_ImplOpenGL3_FrameStats* out_stats);    // Stats of the last rendered frame, false before the first one
+IMGUI_IMPL_API void     ImGui_ImplOpenGL3_SetGpuTimerEnabled(bool enabled);                       // Disabled by default
+IMGUI_IMPL_API bool     ImGui_ImplOpenGL3_HasGpuTimer();                                         // GL_EXT_disjoint_timer_query is available
+
 // Specific OpenGL ES versions
 //#define IMGUI_IMPL_OPENGL_ES2     // Auto-detected on Emscripten
 //#define IMGUI_IMPL_OPENGL_ES3     // Auto-detected on iOS/Android
@@ -47,6 +47,34 @@
 //#define IMGUI_DISABLE_DEFAULT_FILE_FUNCTIONS              // Don't implement ImFileOpen/ImFileClose/ImFileRead/ImFileWrite and ImFileHandle so you can implement them yourself if you don't want to link with fopen/fclose/fread/fwrite. This will also disable the LogToTTY() function.
 //#define IMGUI_DISABLE_DEFAULT_ALLOCATORS                  // Don't implement default allocators calling malloc()/free() to avoid linking with them. You will need to call ImGui::SetAllocatorFunctions().
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
+//#define IMGUI_DISABLE_NEON                                // Disable use of NEON intrinsics even if available (arm64)
+
+//---- Hash IDs with CRC32C (Castagnoli) instead of CRC32, using the ARMv8 CRC32 (__crc32c*) or SSE4.2 (_mm_crc32_*) instructions when available
+// and slice-by-8 tables otherwise. IDs (and table settings saved in .ini files) differ from the ones produced by the default CRC32.
+// The hardware path needs '-march=armv8-a+crc' on arm64 and '-msse4.2' on x86_64 (default for Android x86_64, see CMakeLists.txt).
+#define IMGUI_USE_CRC32C_HASH
+
+//---- Use an open addressing hash index (Robin Hood linear probing) for ImGuiStorage instead of a sorted vector + binary search.
+// Lookups become O(1) and insertions no longer shift the whole vector. Storage->Data keeps the pairs in insertion order (no longer sorted by key).
+#define IMGUI_USE_HASHED_STORAGE
+
+//---- Default allocator: serve MemAlloc()/MemFree() from size-class pools (16..65536 bytes, larger blocks go to malloc) instead of calling malloc/free every time.
+// Each thread allocates from its own free lists without locking, and active/peak bytes are reported in the Metrics window. Pool pages are never returned to the system.
+#define IMGUI_USE_POOL_ALLOCATOR
+
+//---- [OpenGL3 backend] Upload the font atlas as a single channel GL_R8 texture (swizzled to 1,1,1,R) instead of RGBA32 on GL ES 3.0+/GL 3.3+.
+// Uses 4x less texture memory for the same rendering. Don't enable if you write colored pixels into GetTexDataAsRGBA32() (custom rects, colored icons).
+#define IMGUI_USE_ALPHA8_FONT_ATLAS
+
+//---- Make the current context pointer (GImGui) thread local, so N threads can each drive their own context concurrently (see "Current context pointer" in imgui.cpp).
+// Each thread must call SetCurrentContext() itself. Contexts may share one ImFontAtlas (CreateContext(shared_font_atlas)) as long as it is built first and not modified
+// while they run; only the owning context locks it during its frames. Threads without a context (e.g. raw ImDrawList recording) don't touch any context's metrics.
+#define IMGUI_USE_THREAD_LOCAL_CONTEXT
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+struct ImGuiContext;
+extern thread_local ImGuiContext* GImGuiTLS;
+#define GImGui GImGuiTLS
+#endif
 
 //---- Include imgui_user.h at the end of imgui.h as a convenience
 //#define IMGUI_INCLUDE_IMGUI_USER_H
@@ -60,6 +60,7 @@ Index of this file:
 #include <float.h>                  // FLT_MIN, FLT_MAX
 #include <stdarg.h>                 // va_list, va_start, va_end
 #include <stddef.h>                 // ptrdiff_t, NULL
+#include <stdint.h>                 // uintptr_t (ImTextureID)
 #include <string.h>                 // memset, memmove, memcpy, strlen, strchr, strcpy, strcmp
 
 // Version
@@ -160,6 +161,7 @@ struct ImGuiStorage;                // Helper for key->value storage
 struct ImGuiStyle;                  // Runtime data for styling/colors
 struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often handling sort specs for a single column, occasionally more)
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
+struct ImGuiTableDataSource;        // Virtual rows provider for a table (row count, sorting, filtering, row submission)
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
 struct ImGuiViewport;               // A Platform Window (always only one in 'master' branch), in the future may represent Platform Monitor
@@ -372,6 +374,7 @@ namespace ImGui
     IMGUI_API void          SetNextWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                 // set next window collapsed state. call before Begin()
     IMGUI_API void          SetNextWindowFocus();                                                       // set next window to be focused / top-most. call before Begin()
     IMGUI_API void          SetNextWindowBgAlpha(float alpha);                                          // set next window background color alpha. helper to easily override the Alpha component of ImGuiCol_WindowBg/ChildBg/PopupBg. you may also use ImGuiWindowFlags_NoBackground.
+    IMGUI_API void          SetNextWindowRetained(ImGuiID key);                                         // set next window as retained: while 'key' (hash your widget values into it), window position/size/scroll and style are unchanged, last frame vertices are reused and Begin() returns false. Not used while the window is hovered/active. Contents must not create child windows.
     IMGUI_API void          SetWindowPos(const ImVec2& pos, ImGuiCond cond = 0);                        // (not recommended) set current window position - call within Begin()/End(). prefer using SetNextWindowPos(), as this may incur tearing and side-effects.
     IMGUI_API void          SetWindowSize(const ImVec2& size, ImGuiCond cond = 0);                      // (not recommended) set current window size - call within Begin()/End(). set to ImVec2(0, 0) to force an auto-fit. prefer using SetNextWindowSize(), as this may incur tearing and minor side-effects.
     IMGUI_API void          SetWindowCollapsed(bool collapsed, ImGuiCond cond = 0);                     // (not recommended) set current window collapsed state. prefer using SetNextWindowCollapsed().
@@ -769,6 +772,16 @@ namespace ImGui
     // - Lifetime: don't hold on this pointer over multiple frames or past any subsequent call to BeginTable().
     IMGUI_API ImGuiTableSortSpecs*  TableGetSortSpecs();                        // get latest sort specs for the table (NULL if not sorting).
 
+    // Tables: Data source
+    // - For large data sets: the table keeps the display order of the rows (filtered + sorted with the current sort specs) and only
+    //   rebuilds it when sort specs, source->RowCount or source->DataVersion change, instead of the caller re-sorting every frame.
+    // - Call TableSetDataSource() after TableSetupColumn()/TableHeadersRow(), then TableSubmitDataSourceRows() to submit the visible rows
+    //   with a clipper, or use your own ImGuiListClipper with TableGetDataSourceRow().
+    // - Only visible rows are submitted, so columns auto-fit only measures those.
+    IMGUI_API int                   TableSetDataSource(const ImGuiTableDataSource* source); // update the cached display order if needed, return number of rows to display.
+    IMGUI_API int                   TableGetDataSourceRow(int display_n);       // return data row displayed at position 'display_n' (0 <= display_n < value returned by TableSetDataSource())
+    IMGUI_API void                  TableSubmitDataSourceRows(float items_height = -1.0f); // submit visible rows with source->SubmitRow(), calling TableNextRow() before each row.
+
     // Tables: Miscellaneous functions
     // - Functions args 'int column_n' treat the default value of -1 as the same as passing the current column index.
     IMGUI_API int                   TableGetColumnCount();                      // return number of columns (value passed to BeginTable)
@@ -950,6 +963,7 @@ namespace ImGui
     IMGUI_API void          GetAllocatorFunctions(ImGuiMemAllocFunc* p_alloc_func, ImGuiMemFreeFunc* p_free_func, void** p_user_data);
     IMGUI_API void*         MemAlloc(size_t size);
     IMGUI_API void          MemFree(void* ptr);
+    IMGUI_API void*         MemAllocFrame(size_t size);                                         // transient allocation from the current context's frame arena (16 bytes aligned). Valid until the next NewFrame(), never free it.
 
 } // namespace ImGui
 
@@ -2017,7 +2031,11 @@ struct ImGuiIO
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
+    int         MetricsRetainedWindows;             // Number of windows replayed from retained draw data this frame (see SetNextWindowRetained())
     int         MetricsActiveAllocations;           // Number of active allocations, updated by MemAlloc/MemFree based on current context. May be off if you have multiple imgui contexts.
+    int         MetricsFrameAllocations;            // Number of MemAlloc() calls during the last frame (from NewFrame() to NewFrame()), based on current context.
+    int         MetricsFrameAllocatedBytes;         // Bytes requested by MemAlloc() during the last frame.
+    int         MetricsFrameArenaBytes;             // Bytes requested by MemAllocFrame() during the last frame.
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
 
     // Legacy: before 1.87, we required backend to fill io.KeyMap[] (imgui->native map) during initialization and io.KeysDown[] (native indices) every frame.
@@ -2171,6 +2189,21 @@ struct ImGuiTableSortSpecs
     ImGuiTableSortSpecs()       { memset(this, 0, sizeof(*this)); }
 };
 
+// Virtual rows provider for a table, see TableSetDataSource(). Rows are identified by their index in the data set: 0 to RowCount-1.
+// The table copies this structure, the callbacks are only called during TableSetDataSource() and TableSubmitDataSourceRows().
+struct ImGuiTableDataSource
+{
+    void*   UserData;
+    int     RowCount;                                                   // Number of rows in the data set
+    ImU32   DataVersion;                                                // Change whenever rows or the filter change, to rebuild the display order
+    int     (*CompareRows)(void* user_data, const ImGuiTableColumnSortSpecs* spec, int row_a, int row_b); // Optional: ascending comparison of two rows for spec->ColumnIndex/ColumnUserID (<0, 0, >0). The table applies SortDirection and multiple specs. NULL = data order
+    bool    (*FilterRow)(void* user_data, int row);                     // Optional: return false to hide a row
+    void    (*FetchRows)(void* user_data, const int* rows, int count);  // Optional: called before submitting each range of visible rows (in display order), e.g. to load them
+    void    (*SubmitRow)(void* user_data, int row);                     // Submit the cells of one row (TableNextRow() has been called), used by TableSubmitDataSourceRows()
+
+    ImGuiTableDataSource()      { memset(this, 0, sizeof(*this)); }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers (ImGuiOnceUponAFrame, ImGuiTextFilter, ImGuiTextBuffer, ImGuiStorage, ImGuiListClipper, ImColor)
 //-----------------------------------------------------------------------------
@@ -2260,11 +2293,21 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+#ifdef IMGUI_USE_HASHED_STORAGE
+    ImVector<ImU64>                 Index;          // Open addressing table, each slot is (key << 32) | (index in Data + 1), 0 = empty. Power of 2 size.
+    int                             IndexCount;     // Number of pairs of Data referenced by Index. Pairs added directly to Data are indexed on next query.
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    ImGuiStorage()                  { IndexCount = 0; }
+#endif
+
+    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N) (O(1) with IMGUI_USE_HASHED_STORAGE)
     // - Set***() functions find pair, insertion on demand if missing.
     // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
+#ifdef IMGUI_USE_HASHED_STORAGE
+    void                Clear() { Data.clear(); Index.clear(); IndexCount = 0; }
+#else
     void                Clear() { Data.clear(); }
+#endif
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2570,6 +2613,14 @@ struct ImDrawList
     IMGUI_API void  AddBezierCubic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness, int num_segments = 0); // Cubic Bezier (4 control points)
     IMGUI_API void  AddBezierQuadratic(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, ImU32 col, float thickness, int num_segments = 0);               // Quadratic Bezier (3 control points)
 
+    // Batched primitives
+    // - Same output as calling AddRect() (no rounding), AddLine(), AddCircle() or AddText() once per item, for drawing thousands of markers per frame.
+    // - Items are passed as arrays of 'count' elements (one array per field). Outlines are reserved once per batch and written in a single loop.
+    IMGUI_API void  AddRectsBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count, float thickness = 1.0f);
+    IMGUI_API void  AddLinesBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness = 1.0f);
+    IMGUI_API void  AddCirclesBatch(const ImVec2* centers, const float* radii, const ImU32* cols, int count, int num_segments = 0, float thickness = 1.0f);
+    IMGUI_API void  AddTextBatch(const ImVec2* pos, const char* const* texts, const ImU32* cols, int count);   // Current font/size, zero-terminated texts
+
     // Image primitives
     // - Read FAQ to understand what ImTextureID is.
     // - "p_min" and "p_max" represent the upper-left and lower-right corners of the rectangle.
@@ -2634,6 +2685,9 @@ struct ImDrawList
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
     IMGUI_API void  _PathArcToFastEx(const ImVec2& center, float radius, int a_min_sample, int a_max_sample, int a_step);
     IMGUI_API void  _PathArcToN(const ImVec2& center, float radius, float a_min, float a_max, int num_segments);
+    IMGUI_API void  _CalcPolylinePrimCount(int points_count, ImDrawFlags flags, float thickness, int* out_idx_count, int* out_vtx_count) const;
+    IMGUI_API void  _PolylineNoReserve(const ImVec2* points, int points_count, ImU32 col, ImDrawFlags flags, float thickness);
+    IMGUI_API void  _PathStrokeBatch(const int* points_counts, const ImU32* cols, int count, ImDrawFlags flags, float thickness);
 };
 
 // All draw data to render a Dear ImGui frame
@@ -2735,7 +2789,8 @@ enum ImFontAtlasFlags_
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_SignedDistanceField = 1 << 3   // Rasterize glyphs as signed distance fields (edge at 128, see TexSdfPadding) so a single small atlas renders crisp text at any scale. Requires renderer support (imgui_impl_opengl3 thresholds io.Fonts->TexID in its shader). Implies ImFontAtlasFlags_NoBakedLines. stb_truetype builder only.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2824,6 +2879,7 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    int                         TexSdfPadding;      // Distance range in pixels stored around each glyph with ImFontAtlasFlags_SignedDistanceField. Defaults to 4. Text stays crisp up to ~TexSdfPadding times the baked size.
     bool                        Locked;             // Marked as Locked by ImGui::NewFrame() so attempt to modify the atlas will assert.
 
     // [Internal]
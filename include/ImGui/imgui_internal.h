@@ -60,6 +60,12 @@ Index of this file:
 #include <immintrin.h>
 #endif
 
+// Enable NEON intrinsics if available (arm64 only: vsqrtq_f32()/vdivq_f32() are needed to match the scalar ImRsqrt())
+#if defined(__aarch64__) && defined(__ARM_NEON) && !defined(IMGUI_DISABLE_NEON)
+#define IMGUI_ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
 // Visual Studio warnings
 #ifdef _MSC_VER
 #pragma warning (push)
@@ -297,6 +303,28 @@ namespace ImStb
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImU32 seed = 0);
+
+// Compile-time version of ImHashStr() for string literals, e.g. 'constexpr ImGuiID id = ImHashStrConst("Window");' (same result as ImHashStr("Window")).
+// Also useful with PushID(int)/GetID(int) to avoid hashing a long literal every frame: 'ImGui::PushID((int)ImHashStrConst("##player_panel"));'
+constexpr ImGuiID ImHashStrConst(const char* str, ImU32 seed = 0)
+{
+#ifdef IMGUI_USE_CRC32C_HASH
+    const ImU32 poly = 0x82F63B78; // CRC32C (Castagnoli), reflected
+#else
+    const ImU32 poly = 0xEDB88320; // CRC32, reflected
+#endif
+    seed = ~seed;
+    ImU32 crc = seed;
+    for (; *str; str++)
+    {
+        if (str[0] == '#' && str[1] == '#' && str[2] == '#')
+            crc = seed;
+        crc ^= (unsigned char)*str;
+        for (int k = 0; k < 8; k++)
+            crc = (crc & 1) ? (crc >> 1) ^ poly : (crc >> 1);
+    }
+    return ~crc;
+}
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline ImGuiID   ImHash(const void* data, int size, ImU32 seed = 0) { return size ? ImHashData(data, (size_t)size, seed) : ImHashStr((const char*)data, 0, seed); } // [moved to ImHashStr/ImHashData in 1.68]
 #endif
@@ -618,6 +646,43 @@ struct ImSpanAllocator
     inline void  GetSpan(int n, ImSpan<T>* span)    { span->set((T*)GetSpanPtrBegin(n), (T*)GetSpanPtrEnd(n)); }
 };
 
+// Helper: ImGuiFrameArena
+// Bump allocator for frame transient data (see MemAllocFrame()), reset by NewFrame().
+// Requests that don't fit in the current block are served by MemAlloc() and released on Reset(), which then grows the block to the peak usage
+// so the following frames are served without any allocation.
+struct IMGUI_API ImGuiFrameArena
+{
+    char*           Data;       // Block, Capacity bytes
+    int             Size;       // Bytes used in Data
+    int             Capacity;
+    int             Used;       // Bytes requested since last Reset(), including Overflow
+    int             Peak;       // Highest Used value
+    ImVector<void*> Overflow;   // Allocations that didn't fit in Data
+
+    ImGuiFrameArena()           { Data = NULL; Size = Capacity = Used = Peak = 0; }
+    ~ImGuiFrameArena()          { ClearFreeMemory(); }
+    void*           Alloc(size_t size);
+    void            Reset();
+    void            ClearFreeMemory();
+};
+
+#ifdef IMGUI_USE_POOL_ALLOCATOR
+// Statistics of the default allocator when IMGUI_USE_POOL_ALLOCATOR is defined (see GetPoolAllocatorStats()). Shared by all contexts.
+#define IM_POOL_ALLOCATOR_CLASS_COUNT   24
+struct ImGuiPoolAllocatorStats
+{
+    int             AllocCount;                                     // Total number of allocations
+    int             ActiveBytes;                                    // Bytes currently allocated (requested sizes)
+    int             PeakBytes;                                      // Highest ActiveBytes value
+    int             ReservedBytes;                                  // Bytes obtained from malloc(): pool pages + large blocks
+    int             SystemAllocCount;                               // Total number of malloc() calls
+    int             ClassSize[IM_POOL_ALLOCATOR_CLASS_COUNT];       // Slot size of each class
+    int             ClassActive[IM_POOL_ALLOCATOR_CLASS_COUNT];     // Slots in use in each class
+    int             ClassReserved[IM_POOL_ALLOCATOR_CLASS_COUNT];   // Slots reserved in each class
+    int             LargeActive;                                    // Blocks larger than the last class, allocated with malloc()
+};
+#endif
+
 // Helper: ImPool<>
 // Basic keyed storage for contiguous instances, slow/amortized insertion, O(1) indexable, O(Log N) queries by ID over a dense/hot buffer,
 // Honor constructor/destructor. Add/remove invalidate all pointers. Indexes have the same lifetime as the associated object.
@@ -708,6 +773,11 @@ struct ImChunkStream
 #endif
 #define IM_DRAWLIST_ARCFAST_SAMPLE_MAX                          IM_DRAWLIST_ARCFAST_TABLE_SIZE // Sample index _PathArcToFastEx() for 360 angle.
 
+// Number of items collected into ImDrawList::_Path before AddRectsBatch()/AddLinesBatch()/AddCirclesBatch() reserve and write them.
+#ifndef IM_DRAWLIST_BATCH_SIZE
+#define IM_DRAWLIST_BATCH_SIZE                                  256
+#endif
+
 // Data shared between all ImDrawList instances
 // You may want to create your own instance of this if you want to use ImDrawList completely without ImGui. In that case, watch out for future changes to this structure.
 struct IMGUI_API ImDrawListSharedData
@@ -725,6 +795,7 @@ struct IMGUI_API ImDrawListSharedData
     float           ArcFastRadiusCutoff;                        // Cutoff radius after which arc drawing will fallback to slower PathArcTo()
     ImU8            CircleSegmentCounts[64];    // Precomputed segment count for given radius before we calculate it dynamically (to avoid calculation overhead)
     const ImVec4*   TexUvLines;                 // UV of anti-aliased lines in the atlas
+    bool            TessellationSimd;           // Tessellate anti-aliased AddPolyline()/AddConvexPolyFilled() with SSE/NEON when compiled in (output is identical, false to compare against the scalar path)
 
     ImDrawListSharedData();
     void SetCircleTessellationMaxError(float max_error);
@@ -1053,7 +1124,8 @@ enum ImGuiNextWindowDataFlags_
     ImGuiNextWindowDataFlags_HasSizeConstraint  = 1 << 4,
     ImGuiNextWindowDataFlags_HasFocus           = 1 << 5,
     ImGuiNextWindowDataFlags_HasBgAlpha         = 1 << 6,
-    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7
+    ImGuiNextWindowDataFlags_HasScroll          = 1 << 7,
+    ImGuiNextWindowDataFlags_HasRetained        = 1 << 8
 };
 
 // Storage for SetNexWindow** functions
@@ -1073,6 +1145,7 @@ struct ImGuiNextWindowData
     ImGuiSizeCallback           SizeCallback;
     void*                       SizeCallbackUserData;
     float                       BgAlphaVal;             // Override background alpha
+    ImGuiID                     RetainedKeyVal;         // User key for SetNextWindowRetained()
     ImVec2                      MenuBarOffsetMinVal;    // (Always on) This is not exposed publicly, so we don't clear it and it doesn't have a corresponding flag (could we? for consistency?)
 
     ImGuiNextWindowData()       { memset(this, 0, sizeof(*this)); }
@@ -1763,6 +1836,8 @@ struct ImGuiContext
     float                   TooltipSlowDelay;                   // Time before slow tooltips appears (FIXME: This is temporary until we merge in tooltip timer+priority work)
     ImVector<char>          ClipboardHandlerData;               // If no custom clipboard handler is defined
     ImVector<ImGuiID>       MenusIdSubmittedThisFrame;          // A list of menu IDs that were rendered at least once
+    ImGuiID                 RetainedStyleHash;                  // Hash of Style used by retained windows (see SetNextWindowRetained())
+    int                     RetainedStyleHashFrame;             // Frame RetainedStyleHash was computed. Reset to -1 when Style is modified by Push/PopStyleXXX() or Begin/EndDisabled()
 
     // Platform support
     ImGuiPlatformImeData    PlatformImeData;                    // Data updated by current frame
@@ -1808,6 +1883,11 @@ struct ImGuiContext
     int                     WantTextInputNextFrame;
     char                    TempBuffer[1024 * 3 + 1];           // Temporary text buffer
 
+    // Memory
+    ImGuiFrameArena         FrameArena;                         // Transient allocations, see MemAllocFrame()
+    int                     FrameAllocCount;                    // MemAlloc() calls since NewFrame(), copied to IO.MetricsFrameAllocations
+    int                     FrameAllocBytes;
+
     ImGuiContext(ImFontAtlas* shared_font_atlas)
     {
         Initialized = false;
@@ -1929,6 +2009,8 @@ struct ImGuiContext
         ScrollbarClickDeltaToGrabCenter = 0.0f;
         TooltipOverrideCount = 0;
         TooltipSlowDelay = 0.50f;
+        RetainedStyleHash = 0;
+        RetainedStyleHashFrame = -1;
 
         PlatformImeData.InputPos = ImVec2(0.0f, 0.0f);
         PlatformImeDataPrev.InputPos = ImVec2(-1.0f, -1.0f); // Different to ensure initial submission
@@ -1955,6 +2037,7 @@ struct ImGuiContext
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
         memset(TempBuffer, 0, sizeof(TempBuffer));
+        FrameAllocCount = FrameAllocBytes = 0;
     }
 };
 
@@ -2011,6 +2094,27 @@ struct IMGUI_API ImGuiWindowTempData
     ImVector<float>         TextWrapPosStack;       // Store text wrap pos to restore (attention: .back() is not == TextWrapPos)
 };
 
+// Draw list contents of a retained window, recorded at End() and replayed by Begin() while inputs are unchanged (see SetNextWindowRetained())
+struct ImGuiWindowRetainedCache
+{
+    ImGuiID                 Key;                // User key passed to SetNextWindowRetained() this frame, 0 when the window is not retained
+    ImGuiID                 Hash;               // Hash of Key + window/style state the buffers were recorded with. 0 when nothing is recorded
+    ImGuiID                 RecordingHash;      // Hash computed in Begin(), stored into Hash when End() records successfully
+    bool                    Recording;          // Contents are submitted normally this frame and recorded in End()
+    bool                    Replayed;           // Contents were replayed this frame (window->SkipItems is set)
+    int                     VtxStart;           // Draw list sizes at the end of Begin(), where contents start
+    int                     IdxStart;
+    int                     CmdStart;
+    ImVec2                  CursorMaxPos;       // Layout output of the recorded frame, restored on replay so ContentSize stays stable
+    ImVec2                  IdealMaxPos;
+    ImVector<ImDrawVert>    VtxBuffer;
+    ImVector<ImDrawIdx>     IdxBuffer;          // Relative to the first recorded vertex
+    ImVector<ImDrawCmd>     CmdBuffer;          // IdxOffset relative to IdxBuffer, VtxOffset unused
+
+    void    Clear()         { Hash = 0; Recording = Replayed = false; VtxBuffer.resize(0); IdxBuffer.resize(0); CmdBuffer.resize(0); }
+    void    ClearFreeMemory() { Clear(); VtxBuffer.clear(); IdxBuffer.clear(); CmdBuffer.clear(); }
+};
+
 // Storage for one window
 struct IMGUI_API ImGuiWindow
 {
@@ -2106,6 +2210,7 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
+    ImGuiWindowRetainedCache Retained;                          // Retained draw data, see SetNextWindowRetained()
 
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
@@ -2366,6 +2471,12 @@ struct IMGUI_API ImGuiTable
     ImGuiTableColumnSortSpecs   SortSpecsSingle;
     ImVector<ImGuiTableColumnSortSpecs> SortSpecsMulti;     // FIXME-OPT: Using a small-vector pattern would be good.
     ImGuiTableSortSpecs         SortSpecs;                  // Public facing sorts specs, this is what we return in TableGetSortSpecs()
+    ImGuiTableDataSource        DataSource;                 // Copy of the data source passed to TableSetDataSource()
+    ImVector<int>               DataSourceRows;             // Display order of the data source rows (filtered + sorted), rebuilt when DataSourceVersion/DataSourceRowCount/DataSourceSortHash change
+    ImU32                       DataSourceVersion;
+    int                         DataSourceRowCount;
+    ImGuiID                     DataSourceSortHash;         // Hash of the sort specs used to build DataSourceRows
+    bool                        IsDataSourceValid;          // DataSourceRows has been built (cleared by garbage collection)
     ImGuiTableColumnIdx         SortSpecsCount;
     ImGuiTableColumnIdx         ColumnsEnabledCount;        // Number of enabled columns (<= ColumnsCount)
     ImGuiTableColumnIdx         ColumnsEnabledFixedCount;   // Number of enabled columns (<= ColumnsCount)
@@ -2721,6 +2832,7 @@ namespace ImGui
     inline ImGuiTableInstanceData*   TableGetInstanceData(ImGuiTable* table, int instance_no) { if (instance_no == 0) return &table->InstanceDataFirst; return &table->InstanceDataExtra[instance_no - 1]; }
     IMGUI_API void          TableSortSpecsSanitize(ImGuiTable* table);
     IMGUI_API void          TableSortSpecsBuild(ImGuiTable* table);
+    IMGUI_API void          TableDataSourceBuildRows(ImGuiTable* table, const ImGuiTableSortSpecs* sort_specs);
     IMGUI_API ImGuiSortDirection TableGetColumnNextSortDirection(ImGuiTableColumn* column);
     IMGUI_API void          TableFixColumnSortDirection(ImGuiTable* table, ImGuiTableColumn* column);
     IMGUI_API float         TableGetColumnWidthAuto(ImGuiTable* table, ImGuiTableColumn* column);
@@ -2864,6 +2976,11 @@ namespace ImGui
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
     IMGUI_API void          GcAwakeTransientWindowBuffers(ImGuiWindow* window);
 
+    // Memory
+#ifdef IMGUI_USE_POOL_ALLOCATOR
+    IMGUI_API void          GetPoolAllocatorStats(ImGuiPoolAllocatorStats* out_stats);
+#endif
+
     // Debug Tools
     IMGUI_API void          ErrorCheckEndFrameRecover(ImGuiErrorLogCallback log_callback, void* user_data = NULL);
     IMGUI_API void          ErrorCheckEndWindowRecover(ImGuiErrorLogCallback log_callback, void* user_data = NULL);
@@ -11,6 +11,8 @@
 // User libs
 #include "utils.h"
 #include <android/native_window.h>
+#include "raw_frame.h"
+#include "record_config.h"
 
 struct MDisplayInfo {
     uint32_t width{0};
@@ -29,6 +31,12 @@ struct FuncPointer {
     void *func_stopRecord;
     void *func_initRecord;
     void *func_getRecordNativeWindow;
+    void *func_initRecordConfig;
+    // 原始帧采集，旧版本的库里没有这几个符号(为空)
+    void *func_initRawCapture;
+    void *func_acquireRawFrame;
+    void *func_releaseRawFrame;
+    void *func_stopRawCapture;
 };
 
 class ExternFunction {
@@ -77,6 +85,12 @@ public:
     void initRecord(const char *bitRate, float fps,
                     uint32_t videoWidth = 0, uint32_t videoHeight = 0);
 
+    /**
+     * 录屏初始化(裁剪区域、输出缩放、跳帧)
+     * @return 库不支持裁剪/缩放/跳帧或初始化失败时返回false
+     */
+    bool initRecord(const RecordConfig &config);
+
     /**
      * 开始录屏
      * @param gStopRequested
@@ -95,6 +109,38 @@ public:
      */
     ANativeWindow *getRecordNativeWindow();
 
+    /**
+     * 原始帧采集初始化(不能和录屏同时使用)
+     * @param width 帧宽度，设置0为默认屏幕宽
+     * @param height 帧高度，设置0为默认屏幕高
+     * @param format RawFrame_RGBA_8888 或 RawFrame_YUV_420_888
+     * @param maxImages 调用方最多同时持有的帧数
+     * @return 库不支持或创建失败时返回false
+     */
+    bool initRawCapture(uint32_t width = 0, uint32_t height = 0, int32_t format = RawFrame_RGBA_8888,
+                        int32_t maxImages = 4);
+
+    /**
+     * 取最新的一帧，没有新帧时最多等待 timeoutMs 毫秒
+     * @return 超时、已停止或持有的帧达到 maxImages 时返回false
+     */
+    bool acquireRawFrame(RawFrame *frame, int32_t timeoutMs);
+
+    /**
+     * 把帧还给采集端，之后 frame 中的指针全部失效
+     */
+    void releaseRawFrame(RawFrame *frame);
+
+    /**
+     * 原始帧采集结束调用，会等待其他线程还持有的帧释放(最多1秒)
+     */
+    void stopRawCapture();
+
+    /**
+     * 当前系统版本的库是否支持原始帧采集
+     */
+    bool hasRawCapture();
+
 
 };
 
@@ -0,0 +1,36 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RAW_FRAME_H
+#define NATIVESURFACE_RAW_FRAME_H
+
+#include <cstdint>
+
+struct AHardwareBuffer;
+
+// 原始帧格式，取值和 AImage 的 AIMAGE_FORMAT_* 一致
+enum RawFrameFormat {
+    RawFrame_RGBA_8888 = 0x1,       // 1个平面，pixelStride 4
+    RawFrame_YUV_420_888 = 0x23,    // 3个平面(Y/U/V)，UV 平面可能交错(pixelStride 2)
+};
+
+/**
+ * 原始帧(和 aosp_res 库里的 RawFrame 布局一致，不能改动)
+ * planes 直接指向 AHardwareBuffer 映射出来的内存，释放前一直有效，读取时不需要拷贝
+ * image 是库内部的 AImage 句柄，调用方不要修改
+ */
+struct RawFrame {
+    AHardwareBuffer *buffer;
+    uint8_t *planes[3];
+    int32_t rowStride[3];
+    int32_t pixelStride[3];
+    int32_t planeCount;
+    uint32_t width;
+    uint32_t height;
+    int32_t format;
+    int64_t timestampNs;
+    void *image;
+};
+
+#endif //NATIVESURFACE_RAW_FRAME_H
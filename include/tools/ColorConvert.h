@@ -0,0 +1,53 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_COLORCONVERT_H
+#define NATIVESURFACE_COLORCONVERT_H
+
+#include <cstdint>
+
+// 输出像素的通道顺序
+enum ColorConvertOrder {
+    ColorConvert_BGR = 0,       // OpenCV CV_8UC3 默认顺序
+    ColorConvert_RGB,           // ImageTexture_RGB
+    ColorConvert_BGRA,          // A 固定为 255
+    ColorConvert_RGBA,          // ImageTexture_RGBA
+};
+
+/**
+ * YUV420P(I420) 转 RGB
+ * 全范围 BT.601(JPEG)系数，Q14 定点:
+ *   R = Y + ((22970 * (V - 128) + 8192) >> 14)
+ *   G = Y + ((-5638 * (U - 128) - 11700 * (V - 128) + 8192) >> 14)
+ *   B = Y + ((29032 * (U - 128) + 8192) >> 14)
+ * 结果截断到 0~255；arm 上用 NEON，x86 上用 SSE2，其他平台用标量，三种实现逐字节一致
+ *
+ * 三个平面各自带行宽(AVFrame 的 data/linesize 可以直接传入，不需要先拷贝成连续的缓冲)，
+ * 宽高为奇数时色度平面的宽高向上取整
+ */
+class ColorConvert {
+public:
+    /**
+     * @param dstStride 输出每行的字节数
+     */
+    static void yuv420pToRgb(const uint8_t *y, int yStride, const uint8_t *u, int uStride, const uint8_t *v,
+                             int vStride, uint8_t *dst, int dstStride, int width, int height,
+                             ColorConvertOrder order);
+
+    /**
+     * 标量实现(参考实现，用于校验)
+     */
+    static void yuv420pToRgbScalar(const uint8_t *y, int yStride, const uint8_t *u, int uStride, const uint8_t *v,
+                                   int vStride, uint8_t *dst, int dstStride, int width, int height,
+                                   ColorConvertOrder order);
+
+    /**
+     * 当前使用的实现: "neon" / "ssse3" / "sse2" / "scalar"
+     */
+    static const char *simdName();
+
+    static int channels(ColorConvertOrder order);
+};
+
+#endif //NATIVESURFACE_COLORCONVERT_H
@@ -0,0 +1,119 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_COMPRESS_H
+#define NATIVESURFACE_COMPRESS_H
+
+#include <cstdint>
+#include <vector>
+#include "FrameBuffer.h"
+
+struct z_stream_s;
+
+// 压缩算法，取值写在 DataEnc 头里，不能改动
+enum CompressCodec {
+    Compress_None = 0,
+    Compress_Zlib = 1,          // raw deflate(没有zlib头和校验)，默认级别1
+    Compress_Lz4 = 2,           // LZ4 块格式，和 liblz4 的 LZ4_decompress_safe 兼容
+    Compress_CodecCount
+};
+
+struct CompressStats {
+    uint64_t compressCalls = 0;
+    uint64_t decompressCalls = 0;
+    uint64_t inputBytes = 0;        // 压缩前
+    uint64_t outputBytes = 0;       // 压缩后
+    uint64_t errors = 0;
+    double compressMs = 0.0;
+    double decompressMs = 0.0;
+};
+
+/**
+ * 压缩上下文: z_stream 和 LZ4 哈希表只初始化一次，之后的调用复用(deflateReset/inflateReset)，不再每次分配
+ *
+ * 单包模式(默认): 每次 compress/decompress 的数据互相独立
+ * 流模式(setStreaming(true)): 每个包引用之前的包(zlib 共享滑动窗口，LZ4 保留最近64KB作为字典)，
+ * 遥测这类很小、内容相似的包压缩率高很多；两端必须按同样的顺序处理全部包，连接断开后两端都 resetStream。
+ * 压缩和解压的状态分开，一个上下文可以同时发送一路、接收一路
+ *
+ * 出错时打印并返回-1；不是线程安全的，一个线程使用
+ */
+class CompressContext {
+public:
+    /**
+     * @param zlibLevel deflate 级别 1~9，1 最快
+     */
+    explicit CompressContext(int zlibLevel = 1);
+
+    ~CompressContext();
+
+    CompressContext(const CompressContext &) = delete;
+
+    CompressContext &operator=(const CompressContext &) = delete;
+
+    /**
+     * @param dstCapacity 不小于 bound(codec, srcLen) 时一定成功
+     * @return 压缩后的字节数
+     */
+    int compress(CompressCodec codec, const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    /**
+     * @return 解压后的字节数，数据损坏或 dstCapacity 不够时返回-1
+     */
+    int decompress(CompressCodec codec, const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    /**
+     * 压缩帧缓冲的整块数据(所有平面，包括行尾填充)
+     */
+    int compressFrame(CompressCodec codec, const FrameBuffer &frame, uint8_t *dst, int dstCapacity);
+
+    /**
+     * 直接解压到从 FrameBufferPool 取出的帧缓冲(格式和尺寸已经设置好)，解压后的大小必须等于 frame.size
+     */
+    bool decompressFrame(CompressCodec codec, const uint8_t *src, int srcLen, FrameBuffer &frame);
+
+    void setStreaming(bool streaming);
+
+    bool isStreaming() const;
+
+    /**
+     * 清空流模式的窗口(两端同时调用)
+     */
+    void resetStream();
+
+    CompressStats getStats() const;
+
+    /**
+     * 最坏情况下压缩后的大小
+     */
+    static int bound(CompressCodec codec, int srcLen);
+
+    static const char *getCodecName(CompressCodec codec);
+
+private:
+    bool initDeflate();
+
+    bool initInflate();
+
+    int deflateData(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    int inflateData(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    int lz4Compress(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    int lz4Decompress(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity);
+
+    int zlibLevel;
+    bool streaming = false;
+    z_stream_s *deflater = nullptr;
+    z_stream_s *inflater = nullptr;
+    std::vector<int32_t> lz4Table;          // 4字节序列的哈希 -> 位置(只是候选，使用前比较内容)
+    std::vector<uint8_t> lz4EncodeHistory;  // 流模式: 已经压缩过的数据(最近的作为字典)
+    std::vector<uint8_t> lz4DecodeHistory;  // 流模式: 已经解压的数据
+    size_t lz4EncodeSize = 0;               // 历史里有效的字节(vector 只增长不缩小)
+    size_t lz4DecodeSize = 0;
+    CompressStats stats;
+};
+
+#endif //NATIVESURFACE_COMPRESS_H
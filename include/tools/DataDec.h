@@ -8,7 +8,9 @@
 #define WZ_CHEAT_DATADEC_H
 
 #include <string>
+#include <vector>
 #include "Type.h"
+#include "Compress.h"
 
 using namespace std;
 
@@ -21,6 +23,7 @@ private:
     mbyte *m_bytes;
     int index = HEADER_LEN;
     int m_byteLen = 0;
+    std::vector<mbyte> m_decoded;
 
 public:
     int getCmd();
@@ -31,6 +34,19 @@ public:
 
     int getLength();
 
+    /**
+     * ͷ¼ѹ㷨(DataEnc::compress)
+     */
+    CompressCodec getCodec();
+
+    /**
+     * ݰѹ֮ԭʼݶȡ(ݸΪָڲ壬getData ȡ)
+     * @return ûѹʱֱӷtrueʱfalse
+     */
+    bool decompress(CompressContext &context);
+
+    mbyte *getData();
+
     DataDec();
 
     DataDec(mbyte *bytes, int bytelen);
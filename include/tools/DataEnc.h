@@ -3,7 +3,9 @@
 //
 
 #include "Type.h"
+#include "Compress.h"
 #include <string>
+#include <vector>
 
 #ifndef WZ_CHEAT_DATAENC_H
 #define WZ_CHEAT_DATAENC_H
@@ -22,6 +24,9 @@ private:
 
     int m_byteLen = 0;
 
+    CompressCodec m_codec = Compress_None;
+    std::vector<mbyte> m_packed;
+
 public:
     DataEnc();
 
@@ -64,6 +69,18 @@ public:
 
     static int headerSize();
 
+    /**
+     * 压缩已经写入的数据(写完所有数据后、getData 之前调用)，算法记在头里长度字段的高4位
+     * 压缩后的数据: int 原始长度 + 压缩数据；单包模式下没有变小时不压缩
+     * @return 压缩失败或缓冲放不下时返回false(数据不变，流模式下两端都要 resetStream)
+     */
+    bool compress(CompressContext &context, CompressCodec codec);
+
+    CompressCodec getCodec() const;
+
+    static const int CODEC_SHIFT = 28;          // 长度字段的高4位是压缩算法
+    static const int LENGTH_MASK = 0x0FFFFFFF;
+
     int getDataIndex() const;
 
     void setDataIndex(int i);
@@ -0,0 +1,163 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_FRAMEBUFFER_H
+#define NATIVESURFACE_FRAMEBUFFER_H
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+// 帧缓冲的像素格式
+enum FrameBufferFormat {
+    FrameBuffer_YUV420P = 0,    // I420 三个平面，色度宽高向上取整(ffmpeg 解码输出)
+    FrameBuffer_RGB24,          // ImageTexture_RGB
+    FrameBuffer_BGR24,          // OpenCV CV_8UC3
+    FrameBuffer_RGBA,           // ImageTexture_RGBA
+    FrameBuffer_GRAY8,          // OpenCV CV_8UC1
+};
+
+struct FrameBufferStats {
+    uint64_t allocations = 0;   // 新分配的缓冲
+    uint64_t reuses = 0;        // 复用空闲缓冲
+    uint64_t releases = 0;      // 最后一个引用释放
+    uint64_t freed = 0;         // 空闲缓冲超过上限或尺寸不够被释放
+    size_t allocatedBytes = 0;  // 当前分配的内存(持有中 + 空闲)
+    int outstanding = 0;        // 持有中的缓冲
+    int maxOutstanding = 0;     // 持有缓冲数的最大值
+    int freeCount = 0;          // 空闲缓冲
+};
+
+class FrameBufferPool;
+
+struct FrameBufferShared;
+
+/**
+ * 帧缓冲: 一块64字节对齐的内存按格式分成1~3个平面，行宽按 FrameBufferPool 的对齐补齐
+ * 由 FrameBufferRef 引用计数，最后一个引用释放时回到池里；平面末尾多留64字节，SIMD/sws_scale 越界读取不会出错
+ * 只有持有唯一引用时才能写入
+ */
+struct FrameBuffer {
+    FrameBufferFormat format = FrameBuffer_RGB24;
+    int width = 0;
+    int height = 0;
+    int planeCount = 0;
+    uint8_t *planes[3] = {nullptr, nullptr, nullptr};
+    int strides[3] = {0, 0, 0};
+    uint8_t *data = nullptr;    // 整块内存(planes[0] 起始)
+    size_t size = 0;            // 当前格式使用的字节数
+    size_t capacity = 0;        // 分配的字节数
+    uint64_t seq = 0;           // 生产端填写的帧序号
+    int64_t timestampNs = 0;    // 生产端填写的时间戳
+
+    /**
+     * 每像素字节数(YUV420P 为 Y 平面的1字节)
+     */
+    static int bytesPerPixel(FrameBufferFormat format);
+
+    static const char *getFormatName(FrameBufferFormat format);
+
+private:
+    friend class FrameBufferRef;
+
+    friend class FrameBufferPool;
+
+    std::atomic<int> refs{0};
+    std::shared_ptr<FrameBufferShared> owner;
+};
+
+/**
+ * 帧缓冲的引用，可以拷贝后交给其他线程
+ * 引用可以比 FrameBufferPool 活得更久，池销毁后最后一个引用直接释放内存
+ */
+class FrameBufferRef {
+public:
+    FrameBufferRef() = default;
+
+    FrameBufferRef(const FrameBufferRef &other);
+
+    FrameBufferRef(FrameBufferRef &&other) noexcept;
+
+    FrameBufferRef &operator=(const FrameBufferRef &other);
+
+    FrameBufferRef &operator=(FrameBufferRef &&other) noexcept;
+
+    ~FrameBufferRef();
+
+    void reset();
+
+    FrameBuffer *get() const {
+        return buffer;
+    }
+
+    FrameBuffer *operator->() const {
+        return buffer;
+    }
+
+    explicit operator bool() const {
+        return buffer != nullptr;
+    }
+
+    int useCount() const;
+
+    /**
+     * 交出引用但不减少计数，给 C 回调(av_buffer_create 的 free)保存，之后用 adopt 接回
+     */
+    FrameBuffer *detach();
+
+    /**
+     * 接管 detach 交出的引用(不增加计数)
+     */
+    static FrameBufferRef adopt(FrameBuffer *buffer);
+
+    /**
+     * 增加一个引用
+     */
+    static FrameBufferRef retain(FrameBuffer *buffer);
+
+private:
+    explicit FrameBufferRef(FrameBuffer *buffer) : buffer(buffer) {}
+
+    FrameBuffer *buffer = nullptr;
+};
+
+/**
+ * 帧缓冲池: 按格式和尺寸复用缓冲，解码、分析、显示之间传递引用，不拷贝像素
+ * acquire 和引用的释放可以在任意线程
+ */
+class FrameBufferPool {
+public:
+    /**
+     * @param maxFree 最多保留的空闲缓冲，超出的直接释放
+     * @param strideAlign 行宽对齐(像素)，行宽 = 向上取整(宽度, strideAlign) * 每像素字节数；
+     *                    ffmpeg 解码缓冲需要64，传1得到紧凑的行(兼容只认宽高的旧接口)
+     */
+    explicit FrameBufferPool(int maxFree = 4, int strideAlign = 64);
+
+    ~FrameBufferPool();
+
+    /**
+     * 取一块缓冲(优先复用同格式同尺寸的空闲缓冲，其次复用容量足够的)
+     * @return 分配失败时返回空引用
+     */
+    FrameBufferRef acquire(FrameBufferFormat format, int width, int height);
+
+    /**
+     * 缓冲是否由这个池分配(只比较地址，不访问 buffer)
+     */
+    bool owns(const FrameBuffer *buffer) const;
+
+    FrameBufferStats getStats() const;
+
+    int getStrideAlign() const;
+
+private:
+    std::shared_ptr<FrameBufferShared> shared;
+    int strideAlign;
+};
+
+#endif //NATIVESURFACE_FRAMEBUFFER_H
@@ -0,0 +1,49 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_FRAMEBUFFERVIEWS_H
+#define NATIVESURFACE_FRAMEBUFFERVIEWS_H
+
+#include "FrameBuffer.h"
+#include <opencv2/core.hpp>
+
+extern "C" {
+#include "libavcodec/avcodec.h"
+#include "libavutil/frame.h"
+};
+
+/**
+ * FrameBuffer 和 ffmpeg/OpenCV 之间的零拷贝视图
+ * 只依赖 ffmpeg 和 OpenCV 的部分放在这里，FrameBuffer 本身在没有这两个库的 Linux 基准测试里也能用
+ */
+class FrameBufferViews {
+public:
+    static AVPixelFormat toAVPixelFormat(FrameBufferFormat format);
+
+    /**
+     * 让 AVFrame 直接指向帧缓冲: frame->buf[0] 持有一个引用，av_frame_unref 时释放
+     * @param frame 空的 AVFrame(av_frame_alloc 或 av_frame_unref 之后)
+     */
+    static bool toAVFrame(const FrameBufferRef &buffer, AVFrame *frame);
+
+    /**
+     * 取回 AVFrame 所在的帧缓冲(getBuffer2 分配的，或 toAVFrame 包装的)
+     * @return 不是这个池的缓冲时返回空引用
+     */
+    static FrameBufferRef fromAVFrame(const FrameBufferPool &pool, const AVFrame *frame);
+
+    /**
+     * cv::Mat 头(step 为缓冲行宽)，不持有引用，使用期间 buffer 必须保持有效
+     * @param plane YUV420P 的平面序号，其他格式只有平面0
+     */
+    static cv::Mat toMat(const FrameBufferRef &buffer, int plane = 0);
+
+    /**
+     * AVCodecContext::get_buffer2 回调，ctx->opaque 指向 FrameBufferPool(行宽对齐64)
+     * 解码器直接写进池里的缓冲；不是 YUV420P 或解码器不支持 DR1 时使用默认分配
+     */
+    static int getBuffer2(AVCodecContext *ctx, AVFrame *frame, int flags);
+};
+
+#endif //NATIVESURFACE_FRAMEBUFFERVIEWS_H
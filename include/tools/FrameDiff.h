@@ -0,0 +1,154 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_FRAMEDIFF_H
+#define NATIVESURFACE_FRAMEDIFF_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "FrameBuffer.h"
+#include "raw_frame.h"
+
+struct FrameDiffOptions {
+    int tileSize = 32;              // 块边长(像素)
+    int rowStep = 1;                // 每隔几行比较一行，>1 时每帧换一组行(单行的变化最多晚 rowStep-1 帧发现)
+    float meanThreshold = 1.5f;     // 块内平均每字节差值不小于它时为脏块(大面积的渐变)
+    int peakThreshold = 32;         // 块内单个字节差值不小于它时为脏块(光标、文字等小面积变化)
+};
+
+// 一帧的比较结果，引用在下一次 update 之前有效
+struct FrameDiffResult {
+    bool changed = false;           // 至少有一个脏块
+    bool reset = false;             // 第一帧或尺寸/格式变化，全部是脏块
+    int width = 0;
+    int height = 0;
+    int tileSize = 0;
+    int tileCols = 0;
+    int tileRows = 0;
+    int dirtyTiles = 0;
+    std::vector<uint8_t> dirty;     // tileRows * tileCols，1 为脏块
+    int dirtyX = 0;                 // 脏块外接矩形(像素，已裁到画面内)
+    int dirtyY = 0;
+    int dirtyWidth = 0;
+    int dirtyHeight = 0;
+
+    bool isDirty(int col, int row) const {
+        return dirty[row * tileCols + col] != 0;
+    }
+
+    /**
+     * 像素矩形是否和脏块相交(分析端判断某个区域要不要重新计算)
+     */
+    bool intersects(int x, int y, int w, int h) const;
+};
+
+struct FrameDiffStats {
+    uint64_t frames = 0;
+    uint64_t changedFrames = 0;
+    uint64_t unchangedFrames = 0;
+    uint64_t dirtyTiles = 0;        // 累计脏块
+    uint64_t comparedBytes = 0;     // 累计参与比较的字节
+    double lastMs = 0.0;
+    double totalMs = 0.0;
+};
+
+/**
+ * 帧差异检测: 把画面分成 tileSize 的块，和参考帧逐块求绝对差之和(SAD)和最大差值，超过阈值的块标为脏块
+ *
+ * 参考帧只在脏块处更新为当前帧，缓慢的渐变会累积到超过阈值，参考帧始终等于下游最后收到的内容；
+ * 单平面比较: YUV 只比较Y平面(亮度)，RGBA/RGB 等直接比较所有通道的字节，不做颜色转换。
+ * SAD 在 arm 上用 NEON(vabdq_u8)，x86 上用 SSE2(_mm_sad_epu8)，其他平台用标量，结果逐字节一致
+ *
+ * 发送端跳过没有变化的帧或只发脏块，分析端跳过没有变化的区域，显示端只上传脏块外接矩形
+ * 不是线程安全的，一个线程使用
+ */
+class FrameDiff {
+public:
+    explicit FrameDiff(const FrameDiffOptions &options = FrameDiffOptions());
+
+    /**
+     * 和参考帧比较并更新参考帧
+     * @param stride 每行字节数
+     * @param bytesPerPixel 每像素字节数(灰度/Y平面为1)
+     */
+    const FrameDiffResult &update(const uint8_t *data, int stride, int width, int height, int bytesPerPixel);
+
+    /**
+     * 帧缓冲的第一个平面(YUV420P 为Y平面)
+     */
+    const FrameDiffResult &update(const FrameBuffer &buffer);
+
+    /**
+     * 原始帧的第一个平面(RGBA_8888 或 YUV_420_888 的Y平面)
+     */
+    const FrameDiffResult &update(const RawFrame &frame);
+
+    /**
+     * 丢掉参考帧，下一帧全部是脏块(下游重新连接时调用)
+     */
+    void reset();
+
+    const FrameDiffResult &getResult() const;
+
+    FrameDiffStats getStats() const;
+
+    const FrameDiffOptions &getOptions() const;
+
+    /**
+     * 两段内存的绝对差之和，*peak 更新为其中最大的单字节差值
+     */
+    static uint32_t sad(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak);
+
+    /**
+     * 标量实现(参考实现，用于校验)
+     */
+    static uint32_t sadScalar(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak);
+
+    /**
+     * 当前使用的实现: "neon" / "sse2" / "scalar"
+     */
+    static const char *simdName();
+
+    /**
+     * 脏块表按位打包(行优先，每字节低位在前)，用于发送
+     * @return 写入的字节数，capacity 不够时返回-1
+     */
+    static int packDirtyMap(const FrameDiffResult &result, uint8_t *out, int capacity);
+
+    /**
+     * 解包 packDirtyMap 的数据
+     * @return 解出的脏块数，数据长度不够时返回-1
+     */
+    static int unpackDirtyMap(const uint8_t *in, int length, int tileCols, int tileRows,
+                              std::vector<uint8_t> &dirty);
+
+    /**
+     * 按脏块表把块的像素依次拷贝成紧凑的数据(每块逐行，边缘块按实际宽高)
+     * @param out 为空时只计算需要的字节数
+     * @return 字节数
+     */
+    static size_t gatherTiles(const std::vector<uint8_t> &dirty, int tileSize, const uint8_t *data, int stride,
+                              int width, int height, int bytesPerPixel, uint8_t *out);
+
+    /**
+     * gatherTiles 的逆操作，把块写回画面
+     * @return 读取的字节数，length 不够时返回0
+     */
+    static size_t scatterTiles(const std::vector<uint8_t> &dirty, int tileSize, const uint8_t *in, size_t length,
+                               uint8_t *data, int stride, int width, int height, int bytesPerPixel);
+
+private:
+    void resize(int width, int height, int bytesPerPixel);
+
+    FrameDiffOptions options;
+    FrameDiffResult result;
+    FrameDiffStats stats;
+    std::vector<uint8_t> reference;
+    int referenceStride = 0;
+    int bytesPerPixel = 0;
+    int phase = 0;
+};
+
+#endif //NATIVESURFACE_FRAMEDIFF_H
@@ -8,6 +8,7 @@
 
 #include <cstdio>
 #include <unistd.h>
+#include "FrameBuffer.h"
 
 extern "C" {
 #include "libavcodec/avcodec.h"
@@ -29,8 +30,26 @@ public :
 
     void decode(unsigned char *inputbuff, size_t size);
 
+    /**
+     * 最新一帧的RGB数据(紧凑的行)，下一次 decode 之后可能被复用，需要跨帧持有时用 getFrame
+     */
     uint8_t *getDecBuffer();
 
+    /**
+     * 最新一帧的RGB缓冲(FrameBuffer_RGB24)，持有引用期间内容不变，可以交给分析/显示线程
+     */
+    FrameBufferRef getFrame() const;
+
+    /**
+     * 最新一帧的解码输出(FrameBuffer_YUV420P)，解码器直接写入池里的缓冲，不经过拷贝
+     * 解码器使用默认分配(非 YUV420P 输出)时为空
+     */
+    FrameBufferRef getYuvFrame() const;
+
+    FrameBufferStats getRgbStats() const;
+
+    FrameBufferStats getYuvStats() const;
+
     int getWidth() const;
 
     void setWidth(int width);
@@ -41,18 +60,26 @@ public :
 
 private:
 
+    /**
+     * 把解码输出转换到 rgbPool 的新缓冲
+     */
+    bool convertFrame();
+
     const AVCodec *codec;
     AVCodecContext *c = nullptr;
     int frame_count;
     AVFrame *frame;
     AVPacket avpkt;
-    AVFrame *pFrameRGB;
 
-    int RGBsize;
-    int width;
-    int height;
-    uint8_t *out_buffer = nullptr;
-    struct SwsContext *img_convert_ctx;
+    int width = 0;
+    int height = 0;
+    // 解码器参考帧也在池里，空闲缓冲留够 h264 的最大参考帧数
+    FrameBufferPool yuvPool{20, 64};
+    // 行宽不对齐，getDecBuffer 保持原来的紧凑RGB
+    FrameBufferPool rgbPool{4, 1};
+    FrameBufferRef rgbFrame;
+    FrameBufferRef yuvFrame;
+    struct SwsContext *img_convert_ctx = nullptr;
     bool ready;
 };
 
@@ -10,13 +10,45 @@
 #include <dlfcn.h>
 #include <GLES3/gl32.h>
 #include <string>
+#include <atomic>
 #include <imgui.h>
+#include "FrameBuffer.h"
 
 using namespace std;
 
+// 纹理格式，压缩格式按块存储，GPU直接采样不需要解压
+enum ImageTextureFormat {
+    ImageTexture_RGB = 0,       // setBuffer 默认格式，3字节/像素
+    ImageTexture_RGBA,          // 4字节/像素
+    ImageTexture_BGR,           // OpenCV CV_8UC3，按RGB上传，纹理swizzle交换R/B，不做转换
+    ImageTexture_BGRA,          // OpenCV CV_8UC4
+    ImageTexture_GRAY,          // OpenCV CV_8UC1，单通道上传，swizzle成灰度
+    ImageTexture_ETC2_RGB,      // 4x4块8字节(0.5字节/像素)，GLES 3.0 必须支持
+    ImageTexture_ETC2_RGBA,     // 4x4块16字节(1字节/像素)，GLES 3.0 必须支持
+    ImageTexture_ASTC_4x4,      // 4x4块16字节(1字节/像素)，需要 GL_KHR_texture_compression_astc_ldr
+    ImageTexture_ASTC_6x6,      // 6x6块16字节(0.44字节/像素)
+    ImageTexture_ASTC_8x8,      // 8x8块16字节(0.25字节/像素)
+    ImageTexture_FormatCount
+};
+
 class ImageTexture {
 private:
-    GLuint my_opengl_texture;
+    GLuint my_opengl_texture = 0;
+    int width = 0;
+    int height = 0;
+    ImageTextureFormat format = ImageTexture_RGB;
+    size_t memoryBytes = 0;
+    GLint swizzleState[4] = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+
+    static std::atomic<size_t> totalMemoryBytes;
+
+    bool prepareTexture();
+
+    // 只在通道映射变化时调用 glTexParameteri
+    void setSwizzle(const GLint swizzle[4]);
+
+    void setMemoryBytes(size_t bytes);
+
 public:
     ~ImageTexture();
 
@@ -26,7 +58,77 @@ public:
 
     void *getOpenglTexture() const;
 
+    /**
+     * 上传RGB图像，重复调用时复用同一个纹理
+     */
     void setBuffer(uint8_t *buffer, int width, int height);
+
+    /**
+     * 上传未压缩图像，尺寸和格式不变时用 glTexSubImage2D 更新，不重新分配纹理
+     * @param format ImageTexture_RGB/RGBA/BGR/BGRA/GRAY
+     */
+    bool setPixels(ImageTextureFormat format, const uint8_t *pixels, int width, int height);
+
+    /**
+     * 上传带行宽的未压缩图像(GL_UNPACK_ROW_LENGTH)，不需要先拷贝成紧凑的行
+     * @param rowStride 每行字节数，必须是每像素字节数的整数倍
+     */
+    bool setPixels(ImageTextureFormat format, const uint8_t *pixels, int width, int height, int rowStride);
+
+    /**
+     * 只更新纹理的一个矩形区域(FrameDiff 的脏块外接矩形)，纹理的格式必须相同
+     * @param pixels 整幅图像的起始地址，按 rowStride 定位到 (x, y)
+     * @return 纹理没有创建、格式不同或区域越界时返回false
+     */
+    bool updateRegion(ImageTextureFormat format, const uint8_t *pixels, int rowStride, int x, int y, int width,
+                      int height);
+
+    /**
+     * 直接上传帧缓冲，YUV420P 只上传Y平面(灰度)
+     */
+    bool setFrame(const FrameBufferRef &frame);
+
+    /**
+     * 上传压缩数据(单层，没有mipmap)
+     * @param size 数据大小，必须等于 compressedSize(format, width, height)
+     * @return 格式不支持或数据大小不对时返回false
+     */
+    bool setCompressed(ImageTextureFormat format, const uint8_t *data, size_t size, int width, int height);
+
+    /**
+     * 从 KTX(1.1) 或 .astc 文件数据上传压缩纹理，KTX包含mipmap时全部上传
+     */
+    bool loadCompressed(const uint8_t *data, size_t size);
+
+    bool loadCompressedFile(const char *path);
+
+    int getWidth() const;
+
+    int getHeight() const;
+
+    ImageTextureFormat getFormat() const;
+
+    /**
+     * 纹理占用的显存(按格式计算，包括mipmap)
+     */
+    size_t getMemoryBytes() const;
+
+    /**
+     * 所有 ImageTexture 占用的显存
+     */
+    static size_t getTotalMemoryBytes();
+
+    /**
+     * 当前GL上下文是否支持该格式(压缩格式查询 GL_COMPRESSED_TEXTURE_FORMATS)
+     */
+    static bool isFormatSupported(ImageTextureFormat format);
+
+    /**
+     * 指定格式和尺寸的数据大小(字节)
+     */
+    static size_t compressedSize(ImageTextureFormat format, int width, int height);
+
+    static const char *getFormatName(ImageTextureFormat format);
 };
 
 #endif //NATIVESURFACE_IMAGETEXTURE_H
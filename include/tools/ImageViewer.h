@@ -7,29 +7,62 @@
 
 #include <opencv2/opencv.hpp>
 #include <string>
+#include <atomic>
+#include "FrameBuffer.h"
+#include "TextureCache.h"
 
 using namespace std;
 
+class OverlayLayer;
+
+/**
+ * 图像查看器: 主图层在自己的线程上渲染，imshow 只发布帧句柄，不等待渲染
+ * 每个窗口名一个持久纹理，只有新发布的帧才上传；BGR/GRAY/BGRA 直接上传(纹理swizzle)，不做颜色转换
+ *
+ * cv::Mat 发布时拷贝到池里的帧缓冲，imshow 返回后就可以改写(video.read 复用同一个 Mat)；
+ * 不想多一次拷贝时用 FrameBufferPool + imshow(name, FrameBufferRef)
+ */
 class ImageViewer {
 private:
 
     bool log = true;
-    // dynamic contents
-    vector<string> frame_names;
-    vector<cv::Mat *> frames;
-    float gain;
+    OverlayLayer *layer = nullptr;
+    // 存放 cv::Mat 的拷贝，等待上传的帧持有其中的缓冲
+    FrameBufferPool frames;
+    TextureCache textures;
+    // 没有名字的窗口按 show 之间的调用顺序编号
+    int unnamed = 0;
+    std::atomic<float> gain;
 
     void showMainContents();
 
 public:
     ImageViewer();
 
-    void imshow(string, cv::Mat &frame);
+    void imshow(string frame_name, cv::Mat &frame);
+
+    /**
+     * @param version 内容版本，数据地址和版本都没变时不重新上传(静态图片每帧都 imshow 时使用)
+     */
+    void imshow(string frame_name, cv::Mat &frame, uint64_t version);
 
     void imshow(cv::Mat &frame);
 
+    /**
+     * 显示帧缓冲(持有引用直到被下一帧替换)
+     */
+    void imshow(string frame_name, const FrameBufferRef &frame);
+
+    /**
+     * 通知渲染线程有新帧，立即返回
+     */
     void show();
 
+    /**
+     * 上传统计
+     */
+    TextureCacheStats getStats() const;
+
     float getGain();
 
     void shutdown();
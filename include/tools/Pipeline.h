@@ -0,0 +1,173 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_PIPELINE_H
+#define NATIVESURFACE_PIPELINE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include "ThreadPool.h"
+#include "FrameBuffer.h"
+
+#define PIPELINE_FRAME_SLOTS 4
+
+// 阶段的执行方式
+enum PipelineStageMode {
+    PipelineStage_Serial = 0,   // 同一时间只处理一帧，并且按帧序号的顺序(解码、显示、写文件)
+    PipelineStage_Parallel,     // 多帧同时处理，完成顺序不固定(分析)
+};
+
+/**
+ * 在流水线里传递的一帧
+ * buffers 按约定的槽位保存各阶段的输出(如 0 原始帧、1 解码后、2 分析结果)，帧完成后全部释放
+ */
+struct PipelineFrame {
+    uint64_t seq = 0;               // 源阶段分配的序号，从0连续递增
+    int64_t startNs = 0;            // 源阶段开始的时间
+    bool dropped = false;           // 被某个阶段丢弃，之后的阶段不再处理
+    FrameBufferRef buffers[PIPELINE_FRAME_SLOTS];
+    std::shared_ptr<void> userData; // 阶段之间传递的其他数据(分析结果等)
+
+    void reset();
+};
+
+/**
+ * 阶段函数
+ * 源阶段返回false表示没有更多帧；其他阶段返回false表示丢弃这一帧
+ */
+typedef std::function<bool(PipelineFrame &frame)> PipelineStageFunc;
+
+struct PipelineStageStats {
+    std::string name;
+    PipelineStageMode mode = PipelineStage_Serial;
+    uint64_t frames = 0;            // 处理的帧
+    uint64_t dropped = 0;           // 这个阶段丢弃的帧
+    int64_t busyNs = 0;             // 阶段函数的总耗时
+    int64_t maxNs = 0;              // 单帧最大耗时
+    int64_t waitNs = 0;             // 到达阶段到开始处理的总等待(排队/等前一帧)
+    int maxConcurrent = 0;          // 同时处理的最大帧数
+
+    double avgMs() const {
+        return frames > 0 ? (double) busyNs / (double) frames / 1e6 : 0.0;
+    }
+
+    double avgWaitMs() const {
+        return frames > 0 ? (double) waitNs / (double) frames / 1e6 : 0.0;
+    }
+};
+
+struct PipelineStats {
+    uint64_t frames = 0;            // 走完所有阶段的帧(含丢弃的)
+    uint64_t dropped = 0;
+    int64_t wallNs = 0;             // run 的总耗时
+    int64_t latencyNs = 0;          // 源阶段开始到最后一个阶段结束的总延迟(不含丢弃的帧)
+    int64_t maxLatencyNs = 0;
+    int maxInFlight = 0;            // 同时在流水线里的最大帧数
+    std::vector<PipelineStageStats> stages;   // 第一个是源阶段
+
+    double fps() const {
+        return wallNs > 0 ? (double) frames * 1e9 / (double) wallNs : 0.0;
+    }
+
+    double avgLatencyMs() const {
+        return frames > dropped ? (double) latencyNs / (double) (frames - dropped) / 1e6 : 0.0;
+    }
+};
+
+/**
+ * 帧处理流水线: 源阶段 -> 阶段1 -> 阶段2 ... 每个阶段是一个任务，在 ThreadPool 上执行
+ * 最多 maxInFlight 帧同时在流水线里，第N帧在分析时第N+1帧已经在解码；
+ * 串行阶段按帧序号处理(前面的并行阶段乱序完成的帧在这里重新排队)，所以显示顺序和源顺序一致
+ *
+ * 源阶段在调用 run 的线程上执行(读文件/取帧，可以阻塞)，达到 maxInFlight 时等待有帧完成
+ * 阶段函数里可以用 getPool().parallelFor / parallelTiles 把大图分块到多个核上
+ */
+class Pipeline {
+public:
+    explicit Pipeline(ThreadPool &pool);
+
+    ~Pipeline();
+
+    Pipeline(const Pipeline &) = delete;
+
+    Pipeline &operator=(const Pipeline &) = delete;
+
+    void setSource(const std::string &name, PipelineStageFunc func);
+
+    void addStage(const std::string &name, PipelineStageMode mode, PipelineStageFunc func);
+
+    /**
+     * 一直运行到源阶段没有更多帧(或 stop)，所有帧完成后返回
+     * @return 完成的帧数(含丢弃的)
+     */
+    uint64_t run(int maxInFlight);
+
+    /**
+     * 对照用: 在调用线程上一帧接一帧地执行所有阶段(不并行，不流水)
+     */
+    uint64_t runSequential();
+
+    /**
+     * 不再从源阶段取帧，已经在流水线里的帧照常完成(任意线程)
+     */
+    void stop();
+
+    PipelineStats getStats() const;
+
+    /**
+     * 输出每个阶段的耗时和吞吐
+     */
+    void printStats() const;
+
+    ThreadPool &getPool();
+
+private:
+    struct Token {
+        PipelineFrame frame;
+        int64_t arriveNs = 0;
+    };
+
+    struct Stage {
+        std::string name;
+        PipelineStageMode mode = PipelineStage_Serial;
+        PipelineStageFunc func;
+        // 串行阶段: 下一个该处理的序号，正在处理时 busy，提前到达的帧按序号排队
+        uint64_t nextSeq = 0;
+        bool busy = false;
+        std::map<uint64_t, Token *> waiting;
+        int running = 0;
+        PipelineStageStats stats;
+    };
+
+    void resetRun();
+
+    // 执行阶段函数并记录耗时，返回false表示这一帧被丢弃
+    bool callStage(Stage &stage, Token *token);
+
+    // 帧到达第 index 个阶段(index 等于阶段数表示完成)
+    void arrive(Token *token, size_t index);
+
+    void execute(Token *token, size_t index);
+
+    void finish(Token *token);
+
+    ThreadPool &pool;
+    Stage source;
+    std::vector<std::unique_ptr<Stage>> stages;
+    std::vector<std::unique_ptr<Token>> tokens;
+    std::vector<Token *> freeTokens;
+    int inFlight = 0;
+    bool stopped = false;
+    PipelineStats stats;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+};
+
+#endif //NATIVESURFACE_PIPELINE_H
@@ -0,0 +1,229 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_PROFILER_H
+#define NATIVESURFACE_PROFILER_H
+
+#include <cstdint>
+#include <atomic>
+#include <vector>
+
+/**
+ * 帧分析器
+ * PROFILE_ZONE 在作用域结束时把一段耗时写入当前线程自己的环形缓冲(单生产者，无锁)，
+ * 写满后覆盖最旧的记录；读取方(时间线窗口/导出)随时可以从任意线程拷贝
+ *
+ * 记录时只读CPU计数器(x86 rdtsc / arm64 cntvct_el0)，读取时再换算成 CLOCK_MONOTONIC 纳秒，
+ * 每个区段的开销在几十纳秒以内
+ *
+ * PROFILE_COUNTER 记录一个随时间变化的数值(每帧的绘制调用数、GPU耗时等)，时间线窗口和导出中按名称显示
+ *
+ * 编译时没有定义 NATIVE_SURFACE_PROFILER(CMake BUILD_PROFILER=OFF) 时宏全部为空，
+ * 运行时也可以 Profiler::setEnabled(false) 暂停记录
+ */
+
+#if defined(NATIVE_SURFACE_PROFILER)
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+// name 必须是字符串常量(只保存指针)
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+#define PROFILE_FRAME() Profiler::frameMark()
+#define PROFILE_THREAD(name) Profiler::setThreadName(name)
+#define PROFILE_COUNTER(name, value) Profiler::setCounter(name, (double) (value))
+#else
+#define PROFILE_ZONE(name)
+#define PROFILE_FUNCTION()
+#define PROFILE_FRAME()
+#define PROFILE_THREAD(name)
+#define PROFILE_COUNTER(name, value)
+#endif
+
+// 读取后的一段耗时
+struct ProfileEvent {
+    const char *name;
+    int64_t startNs;            // CLOCK_MONOTONIC
+    int64_t endNs;
+    int depth;                  // 同一线程内的嵌套层级，0为最外层
+};
+
+// 一个线程的记录，按开始时间排序
+struct ProfileThreadEvents {
+    int tid;
+    char name[32];
+    uint64_t overwritten;       // 被覆盖(丢失)的记录数
+    std::vector<ProfileEvent> events;
+};
+
+// 计数器的一次取值
+struct ProfileCounterSample {
+    int64_t ns;                 // CLOCK_MONOTONIC
+    double value;
+};
+
+// 一个计数器最近的取值，按时间排序
+struct ProfileCounterTrack {
+    char name[48];
+    std::vector<ProfileCounterSample> samples;
+};
+
+// 一个线程的环形缓冲，只由所属线程写入，线程结束后留给下一个新线程复用
+struct ProfileRing {
+    static const uint32_t CAPACITY = 8192;  // 2的幂
+
+    struct Slot {
+        std::atomic<const char *> name{nullptr};
+        std::atomic<uint64_t> start{0};
+        std::atomic<uint64_t> end{0};
+        std::atomic<uint32_t> depth{0};
+    };
+
+    Slot slots[CAPACITY];
+    std::atomic<uint64_t> head{0};          // 已写入的总数
+    std::atomic<uint64_t> base{0};          // 当前线程的第一条记录
+    std::atomic<int> tid{0};
+    std::atomic<bool> active{false};
+    char name[32] = {};
+    uint32_t depth = 0;                     // 所属线程使用
+    ProfileRing *next = nullptr;
+};
+
+class Profiler {
+public:
+    /**
+     * 读取CPU计数器(不是纳秒)，用 ticksToNs 换算
+     */
+    static inline uint64_t ticks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__)
+        uint64_t value;
+        asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+        return value;
+#else
+        return (uint64_t) nowNs();
+#endif
+    }
+
+    static int64_t ticksToNs(uint64_t ticks);
+
+    // CLOCK_MONOTONIC 纳秒
+    static int64_t nowNs();
+
+    static inline bool isEnabled() {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    static void setEnabled(bool enable);
+
+    /**
+     * 当前线程的缓冲，第一次调用时分配
+     */
+    static inline ProfileRing *threadRing() {
+        ProfileRing *ring = currentRing;
+        return ring != nullptr ? ring : acquireRing();
+    }
+
+    /**
+     * 设置当前线程在时间线/导出中显示的名称
+     * nullptr 表示交还当前线程的缓冲(线程结束时自动调用)
+     */
+    static void setThreadName(const char *name);
+
+    /**
+     * 标记一帧结束(主渲染线程 drawEnd() 调用)，时间线按帧截取
+     */
+    static void frameMark();
+
+    /**
+     * 最近 count 帧的起止时间(最近一帧在最后)
+     * @return 实际帧数
+     */
+    static int getFrameTimes(int64_t *frameEndNs, int count);
+
+    /**
+     * 拷贝所有线程在 sinceNs 之后结束的记录，可以在任意线程调用
+     */
+    static void collect(std::vector<ProfileThreadEvents> &out, int64_t sinceNs = 0);
+
+    /**
+     * 把缓冲中全部记录导出为 Chrome trace JSON(chrome://tracing / Perfetto 打开)
+     */
+    static bool exportChromeTrace(const char *path);
+
+    /**
+     * 记录计数器的当前值，name 按内容区分(会被拷贝)，任意线程可调用
+     * 每个计数器保留最近 256 次取值，最多 64 个计数器
+     */
+    static void setCounter(const char *name, double value);
+
+    /**
+     * 读取计数器最近一次的值
+     * @return 没有记录过时返回false
+     */
+    static bool getCounter(const char *name, double &value);
+
+    /**
+     * 拷贝所有计数器在 sinceNs 之后的取值
+     */
+    static void collectCounters(std::vector<ProfileCounterTrack> &out, int64_t sinceNs = 0);
+
+    /**
+     * ImGui 时间线窗口: 最近几帧每个线程一行，区段按层级叠放，下方按名称汇总
+     * 在绘制线程的 drawBegin()/drawEnd() 之间调用
+     */
+    static void showWindow(bool *open = nullptr);
+
+private:
+    static ProfileRing *acquireRing();
+
+    static void releaseRing();
+
+    static std::atomic<bool> enabled;
+    static thread_local ProfileRing *currentRing;
+};
+
+/**
+ * 作用域耗时，用 PROFILE_ZONE 宏创建
+ */
+class ProfileZone {
+public:
+    explicit inline ProfileZone(const char *name) : name(name) {
+        if (!Profiler::isEnabled()) {
+            ring = nullptr;
+            return;
+        }
+        ring = Profiler::threadRing();
+        ring->depth++;
+        start = Profiler::ticks();
+    }
+
+    inline ~ProfileZone() {
+        if (ring == nullptr) {
+            return;
+        }
+        uint64_t end = Profiler::ticks();
+        uint32_t depth = --ring->depth;
+        uint64_t index = ring->head.load(std::memory_order_relaxed);
+        // 上一条的 head 先于这一条的数据可见，读取方据此判断拷贝时哪些槽位被覆盖(x86上只是编译屏障)
+        std::atomic_thread_fence(std::memory_order_release);
+        ProfileRing::Slot &slot = ring->slots[index & (ProfileRing::CAPACITY - 1)];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.depth.store(depth, std::memory_order_relaxed);
+        ring->head.store(index + 1, std::memory_order_release);
+    }
+
+    ProfileZone(const ProfileZone &) = delete;
+
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *name;
+    ProfileRing *ring;
+    uint64_t start = 0;
+};
+
+#endif //NATIVESURFACE_PROFILER_H
@@ -0,0 +1,244 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RAWFRAMEPOOL_H
+#define NATIVESURFACE_RAWFRAMEPOOL_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <vector>
+#include <memory>
+#include "native_surface/raw_frame.h"
+
+#if defined(__ANDROID__)
+#include "native_surface/extern_function.h"
+#endif
+
+/**
+ * 原始帧来源
+ * 设备上是 aosp_res 库里的 AImageReader(ExternRawFrameSource)，Linux 上用 SyntheticFrameSource 代替，
+ * 两者的语义一致: 只取最新的一帧，同时持有的帧数不能超过 getMaxImages()
+ */
+class RawFrameSource {
+public:
+    virtual ~RawFrameSource() = default;
+
+    /**
+     * 取最新的一帧，没有新帧时最多等待 timeoutMs 毫秒
+     * @return 超时、已停止或持有的帧达到上限时返回false
+     */
+    virtual bool acquire(RawFrame &frame, int timeoutMs) = 0;
+
+    /**
+     * 把帧还给来源，可以在任意线程调用
+     */
+    virtual void release(RawFrame &frame) = 0;
+
+    virtual int getMaxImages() const = 0;
+};
+
+#if defined(__ANDROID__)
+
+/**
+ * ExternFunction 的原始帧采集(initRawCapture 之后使用，stopRawCapture 之前销毁)
+ */
+class ExternRawFrameSource : public RawFrameSource {
+public:
+    ExternRawFrameSource(ExternFunction *externFunction, int maxImages);
+
+    bool acquire(RawFrame &frame, int timeoutMs) override;
+
+    void release(RawFrame &frame) override;
+
+    int getMaxImages() const override;
+
+private:
+    ExternFunction *externFunction;
+    int maxImages;
+};
+
+#endif
+
+/**
+ * 模拟 AImageReader 的帧来源(Linux/基准测试用)
+ * 生产线程按帧率把帧写进 maxImages + 2 块缓冲(BufferQueue 生产端最多多出队两块)，
+ * 队列里只保留最新的一帧，旧帧直接回收；没有空闲缓冲时生产端丢帧
+ *
+ * 帧内容: 每个平面每行开头8字节是帧序号，其余字节是 patternByte(序号, 平面)，
+ * 用 checkPattern 校验帧在持有期间没有被生产端改写
+ */
+class SyntheticFrameSource : public RawFrameSource {
+public:
+    SyntheticFrameSource(uint32_t width, uint32_t height, int32_t format, int maxImages, float fps);
+
+    ~SyntheticFrameSource() override;
+
+    bool start();
+
+    void stop();
+
+    bool acquire(RawFrame &frame, int timeoutMs) override;
+
+    void release(RawFrame &frame) override;
+
+    int getMaxImages() const override;
+
+    // 生产端写入的帧数
+    uint64_t getProducedCount() const;
+
+    // 没有空闲缓冲，生产端丢弃的帧数
+    uint64_t getProducerDroppedCount() const;
+
+    // 还没被取走就被更新的帧替换掉的帧数
+    uint64_t getReplacedCount() const;
+
+    // 调用方当前持有的帧数
+    int getAcquiredCount() const;
+
+    static uint8_t patternByte(uint64_t seq, int plane);
+
+    /**
+     * 校验帧内容(每行的序号和首尾字节)
+     * @param seq 帧序号
+     */
+    static bool checkPattern(const RawFrame &frame, uint64_t *seq);
+
+private:
+    enum BufferState {
+        Buffer_Free,
+        Buffer_Dequeued,        // 生产端正在写入
+        Buffer_Queued,          // 等待取走
+        Buffer_Acquired,        // 调用方持有
+    };
+
+    struct Buffer {
+        std::vector<uint8_t> data;
+        RawFrame frame{};
+        BufferState state = Buffer_Free;
+    };
+
+    void producerLoop();
+
+    void fill(Buffer &buffer, uint64_t seq);
+
+    uint32_t width;
+    uint32_t height;
+    int32_t format;
+    int maxImages;
+    float fps;
+    std::vector<Buffer> buffers;
+    int queued = -1;
+    int acquiredCount = 0;
+    uint64_t produced = 0;
+    uint64_t producerDropped = 0;
+    uint64_t replaced = 0;
+    bool running = false;
+    std::thread thread;
+    mutable std::mutex mutex;
+    std::condition_variable cond;
+};
+
+class RawFramePool;
+
+/**
+ * 帧的引用，可以拷贝后交给其他线程，最后一个引用释放时帧还给来源
+ * RawFramePool 析构时会等其他线程的引用释放，析构的线程自己不能还持有引用
+ */
+class RawFrameRef {
+public:
+    RawFrameRef() = default;
+
+    RawFrameRef(const RawFrameRef &other);
+
+    RawFrameRef(RawFrameRef &&other) noexcept;
+
+    RawFrameRef &operator=(const RawFrameRef &other);
+
+    RawFrameRef &operator=(RawFrameRef &&other) noexcept;
+
+    ~RawFrameRef();
+
+    void reset();
+
+    const RawFrame *get() const;
+
+    const RawFrame *operator->() const {
+        return get();
+    }
+
+    explicit operator bool() const {
+        return slot != nullptr;
+    }
+
+    int useCount() const;
+
+private:
+    friend class RawFramePool;
+
+    struct Slot;
+
+    explicit RawFrameRef(Slot *slot) : slot(slot) {}
+
+    Slot *slot = nullptr;
+};
+
+struct RawFramePoolStats {
+    uint64_t acquired = 0;      // 交给调用方的帧
+    uint64_t released = 0;      // 最后一个引用释放、已还给来源的帧
+    uint64_t dropped = 0;       // 持有的帧达到上限，这次没有取帧
+    uint64_t timeouts = 0;      // 来源没有新帧(超时或已停止)
+    int outstanding = 0;        // 当前持有的帧
+    int maxOutstanding = 0;     // 持有帧数的最大值
+};
+
+/**
+ * 原始帧池: 在来源之上分发带引用计数的帧，帧内存始终属于来源(AHardwareBuffer)，不做拷贝
+ * 同时持有的帧数超过上限时 acquire 直接返回空引用(计入 dropped)，不会阻塞生产端
+ */
+class RawFramePool {
+public:
+    /**
+     * @param maxOutstanding 同时持有的上限，0 为来源的 getMaxImages()
+     */
+    explicit RawFramePool(RawFrameSource *source, int maxOutstanding = 0);
+
+    /**
+     * 等所有引用释放、帧还给来源之后才返回
+     */
+    ~RawFramePool();
+
+    /**
+     * 取最新的一帧，失败时返回空引用
+     * 只在一个线程调用，得到的引用可以交给任意线程
+     */
+    RawFrameRef acquire(int timeoutMs);
+
+    RawFramePoolStats getStats() const;
+
+    int getMaxOutstanding() const;
+
+private:
+    friend class RawFrameRef;
+
+    void releaseSlot(RawFrameRef::Slot *slot);
+
+    RawFrameSource *source;
+    int maxOutstanding;
+    std::unique_ptr<RawFrameRef::Slot[]> slots;
+    std::vector<RawFrameRef::Slot *> freeSlots;
+    RawFramePoolStats stats;
+    mutable std::mutex mutex;
+    std::condition_variable releasedCond;
+};
+
+struct RawFrameRef::Slot {
+    RawFrame frame{};
+    std::atomic<int> refs{0};
+    RawFramePool *pool = nullptr;
+};
+
+#endif //NATIVESURFACE_RAWFRAMEPOOL_H
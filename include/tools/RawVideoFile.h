@@ -0,0 +1,86 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RAWVIDEOFILE_H
+#define NATIVESURFACE_RAWVIDEOFILE_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstddef>
+#include "FrameBuffer.h"
+
+/**
+ * 原始视频文件: 没有文件头，帧与帧首尾相接，每帧的平面按顺序紧凑排列(没有行对齐)
+ * 和 ffmpeg -f rawvideo 的格式一致，可以在 Linux 上用文件代替采集/解码来测试处理流水线:
+ *   ffmpeg -i a.mp4 -f rawvideo -pix_fmt yuv420p a.yuv
+ */
+class RawVideoReader {
+public:
+    RawVideoReader() = default;
+
+    ~RawVideoReader();
+
+    RawVideoReader(const RawVideoReader &) = delete;
+
+    RawVideoReader &operator=(const RawVideoReader &) = delete;
+
+    bool open(const char *path, FrameBufferFormat format, int width, int height);
+
+    /**
+     * 读下一帧到池里取的缓冲(按缓冲的行宽写入)，seq 为帧在文件里的序号
+     * @return 文件结束或读取失败时返回空引用；loop 时结束后从头开始
+     */
+    FrameBufferRef read(FrameBufferPool &pool);
+
+    void setLoop(bool loop);
+
+    void close();
+
+    /**
+     * 文件里的帧数
+     */
+    int getFrameCount() const;
+
+    /**
+     * 一帧在文件里的字节数
+     */
+    static size_t frameSize(FrameBufferFormat format, int width, int height);
+
+private:
+    FILE *file = nullptr;
+    FrameBufferFormat format = FrameBuffer_YUV420P;
+    int width = 0;
+    int height = 0;
+    bool loop = false;
+    int frameCount = 0;
+    uint64_t frameIndex = 0;
+};
+
+class RawVideoWriter {
+public:
+    RawVideoWriter() = default;
+
+    ~RawVideoWriter();
+
+    RawVideoWriter(const RawVideoWriter &) = delete;
+
+    RawVideoWriter &operator=(const RawVideoWriter &) = delete;
+
+    bool open(const char *path, FrameBufferFormat format, int width, int height);
+
+    /**
+     * 写一帧(去掉行对齐)，格式和尺寸必须和 open 时一致
+     */
+    bool write(const FrameBuffer &buffer);
+
+    void close();
+
+private:
+    FILE *file = nullptr;
+    FrameBufferFormat format = FrameBuffer_YUV420P;
+    int width = 0;
+    int height = 0;
+};
+
+#endif //NATIVESURFACE_RAWVIDEOFILE_H
@@ -0,0 +1,38 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RECORDPACKET_H
+#define NATIVESURFACE_RECORDPACKET_H
+
+#include <vector>
+#include "Type.h"
+#include "FrameDiff.h"
+#include "Compress.h"
+
+// 录屏数据包类型(DataEnc 头里的 cmd)，screenRecord.cpp 发送，recordReceive.cpp 接收
+enum RecordPacketCmd {
+    RecordPacket_H264 = 0,          // h264 码流
+    RecordPacket_Unchanged = 1,     // 画面没有变化，只有头，接收端保持上一帧
+    RecordPacket_Tiles = 2,         // 原始帧的脏块，见下面的布局
+};
+
+/*
+ * RecordPacket_Tiles 数据(DataEnc 的 int 为大端):
+ *   int width, int height, int tileSize, int bytesPerPixel(4, RGBA)
+ *   int mapLength, 脏块表(FrameDiff::packDirtyMap)
+ *   脏块像素(FrameDiff::gatherTiles，行优先，每块逐行)
+ * 第一帧和画面尺寸变化时全部是脏块
+ */
+static const int RECORD_TILES_HEADER = 5 * 4;
+
+/**
+ * 把一帧原始画面按 diff 打成数据包(头+数据): 有变化时 RecordPacket_Tiles，没有变化时 RecordPacket_Unchanged
+ * @param pixels diff 比较的同一帧(RGBA)
+ * @param context 不为空时用 codec 压缩数据(DataEnc::compress)
+ * @return 数据包长度，失败返回-1
+ */
+int buildTilesPacket(const FrameDiffResult &diff, const uint8_t *pixels, int rowStride, std::vector<mbyte> &packet,
+                     CompressContext *context = nullptr, CompressCodec codec = Compress_None);
+
+#endif //NATIVESURFACE_RECORDPACKET_H
@@ -0,0 +1,89 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_RECORDRECEIVER_H
+#define NATIVESURFACE_RECORDRECEIVER_H
+
+#include <cstdint>
+#include <vector>
+#include "Type.h"
+#include "DataDec.h"
+#include "Compress.h"
+#include "FrameBuffer.h"
+#include "ImageTexture.h"
+#include "RecordPacket.h"
+
+#ifdef NATIVE_SURFACE_FFMPEG
+#include "H264Decoder.h"
+#endif
+
+struct RecordReceiverStats {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;             // 收到的字节(压缩的包按压缩后计算)
+    uint64_t h264Packets = 0;
+    uint64_t tilesPackets = 0;
+    uint64_t unchangedPackets = 0;
+    uint64_t undecoded = 0;         // 没有解码器时跳过的 h264 包
+    uint64_t errors = 0;
+};
+
+// 一个数据包各阶段的耗时
+struct RecordPacketTiming {
+    double decompressMs = 0.0;
+    double decodeMs = 0.0;          // h264 解码+转换 或 脏块写入画布
+    double uploadMs = 0.0;          // 上传纹理
+};
+
+/**
+ * 录屏接收端的数据包处理(recordReceive.cpp 和 NativeReplay 共用): 解压、h264 解码或脏块写入画布、上传纹理
+ * 需要在 GL 上下文线程调用；没有 NATIVE_SURFACE_FFMPEG(Linux 上没有 ffmpeg 库)时 h264 包只计数不解码
+ */
+class RecordReceiver {
+public:
+    RecordReceiver() = default;
+
+    RecordReceiver(const RecordReceiver &) = delete;
+
+    RecordReceiver &operator=(const RecordReceiver &) = delete;
+
+    /**
+     * @param packet 完整数据包(头+数据)，压缩的包在内部解压，不修改 packet
+     * @return 数据包损坏时返回false，之后的包仍然可以继续处理
+     */
+    bool handlePacket(mbyte *packet, int length, RecordPacketTiming *timing = nullptr);
+
+    /**
+     * 清空流模式的解压窗口(发送端重新连接、回放重新开始时)
+     */
+    void resetStream();
+
+    ImageTexture &getTexture();
+
+    /**
+     * 原始帧模式的画布(RGBA)，h264 模式为空
+     */
+    FrameBufferRef getCanvas() const;
+
+    RecordReceiverStats getStats() const;
+
+    static bool hasH264Decoder();
+
+private:
+    bool applyTiles(mbyte *data, int length, RecordPacketTiming &timing);
+
+#ifdef NATIVE_SURFACE_FFMPEG
+    H264Decoder decoder;
+#endif
+    CompressContext compress;
+    DataDec dataDec;
+    // 纹理跨帧复用，直接从解码器的帧缓冲上传
+    ImageTexture texture;
+    // 原始帧模式的画布，接收端持有唯一引用，直接写入
+    FrameBufferPool canvasPool{1};
+    FrameBufferRef canvas;
+    std::vector<uint8_t> dirty;
+    RecordReceiverStats stats;
+};
+
+#endif //NATIVESURFACE_RECORDRECEIVER_H
@@ -0,0 +1,140 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_SCREENRECOGNIZER_H
+#define NATIVESURFACE_SCREENRECOGNIZER_H
+
+#include <opencv2/core.hpp>
+#include "FrameDiff.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+struct ScreenRecognizerOptions {
+    int levels = 4;                 // 金字塔层数(含原图)，粗搜索在模板缩小后仍不小于 minCoarseSize 的最高层进行
+    int minCoarseSize = 10;         // 粗搜索层模板的最小边长(像素)
+    float threshold = 0.85f;        // 默认匹配阈值(TM_CCOEFF_NORMED)
+    float coarseSlack = 0.25f;      // 粗搜索的阈值比 threshold 低多少(缩小后相关系数会下降)
+    int maxCandidates = 3;          // 每个模板粗搜索后最多细化的候选位置
+    int roiMargin = 24;             // 上一帧命中位置周围的搜索边距(原图像素)，没找到时同一帧回到全图搜索
+    float stillScore = 0.97f;       // 上一帧位置上的相关系数不低于这个值时认为图标没有移动，不再搜索 ROI
+};
+
+// 一个模板在一帧里的结果
+struct ScreenMatch {
+    int id = -1;
+    std::string name;
+    bool found = false;
+    float score = 0.0f;             // 最佳相关系数
+    cv::Rect rect;                  // 原图坐标
+    bool tracked = false;           // 在上一帧命中位置附近找到
+};
+
+struct ScreenRecognizerStats {
+    uint64_t frames = 0;
+    uint64_t roiSearches = 0;       // 在上一帧位置附近搜索
+    uint64_t roiHits = 0;
+    uint64_t stillHits = 0;         // 图标没有移动(上一帧位置直接命中)
+    uint64_t fullSearches = 0;      // 全图粗到细搜索的模板次数
+    uint64_t fftCorrelations = 0;   // 粗搜索层的频域相关(每个模板一次)
+    uint64_t frameSpectra = 0;      // 计算的帧频谱(每层每帧一次，所有模板共用)
+    uint64_t refinements = 0;       // 原图上细化的候选
+    uint64_t rejectedTemplates = 0; // addTemplate 拒绝的模板(太小/纯色/格式不支持)
+    uint64_t skippedFrames = 0;     // FrameDiff 判定没有变化、直接返回上一帧结果的帧
+    uint64_t unchangedHits = 0;     // 命中位置不在脏块里、沿用上一帧结果的模板次数
+    double lastPyramidMs = 0.0;
+    double lastCoarseMs = 0.0;
+    double lastRefineMs = 0.0;      // 细化和 ROI 搜索
+    double lastTotalMs = 0.0;
+};
+
+/**
+ * 屏幕状态识别: 在采集的帧里找已知的界面图标(模板)
+ *
+ * 每帧只做一次灰度转换和金字塔；模板在 addTemplate 时预先建好金字塔、去均值和范数，
+ * 粗搜索层的模板频谱按帧尺寸缓存，同一层所有模板共用一次帧的DFT，每个模板只做一次频谱乘法和逆变换，
+ * 归一化需要的窗口和/平方和由积分图得到；粗搜索的候选在原图的小窗口里用 matchTemplate 细化。
+ * 上一帧命中的模板先看原位置的相关系数(没有移动时不做任何搜索)，再在命中位置附近搜索，没找到才回到全图搜索。
+ *
+ * 模板和帧按原尺寸匹配(界面图标不缩放)，不是线程安全的，一个线程使用
+ */
+class ScreenRecognizer {
+public:
+    explicit ScreenRecognizer(const ScreenRecognizerOptions &options = ScreenRecognizerOptions());
+
+    ~ScreenRecognizer();
+
+    ScreenRecognizer(const ScreenRecognizer &) = delete;
+
+    ScreenRecognizer &operator=(const ScreenRecognizer &) = delete;
+
+    /**
+     * 添加模板(CV_8UC1/CV_8UC3 BGR/CV_8UC4 BGRA)，预先计算金字塔
+     * @param threshold 匹配阈值，<=0 使用 options.threshold
+     * @param region 只在这个区域里找(原图坐标)，空为全图
+     * @return 模板id，模板太小或格式不支持时返回-1
+     */
+    int addTemplate(const std::string &name, const cv::Mat &image, float threshold = 0.0f,
+                    const cv::Rect &region = cv::Rect());
+
+    void removeTemplate(int id);
+
+    int getTemplateCount() const;
+
+    /**
+     * 在一帧里找所有模板，返回每个模板的结果(按添加顺序，引用在下一次 recognize 之前有效)
+     */
+    const std::vector<ScreenMatch> &recognize(const cv::Mat &frame);
+
+    /**
+     * 带帧差异的识别: 画面没有变化时直接返回上一帧的结果(不做灰度和金字塔)，
+     * 上一帧命中位置和限定区域不在脏块里的模板沿用上一帧结果，其余模板照常搜索
+     * @param diff 同一帧的 FrameDiff 结果，空指针时和 recognize(frame) 相同
+     */
+    const std::vector<ScreenMatch> &recognize(const cv::Mat &frame, const FrameDiffResult *diff);
+
+    /**
+     * 忘掉上一帧的命中位置(画面切换时调用)，下一帧全部全图搜索
+     */
+    void resetTracking();
+
+    ScreenRecognizerStats getStats() const;
+
+    const ScreenRecognizerOptions &getOptions() const;
+
+    /**
+     * 对照用: 原图上直接 matchTemplate(TM_CCOEFF_NORMED) 的最佳位置
+     */
+    static ScreenMatch matchFull(const cv::Mat &frameGray, const cv::Mat &templGray);
+
+    /**
+     * 转成灰度(不拷贝已经是灰度的 Mat)
+     */
+    static bool toGray(const cv::Mat &src, cv::Mat &gray);
+
+private:
+    struct Template;
+    struct Level;
+
+    void buildPyramid(const cv::Mat &gray);
+
+    void prepareSpectrum(Template &templ, Level &level);
+
+    void coarseSearch(Template &templ, std::vector<cv::Point> &candidates);
+
+    bool refine(Template &templ, const cv::Rect &window, ScreenMatch &match);
+
+    float scoreAt(const Template &templ, const cv::Rect &rect) const;
+
+    ScreenRecognizerOptions options;
+    std::vector<std::unique_ptr<Template>> templates;
+    std::vector<std::unique_ptr<Level>> levels;
+    std::vector<ScreenMatch> results;
+    ScreenRecognizerStats stats;
+    cv::Size lastFrameSize;
+    int nextId = 0;
+};
+
+#endif //NATIVESURFACE_SCREENRECOGNIZER_H
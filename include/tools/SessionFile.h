@@ -0,0 +1,138 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_SESSIONFILE_H
+#define NATIVESURFACE_SESSIONFILE_H
+
+#include <cstdio>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+ * 录制的会话文件，Linux 上用 NativeReplay 回放(见 src/replay.cpp)
+ *
+ * 文件头 16 字节: "NSSN" int version int64 录制开始的系统时间(毫秒)
+ * 之后是记录，每条记录 16 字节头: int64 相对开始的时间(微秒，单调时钟) int type int length，然后是 length 字节数据
+ * 所有整数和 DataEnc 一样是大端
+ *
+ * SessionRecord_Packet:      收到的完整数据包(DataEnc 头 + 数据，压缩的包保持压缩)，时间为收完的时刻
+ * SessionRecord_Touch:       一次 SYN_REPORT 的全部触摸事件(包括最后的 SYN)，每个事件 short type short code int value
+ * SessionRecord_Display:     int width int height int orientation，开始时和屏幕信息变化时记录
+ * SessionRecord_TouchDevice: int maxX int maxY 触摸屏坐标范围，打开触摸设备时记录
+ */
+enum SessionRecordType {
+    SessionRecord_Packet = 1,
+    SessionRecord_Touch = 2,
+    SessionRecord_Display = 3,
+    SessionRecord_TouchDevice = 4,
+};
+
+struct SessionTouchEvent {
+    uint16_t type;
+    uint16_t code;
+    int32_t value;
+};
+
+struct SessionRecord {
+    int64_t timeUs = 0;
+    SessionRecordType type = SessionRecord_Packet;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * 录制: 接收线程写数据包，触摸线程写触摸事件，所有写入加锁
+ */
+class SessionWriter {
+public:
+    static const int VERSION = 1;
+
+    SessionWriter() = default;
+
+    ~SessionWriter();
+
+    SessionWriter(const SessionWriter &) = delete;
+
+    SessionWriter &operator=(const SessionWriter &) = delete;
+
+    bool open(const char *path);
+
+    bool isOpen() const;
+
+    /*
+     * timeUs 为-1 时使用当前时间(elapsedUs)；生成会话时可以指定，比上一条早时按上一条的时间记录
+     */
+    bool writePacket(const uint8_t *packet, int length, int64_t timeUs = -1);
+
+    bool writeTouch(const SessionTouchEvent *events, int count, int64_t timeUs = -1);
+
+    bool writeDisplay(uint32_t width, uint32_t height, uint32_t orientation, int64_t timeUs = -1);
+
+    bool writeTouchDevice(int maxX, int maxY, int64_t timeUs = -1);
+
+    bool write(int64_t timeUs, SessionRecordType type, const uint8_t *data, int length);
+
+    /**
+     * 相对录制开始的时间(微秒)
+     */
+    int64_t elapsedUs() const;
+
+    uint64_t getRecordCount() const;
+
+    void close();
+
+private:
+    FILE *file = nullptr;
+    int64_t startUs = 0;
+    int64_t lastUs = 0;
+    uint64_t records = 0;
+    mutable std::mutex mutex;
+};
+
+class SessionReader {
+public:
+    SessionReader() = default;
+
+    ~SessionReader();
+
+    SessionReader(const SessionReader &) = delete;
+
+    SessionReader &operator=(const SessionReader &) = delete;
+
+    bool open(const char *path);
+
+    /**
+     * 读下一条记录(复用 record.data 的空间)
+     * @return 文件结束或记录损坏时返回false，isCorrupt 区分两种情况
+     */
+    bool next(SessionRecord &record);
+
+    /**
+     * 回到第一条记录
+     */
+    bool rewind();
+
+    bool isCorrupt() const;
+
+    int64_t getStartTimeMs() const;
+
+    void close();
+
+    static bool parseDisplay(const SessionRecord &record, uint32_t &width, uint32_t &height, uint32_t &orientation);
+
+    static bool parseTouchDevice(const SessionRecord &record, int &maxX, int &maxY);
+
+    /**
+     * @return 事件个数，格式错误返回-1
+     */
+    static int parseTouch(const SessionRecord &record, std::vector<SessionTouchEvent> &events);
+
+private:
+    FILE *file = nullptr;
+    int64_t startTimeMs = 0;
+    int64_t lastTimeUs = 0;
+    bool corrupt = false;
+};
+
+#endif //NATIVESURFACE_SESSIONFILE_H
@@ -0,0 +1,106 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_SESSIONREPLAY_H
+#define NATIVESURFACE_SESSIONREPLAY_H
+
+#include <cstdio>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SessionFile.h"
+#include "RecordReceiver.h"
+#include "Android_touch/TouchParser.h"
+
+struct SessionReplayOptions {
+    double speed = 0.0;             // 0 最快；1 按录制的时间；2 两倍速
+    int loops = 1;
+    bool render = true;             // 每个数据包画一帧(drawBegin/drawEnd)，和 recordReceive.cpp 一样
+};
+
+// 一个阶段的耗时分布(毫秒)
+struct ReplayStageStats {
+    std::string name;
+    uint64_t count = 0;
+    double avgMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+struct SessionReplayReport {
+    std::string session;
+    double speed = 0.0;
+    double wallMs = 0.0;
+    double sessionMs = 0.0;         // 录制的时长(所有循环)
+    uint64_t frames = 0;
+    uint64_t touchEvents = 0;       // 回放的 input_event 个数
+    uint64_t touchDispatched = 0;   // 分发给图层的触摸(按下/移动/抬起)
+    uint64_t displayChanges = 0;
+    RecordReceiverStats receiver;
+    bool corrupt = false;           // 文件在中间损坏(录制被打断)
+    double fps = 0.0;
+    double cpuMs = 0.0;             // 进程的用户+系统CPU时间
+    double cpuPercent = 0.0;        // 相对一个核
+    long rssKb = 0;
+    long peakRssKb = 0;
+    // read decompress decode upload render touch latency(数据包到达到画完)
+    std::vector<ReplayStageStats> stages;
+};
+
+// 合成会话(没有真机录制时的基准语料): 原始帧模式的脏块包 + 拖动手势 + 可选的旋转
+struct SyntheticSessionConfig {
+    int width = 720;
+    int height = 1280;
+    int frames = 120;
+    double fps = 60.0;
+    CompressCodec codec = Compress_None;    // 数据包压缩(单包模式)
+    bool touch = true;
+    bool rotate = false;            // 一半的时候旋转到横屏
+};
+
+/**
+ * 会话回放: 按 recordReceive.cpp 的逻辑处理数据包(RecordReceiver)，触摸事件走 TouchParser 分发给图层，
+ * 统计每个阶段的耗时和进程的 CPU/内存，在 Linux 上不需要手机就能比较改动前后的性能
+ * 需要先 initDraw，在主线程调用
+ */
+class SessionReplay {
+public:
+    explicit SessionReplay(const SessionReplayOptions &options = SessionReplayOptions());
+
+    SessionReplay(const SessionReplay &) = delete;
+
+    SessionReplay &operator=(const SessionReplay &) = delete;
+
+    bool run(const char *path, SessionReplayReport &report);
+
+    RecordReceiver &getReceiver();
+
+    /**
+     * 最后一次分发的触摸事件，没有时返回false
+     */
+    bool getLastTouch(ImGuInputEvent &event) const;
+
+    static void printReport(const SessionReplayReport &report, FILE *out = stdout);
+
+    static bool writeJson(const SessionReplayReport &report, const char *path);
+
+    /**
+     * 生成合成会话
+     * @param lastFrame 不为空时返回最后一帧(RGBA，紧凑的行)，用于校验回放结果
+     */
+    static bool writeSynthetic(const char *path, const SyntheticSessionConfig &config,
+                               std::vector<uint8_t> *lastFrame = nullptr);
+
+private:
+    void renderFrame();
+
+    SessionReplayOptions options;
+    RecordReceiver receiver;
+    TouchParser touchParser;
+    ImGuInputEvent lastTouch{};
+    bool hasTouch = false;
+};
+
+#endif //NATIVESURFACE_SESSIONREPLAY_H
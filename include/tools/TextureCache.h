@@ -0,0 +1,118 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_TEXTURECACHE_H
+#define NATIVESURFACE_TEXTURECACHE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "ImageTexture.h"
+#include "FrameBuffer.h"
+
+/**
+ * 发布给 TextureCache 的一帧图像
+ * keepAlive 持有像素的所有者(cv::Mat、FrameBufferRef 等)，上传完成之前像素一直有效
+ */
+struct TextureFrame {
+    ImageTextureFormat format = ImageTexture_RGB;
+    const uint8_t *pixels = nullptr;
+    int width = 0;
+    int height = 0;
+    int stride = 0;             // 每行字节数
+    uint64_t version = 0;       // 0 表示每次发布都是新内容；非0时像素地址和版本都没变就不重新上传
+    const void *source = nullptr;   // 比较版本用的内容地址，为空时用 pixels(像素是拷贝时填原数据的地址)
+    std::shared_ptr<void> keepAlive;
+
+    /**
+     * 包装帧缓冲(持有引用)
+     */
+    static TextureFrame fromFrameBuffer(const FrameBufferRef &buffer);
+};
+
+struct TextureCacheStats {
+    uint64_t published = 0;     // 发布的帧
+    uint64_t uploads = 0;       // 上传到纹理的帧
+    uint64_t replaced = 0;      // 还没上传就被新帧替换的帧
+    uint64_t unchanged = 0;     // 地址和版本都没变，跳过的发布
+    int windows = 0;
+};
+
+/**
+ * 按窗口名保存的持久纹理
+ * 任意线程 publish，渲染线程(GL上下文当前)在 upload 里只上传有新内容的窗口，纹理跨帧复用
+ */
+class TextureCache {
+public:
+    TextureCache() = default;
+
+    ~TextureCache();
+
+    TextureCache(const TextureCache &) = delete;
+
+    TextureCache &operator=(const TextureCache &) = delete;
+
+    /**
+     * 发布窗口的最新一帧(只保存句柄，不拷贝像素)，任意线程可调用
+     * @return 和上一次发布的地址、版本相同(不需要重新上传)时返回false
+     */
+    bool publish(const std::string &name, TextureFrame frame);
+
+    /**
+     * 发布前需要拷贝像素时先检查: 内容地址和版本都和上一次发布相同时计为一次跳过的发布并返回true，不用再拷贝和 publish
+     */
+    bool skipUnchanged(const std::string &name, const void *source, uint64_t version);
+
+    /**
+     * 移除窗口，纹理在下一次 upload 时释放
+     */
+    void remove(const std::string &name);
+
+    /**
+     * 上传有新内容的窗口，渲染线程调用
+     * @return 这次上传的窗口数
+     */
+    int upload();
+
+    /**
+     * 每个窗口画成一个 ImGui 窗口，渲染线程调用
+     */
+    void draw();
+
+    /**
+     * 释放所有纹理，在GL上下文当前的线程调用
+     */
+    void clear();
+
+    TextureCacheStats getStats() const;
+
+    /**
+     * 窗口的纹理(没有上传过时为空)，渲染线程调用
+     */
+    ImageTexture *getTexture(const std::string &name);
+
+private:
+    // Window 只在渲染线程(upload/clear)删除，纹理和尺寸只在渲染线程访问
+    struct Window {
+        std::string name;
+        TextureFrame pending;       // 等待上传的帧
+        bool dirty = false;
+        bool removed = false;
+        const void *lastSource = nullptr;
+        uint64_t lastVersion = 0;
+        std::unique_ptr<ImageTexture> texture;
+        int width = 0;
+        int height = 0;
+    };
+
+    Window *findWindow(const std::string &name);
+
+    std::vector<std::unique_ptr<Window>> windows;
+    TextureCacheStats stats;
+    mutable std::mutex mutex;
+};
+
+#endif //NATIVESURFACE_TEXTURECACHE_H
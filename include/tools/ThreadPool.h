@@ -0,0 +1,133 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_THREADPOOL_H
+#define NATIVESURFACE_THREADPOOL_H
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <functional>
+
+struct ThreadPoolStats {
+    uint64_t submitted = 0;     // 提交的任务
+    uint64_t executed = 0;      // 执行完的任务
+    uint64_t stolen = 0;        // 从其他线程队列偷来执行的任务
+    uint64_t helped = 0;        // 等待方(TaskGroup::wait)自己执行的任务
+};
+
+// 图像分块(像素坐标，右下不包含)
+struct TileRect {
+    int x0;
+    int y0;
+    int x1;
+    int y1;
+};
+
+/**
+ * 工作窃取线程池
+ * 每个工作线程一个双端队列: 工作线程提交的任务放进自己队列的尾部并从尾部取(后进先出，数据还在缓存里)，
+ * 空闲时从其他线程队列的头部偷(先进先出，偷走的是较早、通常较大的任务)；其他线程提交的任务轮流分给各个队列
+ *
+ * 等待任务的线程(TaskGroup::wait、parallelFor)不阻塞，而是帮忙执行队列里的任务，
+ * 所以可以在任务里再嵌套 parallelFor，不会因为线程都在等待而死锁
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threads 工作线程数，0 为 CPU 核数
+     */
+    explicit ThreadPool(int threads = 0);
+
+    /**
+     * 执行完队列里剩下的任务再退出
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+
+    /**
+     * 在当前线程执行一个排队的任务
+     * @return 没有任务时返回false
+     */
+    bool runOne();
+
+    /**
+     * 把 [begin, end) 按 grain 分段并行执行 fn(段开始, 段结束)，全部完成后返回，调用方也参与执行
+     */
+    void parallelFor(int begin, int end, int grain, const std::function<void(int begin, int end)> &fn);
+
+    /**
+     * 把图像分成 tileWidth x tileHeight 的块并行处理，全部完成后返回
+     * 按行带分块(tileWidth >= width)时每块的内存连续，适合逐行的滤波/转换
+     */
+    void parallelTiles(int width, int height, int tileWidth, int tileHeight,
+                       const std::function<void(const TileRect &tile)> &fn);
+
+    int getThreadCount() const;
+
+    ThreadPoolStats getStats() const;
+
+    /**
+     * 当前线程在这个池里的编号，不是这个池的工作线程时返回-1
+     */
+    int currentWorker() const;
+
+private:
+    typedef std::function<void()> Task;
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    void workerLoop(int index);
+
+    bool popTask(int self, Task &task, bool *stolen);
+
+    void execute(Task &task);
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<int> pending{0};            // 排队中的任务数
+    std::atomic<uint32_t> nextWorker{0};
+    std::atomic<uint64_t> submitted{0};
+    std::atomic<uint64_t> executed{0};
+    std::atomic<uint64_t> stolen{0};
+    std::atomic<uint64_t> helped{0};
+    bool stopping = false;
+    std::mutex sleepMutex;
+    std::condition_variable sleepCond;
+};
+
+/**
+ * 一组任务，wait 等待这组任务全部完成(等待期间帮忙执行池里的任务)
+ */
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool);
+
+    ~TaskGroup();
+
+    void run(std::function<void()> task);
+
+    void wait();
+
+private:
+    ThreadPool &pool;
+    std::atomic<int> remaining{0};
+    std::mutex mutex;
+    std::condition_variable cond;
+};
+
+#endif //NATIVESURFACE_THREADPOOL_H
@@ -0,0 +1,51 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#ifndef NATIVESURFACE_BENCH_H
+#define NATIVESURFACE_BENCH_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+/**
+ * 基准测试场景
+ * 每帧在 drawBegin()/drawEnd() 之间调用 frame，setup/teardown 可为空
+ */
+struct BenchScene {
+    const char *name;
+    const char *desc;
+
+    void (*setup)();
+
+    void (*frame)(int frame);
+
+    void (*teardown)();
+};
+
+class BenchRegistry {
+public:
+    static std::vector<BenchScene> &scenes();
+
+    static bool add(const BenchScene &scene);
+
+    static const BenchScene *find(const std::string &name);
+};
+
+/**
+ * 场景上报自定义计数(每帧调用)，报告里输出每帧平均值
+ */
+void benchCounter(const char *name, double value);
+
+/**
+ * 场景校验失败(如golden比对不一致)，NativeBench 最终返回非0
+ */
+void benchFail(const char *fmt, ...);
+
+#define BENCH_CONCAT_(a, b) a##b
+#define BENCH_CONCAT(a, b) BENCH_CONCAT_(a, b)
+#define BENCH_SCENE(name, desc, setup, frame, teardown) \
+    static bool BENCH_CONCAT(g_BenchScene_, __LINE__) = BenchRegistry::add({name, desc, setup, frame, teardown})
+
+#endif //NATIVESURFACE_BENCH_H
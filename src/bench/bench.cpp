@@ -0,0 +1,375 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 离屏基准测试: 回放脚本化的UI场景，统计每帧CPU耗时、draw call、顶点数
+// 用法: NativeBench [--scene 名称|all] [--frames N] [--warmup N] [--size 宽x高] [--dump 目录] [--dump-every N] [--list]
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <map>
+#include <algorithm>
+#include <ctime>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdarg>
+
+std::vector<BenchScene> &BenchRegistry::scenes() {
+    static std::vector<BenchScene> list;
+    return list;
+}
+
+bool BenchRegistry::add(const BenchScene &scene) {
+    scenes().push_back(scene);
+    return true;
+}
+
+const BenchScene *BenchRegistry::find(const std::string &name) {
+    for (const BenchScene &scene: scenes()) {
+        if (name == scene.name) {
+            return &scene;
+        }
+    }
+    return nullptr;
+}
+
+// 当前场景的自定义计数: 名称 -> 累计值
+static std::map<std::string, double> g_Counters;
+
+void benchCounter(const char *name, double value) {
+    g_Counters[name] += value;
+}
+
+static int g_Failures = 0;
+
+void benchFail(const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    printf("FAIL: ");
+    vprintf(fmt, args);
+    printf("\n");
+    va_end(args);
+    g_Failures++;
+}
+
+static double nowMs(clockid_t clock) {
+    struct timespec ts{};
+    clock_gettime(clock, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+}
+
+//---------------------------------------------------------------------------
+// PNG 输出(不压缩的deflate块，不依赖zlib)
+//---------------------------------------------------------------------------
+static uint32_t pngCrc(uint32_t crc, const uint8_t *data, size_t len) {
+    static uint32_t table[256];
+    if (table[1] == 0) {
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+static void putBE32(std::vector<uint8_t> &out, uint32_t v) {
+    out.push_back((uint8_t) (v >> 24));
+    out.push_back((uint8_t) (v >> 16));
+    out.push_back((uint8_t) (v >> 8));
+    out.push_back((uint8_t) v);
+}
+
+static void pngChunk(std::vector<uint8_t> &out, const char *type, const std::vector<uint8_t> &data) {
+    putBE32(out, (uint32_t) data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    uint32_t crc = pngCrc(0xFFFFFFFFu, out.data() + start, out.size() - start) ^ 0xFFFFFFFFu;
+    putBE32(out, crc);
+}
+
+static bool writePng(const char *path, const uint8_t *rgba, uint32_t width, uint32_t height) {
+    std::vector<uint8_t> raw;
+    raw.reserve((size_t) (width * 4 + 1) * height);
+    for (uint32_t y = 0; y < height; y++) {
+        raw.push_back(0); // filter: none
+        raw.insert(raw.end(), rgba + (size_t) y * width * 4, rgba + (size_t) (y + 1) * width * 4);
+    }
+    std::vector<uint8_t> zdata = {0x78, 0x01};
+    uint32_t a = 1, b = 0;
+    for (uint8_t c: raw) {
+        a = (a + c) % 65521;
+        b = (b + a) % 65521;
+    }
+    size_t pos = 0;
+    do {
+        size_t len = std::min<size_t>(65535, raw.size() - pos);
+        zdata.push_back(pos + len == raw.size() ? 1 : 0);
+        zdata.push_back((uint8_t) len);
+        zdata.push_back((uint8_t) (len >> 8));
+        zdata.push_back((uint8_t) ~len);
+        zdata.push_back((uint8_t) (~len >> 8));
+        zdata.insert(zdata.end(), raw.begin() + (long) pos, raw.begin() + (long) (pos + len));
+        pos += len;
+    } while (pos < raw.size());
+    putBE32(zdata, (b << 16) | a);
+
+    std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    std::vector<uint8_t> ihdr;
+    putBE32(ihdr, width);
+    putBE32(ihdr, height);
+    ihdr.insert(ihdr.end(), {8, 6, 0, 0, 0}); // 8bit RGBA
+    pngChunk(png, "IHDR", ihdr);
+    pngChunk(png, "IDAT", zdata);
+    pngChunk(png, "IEND", {});
+    FILE *fp = fopen(path, "wb");
+    if (fp == nullptr) {
+        return false;
+    }
+    fwrite(png.data(), 1, png.size(), fp);
+    fclose(fp);
+    return true;
+}
+
+//---------------------------------------------------------------------------
+// Runner
+//---------------------------------------------------------------------------
+struct BenchOptions {
+    std::string scene = "all";
+    int frames = 300;
+    int warmup = 30;
+    const char *dumpDir = nullptr;
+    int dumpEvery = 0;
+};
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+    size_t index = (size_t) (p * (double) (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+static double average(const std::vector<double> &values) {
+    double sum = 0.0;
+    for (double v: values) {
+        sum += v;
+    }
+    return values.empty() ? 0.0 : sum / (double) values.size();
+}
+
+// 按后端的规则从实际渲染的 ImDrawData 推算这一帧的驱动调用数，和 OpenGL3 后端的统计比对
+static void checkRenderStats(const char *scene, int frame, const ImDrawData *drawData, const LayerRenderStats &stats,
+                             uint64_t lastFrame) {
+    int drawCalls = 0, textureBinds = 0, stateChanges = 1, callbacks = 0;
+    size_t bytes = 0;
+    ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+    bool sdfAtlas = (atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    bool sdf = false, textureValid = false, scissorValid = false;
+    ImTextureID texture = 0;
+    int scissor[4] = {};
+    float fbHeight = drawData->DisplaySize.y * drawData->FramebufferScale.y;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList *list = drawData->CmdLists[n];
+        bytes += (size_t) list->VtxBuffer.Size * sizeof(ImDrawVert) + (size_t) list->IdxBuffer.Size * sizeof(ImDrawIdx);
+        for (const ImDrawCmd &cmd: list->CmdBuffer) {
+            if (cmd.UserCallback != nullptr) {
+                if (cmd.UserCallback == ImDrawCallback_ResetRenderState) {
+                    stateChanges++;
+                    sdf = false;
+                } else {
+                    callbacks++;
+                }
+                textureValid = scissorValid = false;
+                continue;
+            }
+            ImVec2 clipMin((cmd.ClipRect.x - drawData->DisplayPos.x) * drawData->FramebufferScale.x,
+                           (cmd.ClipRect.y - drawData->DisplayPos.y) * drawData->FramebufferScale.y);
+            ImVec2 clipMax((cmd.ClipRect.z - drawData->DisplayPos.x) * drawData->FramebufferScale.x,
+                           (cmd.ClipRect.w - drawData->DisplayPos.y) * drawData->FramebufferScale.y);
+            if (clipMax.x <= clipMin.x || clipMax.y <= clipMin.y) {
+                continue;
+            }
+            int box[4] = {(int) clipMin.x, (int) (fbHeight - clipMax.y), (int) (clipMax.x - clipMin.x),
+                          (int) (clipMax.y - clipMin.y)};
+            if (!scissorValid || memcmp(box, scissor, sizeof(box)) != 0) {
+                memcpy(scissor, box, sizeof(box));
+                scissorValid = true;
+                stateChanges++;
+            }
+            if (!textureValid || cmd.GetTexID() != texture) {
+                texture = cmd.GetTexID();
+                textureValid = true;
+                textureBinds++;
+                stateChanges++;
+            }
+            bool cmdSdf = sdfAtlas && cmd.GetTexID() == atlas->TexID;
+            if (cmdSdf != sdf) {
+                sdf = cmdSdf;
+                stateChanges++;
+            }
+            drawCalls++;
+        }
+    }
+    // 字体图集在 NewFrame 中上传，计入同一帧
+    size_t fontBytes = ImGui_ImplOpenGL3_GetFontsTextureBytes();
+    if (stats.frame != lastFrame + 1 || stats.drawCalls != drawCalls || stats.textureBinds != textureBinds ||
+        stats.stateChanges != stateChanges || stats.userCallbacks != callbacks ||
+        (stats.bytesUploaded != bytes && stats.bytesUploaded != bytes + fontBytes)) {
+        benchFail("%s frame %d render stats: frame %llu (last %llu) draws %d/%d binds %d/%d state %d/%d callbacks %d/%d"
+                  " bytes %zu/%zu", scene, frame, (unsigned long long) stats.frame, (unsigned long long) lastFrame,
+                  stats.drawCalls, drawCalls, stats.textureBinds, textureBinds, stats.stateChanges, stateChanges,
+                  stats.userCallbacks, callbacks, stats.bytesUploaded, bytes);
+    }
+}
+
+static void runScene(const BenchScene &scene, const BenchOptions &options) {
+    if (scene.setup) {
+        scene.setup();
+    }
+    std::vector<double> cpuMs, uiMs, renderMs, wallMs;
+    double drawCalls = 0, vertices = 0, indices = 0;
+    double textureBinds = 0, uploadBytes = 0, gpuMs = 0;
+    int gpuFrames = 0;
+    LayerRenderStats stats;
+    uint64_t lastFrame = getMainLayer()->getRenderStats(stats) ? stats.frame : 0;
+    g_Counters.clear();
+    std::vector<uint8_t> pixels;
+    int total = options.warmup + options.frames;
+    for (int i = 0; i < total; i++) {
+        bool measure = i >= options.warmup;
+        if (i == options.warmup) {
+            g_Counters.clear();
+        }
+        double wall0 = nowMs(CLOCK_MONOTONIC);
+        double cpu0 = nowMs(CLOCK_THREAD_CPUTIME_ID);
+        drawBegin();
+        scene.frame(i);
+        double cpu1 = nowMs(CLOCK_THREAD_CPUTIME_ID);
+        drawEnd();
+        double cpu2 = nowMs(CLOCK_THREAD_CPUTIME_ID);
+        double wall1 = nowMs(CLOCK_MONOTONIC);
+        // 主图层实际渲染的是叠加了后台队列的列表
+        const ImDrawData *rendered = getDrawListQueue()->getSplicedDrawData();
+        if (rendered == nullptr) {
+            rendered = ImGui::GetDrawData();
+        }
+        if (rendered != nullptr && getMainLayer()->getRenderStats(stats)) {
+            checkRenderStats(scene.name, i, rendered, stats, lastFrame);
+            lastFrame = stats.frame;
+        }
+        if (!measure) {
+            continue;
+        }
+        textureBinds += stats.textureBinds;
+        uploadBytes += (double) stats.bytesUploaded;
+        if (stats.gpuTimeMs >= 0.0f) {
+            gpuMs += stats.gpuTimeMs;
+            gpuFrames++;
+        }
+        cpuMs.push_back(cpu2 - cpu0);
+        uiMs.push_back(cpu1 - cpu0);
+        renderMs.push_back(cpu2 - cpu1);
+        wallMs.push_back(wall1 - wall0);
+        ImDrawData *drawData = ImGui::GetDrawData();
+        if (drawData != nullptr) {
+            for (int n = 0; n < drawData->CmdListsCount; n++) {
+                drawCalls += drawData->CmdLists[n]->CmdBuffer.Size;
+            }
+            vertices += drawData->TotalVtxCount;
+            indices += drawData->TotalIdxCount;
+        }
+        if (options.dumpDir != nullptr && options.dumpEvery > 0 && (i - options.warmup) % options.dumpEvery == 0) {
+            auto *backend = (HeadlessLayerBackend *) getMainLayer()->getBackend();
+            if (backend->readPixels(pixels)) {
+                char path[512];
+                snprintf(path, sizeof(path), "%s/%s_%05d.png", options.dumpDir, scene.name, i - options.warmup);
+                writePng(path, pixels.data(), backend->getWidth(), backend->getHeight());
+            }
+        }
+    }
+    if (scene.teardown) {
+        scene.teardown();
+    }
+    double frames = (double) cpuMs.size();
+    printf("%-16s cpu %7.3f ms (p50 %7.3f p99 %7.3f) ui %7.3f ms render %7.3f ms wall %7.3f ms"
+           " | draw calls %8.1f vtx %9.1f idx %9.1f\n",
+           scene.name, average(cpuMs), percentile(cpuMs, 0.5), percentile(cpuMs, 0.99),
+           average(uiMs), average(renderMs), average(wallMs),
+           drawCalls / frames, vertices / frames, indices / frames);
+    printf("%-16s   texture binds %.1f/frame upload %.1f KB/frame", "", textureBinds / frames,
+           uploadBytes / 1024.0 / frames);
+    if (gpuFrames > 0) {
+        printf(" gpu %.3f ms", gpuMs / gpuFrames);
+    }
+    printf("\n");
+    for (auto &counter: g_Counters) {
+        printf("%-16s   %s: %.3f/frame\n", "", counter.first.c_str(), counter.second / frames);
+    }
+    fflush(stdout);
+}
+
+static void usage() {
+    printf("NativeBench [--scene name|all] [--frames N] [--warmup N] [--size WxH] [--dump dir] [--dump-every N] [--list]\n");
+}
+
+int main(int argc, char *argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--list") == 0) {
+            for (const BenchScene &scene: BenchRegistry::scenes()) {
+                printf("%-16s %s\n", scene.name, scene.desc);
+            }
+            return 0;
+        } else if (value == nullptr) {
+            usage();
+            return -1;
+        } else if (strcmp(arg, "--scene") == 0) {
+            options.scene = value;
+        } else if (strcmp(arg, "--frames") == 0) {
+            options.frames = atoi(value);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options.warmup = atoi(value);
+        } else if (strcmp(arg, "--size") == 0) {
+            setenv("HEADLESS_SIZE", value, 1);
+        } else if (strcmp(arg, "--dump") == 0) {
+            options.dumpDir = value;
+            if (options.dumpEvery == 0) {
+                options.dumpEvery = 60;
+            }
+        } else if (strcmp(arg, "--dump-every") == 0) {
+            options.dumpEvery = atoi(value);
+        } else {
+            usage();
+            return -1;
+        }
+        i++;
+    }
+    if (!initDraw(true)) {
+        return -1;
+    }
+    printf("frames: %d warmup: %d size: %ux%u\n", options.frames, options.warmup, displayInfo.width,
+           displayInfo.height);
+    bool found = false;
+    for (const BenchScene &scene: BenchRegistry::scenes()) {
+        if (options.scene == "all" || options.scene == scene.name) {
+            found = true;
+            runScene(scene, options);
+        }
+    }
+    if (!found) {
+        printf("no scene: %s\n", options.scene.c_str());
+    }
+    shutdown();
+    return found && g_Failures == 0 ? 0 : -1;
+}
@@ -0,0 +1,208 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 内存分配场景: 每帧的临时缓冲(文本缓冲/临时 ImDrawList/格式化字符串)，对比池分配器+帧内存与直接 malloc/free；
+// 开始前多个线程同时分配/释放(包括另一个线程释放)，线程退出后池统计必须回到原值
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <ctime>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+static const int ALLOC_LINES = 400;
+static const int ALLOC_PRIMS = 1000;
+static const int ALLOC_STRINGS = 2000;
+static const int ALLOC_THREADS = 4;
+static const int ALLOC_THREAD_BLOCKS = 50000;
+
+// 防止计时循环被优化掉
+static volatile int g_AllocSink;
+static int g_MallocCalls;
+
+static double nowUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+static double wallMs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+}
+
+// 未开启 IMGUI_USE_POOL_ALLOCATOR 时的默认分配器，额外统计调用次数
+static void *countingMalloc(size_t size, void *) {
+    g_MallocCalls++;
+    return malloc(size);
+}
+
+static void countingFree(void *ptr, void *) {
+    free(ptr);
+}
+
+// 一帧里常见的临时数据: 日志文本缓冲、离屏 ImDrawList、临时数组，全部在函数内释放
+static void transientWork(int frame) {
+    ImGuiTextBuffer log;
+    for (int i = 0; i < ALLOC_LINES; i++) {
+        log.appendf("[%05d] frame %d value %.3f\n", i, frame, (float) i * 0.25f);
+    }
+    ImDrawList drawList(ImGui::GetDrawListSharedData());
+    drawList._ResetForNewFrame();
+    drawList.PushClipRectFullScreen();
+    for (int i = 0; i < ALLOC_PRIMS; i++) {
+        float x = (float) (i % 40) * 20.0f, y = (float) (i / 40) * 20.0f;
+        drawList.AddRect(ImVec2(x, y), ImVec2(x + 16, y + 16), IM_COL32(255, 255, 0, 255));
+    }
+    ImVector<ImVec2> points;
+    for (int i = 0; i < ALLOC_PRIMS; i++) {
+        points.push_back(ImVec2((float) i, (float) (i * 7 % 100)));
+    }
+    g_AllocSink = log.size() + drawList.VtxBuffer.Size + points.Size;
+}
+
+// 格式化字符串: 每个一次 MemAlloc/MemFree，或从帧内存分配
+static void formatStrings(int frame, bool frameArena) {
+    int sink = 0;
+    for (int i = 0; i < ALLOC_STRINGS; i++) {
+        size_t size = 32 + (size_t) (i % 8) * 32;
+        char *buf = (char *) (frameArena ? ImGui::MemAllocFrame(size) : IM_ALLOC(size));
+        sink += ImFormatString(buf, size, "item %d frame %d", i, frame);
+        if (!frameArena) {
+            IM_FREE(buf);
+        }
+    }
+    g_AllocSink = sink;
+}
+
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+static int activeSlots(const ImGuiPoolAllocatorStats &stats) {
+    int slots = stats.LargeActive;
+    for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++) {
+        slots += stats.ClassActive[n];
+    }
+    return slots;
+}
+
+// 每个分级的最小和最大请求(上一级+1、本级大小)都要落在这一级，例如65和96字节都在96字节级
+static void checkPoolClasses() {
+    ImGuiPoolAllocatorStats before{}, during{};
+    ImGui::GetPoolAllocatorStats(&before);
+    void *blocks[IM_POOL_ALLOCATOR_CLASS_COUNT][2];
+    for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++) {
+        blocks[n][0] = IM_ALLOC(n == 0 ? 1 : (size_t) before.ClassSize[n - 1] + 1);
+        blocks[n][1] = IM_ALLOC((size_t) before.ClassSize[n]);
+    }
+    ImGui::GetPoolAllocatorStats(&during);
+    for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++) {
+        if (during.ClassActive[n] - before.ClassActive[n] != 2) {
+            benchFail("alloc: class %d bytes got %d of its 2 blocks (%d active)", before.ClassSize[n],
+                      during.ClassActive[n] - before.ClassActive[n], during.ClassActive[n]);
+        }
+        IM_FREE(blocks[n][0]);
+        IM_FREE(blocks[n][1]);
+    }
+}
+#endif
+
+// 先检查分级选择；每个线程有自己的空闲链表: 各线程同时分配/释放，线程0另外留下一批块由主线程释放
+static void allocSetup() {
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+    checkPoolClasses();
+    ImGuiPoolAllocatorStats before{}, after{};
+    ImGui::GetPoolAllocatorStats(&before);
+    std::vector<void *> handoff;
+    std::vector<std::thread> threads;
+    double t0 = wallMs();
+    for (int t = 0; t < ALLOC_THREADS; t++) {
+        threads.emplace_back([t, &handoff] {
+            std::vector<void *> blocks;
+            for (int i = 0; i < ALLOC_THREAD_BLOCKS; i++) {
+                blocks.push_back(IM_ALLOC(16 + (size_t) ((i * 37 + t * 11) % 4000)));
+                if (blocks.size() >= 256) {
+                    for (void *block: blocks) {
+                        IM_FREE(block);
+                    }
+                    blocks.clear();
+                }
+            }
+            for (void *block: blocks) {
+                IM_FREE(block);
+            }
+            if (t == 0) {
+                for (int i = 0; i < 4096; i++) {
+                    handoff.push_back(IM_ALLOC(48));
+                }
+            }
+        });
+    }
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+    for (void *block: handoff) {
+        IM_FREE(block);
+    }
+    double t1 = wallMs();
+    ImGui::GetPoolAllocatorStats(&after);
+    printf("alloc: %d threads x %d blocks in %.1f ms\n", ALLOC_THREADS, ALLOC_THREAD_BLOCKS, t1 - t0);
+    int expectedAllocs = ALLOC_THREADS * ALLOC_THREAD_BLOCKS + 4096;
+    if (after.ActiveBytes != before.ActiveBytes || activeSlots(after) != activeSlots(before) ||
+        after.AllocCount - before.AllocCount < expectedAllocs) {
+        benchFail("alloc: pool stats after threads exited: active %d -> %d bytes, %d -> %d blocks, %d allocs",
+                  before.ActiveBytes, after.ActiveBytes, activeSlots(before), activeSlots(after),
+                  after.AllocCount - before.AllocCount);
+    }
+#endif
+}
+
+static void allocFrame(int frame) {
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, 400), ImGuiCond_Always);
+    ImGui::ShowMetricsWindow();
+
+    // 当前分配器(IMGUI_USE_POOL_ALLOCATOR 时为池分配器)
+    int systemAllocs = 0;
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+    ImGuiPoolAllocatorStats stats{};
+    ImGui::GetPoolAllocatorStats(&stats);
+    systemAllocs = stats.SystemAllocCount;
+#endif
+    double t0 = nowUs();
+    transientWork(frame);
+    double t1 = nowUs();
+    formatStrings(frame, true);
+    double t2 = nowUs();
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+    ImGui::GetPoolAllocatorStats(&stats);
+    systemAllocs = stats.SystemAllocCount - systemAllocs;
+#endif
+
+    // 同样的工作换成 malloc/free，只在这段代码里替换，期间分配的内存都在这里释放
+    ImGuiMemAllocFunc allocFunc;
+    ImGuiMemFreeFunc freeFunc;
+    void *userData;
+    ImGui::GetAllocatorFunctions(&allocFunc, &freeFunc, &userData);
+    ImGui::SetAllocatorFunctions(countingMalloc, countingFree, nullptr);
+    g_MallocCalls = 0;
+    double t3 = nowUs();
+    transientWork(frame);
+    double t4 = nowUs();
+    formatStrings(frame, false);
+    double t5 = nowUs();
+    ImGui::SetAllocatorFunctions(allocFunc, freeFunc, userData);
+
+    benchCounter("pool transient us", t1 - t0);
+    benchCounter("arena strings us", t2 - t1);
+    benchCounter("pool malloc calls", systemAllocs);
+    benchCounter("malloc transient us", t4 - t3);
+    benchCounter("malloc strings us", t5 - t4);
+    benchCounter("malloc calls", g_MallocCalls);
+    benchCounter("MemAlloc calls/frame", ImGui::GetIO().MetricsFrameAllocations);
+}
+
+BENCH_SCENE("alloc", "Per-frame transient buffers: pool allocator + frame arena vs malloc/free", allocSetup, allocFrame,
+            nullptr);
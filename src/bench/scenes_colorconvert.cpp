@@ -0,0 +1,215 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 颜色转换场景: ColorConvert::yuv420pToRgb 的 SIMD 实现和标量参考实现逐字节比较(四种通道顺序、带行宽填充、奇数宽高)，
+// 标量定点实现和原来 test.cpp 里的浮点实现最多差1；720p/1080p 下对比浮点、标量、SIMD 的耗时，每帧转换一帧上传纹理
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "ColorConvert.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <memory>
+
+static const int CC_PREVIEW_WIDTH = 1280;
+static const int CC_PREVIEW_HEIGHT = 720;
+
+// 带行宽填充的 I420 帧(和 AVFrame 一样三个平面分开存放)
+struct CcFrame {
+    int width = 0;
+    int height = 0;
+    int strides[3] = {0, 0, 0};
+    std::vector<uint8_t> planes[3];
+
+    void init(int w, int h, int padding) {
+        width = w;
+        height = h;
+        int chromaWidth = (w + 1) / 2, chromaHeight = (h + 1) / 2;
+        strides[0] = w + padding;
+        strides[1] = strides[2] = chromaWidth + padding;
+        planes[0].assign((size_t) strides[0] * h, 0);
+        planes[1].assign((size_t) strides[1] * chromaHeight, 0);
+        planes[2].assign((size_t) strides[2] * chromaHeight, 0);
+    }
+
+    // 随机内容，混入 0/255 覆盖截断
+    void fillRandom() {
+        for (std::vector<uint8_t> &plane: planes) {
+            for (uint8_t &value: plane) {
+                int r = rand();
+                value = r % 8 == 0 ? 0 : (r % 8 == 1 ? 255 : (uint8_t) (r >> 4));
+            }
+        }
+    }
+
+    void convert(uint8_t *dst, int dstStride, ColorConvertOrder order, bool scalar) const {
+        if (scalar) {
+            ColorConvert::yuv420pToRgbScalar(planes[0].data(), strides[0], planes[1].data(), strides[1],
+                                             planes[2].data(), strides[2], dst, dstStride, width, height, order);
+        } else {
+            ColorConvert::yuv420pToRgb(planes[0].data(), strides[0], planes[1].data(), strides[1],
+                                       planes[2].data(), strides[2], dst, dstStride, width, height, order);
+        }
+    }
+};
+
+static CcFrame g_CcPreview;
+static std::vector<uint8_t> g_CcPixels;
+static std::unique_ptr<ImageTexture> g_CcTexture;
+
+// 原来 test.cpp 里的浮点实现(改为按行宽读取平面)，只用来对比误差和耗时
+static void floatYuv420pToBgr(const CcFrame &frame, uint8_t *dst, int dstStride) {
+    for (int y = 0; y < frame.height; y++) {
+        for (int x = 0; x < frame.width; x++) {
+            uint8_t Y = frame.planes[0][(size_t) y * frame.strides[0] + x];
+            uint8_t U = frame.planes[1][(size_t) (y / 2) * frame.strides[1] + x / 2];
+            uint8_t V = frame.planes[2][(size_t) (y / 2) * frame.strides[2] + x / 2];
+            int R = Y + 1.402 * (V - 128);
+            int G = Y - 0.34413 * (U - 128) - 0.71414 * (V - 128);
+            int B = Y + 1.772 * (U - 128);
+            R = R < 0 ? 0 : (R > 255 ? 255 : R);
+            G = G < 0 ? 0 : (G > 255 ? 255 : G);
+            B = B < 0 ? 0 : (B > 255 ? 255 : B);
+            uint8_t *pixel = dst + (size_t) y * dstStride + x * 3;
+            pixel[0] = (uint8_t) B;
+            pixel[1] = (uint8_t) G;
+            pixel[2] = (uint8_t) R;
+        }
+    }
+}
+
+// SIMD 和标量逐字节一致，输出行尾的填充不能被写
+static void checkBitExact(int width, int height, int padding) {
+    CcFrame frame;
+    frame.init(width, height, padding);
+    frame.fillRandom();
+    static const ColorConvertOrder orders[] = {ColorConvert_BGR, ColorConvert_RGB, ColorConvert_BGRA,
+                                               ColorConvert_RGBA};
+    for (ColorConvertOrder order: orders) {
+        int rowBytes = width * ColorConvert::channels(order);
+        int dstStride = rowBytes + padding;
+        std::vector<uint8_t> simd((size_t) dstStride * height, 0x5a);
+        std::vector<uint8_t> scalar((size_t) dstStride * height, 0x5a);
+        frame.convert(simd.data(), dstStride, order, false);
+        frame.convert(scalar.data(), dstStride, order, true);
+        for (size_t i = 0; i < simd.size(); i++) {
+            bool pad = (int) (i % dstStride) >= rowBytes;
+            if (simd[i] != scalar[i] || (pad && simd[i] != 0x5a)) {
+                benchFail("colorconvert %dx%d order %d byte %zu (row %zu): simd %d scalar %d", width, height,
+                          order, i, i / dstStride, simd[i], scalar[i]);
+                return;
+            }
+        }
+    }
+}
+
+// 定点实现和浮点实现的差异
+static void checkAgainstFloat(int width, int height) {
+    CcFrame frame;
+    frame.init(width, height, 16);
+    frame.fillRandom();
+    std::vector<uint8_t> fixed((size_t) width * height * 3), reference((size_t) width * height * 3);
+    frame.convert(fixed.data(), width * 3, ColorConvert_BGR, true);
+    floatYuv420pToBgr(frame, reference.data(), width * 3);
+    int maxDiff = 0;
+    for (size_t i = 0; i < fixed.size(); i++) {
+        int diff = abs((int) fixed[i] - (int) reference[i]);
+        maxDiff = diff > maxDiff ? diff : maxDiff;
+    }
+    if (maxDiff > 1) {
+        benchFail("colorconvert fixed point differs from float by %d", maxDiff);
+    }
+}
+
+static double timeMs(void (*convert)(const CcFrame &, uint8_t *), const CcFrame &frame, uint8_t *dst,
+                     int iterations) {
+    convert(frame, dst);
+    int64_t start = Profiler::nowNs();
+    for (int i = 0; i < iterations; i++) {
+        convert(frame, dst);
+    }
+    return (double) (Profiler::nowNs() - start) / 1e6 / iterations;
+}
+
+static void runFloat(const CcFrame &frame, uint8_t *dst) {
+    floatYuv420pToBgr(frame, dst, frame.width * 3);
+}
+
+static void runScalar(const CcFrame &frame, uint8_t *dst) {
+    frame.convert(dst, frame.width * 3, ColorConvert_BGR, true);
+}
+
+static void runSimd(const CcFrame &frame, uint8_t *dst) {
+    frame.convert(dst, frame.width * 3, ColorConvert_BGR, false);
+}
+
+static void benchmark(int width, int height) {
+    CcFrame frame;
+    frame.init(width, height, 64);
+    frame.fillRandom();
+    std::vector<uint8_t> dst((size_t) width * height * 3);
+    double floatMs = timeMs(runFloat, frame, dst.data(), 5);
+    double scalarMs = timeMs(runScalar, frame, dst.data(), 10);
+    double simdMs = timeMs(runSimd, frame, dst.data(), 20);
+    printf("colorconvert     %dx%d BGR  float %.2f ms  scalar %.2f ms  %s %.2f ms  (%.1fx vs float, %.1fx vs scalar)\n",
+           width, height, floatMs, scalarMs, ColorConvert::simdName(), simdMs, floatMs / simdMs, scalarMs / simdMs);
+}
+
+static void ccSetup() {
+    srand(7);
+    // 奇数宽高和不足16像素的尾部走标量路径
+    const int sizes[][2] = {{1, 1}, {15, 3}, {16, 2}, {33, 17}, {47, 9}, {1280, 720}, {1920, 1080}};
+    for (const auto &size: sizes) {
+        checkBitExact(size[0], size[1], 0);
+        checkBitExact(size[0], size[1], 13);
+    }
+    checkAgainstFloat(640, 360);
+    benchmark(1280, 720);
+    benchmark(1920, 1080);
+
+    g_CcPreview.init(CC_PREVIEW_WIDTH, CC_PREVIEW_HEIGHT, 32);
+    g_CcPixels.assign((size_t) CC_PREVIEW_WIDTH * CC_PREVIEW_HEIGHT * 4, 0);
+    g_CcTexture.reset(new ImageTexture());
+}
+
+static void ccFrame(int frame) {
+    // 渐变画面: 亮度沿 x 移动，色度沿 y 变化
+    for (int y = 0; y < CC_PREVIEW_HEIGHT; y++) {
+        uint8_t *row = g_CcPreview.planes[0].data() + (size_t) y * g_CcPreview.strides[0];
+        for (int x = 0; x < CC_PREVIEW_WIDTH; x++) {
+            row[x] = (uint8_t) (x + frame * 8);
+        }
+    }
+    for (int y = 0; y < CC_PREVIEW_HEIGHT / 2; y++) {
+        memset(g_CcPreview.planes[1].data() + (size_t) y * g_CcPreview.strides[1], (uint8_t) (y + frame * 4),
+               CC_PREVIEW_WIDTH / 2);
+        memset(g_CcPreview.planes[2].data() + (size_t) y * g_CcPreview.strides[2], (uint8_t) (255 - y),
+               CC_PREVIEW_WIDTH / 2);
+    }
+    int64_t start = Profiler::nowNs();
+    g_CcPreview.convert(g_CcPixels.data(), CC_PREVIEW_WIDTH * 4, ColorConvert_RGBA, false);
+    double ms = (double) (Profiler::nowNs() - start) / 1e6;
+    benchCounter("convert ms", ms);
+    g_CcTexture->setPixels(ImageTexture_RGBA, g_CcPixels.data(), CC_PREVIEW_WIDTH, CC_PREVIEW_HEIGHT);
+
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::Begin("ColorConvert", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("%s  %dx%d  %.2f ms", ColorConvert::simdName(), CC_PREVIEW_WIDTH, CC_PREVIEW_HEIGHT, ms);
+    ImGui::Image((ImTextureID) g_CcTexture->getOpenglTexture(),
+                 ImVec2(CC_PREVIEW_WIDTH / 2, CC_PREVIEW_HEIGHT / 2));
+    ImGui::End();
+}
+
+static void ccTeardown() {
+    g_CcTexture.reset();
+    g_CcPixels.clear();
+    g_CcPixels.shrink_to_fit();
+    g_CcPreview = CcFrame();
+}
+
+BENCH_SCENE("colorconvert", "YUV420P to RGB: SIMD vs scalar bit-exact checks, 720p/1080p timing and a live preview",
+            ccSetup, ccFrame, ccTeardown);
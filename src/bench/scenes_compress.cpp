@@ -0,0 +1,392 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 压缩场景: CompressContext 各算法单包/流模式往返(空数据、不可压缩、高度重复、1MB)，截断和改写的数据解压不会越界；
+// 系统有 liblz4 时和它互相解压校验格式兼容；DataEnc 头的压缩标记经 DataDec 解压后字段不变。
+// 遥测数据(每帧一个包: 计数器 + 分析器区段)上对比每次新建 z_stream 的默认级别(原 test1.cpp 的做法)、
+// zlib 级别1、LZ4 的压缩率和 MB/s；每帧把分析器实际记录的区段打包，用流模式 LZ4 发送再解包校验
+//
+
+#include "Bench.h"
+#include "Compress.h"
+#include "DataEnc.h"
+#include "DataDec.h"
+#include "Profiler.h"
+#include <zlib.h>
+#include <dlfcn.h>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <vector>
+#include <string>
+
+static const int TELEMETRY_PACKETS = 600;       // 60fps 10秒
+static const int TELEMETRY_BUFFER = 16 * 1024;
+
+static const char *const g_TelemetryZones[] = {
+        "drawBegin", "ImGui::NewFrame", "OverlayLayer::beginFrame", "DrawListQueue::splice", "ImGui::Render",
+        "OverlayLayer::endFrame", "TextureCache::upload", "FrameDiff::update", "H264Decoder::decode",
+        "ColorConvert::yuv420pToRgb", "TCPClient::recvo", "Pipeline::stage", "present", "drawEnd",
+};
+
+static std::vector<std::vector<uint8_t>> g_TelemetryCorpus;
+static CompressContext *g_CompressSender = nullptr;
+static CompressContext *g_CompressReceiver = nullptr;
+static int64_t g_CompressLastNs = 0;
+static uint64_t g_CompressLiveRaw = 0;
+static uint64_t g_CompressLivePacked = 0;
+static int g_CompressLivePackets = 0;
+
+// 合成的遥测包: 和 DataEnc 的实际用法一样逐字段写入
+static int makeTelemetryPacket(mbyte *buffer, int capacity, int seq) {
+    DataEnc dataEnc(buffer, capacity);
+    dataEnc.setCmd(100);
+    dataEnc.setCount(seq);
+    dataEnc.putInt(seq).putLong(1700000000000LL + seq * 16667LL);
+    dataEnc.putFloat(60.0f - (float) (rand() % 3)).putFloat(9.0f + (float) (rand() % 400) / 100.0f);
+    for (int i = 0; i < 8; i++) {
+        dataEnc.putFloat((float) (i * 100) + std::sin((float) seq * 0.05f + (float) i) * 10.0f);
+    }
+    int zones = 10 + rand() % 5;
+    dataEnc.putInt(zones);
+    int startUs = 0;
+    for (int i = 0; i < zones; i++) {
+        dataEnc.putStr(g_TelemetryZones[i]);
+        int durationUs = 50 + rand() % 900;
+        dataEnc.putInt(startUs).putInt(durationUs).putByte((mbyte) (i % 3));
+        startUs += durationUs + rand() % 40;
+    }
+    dataEnc.getData();
+    return dataEnc.getDataLen();
+}
+
+static void roundTrip(CompressContext &sender, CompressContext &receiver, CompressCodec codec,
+                      const std::vector<uint8_t> &data, const char *what) {
+    std::vector<uint8_t> packed((size_t) CompressContext::bound(codec, (int) data.size()) + 1);
+    std::vector<uint8_t> unpacked(data.size() + 1);
+    int length = sender.compress(codec, data.data(), (int) data.size(), packed.data(), (int) packed.size());
+    int decoded = length < 0 ? -1 : receiver.decompress(codec, packed.data(), length, unpacked.data(),
+                                                        (int) unpacked.size());
+    if (decoded != (int) data.size() || memcmp(unpacked.data(), data.data(), data.size()) != 0) {
+        benchFail("compress %s %s%s: %zu -> %d -> %d", CompressContext::getCodecName(codec), what,
+                  sender.isStreaming() ? " (stream)" : "", data.size(), length, decoded);
+    }
+}
+
+static void checkRoundTrips() {
+    std::vector<std::vector<uint8_t>> inputs(5);
+    inputs[1].assign(1, 42);
+    inputs[2].resize(70000);
+    for (uint8_t &value: inputs[2]) {
+        value = (uint8_t) rand();
+    }
+    // 很长的重复(匹配长度超过255，重叠复制)
+    inputs[3].assign(100000, 'x');
+    for (size_t i = 0; i < inputs[3].size(); i += 1000) {
+        inputs[3][i] = (uint8_t) ('a' + i % 26);
+    }
+    // 1MB 界面像素: 横条纹加少量噪声
+    inputs[4].resize(1024 * 1024);
+    for (size_t i = 0; i < inputs[4].size(); i++) {
+        inputs[4][i] = (uint8_t) ((i / 4096) % 2 ? 200 : 40 + (rand() % 16 == 0));
+    }
+    const char *names[] = {"empty", "1 byte", "random", "repeat", "1MB ui"};
+    for (int streaming = 0; streaming < 2; streaming++) {
+        for (int codec = Compress_None; codec < Compress_CodecCount; codec++) {
+            CompressContext sender, receiver;
+            sender.setStreaming(streaming != 0);
+            receiver.setStreaming(streaming != 0);
+            // 同一个上下文连续使用两轮，流模式下第二轮引用第一轮的数据
+            for (int round = 0; round < 2; round++) {
+                for (size_t i = 0; i < inputs.size(); i++) {
+                    roundTrip(sender, receiver, (CompressCodec) codec, inputs[i], names[i]);
+                }
+            }
+            if (sender.getStats().errors != 0 || receiver.getStats().errors != 0) {
+                benchFail("compress %s: %llu errors", CompressContext::getCodecName((CompressCodec) codec),
+                          (unsigned long long) (sender.getStats().errors + receiver.getStats().errors));
+            }
+        }
+    }
+    // 流模式的小包: 第二个相同的包几乎只剩一个匹配
+    CompressContext stream;
+    stream.setStreaming(true);
+    mbyte packet[TELEMETRY_BUFFER];
+    int length = makeTelemetryPacket(packet, TELEMETRY_BUFFER, 1);
+    uint8_t out[TELEMETRY_BUFFER];
+    stream.compress(Compress_Lz4, (uint8_t *) packet, length, out, sizeof(out));
+    int second = stream.compress(Compress_Lz4, (uint8_t *) packet, length, out, sizeof(out));
+    if (second < 0 || second > 16) {
+        benchFail("compress lz4 stream: repeated %d byte packet took %d bytes", length, second);
+    }
+}
+
+// 损坏的数据只能返回错误或者错误的内容，不能越界(配合 ASan 运行时更有意义)
+static void checkCorrupt() {
+    std::vector<uint8_t> data(20000);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = (uint8_t) ((i * 7) % 251 < 120 ? 'a' + i % 5 : rand());
+    }
+    CompressContext context;
+    for (int codec = Compress_Zlib; codec < Compress_CodecCount; codec++) {
+        std::vector<uint8_t> packed((size_t) CompressContext::bound((CompressCodec) codec, (int) data.size()));
+        int length = context.compress((CompressCodec) codec, data.data(), (int) data.size(), packed.data(),
+                                      (int) packed.size());
+        std::vector<uint8_t> out(data.size());
+        for (int i = 0; i < 200; i++) {
+            std::vector<uint8_t> broken(packed.begin(), packed.begin() + length);
+            int cut = rand() % length;
+            broken[(size_t) rand() % broken.size()] ^= (uint8_t) (1 + rand() % 255);
+            int decoded = context.decompress((CompressCodec) codec, broken.data(), i % 2 ? cut : length, out.data(),
+                                             (int) out.size());
+            if (decoded > (int) out.size()) {
+                benchFail("compress %s corrupt input decoded %d bytes",
+                          CompressContext::getCodecName((CompressCodec) codec), decoded);
+            }
+        }
+        // 输出缓冲小一个字节
+        if (context.decompress((CompressCodec) codec, packed.data(), length, out.data(), (int) out.size() - 1) >= 0) {
+            benchFail("compress %s: short output buffer not detected",
+                      CompressContext::getCodecName((CompressCodec) codec));
+        }
+    }
+}
+
+// 系统里有 liblz4(没有头文件也可以)时互相解压
+static void checkLz4Compatible() {
+    void *handle = dlopen("liblz4.so.1", RTLD_NOW);
+    if (handle == nullptr) {
+        printf("compress         liblz4 not found, format compatibility not checked\n");
+        return;
+    }
+    auto decompressSafe = (int (*)(const char *, char *, int, int)) dlsym(handle, "LZ4_decompress_safe");
+    auto compressDefault = (int (*)(const char *, char *, int, int)) dlsym(handle, "LZ4_compress_default");
+    if (decompressSafe != nullptr && compressDefault != nullptr) {
+        std::vector<uint8_t> data(300000);
+        for (size_t i = 0; i < data.size(); i++) {
+            data[i] = (uint8_t) (i % 3000 < 2000 ? "telemetry zone "[i % 15] : rand());
+        }
+        CompressContext context;
+        std::vector<uint8_t> packed((size_t) CompressContext::bound(Compress_Lz4, (int) data.size()));
+        std::vector<uint8_t> out(data.size());
+        int length = context.compress(Compress_Lz4, data.data(), (int) data.size(), packed.data(),
+                                      (int) packed.size());
+        int decoded = decompressSafe((const char *) packed.data(), (char *) out.data(), length, (int) out.size());
+        if (decoded != (int) data.size() || memcmp(out.data(), data.data(), data.size()) != 0) {
+            benchFail("compress: liblz4 cannot decode our lz4 block (%d)", decoded);
+        }
+        length = compressDefault((const char *) data.data(), (char *) packed.data(), (int) data.size(),
+                                 (int) packed.size());
+        decoded = context.decompress(Compress_Lz4, packed.data(), length, out.data(), (int) out.size());
+        if (decoded != (int) data.size() || memcmp(out.data(), data.data(), data.size()) != 0) {
+            benchFail("compress: cannot decode liblz4 block (%d)", decoded);
+        }
+    }
+    dlclose(handle);
+}
+
+// DataEnc 头的压缩标记，DataDec 解压后按原来的字段读取
+static void checkDataEnc() {
+    CompressContext sender, receiver;
+    sender.setStreaming(true);
+    receiver.setStreaming(true);
+    mbyte buffer[TELEMETRY_BUFFER];
+    for (int i = 0; i < 50; i++) {
+        CompressCodec codec = (CompressCodec) (i % Compress_CodecCount);
+        DataEnc dataEnc(buffer, TELEMETRY_BUFFER);
+        dataEnc.setCmd(7);
+        dataEnc.setCount(i);
+        dataEnc.putInt(i).putString("zone name repeated zone name repeated").putLong(123456789LL * i);
+        int rawLength = dataEnc.getDataIndex();
+        if (!dataEnc.compress(sender, codec)) {
+            benchFail("compress: DataEnc::compress %s failed", CompressContext::getCodecName(codec));
+            return;
+        }
+        dataEnc.getData();
+        DataDec dataDec(buffer, dataEnc.getDataLen());
+        if (dataDec.getCodec() != codec || dataDec.getLength() != dataEnc.getDataLen() - DataDec::headerSize()) {
+            benchFail("compress: header codec %d length %d", dataDec.getCodec(), dataDec.getLength());
+            return;
+        }
+        if (!dataDec.decompress(receiver) || dataDec.getCmd() != 7 || dataDec.getCount() != i ||
+            dataDec.getLength() != rawLength || dataDec.getInt() != i ||
+            dataDec.getString() != "zone name repeated zone name repeated" || dataDec.getLong() != 123456789LL * i) {
+            benchFail("compress: DataDec %s packet %d does not match", CompressContext::getCodecName(codec), i);
+            return;
+        }
+    }
+}
+
+struct CompressResult {
+    uint64_t raw = 0;
+    uint64_t packed = 0;
+    double compressMs = 0.0;
+    double decompressMs = 0.0;
+};
+
+// 原 test1.cpp 的 gzCompress: 每次新建 z_stream，默认级别
+static int freshDeflate(const uint8_t *src, int length, uint8_t *dst, int capacity) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 | 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return -1;
+    }
+    stream.next_in = (Bytef *) src;
+    stream.avail_in = (uInt) length;
+    stream.next_out = dst;
+    stream.avail_out = (uInt) capacity;
+    int err = deflate(&stream, Z_FINISH);
+    int out = (int) stream.total_out;
+    deflateEnd(&stream);
+    return err == Z_STREAM_END ? out : -1;
+}
+
+static int freshInflate(const uint8_t *src, int length, uint8_t *dst, int capacity) {
+    z_stream stream;
+    memset(&stream, 0, sizeof(stream));
+    if (inflateInit2(&stream, 15 | 16) != Z_OK) {
+        return -1;
+    }
+    stream.next_in = (Bytef *) src;
+    stream.avail_in = (uInt) length;
+    stream.next_out = dst;
+    stream.avail_out = (uInt) capacity;
+    int err = inflate(&stream, Z_FINISH);
+    int out = (int) stream.total_out;
+    inflateEnd(&stream);
+    return err == Z_STREAM_END ? out : -1;
+}
+
+static CompressResult runCorpus(CompressCodec codec, int level, bool streaming, bool fresh) {
+    CompressResult result;
+    CompressContext sender(level), receiver(level);
+    sender.setStreaming(streaming);
+    receiver.setStreaming(streaming);
+    std::vector<std::vector<uint8_t>> packed(g_TelemetryCorpus.size());
+    int64_t start = Profiler::nowNs();
+    for (size_t i = 0; i < g_TelemetryCorpus.size(); i++) {
+        const std::vector<uint8_t> &data = g_TelemetryCorpus[i];
+        packed[i].resize((size_t) CompressContext::bound(Compress_Zlib, (int) data.size()) + 32);
+        int length = fresh ? freshDeflate(data.data(), (int) data.size(), packed[i].data(), (int) packed[i].size())
+                           : sender.compress(codec, data.data(), (int) data.size(), packed[i].data(),
+                                             (int) packed[i].size());
+        packed[i].resize(length < 0 ? 0 : (size_t) length);
+        result.raw += data.size();
+        result.packed += packed[i].size();
+    }
+    result.compressMs = (double) (Profiler::nowNs() - start) / 1e6;
+    std::vector<uint8_t> out(TELEMETRY_BUFFER);
+    start = Profiler::nowNs();
+    for (size_t i = 0; i < packed.size(); i++) {
+        int length = fresh ? freshInflate(packed[i].data(), (int) packed[i].size(), out.data(), (int) out.size())
+                           : receiver.decompress(codec, packed[i].data(), (int) packed[i].size(), out.data(),
+                                                 (int) out.size());
+        if (length != (int) g_TelemetryCorpus[i].size() ||
+            memcmp(out.data(), g_TelemetryCorpus[i].data(), (size_t) length) != 0) {
+            benchFail("compress corpus %s packet %zu", CompressContext::getCodecName(codec), i);
+            break;
+        }
+    }
+    result.decompressMs = (double) (Profiler::nowNs() - start) / 1e6;
+    return result;
+}
+
+static void printCorpus(const char *name, const CompressResult &result) {
+    double megabytes = (double) result.raw / (1024.0 * 1024.0);
+    printf("compress         %-22s ratio %5.2f  compress %7.1f MB/s  decompress %7.1f MB/s  %.2f us/packet\n",
+           name, (double) result.raw / (double) std::max<uint64_t>(1, result.packed),
+           megabytes / (result.compressMs / 1000.0), megabytes / (result.decompressMs / 1000.0),
+           result.compressMs * 1000.0 / (double) g_TelemetryCorpus.size());
+}
+
+static void compressSetup() {
+    srand(17);
+    checkRoundTrips();
+    checkCorrupt();
+    checkLz4Compatible();
+    checkDataEnc();
+
+    g_TelemetryCorpus.clear();
+    mbyte buffer[TELEMETRY_BUFFER];
+    for (int i = 0; i < TELEMETRY_PACKETS; i++) {
+        int length = makeTelemetryPacket(buffer, TELEMETRY_BUFFER, i);
+        g_TelemetryCorpus.emplace_back((uint8_t *) buffer, (uint8_t *) buffer + length);
+    }
+    printf("compress         telemetry: %d packets, %.0f bytes/packet\n", TELEMETRY_PACKETS,
+           (double) g_TelemetryCorpus[0].size());
+    printCorpus("gzip default (fresh)", runCorpus(Compress_Zlib, 6, false, true));
+    printCorpus("zlib 1", runCorpus(Compress_Zlib, 1, false, false));
+    printCorpus("zlib 1 stream", runCorpus(Compress_Zlib, 1, true, false));
+    printCorpus("lz4", runCorpus(Compress_Lz4, 1, false, false));
+    printCorpus("lz4 stream", runCorpus(Compress_Lz4, 1, true, false));
+
+    g_CompressSender = new CompressContext();
+    g_CompressReceiver = new CompressContext();
+    g_CompressSender->setStreaming(true);
+    g_CompressReceiver->setStreaming(true);
+    g_CompressLastNs = Profiler::nowNs();
+    g_CompressLiveRaw = 0;
+    g_CompressLivePacked = 0;
+    g_CompressLivePackets = 0;
+}
+
+// 分析器上一帧实际记录的区段打包成遥测，流模式 LZ4 压缩后解包比较
+static void compressFrame(int frame) {
+    static std::vector<ProfileThreadEvents> threads;
+    Profiler::collect(threads, g_CompressLastNs);
+    int64_t now = Profiler::nowNs();
+    static std::vector<mbyte> buffer(256 * 1024);
+    DataEnc dataEnc(buffer.data(), (int) buffer.size());
+    dataEnc.setCmd(100);
+    dataEnc.setCount(frame);
+    int events = 0;
+    for (const ProfileThreadEvents &thread: threads) {
+        events += (int) thread.events.size();
+    }
+    dataEnc.putInt(frame).putLong(now).putInt(events);
+    for (const ProfileThreadEvents &thread: threads) {
+        for (const ProfileEvent &event: thread.events) {
+            if (dataEnc.getDataLen() + 256 > (int) buffer.size()) {
+                break;
+            }
+            dataEnc.putInt(thread.tid).putStr(event.name);
+            dataEnc.putInt((int) ((event.startNs - g_CompressLastNs) / 1000));
+            dataEnc.putInt((int) ((event.endNs - event.startNs) / 1000)).putByte((mbyte) event.depth);
+        }
+    }
+    g_CompressLastNs = now;
+    int rawLength = dataEnc.getDataIndex();
+    if (!dataEnc.compress(*g_CompressSender, Compress_Lz4)) {
+        benchFail("compress frame %d: DataEnc::compress failed", frame);
+        return;
+    }
+    dataEnc.getData();
+    DataDec dataDec(buffer.data(), dataEnc.getDataLen());
+    if (!dataDec.decompress(*g_CompressReceiver) || dataDec.getLength() != rawLength || dataDec.getInt() != frame ||
+        dataDec.getLong() != now || dataDec.getInt() != events) {
+        benchFail("compress frame %d: live telemetry round trip failed", frame);
+    }
+    g_CompressLiveRaw += (uint64_t) rawLength;
+    g_CompressLivePacked += (uint64_t) dataEnc.getDataIndex();
+    g_CompressLivePackets++;
+    benchCounter("telemetry bytes", rawLength);
+    benchCounter("telemetry lz4 bytes", dataEnc.getDataIndex());
+}
+
+static void compressTeardown() {
+    CompressStats stats = g_CompressSender->getStats();
+    printf("compress         live profiler telemetry: %d packets, %.0f -> %.0f bytes/packet (ratio %.2f), "
+           "%.1f us/packet\n", g_CompressLivePackets,
+           g_CompressLivePackets > 0 ? (double) g_CompressLiveRaw / g_CompressLivePackets : 0.0,
+           g_CompressLivePackets > 0 ? (double) g_CompressLivePacked / g_CompressLivePackets : 0.0,
+           (double) g_CompressLiveRaw / (double) std::max<uint64_t>(1, g_CompressLivePacked),
+           stats.compressCalls > 0 ? stats.compressMs * 1000.0 / (double) stats.compressCalls : 0.0);
+    delete g_CompressSender;
+    g_CompressSender = nullptr;
+    delete g_CompressReceiver;
+    g_CompressReceiver = nullptr;
+    g_TelemetryCorpus.clear();
+}
+
+BENCH_SCENE("compress", "zlib/lz4 round trips, DataEnc compression flag, telemetry ratio and MB/s",
+            compressSetup, compressFrame, compressTeardown);
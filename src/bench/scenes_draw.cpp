@@ -0,0 +1,316 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// ImDrawList 图元场景: 10k图元/20k矩形微基准，以及SIMD细分、批量接口的golden顶点比对
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <cstring>
+
+// 固定种子的随机数，保证每次生成的图元一致
+static uint32_t g_DrawSeed = 1;
+
+static float drawRandom(float min, float max) {
+    g_DrawSeed = g_DrawSeed * 1664525u + 1013904223u;
+    return min + (max - min) * (float) (g_DrawSeed >> 8) / (float) (1 << 24);
+}
+
+static ImU32 drawRandomColor() {
+    return IM_COL32((int) drawRandom(0, 255), (int) drawRandom(0, 255), (int) drawRandom(0, 255), 255);
+}
+
+//---------------------------------------------------------------------------
+// prims10k: 每帧10000个图元(矩形框/线/圆/实心圆)，分到10个窗口避免单个 ImDrawList 超过16位索引
+//---------------------------------------------------------------------------
+static const int PRIM_WINDOWS = 10;
+static const int PRIMS_PER_WINDOW = 1000;
+
+static void primitives(int frame, bool simd) {
+    ImGui::GetDrawListSharedData()->TessellationSimd = simd;
+    ImVec2 display = ImGui::GetIO().DisplaySize;
+    for (int w = 0; w < PRIM_WINDOWS; w++) {
+        char name[32];
+        snprintf(name, sizeof(name), "prims_%d", w);
+        ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+        ImGui::SetNextWindowSize(display, ImGuiCond_Always);
+        ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground |
+                                    ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoSavedSettings);
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        g_DrawSeed = (uint32_t) (w * 7919 + frame);
+        for (int i = 0; i < PRIMS_PER_WINDOW; i++) {
+            ImVec2 p(drawRandom(0, display.x), drawRandom(0, display.y));
+            ImU32 col = drawRandomColor();
+            switch (i & 3) {
+                case 0:
+                    drawList->AddRect(p, ImVec2(p.x + drawRandom(10, 80), p.y + drawRandom(20, 160)), col, 0.0f, 0,
+                                      2.0f);
+                    break;
+                case 1:
+                    drawList->AddLine(p, ImVec2(p.x + drawRandom(-100, 100), p.y + drawRandom(-100, 100)), col, 1.5f);
+                    break;
+                case 2:
+                    drawList->AddCircle(p, drawRandom(4, 16), col, 0, 1.0f);
+                    break;
+                default:
+                    drawList->AddCircleFilled(p, drawRandom(3, 10), col);
+                    break;
+            }
+        }
+        ImGui::End();
+    }
+    ImGui::GetDrawListSharedData()->TessellationSimd = true;
+}
+
+static void primitivesSimdFrame(int frame) {
+    primitives(frame, true);
+}
+
+static void primitivesScalarFrame(int frame) {
+    primitives(frame, false);
+}
+
+BENCH_SCENE("prims10k", "10000 rect/line/circle primitives, SIMD tessellation", nullptr, primitivesSimdFrame, nullptr);
+BENCH_SCENE("prims10k_scalar", "10000 rect/line/circle primitives, scalar tessellation", nullptr,
+            primitivesScalarFrame, nullptr);
+
+//---------------------------------------------------------------------------
+// tess_golden: 相同的图元分别用SIMD和标量路径细分，顶点/索引必须逐字节一致
+//---------------------------------------------------------------------------
+static void goldenPrimitives(ImDrawList *drawList) {
+    g_DrawSeed = 12345;
+    ImVector<ImVec2> points;
+    const float thicknesses[] = {0.5f, 1.0f, 1.5f, 2.0f, 3.0f, 7.3f};
+    for (int i = 0; i < 400; i++) {
+        // 随机折线，包含重复点(零长度线段)
+        int count = 2 + (int) drawRandom(0, 40);
+        points.resize(0);
+        for (int n = 0; n < count; n++) {
+            if (n > 0 && drawRandom(0, 1) < 0.1f) {
+                points.push_back(points.back());
+            } else {
+                points.push_back(ImVec2(drawRandom(-50, 1200), drawRandom(-50, 2500)));
+            }
+        }
+        ImDrawFlags flags = drawRandom(0, 1) < 0.5f ? ImDrawFlags_Closed : ImDrawFlags_None;
+        float thickness = thicknesses[i % IM_ARRAYSIZE(thicknesses)];
+        drawList->AddPolyline(points.Data, points.Size, drawRandomColor(), flags, thickness);
+        if (count >= 3) {
+            drawList->AddConvexPolyFilled(points.Data, points.Size, drawRandomColor());
+        }
+        ImVec2 p(drawRandom(0, 1000), drawRandom(0, 2000));
+        drawList->AddRect(p, ImVec2(p.x + drawRandom(0, 200), p.y + drawRandom(0, 200)), drawRandomColor(),
+                          drawRandom(0, 8), 0, thickness);
+        drawList->AddCircle(p, drawRandom(0.5f, 300), drawRandomColor(), 0, thickness);
+        drawList->AddCircleFilled(p, drawRandom(0.5f, 300), drawRandomColor());
+        drawList->AddNgonFilled(p, drawRandom(1, 50), drawRandomColor(), 3 + i % 9);
+        drawList->AddBezierCubic(p, ImVec2(p.x + 50, p.y - 80), ImVec2(p.x + 120, p.y + 90),
+                                 ImVec2(p.x + 200, p.y), drawRandomColor(), thickness);
+        // 两点线段和直角矩形框(标记框常用)，以及退化的零长度线段
+        drawList->AddLine(p, ImVec2(p.x + drawRandom(-100, 100), p.y + drawRandom(-100, 100)), drawRandomColor(),
+                          thickness);
+        drawList->AddLine(p, p, drawRandomColor(), thickness);
+        drawList->AddRect(p, ImVec2(p.x + drawRandom(0, 80), p.y + drawRandom(0, 160)), drawRandomColor(), 0.0f, 0,
+                          thickness);
+        drawList->AddRectFilled(p, ImVec2(p.x + drawRandom(0, 80), p.y + drawRandom(0, 160)), drawRandomColor(),
+                                drawRandom(0, 12));
+    }
+}
+
+static void goldenDraw(ImDrawList *drawList, ImDrawListFlags flags, float fringeScale, bool simd) {
+    ImDrawListSharedData *sharedData = ImGui::GetDrawListSharedData();
+    drawList->_ResetForNewFrame();
+    drawList->Flags = flags;
+    drawList->_FringeScale = fringeScale;
+    drawList->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    drawList->PushClipRectFullScreen();
+    sharedData->TessellationSimd = simd;
+    goldenPrimitives(drawList);
+    sharedData->TessellationSimd = true;
+}
+
+static void goldenFrame(int frame) {
+    // 覆盖非抗锯齿、抗锯齿线(几何/纹理)、抗锯齿填充几条路径，最后一组放大AA边缘(不走纹理线)
+    const ImDrawListFlags variants[] = {
+            ImDrawListFlags_None,
+            ImDrawListFlags_AntiAliasedLines,
+            ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex,
+            ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedFill,
+            ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AntiAliasedFill,
+    };
+    ImDrawList simd(ImGui::GetDrawListSharedData());
+    ImDrawList scalar(ImGui::GetDrawListSharedData());
+    for (int v = 0; v <= IM_ARRAYSIZE(variants); v++) {
+        ImDrawListFlags flags = variants[v < IM_ARRAYSIZE(variants) ? v : IM_ARRAYSIZE(variants) - 1];
+        float fringeScale = v < IM_ARRAYSIZE(variants) ? 1.0f : 2.0f;
+        goldenDraw(&simd, flags, fringeScale, true);
+        goldenDraw(&scalar, flags, fringeScale, false);
+        bool same = simd.VtxBuffer.Size == scalar.VtxBuffer.Size && simd.IdxBuffer.Size == scalar.IdxBuffer.Size &&
+                    memcmp(simd.VtxBuffer.Data, scalar.VtxBuffer.Data, simd.VtxBuffer.size_in_bytes()) == 0 &&
+                    memcmp(simd.IdxBuffer.Data, scalar.IdxBuffer.Data, simd.IdxBuffer.size_in_bytes()) == 0;
+        if (!same) {
+            benchFail("tess_golden flags:%d fringe:%.0f vtx %d/%d idx %d/%d differ", flags, fringeScale,
+                      simd.VtxBuffer.Size, scalar.VtxBuffer.Size, simd.IdxBuffer.Size, scalar.IdxBuffer.Size);
+        } else if (frame == 0) {
+            printf("tess_golden flags:%d fringe:%.0f vtx:%d idx:%d identical\n", flags, fringeScale,
+                   simd.VtxBuffer.Size, simd.IdxBuffer.Size);
+        }
+        benchCounter("golden vertices", simd.VtxBuffer.Size);
+    }
+}
+
+BENCH_SCENE("tess_golden", "SIMD vs scalar tessellation golden vertex comparison", nullptr, goldenFrame, nullptr);
+
+//---------------------------------------------------------------------------
+// rects20k: 每帧20000个矩形框，逐个 AddRect 对比 AddRectsBatch (4个窗口，每个5000个，避免超过16位索引)
+//---------------------------------------------------------------------------
+static const int RECT_WINDOWS = 4;
+static const int RECTS_PER_WINDOW = 5000;
+
+static ImVector<ImVec2> g_RectMin;
+static ImVector<ImVec2> g_RectMax;
+static ImVector<ImU32> g_RectCols;
+
+static void rectsSetup() {
+    ImVec2 display = ImGui::GetIO().DisplaySize;
+    int count = RECT_WINDOWS * RECTS_PER_WINDOW;
+    g_RectMin.resize(count);
+    g_RectMax.resize(count);
+    g_RectCols.resize(count);
+    g_DrawSeed = 1;
+    for (int i = 0; i < count; i++) {
+        g_RectMin[i] = ImVec2(drawRandom(0, display.x), drawRandom(0, display.y));
+        g_RectMax[i] = ImVec2(g_RectMin[i].x + drawRandom(8, 64), g_RectMin[i].y + drawRandom(8, 64));
+        g_RectCols[i] = drawRandomColor();
+    }
+}
+
+static void rects(int frame, bool batch) {
+    ImVec2 display = ImGui::GetIO().DisplaySize;
+    // 每帧整体平移，模拟跟随目标的标记框
+    ImVec2 offset((float) (frame % 32), (float) (frame % 16));
+    for (int w = 0; w < RECT_WINDOWS; w++) {
+        char name[32];
+        snprintf(name, sizeof(name), "rects_%d", w);
+        ImGui::SetNextWindowPos(offset, ImGuiCond_Always);
+        ImGui::SetNextWindowSize(display, ImGuiCond_Always);
+        ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground |
+                                    ImGuiWindowFlags_NoInputs | ImGuiWindowFlags_NoSavedSettings);
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        int start = w * RECTS_PER_WINDOW;
+        if (batch) {
+            drawList->AddRectsBatch(g_RectMin.Data + start, g_RectMax.Data + start, g_RectCols.Data + start,
+                                    RECTS_PER_WINDOW, 2.0f);
+        } else {
+            for (int i = start; i < start + RECTS_PER_WINDOW; i++) {
+                drawList->AddRect(g_RectMin[i], g_RectMax[i], g_RectCols[i], 0.0f, 0, 2.0f);
+            }
+        }
+        ImGui::End();
+    }
+}
+
+static void rectsFrame(int frame) {
+    rects(frame, false);
+}
+
+static void rectsBatchFrame(int frame) {
+    rects(frame, true);
+}
+
+static void rectsTeardown() {
+    g_RectMin.clear();
+    g_RectMax.clear();
+    g_RectCols.clear();
+}
+
+BENCH_SCENE("rects20k", "20000 rect outlines, AddRect per item", rectsSetup, rectsFrame, rectsTeardown);
+BENCH_SCENE("rects20k_batch", "20000 rect outlines, AddRectsBatch", rectsSetup, rectsBatchFrame, rectsTeardown);
+
+//---------------------------------------------------------------------------
+// batch_golden: AddXXXBatch 与逐个调用的顶点/索引必须逐字节一致
+//---------------------------------------------------------------------------
+static const int BATCH_GOLDEN_ITEMS = 600;
+
+static void batchGoldenDraw(ImDrawList *drawList, ImDrawListFlags flags, bool batch) {
+    drawList->_ResetForNewFrame();
+    drawList->Flags = flags;
+    drawList->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    drawList->PushClipRect(ImVec2(0, 0), ImVec2(1000, 2000));
+
+    ImVector<ImVec2> a, b;
+    ImVector<float> radii;
+    ImVector<ImU32> cols;
+    ImVector<const char *> texts;
+    const char *labels[] = {"", "enemy", "hp 100", "dist 35m\nlv 12", "\xe4\xb8\xad", "  x  "};
+    g_DrawSeed = 777;
+    for (int i = 0; i < BATCH_GOLDEN_ITEMS; i++) {
+        // 部分落在裁剪区外，部分透明
+        a.push_back(ImVec2(drawRandom(-100, 1100), drawRandom(-100, 2100)));
+        b.push_back(ImVec2(a.back().x + drawRandom(-20, 80), a.back().y + drawRandom(-20, 80)));
+        radii.push_back(drawRandom(-2, 120));
+        cols.push_back(i % 17 == 0 ? IM_COL32(255, 0, 0, 0) : drawRandomColor());
+        texts.push_back(labels[i % IM_ARRAYSIZE(labels)]);
+    }
+    const float thicknesses[] = {1.0f, 2.0f, 3.5f};
+    for (float thickness: thicknesses) {
+        if (batch) {
+            drawList->AddRectsBatch(a.Data, b.Data, cols.Data, a.Size, thickness);
+            drawList->AddLinesBatch(a.Data, b.Data, cols.Data, a.Size, thickness);
+            drawList->AddCirclesBatch(a.Data, radii.Data, cols.Data, a.Size, 0, thickness);
+            drawList->AddCirclesBatch(a.Data, radii.Data, cols.Data, a.Size, 7, thickness);
+        } else {
+            for (int i = 0; i < a.Size; i++) {
+                drawList->AddRect(a[i], b[i], cols[i], 0.0f, 0, thickness);
+            }
+            for (int i = 0; i < a.Size; i++) {
+                drawList->AddLine(a[i], b[i], cols[i], thickness);
+            }
+            for (int i = 0; i < a.Size; i++) {
+                drawList->AddCircle(a[i], radii[i], cols[i], 0, thickness);
+            }
+            for (int i = 0; i < a.Size; i++) {
+                drawList->AddCircle(a[i], radii[i], cols[i], 7, thickness);
+            }
+        }
+    }
+    if (batch) {
+        drawList->AddTextBatch(a.Data, texts.Data, cols.Data, a.Size);
+    } else {
+        for (int i = 0; i < a.Size; i++) {
+            drawList->AddText(a[i], cols[i], texts[i]);
+        }
+    }
+}
+
+static void batchGoldenFrame(int frame) {
+    const ImDrawListFlags variants[] = {
+            ImDrawListFlags_None,
+            ImDrawListFlags_AntiAliasedLines,
+            ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex,
+            ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex | ImDrawListFlags_AllowVtxOffset,
+    };
+    ImDrawList single(ImGui::GetDrawListSharedData());
+    ImDrawList batch(ImGui::GetDrawListSharedData());
+    for (ImDrawListFlags flags: variants) {
+        batchGoldenDraw(&single, flags, false);
+        batchGoldenDraw(&batch, flags, true);
+        bool same = single.VtxBuffer.Size == batch.VtxBuffer.Size && single.IdxBuffer.Size == batch.IdxBuffer.Size &&
+                    single.CmdBuffer.Size == batch.CmdBuffer.Size &&
+                    memcmp(single.VtxBuffer.Data, batch.VtxBuffer.Data, single.VtxBuffer.size_in_bytes()) == 0 &&
+                    memcmp(single.IdxBuffer.Data, batch.IdxBuffer.Data, single.IdxBuffer.size_in_bytes()) == 0 &&
+                    memcmp(single.CmdBuffer.Data, batch.CmdBuffer.Data, single.CmdBuffer.size_in_bytes()) == 0;
+        if (!same) {
+            benchFail("batch_golden flags:%d vtx %d/%d idx %d/%d cmd %d/%d differ", flags, single.VtxBuffer.Size,
+                      batch.VtxBuffer.Size, single.IdxBuffer.Size, batch.IdxBuffer.Size, single.CmdBuffer.Size,
+                      batch.CmdBuffer.Size);
+        } else if (frame == 0) {
+            printf("batch_golden flags:%d vtx:%d idx:%d cmd:%d identical\n", flags, batch.VtxBuffer.Size,
+                   batch.IdxBuffer.Size, batch.CmdBuffer.Size);
+        }
+    }
+}
+
+BENCH_SCENE("batch_golden", "AddXXXBatch vs per-item calls golden vertex comparison", nullptr, batchGoldenFrame,
+            nullptr);
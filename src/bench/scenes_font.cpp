@@ -0,0 +1,205 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 距离场字体场景: 一套 SDF 图集对比烘焙三个字号的图集(显存/构建耗时)，
+// 主图层切换到 SDF 图集后同一段文字放大到 1x~5x，与位图字体放大比较边缘清晰度
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include <imgui_internal.h>
+#include <memory>
+#include <cstdlib>
+#include <ctime>
+
+static const float FONT_BASE_SIZE = 22.0f;              // 与 OverlayLayer 默认字体一致
+static const float FONT_SCALES[] = {1.0f, 2.0f, 3.0f, 5.0f};
+static const int FONT_SCALE_COUNT = sizeof(FONT_SCALES) / sizeof(FONT_SCALES[0]);
+static const char *FONT_SAMPLE = "Hg@8%";
+static const float FONT_ROW_Y = 1500.0f;
+static const float FONT_SDF_X = 20.0f;
+static const float FONT_BITMAP_X = 560.0f;
+
+static ImFontAtlasFlags g_FontLayerFlags;
+static std::unique_ptr<ImFontAtlas> g_FontBitmapAtlas;
+static std::unique_ptr<ImageTexture> g_FontBitmapTexture;
+static std::vector<uint8_t> g_FontPixels;
+
+static double nowUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+// 只在CPU上构建图集，输出 Alpha8 大小和构建耗时
+static void buildAtlas(const char *config, const char *path, const float *sizes, int count, bool sdf,
+                       const ImWchar *ranges) {
+    ImFontAtlas atlas;
+    if (sdf) {
+        atlas.Flags |= ImFontAtlasFlags_SignedDistanceField;
+    }
+    for (int i = 0; i < count; i++) {
+        ImFontConfig fontConfig;
+        fontConfig.SizePixels = sizes[i];
+        ImFont *font = path != nullptr ? atlas.AddFontFromFileTTF(path, sizes[i], &fontConfig, ranges)
+                                       : atlas.AddFontDefault(&fontConfig);
+        if (font == nullptr) {
+            return;
+        }
+    }
+    double t0 = nowUs();
+    unsigned char *pixels;
+    int width, height;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+    double t1 = nowUs();
+    printf("sdffont          %-32s %4dx%-4d Alpha8 %8.1f KB  build %8.2f ms\n", config, width, height,
+           (double) width * height / 1024.0, (t1 - t0) / 1000.0);
+}
+
+// 主图层字体图集按新的 flags 重新构建并上传(只能在帧外调用)
+static void rebuildLayerAtlas(ImFontAtlasFlags flags) {
+    ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+    ImGui_ImplOpenGL3_DestroyFontsTexture();
+    atlas->ClearTexData();
+    atlas->Flags = flags;
+    double t0 = nowUs();
+    atlas->Build();
+    double t1 = nowUs();
+    ImGui_ImplOpenGL3_CreateFontsTexture();
+    printf("sdffont          layer atlas %-20s %4dx%-4d uploaded %8.1f KB  build %8.2f ms\n",
+           flags & ImFontAtlasFlags_SignedDistanceField ? "sdf" : "bitmap", atlas->TexWidth, atlas->TexHeight,
+           (double) ImGui_ImplOpenGL3_GetFontsTextureBytes() / 1024.0, (t1 - t0) / 1000.0);
+}
+
+static void fontSetup() {
+    ImGuiIO &io = ImGui::GetIO();
+    if (io.Fonts->TexID == ImTextureID{}) {
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+    }
+
+    // 现在的做法: 每个需要的字号烘焙一份；SDF: 一份基础字号
+    const float bakedSizes[] = {FONT_BASE_SIZE, FONT_BASE_SIZE * 2.0f, FONT_BASE_SIZE * 3.0f};
+    buildAtlas("default baked 22/44/66px", nullptr, bakedSizes, 3, false, nullptr);
+    buildAtlas("default sdf 22px", nullptr, bakedSizes, 1, true, nullptr);
+    if (const char *path = getenv("BENCH_FONT")) {
+        const ImWchar *ranges = io.Fonts->GetGlyphRangesChineseSimplifiedCommon();
+        const float cjkSizes[] = {40.0f, 80.0f, 120.0f};
+        buildAtlas("BENCH_FONT CJK baked 40/80/120px", path, cjkSizes, 3, false, ranges);
+        buildAtlas("BENCH_FONT CJK sdf 40px", path, cjkSizes, 1, true, ranges);
+    }
+
+    // 对比用的位图字体，和主图层同一字号，用单独的纹理
+    g_FontBitmapAtlas.reset(new ImFontAtlas());
+    ImFontConfig fontConfig;
+    fontConfig.SizePixels = FONT_BASE_SIZE;
+    g_FontBitmapAtlas->AddFontDefault(&fontConfig);
+    unsigned char *pixels;
+    int width, height;
+    g_FontBitmapAtlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    g_FontBitmapTexture.reset(new ImageTexture());
+    g_FontBitmapTexture->setPixels(ImageTexture_RGBA, pixels, width, height);
+    g_FontBitmapAtlas->SetTexID((ImTextureID) g_FontBitmapTexture->getOpenglTexture());
+
+    g_FontLayerFlags = io.Fonts->Flags;
+    rebuildLayerAtlas(g_FontLayerFlags | ImFontAtlasFlags_SignedDistanceField);
+}
+
+// 区域内白色文字的覆盖统计: 半透明像素占比越低边缘越锐利，墨量用来确认两种字体字形大小一致
+struct FontCoverage {
+    double ink = 0.0;
+    int partial = 0;
+    int solid = 0;
+};
+
+static FontCoverage measureCoverage(const std::vector<uint8_t> &pixels, uint32_t width, int x0, int y0, int x1,
+                                    int y1) {
+    FontCoverage coverage;
+    for (int y = y0; y < y1; y++) {
+        for (int x = x0; x < x1; x++) {
+            int value = pixels[((size_t) y * width + x) * 4];
+            coverage.ink += value / 255.0;
+            if (value >= 230) {
+                coverage.solid++;
+            } else if (value > 25) {
+                coverage.partial++;
+            }
+        }
+    }
+    return coverage;
+}
+
+static float rowY(int row) {
+    float y = FONT_ROW_Y;
+    for (int i = 0; i < row; i++) {
+        y += FONT_BASE_SIZE * FONT_SCALES[i] + 16.0f;
+    }
+    return y;
+}
+
+static void checkPreviousFrame(int frame) {
+    auto *backend = (HeadlessLayerBackend *) getMainLayer()->getBackend();
+    if (frame < 2 || !backend->readPixels(g_FontPixels)) {
+        return;
+    }
+    uint32_t width = backend->getWidth();
+    for (int row = 0; row < FONT_SCALE_COUNT; row++) {
+        int y0 = (int) rowY(row) - 4;
+        int y1 = (int) (rowY(row) + FONT_BASE_SIZE * FONT_SCALES[row]) + 4;
+        FontCoverage sdf = measureCoverage(g_FontPixels, width, (int) FONT_SDF_X - 4, y0, (int) FONT_BITMAP_X - 20, y1);
+        FontCoverage bitmap = measureCoverage(g_FontPixels, width, (int) FONT_BITMAP_X - 4, y0, (int) width - 4, y1);
+        double sdfSoft = (double) sdf.partial / ImMax(1, sdf.partial + sdf.solid);
+        double bitmapSoft = (double) bitmap.partial / ImMax(1, bitmap.partial + bitmap.solid);
+        char name[48];
+        snprintf(name, sizeof(name), "%.0fx edge ratio sdf", FONT_SCALES[row]);
+        benchCounter(name, sdfSoft);
+        snprintf(name, sizeof(name), "%.0fx edge ratio bitmap", FONT_SCALES[row]);
+        benchCounter(name, bitmapSoft);
+        if (bitmap.ink <= 0.0 || sdf.ink < bitmap.ink * 0.75 || sdf.ink > bitmap.ink * 1.25) {
+            benchFail("sdffont %.0fx ink sdf %.0f bitmap %.0f", FONT_SCALES[row], sdf.ink, bitmap.ink);
+        }
+        if (FONT_SCALES[row] >= 2.0f && sdfSoft >= bitmapSoft) {
+            benchFail("sdffont %.0fx sdf edges (%.2f) not sharper than bitmap (%.2f)", FONT_SCALES[row], sdfSoft,
+                      bitmapSoft);
+        }
+    }
+}
+
+static void fontFrame(int frame) {
+    checkPreviousFrame(frame);
+
+    // 普通界面也用 SDF 图集绘制
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, 1200), ImGuiCond_Always);
+    ImGui::Begin("sdffont", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    for (int i = 0; i < 20; i++) {
+        ImGui::Text("Line %02d: The quick brown fox jumps over the lazy dog 0123456789", i);
+    }
+    ImGui::SetWindowFontScale(2.0f);
+    ImGui::Text("Window font scale 2x");
+    ImGui::SetWindowFontScale(1.0f);
+    static float value = 0.5f;
+    ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+    ImGui::End();
+
+    ImDrawList *drawList = ImGui::GetForegroundDrawList();
+    ImFont *sdfFont = ImGui::GetIO().Fonts->Fonts[0];
+    ImFont *bitmapFont = g_FontBitmapAtlas->Fonts[0];
+    for (int row = 0; row < FONT_SCALE_COUNT; row++) {
+        float size = FONT_BASE_SIZE * FONT_SCALES[row];
+        drawList->AddText(sdfFont, size, ImVec2(FONT_SDF_X, rowY(row)), IM_COL32_WHITE, FONT_SAMPLE);
+        drawList->PushTextureID(g_FontBitmapAtlas->TexID);
+        drawList->AddText(bitmapFont, size, ImVec2(FONT_BITMAP_X, rowY(row)), IM_COL32_WHITE, FONT_SAMPLE);
+        drawList->PopTextureID();
+    }
+}
+
+static void fontTeardown() {
+    rebuildLayerAtlas(g_FontLayerFlags);
+    g_FontBitmapAtlas.reset();
+    g_FontBitmapTexture.reset();
+    g_FontPixels.clear();
+}
+
+BENCH_SCENE("sdffont", "One SDF font atlas vs three baked sizes: memory, build time and edge sharpness at 1x-5x",
+            fontSetup, fontFrame, fontTeardown);
@@ -0,0 +1,334 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 帧缓冲场景: 模拟 H264Decoder 的 解码 -> 分析 -> 显示 流程，解码输出(YUV420P)和RGB都从 FrameBufferPool 取，
+// 引用交给分析线程和纹理上传，不拷贝像素；和原来每帧 malloc + 拷贝平面的流程对比耗时和分配次数。
+// 校验引用计数、复用、空闲上限、池先于引用销毁，以及预热之后不再有新的分配
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "FrameBuffer.h"
+#include "ColorConvert.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <memory>
+
+static const int FB_WIDTH = 1280;
+static const int FB_HEIGHT = 720;
+static const int FB_REFERENCE_FRAMES = 4;      // 解码器持有的参考帧
+static const int FB_WARMUP_FRAMES = 8;
+
+struct FbJob {
+    FrameBufferRef yuv;
+    FrameBufferRef rgb;
+};
+
+static std::unique_ptr<FrameBufferPool> g_FbYuvPool;
+static std::unique_ptr<FrameBufferPool> g_FbRgbPool;
+static std::unique_ptr<ImageTexture> g_FbTexture;
+static std::deque<FrameBufferRef> g_FbReferences;
+static uint64_t g_FbSeq = 0;
+static uint64_t g_FbWarmAllocations = 0;
+static double g_FbPooledMs = 0.0;
+static double g_FbCopyMs = 0.0;
+static uint64_t g_FbCopyMallocs = 0;
+static int g_FbFrames = 0;
+
+// 分析线程: 校验 YUV 内容和序号，读RGB求平均亮度
+static std::thread g_FbAnalysis;
+static std::mutex g_FbMutex;
+static std::condition_variable g_FbCond;
+static std::deque<FbJob> g_FbQueue;
+static bool g_FbRunning = false;
+static std::atomic<int> g_FbAnalyzed{0};
+static std::atomic<int> g_FbErrors{0};
+
+static uint8_t fbLuma(uint64_t seq, int row) {
+    return (uint8_t) (seq * 7 + row);
+}
+
+// 模拟解码器写入 YUV 平面
+static void fbFillYuv(FrameBuffer *buffer, uint64_t seq) {
+    for (int y = 0; y < buffer->height; y++) {
+        memset(buffer->planes[0] + (size_t) y * buffer->strides[0], fbLuma(seq, y), buffer->width);
+    }
+    int chromaWidth = (buffer->width + 1) / 2, chromaHeight = (buffer->height + 1) / 2;
+    for (int y = 0; y < chromaHeight; y++) {
+        memset(buffer->planes[1] + (size_t) y * buffer->strides[1], (uint8_t) (128 + y % 64), chromaWidth);
+        memset(buffer->planes[2] + (size_t) y * buffer->strides[2], (uint8_t) (160 - y % 64), chromaWidth);
+    }
+    buffer->seq = seq;
+}
+
+static bool fbCheckYuv(const FrameBuffer *buffer) {
+    for (int y = 0; y < buffer->height; y += 7) {
+        const uint8_t *row = buffer->planes[0] + (size_t) y * buffer->strides[0];
+        uint8_t expected = fbLuma(buffer->seq, y);
+        if (row[0] != expected || row[buffer->width - 1] != expected) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void fbAnalysisLoop() {
+    PROFILE_THREAD("fb analysis");
+    std::unique_lock<std::mutex> lock(g_FbMutex);
+    while (true) {
+        g_FbCond.wait(lock, [] { return !g_FbRunning || !g_FbQueue.empty(); });
+        if (g_FbQueue.empty()) {
+            break;
+        }
+        FbJob job = std::move(g_FbQueue.front());
+        g_FbQueue.pop_front();
+        lock.unlock();
+        {
+            PROFILE_ZONE("fb analyze");
+            uint64_t sum = 0;
+            const FrameBuffer *rgb = job.rgb.get();
+            for (int y = 0; y < rgb->height; y += 4) {
+                const uint8_t *row = rgb->planes[0] + (size_t) y * rgb->strides[0];
+                for (int x = 0; x < rgb->width * 3; x += 12) {
+                    sum += row[x];
+                }
+            }
+            benchCounter("fb analysis sum", (double) (sum & 0xff));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            // 分析期间解码端一直在写其他缓冲
+            if (!fbCheckYuv(job.yuv.get()) || job.rgb->seq != job.yuv->seq) {
+                g_FbErrors.fetch_add(1);
+            }
+        }
+        g_FbAnalyzed.fetch_add(1);
+        job = FbJob();
+        lock.lock();
+    }
+}
+
+static void fbCheckLayout() {
+    FrameBufferPool pool(2, 64);
+    FrameBufferRef yuv = pool.acquire(FrameBuffer_YUV420P, 33, 17);
+    if (!yuv || yuv->planeCount != 3 || yuv->strides[0] != 64 || yuv->strides[1] != 64 ||
+        ((uintptr_t) yuv->planes[1] & 63) != 0 || ((uintptr_t) yuv->planes[2] & 63) != 0 ||
+        yuv->planes[1] < yuv->planes[0] + 64 * 17 || yuv->planes[2] < yuv->planes[1] + 64 * 9 ||
+        yuv->size + 64 > yuv->capacity) {
+        benchFail("framebuffer yuv 33x17 layout");
+    }
+    FrameBufferPool tight(2, 1);
+    FrameBufferRef rgb = tight.acquire(FrameBuffer_RGB24, 33, 17);
+    if (!rgb || rgb->planeCount != 1 || rgb->strides[0] != 99 || rgb->planes[1] != nullptr) {
+        benchFail("framebuffer tight rgb layout");
+    }
+    if (pool.owns(rgb.get()) || !tight.owns(rgb.get()) || pool.acquire(FrameBuffer_RGBA, 0, 10)) {
+        benchFail("framebuffer owns/invalid size");
+    }
+}
+
+static void fbCheckRefs() {
+    FrameBufferPool pool(2);
+    FrameBufferRef a = pool.acquire(FrameBuffer_RGBA, 64, 64);
+    uint8_t *data = a->data;
+    FrameBufferRef b = a;
+    FrameBufferRef c = std::move(b);
+    if (a.useCount() != 2 || b || pool.getStats().outstanding != 1) {
+        benchFail("framebuffer copy/move: use count %d", a.useCount());
+    }
+    // detach/adopt 模拟 av_buffer_create 的 free 回调
+    FrameBuffer *raw = c.detach();
+    FrameBufferRef retained = FrameBufferRef::retain(raw);
+    if (a.useCount() != 3) {
+        benchFail("framebuffer retain: use count %d", a.useCount());
+    }
+    FrameBufferRef::adopt(raw).reset();
+    retained.reset();
+    a.reset();
+    FrameBufferStats stats = pool.getStats();
+    if (stats.outstanding != 0 || stats.releases != 1 || stats.freeCount != 1) {
+        benchFail("framebuffer release: outstanding %d releases %llu free %d", stats.outstanding,
+                  (unsigned long long) stats.releases, stats.freeCount);
+    }
+    // 同尺寸复用同一块，尺寸更小时复用容量足够的
+    FrameBufferRef again = pool.acquire(FrameBuffer_RGBA, 64, 64);
+    if (again->data != data || pool.getStats().reuses != 1) {
+        benchFail("framebuffer same size not reused");
+    }
+    again.reset();
+    FrameBufferRef smaller = pool.acquire(FrameBuffer_GRAY8, 30, 30);
+    if (smaller->data != data || smaller->format != FrameBuffer_GRAY8 || smaller->strides[0] != 64 ||
+        pool.getStats().allocations != 1) {
+        benchFail("framebuffer smaller size not reused");
+    }
+}
+
+static void fbCheckLimits() {
+    FrameBufferPool pool(2);
+    std::vector<FrameBufferRef> held;
+    for (int i = 0; i < 5; i++) {
+        held.push_back(pool.acquire(FrameBuffer_RGB24, 100, 100));
+    }
+    held.clear();
+    FrameBufferStats stats = pool.getStats();
+    if (stats.allocations != 5 || stats.freeCount != 2 || stats.freed != 3 || stats.maxOutstanding != 5) {
+        benchFail("framebuffer max free: allocations %llu free %d freed %llu", (unsigned long long) stats.allocations,
+                  stats.freeCount, (unsigned long long) stats.freed);
+    }
+    // 池先销毁，持有的引用释放时直接释放内存
+    std::unique_ptr<FrameBufferPool> shortLived(new FrameBufferPool(2));
+    FrameBufferRef survivor = shortLived->acquire(FrameBuffer_RGB24, 100, 100);
+    FrameBufferRef second = survivor;
+    shortLived.reset();
+    memset(survivor->planes[0], 0x7f, (size_t) survivor->strides[0] * survivor->height);
+    second.reset();
+    survivor.reset();
+}
+
+static void fbSetup() {
+    fbCheckLayout();
+    fbCheckRefs();
+    fbCheckLimits();
+    // 空闲上限要容纳参考帧 + 分析队列 + 显示中的帧，预热之后不再分配
+    g_FbYuvPool.reset(new FrameBufferPool(FB_REFERENCE_FRAMES + 8, 64));
+    g_FbRgbPool.reset(new FrameBufferPool(8, 64));
+    g_FbTexture.reset(new ImageTexture());
+    g_FbSeq = 0;
+    g_FbWarmAllocations = 0;
+    g_FbPooledMs = 0.0;
+    g_FbCopyMs = 0.0;
+    g_FbCopyMallocs = 0;
+    g_FbFrames = 0;
+    g_FbAnalyzed = 0;
+    g_FbErrors = 0;
+    g_FbRunning = true;
+    g_FbAnalysis = std::thread(fbAnalysisLoop);
+}
+
+// 原来的流程: 拷贝平面到连续缓冲，再转换到新分配的RGB缓冲，最后交出去之前再拷贝一次
+static void fbCopyPath(const FrameBuffer *yuv) {
+    int width = yuv->width, height = yuv->height;
+    auto *contiguous = (uint8_t *) malloc((size_t) width * height * 3 / 2);
+    auto *rgb = (uint8_t *) malloc((size_t) width * height * 3);
+    auto *out = (uint8_t *) malloc((size_t) width * height * 3);
+    g_FbCopyMallocs += 3;
+    uint8_t *dst = contiguous;
+    for (int y = 0; y < height; y++, dst += width) {
+        memcpy(dst, yuv->planes[0] + (size_t) y * yuv->strides[0], width);
+    }
+    for (int p = 1; p < 3; p++) {
+        for (int y = 0; y < height / 2; y++, dst += width / 2) {
+            memcpy(dst, yuv->planes[p] + (size_t) y * yuv->strides[p], width / 2);
+        }
+    }
+    ColorConvert::yuv420pToRgb(contiguous, width, contiguous + width * height, width / 2,
+                               contiguous + width * height * 5 / 4, width / 2, rgb, width * 3, width, height,
+                               ColorConvert_RGB);
+    memcpy(out, rgb, (size_t) width * height * 3);
+    benchCounter("fb copy checksum", out[(size_t) width * height * 3 / 2]);
+    free(contiguous);
+    free(rgb);
+    free(out);
+}
+
+static void fbFrame(int frame) {
+    int64_t start = Profiler::nowNs();
+    // 解码: 输出写进池里的缓冲，解码器持有最近几帧作为参考帧
+    FrameBufferRef yuv = g_FbYuvPool->acquire(FrameBuffer_YUV420P, FB_WIDTH, FB_HEIGHT);
+    if (!yuv) {
+        benchFail("framebuffer yuv acquire failed");
+        return;
+    }
+    fbFillYuv(yuv.get(), ++g_FbSeq);
+    g_FbReferences.push_back(yuv);
+    if (g_FbReferences.size() > (size_t) FB_REFERENCE_FRAMES) {
+        g_FbReferences.pop_front();
+    }
+    FrameBufferRef rgb = g_FbRgbPool->acquire(FrameBuffer_RGB24, FB_WIDTH, FB_HEIGHT);
+    ColorConvert::yuv420pToRgb(yuv->planes[0], yuv->strides[0], yuv->planes[1], yuv->strides[1], yuv->planes[2],
+                               yuv->strides[2], rgb->planes[0], rgb->strides[0], FB_WIDTH, FB_HEIGHT,
+                               ColorConvert_RGB);
+    rgb->seq = yuv->seq;
+    {
+        std::lock_guard<std::mutex> lock(g_FbMutex);
+        g_FbQueue.push_back({yuv, rgb});
+    }
+    g_FbCond.notify_one();
+    double pooledMs = (double) (Profiler::nowNs() - start) / 1e6;
+
+    start = Profiler::nowNs();
+    fbCopyPath(yuv.get());
+    double copyMs = (double) (Profiler::nowNs() - start) / 1e6;
+    g_FbPooledMs += pooledMs;
+    g_FbCopyMs += copyMs;
+    g_FbFrames++;
+    benchCounter("fb pooled ms", pooledMs);
+    benchCounter("fb copy ms", copyMs);
+
+    // 显示: 按缓冲行宽直接上传
+    if (!g_FbTexture->setFrame(rgb)) {
+        benchFail("framebuffer texture upload failed");
+    }
+    if (frame == FB_WARMUP_FRAMES) {
+        g_FbWarmAllocations = g_FbYuvPool->getStats().allocations + g_FbRgbPool->getStats().allocations;
+    }
+
+    FrameBufferStats yuvStats = g_FbYuvPool->getStats(), rgbStats = g_FbRgbPool->getStats();
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::Begin("FrameBuffer", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("seq %llu  analyzed %d  pooled %.2f ms  copy %.2f ms", (unsigned long long) g_FbSeq,
+                g_FbAnalyzed.load(), pooledMs, copyMs);
+    ImGui::Text("yuv: alloc %llu reuse %llu outstanding %d | rgb: alloc %llu reuse %llu outstanding %d",
+                (unsigned long long) yuvStats.allocations, (unsigned long long) yuvStats.reuses,
+                yuvStats.outstanding, (unsigned long long) rgbStats.allocations,
+                (unsigned long long) rgbStats.reuses, rgbStats.outstanding);
+    ImGui::Image((ImTextureID) g_FbTexture->getOpenglTexture(), ImVec2(FB_WIDTH / 2, FB_HEIGHT / 2));
+    ImGui::End();
+}
+
+static void fbTeardown() {
+    {
+        std::lock_guard<std::mutex> lock(g_FbMutex);
+        g_FbRunning = false;
+    }
+    g_FbCond.notify_all();
+    g_FbAnalysis.join();
+    g_FbReferences.clear();
+
+    FrameBufferStats yuvStats = g_FbYuvPool->getStats(), rgbStats = g_FbRgbPool->getStats();
+    uint64_t allocations = yuvStats.allocations + rgbStats.allocations;
+    printf("framebuffer      %d frames | pooled %.2f ms/frame, %llu allocations (yuv %llu max %d, rgb %llu max %d),"
+           " %.1f MB | copy path %.2f ms/frame, %llu mallocs\n", g_FbFrames,
+           g_FbFrames > 0 ? g_FbPooledMs / g_FbFrames : 0.0, (unsigned long long) allocations,
+           (unsigned long long) yuvStats.allocations, yuvStats.maxOutstanding,
+           (unsigned long long) rgbStats.allocations, rgbStats.maxOutstanding,
+           (double) (yuvStats.allocatedBytes + rgbStats.allocatedBytes) / (1024.0 * 1024.0),
+           g_FbFrames > 0 ? g_FbCopyMs / g_FbFrames : 0.0, (unsigned long long) g_FbCopyMallocs);
+    if (g_FbErrors != 0 || g_FbAnalyzed != g_FbFrames) {
+        benchFail("framebuffer analysis: %d errors, analyzed %d of %d", g_FbErrors.load(), g_FbAnalyzed.load(),
+                  g_FbFrames);
+    }
+    // 空闲上限足够时只在持有数创新高时分配
+    if (yuvStats.allocations != (uint64_t) yuvStats.maxOutstanding ||
+        rgbStats.allocations != (uint64_t) rgbStats.maxOutstanding) {
+        benchFail("framebuffer allocations exceed peak outstanding");
+    }
+    if (g_FbFrames > FB_WARMUP_FRAMES + 4 && allocations > g_FbWarmAllocations + 2) {
+        benchFail("framebuffer allocated %llu buffers after warmup",
+                  (unsigned long long) (allocations - g_FbWarmAllocations));
+    }
+    if (yuvStats.outstanding != 0 || rgbStats.outstanding != 0) {
+        benchFail("framebuffer leaked: yuv %d rgb %d", yuvStats.outstanding, rgbStats.outstanding);
+    }
+    g_FbTexture.reset();
+    g_FbYuvPool.reset();
+    g_FbRgbPool.reset();
+}
+
+BENCH_SCENE("framebuffer", "pooled ref-counted frame buffers: decode -> analyze -> display without copies",
+            fbSetup, fbFrame, fbTeardown);
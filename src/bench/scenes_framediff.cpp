@@ -0,0 +1,321 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 帧差异场景: FrameDiff::sad 的 SIMD 实现和标量实现比较(各种长度和未对齐地址)；1080p 画面上校验
+// 静止帧没有脏块、±1噪声不算变化、光标只标出覆盖的块(包括右下角不完整的块)、缓慢渐变会累积到阈值、
+// 隔行采样最多晚一帧发现单行变化，脏块打包/解包/拷贝往返后和当前帧一致；
+// 输出 RGBA 和Y平面每帧比较耗时，每帧只把脏块外接矩形上传到纹理
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "FrameDiff.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <memory>
+
+static const int FD_WIDTH = 1920;
+static const int FD_HEIGHT = 1080;
+static const int FD_CURSOR = 12;
+
+struct FdImage {
+    int width = 0;
+    int height = 0;
+    int bytesPerPixel = 0;
+    int stride = 0;
+    std::vector<uint8_t> pixels;
+
+    void init(int w, int h, int bpp, int padding) {
+        width = w;
+        height = h;
+        bytesPerPixel = bpp;
+        stride = w * bpp + padding;
+        pixels.assign((size_t) stride * h, 0);
+    }
+
+    uint8_t *at(int x, int y) {
+        return pixels.data() + (size_t) y * stride + (size_t) x * bytesPerPixel;
+    }
+
+    // 界面一样的画面: 平滑的渐变加上少量纹理，所有像素在 4~250 之间，±1 不会截断
+    void fillUi(int seed) {
+        srand(seed);
+        for (int y = 0; y < height; y++) {
+            uint8_t *row = at(0, y);
+            for (int x = 0; x < width * bytesPerPixel; x++) {
+                row[x] = (uint8_t) (4 + ((x / bytesPerPixel + y) / 9 + (rand() & 7)) % 240);
+            }
+        }
+    }
+
+    void fillRect(int x, int y, int w, int h, uint8_t value) {
+        for (int row = y; row < y + h; row++) {
+            memset(at(x, row), value, (size_t) w * bytesPerPixel);
+        }
+    }
+
+    const FrameDiffResult &diff(FrameDiff &frameDiff) const {
+        return frameDiff.update(pixels.data(), stride, width, height, bytesPerPixel);
+    }
+};
+
+static FdImage g_FdImage;
+static FrameDiff *g_FdDiff = nullptr;
+static std::unique_ptr<ImageTexture> g_FdTexture;
+static int g_FdCursorX = 0;
+static int g_FdCursorY = 0;
+static int g_FdScroll = 0;
+static uint64_t g_FdUploadBytes = 0;
+static uint64_t g_FdFullBytes = 0;
+
+static void checkSad() {
+    std::vector<uint8_t> a(70000 + 32), b(70000 + 32);
+    for (size_t i = 0; i < a.size(); i++) {
+        a[i] = (uint8_t) rand();
+        // 一半的字节差值很小，一半随机，覆盖 0/255
+        b[i] = i % 2 == 0 ? (uint8_t) (a[i] + (rand() % 5) - 2) : (uint8_t) rand();
+    }
+    const int lengths[] = {0, 1, 15, 16, 17, 31, 64, 129, 1000, 4096, 70000};
+    for (int length: lengths) {
+        for (int offset = 0; offset < 3; offset++) {
+            uint8_t simdPeak = 0, scalarPeak = 0;
+            uint32_t simd = FrameDiff::sad(a.data() + offset, b.data() + offset * 2, length, &simdPeak);
+            uint32_t scalar = FrameDiff::sadScalar(a.data() + offset, b.data() + offset * 2, length, &scalarPeak);
+            if (simd != scalar || simdPeak != scalarPeak) {
+                benchFail("framediff sad length %d offset %d: simd %u/%d scalar %u/%d", length, offset, simd,
+                          simdPeak, scalar, scalarPeak);
+            }
+        }
+    }
+}
+
+// 脏块必须正好是覆盖 rect 的块
+static void expectDirty(const FrameDiffResult &result, int x, int y, int w, int h, const char *what) {
+    int tile = result.tileSize;
+    int expected = 0;
+    for (int row = 0; row < result.tileRows; row++) {
+        for (int col = 0; col < result.tileCols; col++) {
+            bool inside = w > 0 && col >= x / tile && col <= (x + w - 1) / tile && row >= y / tile &&
+                          row <= (y + h - 1) / tile;
+            expected += inside;
+            if (inside != result.isDirty(col, row)) {
+                benchFail("framediff %s: tile (%d,%d) dirty %d expected %d", what, col, row,
+                          result.isDirty(col, row), inside);
+                return;
+            }
+        }
+    }
+    if (result.dirtyTiles != expected || result.changed != (expected > 0)) {
+        benchFail("framediff %s: %d dirty tiles, expected %d", what, result.dirtyTiles, expected);
+    }
+}
+
+static void checkScenarios(int bytesPerPixel) {
+    FdImage image;
+    image.init(FD_WIDTH, FD_HEIGHT, bytesPerPixel, 64);
+    image.fillUi(3);
+    FrameDiff frameDiff;
+    const FrameDiffResult &first = image.diff(frameDiff);
+    if (!first.reset || first.dirtyTiles != first.tileCols * first.tileRows) {
+        benchFail("framediff first frame: %d dirty tiles", first.dirtyTiles);
+    }
+    expectDirty(image.diff(frameDiff), 0, 0, 0, 0, "static");
+
+    // 整幅 ±1 噪声(编码/抖动)
+    std::vector<uint8_t> saved = image.pixels;
+    for (size_t i = 0; i < image.pixels.size(); i++) {
+        image.pixels[i] = (uint8_t) (image.pixels[i] + (int) (i % 3) - 1);
+    }
+    expectDirty(image.diff(frameDiff), 0, 0, 0, 0, "noise");
+    image.pixels = saved;
+    image.diff(frameDiff);
+
+    // 光标跨四个块，右下角不完整的块
+    image.fillRect(100, 60, FD_CURSOR, FD_CURSOR, 250);
+    expectDirty(image.diff(frameDiff), 100, 60, FD_CURSOR, FD_CURSOR, "cursor");
+    image.fillRect(FD_WIDTH - 5, FD_HEIGHT - 3, 5, 3, 0);
+    const FrameDiffResult &corner = image.diff(frameDiff);
+    expectDirty(corner, FD_WIDTH - 5, FD_HEIGHT - 3, 5, 3, "corner");
+    if (corner.dirtyX + corner.dirtyWidth != FD_WIDTH || corner.dirtyY + corner.dirtyHeight != FD_HEIGHT) {
+        benchFail("framediff corner bounds %d,%d %dx%d", corner.dirtyX, corner.dirtyY, corner.dirtyWidth,
+                  corner.dirtyHeight);
+    }
+
+    // 单行1像素的细线
+    image.fillRect(500, 301, 1, 1, 0);
+    expectDirty(image.diff(frameDiff), 500, 301, 1, 1, "pixel");
+
+    // 缓慢渐变: 每帧 +1 不超过阈值，参考帧不跟，累积到 +2 时整幅变脏(画面里没有大于253的值，不会回绕)
+    for (uint8_t &value: image.pixels) {
+        value++;
+    }
+    expectDirty(image.diff(frameDiff), 0, 0, 0, 0, "fade 1");
+    for (uint8_t &value: image.pixels) {
+        value++;
+    }
+    expectDirty(image.diff(frameDiff), 0, 0, FD_WIDTH, FD_HEIGHT, "fade 2");
+
+    // 脏块往返: 接收端的画面 + 脏块 = 当前帧
+    FdImage receiver = image;
+    image.fillRect(900, 500, 300, 40, 17);
+    image.fillRect(10, 1000, 64, 64, 230);
+    const FrameDiffResult &edit = image.diff(frameDiff);
+    std::vector<uint8_t> map((edit.dirty.size() + 7) / 8), dirty;
+    int mapLength = FrameDiff::packDirtyMap(edit, map.data(), (int) map.size());
+    if (FrameDiff::unpackDirtyMap(map.data(), mapLength, edit.tileCols, edit.tileRows, dirty) != edit.dirtyTiles) {
+        benchFail("framediff dirty map round trip");
+    }
+    size_t bytes = FrameDiff::gatherTiles(dirty, edit.tileSize, image.pixels.data(), image.stride, FD_WIDTH,
+                                          FD_HEIGHT, bytesPerPixel, nullptr);
+    std::vector<uint8_t> tiles(bytes);
+    FrameDiff::gatherTiles(dirty, edit.tileSize, image.pixels.data(), image.stride, FD_WIDTH, FD_HEIGHT,
+                           bytesPerPixel, tiles.data());
+    if (FrameDiff::scatterTiles(dirty, edit.tileSize, tiles.data(), tiles.size(), receiver.pixels.data(),
+                                receiver.stride, FD_WIDTH, FD_HEIGHT, bytesPerPixel) != bytes) {
+        benchFail("framediff scatter");
+    }
+    for (int y = 0; y < FD_HEIGHT; y++) {
+        if (memcmp(receiver.at(0, y), image.at(0, y), (size_t) FD_WIDTH * bytesPerPixel) != 0) {
+            benchFail("framediff receiver row %d differs after scatter", y);
+            break;
+        }
+    }
+    if (bytes * 10 > (size_t) FD_WIDTH * FD_HEIGHT * bytesPerPixel) {
+        benchFail("framediff edit sent %zu bytes", bytes);
+    }
+
+    // 隔行采样: 奇数行的变化在下一帧发现
+    FrameDiffOptions options;
+    options.rowStep = 2;
+    FrameDiff sampled(options);
+    image.diff(sampled);
+    image.fillRect(704, 33, 8, 1, 255);
+    int found = sampled.update(image.pixels.data(), image.stride, FD_WIDTH, FD_HEIGHT, bytesPerPixel).dirtyTiles;
+    found += image.diff(sampled).dirtyTiles;
+    if (found != 1) {
+        benchFail("framediff rowStep 2: %d dirty tiles over two frames", found);
+    }
+}
+
+static double timeMs(FrameDiff &frameDiff, const FdImage &image, int iterations) {
+    image.diff(frameDiff);
+    int64_t start = Profiler::nowNs();
+    for (int i = 0; i < iterations; i++) {
+        image.diff(frameDiff);
+    }
+    return (double) (Profiler::nowNs() - start) / 1e6 / iterations;
+}
+
+// 静止画面是最坏情况(每个块都要比较完)，对照逐行 memcmp 和标量
+static void benchmark(int bytesPerPixel, const char *name) {
+    FdImage image;
+    image.init(FD_WIDTH, FD_HEIGHT, bytesPerPixel, 0);
+    image.fillUi(5);
+    FdImage copy = image;
+    int64_t start = Profiler::nowNs();
+    bool equal = memcmp(image.pixels.data(), copy.pixels.data(), image.pixels.size()) == 0;
+    double memcmpMs = (double) (Profiler::nowNs() - start) / 1e6;
+    uint8_t peak = 0;
+    start = Profiler::nowNs();
+    uint32_t sum = FrameDiff::sadScalar(image.pixels.data(), copy.pixels.data(), (int) image.pixels.size(), &peak);
+    double scalarMs = (double) (Profiler::nowNs() - start) / 1e6;
+    FrameDiff full;
+    double simdMs = timeMs(full, image, 20);
+    FrameDiffOptions options;
+    options.rowStep = 2;
+    FrameDiff sampled(options);
+    double sampledMs = timeMs(sampled, image, 20);
+    printf("framediff        %dx%d %-4s memcmp %.2f ms  scalar sad %.2f ms  %s %.2f ms  rowStep2 %.2f ms%s\n",
+           FD_WIDTH, FD_HEIGHT, name, memcmpMs, scalarMs, FrameDiff::simdName(), simdMs, sampledMs,
+           equal && sum == 0 ? "" : " (mismatch)");
+}
+
+static void fdSetup() {
+    srand(11);
+    checkSad();
+    checkScenarios(4);
+    checkScenarios(1);
+    benchmark(4, "RGBA");
+    benchmark(1, "Y");
+
+    g_FdImage.init(FD_WIDTH, FD_HEIGHT, 4, 0);
+    g_FdImage.fillUi(9);
+    g_FdDiff = new FrameDiff();
+    g_FdTexture.reset(new ImageTexture());
+    g_FdCursorX = 200;
+    g_FdCursorY = 200;
+    g_FdScroll = 0;
+    g_FdUploadBytes = 0;
+    g_FdFullBytes = 0;
+}
+
+static void fdFrame(int frame) {
+    // 四帧一轮: 静止、光标移动、±1噪声、一块区域滚动
+    switch (frame % 4) {
+        case 1:
+            g_FdImage.fillRect(g_FdCursorX, g_FdCursorY, FD_CURSOR, FD_CURSOR, 128);
+            g_FdCursorX = (g_FdCursorX + 37) % (FD_WIDTH - FD_CURSOR);
+            g_FdCursorY = (g_FdCursorY + 23) % (FD_HEIGHT - FD_CURSOR);
+            g_FdImage.fillRect(g_FdCursorX, g_FdCursorY, FD_CURSOR, FD_CURSOR, 250);
+            break;
+        case 2:
+            for (int y = 0; y < FD_HEIGHT; y += 2) {
+                uint8_t *row = g_FdImage.at(0, y);
+                for (int x = 0; x < FD_WIDTH * 4; x += 7) {
+                    row[x] ^= 1;
+                }
+            }
+            break;
+        case 3:
+            // 列表区域(16行一条的条纹)向上滚动8行，区域里每个块都变化
+            g_FdScroll += 8;
+            for (int y = 400; y < 700; y++) {
+                g_FdImage.fillRect(600, y, 600, 1, ((y + g_FdScroll) / 16) % 2 ? 200 : 40);
+            }
+            break;
+        default:
+            break;
+    }
+    const FrameDiffResult &result = g_FdImage.diff(*g_FdDiff);
+    if (frame % 4 == 0 && result.changed && !result.reset) {
+        benchFail("framediff frame %d: static frame has %d dirty tiles", frame, result.dirtyTiles);
+    }
+    if (frame % 4 == 2 && result.changed) {
+        benchFail("framediff frame %d: noise frame has %d dirty tiles", frame, result.dirtyTiles);
+    }
+    if (result.reset || g_FdTexture->getWidth() == 0) {
+        g_FdTexture->setPixels(ImageTexture_RGBA, g_FdImage.pixels.data(), FD_WIDTH, FD_HEIGHT);
+        g_FdUploadBytes += (uint64_t) FD_WIDTH * FD_HEIGHT * 4;
+    } else if (result.changed) {
+        g_FdTexture->updateRegion(ImageTexture_RGBA, g_FdImage.pixels.data(), g_FdImage.stride, result.dirtyX,
+                                  result.dirtyY, result.dirtyWidth, result.dirtyHeight);
+        g_FdUploadBytes += (uint64_t) result.dirtyWidth * result.dirtyHeight * 4;
+    }
+    g_FdFullBytes += (uint64_t) FD_WIDTH * FD_HEIGHT * 4;
+    benchCounter("diff ms", g_FdDiff->getStats().lastMs);
+    benchCounter("dirty tiles", result.dirtyTiles);
+
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::Begin("FrameDiff", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("dirty %d/%d tiles", result.dirtyTiles, result.tileCols * result.tileRows);
+    ImGui::Image((ImTextureID) g_FdTexture->getOpenglTexture(), ImVec2(FD_WIDTH / 4.0f, FD_HEIGHT / 4.0f));
+    ImGui::End();
+}
+
+static void fdTeardown() {
+    FrameDiffStats stats = g_FdDiff->getStats();
+    printf("framediff        %llu frames, %llu unchanged, %.2f ms/frame, uploaded %.1f%% of full frames\n",
+           (unsigned long long) stats.frames, (unsigned long long) stats.unchangedFrames,
+           stats.frames > 0 ? stats.totalMs / (double) stats.frames : 0.0,
+           g_FdFullBytes > 0 ? 100.0 * (double) g_FdUploadBytes / (double) g_FdFullBytes : 0.0);
+    delete g_FdDiff;
+    g_FdDiff = nullptr;
+    g_FdTexture.reset();
+    g_FdImage.pixels.clear();
+}
+
+BENCH_SCENE("framediff", "1080p frame-difference gate: SIMD SAD tiles, dirty map round trip, dirty-rect uploads",
+            fdSetup, fdFrame, fdTeardown);
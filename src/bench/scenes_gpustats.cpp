@@ -0,0 +1,167 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 渲染统计场景: 多个子窗口(同一纹理、不同裁剪区域)、两张图片和三个模拟视频纹理绘制的用户回调，
+// 校验回调计数、重复纹理绑定被跳过；驱动支持 GL_EXT_disjoint_timer_query 时校验GPU计时异步读回、
+// 回调耗时不超过整帧，以及中途关闭/重新开启计时
+// (每帧的绘制调用/状态切换/纹理绑定/上传字节数由 NativeBench 对所有场景逐帧比对)
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include <memory>
+#include <vector>
+
+static const int GPUSTATS_CALLBACKS = 3;
+static const int GPUSTATS_CLEARS[GPUSTATS_CALLBACKS] = {1, 4, 16};  // 每个回调的全屏清除次数(模拟不同开销的视频帧)
+static const int GPUSTATS_IMAGE_SIZE = 64;
+static const int GPUSTATS_DISABLE_FRAME = 10;
+static const int GPUSTATS_ENABLE_FRAME = 13;
+static const int GPUSTATS_MAX_LATENCY = 4;
+
+static std::unique_ptr<ImageTexture> g_GpuStatsImages[2];
+static bool g_GpuStatsTimer = false;
+static int g_GpuStatsTimed = 0;
+
+// 在回调所在的窗口区域内反复清除，GPU开销随次数增加
+static void gpuStatsCallback(const ImDrawList *, const ImDrawCmd *cmd) {
+    int clears = GPUSTATS_CLEARS[(intptr_t) cmd->UserCallbackData];
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    const ImVec4 &clip = cmd->ClipRect;
+    glScissor((GLint) clip.x, viewport[3] - (GLint) clip.w, (GLsizei) (clip.z - clip.x), (GLsizei) (clip.w - clip.y));
+    for (int i = 0; i < clears; i++) {
+        glClearColor((float) i / (float) clears, 0.2f, 0.4f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT);
+    }
+}
+
+static void gpuStatsSetup() {
+    std::vector<uint8_t> pixels((size_t) GPUSTATS_IMAGE_SIZE * GPUSTATS_IMAGE_SIZE * 4);
+    for (int t = 0; t < 2; t++) {
+        for (size_t i = 0; i < pixels.size(); i += 4) {
+            pixels[i] = t == 0 ? 255 : 0;
+            pixels[i + 1] = t == 0 ? 0 : 255;
+            pixels[i + 2] = 0;
+            pixels[i + 3] = 255;
+        }
+        g_GpuStatsImages[t].reset(new ImageTexture());
+        g_GpuStatsImages[t]->setPixels(ImageTexture_RGBA, pixels.data(), GPUSTATS_IMAGE_SIZE, GPUSTATS_IMAGE_SIZE);
+    }
+    g_GpuStatsTimer = ImGui_ImplOpenGL3_HasGpuTimer();
+    g_GpuStatsTimed = 0;
+    ImGui_ImplOpenGL3_SetGpuTimerEnabled(true);
+}
+
+// 上一帧的统计
+static void checkGpuStats(int frame) {
+    LayerRenderStats stats;
+    if (!getMainLayer()->getRenderStats(stats)) {
+        benchFail("gpustats no render stats");
+        return;
+    }
+    if (stats.userCallbacks != GPUSTATS_CALLBACKS) {
+        benchFail("gpustats frame %d user callbacks %d", frame, stats.userCallbacks);
+    }
+    // 各子窗口的文字都采样字体纹理，只有裁剪区域不同，连续使用同一纹理时不重复绑定
+    if (stats.textureBinds >= stats.drawCalls) {
+        benchFail("gpustats frame %d texture binds %d, draw calls %d", frame, stats.textureBinds, stats.drawCalls);
+    }
+    benchCounter("draw calls", stats.drawCalls);
+    benchCounter("texture binds", stats.textureBinds);
+    benchCounter("state changes", stats.stateChanges);
+    if (!g_GpuStatsTimer) {
+        if (stats.gpuTimeMs >= 0.0f || stats.gpuCallbackMs != -1.0f) {
+            benchFail("gpustats gpu time %.3f ms, callbacks %.3f ms without GL_EXT_disjoint_timer_query",
+                      stats.gpuTimeMs, stats.gpuCallbackMs);
+        }
+        return;
+    }
+    bool disabled = frame > GPUSTATS_DISABLE_FRAME && frame <= GPUSTATS_ENABLE_FRAME;
+    if (disabled) {
+        if (stats.gpuTimeMs >= 0.0f || stats.gpuCallbackMs != -1.0f) {
+            benchFail("gpustats frame %d gpu time %.3f ms, callbacks %.3f ms while disabled", frame, stats.gpuTimeMs,
+                      stats.gpuCallbackMs);
+        }
+        return;
+    }
+    if (stats.gpuTimeMs < 0.0f) {
+        // 刚开启时结果还在路上
+        if ((frame > GPUSTATS_MAX_LATENCY && frame <= GPUSTATS_DISABLE_FRAME) ||
+            frame > GPUSTATS_ENABLE_FRAME + GPUSTATS_MAX_LATENCY) {
+            benchFail("gpustats frame %d no gpu time", frame);
+        }
+        return;
+    }
+    // 不等待GPU: 读到的总是之前的帧
+    if (stats.gpuLatency < 1 || stats.gpuLatency > GPUSTATS_MAX_LATENCY) {
+        benchFail("gpustats frame %d gpu latency %d frames", frame, stats.gpuLatency);
+    }
+    if (stats.gpuCallbackMs < 0.0f || stats.gpuCallbackMs > stats.gpuTimeMs + 0.001f) {
+        benchFail("gpustats frame %d callbacks %.3f ms > frame %.3f ms", frame, stats.gpuCallbackMs, stats.gpuTimeMs);
+    }
+    g_GpuStatsTimed++;
+    benchCounter("gpu ms", stats.gpuTimeMs);
+    benchCounter("gpu callback ms", stats.gpuCallbackMs);
+}
+
+static void gpuStatsFrame(int frame) {
+    if (frame > 0) {
+        checkGpuStats(frame);
+    }
+    if (frame == GPUSTATS_DISABLE_FRAME) {
+        ImGui_ImplOpenGL3_SetGpuTimerEnabled(false);
+    } else if (frame == GPUSTATS_ENABLE_FRAME) {
+        ImGui_ImplOpenGL3_SetGpuTimerEnabled(true);
+    }
+
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1000, 1400), ImGuiCond_Always);
+    ImGui::Begin("GPU stats", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    for (int c = 0; c < 4; c++) {
+        char name[16];
+        snprintf(name, sizeof(name), "child%d", c);
+        ImGui::BeginChild(name, ImVec2(460, 200), true);
+        for (int i = 0; i < 6; i++) {
+            ImGui::Text("%s line %d frame %d", name, i, frame);
+        }
+        ImGui::EndChild();
+        if (c % 2 == 0) {
+            ImGui::SameLine();
+        }
+    }
+    ImVec2 imageSize((float) GPUSTATS_IMAGE_SIZE * 2, (float) GPUSTATS_IMAGE_SIZE * 2);
+    ImGui::Image((ImTextureID) g_GpuStatsImages[0]->getOpenglTexture(), imageSize);
+    ImGui::SameLine();
+    ImGui::Image((ImTextureID) g_GpuStatsImages[1]->getOpenglTexture(), imageSize);
+    for (int i = 0; i < GPUSTATS_CALLBACKS; i++) {
+        ImGui::Text("video %d: %d clears", i, GPUSTATS_CLEARS[i]);
+        ImVec2 pos = ImGui::GetCursorScreenPos();
+        ImGui::Dummy(ImVec2(600, 160));
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        drawList->PushClipRect(pos, ImVec2(pos.x + 600, pos.y + 160), true);
+        drawList->AddCallback(gpuStatsCallback, (void *) (intptr_t) i);
+        drawList->AddCallback(ImDrawCallback_ResetRenderState, nullptr);
+        drawList->PopClipRect();
+    }
+    ImGui::End();
+}
+
+static void gpuStatsTeardown() {
+    printf("gpustats         GL_EXT_disjoint_timer_query %s, %d frames with gpu time\n",
+           g_GpuStatsTimer ? "yes" : "no", g_GpuStatsTimed);
+    if (g_GpuStatsTimer && g_GpuStatsTimed == 0) {
+        benchFail("gpustats no gpu time read back");
+    }
+    // 恢复 initDraw 的设置
+#if !defined(NATIVE_SURFACE_PROFILER)
+    ImGui_ImplOpenGL3_SetGpuTimerEnabled(false);
+#endif
+    for (std::unique_ptr<ImageTexture> &image: g_GpuStatsImages) {
+        image.reset();
+    }
+}
+
+BENCH_SCENE("gpustats", "driver call counters, user callback timing and async GPU timer queries of the OpenGL3 backend",
+            gpuStatsSetup, gpuStatsFrame, gpuStatsTeardown);
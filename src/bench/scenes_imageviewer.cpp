@@ -0,0 +1,210 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 图像查看器场景: 4路1080p视频流(BGR/RGB/GRAY/RGBA)由4个线程发布到 TextureCache，
+// 偶数帧走原来 ImageViewer::show 的方式(每帧每张图新建纹理、glTexImage2D、用完删除)，
+// 奇数帧只上传有新帧的窗口、纹理跨帧复用；对比两种方式的每帧耗时，校验发布/上传/替换计数和版本去重
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "TextureCache.h"
+#include "FrameBuffer.h"
+#include "Profiler.h"
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+static const int VIEWER_WIDTH = 1920;
+static const int VIEWER_HEIGHT = 1080;
+static const int VIEWER_STREAMS = 4;
+static const int VIEWER_STREAM_INTERVAL_MS = 33;    // 每路30fps
+
+struct ViewerStream {
+    const char *name = nullptr;
+    FrameBufferFormat format = FrameBuffer_RGBA;
+    std::unique_ptr<FrameBufferPool> pool{};
+    std::thread thread{};
+    uint64_t produced = 0;
+};
+
+static TextureCache *g_ViewerCache = nullptr;
+static ViewerStream g_ViewerStreams[VIEWER_STREAMS] = {
+        {"stream bgr",  FrameBuffer_BGR24},
+        {"stream rgb",  FrameBuffer_RGB24},
+        {"stream gray", FrameBuffer_GRAY8},
+        {"stream rgba", FrameBuffer_RGBA},
+};
+static std::atomic<bool> g_ViewerRunning{false};
+// 原来的方式: 每帧新建的纹理，下一帧开始时删除(原来在 drawEnd 之后删除)
+static std::vector<ImageTexture *> g_ViewerLegacyTextures;
+static std::vector<uint8_t> g_ViewerLegacyPixels;
+static ImageTexture *g_ViewerFirstTexture = nullptr;
+static double g_ViewerLegacyMs = 0.0, g_ViewerCachedMs = 0.0;
+static int g_ViewerLegacyFrames = 0, g_ViewerCachedFrames = 0;
+
+static void viewerProduce(ViewerStream *stream) {
+    PROFILE_THREAD(stream->name);
+    while (g_ViewerRunning) {
+        FrameBufferRef buffer = stream->pool->acquire(stream->format, VIEWER_WIDTH, VIEWER_HEIGHT);
+        int rowBytes = VIEWER_WIDTH * FrameBuffer::bytesPerPixel(stream->format);
+        auto value = (uint8_t) (stream->produced * 5);
+        for (int y = 0; y < VIEWER_HEIGHT; y++) {
+            memset(buffer->planes[0] + (size_t) y * buffer->strides[0], (uint8_t) (value + y / 8), rowBytes);
+        }
+        buffer->seq = ++stream->produced;
+        // 只交出句柄，渲染端上传前缓冲由 TextureFrame 持有
+        g_ViewerCache->publish(stream->name, TextureFrame::fromFrameBuffer(buffer));
+        std::this_thread::sleep_for(std::chrono::milliseconds(VIEWER_STREAM_INTERVAL_MS));
+    }
+}
+
+static void viewerCheckVersion() {
+    TextureCache cache;
+    std::vector<uint8_t> pixels(64 * 64 * 3, 100);
+    TextureFrame frame;
+    frame.format = ImageTexture_BGR;
+    frame.pixels = pixels.data();
+    frame.width = frame.height = 64;
+    frame.stride = 64 * 3;
+    frame.version = 5;
+    // 静态图片每帧重复发布: 地址和版本都没变只上传一次
+    bool first = cache.publish("static", frame);
+    bool second = cache.publish("static", frame);
+    int uploads = cache.upload();
+    int again = cache.upload();
+    frame.version = 6;
+    bool third = cache.publish("static", frame);
+    int changed = cache.upload();
+    TextureCacheStats stats = cache.getStats();
+    if (!first || second || !third || uploads != 1 || again != 0 || changed != 1 || stats.unchanged != 1 ||
+        stats.windows != 1) {
+        benchFail("imageviewer version dedup: publish %d/%d/%d uploads %d/%d/%d unchanged %llu", first, second,
+                  third, uploads, again, changed, (unsigned long long) stats.unchanged);
+    }
+    // 像素是拷贝(ImageViewer 的 cv::Mat)时按原数据地址去重: 每次拷贝地址不同，原数据和版本没变就跳过
+    std::vector<uint8_t> copy(pixels);
+    frame.pixels = copy.data();
+    frame.source = pixels.data();
+    bool copied = cache.publish("static", frame);
+    bool skipped = cache.skipUnchanged("static", pixels.data(), 6);
+    bool newer = cache.skipUnchanged("static", pixels.data(), 7);
+    cache.upload();
+    stats = cache.getStats();
+    if (copied || !skipped || newer || stats.published != 5 || stats.unchanged != 3 || stats.uploads != 2) {
+        benchFail("imageviewer copied frame dedup: publish %d skip %d/%d published %llu unchanged %llu", copied,
+                  skipped, newer, (unsigned long long) stats.published, (unsigned long long) stats.unchanged);
+    }
+    ImageTexture *texture = cache.getTexture("static");
+    cache.remove("static");
+    cache.upload();
+    if (texture == nullptr || cache.getTexture("static") != nullptr || cache.getStats().windows != 0) {
+        benchFail("imageviewer remove");
+    }
+}
+
+static void viewerSetup() {
+    viewerCheckVersion();
+    g_ViewerCache = new TextureCache();
+    g_ViewerLegacyPixels.assign((size_t) VIEWER_WIDTH * VIEWER_HEIGHT * 3, 90);
+    g_ViewerFirstTexture = nullptr;
+    g_ViewerLegacyMs = g_ViewerCachedMs = 0.0;
+    g_ViewerLegacyFrames = g_ViewerCachedFrames = 0;
+    g_ViewerRunning = true;
+    for (ViewerStream &stream: g_ViewerStreams) {
+        stream.pool.reset(new FrameBufferPool(4));
+        stream.produced = 0;
+        stream.thread = std::thread(viewerProduce, &stream);
+    }
+}
+
+static void viewerFrame(int frame) {
+    for (ImageTexture *texture: g_ViewerLegacyTextures) {
+        delete texture;
+    }
+    g_ViewerLegacyTextures.clear();
+
+    int64_t start = Profiler::nowNs();
+    ImVec2 size(VIEWER_WIDTH / 4.0f, VIEWER_HEIGHT / 4.0f);
+    if (frame % 2 == 0) {
+        // 原来的 show(): 每张图新建纹理并完整上传
+        for (int i = 0; i < VIEWER_STREAMS; i++) {
+            auto *texture = new ImageTexture();
+            texture->setPixels(ImageTexture_RGB, g_ViewerLegacyPixels.data(), VIEWER_WIDTH, VIEWER_HEIGHT);
+            g_ViewerLegacyTextures.push_back(texture);
+            ImGui::SetNextWindowPos(ImVec2(0, 100 + (float) i * (size.y + 60)), ImGuiCond_Always);
+            ImGui::Begin(g_ViewerStreams[i].name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+            ImGui::Image((ImTextureID) texture->getOpenglTexture(), size);
+            ImGui::End();
+        }
+        g_ViewerLegacyMs += (double) (Profiler::nowNs() - start) / 1e6;
+        g_ViewerLegacyFrames++;
+        benchCounter("viewer legacy ms", (double) (Profiler::nowNs() - start) / 1e6);
+        return;
+    }
+    int uploads = g_ViewerCache->upload();
+    for (int i = 0; i < VIEWER_STREAMS; i++) {
+        ImageTexture *texture = g_ViewerCache->getTexture(g_ViewerStreams[i].name);
+        if (texture == nullptr) {
+            continue;
+        }
+        if (i == 0) {
+            // 窗口的纹理跨帧复用
+            if (g_ViewerFirstTexture == nullptr) {
+                g_ViewerFirstTexture = texture;
+            } else if (texture != g_ViewerFirstTexture) {
+                benchFail("imageviewer texture recreated at frame %d", frame);
+            }
+        }
+        ImGui::SetNextWindowPos(ImVec2(600, 100 + (float) i * (size.y + 60)), ImGuiCond_Always);
+        ImGui::Begin(g_ViewerStreams[i].name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Image((ImTextureID) texture->getOpenglTexture(), size);
+        ImGui::End();
+    }
+    double ms = (double) (Profiler::nowNs() - start) / 1e6;
+    g_ViewerCachedMs += ms;
+    g_ViewerCachedFrames++;
+    benchCounter("viewer cached ms", ms);
+    benchCounter("viewer uploads", uploads);
+}
+
+static void viewerTeardown() {
+    g_ViewerRunning = false;
+    for (ViewerStream &stream: g_ViewerStreams) {
+        stream.thread.join();
+    }
+    for (ImageTexture *texture: g_ViewerLegacyTextures) {
+        delete texture;
+    }
+    g_ViewerLegacyTextures.clear();
+    // 生产端停止后上传剩下的帧，再上传一次不应该有任何上传
+    g_ViewerCache->upload();
+    int again = g_ViewerCache->upload();
+    TextureCacheStats stats = g_ViewerCache->getStats();
+    printf("imageviewer      %d x %dx%d streams | legacy %.2f ms/frame (%d uploads/frame) | cached %.2f ms/frame,"
+           " published %llu uploads %llu replaced %llu\n", VIEWER_STREAMS, VIEWER_WIDTH, VIEWER_HEIGHT,
+           g_ViewerLegacyFrames > 0 ? g_ViewerLegacyMs / g_ViewerLegacyFrames : 0.0, VIEWER_STREAMS,
+           g_ViewerCachedFrames > 0 ? g_ViewerCachedMs / g_ViewerCachedFrames : 0.0,
+           (unsigned long long) stats.published, (unsigned long long) stats.uploads,
+           (unsigned long long) stats.replaced);
+    if (again != 0 || stats.windows != VIEWER_STREAMS ||
+        stats.published != stats.uploads + stats.replaced + stats.unchanged) {
+        benchFail("imageviewer counters: published %llu uploads %llu replaced %llu unchanged %llu again %d",
+                  (unsigned long long) stats.published, (unsigned long long) stats.uploads,
+                  (unsigned long long) stats.replaced, (unsigned long long) stats.unchanged, again);
+    }
+    delete g_ViewerCache;
+    g_ViewerCache = nullptr;
+    for (ViewerStream &stream: g_ViewerStreams) {
+        if (stream.pool->getStats().outstanding != 0) {
+            benchFail("imageviewer %s still holds %d buffers", stream.name, stream.pool->getStats().outstanding);
+        }
+        stream.pool.reset();
+    }
+}
+
+BENCH_SCENE("imageviewer", "4 1080p streams published from threads: persistent texture cache vs per-frame textures",
+            viewerSetup, viewerFrame, viewerTeardown);
@@ -0,0 +1,245 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 图层调度场景: mock 后端(不创建窗口/EGL)驱动3个各自线程上的 OverlayLayer，共享一套字体图集；
+// 校验两个视频图层的回调能同时执行(不被全局ImGui锁串行)、Continuous 图层按目标帧率刷新、
+// OnChange 图层只在 markDirty/触摸之后刷新对应帧数、触摸事件在下一帧写入最上层接收触摸图层的 ImGuiIO
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <backends/imgui_impl_android.h>
+#include <memory>
+#include <atomic>
+#include <unistd.h>
+
+static const int LAYER_VIDEOS = 2;
+static const float LAYER_VIDEO_FPS = 60.0f;
+static const int64_t LAYER_RUN_MS = 300;
+static const int64_t LAYER_WAIT_MS = 1000;
+static const int64_t MS = 1000000;
+
+// 只记录调用，字体纹理和真实后端一样在第一帧 newFrame 时"上传"
+class MockLayerBackend : public LayerBackend {
+public:
+    bool create(const LayerConfig &, LayerBackend *) override {
+        return true;
+    }
+
+    void destroy() override {
+    }
+
+    bool makeCurrent() override {
+        return true;
+    }
+
+    void releaseCurrent() override {
+    }
+
+    bool initImGui() override {
+        return true;
+    }
+
+    void shutdownImGui() override {
+    }
+
+    void newFrame(uint32_t width, uint32_t height) override {
+        ImGuiIO &io = ImGui::GetIO();
+        if (io.Fonts->TexID == (ImTextureID) 0) {
+            unsigned char *pixels;
+            int w, h;
+            io.Fonts->GetTexDataAsRGBA32(&pixels, &w, &h);
+            io.Fonts->SetTexID((ImTextureID) 1);
+        }
+        io.DisplaySize = ImVec2((float) width, (float) height);
+        int64_t now = LayerScheduler::nowNs();
+        io.DeltaTime = lastNs > 0 && now > lastNs ? (float) (now - lastNs) / 1e9f : 1.0f / 60.0f;
+        lastNs = now;
+    }
+
+    void renderDrawData(ImDrawData *drawData, uint32_t, uint32_t) override {
+        vertices += drawData->TotalVtxCount;
+    }
+
+    void present() override {
+        presents++;
+    }
+
+    std::atomic<int> presents{0};
+    std::atomic<int> vertices{0};
+
+private:
+    int64_t lastNs = 0;
+};
+
+static std::unique_ptr<ImFontAtlas> g_LayerFonts;
+static std::unique_ptr<OverlayLayer> g_LayerVideos[LAYER_VIDEOS];
+static std::unique_ptr<OverlayLayer> g_LayerHud;
+static std::atomic<int> g_LayerInside{0};
+static std::atomic<int> g_LayerMaxInside{0};
+static std::atomic<int> g_LayerWrongContext{0};
+static std::atomic<bool> g_LayerHudMouseDown{false};
+static std::atomic<float> g_LayerHudMouseX{0.0f};
+static std::atomic<float> g_LayerHudMouseY{0.0f};
+
+static void layerVideoDraw(OverlayLayer &layer) {
+    if (ImGui::GetCurrentContext() != layer.getContext()) {
+        g_LayerWrongContext++;
+    }
+    int inside = ++g_LayerInside;
+    int max = g_LayerMaxInside.load();
+    while (inside > max && !g_LayerMaxInside.compare_exchange_weak(max, inside)) {
+    }
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::Begin(layer.getConfig().name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+    ImGui::Text("%s frame %llu", layer.getConfig().name, (unsigned long long) layer.getScheduler().getFrameCount());
+    ImGui::End();
+    // 等另一个视频图层也进入回调；回调被串行时这里会等到超时
+    int64_t deadline = LayerScheduler::nowNs() + 200 * MS;
+    while (g_LayerMaxInside.load() < LAYER_VIDEOS && LayerScheduler::nowNs() < deadline) {
+        usleep(500);
+    }
+    g_LayerInside--;
+}
+
+static void layerHudDraw(OverlayLayer &layer) {
+    if (ImGui::GetCurrentContext() != layer.getContext()) {
+        g_LayerWrongContext++;
+    }
+    ImGuiIO &io = ImGui::GetIO();
+    g_LayerHudMouseDown = io.MouseDown[0];
+    g_LayerHudMouseX = io.MousePos.x;
+    g_LayerHudMouseY = io.MousePos.y;
+    ImGui::Begin("mock hud", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("hud frame %llu", (unsigned long long) layer.getScheduler().getFrameCount());
+    ImGui::End();
+}
+
+// 等图层画到 frames 帧，再多等一会确认没有多画
+static uint64_t layerWaitFrames(OverlayLayer &layer, uint64_t frames) {
+    int64_t deadline = LayerScheduler::nowNs() + LAYER_WAIT_MS * MS;
+    while (layer.getScheduler().getFrameCount() < frames && LayerScheduler::nowNs() < deadline) {
+        usleep(1000);
+    }
+    usleep(100 * 1000);
+    return layer.getScheduler().getFrameCount();
+}
+
+static void layerSetup() {
+    g_LayerInside = 0;
+    g_LayerMaxInside = 0;
+    g_LayerWrongContext = 0;
+    g_LayerFonts.reset(new ImFontAtlas());
+    for (int i = 0; i < LAYER_VIDEOS; i++) {
+        LayerConfig config;
+        config.name = i == 0 ? "mock video 0" : "mock video 1";
+        config.width = 640;
+        config.height = 360;
+        config.zOrder = 100 + i;
+        config.fps = LAYER_VIDEO_FPS;
+        config.fonts = g_LayerFonts.get();
+        g_LayerVideos[i].reset(new OverlayLayer(config, new MockLayerBackend()));
+    }
+    LayerConfig hudConfig;
+    hudConfig.name = "mock hud";
+    hudConfig.width = 640;
+    hudConfig.height = 360;
+    hudConfig.zOrder = 1000;
+    hudConfig.mode = LayerRender_OnChange;
+    hudConfig.acceptInput = true;
+    hudConfig.fonts = g_LayerFonts.get();
+    g_LayerHud.reset(new OverlayLayer(hudConfig, new MockLayerBackend()));
+    for (auto &layer: g_LayerVideos) {
+        if (!layer->init()) {
+            benchFail("layers: init %s failed", layer->getConfig().name);
+            return;
+        }
+    }
+    if (!g_LayerHud->init()) {
+        benchFail("layers: init hud failed");
+        return;
+    }
+
+    int64_t start = LayerScheduler::nowNs();
+    for (auto &layer: g_LayerVideos) {
+        layer->start(layerVideoDraw);
+    }
+    g_LayerHud->start(layerHudDraw);
+    usleep(LAYER_RUN_MS * 1000);
+
+    // 并行: 两个视频图层的回调同时在执行
+    if (g_LayerMaxInside.load() < LAYER_VIDEOS) {
+        benchFail("layers: callbacks serialized (max %d running at once)", g_LayerMaxInside.load());
+    }
+    // Continuous: 按60fps刷新，不超过目标帧率(第一帧立即画，多算2帧余量)
+    double elapsedMs = (double) (LayerScheduler::nowNs() - start) / MS;
+    auto expected = (uint64_t) (elapsedMs * LAYER_VIDEO_FPS / 1000.0);
+    for (auto &layer: g_LayerVideos) {
+        uint64_t frames = layer->getScheduler().getFrameCount();
+        auto *backend = (MockLayerBackend *) layer->getBackend();
+        if (frames < expected / 2 || frames > expected + 2 || backend->presents.load() != (int) frames ||
+            backend->vertices.load() == 0) {
+            benchFail("layers: %s rendered %llu frames (expected ~%llu) presents %d", layer->getConfig().name,
+                      (unsigned long long) frames, (unsigned long long) expected, backend->presents.load());
+        }
+    }
+    // OnChange: 启动时画一帧，之后没有变化不画
+    uint64_t hudFrames = g_LayerHud->getScheduler().getFrameCount();
+    if (hudFrames != 1) {
+        benchFail("layers: idle hud rendered %llu frames (expected 1)", (unsigned long long) hudFrames);
+    }
+    g_LayerHud->markDirty(2);
+    hudFrames = layerWaitFrames(*g_LayerHud, 3);
+    if (hudFrames != 3) {
+        benchFail("layers: hud rendered %llu frames after markDirty(2) (expected 3)", (unsigned long long) hudFrames);
+    }
+    // 触摸: 分发给 zOrder 最大的 hud，标记3帧，下一帧写入它的 ImGuiIO
+    ImGuInputEvent down{};
+    down.type = IM_DOWN;
+    down.pos = ImVec2(123.0f, 45.0f);
+    OverlayLayer::dispatchInput(down);
+    hudFrames = layerWaitFrames(*g_LayerHud, 6);
+    if (hudFrames != 6 || !g_LayerHudMouseDown.load() || g_LayerHudMouseX.load() != 123.0f ||
+        g_LayerHudMouseY.load() != 45.0f) {
+        benchFail("layers: touch down frames %llu mouse %d (%.1f, %.1f)", (unsigned long long) hudFrames,
+                  (int) g_LayerHudMouseDown.load(), g_LayerHudMouseX.load(), g_LayerHudMouseY.load());
+    }
+    ImGuInputEvent up = down;
+    up.type = IM_UP;
+    OverlayLayer::dispatchInput(up);
+    hudFrames = layerWaitFrames(*g_LayerHud, 9);
+    if (hudFrames != 9 || g_LayerHudMouseDown.load()) {
+        benchFail("layers: touch up frames %llu mouse %d", (unsigned long long) hudFrames,
+                  (int) g_LayerHudMouseDown.load());
+    }
+    if (g_LayerWrongContext.load() != 0) {
+        benchFail("layers: %d callbacks ran with another layer's context", g_LayerWrongContext.load());
+    }
+    for (auto &layer: g_LayerVideos) {
+        layer->stop();
+    }
+    g_LayerHud->stop();
+}
+
+static void layerFrame(int) {
+    benchCounter("max concurrent callbacks", g_LayerMaxInside.load());
+    for (auto &layer: g_LayerVideos) {
+        if (layer) {
+            benchCounter("video frames", (double) layer->getScheduler().getFrameCount());
+        }
+    }
+    if (g_LayerHud) {
+        benchCounter("hud frames", (double) g_LayerHud->getScheduler().getFrameCount());
+    }
+}
+
+static void layerTeardown() {
+    for (auto &layer: g_LayerVideos) {
+        layer.reset();
+    }
+    g_LayerHud.reset();
+    g_LayerFonts.reset();
+}
+
+BENCH_SCENE("layers", "mock-backend OverlayLayers: parallel callbacks, fps pacing, OnChange dirty/touch frames",
+            layerSetup, layerFrame, layerTeardown);
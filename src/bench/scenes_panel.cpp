@@ -0,0 +1,209 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 独立面板场景: 4个 OverlayPanel 各自的ImGui上下文、线程和帧率(240/120/60/30)同时绘制，
+// 结果经 DrawListQueue 叠加到主图层，中途取消/恢复关联；校验叠加的面板列表完整、落在各自区域内，帧率互不影响
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <memory>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <cmath>
+
+static const int PANEL_COUNT = 4;
+static const float PANEL_FPS[PANEL_COUNT] = {240.0f, 120.0f, 60.0f, 30.0f};
+static const float PANEL_WIDTH = 520.0f;
+static const float PANEL_HEIGHT = 560.0f;
+
+struct BenchPanel {
+    std::unique_ptr<OverlayPanel> panel;
+    std::atomic<double> renderUs{0.0};          // 面板线程累计的CPU时间
+    std::atomic<int> wrongContext{0};
+    uint64_t lastFrameCount = 0;
+    int64_t startNs = 0;
+    int shown = 0;                              // 渲染线程: 叠加过的帧数
+};
+
+static BenchPanel g_Panels[PANEL_COUNT];
+
+static double nowUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+static void panelDraw(int index, OverlayPanel &panel) {
+    BenchPanel &benchPanel = g_Panels[index];
+    double t0 = nowUs();
+    if (ImGui::GetCurrentContext() != panel.getContext()) {
+        benchPanel.wrongContext.fetch_add(1);
+    }
+    ImGuiIO &io = ImGui::GetIO();
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(io.DisplaySize, ImGuiCond_Always);
+    ImGui::Begin(panel.getConfig().name, nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoMove);
+    uint64_t frame = panel.getFrameCount();
+    ImGui::Text("%s %.0f fps frame %llu", panel.getConfig().name, panel.getConfig().fps, (unsigned long long) frame);
+    ImGui::Text("framerate %.1f", io.Framerate);
+    ImGui::ProgressBar((float) (frame % 100) / 100.0f);
+    float values[64];
+    for (int i = 0; i < 64; i++) {
+        values[i] = sinf((float) (frame + i) * 0.2f + (float) index);
+    }
+    ImGui::PlotLines("##wave", values, 64, 0, nullptr, -1.0f, 1.0f, ImVec2(0, 120));
+    ImGui::BeginChild("rows", ImVec2(0, 0), true);
+    for (int i = 0; i < 40; i++) {
+        ImGui::Text("row %02d value %8.3f", i, values[i % 64] * 1000.0f);
+    }
+    ImGui::EndChild();
+    ImGui::End();
+    benchPanel.renderUs = benchPanel.renderUs + (nowUs() - t0);
+}
+
+static void panelSetup() {
+    for (int i = 0; i < PANEL_COUNT; i++) {
+        static char names[PANEL_COUNT][16];
+        snprintf(names[i], sizeof(names[i]), "panel%d", i);
+        PanelConfig config;
+        config.name = names[i];
+        config.x = 20.0f + (float) (i % 2) * (PANEL_WIDTH + 20.0f);
+        config.y = 100.0f + (float) (i / 2) * (PANEL_HEIGHT + 20.0f);
+        config.width = PANEL_WIDTH;
+        config.height = PANEL_HEIGHT;
+        config.order = i;
+        config.fps = PANEL_FPS[i];
+        BenchPanel &benchPanel = g_Panels[i];
+        benchPanel.renderUs = 0.0;
+        benchPanel.wrongContext = 0;
+        benchPanel.lastFrameCount = 0;
+        benchPanel.shown = 0;
+        benchPanel.panel.reset(createOverlayPanel(config));
+        if (benchPanel.panel == nullptr) {
+            benchFail("panels4 create %s failed", names[i]);
+            continue;
+        }
+        benchPanel.startNs = LayerScheduler::nowNs();
+        benchPanel.panel->start([i](OverlayPanel &panel) { panelDraw(i, panel); });
+    }
+}
+
+// 校验上一帧叠加的面板列表: 每个面板一个列表，裁剪矩形不超出面板区域，命令覆盖全部索引且索引不越界
+static void checkPanelLists() {
+    ImDrawData *drawData = getDrawListQueue()->getSplicedDrawData();
+    if (drawData == nullptr) {
+        return;
+    }
+    int lists = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList *list = drawData->CmdLists[n];
+        if (list->_OwnerName == nullptr || strncmp(list->_OwnerName, "panel", 5) != 0) {
+            continue;
+        }
+        int index = atoi(list->_OwnerName + 5);
+        if (index < 0 || index >= PANEL_COUNT || g_Panels[index].panel == nullptr) {
+            benchFail("panels4 unknown list %s", list->_OwnerName);
+            continue;
+        }
+        lists++;
+        g_Panels[index].shown++;
+        const PanelConfig &config = g_Panels[index].panel->getConfig();
+        ImRect rect(config.x, config.y, config.x + config.width, config.y + config.height);
+        rect.Expand(0.5f);
+        int elems = 0;
+        for (const ImDrawCmd &cmd: list->CmdBuffer) {
+            elems += (int) cmd.ElemCount;
+            if (!rect.Contains(ImRect(cmd.ClipRect))) {
+                benchFail("panels4 %s clip rect (%.0f,%.0f)-(%.0f,%.0f) outside panel", list->_OwnerName,
+                          cmd.ClipRect.x, cmd.ClipRect.y, cmd.ClipRect.z, cmd.ClipRect.w);
+                break;
+            }
+            for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                if (cmd.VtxOffset + list->IdxBuffer[(int) (cmd.IdxOffset + i)] >= (unsigned int) list->VtxBuffer.Size) {
+                    benchFail("panels4 %s index out of range", list->_OwnerName);
+                    break;
+                }
+            }
+        }
+        if (elems != list->IdxBuffer.Size) {
+            benchFail("panels4 %s draw commands cover %d of %d indices", list->_OwnerName, elems,
+                      list->IdxBuffer.Size);
+        }
+        const ImVec2 &pos = list->VtxBuffer[0].pos;
+        if (!rect.Contains(pos)) {
+            benchFail("panels4 %s first vertex (%.0f,%.0f) outside panel", list->_OwnerName, pos.x, pos.y);
+        }
+    }
+    benchCounter("panel lists", lists);
+}
+
+static void panelFrame(int frame) {
+    checkPanelLists();
+
+    // 中途取消关联再恢复，模拟主图层重建(横竖屏切换)，面板在这期间跳过绘制
+    OverlayLayer *layer = getMainLayer();
+    if (frame % 100 == 50) {
+        layer->setDrawListQueue(nullptr);
+    } else if (frame % 100 == 52) {
+        layer->setDrawListQueue(getDrawListQueue());
+    }
+
+    ImGui::SetNextWindowPos(ImVec2(0, 1400), ImGuiCond_Always);
+    ImGui::Begin("Panels", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    for (int i = 0; i < PANEL_COUNT; i++) {
+        BenchPanel &benchPanel = g_Panels[i];
+        if (benchPanel.panel == nullptr) {
+            continue;
+        }
+        uint64_t frames = benchPanel.panel->getFrameCount();
+        char name[32];
+        snprintf(name, sizeof(name), "panel%d frames/frame", i);
+        benchCounter(name, (double) (frames - benchPanel.lastFrameCount));
+        benchPanel.lastFrameCount = frames;
+        ImGui::Text("panel%d %.0f fps frames %llu skipped %llu shown %d", i, PANEL_FPS[i],
+                    (unsigned long long) frames, (unsigned long long) benchPanel.panel->getSkippedCount(),
+                    benchPanel.shown);
+    }
+    ImGui::End();
+}
+
+static void panelTeardown() {
+    int64_t endNs = LayerScheduler::nowNs();
+    for (int i = 0; i < PANEL_COUNT; i++) {
+        BenchPanel &benchPanel = g_Panels[i];
+        if (benchPanel.panel == nullptr) {
+            continue;
+        }
+        benchPanel.panel->stop();
+        uint64_t frames = benchPanel.panel->getFrameCount();
+        double seconds = (double) (endNs - benchPanel.startNs) / 1e9;
+        printf("panels4          panel%d target %5.0f fps achieved %7.1f fps  frames %6llu skipped %5llu shown %5d"
+               "  cpu %7.1f us/frame\n", i, PANEL_FPS[i], seconds > 0.0 ? (double) frames / seconds : 0.0,
+               (unsigned long long) frames, (unsigned long long) benchPanel.panel->getSkippedCount(),
+               benchPanel.shown, frames > 0 ? benchPanel.renderUs / (double) frames : 0.0);
+        if (frames == 0 || benchPanel.shown == 0) {
+            benchFail("panels4 panel%d frames %llu shown %d", i, (unsigned long long) frames, benchPanel.shown);
+        }
+        if (benchPanel.wrongContext != 0) {
+            benchFail("panels4 panel%d drew with another context %d times", i, benchPanel.wrongContext.load());
+        }
+        // 线程互不阻塞: 面板帧数应当随目标帧率递减(240fps 面板不会被 30fps 面板拖慢)
+        if (i > 0 && g_Panels[i - 1].panel != nullptr && seconds > 0.5 &&
+            g_Panels[i - 1].panel->getFrameCount() < frames) {
+            benchFail("panels4 panel%d (%.0f fps) rendered fewer frames than panel%d (%.0f fps)", i - 1,
+                      PANEL_FPS[i - 1], i, PANEL_FPS[i]);
+        }
+    }
+    for (BenchPanel &benchPanel: g_Panels) {
+        benchPanel.panel.reset();
+    }
+    // 场景可能停在取消关联的那几帧，恢复关联；已销毁的通道在下一次 drawEnd() 时释放
+    getMainLayer()->setDrawListQueue(getDrawListQueue());
+}
+
+BENCH_SCENE("panels4", "4 OverlayPanels with their own ImGui context, thread and frame rate, spliced into the main layer",
+            panelSetup, panelFrame, panelTeardown);
@@ -0,0 +1,395 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 处理流水线场景: 从原始视频文件(YUV420P 720p)读帧，读取 -> 解码(YUV转BGR，按行带分块) ->
+// 分析(半尺寸灰度 + 增益 + Sobel 边缘，分块并行，多帧同时分析) -> 显示(按序发布到 TextureCache)，
+// 先逐帧单线程跑一遍再用流水线跑一遍，校验两次每帧的结果一致、显示顺序和文件顺序一致，输出各阶段耗时和吞吐；
+// 之后流水线在后台循环读文件，渲染线程每帧上传最新的结果。另外校验线程池的分块覆盖、嵌套 parallelFor 和乱序丢帧
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "TextureCache.h"
+#include "FrameBuffer.h"
+#include "ColorConvert.h"
+#include "ThreadPool.h"
+#include "Pipeline.h"
+#include "RawVideoFile.h"
+#include "Profiler.h"
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <unistd.h>
+
+static const int PIPE_WIDTH = 1280;
+static const int PIPE_HEIGHT = 720;
+static const int PIPE_FILE_FRAMES = 24;
+static const int PIPE_THREADS = 4;
+static const int PIPE_IN_FLIGHT = 4;
+static const int PIPE_BAND_ROWS = 64;           // 分块的行数(偶数，YUV420P 色度按两行一组)
+
+// 帧里各阶段输出的槽位
+enum PipeSlot {
+    PipeSlot_Yuv = 0,
+    PipeSlot_Bgr,
+    PipeSlot_Gray,
+    PipeSlot_Edges,
+};
+
+struct PipeContext {
+    RawVideoReader reader;
+    FrameBufferPool yuvPool{PIPE_IN_FLIGHT + 2, 64};
+    FrameBufferPool bgrPool{PIPE_IN_FLIGHT + 2, 64};
+    FrameBufferPool grayPool{PIPE_IN_FLIGHT * 2 + 2, 64};
+    std::vector<uint64_t> checksums;            // 每帧边缘图的校验和(按文件里的帧序号)
+    uint64_t expectedSeq = 0;                   // 显示阶段下一个应该收到的序号
+    std::atomic<int> orderErrors{0};
+    TextureCache *display = nullptr;
+    int intervalMs = 0;                         // 源阶段每帧的间隔(模拟按帧率采集)，0为尽快读
+};
+
+static char g_PipePath[256];
+static std::unique_ptr<ThreadPool> g_PipePool;
+static std::unique_ptr<PipeContext> g_PipeLive;
+static std::unique_ptr<Pipeline> g_PipeLivePipeline;
+static std::thread g_PipeLiveThread;
+static TextureCache *g_PipeCache = nullptr;
+static uint64_t g_PipeLastFrames = 0;
+
+// 帧内容: 水平渐变背景上移动的方块，色度随帧变化
+static void pipeFill(FrameBuffer *buffer, int index) {
+    int box = 160;
+    int bx = (index * 37) % (PIPE_WIDTH - box);
+    int by = (index * 23) % (PIPE_HEIGHT - box);
+    for (int y = 0; y < PIPE_HEIGHT; y++) {
+        uint8_t *row = buffer->planes[0] + (size_t) y * buffer->strides[0];
+        for (int x = 0; x < PIPE_WIDTH; x++) {
+            bool inside = x >= bx && x < bx + box && y >= by && y < by + box;
+            row[x] = inside ? 230 : (uint8_t) (x * 160 / PIPE_WIDTH + 20);
+        }
+    }
+    for (int plane = 1; plane < 3; plane++) {
+        for (int y = 0; y < (PIPE_HEIGHT + 1) / 2; y++) {
+            memset(buffer->planes[plane] + (size_t) y * buffer->strides[plane],
+                   (uint8_t) (128 + (plane == 1 ? index : -index) * 3), (PIPE_WIDTH + 1) / 2);
+        }
+    }
+}
+
+static bool pipeWriteFile() {
+    const char *dir = getenv("TMPDIR");
+    snprintf(g_PipePath, sizeof(g_PipePath), "%s/nativebench_pipeline_%d.yuv", dir != nullptr ? dir : "/tmp",
+             (int) getpid());
+    RawVideoWriter writer;
+    if (!writer.open(g_PipePath, FrameBuffer_YUV420P, PIPE_WIDTH, PIPE_HEIGHT)) {
+        return false;
+    }
+    FrameBufferPool pool(1);
+    for (int i = 0; i < PIPE_FILE_FRAMES; i++) {
+        FrameBufferRef buffer = pool.acquire(FrameBuffer_YUV420P, PIPE_WIDTH, PIPE_HEIGHT);
+        pipeFill(buffer.get(), i);
+        if (!writer.write(*buffer.get())) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 解码: YUV420P 转 BGR，按行带分到线程池
+static bool pipeDecode(ThreadPool &pool, PipeContext &context, PipelineFrame &frame) {
+    const FrameBufferRef &yuv = frame.buffers[PipeSlot_Yuv];
+    FrameBufferRef bgr = context.bgrPool.acquire(FrameBuffer_BGR24, yuv->width, yuv->height);
+    if (!bgr) {
+        return false;
+    }
+    int bands = (yuv->height + PIPE_BAND_ROWS - 1) / PIPE_BAND_ROWS;
+    pool.parallelFor(0, bands, 1, [&](int first, int last) {
+        for (int band = first; band < last; band++) {
+            int y0 = band * PIPE_BAND_ROWS;
+            int rows = y0 + PIPE_BAND_ROWS < yuv->height ? PIPE_BAND_ROWS : yuv->height - y0;
+            ColorConvert::yuv420pToRgb(yuv->planes[0] + (size_t) y0 * yuv->strides[0], yuv->strides[0],
+                                       yuv->planes[1] + (size_t) (y0 / 2) * yuv->strides[1], yuv->strides[1],
+                                       yuv->planes[2] + (size_t) (y0 / 2) * yuv->strides[2], yuv->strides[2],
+                                       bgr->planes[0] + (size_t) y0 * bgr->strides[0], bgr->strides[0],
+                                       yuv->width, rows, ColorConvert_BGR);
+        }
+    });
+    bgr->seq = yuv->seq;
+    frame.buffers[PipeSlot_Bgr] = std::move(bgr);
+    // 解码完原始帧就可以回到池里
+    frame.buffers[PipeSlot_Yuv].reset();
+    return true;
+}
+
+// 分析: 半尺寸灰度(2x2平均) x 增益，再做 Sobel 边缘(|gx| + |gy|)，两遍都分块并行
+static bool pipeAnalyse(ThreadPool &pool, PipeContext &context, PipelineFrame &frame) {
+    const FrameBufferRef &bgr = frame.buffers[PipeSlot_Bgr];
+    int width = bgr->width / 2;
+    int height = bgr->height / 2;
+    FrameBufferRef gray = context.grayPool.acquire(FrameBuffer_GRAY8, width, height);
+    FrameBufferRef edges = context.grayPool.acquire(FrameBuffer_GRAY8, width, height);
+    if (!gray || !edges) {
+        return false;
+    }
+    const int gain = 307;   // 1.2 (Q8)
+    pool.parallelTiles(width, height, width, PIPE_BAND_ROWS / 2, [&](const TileRect &tile) {
+        for (int y = tile.y0; y < tile.y1; y++) {
+            const uint8_t *src0 = bgr->planes[0] + (size_t) (y * 2) * bgr->strides[0];
+            const uint8_t *src1 = src0 + bgr->strides[0];
+            uint8_t *dst = gray->planes[0] + (size_t) y * gray->strides[0];
+            for (int x = tile.x0; x < tile.x1; x++) {
+                const uint8_t *p0 = src0 + x * 6;
+                const uint8_t *p1 = src1 + x * 6;
+                int b = p0[0] + p0[3] + p1[0] + p1[3];
+                int g = p0[1] + p0[4] + p1[1] + p1[4];
+                int r = p0[2] + p0[5] + p1[2] + p1[5];
+                int luma = (b * 29 + g * 150 + r * 77) >> 10;
+                luma = (luma * gain) >> 8;
+                dst[x] = (uint8_t) (luma > 255 ? 255 : luma);
+            }
+        }
+    });
+    std::atomic<uint64_t> checksum{0};
+    pool.parallelTiles(width, height, width, PIPE_BAND_ROWS / 2, [&](const TileRect &tile) {
+        uint64_t sum = 0;
+        for (int y = tile.y0; y < tile.y1; y++) {
+            uint8_t *dst = edges->planes[0] + (size_t) y * edges->strides[0];
+            if (y == 0 || y == height - 1) {
+                memset(dst, 0, width);
+                continue;
+            }
+            const uint8_t *up = gray->planes[0] + (size_t) (y - 1) * gray->strides[0];
+            const uint8_t *mid = up + gray->strides[0];
+            const uint8_t *down = mid + gray->strides[0];
+            dst[0] = dst[width - 1] = 0;
+            for (int x = 1; x < width - 1; x++) {
+                int gx = (up[x + 1] + 2 * mid[x + 1] + down[x + 1]) - (up[x - 1] + 2 * mid[x - 1] + down[x - 1]);
+                int gy = (down[x - 1] + 2 * down[x] + down[x + 1]) - (up[x - 1] + 2 * up[x] + up[x + 1]);
+                int magnitude = (gx < 0 ? -gx : gx) + (gy < 0 ? -gy : gy);
+                dst[x] = (uint8_t) (magnitude > 255 ? 255 : magnitude);
+                sum += (uint64_t) dst[x] * (uint64_t) (x + y);
+            }
+        }
+        checksum.fetch_add(sum, std::memory_order_relaxed);
+    });
+    uint64_t seq = bgr->seq;
+    if (seq < context.checksums.size()) {
+        context.checksums[seq] = checksum.load();
+    }
+    gray->seq = edges->seq = seq;
+    frame.buffers[PipeSlot_Gray] = std::move(gray);
+    frame.buffers[PipeSlot_Edges] = std::move(edges);
+    return true;
+}
+
+// 显示: 按顺序发布(只交出引用，渲染线程上传)
+static bool pipeDisplay(PipeContext &context, PipelineFrame &frame) {
+    if (frame.seq != context.expectedSeq) {
+        context.orderErrors++;
+    }
+    context.expectedSeq = frame.seq + 1;
+    if (context.display != nullptr) {
+        context.display->publish("pipeline bgr", TextureFrame::fromFrameBuffer(frame.buffers[PipeSlot_Bgr]));
+        context.display->publish("pipeline edges", TextureFrame::fromFrameBuffer(frame.buffers[PipeSlot_Edges]));
+    }
+    return true;
+}
+
+static void pipeBuild(Pipeline &pipeline, PipeContext &context) {
+    ThreadPool *pool = &pipeline.getPool();
+    pipeline.setSource("read", [&context](PipelineFrame &frame) {
+        if (context.intervalMs > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(context.intervalMs));
+        }
+        frame.buffers[PipeSlot_Yuv] = context.reader.read(context.yuvPool);
+        return (bool) frame.buffers[PipeSlot_Yuv];
+    });
+    pipeline.addStage("decode", PipelineStage_Serial, [pool, &context](PipelineFrame &frame) {
+        return pipeDecode(*pool, context, frame);
+    });
+    pipeline.addStage("analyse", PipelineStage_Parallel, [pool, &context](PipelineFrame &frame) {
+        return pipeAnalyse(*pool, context, frame);
+    });
+    pipeline.addStage("display", PipelineStage_Serial, [&context](PipelineFrame &frame) {
+        return pipeDisplay(context, frame);
+    });
+}
+
+// 逐帧单线程 / 流水线各跑一遍文件，结果必须一致
+static void pipeCompare() {
+    PipeContext sequential, pipelined;
+    sequential.checksums.assign(PIPE_FILE_FRAMES, 0);
+    pipelined.checksums.assign(PIPE_FILE_FRAMES, 1);
+    if (!sequential.reader.open(g_PipePath, FrameBuffer_YUV420P, PIPE_WIDTH, PIPE_HEIGHT) ||
+        !pipelined.reader.open(g_PipePath, FrameBuffer_YUV420P, PIPE_WIDTH, PIPE_HEIGHT)) {
+        benchFail("pipeline: open %s", g_PipePath);
+        return;
+    }
+    if (sequential.reader.getFrameCount() != PIPE_FILE_FRAMES) {
+        benchFail("pipeline: file has %d frames, expected %d", sequential.reader.getFrameCount(), PIPE_FILE_FRAMES);
+    }
+    Pipeline first(*g_PipePool), second(*g_PipePool);
+    pipeBuild(first, sequential);
+    pipeBuild(second, pipelined);
+    uint64_t sequentialFrames = first.runSequential();
+    uint64_t pipelinedFrames = second.run(PIPE_IN_FLIGHT);
+    PipelineStats a = first.getStats();
+    PipelineStats b = second.getStats();
+    printf("pipeline sequential (one frame at a time):\n");
+    first.printStats();
+    printf("pipeline pipelined (%d threads, %d in flight):\n", g_PipePool->getThreadCount(), PIPE_IN_FLIGHT);
+    second.printStats();
+    printf("pipeline         throughput %.1f -> %.1f fps (x%.2f, %u cores)\n", a.fps(), b.fps(),
+           a.fps() > 0 ? b.fps() / a.fps() : 0.0, std::thread::hardware_concurrency());
+    if (sequentialFrames != PIPE_FILE_FRAMES || pipelinedFrames != PIPE_FILE_FRAMES) {
+        benchFail("pipeline: frames %llu / %llu, expected %d", (unsigned long long) sequentialFrames,
+                  (unsigned long long) pipelinedFrames, PIPE_FILE_FRAMES);
+    }
+    if (sequential.orderErrors != 0 || pipelined.orderErrors != 0) {
+        benchFail("pipeline: display order errors %d / %d", sequential.orderErrors.load(),
+                  pipelined.orderErrors.load());
+    }
+    for (int i = 0; i < PIPE_FILE_FRAMES; i++) {
+        if (sequential.checksums[i] != pipelined.checksums[i] || sequential.checksums[i] == 0) {
+            benchFail("pipeline: frame %d checksum %llu != %llu", i, (unsigned long long) sequential.checksums[i],
+                      (unsigned long long) pipelined.checksums[i]);
+            break;
+        }
+    }
+    if (b.stages.size() != 4 || b.stages[1].maxConcurrent != 1 || b.stages[3].maxConcurrent != 1) {
+        benchFail("pipeline: serial stage ran concurrently");
+    }
+    if (b.maxInFlight < 2 || b.maxInFlight > PIPE_IN_FLIGHT) {
+        benchFail("pipeline: in flight %d, expected 2..%d", b.maxInFlight, PIPE_IN_FLIGHT);
+    }
+    // 帧完成后缓冲全部还给池
+    if (pipelined.yuvPool.getStats().outstanding != 0 || pipelined.bgrPool.getStats().outstanding != 0 ||
+        pipelined.grayPool.getStats().outstanding != 0) {
+        benchFail("pipeline: buffers still held after run");
+    }
+}
+
+// 线程池: 分块不重不漏，任务里嵌套 parallelFor 不死锁
+static void pipeCheckPool() {
+    ThreadPool &pool = *g_PipePool;
+    std::vector<uint8_t> covered(333 * 97, 0);
+    pool.parallelTiles(333, 97, 64, 16, [&](const TileRect &tile) {
+        for (int y = tile.y0; y < tile.y1; y++) {
+            for (int x = tile.x0; x < tile.x1; x++) {
+                covered[y * 333 + x]++;
+            }
+        }
+    });
+    for (uint8_t count: covered) {
+        if (count != 1) {
+            benchFail("pipeline pool: tile coverage %d", count);
+            break;
+        }
+    }
+    std::atomic<int> total{0};
+    pool.parallelFor(0, 16, 1, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            pool.parallelFor(0, 100, 7, [&](int begin, int end) {
+                total.fetch_add(end - begin, std::memory_order_relaxed);
+            });
+        }
+    });
+    if (total != 1600) {
+        benchFail("pipeline pool: nested parallelFor total %d", total.load());
+    }
+}
+
+// 并行阶段乱序完成、丢掉一半的帧，串行阶段仍然按顺序只收到留下的帧
+static void pipeCheckOrdering() {
+    Pipeline pipeline(*g_PipePool);
+    uint64_t produced = 0;
+    std::vector<uint64_t> received;
+    pipeline.setSource("count", [&produced](PipelineFrame &) {
+        return produced++ < 200;
+    });
+    pipeline.addStage("shuffle", PipelineStage_Parallel, [](PipelineFrame &frame) {
+        std::this_thread::sleep_for(std::chrono::microseconds((frame.seq * 7919) % 5 * 100));
+        return frame.seq % 2 == 0;
+    });
+    pipeline.addStage("sink", PipelineStage_Serial, [&received](PipelineFrame &frame) {
+        received.push_back(frame.seq);
+        return true;
+    });
+    pipeline.run(8);
+    PipelineStats stats = pipeline.getStats();
+    bool ordered = received.size() == 100;
+    for (size_t i = 0; ordered && i < received.size(); i++) {
+        ordered = received[i] == i * 2;
+    }
+    if (!ordered || stats.frames != 200 || stats.dropped != 100 || stats.stages[1].dropped != 100) {
+        benchFail("pipeline ordering: received %zu frames, completed %llu dropped %llu", received.size(),
+                  (unsigned long long) stats.frames, (unsigned long long) stats.dropped);
+    }
+}
+
+static void pipeSetup() {
+    g_PipePool.reset(new ThreadPool(PIPE_THREADS));
+    if (!pipeWriteFile()) {
+        benchFail("pipeline: write %s", g_PipePath);
+        return;
+    }
+    pipeCheckPool();
+    pipeCheckOrdering();
+    pipeCompare();
+
+    // 后台循环读文件，结果发布给渲染线程
+    g_PipeCache = new TextureCache();
+    g_PipeLive.reset(new PipeContext());
+    g_PipeLive->display = g_PipeCache;
+    g_PipeLive->intervalMs = 16;
+    g_PipeLive->reader.open(g_PipePath, FrameBuffer_YUV420P, PIPE_WIDTH, PIPE_HEIGHT);
+    g_PipeLive->reader.setLoop(true);
+    g_PipeLivePipeline.reset(new Pipeline(*g_PipePool));
+    pipeBuild(*g_PipeLivePipeline, *g_PipeLive);
+    g_PipeLastFrames = 0;
+    g_PipeLiveThread = std::thread([] {
+        PROFILE_THREAD("pipeline");
+        g_PipeLivePipeline->run(PIPE_IN_FLIGHT);
+    });
+}
+
+static void pipeFrame(int) {
+    if (g_PipeCache == nullptr) {
+        return;
+    }
+    int uploads = g_PipeCache->upload();
+    g_PipeCache->draw();
+    PipelineStats stats = g_PipeLivePipeline->getStats();
+    benchCounter("pipeline frames", (double) (stats.frames - g_PipeLastFrames));
+    benchCounter("pipeline uploads", uploads);
+    g_PipeLastFrames = stats.frames;
+}
+
+static void pipeTeardown() {
+    if (g_PipeLivePipeline) {
+        g_PipeLivePipeline->stop();
+        g_PipeLiveThread.join();
+        printf("pipeline live:\n");
+        g_PipeLivePipeline->printStats();
+        if (g_PipeLive->orderErrors != 0) {
+            benchFail("pipeline live: display order errors %d", g_PipeLive->orderErrors.load());
+        }
+        g_PipeLivePipeline.reset();
+    }
+    delete g_PipeCache;
+    g_PipeCache = nullptr;
+    g_PipeLive.reset();
+    ThreadPoolStats stats = g_PipePool->getStats();
+    printf("pipeline pool    %d threads: %llu tasks, %llu stolen, %llu run by waiting threads\n",
+           g_PipePool->getThreadCount(), (unsigned long long) stats.executed, (unsigned long long) stats.stolen,
+           (unsigned long long) stats.helped);
+    g_PipePool.reset();
+    unlink(g_PipePath);
+}
+
+BENCH_SCENE("pipeline", "file-driven read -> decode -> tiled analysis -> display on a work-stealing pool",
+            pipeSetup, pipeFrame, pipeTeardown);
@@ -0,0 +1,211 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 帧分析器场景: 测量每个 PROFILE_ZONE 的开销(要求低于50ns)，4个线程持续写入嵌套区段，
+// 每帧从渲染线程读取并校验，显示时间线窗口，最后导出 Chrome trace 校验条数
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+
+#if defined(NATIVE_SURFACE_PROFILER)
+
+static const int PROFILER_WRITERS = 4;
+static const int PROFILER_LOOP = 2000000;
+static const double PROFILER_MAX_ZONE_NS = 50.0;
+
+static const char *const PROFILER_NAMES[] = {"writer frame", "writer step", "writer leaf"};
+
+static std::thread g_ProfilerWriters[PROFILER_WRITERS];
+static std::atomic<bool> g_ProfilerRunning{false};
+static std::atomic<uint64_t> g_ProfilerWritten{0};
+static std::vector<ProfileThreadEvents> g_ProfilerThreads;
+
+static int64_t monotonicNs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// 空循环和带区段的循环各跑一遍，差值就是每个区段的开销
+static double measureZoneNs(bool enabled) {
+    Profiler::setEnabled(enabled);
+    int64_t t0 = monotonicNs();
+    for (int i = 0; i < PROFILER_LOOP; i++) {
+        asm volatile("" ::: "memory");
+    }
+    int64_t t1 = monotonicNs();
+    for (int i = 0; i < PROFILER_LOOP; i++) {
+        PROFILE_ZONE("overhead");
+        asm volatile("" ::: "memory");
+    }
+    int64_t t2 = monotonicNs();
+    Profiler::setEnabled(true);
+    return (double) ((t2 - t1) - (t1 - t0)) / PROFILER_LOOP;
+}
+
+static void profilerWriter(int index) {
+    char name[16];
+    snprintf(name, sizeof(name), "writer%d", index);
+    PROFILE_THREAD(name);
+    volatile uint32_t sink = 0;
+    while (g_ProfilerRunning.load(std::memory_order_relaxed)) {
+        PROFILE_ZONE("writer frame");
+        for (int step = 0; step < 8; step++) {
+            PROFILE_ZONE("writer step");
+            for (int leaf = 0; leaf < 4; leaf++) {
+                PROFILE_ZONE("writer leaf");
+                for (int i = 0; i < 200; i++) {
+                    sink = sink + i;
+                }
+            }
+        }
+        g_ProfilerWritten.fetch_add(1 + 8 + 32, std::memory_order_relaxed);
+        std::this_thread::sleep_for(std::chrono::microseconds(200 * (index + 1)));
+    }
+}
+
+static void profilerSetup() {
+    // 取三次里最好的一次，排除调度抖动
+    double enabledNs = 1e9, disabledNs = 1e9;
+    for (int i = 0; i < 3; i++) {
+        enabledNs = std::min(enabledNs, measureZoneNs(true));
+        disabledNs = std::min(disabledNs, measureZoneNs(false));
+    }
+    int64_t t0 = monotonicNs();
+    for (int i = 0; i < PROFILER_LOOP; i++) {
+        asm volatile("" :: "r"(Profiler::nowNs()) : "memory");
+    }
+    double clockNs = (double) (monotonicNs() - t0) / PROFILER_LOOP;
+    printf("profiler         zone %6.1f ns  disabled at runtime %5.1f ns  (clock_gettime %5.1f ns)\n", enabledNs,
+           disabledNs, clockNs);
+    if (enabledNs > PROFILER_MAX_ZONE_NS) {
+        benchFail("profiler zone overhead %.1f ns > %.0f ns", enabledNs, PROFILER_MAX_ZONE_NS);
+    }
+
+    // 换算后的时间和 CLOCK_MONOTONIC 对得上
+    int64_t before = Profiler::nowNs();
+    int64_t converted = Profiler::ticksToNs(Profiler::ticks());
+    int64_t after = Profiler::nowNs();
+    if (converted < before - 100000 || converted > after + 100000) {
+        benchFail("profiler ticksToNs %lld outside [%lld, %lld]", (long long) converted, (long long) before,
+                  (long long) after);
+    }
+
+    g_ProfilerWritten = 0;
+    g_ProfilerRunning = true;
+    for (int i = 0; i < PROFILER_WRITERS; i++) {
+        g_ProfilerWriters[i] = std::thread(profilerWriter, i);
+    }
+}
+
+static bool knownWriterName(const char *name) {
+    for (const char *known: PROFILER_NAMES) {
+        if (name == known || (name != nullptr && strcmp(name, known) == 0)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// 读取全部线程的记录: 写入线程的区段名称、层级和起止时间都要合法，子区段落在父区段之内
+static void checkWriters() {
+    int64_t sinceNs = Profiler::nowNs() - 20000000;
+    Profiler::collect(g_ProfilerThreads, sinceNs);
+    int writers = 0;
+    size_t events = 0;
+    for (const ProfileThreadEvents &thread: g_ProfilerThreads) {
+        if (strncmp(thread.name, "writer", 6) != 0) {
+            continue;
+        }
+        writers++;
+        events += thread.events.size();
+        int64_t parentEnd[3] = {INT64_MAX, INT64_MAX, INT64_MAX};
+        for (size_t i = 0; i < thread.events.size(); i++) {
+            const ProfileEvent &event = thread.events[i];
+            if (!knownWriterName(event.name) || event.depth > 2 || event.endNs < event.startNs) {
+                benchFail("profiler %s event %zu torn: depth %d %lld..%lld", thread.name, i, event.depth,
+                          (long long) event.startNs, (long long) event.endNs);
+                break;
+            }
+            if (event.name != PROFILER_NAMES[event.depth]) {
+                benchFail("profiler %s depth %d has %s", thread.name, event.depth, event.name);
+                break;
+            }
+            // 父区段在子区段之后写入，正在进行的父区段还没有记录，只检查已记录的父区段
+            int64_t parent = event.depth > 0 ? parentEnd[event.depth - 1] : INT64_MAX;
+            if (event.startNs < parent && event.endNs > parent) {
+                benchFail("profiler %s %s ends after its parent", thread.name, event.name);
+                break;
+            }
+            parentEnd[event.depth] = event.endNs;
+        }
+    }
+    if (writers != PROFILER_WRITERS) {
+        benchFail("profiler collected %d writer threads", writers);
+    }
+    benchCounter("collected events", (double) events);
+}
+
+static void profilerFrame(int frame) {
+    if (frame > 0) {
+        checkWriters();
+    }
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, 1600), ImGuiCond_Always);
+    Profiler::showWindow();
+}
+
+static void profilerTeardown() {
+    g_ProfilerRunning = false;
+    for (std::thread &thread: g_ProfilerWriters) {
+        thread.join();
+    }
+    // 导出全部记录，条数要和读取到的一致
+    char path[256];
+    const char *dir = getenv("TMPDIR");
+    snprintf(path, sizeof(path), "%s/nativebench_trace_%d.json", dir != nullptr ? dir : "/tmp", (int) getpid());
+    Profiler::collect(g_ProfilerThreads);
+    size_t expected = 0;
+    for (const ProfileThreadEvents &thread: g_ProfilerThreads) {
+        expected += thread.events.size();
+    }
+    if (!Profiler::exportChromeTrace(path)) {
+        benchFail("profiler export %s failed", path);
+        return;
+    }
+    FILE *file = fopen(path, "r");
+    size_t complete = 0, metadata = 0;
+    long bytes = 0;
+    bool header = false;
+    char line[512];
+    while (file != nullptr && fgets(line, sizeof(line), file) != nullptr) {
+        header = header || strncmp(line, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 39) == 0;
+        complete += strstr(line, "\"ph\":\"X\"") != nullptr;
+        metadata += strstr(line, "\"ph\":\"M\"") != nullptr;
+        bytes += (long) strlen(line);
+    }
+    if (file != nullptr) {
+        fclose(file);
+    }
+    remove(path);
+    printf("profiler         written %llu zones, exported %zu events from %zu threads (%.1f KB)\n",
+           (unsigned long long) g_ProfilerWritten.load(), complete, metadata, (double) bytes / 1024.0);
+    // 写入线程已经停止，但主线程在 collect 之后还会记录 drawEnd 之类的区段
+    if (!header || complete < expected || metadata != g_ProfilerThreads.size()) {
+        benchFail("profiler trace: header %d, %zu events (expected >= %zu), %zu threads", header, complete, expected,
+                  metadata);
+    }
+    g_ProfilerThreads.clear();
+}
+
+BENCH_SCENE("profiler", "PROFILE_ZONE overhead, 4 threads writing nested zones, timeline window and Chrome trace export",
+            profilerSetup, profilerFrame, profilerTeardown);
+
+#endif
@@ -0,0 +1,202 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 后台线程绘制场景: 8个生产线程各自录制 ImDrawList 提交到 DrawListQueue，drawEnd() 时叠加到主图层，
+// 期间不断销毁/重建通道并在中途取消/恢复关联，校验每个叠加的列表完整且来自最新的提交
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdlib>
+
+static const int QUEUE_PRODUCERS = 8;
+static const int QUEUE_CHANNEL_LIFETIME = 64;   // 每个通道提交这么多次后销毁重建
+
+struct QueueProducer {
+    std::thread thread;
+    std::atomic<uint32_t> submits{0};
+    std::atomic<uint32_t> skipped{0};           // begin() 返回nullptr 的次数
+    uint32_t lastSeq = 0;                        // 渲染线程: 已经显示过的最大序号
+};
+
+static QueueProducer g_QueueProducers[QUEUE_PRODUCERS];
+static std::atomic<bool> g_QueueRunning{false};
+static DrawListQueueStats g_QueueLastStats;
+
+// 颜色里编码线程号和序号，渲染线程据此校验列表没有被撕裂
+static ImU32 queueColor(int index, uint32_t seq) {
+    return IM_COL32(index, seq & 0xFF, (seq >> 8) & 0xFF, 0x80 | ((seq >> 16) & 0x7F));
+}
+
+static uint32_t queueSeq(ImU32 col) {
+    return ((col >> IM_COL32_G_SHIFT) & 0xFF) | (((col >> IM_COL32_B_SHIFT) & 0xFF) << 8) |
+           (((col >> IM_COL32_A_SHIFT) & 0x7F) << 16);
+}
+
+static int queueRects(uint32_t seq) {
+    return 1 + (int) (seq * 2654435761u >> 24) % 200;
+}
+
+static void queueProducer(int index) {
+    DrawListQueue *queue = getDrawListQueue();
+    QueueProducer &producer = g_QueueProducers[index];
+    char name[32];
+    snprintf(name, sizeof(name), "worker%d", index);
+    DrawListChannel *channel = queue->createChannel(name, index);
+    uint32_t seq = 0;
+    int channelSubmits = 0;
+    while (g_QueueRunning.load(std::memory_order_relaxed)) {
+        ImDrawList *list = channel->begin();
+        if (list == nullptr) {
+            producer.skipped.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();
+            continue;
+        }
+        seq++;
+        ImU32 col = queueColor(index, seq);
+        int rects = queueRects(seq);
+        float x0 = (float) index * 120.0f;
+        for (int i = 0; i < rects; i++) {
+            float y = (float) (i % 50) * 24.0f + (float) (i / 50) * 4.0f;
+            list->AddRectFilled(ImVec2(x0, y), ImVec2(x0 + 100.0f, y + 20.0f), col);
+        }
+        // 每4次提交带一段文字，用到共享的字体图集
+        if (seq % 4 == 0) {
+            char text[48];
+            snprintf(text, sizeof(text), "worker %d seq %u", index, seq);
+            list->AddText(ImVec2(x0, 1300.0f), col, text);
+        }
+        channel->submit();
+        producer.submits.fetch_add(1, std::memory_order_relaxed);
+        if (++channelSubmits == QUEUE_CHANNEL_LIFETIME) {
+            queue->destroyChannel(channel);
+            channel = queue->createChannel(name, index);
+            channelSubmits = 0;
+        }
+        // 一半线程全速提交，另一半模拟按自己的节奏出结果
+        if (index % 2 == 1) {
+            std::this_thread::sleep_for(std::chrono::microseconds(500 * index));
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    queue->destroyChannel(channel);
+}
+
+static void queueSetup() {
+    g_QueueRunning = true;
+    g_QueueLastStats = getDrawListQueue()->getStats();
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        g_QueueProducers[i].submits = 0;
+        g_QueueProducers[i].skipped = 0;
+        g_QueueProducers[i].lastSeq = 0;
+        g_QueueProducers[i].thread = std::thread(queueProducer, i);
+    }
+}
+
+// 校验上一帧叠加的列表: 同一列表颜色一致(没有混入其他提交)，顶点数与序号对应，序号不回退
+// (ImGui自己的列表已经被本帧 NewFrame() 重置，只检查队列的列表)
+static void checkSplicedLists() {
+    ImDrawData *drawData = getDrawListQueue()->getSplicedDrawData();
+    if (drawData == nullptr) {
+        return;
+    }
+    uint32_t frameSeq[QUEUE_PRODUCERS] = {};
+    int lists = 0;
+    for (int n = 0; n < drawData->CmdListsCount; n++) {
+        const ImDrawList *list = drawData->CmdLists[n];
+        if (list->_OwnerName == nullptr || strncmp(list->_OwnerName, "worker", 6) != 0) {
+            if (lists > 0) {
+                benchFail("drawqueue8 ImGui list %s after worker lists", list->_OwnerName);
+            }
+            continue;
+        }
+        lists++;
+        ImU32 col = list->VtxBuffer[0].col;
+        int index = (int) ((col >> IM_COL32_R_SHIFT) & 0xFF);
+        uint32_t seq = queueSeq(col);
+        if (index >= QUEUE_PRODUCERS || atoi(list->_OwnerName + 6) != index) {
+            benchFail("drawqueue8 list %s has color of producer %d", list->_OwnerName, index);
+            continue;
+        }
+        for (const ImDrawVert &vert: list->VtxBuffer) {
+            if (vert.col != col) {
+                benchFail("drawqueue8 list %s seq %u mixes vertex colors", list->_OwnerName, seq);
+                break;
+            }
+        }
+        int rectVtx = queueRects(seq) * 4;
+        if (seq % 4 == 0 ? list->VtxBuffer.Size <= rectVtx : list->VtxBuffer.Size != rectVtx) {
+            benchFail("drawqueue8 list %s seq %u has %d vertices, expected %d", list->_OwnerName, seq,
+                      list->VtxBuffer.Size, rectVtx);
+        }
+        int elems = 0;
+        for (const ImDrawCmd &cmd: list->CmdBuffer) {
+            elems += (int) cmd.ElemCount;
+        }
+        if (elems != list->IdxBuffer.Size) {
+            benchFail("drawqueue8 list %s seq %u draw commands cover %d of %d indices", list->_OwnerName, seq, elems,
+                      list->IdxBuffer.Size);
+        }
+        frameSeq[index] = ImMax(frameSeq[index], seq);
+    }
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        QueueProducer &producer = g_QueueProducers[i];
+        if (frameSeq[i] != 0 && frameSeq[i] < producer.lastSeq) {
+            benchFail("drawqueue8 producer %d went back from seq %u to %u", i, producer.lastSeq, frameSeq[i]);
+        }
+        producer.lastSeq = ImMax(producer.lastSeq, frameSeq[i]);
+    }
+    benchCounter("spliced lists", lists);
+}
+
+static void queueFrame(int frame) {
+    checkSplicedLists();
+
+    // 中途取消关联再恢复，模拟主图层重建(横竖屏切换)
+    OverlayLayer *layer = getMainLayer();
+    if (frame % 100 == 50) {
+        layer->setDrawListQueue(nullptr);
+    } else if (frame % 100 == 52) {
+        layer->setDrawListQueue(getDrawListQueue());
+    }
+
+    DrawListQueueStats stats = getDrawListQueue()->getStats();
+    benchCounter("submits/frame", (double) (stats.submitted - g_QueueLastStats.submitted));
+    benchCounter("acquired/frame", (double) (stats.acquired - g_QueueLastStats.acquired));
+    benchCounter("channels", stats.channels);
+    g_QueueLastStats = stats;
+
+    ImGui::SetNextWindowPos(ImVec2(0, 1400), ImGuiCond_Always);
+    ImGui::Begin("drawqueue8", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        ImGui::Text("worker%d submits %u skipped %u shown seq %u", i, g_QueueProducers[i].submits.load(),
+                    g_QueueProducers[i].skipped.load(), g_QueueProducers[i].lastSeq);
+    }
+    ImGui::End();
+}
+
+static void queueTeardown() {
+    g_QueueRunning = false;
+    for (QueueProducer &producer: g_QueueProducers) {
+        producer.thread.join();
+    }
+    for (int i = 0; i < QUEUE_PRODUCERS; i++) {
+        if (g_QueueProducers[i].submits == 0 || g_QueueProducers[i].lastSeq == 0) {
+            benchFail("drawqueue8 producer %d submits %u shown seq %u", i, g_QueueProducers[i].submits.load(),
+                      g_QueueProducers[i].lastSeq);
+        }
+    }
+    DrawListQueueStats stats = getDrawListQueue()->getStats();
+    printf("drawqueue8       submitted %llu acquired %llu dropped %llu\n", (unsigned long long) stats.submitted,
+           (unsigned long long) stats.acquired, (unsigned long long) stats.dropped);
+    // 场景可能停在取消关联的那几帧，恢复关联；已销毁的通道在下一次 drawEnd() 时释放
+    getMainLayer()->setDrawListQueue(getDrawListQueue());
+}
+
+BENCH_SCENE("drawqueue8", "8 producer threads recording ImDrawLists into DrawListQueue, spliced as foreground",
+            queueSetup, queueFrame, queueTeardown);
@@ -0,0 +1,277 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 原始帧采集场景: SyntheticFrameSource 代替 AImageReader 按240fps产出 RGBA 帧，RawFramePool 分发带引用计数的帧，
+// 渲染线程取最新帧上传纹理、持有几帧后释放，分析线程并行读取同一帧；
+// 校验持有期间帧内容不被生产端改写、同时持有的帧数不超过上限、超限时计入 dropped、结束时全部帧已还给来源、
+// 池析构时等待其他线程的引用
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include "RawFramePool.h"
+#include "Profiler.h"
+#include <memory>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+
+static const uint32_t RAW_WIDTH = 720;
+static const uint32_t RAW_HEIGHT = 1280;
+static const int RAW_MAX_IMAGES = 4;
+static const int RAW_POOL_CAP = 3;          // 比来源上限少一帧，留给 acquireLatest 轮换
+static const float RAW_FPS = 240.0f;
+
+// 持有中的帧和取到时的序号，释放前再校验一次
+struct RawHeldFrame {
+    RawFrameRef ref;
+    uint64_t seq;
+};
+
+static std::unique_ptr<SyntheticFrameSource> g_RawSource;
+static std::unique_ptr<SyntheticFrameSource> g_RawYuvSource;
+static std::unique_ptr<RawFramePool> g_RawPool;
+static std::unique_ptr<RawFramePool> g_RawYuvPool;
+static std::unique_ptr<ImageTexture> g_RawTexture;
+static std::deque<RawHeldFrame> g_RawHeld;
+static uint64_t g_RawLastSeq = 0;
+static double g_RawLatencyMs = 0.0;
+static int g_RawFrames = 0;
+
+// 分析线程: 从队列取帧引用，校验内容后模拟2ms的处理再释放
+static std::thread g_RawAnalysis;
+static std::mutex g_RawQueueMutex;
+static std::condition_variable g_RawQueueCond;
+static std::deque<RawHeldFrame> g_RawQueue;
+static bool g_RawAnalysisRunning = false;
+static std::atomic<int> g_RawAnalyzed{0};
+static std::atomic<int> g_RawAnalysisErrors{0};
+
+static bool checkHeld(const RawHeldFrame &held) {
+    uint64_t seq = 0;
+    return SyntheticFrameSource::checkPattern(*held.ref.get(), &seq) && seq == held.seq;
+}
+
+static void rawAnalysisLoop() {
+    PROFILE_THREAD("raw analysis");
+    std::unique_lock<std::mutex> lock(g_RawQueueMutex);
+    while (true) {
+        g_RawQueueCond.wait(lock, [] { return !g_RawAnalysisRunning || !g_RawQueue.empty(); });
+        if (g_RawQueue.empty()) {
+            break;
+        }
+        RawHeldFrame held = std::move(g_RawQueue.front());
+        g_RawQueue.pop_front();
+        lock.unlock();
+        {
+            PROFILE_ZONE("raw analyze");
+            if (!checkHeld(held)) {
+                g_RawAnalysisErrors.fetch_add(1);
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            // 处理完再校验一次，期间生产端一直在写其他缓冲
+            if (!checkHeld(held)) {
+                g_RawAnalysisErrors.fetch_add(1);
+            }
+        }
+        g_RawAnalyzed.fetch_add(1);
+        held.ref.reset();
+        lock.lock();
+    }
+}
+
+// 持有到上限: 再取一帧必须失败并计入 dropped，持有期间生产端继续写入但不能改写持有的帧
+static void checkPoolCap() {
+    std::vector<RawHeldFrame> held;
+    for (int i = 0; i < RAW_POOL_CAP; i++) {
+        RawFrameRef ref = g_RawPool->acquire(100);
+        uint64_t seq = 0;
+        if (!ref || !SyntheticFrameSource::checkPattern(*ref.get(), &seq)) {
+            benchFail("rawcapture acquire %d of %d failed", i + 1, RAW_POOL_CAP);
+            return;
+        }
+        held.push_back({std::move(ref), seq});
+    }
+    RawFramePoolStats before = g_RawPool->getStats();
+    if (g_RawPool->acquire(100)) {
+        benchFail("rawcapture acquired more than %d frames", RAW_POOL_CAP);
+    }
+    RawFramePoolStats after = g_RawPool->getStats();
+    if (after.dropped != before.dropped + 1 || after.outstanding != RAW_POOL_CAP ||
+        g_RawSource->getAcquiredCount() != RAW_POOL_CAP) {
+        benchFail("rawcapture at cap: dropped %llu -> %llu, outstanding %d, source acquired %d",
+                  (unsigned long long) before.dropped, (unsigned long long) after.dropped, after.outstanding,
+                  g_RawSource->getAcquiredCount());
+    }
+    // 240fps 下 50ms 约12帧，只剩 maxImages + 2 - 3 块缓冲在轮换
+    uint64_t produced = g_RawSource->getProducedCount();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    if (g_RawSource->getProducedCount() <= produced) {
+        benchFail("rawcapture producer stalled while frames were held");
+    }
+    for (const RawHeldFrame &frame: held) {
+        if (!checkHeld(frame)) {
+            benchFail("rawcapture frame %llu overwritten while held", (unsigned long long) frame.seq);
+        }
+    }
+    // 拷贝的引用释放后帧还在，最后一个引用释放时才还给来源
+    RawFrameRef copy = held[0].ref;
+    held.clear();
+    if (g_RawPool->getStats().outstanding != 1 || copy.useCount() != 1) {
+        benchFail("rawcapture copied ref: outstanding %d use count %d", g_RawPool->getStats().outstanding,
+                  copy.useCount());
+    }
+    copy.reset();
+    if (g_RawPool->getStats().outstanding != 0 || g_RawSource->getAcquiredCount() != 0) {
+        benchFail("rawcapture frames not returned to source: %d", g_RawSource->getAcquiredCount());
+    }
+}
+
+// 池先于引用销毁: 析构要等另一个线程释放引用，帧还给来源之后才返回
+static void checkPoolLifetime() {
+    std::unique_ptr<RawFramePool> pool(new RawFramePool(g_RawSource.get(), 1));
+    RawFrameRef ref = pool->acquire(100);
+    if (!ref) {
+        benchFail("rawcapture lifetime pool acquire failed");
+        return;
+    }
+    std::atomic<bool> released{false};
+    std::thread holder([&released](RawFrameRef held) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+        released = true;
+        held.reset();
+    }, std::move(ref));
+    pool.reset();
+    if (!released || g_RawSource->getAcquiredCount() != 0) {
+        benchFail("rawcapture pool destroyed before its refs: released %d, source acquired %d", (int) released.load(),
+                  g_RawSource->getAcquiredCount());
+    }
+    holder.join();
+}
+
+static void rawSetup() {
+    g_RawSource.reset(new SyntheticFrameSource(RAW_WIDTH, RAW_HEIGHT, RawFrame_RGBA_8888, RAW_MAX_IMAGES, RAW_FPS));
+    g_RawYuvSource.reset(new SyntheticFrameSource(RAW_WIDTH, RAW_HEIGHT, RawFrame_YUV_420_888, 2, 120.0f));
+    if (!g_RawSource->start() || !g_RawYuvSource->start()) {
+        benchFail("rawcapture source start failed");
+    }
+    g_RawPool.reset(new RawFramePool(g_RawSource.get(), RAW_POOL_CAP));
+    g_RawYuvPool.reset(new RawFramePool(g_RawYuvSource.get()));
+    if (g_RawPool->getMaxOutstanding() != RAW_POOL_CAP || g_RawYuvPool->getMaxOutstanding() != 2) {
+        benchFail("rawcapture pool cap %d/%d", g_RawPool->getMaxOutstanding(), g_RawYuvPool->getMaxOutstanding());
+    }
+    checkPoolCap();
+    checkPoolLifetime();
+    g_RawTexture.reset(new ImageTexture());
+    g_RawLastSeq = 0;
+    g_RawLatencyMs = 0.0;
+    g_RawFrames = 0;
+    g_RawAnalyzed = 0;
+    g_RawAnalysisErrors = 0;
+    g_RawAnalysisRunning = true;
+    g_RawAnalysis = std::thread(rawAnalysisLoop);
+}
+
+static void rawFrame(int frame) {
+    RawFrameRef ref = g_RawPool->acquire(20);
+    if (ref) {
+        uint64_t seq = 0;
+        if (!SyntheticFrameSource::checkPattern(*ref.get(), &seq)) {
+            benchFail("rawcapture frame %d torn", frame);
+        } else if (seq <= g_RawLastSeq) {
+            // 只取最新帧，序号必须递增
+            benchFail("rawcapture frame %d seq %llu after %llu", frame, (unsigned long long) seq,
+                      (unsigned long long) g_RawLastSeq);
+        }
+        g_RawLastSeq = seq;
+        g_RawFrames++;
+        g_RawLatencyMs += (double) (Profiler::nowNs() - ref->timestampNs) / 1e6;
+        if (ref->rowStride[0] == (int32_t) ref->width * 4) {
+            g_RawTexture->setPixels(ImageTexture_RGBA, ref->planes[0], (int) ref->width, (int) ref->height);
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_RawQueueMutex);
+            g_RawQueue.push_back({ref, seq});
+        }
+        g_RawQueueCond.notify_one();
+        // 渲染线程自己也持有 0~1 帧，和分析线程的引用交叉释放
+        g_RawHeld.push_back({std::move(ref), seq});
+    }
+    while (g_RawHeld.size() > (size_t) (frame % 2)) {
+        if (!checkHeld(g_RawHeld.front())) {
+            benchFail("rawcapture frame %llu overwritten while held", (unsigned long long) g_RawHeld.front().seq);
+        }
+        g_RawHeld.pop_front();
+    }
+
+    // YUV 帧取到后立即校验释放
+    RawFrameRef yuv = g_RawYuvPool->acquire(0);
+    if (yuv && (yuv->planeCount != 3 || !SyntheticFrameSource::checkPattern(*yuv.get(), nullptr))) {
+        benchFail("rawcapture yuv frame torn");
+    }
+    yuv.reset();
+
+    RawFramePoolStats stats = g_RawPool->getStats();
+    if (stats.maxOutstanding > RAW_POOL_CAP || g_RawSource->getAcquiredCount() > RAW_MAX_IMAGES) {
+        benchFail("rawcapture outstanding %d (cap %d), source acquired %d", stats.maxOutstanding, RAW_POOL_CAP,
+                  g_RawSource->getAcquiredCount());
+    }
+    benchCounter("raw outstanding", stats.outstanding);
+
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::Begin("RawCapture", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("seq %llu  acquired %llu  released %llu  dropped %llu  outstanding %d",
+                (unsigned long long) g_RawLastSeq, (unsigned long long) stats.acquired,
+                (unsigned long long) stats.released, (unsigned long long) stats.dropped, stats.outstanding);
+    ImGui::Text("produced %llu  replaced %llu  producer dropped %llu  analyzed %d",
+                (unsigned long long) g_RawSource->getProducedCount(),
+                (unsigned long long) g_RawSource->getReplacedCount(),
+                (unsigned long long) g_RawSource->getProducerDroppedCount(), g_RawAnalyzed.load());
+    if (g_RawTexture->getWidth() > 0) {
+        ImGui::Image((ImTextureID) g_RawTexture->getOpenglTexture(), ImVec2(RAW_WIDTH / 2, RAW_HEIGHT / 2));
+    }
+    ImGui::End();
+}
+
+static void rawTeardown() {
+    g_RawHeld.clear();
+    {
+        std::lock_guard<std::mutex> lock(g_RawQueueMutex);
+        g_RawAnalysisRunning = false;
+    }
+    g_RawQueueCond.notify_all();
+    g_RawAnalysis.join();
+
+    RawFramePoolStats stats = g_RawPool->getStats();
+    RawFramePoolStats yuvStats = g_RawYuvPool->getStats();
+    printf("rawcapture       produced %llu replaced %llu producer dropped %llu | pool acquired %llu released %llu"
+           " dropped %llu timeouts %llu max outstanding %d | analyzed %d  latency %.2f ms  yuv %llu\n",
+           (unsigned long long) g_RawSource->getProducedCount(), (unsigned long long) g_RawSource->getReplacedCount(),
+           (unsigned long long) g_RawSource->getProducerDroppedCount(), (unsigned long long) stats.acquired,
+           (unsigned long long) stats.released, (unsigned long long) stats.dropped,
+           (unsigned long long) stats.timeouts, stats.maxOutstanding, g_RawAnalyzed.load(),
+           g_RawFrames > 0 ? g_RawLatencyMs / g_RawFrames : 0.0, (unsigned long long) yuvStats.acquired);
+    if (g_RawAnalysisErrors != 0) {
+        benchFail("rawcapture analysis saw %d overwritten frames", g_RawAnalysisErrors.load());
+    }
+    if (g_RawFrames == 0 || g_RawAnalyzed != g_RawFrames) {
+        benchFail("rawcapture acquired %d frames, analyzed %d", g_RawFrames, g_RawAnalyzed.load());
+    }
+    if (stats.outstanding != 0 || stats.acquired != stats.released || g_RawSource->getAcquiredCount() != 0 ||
+        yuvStats.outstanding != 0 || g_RawYuvSource->getAcquiredCount() != 0) {
+        benchFail("rawcapture leaked frames: outstanding %d acquired %llu released %llu source %d",
+                  stats.outstanding, (unsigned long long) stats.acquired, (unsigned long long) stats.released,
+                  g_RawSource->getAcquiredCount());
+    }
+    g_RawPool.reset();
+    g_RawYuvPool.reset();
+    g_RawSource.reset();
+    g_RawYuvSource.reset();
+    g_RawTexture.reset();
+}
+
+BENCH_SCENE("rawcapture", "synthetic ImageReader source, ref-counted RawFramePool shared with an analysis thread",
+            rawSetup, rawFrame, rawTeardown);
@@ -0,0 +1,223 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 屏幕识别场景(需要 OpenCV: cmake -DBUILD_HEADLESS=ON -DOpenCV_DIR=<opencv build>):
+// 1080p 合成画面上放50个图标，每帧部分图标小幅移动、部分隐藏，每16帧整体换位置(画面切换)；
+// ScreenRecognizer 找全部50个模板，校验每个可见图标的位置(±1像素)、隐藏的图标不误报，
+// 和原图上逐个 matchTemplate 的耗时对比，输出 ROI 命中率、频域相关次数等统计；
+// 每4帧有一帧画面不变，FrameDiff 的结果传给识别器，没有变化的帧和没有变化的图标沿用上一帧结果
+//
+
+#ifdef NATIVE_SURFACE_OPENCV
+
+#include "Bench.h"
+#include "ScreenRecognizer.h"
+#include "Profiler.h"
+#include <opencv2/imgproc.hpp>
+#include <vector>
+#include <string>
+#include <cstdlib>
+
+static const int RECOG_WIDTH = 1920;
+static const int RECOG_HEIGHT = 1080;
+static const int RECOG_TEMPLATES = 50;
+static const int RECOG_CELL = 120;              // 图标放在 120x120 的格子里，格子之间不重叠
+static const int RECOG_BASELINE_TEMPLATES = 10; // 直接 matchTemplate 太慢，只测10个再按50个折算
+
+struct RecogIcon {
+    cv::Mat image;
+    int cell = 0;
+    cv::Point offset;                           // 在格子里的位置
+    bool visible = true;
+};
+
+static ScreenRecognizer *g_Recognizer = nullptr;
+static FrameDiff *g_RecogDiff = nullptr;
+static cv::Mat g_RecogBackground;
+static cv::Mat g_RecogFrame;
+static std::vector<RecogIcon> g_RecogIcons;
+static cv::RNG g_RecogRng(20261019);
+static double g_RecogColdMs = 0.0;
+static double g_RecogBaselineMs = 0.0;          // 每个模板直接 matchTemplate 的耗时
+static double g_RecogTotalMs = 0.0;
+static int g_RecogFrames = 0;
+static int g_RecogErrors = 0;
+
+static cv::Point recogPosition(const RecogIcon &icon) {
+    int columns = RECOG_WIDTH / RECOG_CELL;
+    return cv::Point((icon.cell % columns) * RECOG_CELL, (icon.cell / columns) * RECOG_CELL) + icon.offset;
+}
+
+// 每个图标随机分到不同的格子
+static void recogShuffle() {
+    int cells = (RECOG_WIDTH / RECOG_CELL) * (RECOG_HEIGHT / RECOG_CELL);
+    std::vector<int> order(cells);
+    for (int i = 0; i < cells; i++) {
+        order[i] = i;
+    }
+    for (int i = cells - 1; i > 0; i--) {
+        std::swap(order[i], order[g_RecogRng.uniform(0, i + 1)]);
+    }
+    for (int i = 0; i < RECOG_TEMPLATES; i++) {
+        RecogIcon &icon = g_RecogIcons[i];
+        icon.cell = order[i];
+        icon.offset = cv::Point(g_RecogRng.uniform(0, RECOG_CELL - icon.image.cols + 1),
+                                g_RecogRng.uniform(0, RECOG_CELL - icon.image.rows + 1));
+    }
+}
+
+static void recogCompose() {
+    g_RecogBackground.copyTo(g_RecogFrame);
+    for (RecogIcon &icon: g_RecogIcons) {
+        if (icon.visible) {
+            icon.image.copyTo(g_RecogFrame(cv::Rect(recogPosition(icon), icon.image.size())));
+        }
+    }
+}
+
+static cv::Mat recogMakeIcon(int size) {
+    cv::Mat icon(size, size, CV_8UC3);
+    g_RecogRng.fill(icon, cv::RNG::UNIFORM, cv::Scalar::all(0), cv::Scalar::all(255));
+    cv::GaussianBlur(icon, icon, cv::Size(5, 5), 0);
+    for (int i = 0; i < 4; i++) {
+        cv::Point center(g_RecogRng.uniform(0, size), g_RecogRng.uniform(0, size));
+        cv::Scalar color(g_RecogRng.uniform(0, 256), g_RecogRng.uniform(0, 256), g_RecogRng.uniform(0, 256));
+        if (i % 2 == 0) {
+            cv::circle(icon, center, g_RecogRng.uniform(4, size / 3), color, cv::FILLED);
+        } else {
+            cv::rectangle(icon, center, center + cv::Point(size / 4, size / 5), color, 2);
+        }
+    }
+    return icon;
+}
+
+// 和预期位置比较: 可见的要找到且误差不超过1像素，隐藏的不能找到
+static void recogCheck(const std::vector<ScreenMatch> &matches, int frame) {
+    if ((int) matches.size() != RECOG_TEMPLATES) {
+        benchFail("recognizer frame %d: %zu results", frame, matches.size());
+        g_RecogErrors++;
+        return;
+    }
+    for (int i = 0; i < RECOG_TEMPLATES; i++) {
+        const RecogIcon &icon = g_RecogIcons[i];
+        const ScreenMatch &match = matches[i];
+        cv::Point expected = recogPosition(icon);
+        bool ok = icon.visible ? match.found && std::abs(match.rect.x - expected.x) <= 1 &&
+                                 std::abs(match.rect.y - expected.y) <= 1 : !match.found;
+        if (!ok) {
+            if (g_RecogErrors < 5) {
+                benchFail("recognizer frame %d: %s visible %d found %d at (%d,%d) score %.3f, expected (%d,%d)",
+                          frame, match.name.c_str(), icon.visible, match.found, match.rect.x, match.rect.y,
+                          match.score, expected.x, expected.y);
+            }
+            g_RecogErrors++;
+        }
+    }
+}
+
+static void recogSetup() {
+    // 界面背景: 模糊的噪声纹理加上网格线
+    g_RecogBackground.create(RECOG_HEIGHT, RECOG_WIDTH, CV_8UC3);
+    g_RecogRng.fill(g_RecogBackground, cv::RNG::UNIFORM, cv::Scalar::all(40), cv::Scalar::all(200));
+    cv::GaussianBlur(g_RecogBackground, g_RecogBackground, cv::Size(15, 15), 0);
+    for (int x = 0; x < RECOG_WIDTH; x += 64) {
+        cv::line(g_RecogBackground, cv::Point(x, 0), cv::Point(x, RECOG_HEIGHT), cv::Scalar(90, 90, 90), 1);
+    }
+    g_RecogIcons.assign(RECOG_TEMPLATES, RecogIcon());
+    ScreenRecognizerOptions options;
+    g_Recognizer = new ScreenRecognizer(options);
+    for (int i = 0; i < RECOG_TEMPLATES; i++) {
+        g_RecogIcons[i].image = recogMakeIcon(g_RecogRng.uniform(40, 97));
+        if (g_Recognizer->addTemplate("icon" + std::to_string(i), g_RecogIcons[i].image) != i) {
+            benchFail("recognizer: template %d rejected", i);
+        }
+    }
+    recogShuffle();
+    recogCompose();
+
+    // 对照: 原图上逐个 matchTemplate
+    cv::Mat gray;
+    ScreenRecognizer::toGray(g_RecogFrame, gray);
+    int64_t start = Profiler::nowNs();
+    for (int i = 0; i < RECOG_BASELINE_TEMPLATES; i++) {
+        cv::Mat templGray;
+        ScreenRecognizer::toGray(g_RecogIcons[i].image, templGray);
+        ScreenMatch match = ScreenRecognizer::matchFull(gray, templGray);
+        if (match.rect.tl() != recogPosition(g_RecogIcons[i])) {
+            benchFail("recognizer baseline: icon%d at (%d,%d)", i, match.rect.x, match.rect.y);
+        }
+    }
+    g_RecogBaselineMs = (double) (Profiler::nowNs() - start) / 1e6 / RECOG_BASELINE_TEMPLATES;
+
+    // 冷启动: 没有上一帧的位置，全部全图粗到细搜索
+    g_RecogColdMs = 0.0;
+    g_RecogDiff = new FrameDiff();
+    const FrameDiffResult &diff = g_RecogDiff->update(g_RecogFrame.data, (int) g_RecogFrame.step, g_RecogFrame.cols,
+                                                      g_RecogFrame.rows, 3);
+    recogCheck(g_Recognizer->recognize(g_RecogFrame, &diff), -1);
+    g_RecogColdMs = g_Recognizer->getStats().lastTotalMs;
+    g_RecogTotalMs = 0.0;
+    g_RecogFrames = 0;
+    g_RecogErrors = 0;
+}
+
+static void recogFrame(int frame) {
+    if (frame % 16 == 8) {
+        // 画面切换: 所有图标换位置
+        recogShuffle();
+    }
+    // 每4帧有一帧和上一帧相同
+    for (int i = 0; i < RECOG_TEMPLATES && frame % 4 != 2; i++) {
+        RecogIcon &icon = g_RecogIcons[i];
+        // 每帧五分之一的图标在格子里移动几个像素，十分之一的图标隔帧隐藏
+        if (i % 5 == frame % 5) {
+            int maxX = RECOG_CELL - icon.image.cols, maxY = RECOG_CELL - icon.image.rows;
+            icon.offset.x = std::min(maxX, std::max(0, icon.offset.x + g_RecogRng.uniform(-6, 7)));
+            icon.offset.y = std::min(maxY, std::max(0, icon.offset.y + g_RecogRng.uniform(-6, 7)));
+        }
+        icon.visible = i % 10 != 3 || frame % 2 == 0;
+    }
+    recogCompose();
+    const FrameDiffResult &diff = g_RecogDiff->update(g_RecogFrame.data, (int) g_RecogFrame.step, g_RecogFrame.cols,
+                                                      g_RecogFrame.rows, 3);
+    const std::vector<ScreenMatch> &matches = g_Recognizer->recognize(g_RecogFrame, &diff);
+    ScreenRecognizerStats stats = g_Recognizer->getStats();
+    recogCheck(matches, frame);
+    g_RecogTotalMs += stats.lastTotalMs;
+    g_RecogFrames++;
+    benchCounter("recognize ms", stats.lastTotalMs);
+    benchCounter("recognize coarse ms", stats.lastCoarseMs);
+    benchCounter("recognize refine ms", stats.lastRefineMs);
+    benchCounter("framediff ms", g_RecogDiff->getStats().lastMs);
+}
+
+static void recogTeardown() {
+    ScreenRecognizerStats stats = g_Recognizer->getStats();
+    double average = g_RecogFrames > 0 ? g_RecogTotalMs / g_RecogFrames : 0.0;
+    printf("recognizer       %d templates on %dx%d: matchTemplate %.1f ms/template (%.0f ms for all) | "
+           "cold %.1f ms | tracked %.2f ms/frame (x%.0f)\n", RECOG_TEMPLATES, RECOG_WIDTH, RECOG_HEIGHT,
+           g_RecogBaselineMs, g_RecogBaselineMs * RECOG_TEMPLATES, g_RecogColdMs, average,
+           average > 0 ? g_RecogBaselineMs * RECOG_TEMPLATES / average : 0.0);
+    printf("recognizer       still %llu, roi %llu/%llu hits, full searches %llu, fft correlations %llu, frame spectra %llu,"
+           " refinements %llu, errors %d\n", (unsigned long long) stats.stillHits, (unsigned long long) stats.roiHits,
+           (unsigned long long) stats.roiSearches, (unsigned long long) stats.fullSearches,
+           (unsigned long long) stats.fftCorrelations, (unsigned long long) stats.frameSpectra,
+           (unsigned long long) stats.refinements, g_RecogErrors);
+    printf("recognizer       framediff: %llu unchanged frames skipped, %llu unchanged icons reused\n",
+           (unsigned long long) stats.skippedFrames, (unsigned long long) stats.unchangedHits);
+    if (g_RecogFrames >= 4 && (stats.skippedFrames == 0 || stats.unchangedHits == 0)) {
+        benchFail("recognizer: framediff did not skip any work");
+    }
+    delete g_Recognizer;
+    g_Recognizer = nullptr;
+    delete g_RecogDiff;
+    g_RecogDiff = nullptr;
+    g_RecogIcons.clear();
+    g_RecogFrame.release();
+    g_RecogBackground.release();
+}
+
+BENCH_SCENE("recognizer", "50 icon templates on 1080p frames: pyramid + batched FFT + ROI tracking vs matchTemplate",
+            recogSetup, recogFrame, recogTeardown);
+
+#endif
@@ -0,0 +1,186 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 录屏投影场景: computeRecordProjection(record_config.h) 的固定用例(全屏/指定输出大小/裁剪+缩放/越界裁剪/旋转)
+// 和随机参数的不变量(采集区域在屏幕内、输出区域在画面内且保持宽高比、自动输出大小为偶数)，每帧画出一个用例的映射
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "native_surface/record_config.h"
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+
+static const uint32_t PROJ_DISPLAY_WIDTH = 1080;
+static const uint32_t PROJ_DISPLAY_HEIGHT = 2400;
+static const int PROJ_RANDOM_CASES = 100000;
+
+struct ProjCase {
+    const char *name;
+    RecordConfig config;
+    bool rotate;
+    bool valid;
+    RecordRect layerStackRect;
+    RecordRect displayRect;
+    uint32_t videoWidth;
+    uint32_t videoHeight;
+};
+
+static std::vector<ProjCase> g_ProjCases;
+
+static RecordConfig projConfig(uint32_t videoWidth, uint32_t videoHeight, int32_t x, int32_t y, int32_t w, int32_t h,
+                               float scale) {
+    RecordConfig config;
+    config.videoWidth = videoWidth;
+    config.videoHeight = videoHeight;
+    config.cropX = x;
+    config.cropY = y;
+    config.cropWidth = w;
+    config.cropHeight = h;
+    config.scale = scale;
+    return config;
+}
+
+static bool sameRect(const RecordRect &a, const RecordRect &b) {
+    return a.left == b.left && a.top == b.top && a.right == b.right && a.bottom == b.bottom;
+}
+
+static void checkCase(const ProjCase &test) {
+    RecordProjection projection{};
+    bool valid = computeRecordProjection(test.config, PROJ_DISPLAY_WIDTH, PROJ_DISPLAY_HEIGHT, test.rotate,
+                                         &projection);
+    if (valid != test.valid) {
+        benchFail("recordproj %s returned %d", test.name, valid);
+        return;
+    }
+    if (!valid) {
+        return;
+    }
+    if (!sameRect(projection.layerStackRect, test.layerStackRect) ||
+        !sameRect(projection.displayRect, test.displayRect) || projection.videoWidth != test.videoWidth ||
+        projection.videoHeight != test.videoHeight) {
+        const RecordRect &l = projection.layerStackRect, &d = projection.displayRect;
+        benchFail("recordproj %s: crop (%d,%d)-(%d,%d) out (%d,%d)-(%d,%d) video %ux%u", test.name, l.left, l.top,
+                  l.right, l.bottom, d.left, d.top, d.right, d.bottom, projection.videoWidth, projection.videoHeight);
+    }
+}
+
+// 随机参数只校验不变量
+static void checkRandom() {
+    srand(42);
+    int valid = 0;
+    for (int i = 0; i < PROJ_RANDOM_CASES; i++) {
+        RecordConfig config;
+        config.cropX = rand() % 1400 - 200;
+        config.cropY = rand() % 2800 - 200;
+        config.cropWidth = rand() % 4 == 0 ? 0 : rand() % 1200;
+        config.cropHeight = rand() % 4 == 0 ? 0 : rand() % 2600;
+        config.scale = rand() % 3 == 0 ? 1.0f : 0.05f + (float) (rand() % 200) / 100.0f;
+        if (rand() % 3 == 0) {
+            config.videoWidth = 2 + rand() % 1920;
+            config.videoHeight = 2 + rand() % 1920;
+        }
+        bool rotate = rand() % 4 == 0;
+        RecordProjection projection{};
+        if (!computeRecordProjection(config, PROJ_DISPLAY_WIDTH, PROJ_DISPLAY_HEIGHT, rotate, &projection)) {
+            continue;
+        }
+        valid++;
+        const RecordRect &l = projection.layerStackRect, &d = projection.displayRect;
+        uint32_t fitWidth = rotate ? projection.videoHeight : projection.videoWidth;
+        uint32_t fitHeight = rotate ? projection.videoWidth : projection.videoHeight;
+        // 保持宽高比: 推导出的一边只有四舍五入的误差(被限制到1像素的极端情况除外)
+        int64_t cropWidth = l.right - l.left, cropHeight = l.bottom - l.top;
+        int64_t outWidth = d.right - d.left, outHeight = d.bottom - d.top;
+        bool aspect = llabs(outHeight * cropWidth - outWidth * cropHeight) <= std::max(cropWidth, cropHeight) / 2 ||
+                      outWidth == 1 || outHeight == 1;
+        bool ok = l.left >= 0 && l.top >= 0 && l.right <= (int32_t) PROJ_DISPLAY_WIDTH &&
+                  l.bottom <= (int32_t) PROJ_DISPLAY_HEIGHT && l.right - l.left >= 2 && l.bottom - l.top >= 2 &&
+                  d.left >= 0 && d.top >= 0 && d.right <= (int32_t) fitWidth && d.bottom <= (int32_t) fitHeight &&
+                  d.right > d.left && d.bottom > d.top && aspect &&
+                  // 居中，并且至少一边填满
+                  abs((d.left + d.right) - (int32_t) fitWidth) <= 1 &&
+                  abs((d.top + d.bottom) - (int32_t) fitHeight) <= 1 &&
+                  (d.right - d.left == (int32_t) fitWidth || d.bottom - d.top == (int32_t) fitHeight);
+        if (config.videoWidth == 0 && (projection.videoWidth % 2 != 0 || projection.videoHeight % 2 != 0)) {
+            ok = false;
+        }
+        if (!ok) {
+            benchFail("recordproj random %d: crop %d,%d %dx%d scale %.2f video %ux%u rotate %d -> "
+                      "(%d,%d)-(%d,%d) out (%d,%d)-(%d,%d) video %ux%u", i, config.cropX, config.cropY,
+                      config.cropWidth, config.cropHeight, config.scale, config.videoWidth, config.videoHeight,
+                      rotate, l.left, l.top, l.right, l.bottom, d.left, d.top, d.right, d.bottom,
+                      projection.videoWidth, projection.videoHeight);
+            return;
+        }
+    }
+    printf("recordproj       %d random configs, %d inside the display\n", PROJ_RANDOM_CASES, valid);
+}
+
+static void projSetup() {
+    g_ProjCases = {
+            // 默认: 整个屏幕，输出等于屏幕大小
+            {"full", projConfig(0, 0, 0, 0, 0, 0, 1.0f), false, true,
+                    {0, 0, 1080, 2400}, {0, 0, 1080, 2400}, 1080, 2400},
+            // 原来的 initRecord(720, 1280): 保持宽高比居中
+            {"720x1280", projConfig(720, 1280, 0, 0, 0, 0, 1.0f), false, true,
+                    {0, 0, 1080, 2400}, {72, 0, 648, 1280}, 720, 1280},
+            // 小地图: 左上角 540x540 缩小一半
+            {"minimap", projConfig(0, 0, 100, 200, 540, 540, 0.5f), false, true,
+                    {100, 200, 640, 740}, {0, 0, 270, 270}, 270, 270},
+            // 四分之一分辨率
+            {"quarter", projConfig(0, 0, 0, 0, 0, 0, 0.25f), false, true,
+                    {0, 0, 1080, 2400}, {0, 0, 270, 600}, 270, 600},
+            // 超出屏幕的部分被裁掉
+            {"clamped", projConfig(0, 0, 900, 2300, 400, 400, 1.0f), false, true,
+                    {900, 2300, 1080, 2400}, {0, 0, 180, 100}, 180, 100},
+            // 奇数宽高向下取偶数，输出区域保持宽高比
+            {"odd", projConfig(0, 0, 0, 0, 333, 333, 1.0f), false, true,
+                    {0, 0, 333, 333}, {0, 0, 332, 332}, 332, 332},
+            // 旋转: 输出宽高互换，投影矩形在旋转前解释
+            {"rotate", projConfig(0, 0, 0, 0, 0, 0, 0.5f), true, true,
+                    {0, 0, 1080, 2400}, {0, 0, 540, 1200}, 1200, 540},
+            {"outside", projConfig(0, 0, 1100, 0, 100, 100, 1.0f), false, false, {}, {}, 0, 0},
+            {"tiny", projConfig(0, 0, 10, 10, 1, 1, 1.0f), false, false, {}, {}, 0, 0},
+    };
+    for (const ProjCase &test: g_ProjCases) {
+        checkCase(test);
+    }
+    checkRandom();
+}
+
+static void projFrame(int frame) {
+    const ProjCase &test = g_ProjCases[frame % g_ProjCases.size()];
+    RecordProjection projection{};
+    bool valid = computeRecordProjection(test.config, PROJ_DISPLAY_WIDTH, PROJ_DISPLAY_HEIGHT, test.rotate,
+                                         &projection);
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(1000, 900), ImGuiCond_Always);
+    ImGui::Begin("RecordProjection", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    ImGui::Text("%s  valid %d  video %ux%u", test.name, valid, projection.videoWidth, projection.videoHeight);
+    // 左边是屏幕和采集区域，右边是输出画面和内容区域(缩小到 1/3)
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    const float s = 1.0f / 3.0f;
+    drawList->AddRect(origin, ImVec2(origin.x + PROJ_DISPLAY_WIDTH * s, origin.y + PROJ_DISPLAY_HEIGHT * s),
+                      IM_COL32(200, 200, 200, 255));
+    if (valid) {
+        const RecordRect &l = projection.layerStackRect, &d = projection.displayRect;
+        drawList->AddRectFilled(ImVec2(origin.x + l.left * s, origin.y + l.top * s),
+                                ImVec2(origin.x + l.right * s, origin.y + l.bottom * s), IM_COL32(80, 160, 255, 120));
+        ImVec2 out(origin.x + PROJ_DISPLAY_WIDTH * s + 40, origin.y);
+        drawList->AddRect(out, ImVec2(out.x + projection.videoWidth * s, out.y + projection.videoHeight * s),
+                          IM_COL32(200, 200, 200, 255));
+        drawList->AddRectFilled(ImVec2(out.x + d.left * s, out.y + d.top * s),
+                                ImVec2(out.x + d.right * s, out.y + d.bottom * s), IM_COL32(255, 160, 80, 120));
+    }
+    ImGui::End();
+}
+
+static void projTeardown() {
+    g_ProjCases.clear();
+}
+
+BENCH_SCENE("recordproj", "record crop/scale/rotate projection math: fixed cases, random invariants and a preview",
+            projSetup, projFrame, projTeardown);
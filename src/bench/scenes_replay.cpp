@@ -0,0 +1,169 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 会话回放场景: 生成合成会话(脏块包 LZ4 压缩 + 拖动手势 + 旋转)，按接收端的逻辑最快速度回放，
+// 校验画布和最后一帧一致、触摸换算出的位置和分发次数、屏幕信息变化；截断的文件报告为损坏；
+// 按2倍速回放时总耗时不少于录制时长的一半；输出回放报告，每帧显示回放结果的纹理
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "SessionReplay.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <memory>
+#include <unistd.h>
+
+static const int RP_WIDTH = 320;
+static const int RP_HEIGHT = 480;
+static const int RP_FRAMES = 48;
+
+static std::unique_ptr<SessionReplay> g_RpReplay;
+static SessionReplayReport g_RpReport;
+static std::string g_RpPath;
+
+static bool rpTempPath(std::string &path, const char *suffix) {
+    char name[] = "/tmp/nsreplayXXXXXX";
+    int fd = mkstemp(name);
+    if (fd < 0) {
+        return false;
+    }
+    close(fd);
+    unlink(name);
+    path = std::string(name) + suffix;
+    return true;
+}
+
+// 复制会话文件并去掉最后 cut 字节，模拟录制被打断
+static bool rpTruncate(const std::string &from, const std::string &to, long cut) {
+    FILE *in = fopen(from.c_str(), "rb");
+    if (in == nullptr) {
+        return false;
+    }
+    std::vector<char> data;
+    char buffer[65536];
+    size_t got;
+    while ((got = fread(buffer, 1, sizeof(buffer), in)) > 0) {
+        data.insert(data.end(), buffer, buffer + got);
+    }
+    fclose(in);
+    FILE *out = fopen(to.c_str(), "wb");
+    if (out == nullptr || (long) data.size() <= cut) {
+        if (out != nullptr) {
+            fclose(out);
+        }
+        return false;
+    }
+    fwrite(data.data(), 1, data.size() - (size_t) cut, out);
+    fclose(out);
+    return true;
+}
+
+static void rpSetup() {
+    SyntheticSessionConfig config;
+    config.width = RP_WIDTH;
+    config.height = RP_HEIGHT;
+    config.frames = RP_FRAMES;
+    config.codec = Compress_Lz4;
+    config.rotate = true;
+    std::vector<uint8_t> lastFrame;
+    if (!rpTempPath(g_RpPath, ".nss") || !SessionReplay::writeSynthetic(g_RpPath.c_str(), config, &lastFrame)) {
+        benchFail("replay: cannot write synthetic session");
+        return;
+    }
+    g_RpReplay.reset(new SessionReplay());
+    if (!g_RpReplay->run(g_RpPath.c_str(), g_RpReport)) {
+        benchFail("replay: run failed");
+        return;
+    }
+    const RecordReceiverStats &r = g_RpReport.receiver;
+    if (g_RpReport.frames != RP_FRAMES || r.packets != RP_FRAMES || r.errors != 0 || g_RpReport.corrupt ||
+        r.tilesPackets + r.unchangedPackets != RP_FRAMES || r.unchangedPackets == 0) {
+        benchFail("replay: frames %llu packets %llu tiles %llu unchanged %llu errors %llu",
+                  (unsigned long long) g_RpReport.frames, (unsigned long long) r.packets,
+                  (unsigned long long) r.tilesPackets, (unsigned long long) r.unchangedPackets,
+                  (unsigned long long) r.errors);
+    }
+    // 画布是脏块逐帧拼出来的，必须和发送端最后一帧完全一致
+    FrameBufferRef canvas = g_RpReplay->getReceiver().getCanvas();
+    bool same = canvas && canvas->width == RP_WIDTH && canvas->height == RP_HEIGHT;
+    for (int y = 0; same && y < RP_HEIGHT; y++) {
+        same = memcmp(canvas->planes[0] + (size_t) y * canvas->strides[0],
+                      lastFrame.data() + (size_t) y * RP_WIDTH * 4, RP_WIDTH * 4) == 0;
+    }
+    if (!same) {
+        benchFail("replay: canvas differs from the last sent frame");
+    }
+    // 拖动: 按下、每帧移动、抬起(见 SessionReplay::writeSynthetic)
+    int downFrame = std::min(4, RP_FRAMES / 4), upFrame = RP_FRAMES - 1 - downFrame;
+    if (g_RpReport.touchDispatched != (uint64_t) (upFrame - downFrame + 1) || g_RpReport.displayChanges != 1) {
+        benchFail("replay: touch dispatched %llu (expected %d) display changes %llu",
+                  (unsigned long long) g_RpReport.touchDispatched, upFrame - downFrame + 1,
+                  (unsigned long long) g_RpReport.displayChanges);
+    }
+    // 旋转之后(方向1)触摸屏的 (x, y) 换算成 (y, 范围 - x)，宽高交换
+    ImGuInputEvent touch{};
+    int range = 10000;
+    float lastX = (float) (range / 5 + (range * 3 / 5) * (upFrame - 1 - downFrame) / (upFrame - downFrame));
+    ImVec2 expected((float) (range / 2) * RP_WIDTH / (float) range,
+                    ((float) range - lastX) * RP_HEIGHT / (float) range);
+    if (!g_RpReplay->getLastTouch(touch) || touch.type != IM_UP || std::fabs(touch.pos.x - expected.x) > 0.5f ||
+        std::fabs(touch.pos.y - expected.y) > 0.5f) {
+        benchFail("replay: last touch %d (%.1f, %.1f) expected up (%.1f, %.1f)", touch.type, touch.pos.x, touch.pos.y,
+                  expected.x, expected.y);
+    }
+    SessionReplay::printReport(g_RpReport);
+
+    // 截断的文件: 前面的记录照常回放，报告为损坏
+    std::string truncated = g_RpPath + ".cut";
+    SessionReplayReport cutReport;
+    SessionReplayOptions fast;
+    fast.render = false;
+    SessionReplay cutReplay(fast);
+    if (!rpTruncate(g_RpPath, truncated, 7) || !cutReplay.run(truncated.c_str(), cutReport) || !cutReport.corrupt ||
+        cutReport.frames == 0) {
+        benchFail("replay: truncated session not reported (frames %llu)", (unsigned long long) cutReport.frames);
+    }
+    unlink(truncated.c_str());
+
+    // 2倍速回放按录制的时间等待
+    SessionReplayOptions paced;
+    paced.speed = 2.0;
+    paced.render = false;
+    SessionReplay pacedReplay(paced);
+    SessionReplayReport pacedReport;
+    if (!pacedReplay.run(g_RpPath.c_str(), pacedReport) || pacedReport.wallMs < pacedReport.sessionMs / 2.0 * 0.95) {
+        benchFail("replay: 2x replay took %.1f ms for %.1f ms session", pacedReport.wallMs, pacedReport.sessionMs);
+    }
+}
+
+static void rpFrame(int) {
+    if (!g_RpReplay) {
+        return;
+    }
+    for (const ReplayStageStats &stage: g_RpReport.stages) {
+        if (stage.name == "decompress" || stage.name == "decode" || stage.name == "render") {
+            benchCounter((stage.name + " p99 ms").c_str(), stage.p99Ms);
+        }
+    }
+    ImageTexture &texture = g_RpReplay->getReceiver().getTexture();
+    ImGui::SetNextWindowPos(ImVec2(0, 100), ImGuiCond_Always);
+    ImGui::Begin("Replay", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+    ImGui::Text("%llu frames %.1f fps", (unsigned long long) g_RpReport.frames, g_RpReport.fps);
+    ImGui::Image((ImTextureID) texture.getOpenglTexture(), ImVec2((float) texture.getWidth(),
+                                                                  (float) texture.getHeight()));
+    ImGui::End();
+}
+
+static void rpTeardown() {
+    g_RpReplay.reset();
+    if (!g_RpPath.empty()) {
+        unlink(g_RpPath.c_str());
+        g_RpPath.clear();
+    }
+}
+
+BENCH_SCENE("replay", "session replay: synthetic tiles+touch session, canvas/touch checks, truncation, paced replay",
+            rpSetup, rpFrame, rpTeardown);
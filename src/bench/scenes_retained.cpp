@@ -0,0 +1,73 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 50个静态HUD窗口，对比普通提交与 SetNextWindowRetained 复用顶点
+//
+
+#include "Bench.h"
+#include "draw.h"
+
+static const int HUD_WINDOWS = 50;
+static const int HUD_COLUMNS = 5;
+
+struct HudValues {
+    int hp;
+    int ammo;
+    float progress;
+    float history[32];
+};
+
+static HudValues g_HudValues[HUD_WINDOWS];
+
+static void hudSetup() {
+    for (int i = 0; i < HUD_WINDOWS; i++) {
+        HudValues &values = g_HudValues[i];
+        values.hp = 100 - i;
+        values.ammo = 30 + i;
+        values.progress = (float) i / HUD_WINDOWS;
+        for (int n = 0; n < IM_ARRAYSIZE(values.history); n++) {
+            values.history[n] = (float) ((n * 7 + i * 13) % 32) / 32.0f;
+        }
+    }
+}
+
+static void hudWindows(int frame, bool retained) {
+    ImVec2 display = ImGui::GetIO().DisplaySize;
+    ImVec2 size(display.x / HUD_COLUMNS, display.y / (HUD_WINDOWS / HUD_COLUMNS));
+    // 每秒只有一个窗口的数据变化
+    if (frame % 60 == 0) {
+        g_HudValues[(frame / 60) % HUD_WINDOWS].ammo++;
+    }
+    for (int i = 0; i < HUD_WINDOWS; i++) {
+        const HudValues &values = g_HudValues[i];
+        char name[32];
+        snprintf(name, sizeof(name), "hud_%02d", i);
+        ImGui::SetNextWindowPos(ImVec2(size.x * (float) (i % HUD_COLUMNS), size.y * (float) (i / HUD_COLUMNS)),
+                                ImGuiCond_Always);
+        ImGui::SetNextWindowSize(size, ImGuiCond_Always);
+        if (retained) {
+            ImGui::SetNextWindowRetained(ImHashData(&values, sizeof(values)));
+        }
+        if (ImGui::Begin(name, nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoInputs)) {
+            ImGui::Text("HP   %d", values.hp);
+            ImGui::Text("AMMO %d", values.ammo);
+            ImGui::ProgressBar(values.progress);
+            ImGui::PlotLines("##history", values.history, IM_ARRAYSIZE(values.history));
+            ImGui::Separator();
+            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.2f, 1.0f), "target %d m", values.hp * 3);
+        }
+        ImGui::End();
+    }
+}
+
+static void hudImmediateFrame(int frame) {
+    hudWindows(frame, false);
+}
+
+static void hudRetainedFrame(int frame) {
+    hudWindows(frame, true);
+    benchCounter("retained windows", ImGui::GetIO().MetricsRetainedWindows);
+}
+
+BENCH_SCENE("hud50", "50 static HUD windows, immediate", hudSetup, hudImmediateFrame, nullptr);
+BENCH_SCENE("hud50_retained", "50 static HUD windows, SetNextWindowRetained", hudSetup, hudRetainedFrame, nullptr);
@@ -0,0 +1,207 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// ImGuiStorage 场景: 10万个key的插入/查询耗时，以及1万个节点的树形列表(每个节点的展开状态都在窗口 StateStorage 里)
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <ctime>
+
+static const int STORAGE_KEYS = 100000;
+static const int TREE_ROOTS = 100;
+static const int TREE_CHILDREN = 100;
+
+// 防止计时循环被优化掉
+static volatile int g_StorageSink;
+
+static double nowUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+// 未开启 IMGUI_USE_HASHED_STORAGE 时 ImGuiStorage 的实现(有序数组 + 二分查找)，作为对比基准
+struct SortedStorage {
+    ImVector<ImGuiStorage::ImGuiStoragePair> data;
+
+    ImGuiStorage::ImGuiStoragePair *lowerBound(ImGuiID key) {
+        ImGuiStorage::ImGuiStoragePair *first = data.Data;
+        size_t count = (size_t) data.Size;
+        while (count > 0) {
+            size_t half = count >> 1;
+            if (first[half].key < key) {
+                first += half + 1;
+                count -= half + 1;
+            } else {
+                count = half;
+            }
+        }
+        return first;
+    }
+
+    int getInt(ImGuiID key, int defaultVal) {
+        ImGuiStorage::ImGuiStoragePair *it = lowerBound(key);
+        return it == data.end() || it->key != key ? defaultVal : it->val_i;
+    }
+
+    void setInt(ImGuiID key, int val) {
+        ImGuiStorage::ImGuiStoragePair *it = lowerBound(key);
+        if (it == data.end() || it->key != key) {
+            data.insert(it, ImGuiStorage::ImGuiStoragePair(key, val));
+            return;
+        }
+        it->val_i = val;
+    }
+};
+
+//---------------------------------------------------------------------------
+// storage100k: 每帧清空后插入10万个key，再分别查询10万个存在/不存在的key
+// 有序数组插入是O(n^2)，只在setup里测一次
+//---------------------------------------------------------------------------
+static std::vector<ImGuiID> g_StorageKeys;
+static std::vector<ImGuiID> g_StorageMissKeys;
+static ImGuiStorage g_Storage;
+
+static void storageSetup() {
+    g_StorageKeys.resize(STORAGE_KEYS);
+    g_StorageMissKeys.resize(STORAGE_KEYS);
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        int miss = i + STORAGE_KEYS;
+        g_StorageKeys[i] = ImHashData(&i, sizeof(i));
+        g_StorageMissKeys[i] = ImHashData(&miss, sizeof(miss));
+    }
+    SortedStorage sorted;
+    double t0 = nowUs();
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        sorted.setInt(g_StorageKeys[i], i);
+    }
+    double t1 = nowUs();
+    int sink = 0;
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        sink += sorted.getInt(g_StorageKeys[i], -1);
+    }
+    double t2 = nowUs();
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        sink += sorted.getInt(g_StorageMissKeys[i], -1);
+    }
+    double t3 = nowUs();
+    g_StorageSink = sink;
+    printf("storage100k      sorted vector: insert %.3f ms lookup %.3f ms miss %.3f ms\n", (t1 - t0) / 1000.0,
+           (t2 - t1) / 1000.0, (t3 - t2) / 1000.0);
+}
+
+static void storageFrame(int frame) {
+    g_Storage.Clear();
+    double t0 = nowUs();
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        g_Storage.SetInt(g_StorageKeys[i], i);
+    }
+    double t1 = nowUs();
+    int sink = 0;
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        sink += g_Storage.GetInt(g_StorageKeys[i], -1);
+    }
+    double t2 = nowUs();
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        sink += g_Storage.GetInt(g_StorageMissKeys[i], -1);
+    }
+    double t3 = nowUs();
+    g_StorageSink = sink;
+    benchCounter("insert us", t1 - t0);
+    benchCounter("lookup us", t2 - t1);
+    benchCounter("miss us", t3 - t2);
+
+    if (frame != 0) {
+        return;
+    }
+    // 校验: 查询结果、Get***Ref、直接写 Data 后 BuildSortByKey
+    for (int i = 0; i < STORAGE_KEYS; i++) {
+        if (g_Storage.GetInt(g_StorageKeys[i], -1) != i || g_Storage.GetInt(g_StorageMissKeys[i], -1) != -1) {
+            benchFail("storage100k lookup key %d", i);
+            break;
+        }
+    }
+    *g_Storage.GetIntRef(g_StorageKeys[7]) = 1234;
+    *g_Storage.GetIntRef(g_StorageMissKeys[7], 5678) += 1;
+    if (g_Storage.GetInt(g_StorageKeys[7]) != 1234 || g_Storage.GetInt(g_StorageMissKeys[7]) != 5679 ||
+        g_Storage.Data.Size != STORAGE_KEYS + 1) {
+        benchFail("storage100k GetIntRef");
+    }
+    ImGuiStorage bulk;
+    for (int i = 0; i < 1000; i++) {
+        bulk.Data.push_back(ImGuiStorage::ImGuiStoragePair(g_StorageKeys[i], i));
+    }
+    bulk.BuildSortByKey();
+    for (int i = 0; i < 1000; i++) {
+        if (bulk.GetInt(g_StorageKeys[i], -1) != i) {
+            benchFail("storage100k BuildSortByKey key %d", i);
+            break;
+        }
+    }
+}
+
+static void storageTeardown() {
+    g_Storage.Clear();
+    g_StorageKeys.clear();
+    g_StorageMissKeys.clear();
+}
+
+BENCH_SCENE("storage100k", "ImGuiStorage insert/lookup of 100k keys (sorted vector measured once in setup)",
+            storageSetup, storageFrame, storageTeardown);
+
+//---------------------------------------------------------------------------
+// tree10k: 100个根节点 x 100个子节点，全部展开，窗口 StateStorage 里约1万个展开状态
+//---------------------------------------------------------------------------
+static void treeFrame(int) {
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("tree10k", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    char label[32];
+    for (int root = 0; root < TREE_ROOTS; root++) {
+        snprintf(label, sizeof(label), "Node %d", root);
+        ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+        if (!ImGui::TreeNode(label)) {
+            continue;
+        }
+        for (int child = 0; child < TREE_CHILDREN; child++) {
+            snprintf(label, sizeof(label), "Item %d", child);
+            ImGui::SetNextItemOpen(true, ImGuiCond_Once);
+            if (ImGui::TreeNode(label)) {
+                ImGui::TreePop();
+            }
+        }
+        ImGui::TreePop();
+    }
+
+    // 同一组展开状态的查询耗时: ImGuiStorage 对比有序数组
+    ImGuiStorage *storage = ImGui::GetStateStorage();
+    static SortedStorage sorted;
+    if (sorted.data.Size != storage->Data.Size) {
+        sorted.data = storage->Data;
+        qsort(sorted.data.Data, (size_t) sorted.data.Size, sizeof(ImGuiStorage::ImGuiStoragePair),
+              [](const void *a, const void *b) {
+                  ImGuiID ka = ((const ImGuiStorage::ImGuiStoragePair *) a)->key;
+                  ImGuiID kb = ((const ImGuiStorage::ImGuiStoragePair *) b)->key;
+                  return ka < kb ? -1 : ka > kb ? 1 : 0;
+              });
+    }
+    int sink = 0;
+    double t0 = nowUs();
+    for (const ImGuiStorage::ImGuiStoragePair &pair: storage->Data) {
+        sink += storage->GetInt(pair.key);
+    }
+    double t1 = nowUs();
+    for (const ImGuiStorage::ImGuiStoragePair &pair: storage->Data) {
+        sink += sorted.getInt(pair.key, 0);
+    }
+    double t2 = nowUs();
+    g_StorageSink = sink;
+    benchCounter("storage entries", storage->Data.Size);
+    benchCounter("storage lookup us", t1 - t0);
+    benchCounter("sorted lookup us", t2 - t1);
+    ImGui::End();
+}
+
+BENCH_SCENE("tree10k", "10k open tree nodes, per-frame TreeNode state lookups", nullptr, treeFrame, nullptr);
@@ -0,0 +1,175 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 百万行表格场景: 通过 ImGuiTableDataSource 提供数据，表格缓存排序/过滤后的行顺序，每帧只提交可见行
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <algorithm>
+#include <ctime>
+
+static const int TABLE_ROWS = 1000000;
+
+// 模拟收到的帧记录
+struct FrameRecord {
+    int frame;
+    float timeMs;
+    int size;
+    int type;
+};
+
+static const char *g_FrameTypes[] = {"I", "P", "B", "touch"};
+static std::vector<FrameRecord> g_Records;
+static bool g_RecordsFilterKeyFrames = false;
+static ImU32 g_RecordsVersion = 0;
+
+static double nowMs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000.0 + (double) ts.tv_nsec / 1000000.0;
+}
+
+static int compareRecords(void *, const ImGuiTableColumnSortSpecs *spec, int rowA, int rowB) {
+    const FrameRecord &a = g_Records[rowA];
+    const FrameRecord &b = g_Records[rowB];
+    switch (spec->ColumnIndex) {
+        case 1:
+            return a.timeMs < b.timeMs ? -1 : a.timeMs > b.timeMs ? 1 : 0;
+        case 2:
+            return a.size - b.size;
+        case 3:
+            return a.type - b.type;
+        default:
+            return a.frame - b.frame;
+    }
+}
+
+static bool filterRecord(void *, int row) {
+    return !g_RecordsFilterKeyFrames || g_Records[row].type == 0;
+}
+
+static void submitRecord(void *, int row) {
+    const FrameRecord &record = g_Records[row];
+    ImGui::TableSetColumnIndex(0);
+    ImGui::Text("%d", record.frame);
+    ImGui::TableSetColumnIndex(1);
+    ImGui::Text("%.3f", record.timeMs);
+    ImGui::TableSetColumnIndex(2);
+    ImGui::Text("%d", record.size);
+    ImGui::TableSetColumnIndex(3);
+    ImGui::TextUnformatted(g_FrameTypes[record.type]);
+}
+
+static void tableSetup() {
+    g_Records.resize(TABLE_ROWS);
+    uint32_t seed = 1;
+    for (int i = 0; i < TABLE_ROWS; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        g_Records[i] = {i, (float) i * 16.6f + (float) (seed >> 28), (int) (seed >> 12) % 200000,
+                        i % 30 == 0 ? 0 : (int) (seed >> 8) % 4};
+    }
+    g_RecordsFilterKeyFrames = false;
+    g_RecordsVersion++;
+
+    // 对比: 调用方每帧自己排序整个数据集(按大小列)
+    std::vector<int> order(TABLE_ROWS);
+    for (int i = 0; i < TABLE_ROWS; i++) {
+        order[i] = i;
+    }
+    double t0 = nowMs();
+    std::stable_sort(order.begin(), order.end(), [](int a, int b) {
+        return g_Records[a].size < g_Records[b].size;
+    });
+    printf("table1m          caller side sort of %d rows: %.3f ms/frame\n", TABLE_ROWS, nowMs() - t0);
+}
+
+// 校验缓存的行顺序: 过滤结果和相邻行的排序关系
+static void checkRows(int count) {
+    ImGuiTableSortSpecs *specs = ImGui::TableGetSortSpecs();
+    int expected = 0;
+    for (int row = 0; row < TABLE_ROWS; row++) {
+        expected += filterRecord(nullptr, row) ? 1 : 0;
+    }
+    if (count != expected) {
+        benchFail("table1m row count %d, expected %d", count, expected);
+        return;
+    }
+    for (int n = 1; n < count; n++) {
+        int a = ImGui::TableGetDataSourceRow(n - 1), b = ImGui::TableGetDataSourceRow(n);
+        int c = compareRecords(nullptr, &specs->Specs[0], a, b);
+        if (specs->Specs[0].SortDirection == ImGuiSortDirection_Descending) {
+            c = -c;
+        }
+        if (c > 0 || (c == 0 && a > b)) {
+            benchFail("table1m rows %d/%d out of order", n - 1, n);
+            return;
+        }
+    }
+}
+
+static void tableFrame(int frame) {
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("table1m", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                            ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("records", 4, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Frame", ImGuiTableColumnFlags_DefaultSort);
+        ImGui::TableSetupColumn("Time ms");
+        ImGui::TableSetupColumn("Size");
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableHeadersRow();
+
+        // 模拟用户操作: 每60帧换一个排序列/方向，每120帧切换只看关键帧
+        if (frame % 60 == 0) {
+            int column = (frame / 60) % 4;
+            ImGui::TableSetColumnSortDirection(column, (frame / 240) % 2 == 0 ? ImGuiSortDirection_Ascending
+                                                                               : ImGuiSortDirection_Descending, false);
+        }
+        if (frame % 120 == 119) {
+            g_RecordsFilterKeyFrames = !g_RecordsFilterKeyFrames;
+            g_RecordsVersion++;
+        }
+
+        ImGuiTableDataSource source;
+        source.RowCount = (int) g_Records.size();
+        source.DataVersion = g_RecordsVersion;
+        source.CompareRows = compareRecords;
+        source.FilterRow = filterRecord;
+        source.SubmitRow = submitRecord;
+        ImGuiTable *table = ImGui::GetCurrentTable();
+        bool rebuild = !table->IsDataSourceValid || table->DataSourceVersion != source.DataVersion;
+        if (ImGuiTableSortSpecs *specs = ImGui::TableGetSortSpecs()) {
+            rebuild |= specs->SpecsDirty;
+        }
+        double t0 = nowMs();
+        int count = ImGui::TableSetDataSource(&source);
+        double t1 = nowMs();
+        if (rebuild) {
+            benchCounter("rebuilds", 1);
+            benchCounter("rebuild ms", t1 - t0);
+            checkRows(count);
+        } else {
+            benchCounter("cached ms", t1 - t0);
+        }
+
+        // 模拟滚动
+        ImGui::SetScrollY((float) (frame * 7919 % count) * ImGui::GetTextLineHeightWithSpacing());
+        double t2 = nowMs();
+        ImGui::TableSubmitDataSourceRows(ImGui::GetTextLineHeightWithSpacing());
+        benchCounter("submit ms", nowMs() - t2);
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void tableTeardown() {
+    g_Records.clear();
+    g_Records.shrink_to_fit();
+}
+
+BENCH_SCENE("table1m", "1M rows table through ImGuiTableDataSource (cached sort/filter, visible rows only)", tableSetup,
+            tableFrame, tableTeardown);
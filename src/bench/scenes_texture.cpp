@@ -0,0 +1,283 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 纹理显存场景: 字体图集 RGBA32 与 Alpha8(GL_R8+swizzle) 的显存对比和逐像素一致性，
+// 以及 ImageTexture 压缩格式(ETC2/ASTC)和 BGR/BGRA/GRAY(swizzle)的显存对比和采样结果校验
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include <imgui_internal.h>
+#include <memory>
+#include <cstring>
+#include <cstdlib>
+
+static const int TEXMEM_IMAGE_SIZE = 256;
+static const int TEXMEM_CHECK_FRAMES = 10;
+static const int TEXMEM_SLOT = 130;         // 每张图片占的宽度(9张要放进1080宽的屏幕)
+static const int TEXMEM_DRAW_SIZE = 120;  // 第2帧开始(窗口布局已稳定)校验到这一帧
+
+// 待校验的纹理: 屏幕位置和期望颜色
+struct TexmemImage {
+    std::unique_ptr<ImageTexture> texture;
+    const char *name;
+    ImU32 expected;
+};
+
+static std::vector<TexmemImage> g_TexmemImages;
+static std::unique_ptr<ImageTexture> g_TexmemFontRgba;
+static ImTextureID g_TexmemFontAlpha8;
+static std::vector<uint8_t> g_TexmemAlpha8Pixels;
+static std::vector<uint8_t> g_TexmemPixels;
+
+static void printAtlas(const char *config, ImFontAtlas *atlas, size_t uploaded) {
+    size_t rgba = (size_t) atlas->TexWidth * atlas->TexHeight * 4;
+    size_t alpha8 = (size_t) atlas->TexWidth * atlas->TexHeight;
+    printf("texmem           font %-28s %4dx%-4d RGBA32 %8.1f KB  Alpha8 %8.1f KB", config, atlas->TexWidth,
+           atlas->TexHeight, (double) rgba / 1024.0, (double) alpha8 / 1024.0);
+    if (uploaded != 0) {
+        printf("  uploaded %8.1f KB", (double) uploaded / 1024.0);
+    }
+    printf("\n");
+}
+
+// 其他字体配置只在CPU上构建图集，计算上传后的大小
+static void printAtlasConfig(const char *config, const char *path, float size, const ImWchar *ranges) {
+    ImFontAtlas atlas;
+    ImFontConfig fontConfig;
+    fontConfig.SizePixels = size;
+    ImFont *font = path != nullptr ? atlas.AddFontFromFileTTF(path, size, &fontConfig, ranges)
+                                   : atlas.AddFontDefault(&fontConfig);
+    if (font == nullptr) {
+        return;
+    }
+    unsigned char *pixels;
+    int width, height;
+    atlas.GetTexDataAsAlpha8(&pixels, &width, &height);
+    printAtlas(config, &atlas, 0);
+}
+
+// ETC1/ETC2 individual 模式的纯色块: 每通道4位(x17)，码表0、像素索引0，解码结果 +2
+static void fillEtc2(std::vector<uint8_t> &out, int r4, int g4, int b4) {
+    size_t blocks = (size_t) (TEXMEM_IMAGE_SIZE / 4) * (TEXMEM_IMAGE_SIZE / 4);
+    out.assign(blocks * 8, 0);
+    for (size_t i = 0; i < blocks; i++) {
+        out[i * 8 + 0] = (uint8_t) (r4 << 4 | r4);
+        out[i * 8 + 1] = (uint8_t) (g4 << 4 | g4);
+        out[i * 8 + 2] = (uint8_t) (b4 << 4 | b4);
+    }
+}
+
+// ASTC void-extent 纯色块: 低12位 0xDFC(LDR)，范围全1，高64位为 RGBA UNORM16
+static void fillAstc(std::vector<uint8_t> &out, int blockSize, uint16_t r, uint16_t g, uint16_t b, uint16_t a) {
+    int blocksPerSide = (TEXMEM_IMAGE_SIZE + blockSize - 1) / blockSize;
+    size_t blocks = (size_t) blocksPerSide * blocksPerSide;
+    out.resize(blocks * 16);
+    uint64_t low = 0xFFFFFFFFFFFFFDFCull;
+    uint64_t high = (uint64_t) r | (uint64_t) g << 16 | (uint64_t) b << 32 | (uint64_t) a << 48;
+    for (size_t i = 0; i < blocks; i++) {
+        memcpy(out.data() + i * 16, &low, 8);
+        memcpy(out.data() + i * 16 + 8, &high, 8);
+    }
+}
+
+// 压缩数据包装成 KTX 1.1 / .astc 文件，走 loadCompressed 的解析
+static std::vector<uint8_t> wrapKtx(const std::vector<uint8_t> &blocks, uint32_t internalFormat) {
+    static const uint8_t identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    uint32_t header[13] = {0x04030201, 0, 1, 0, internalFormat, GL_RGB, TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE, 0, 0, 1,
+                           1, 0};
+    uint32_t imageSize = (uint32_t) blocks.size();
+    std::vector<uint8_t> file(identifier, identifier + sizeof(identifier));
+    file.insert(file.end(), (const uint8_t *) header, (const uint8_t *) header + sizeof(header));
+    file.insert(file.end(), (const uint8_t *) &imageSize, (const uint8_t *) &imageSize + 4);
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+static std::vector<uint8_t> wrapAstc(const std::vector<uint8_t> &blocks, int blockSize) {
+    uint8_t header[16] = {0x13, 0xAB, 0xA1, 0x5C, (uint8_t) blockSize, (uint8_t) blockSize, 1,
+                          TEXMEM_IMAGE_SIZE & 0xFF, TEXMEM_IMAGE_SIZE >> 8, 0,
+                          TEXMEM_IMAGE_SIZE & 0xFF, TEXMEM_IMAGE_SIZE >> 8, 0, 1, 0, 0};
+    std::vector<uint8_t> file(header, header + sizeof(header));
+    file.insert(file.end(), blocks.begin(), blocks.end());
+    return file;
+}
+
+static void addImage(const char *name, ImageTextureFormat format, ImageTexture *texture, bool ok, ImU32 expected) {
+    if (!ok) {
+        delete texture;
+        if (ImageTexture::isFormatSupported(format)) {
+            benchFail("texmem %s upload failed", name);
+        }
+        printf("texmem           image %-10s not supported\n", name);
+        return;
+    }
+    printf("texmem           image %-10s %dx%d %8.1f KB\n", name, texture->getWidth(), texture->getHeight(),
+           (double) texture->getMemoryBytes() / 1024.0);
+    g_TexmemImages.push_back({std::unique_ptr<ImageTexture>(texture), name, expected});
+}
+
+static void texmemSetup() {
+    ImGuiIO &io = ImGui::GetIO();
+    // 图层还没画过帧时字体纹理在第一次 NewFrame() 才创建，这里提前创建以便统计和替换 TexID
+    if (io.Fonts->TexID == ImTextureID{}) {
+        ImGui_ImplOpenGL3_CreateDeviceObjects();
+    }
+    printAtlas("layer default 22px", io.Fonts, ImGui_ImplOpenGL3_GetFontsTextureBytes());
+    printAtlasConfig("default 66px", nullptr, 66.0f, nullptr);
+    // 中文字体(对应实际的 ImGui_init 配置)，BENCH_FONT=字体文件路径
+    if (const char *path = getenv("BENCH_FONT")) {
+        printAtlasConfig("BENCH_FONT 40px CJK common", path, 40.0f, io.Fonts->GetGlyphRangesChineseSimplifiedCommon());
+    }
+
+    // 对比用的 RGBA32 字体纹理
+    unsigned char *pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    g_TexmemFontRgba.reset(new ImageTexture());
+    g_TexmemFontRgba->setPixels(ImageTexture_RGBA, pixels, width, height);
+    g_TexmemFontAlpha8 = io.Fonts->TexID;
+
+    // 1024x1024 UI图片在各格式下的显存
+    for (int i = 0; i < ImageTexture_FormatCount; i++) {
+        auto format = (ImageTextureFormat) i;
+        printf("texmem           1024x1024 %-10s %8.1f KB%s\n", ImageTexture::getFormatName(format),
+               (double) ImageTexture::compressedSize(format, 1024, 1024) / 1024.0,
+               ImageTexture::isFormatSupported(format) ? "" : " (not supported)");
+    }
+
+    size_t before = ImageTexture::getTotalMemoryBytes();
+    std::vector<uint8_t> data((size_t) TEXMEM_IMAGE_SIZE * TEXMEM_IMAGE_SIZE * 4);
+    for (size_t i = 0; i < data.size(); i += 4) {
+        data[i] = 40, data[i + 1] = 160, data[i + 2] = 220, data[i + 3] = 255;
+    }
+    auto *rgba = new ImageTexture();
+    bool ok = rgba->setPixels(ImageTexture_RGBA, data.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("RGBA", ImageTexture_RGBA, rgba, ok, IM_COL32(40, 160, 220, 255));
+    for (size_t i = 0; i < data.size() / 4; i++) {
+        data[i * 3] = 250, data[i * 3 + 1] = 90, data[i * 3 + 2] = 10;
+    }
+    auto *rgb = new ImageTexture();
+    // 先按同尺寸上传一次，第二次走 glTexSubImage2D
+    std::vector<uint8_t> blank((size_t) TEXMEM_IMAGE_SIZE * TEXMEM_IMAGE_SIZE * 3, 0);
+    rgb->setPixels(ImageTexture_RGB, blank.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    ok = rgb->setPixels(ImageTexture_RGB, data.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("RGB", ImageTexture_RGB, rgb, ok, IM_COL32(250, 90, 10, 255));
+
+    // OpenCV 的 BGR/BGRA/GRAY 不转换，靠纹理 swizzle 得到正确颜色
+    for (size_t i = 0; i < data.size() / 4; i++) {
+        data[i * 3] = 10, data[i * 3 + 1] = 90, data[i * 3 + 2] = 250;
+    }
+    auto *bgr = new ImageTexture();
+    ok = bgr->setPixels(ImageTexture_BGR, data.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("BGR", ImageTexture_BGR, bgr, ok, IM_COL32(250, 90, 10, 255));
+    for (size_t i = 0; i < data.size(); i += 4) {
+        data[i] = 220, data[i + 1] = 160, data[i + 2] = 40, data[i + 3] = 255;
+    }
+    auto *bgra = new ImageTexture();
+    ok = bgra->setPixels(ImageTexture_BGRA, data.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("BGRA", ImageTexture_BGRA, bgra, ok, IM_COL32(40, 160, 220, 255));
+    memset(data.data(), 128, (size_t) TEXMEM_IMAGE_SIZE * TEXMEM_IMAGE_SIZE);
+    auto *gray = new ImageTexture();
+    ok = gray->setPixels(ImageTexture_GRAY, data.data(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("GRAY", ImageTexture_GRAY, gray, ok, IM_COL32(128, 128, 128, 255));
+
+    fillEtc2(data, 12, 3, 7);
+    auto *etc2 = new ImageTexture();
+    std::vector<uint8_t> file = wrapKtx(data, GL_COMPRESSED_RGB8_ETC2);
+    ok = etc2->loadCompressed(file.data(), file.size());
+    addImage("ETC2 KTX", ImageTexture_ETC2_RGB, etc2, ok, IM_COL32(12 * 17 + 2, 3 * 17 + 2, 7 * 17 + 2, 255));
+
+    fillAstc(data, 4, 0x3333, 0xCCCC, 0x8080, 0xFFFF);
+    auto *astc4 = new ImageTexture();
+    ok = astc4->setCompressed(ImageTexture_ASTC_4x4, data.data(), data.size(), TEXMEM_IMAGE_SIZE, TEXMEM_IMAGE_SIZE);
+    addImage("ASTC 4x4", ImageTexture_ASTC_4x4, astc4, ok, IM_COL32(0x33, 0xCC, 0x80, 255));
+    fillAstc(data, 8, 0xEEEE, 0x2222, 0xAAAA, 0xFFFF);
+    file = wrapAstc(data, 8);
+    auto *astc8 = new ImageTexture();
+    ok = astc8->loadCompressed(file.data(), file.size());
+    addImage("ASTC .astc", ImageTexture_ASTC_8x8, astc8, ok, IM_COL32(0xEE, 0x22, 0xAA, 255));
+    printf("texmem           images total %8.1f KB\n",
+           (double) (ImageTexture::getTotalMemoryBytes() - before) / 1024.0);
+}
+
+static bool colorNear(const uint8_t *pixel, ImU32 expected) {
+    for (int c = 0; c < 4; c++) {
+        int e = (int) (expected >> (c * 8) & 0xFF);
+        if (abs((int) pixel[c] - e) > 2) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 上一帧的画面: 偶数帧用 Alpha8 字体画、奇数帧用 RGBA32 字体画，相邻两帧必须逐像素相同；每张图片中心为期望颜色
+static void checkPreviousFrame(int frame) {
+    auto *backend = (HeadlessLayerBackend *) getMainLayer()->getBackend();
+    if (frame < 3 || frame > TEXMEM_CHECK_FRAMES || !backend->readPixels(g_TexmemPixels)) {
+        return;
+    }
+    uint32_t width = backend->getWidth();
+    if ((frame - 1) % 2 == 0) {
+        g_TexmemAlpha8Pixels = g_TexmemPixels;
+    } else if (g_TexmemPixels != g_TexmemAlpha8Pixels) {
+        size_t diff = 0;
+        for (size_t i = 0; i < g_TexmemPixels.size(); i++) {
+            diff += g_TexmemPixels[i] != g_TexmemAlpha8Pixels[i];
+        }
+        benchFail("texmem Alpha8 and RGBA32 font frames differ in %zu bytes", diff);
+    }
+    for (size_t i = 0; i < g_TexmemImages.size(); i++) {
+        int x = 20 + (int) i * TEXMEM_SLOT + TEXMEM_DRAW_SIZE / 2, y = 1700 + TEXMEM_DRAW_SIZE / 2;
+        const uint8_t *pixel = g_TexmemPixels.data() + ((size_t) y * width + x) * 4;
+        if (!colorNear(pixel, g_TexmemImages[i].expected)) {
+            benchFail("texmem %s sampled %d,%d,%d,%d expected %08X", g_TexmemImages[i].name, pixel[0], pixel[1],
+                      pixel[2], pixel[3], g_TexmemImages[i].expected);
+        }
+    }
+}
+
+static void texmemFrame(int frame) {
+    checkPreviousFrame(frame);
+    ImGuiIO &io = ImGui::GetIO();
+    bool rgbaFont = frame % 2 == 1;
+    io.Fonts->SetTexID(rgbaFont ? (ImTextureID) g_TexmemFontRgba->getOpenglTexture() : g_TexmemFontAlpha8);
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(io.DisplaySize.x, 1600), ImGuiCond_Always);
+    ImGui::Begin("texmem", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    if (ImGui::GetWindowDrawList()->_CmdHeader.TextureId != io.Fonts->TexID) {
+        benchFail("texmem window does not use the swapped font texture");
+    }
+    for (int i = 0; i < 40; i++) {
+        ImGui::Text("Line %02d: The quick brown fox jumps over the lazy dog 0123456789 !@#$%%^&*()", i);
+    }
+    ImGui::Button("Button");
+    static float value = 0.5f;
+    ImGui::SliderFloat("Slider", &value, 0.0f, 1.0f);
+    ImGui::End();
+
+    ImDrawList *drawList = ImGui::GetForegroundDrawList();
+    for (size_t i = 0; i < g_TexmemImages.size(); i++) {
+        ImVec2 p0(20.0f + (float) (i * TEXMEM_SLOT), 1700.0f);
+        drawList->AddImage((ImTextureID) g_TexmemImages[i].texture->getOpenglTexture(), p0,
+                           ImVec2(p0.x + TEXMEM_DRAW_SIZE, p0.y + TEXMEM_DRAW_SIZE));
+        drawList->AddText(ImVec2(p0.x, p0.y + TEXMEM_DRAW_SIZE + 4.0f), IM_COL32_WHITE, g_TexmemImages[i].name);
+    }
+}
+
+static void texmemTeardown() {
+    ImGui::GetIO().Fonts->SetTexID(g_TexmemFontAlpha8);
+    g_TexmemImages.clear();
+    g_TexmemFontRgba.reset();
+    g_TexmemAlpha8Pixels.clear();
+    g_TexmemPixels.clear();
+    // 释放对比用的 RGBA32 图集副本
+    ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+    IM_FREE(atlas->TexPixelsRGBA32);
+    atlas->TexPixelsRGBA32 = nullptr;
+}
+
+BENCH_SCENE("texmem", "Font atlas Alpha8 vs RGBA32 and ETC2/ASTC ImageTexture memory, with pixel checks",
+            texmemSetup, texmemFrame, texmemTeardown);
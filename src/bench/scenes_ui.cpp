@@ -0,0 +1,143 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 基础UI场景: demo窗口、大表格、每帧上传图片
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include "ImageTexture.h"
+#include <cstdlib>
+#include <memory>
+#include <algorithm>
+#include <cstring>
+
+//---------------------------------------------------------------------------
+// demo: ImGui 自带的 demo 窗口
+//---------------------------------------------------------------------------
+static void demoFrame(int) {
+    ImGui::ShowDemoWindow();
+    // demo 内部用 FirstUseEver 设置了位置，这里强制铺满屏幕(下一帧生效)
+    ImGui::SetWindowPos("Dear ImGui Demo", ImVec2(0, 0));
+    ImGui::SetWindowSize("Dear ImGui Demo", ImGui::GetIO().DisplaySize);
+}
+
+BENCH_SCENE("demo", "ImGui::ShowDemoWindow", nullptr, demoFrame, nullptr);
+
+//---------------------------------------------------------------------------
+// table: 10000行可排序表格，使用 ImGuiListClipper 裁剪
+//---------------------------------------------------------------------------
+struct TableRow {
+    int id;
+    float value;
+    char name[16];
+};
+
+static std::vector<TableRow> g_TableRows;
+
+static void tableSetup() {
+    g_TableRows.resize(10000);
+    srand(1);
+    for (int i = 0; i < (int) g_TableRows.size(); i++) {
+        g_TableRows[i].id = i;
+        g_TableRows[i].value = (float) (rand() % 100000) / 100.0f;
+        snprintf(g_TableRows[i].name, sizeof(g_TableRows[i].name), "row_%05d", rand() % 100000);
+    }
+}
+
+static void tableFrame(int frame) {
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("table", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    ImGuiTableFlags flags = ImGuiTableFlags_Sortable | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+                            ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (ImGui::BeginTable("rows", 3, flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID", ImGuiTableColumnFlags_DefaultSort);
+        ImGui::TableSetupColumn("Name");
+        ImGui::TableSetupColumn("Value");
+        ImGui::TableHeadersRow();
+        if (ImGuiTableSortSpecs *specs = ImGui::TableGetSortSpecs()) {
+            if (specs->SpecsDirty && specs->SpecsCount > 0) {
+                const ImGuiTableColumnSortSpecs &spec = specs->Specs[0];
+                bool asc = spec.SortDirection == ImGuiSortDirection_Ascending;
+                std::sort(g_TableRows.begin(), g_TableRows.end(), [&](const TableRow &a, const TableRow &b) {
+                    int c;
+                    if (spec.ColumnIndex == 1) {
+                        c = strcmp(a.name, b.name);
+                    } else if (spec.ColumnIndex == 2) {
+                        c = a.value < b.value ? -1 : (a.value > b.value ? 1 : 0);
+                    } else {
+                        c = a.id - b.id;
+                    }
+                    return asc ? c < 0 : c > 0;
+                });
+                specs->SpecsDirty = false;
+            }
+        }
+        // 模拟滚动
+        ImGui::SetScrollY((float) (frame * 7 % 5000) * ImGui::GetTextLineHeightWithSpacing());
+        ImGuiListClipper clipper;
+        clipper.Begin((int) g_TableRows.size());
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const TableRow &row = g_TableRows[i];
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::Text("%d", row.id);
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextUnformatted(row.name);
+                ImGui::TableSetColumnIndex(2);
+                ImGui::Text("%.2f", row.value);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void tableTeardown() {
+    g_TableRows.clear();
+    g_TableRows.shrink_to_fit();
+}
+
+BENCH_SCENE("table", "10000 row sortable table with clipper", tableSetup, tableFrame, tableTeardown);
+
+//---------------------------------------------------------------------------
+// image: 每帧上传一张 1280x720 RGB 图片并显示(模拟 recordReceive)
+//---------------------------------------------------------------------------
+static const int IMAGE_WIDTH = 1280;
+static const int IMAGE_HEIGHT = 720;
+static std::vector<uint8_t> g_ImageBuffer;
+// 上一帧的纹理在本帧已经渲染完，可以直接替换
+static std::unique_ptr<ImageTexture> g_ImageTexture;
+
+static void imageSetup() {
+    g_ImageBuffer.resize((size_t) IMAGE_WIDTH * IMAGE_HEIGHT * 3);
+}
+
+static void imageFrame(int frame) {
+    // 合成图案，每帧不同
+    for (int y = 0; y < IMAGE_HEIGHT; y++) {
+        uint8_t *line = g_ImageBuffer.data() + (size_t) y * IMAGE_WIDTH * 3;
+        for (int x = 0; x < IMAGE_WIDTH; x++) {
+            line[x * 3 + 0] = (uint8_t) (x + frame);
+            line[x * 3 + 1] = (uint8_t) (y + frame * 2);
+            line[x * 3 + 2] = (uint8_t) (x ^ y);
+        }
+    }
+    g_ImageTexture.reset(new ImageTexture(g_ImageBuffer.data(), IMAGE_WIDTH, IMAGE_HEIGHT));
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::Begin("image", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoSavedSettings);
+    ImGui::Image((ImTextureID) g_ImageTexture->getOpenglTexture(), ImVec2(IMAGE_WIDTH / 2.0f, IMAGE_HEIGHT / 2.0f));
+    ImGui::End();
+    benchCounter("upload bytes", (double) g_ImageBuffer.size());
+}
+
+static void imageTeardown() {
+    g_ImageTexture.reset();
+    g_ImageBuffer.clear();
+    g_ImageBuffer.shrink_to_fit();
+}
+
+BENCH_SCENE("image", "upload 1280x720 RGB texture per frame", imageSetup, imageFrame, imageTeardown);
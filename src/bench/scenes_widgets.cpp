@@ -0,0 +1,214 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 控件ID哈希场景: 5000个控件的一帧，以及 ImHashStr 与逐字节CRC32的耗时对比、CRC32C正确性校验
+//
+
+#include "Bench.h"
+#include "draw.h"
+#include <imgui_internal.h>
+#include <ctime>
+#include <cstring>
+
+static const int WIDGET_COUNT = 5000;
+
+// 每个控件的label，模拟实际界面里的 "名称##id" 写法
+static std::vector<std::string> g_WidgetLabels;
+static bool g_WidgetChecks[WIDGET_COUNT];
+static float g_WidgetValues[WIDGET_COUNT];
+// 防止计时循环被优化掉
+static volatile ImGuiID g_WidgetHashSink;
+
+static double nowUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return (double) ts.tv_sec * 1000000.0 + (double) ts.tv_nsec / 1000.0;
+}
+
+// 未开启 IMGUI_USE_CRC32C_HASH 时 ImHashStr 的逐字节查表实现，作为对比基准
+static ImU32 legacyCrc32(const char *data, ImU32 seed) {
+    static ImU32 table[256];
+    if (table[1] == 0) {
+        for (ImU32 n = 0; n < 256; n++) {
+            ImU32 c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+    }
+    seed = ~seed;
+    ImU32 crc = seed;
+    const auto *p = (const unsigned char *) data;
+    while (unsigned char c = *p++) {
+        if (c == '#' && p[0] == '#' && p[1] == '#') {
+            crc = seed;
+        }
+        crc = (crc >> 8) ^ table[(crc & 0xFF) ^ c];
+    }
+    return ~crc;
+}
+
+static void widgetsSetup() {
+    g_WidgetLabels.resize(WIDGET_COUNT);
+    for (int i = 0; i < WIDGET_COUNT; i++) {
+        char label[64];
+        switch (i % 4) {
+            case 0:
+                snprintf(label, sizeof(label), "Button %d##widget_button", i);
+                break;
+            case 1:
+                snprintf(label, sizeof(label), "Enable feature %d##widget_check", i);
+                break;
+            case 2:
+                snprintf(label, sizeof(label), "Value %d###widget_slider_%d", i, i);
+                break;
+            default:
+                snprintf(label, sizeof(label), "Section %d", i);
+                break;
+        }
+        g_WidgetLabels[i] = label;
+        g_WidgetChecks[i] = i % 3 == 0;
+        g_WidgetValues[i] = (float) (i % 100) / 100.0f;
+    }
+}
+
+static void widgetsFrame(int) {
+    ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize, ImGuiCond_Always);
+    ImGui::Begin("widgets", nullptr, ImGuiWindowFlags_NoSavedSettings);
+    // 按行分组，每组一个 PushID，控件不裁剪(全部提交)
+    for (int i = 0; i < WIDGET_COUNT; i++) {
+        if (i % 50 == 0) {
+            if (i > 0) {
+                ImGui::PopID();
+            }
+            ImGui::PushID(i / 50);
+        }
+        const char *label = g_WidgetLabels[i].c_str();
+        switch (i % 4) {
+            case 0:
+                ImGui::Button(label);
+                break;
+            case 1:
+                ImGui::Checkbox(label, &g_WidgetChecks[i]);
+                break;
+            case 2:
+                ImGui::SliderFloat(label, &g_WidgetValues[i], 0.0f, 1.0f);
+                break;
+            default:
+                if (ImGui::TreeNode(label)) {
+                    ImGui::TreePop();
+                }
+                break;
+        }
+    }
+    ImGui::PopID();
+    ImGui::End();
+
+    // 同一组label单独计时: 当前 ImHashStr 对比逐字节CRC32
+    ImGuiID seed = ImGui::GetID("widgets");
+    ImGuiID sink = 0;
+    double t0 = nowUs();
+    for (const std::string &label: g_WidgetLabels) {
+        sink ^= ImHashStr(label.c_str(), 0, seed);
+    }
+    double t1 = nowUs();
+    for (const std::string &label: g_WidgetLabels) {
+        sink ^= legacyCrc32(label.c_str(), seed);
+    }
+    double t2 = nowUs();
+    benchCounter("ImHashStr us", t1 - t0);
+    benchCounter("legacy crc32 us", t2 - t1);
+    g_WidgetHashSink = sink;
+}
+
+static void widgetsTeardown() {
+    g_WidgetLabels.clear();
+}
+
+BENCH_SCENE("widgets5k", "5000 widgets with ## / ### ids, ImHashStr vs byte-wise CRC32", widgetsSetup, widgetsFrame,
+            widgetsTeardown);
+
+//---------------------------------------------------------------------------
+// hash_check: CRC32C 标准校验值、按位参考实现、### 语义、ImHashStrConst 与运行时结果一致
+//---------------------------------------------------------------------------
+static ImU32 referenceHash(const unsigned char *data, size_t size, ImU32 seed) {
+#ifdef IMGUI_USE_CRC32C_HASH
+    const ImU32 poly = 0x82F63B78u;
+#else
+    const ImU32 poly = 0xEDB88320u;
+#endif
+    ImU32 crc = ~seed;
+    for (size_t i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (int k = 0; k < 8; k++) {
+            crc = (crc & 1) ? (crc >> 1) ^ poly : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static void hashCheckFrame(int frame) {
+    if (frame != 0) {
+        return;
+    }
+#ifdef IMGUI_USE_CRC32C_HASH
+    if (ImHashData("123456789", 9) != 0xE3069283u) {
+        benchFail("hash_check CRC32C check value %08X", ImHashData("123456789", 9));
+    }
+#endif
+    // 各种长度和对齐，覆盖8/4/1字节分支
+    unsigned char data[96];
+    for (int i = 0; i < (int) sizeof(data); i++) {
+        data[i] = (unsigned char) (i * 37 + 11);
+    }
+    for (int offset = 0; offset < 8; offset++) {
+        for (size_t size = 0; size + offset <= sizeof(data); size++) {
+            ImU32 seed = (ImU32) (size * 2654435761u);
+            if (ImHashData(data + offset, size, seed) != referenceHash(data + offset, size, seed)) {
+                benchFail("hash_check ImHashData offset:%d size:%d", offset, (int) size);
+            }
+        }
+    }
+    // ### 之前的内容不参与哈希
+    if (ImHashStr("label###id") != ImHashStr("other###id") || ImHashStr("a###b###id") != ImHashStr("###id") ||
+        ImHashStr("##id") == ImHashStr("#id") || ImHashStr("x####") != ImHashStr("####") ||
+        ImHashStr("abc###id", 5) != ImHashStr("abc##")) {
+        benchFail("hash_check ### handling");
+    }
+    // '#' 与普通字符随机组合，和"从最后一个 ### 开始哈希"的参考结果比较
+    ImU32 rng = 12345;
+    for (int n = 0; n < 20000; n++) {
+        char text[48];
+        int len = (int) (n % 40);
+        for (int i = 0; i < len; i++) {
+            rng = rng * 1664525u + 1013904223u;
+            text[i] = (rng >> 24) % 3 == 0 ? 'a' : '#';
+        }
+        text[len] = 0;
+        int start = 0;
+        for (int i = 0; i + 2 < len; i++) {
+            if (text[i] == '#' && text[i + 1] == '#' && text[i + 2] == '#') {
+                start = i;
+            }
+        }
+        ImU32 seed = rng;
+        if (ImHashStr(text, 0, seed) != referenceHash((const unsigned char *) text + start, len - start, seed)) {
+            benchFail("hash_check ImHashStr(\"%s\")", text);
+        }
+    }
+    static constexpr ImGuiID windowHash = ImHashStrConst("Window");
+    const char *literals[] = {"Window", "Table", "#SourceExtern", "label###id", "##ContextMenu", ""};
+    if (windowHash != ImHashStr("Window")) {
+        benchFail("hash_check ImHashStrConst(\"Window\")");
+    }
+    for (const char *literal: literals) {
+        if (ImHashStrConst(literal, 1234) != ImHashStr(literal, 0, 1234)) {
+            benchFail("hash_check ImHashStrConst(\"%s\")", literal);
+        }
+    }
+    printf("hash_check done\n");
+}
+
+BENCH_SCENE("hash_check", "ImHashData/ImHashStr/ImHashStrConst correctness", nullptr, hashCheckFrame, nullptr);
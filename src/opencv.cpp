@@ -3,6 +3,8 @@
 #include <thread>
 #include <opencv2/opencv.hpp>
 #include "ImageViewer.h"
+#include "FrameBufferViews.h"
+#include "Pipeline.h"
 
 using namespace std;
 using namespace cv;
@@ -28,30 +30,65 @@ int main(int, char **) {
     cout << "width:" << " " << std::to_string(width) << endl;//输出帧总数
     cout << "height:" << " " << std::to_string(height) << endl;//输出帧总数
 
-    cv::Mat frame, frame2, img;
+    // 读取 -> 缩放+增益 -> 边缘 -> 显示，前后几帧同时在不同阶段处理
+    // 显示在渲染线程异步上传，每帧从池里取新缓冲，不改写还没上传的帧
+    const int inFlight = 4;
+    ThreadPool threadPool;
+    Pipeline pipeline(threadPool);
+    FrameBufferPool framePool(inFlight + 2);
+    FrameBufferPool halfPool(inFlight + 4);
+    FrameBufferPool edgePool(inFlight + 4);
 
 //    img = cv::imread("/sdcard/b.jpg");
 //    cv::resize(img, img, cv::Size(0, 0), 0.5, 0.5, cv::INTER_LINEAR);
 
-    while (video.read(frame)) {
-
-//        cv::resize(frame, frame, cv::Size(0, 0), 1.5, 1.5, cv::INTER_LINEAR);
-        float g = gui.getGain();
-        cv::resize(frame, frame2, cv::Size(0, 0), 0.5, 0.5, cv::INTER_LINEAR);
-
-        frame2.convertTo(frame2, CV_8U, g, 0);
+    pipeline.setSource("read", [&](PipelineFrame &frame) {
+        FrameBufferRef buffer = framePool.acquire(FrameBuffer_BGR24, width, height);
+        cv::Mat mat = FrameBufferViews::toMat(buffer);
+        // 尺寸和类型一致时直接解码到池里的缓冲
+        if (!buffer || !video.read(mat)) {
+            return false;
+        }
+        if (mat.data != buffer->planes[0]) {
+            cv::resize(mat, FrameBufferViews::toMat(buffer), cv::Size(width, height), 0, 0, cv::INTER_LINEAR);
+        }
+        frame.buffers[0] = buffer;
+        return true;
+    });
+    pipeline.addStage("resize", PipelineStage_Parallel, [&](PipelineFrame &frame) {
+        FrameBufferRef half = halfPool.acquire(FrameBuffer_BGR24, width / 2, height / 2);
+        cv::Mat frame2 = FrameBufferViews::toMat(half);
+        cv::resize(FrameBufferViews::toMat(frame.buffers[0]), frame2, frame2.size(), 0, 0, cv::INTER_LINEAR);
+        frame.buffers[0].reset();
+        // 增益逐行独立，按行带分到各个核
+        double g = gui.getGain();
+        threadPool.parallelFor(0, frame2.rows, 64, [&](int y0, int y1) {
+            cv::Mat rows = frame2.rowRange(y0, y1);
+            rows.convertTo(rows, CV_8U, g, 0);
+        });
+        frame.buffers[1] = half;
+        return true;
+    });
+    pipeline.addStage("canny", PipelineStage_Parallel, [&](PipelineFrame &frame) {
+        FrameBufferRef edges = edgePool.acquire(FrameBuffer_GRAY8, width / 2, height / 2);
+        cv::Mat gray;
+        cv::cvtColor(FrameBufferViews::toMat(frame.buffers[1]), gray, cv::COLOR_BGR2GRAY);
+        cv::Mat edgesMat = FrameBufferViews::toMat(edges);
+        cv::Canny(gray, edgesMat, 50, 150);
+        frame.buffers[2] = edges;
+        return true;
+    });
+    pipeline.addStage("display", PipelineStage_Serial, [&](PipelineFrame &frame) {
         // show halfsize image
-//        cv::resize(frame, frame2, cv::Size(0, 0), 0.5, 0.5, cv::INTER_LINEAR);
-
-        gui.imshow("video", frame2);
+        gui.imshow("video", frame.buffers[1]);
+        gui.imshow("edges", frame.buffers[2]);
 //        gui.imshow("img", &img);
-        // make quartersize image and show
-//            gui.imshow("quater", &frame2);
         gui.show();
-        std::this_thread::sleep_for(1ms);
-//            if (cv::waitKey(20) >= 0) {
-//            }
-    }
+        return true;
+    });
+    pipeline.run(inFlight);
+    pipeline.printStats();
+
     video.release();
     gui.shutdown();
 
@@ -4,20 +4,48 @@
 
 #include "DataDec.h"
 #include "TCPServer.h"
-#include "ByteUtils.h"
-#include "H264Decoder.h"
-#include "ImageTexture.h"
 #include "draw.h"
 #include "touch.h"
+#include "TimeTools.h"
+#include "RecordReceiver.h"
+#include "SessionFile.h"
+#include <atomic>
 
-// 接收h264编码流，使用ffmpeg解码到imgui显示
+// 接收h264编码流，使用ffmpeg解码到imgui显示；原始帧模式只接收变化的块
+// 参数: 会话文件路径(可选)，把收到的数据包、触摸事件、屏幕信息录下来，在 Linux 上用 NativeReplay 回放
 int main(int argc, char *argv[]) {
     if (!initDraw(true)) {
         return -1;
     }
+    SessionWriter session;
+    if (argc > 1 && session.open(argv[1])) {
+        printf("recording session: %s\n", argv[1]);
+        session.writeDisplay(displayInfo.width, displayInfo.height, displayInfo.orientation);
+        touchSetRecorder(&session);
+    }
+    MDisplayInfo recordedDisplay = displayInfo;
     Init_touch_config();
-    // h264解码工具
-    H264Decoder decoder;
+    // 统计信息放在单独的HUD图层，只在数据变化时重绘，不跟随视频帧率刷新
+    static std::atomic<int> recvFps{0};
+    static std::atomic<int> frameSize{0};
+    LayerConfig hudConfig;
+    hudConfig.name = "SsageHud";
+    hudConfig.zOrder = 1;
+    hudConfig.mode = LayerRender_OnChange;
+    hudConfig.fps = 30.0f;
+    OverlayLayer *hudLayer = createOverlayLayer(hudConfig);
+    if (hudLayer != nullptr) {
+        hudLayer->start([](OverlayLayer &) {
+            ImGui::Begin("stats");
+            ImGui::Text("recv fps: %d", recvFps.load());
+            ImGui::Text("frame size: %d", frameSize.load());
+            ImGui::End();
+        });
+    }
+    mlong lastTime = TimeTools::getCurrentTime();
+    int frames = 0;
+    // 解压、h264解码/脏块写入画布、上传纹理
+    RecordReceiver receiver;
     // Tcp 服务
     TCPServer tcpServer(6656);
     // 监听客户端
@@ -31,6 +59,12 @@ int main(int argc, char *argv[]) {
     ssize_t err = 0;
     while (true) {
         drawBegin();
+        if (session.isOpen() && (displayInfo.width != recordedDisplay.width ||
+                                 displayInfo.height != recordedDisplay.height ||
+                                 displayInfo.orientation != recordedDisplay.orientation)) {
+            recordedDisplay = displayInfo;
+            session.writeDisplay(displayInfo.width, displayInfo.height, displayInfo.orientation);
+        }
         // 接收头信息
         err = tcpClient->recvo(buffer, DataDec::headerSize());
         if (err != DataDec::headerSize()) {
@@ -40,23 +74,46 @@ int main(int argc, char *argv[]) {
         // 接收数据包
         int frameLenth = dataDec.getLength();
         // printf("frameLenth len: %d\n", frameLenth);
-        err = tcpClient->recvo(buffer, DataDec::headerSize(), frameLenth, 0);
-        if (err != frameLenth) {
-            printf("Failed to get frame. length: %zd\n", err);
+        if (frameLenth < 0 || frameLenth > bufferLen - DataDec::headerSize()) {
+            printf("frame too large: %d\n", frameLenth);
             break;
         }
-        decoder.decode((unsigned char *) (buffer + DataDec::headerSize()), frameLenth);
-        ImageTexture imageTexture(decoder.getDecBuffer(), decoder.getWidth(), decoder.getHeight());
+        if (frameLenth > 0) {
+            err = tcpClient->recvo(buffer, DataDec::headerSize(), frameLenth, 0);
+            if (err != frameLenth) {
+                printf("Failed to get frame. length: %zd\n", err);
+                break;
+            }
+        }
+        if (session.isOpen()) {
+            session.writePacket((const uint8_t *) buffer, DataDec::headerSize() + frameLenth);
+        }
+        receiver.handlePacket(buffer, DataDec::headerSize() + frameLenth);
+        frames++;
+        mlong now = TimeTools::getCurrentTime();
+        if (now - lastTime >= 1000) {
+            recvFps = frames;
+            frameSize = frameLenth;
+            frames = 0;
+            lastTime = now;
+            if (hudLayer != nullptr) {
+                hudLayer->markDirty();
+            }
+        }
+        ImageTexture &imageTexture = receiver.getTexture();
         ImGui::Begin("record");
-        ImVec2 imVec2 = ImVec2((float) decoder.getWidth(), (float) decoder.getHeight());
+        ImVec2 imVec2 = ImVec2((float) imageTexture.getWidth(), (float) imageTexture.getHeight());
         ImGui::SetWindowSize(ImVec2(imVec2.x + 100, imVec2.y + 100));
         ImGui::Image((ImTextureID) imageTexture.getOpenglTexture(), imVec2);
         ImGui::End();
         drawEnd();
     }
+    touchSetRecorder(nullptr);
+    session.close();
     tcpClient->close();
     tcpServer.close();
     delete[] buffer;
+    delete hudLayer;
     shutdown();
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,107 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+// 会话回放: 在 Linux 上按 recordReceive.cpp 的逻辑回放 NativeRecordReceive 录制的会话(数据包+触摸+屏幕信息)，
+// 输出每个阶段的耗时分布、帧率、CPU、内存
+// 用法: NativeReplay <会话文件> [--speed N(0最快，1原速)] [--loop N] [--json 报告] [--no-render] [--size 宽x高]
+//       NativeReplay --synth <会话文件> [--frames N] [--codec none|zlib|lz4] [--rotate] [--size 宽x高]
+//
+
+#include "SessionReplay.h"
+#include "draw.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+static void usage() {
+    printf("NativeReplay <session> [--speed N] [--loop N] [--json path] [--no-render] [--size WxH]\n");
+    printf("NativeReplay --synth <session> [--frames N] [--codec none|zlib|lz4] [--rotate] [--size WxH]\n");
+}
+
+static bool parseCodec(const char *name, CompressCodec &codec) {
+    for (int i = 0; i < Compress_CodecCount; i++) {
+        if (strcmp(name, CompressContext::getCodecName((CompressCodec) i)) == 0) {
+            codec = (CompressCodec) i;
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char *argv[]) {
+    SessionReplayOptions options;
+    SyntheticSessionConfig synth;
+    const char *session = nullptr;
+    const char *jsonPath = nullptr;
+    bool synthesize = false;
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (arg[0] != '-') {
+            session = arg;
+            continue;
+        }
+        if (strcmp(arg, "--no-render") == 0) {
+            options.render = false;
+            continue;
+        } else if (strcmp(arg, "--rotate") == 0) {
+            synth.rotate = true;
+            continue;
+        } else if (value == nullptr) {
+            usage();
+            return -1;
+        } else if (strcmp(arg, "--synth") == 0) {
+            synthesize = true;
+            session = value;
+        } else if (strcmp(arg, "--speed") == 0) {
+            options.speed = atof(value);
+        } else if (strcmp(arg, "--loop") == 0) {
+            options.loops = atoi(value);
+        } else if (strcmp(arg, "--json") == 0) {
+            jsonPath = value;
+        } else if (strcmp(arg, "--frames") == 0) {
+            synth.frames = atoi(value);
+        } else if (strcmp(arg, "--codec") == 0) {
+            if (!parseCodec(value, synth.codec)) {
+                usage();
+                return -1;
+            }
+        } else if (strcmp(arg, "--size") == 0) {
+            setenv("HEADLESS_SIZE", value, 1);
+            sscanf(value, "%dx%d", &synth.width, &synth.height);
+        } else {
+            usage();
+            return -1;
+        }
+        i++;
+    }
+    if (session == nullptr) {
+        usage();
+        return -1;
+    }
+    if (synthesize) {
+        if (!SessionReplay::writeSynthetic(session, synth)) {
+            return -1;
+        }
+        printf("synthetic session %s: %dx%d %d frames codec %s\n", session, synth.width, synth.height, synth.frames,
+               CompressContext::getCodecName(synth.codec));
+        return 0;
+    }
+    if (!initDraw(true)) {
+        return -1;
+    }
+    if (!RecordReceiver::hasH264Decoder()) {
+        printf("built without ffmpeg: h264 packets are counted but not decoded\n");
+    }
+    SessionReplay replay(options);
+    SessionReplayReport report;
+    bool ok = replay.run(session, report);
+    if (ok) {
+        SessionReplay::printReport(report);
+        if (jsonPath != nullptr) {
+            ok = SessionReplay::writeJson(report, jsonPath);
+        }
+    }
+    shutdown();
+    return ok && report.receiver.errors == 0 && !report.corrupt ? 0 : -1;
+}
@@ -6,7 +6,11 @@
 #include "TCPClient.h"
 #include "ByteUtils.h"
 #include "TimeTools.h"
+#include "FrameDiff.h"
+#include "RecordPacket.h"
 #include <thread>
+#include <vector>
+#include <cstring>
 
 FILE *fp;
 // 录屏flag，设置false退出录屏
@@ -41,6 +45,8 @@ void callback(uint8_t *buff, size_t size) {
     memcpy(byte + DataEnc::headerSize(), buff, size);
     // 数据打包
     auto *dataEnc = new DataEnc(byte, DataEnc::headerSize() + size);
+    dataEnc->setCmd(RecordPacket_H264);
+    dataEnc->setCount(0);
     // 设置数据包下标
     dataEnc->setDataIndex((int) size);
     //printf("size: %zu getDataLen:%d fps:%d\n", size, dataEnc->getDataLen(), fps);
@@ -52,10 +58,45 @@ void callback(uint8_t *buff, size_t size) {
     }
 }
 
+/**
+ * 原始帧录屏: 每帧和上一次发送的内容比较，没有变化只发一个头，有变化只发脏块
+ * 静止的界面几乎不占带宽，也不需要编码；需要系统库支持原始帧采集
+ */
+void runRawRecord(ExternFunction &functionRecord) {
+    if (!functionRecord.initRawCapture(720, 1280, RawFrame_RGBA_8888, 2)) {
+        printf("raw capture not supported\n");
+        return;
+    }
+    FrameDiff frameDiff;
+    std::vector<mbyte> packet;
+    int skipped = 0;
+    while (flag) {
+        RawFrame frame;
+        if (!functionRecord.acquireRawFrame(&frame, 100)) {
+            continue;
+        }
+        const FrameDiffResult &diff = frameDiff.update(frame);
+        int length = buildTilesPacket(diff, frame.planes[0], frame.rowStride[0], packet);
+        functionRecord.releaseRawFrame(&frame);
+        if (!diff.changed) {
+            skipped++;
+        }
+        if (length < 0 || !tcpClient->send(packet.data(), length)) {
+            printf("Failed to send buffer\n");
+            flag = false;
+        }
+    }
+    FrameDiffStats stats = frameDiff.getStats();
+    printf("raw record: %llu frames, %d unchanged, %.2f ms/frame diff\n", (unsigned long long) stats.frames,
+           skipped, stats.frames > 0 ? stats.totalMs / (double) stats.frames : 0.0);
+    functionRecord.stopRawCapture();
+}
+
 /**
  * h264录屏测试
  * 运行后会保存录屏数据并且使用tcp发送数据流
  * 代码 recordReceive.cpp 作为接收端
+ * 参数 raw: 不编码，采集原始帧只发送变化的块
  */
 int main(int argc, char *argv[]) {
     // tcp客户端
@@ -65,10 +106,22 @@ int main(int argc, char *argv[]) {
     }
     // 开始录屏
     ExternFunction functionRecord;
+    if (argc > 1 && strcmp(argv[1], "raw") == 0) {
+        runRawRecord(functionRecord);
+        return 0;
+    }
     // 录屏文件保存路径
     fp = fopen("/sdcard/test.h264", "w");
     // 初始化录屏，帧率设置无用待解决
     functionRecord.initRecord("1M", 60.0F, 720, 1280);
+    // 只录屏幕的一部分(裁剪和缩放由合成器完成)，例如左上角 540x540 区域缩小一半、每2帧编码一帧
+//    RecordConfig config;
+//    config.bitRate = "1M";
+//    config.cropWidth = 540;
+//    config.cropHeight = 540;
+//    config.scale = 0.5f;
+//    config.frameSkip = 2;
+//    functionRecord.initRecord(config);
     functionRecord.runRecord(&flag, callback);
     functionRecord.stopRecord();
     fclose(fp);
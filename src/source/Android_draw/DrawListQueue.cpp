@@ -0,0 +1,297 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/DrawListQueue.h"
+#include "Profiler.h"
+#include <cstring>
+#include <cstdio>
+#include <thread>
+#include <algorithm>
+
+DrawListChannel::DrawListChannel(DrawListQueue *queue, const char *name, int order, uint32_t id) :
+        queue(queue), order(order), id(id) {
+    snprintf(this->name, sizeof(this->name), "%s", name != nullptr ? name : "");
+    for (ImDrawList *&list: lists) {
+        list = new ImDrawList(&sharedData);
+        list->_OwnerName = this->name;
+    }
+}
+
+DrawListChannel::~DrawListChannel() {
+    for (ImDrawList *list: lists) {
+        delete list;
+    }
+}
+
+ImDrawList *DrawListChannel::begin() {
+    IM_ASSERT(!recording && "DrawListChannel::begin() called twice without submit()");
+    // 先登记再检查关联状态，detach() 先取消关联再等待登记数归零
+    queue->recorders.fetch_add(1);
+    if (!queue->attached.load()) {
+        queue->recorders.fetch_sub(1);
+        return nullptr;
+    }
+    if (queue->sharedVersion.load(std::memory_order_acquire) != sharedVersion) {
+        std::lock_guard<std::mutex> lock(queue->sharedMutex);
+        memcpy((void *) &sharedData, (const void *) &queue->sharedData, sizeof(sharedData));
+        fontTexture = queue->fontTexture;
+        generation = queue->generation;
+        sharedVersion = queue->sharedVersion.load(std::memory_order_relaxed);
+    }
+    recording = true;
+    ImDrawList *list = lists[back];
+    list->_ResetForNewFrame();
+    list->PushClipRectFullScreen();
+    list->PushTextureID(fontTexture);
+    listGenerations[back] = generation;
+    return list;
+}
+
+void DrawListChannel::submit() {
+    if (!recording) {
+        return;
+    }
+    recording = false;
+    ImDrawList *list = lists[back];
+    list->_PopUnusedDrawCmd();
+    // 16位索引且后端不支持VtxOffset时，超过65535的顶点会被索引截断，整个列表丢弃
+    if (sizeof(ImDrawIdx) == 2 && list->VtxBuffer.Size > 0x10000 &&
+        !(list->Flags & ImDrawListFlags_AllowVtxOffset)) {
+        queue->dropped.fetch_add(1, std::memory_order_relaxed);
+        queue->recorders.fetch_sub(1);
+        return;
+    }
+    back = ready.exchange(back | READY_NEW, std::memory_order_acq_rel) & 3;
+    queue->submitted.fetch_add(1, std::memory_order_relaxed);
+    queue->recorders.fetch_sub(1);
+}
+
+void DrawListChannel::submit(const ImDrawData *drawData, const ImVec2 &offset) {
+    PROFILE_ZONE("DrawListChannel::submit");
+    if (!recording) {
+        return;
+    }
+    ImDrawList *list = lists[back];
+    list->CmdBuffer.resize(0);
+    list->VtxBuffer.resize(0);
+    list->IdxBuffer.resize(0);
+    if (drawData != nullptr && drawData->Valid) {
+        list->VtxBuffer.reserve(drawData->TotalVtxCount);
+        list->IdxBuffer.reserve(drawData->TotalIdxCount);
+        for (int n = 0; n < drawData->CmdListsCount; n++) {
+            const ImDrawList *src = drawData->CmdLists[n];
+            unsigned int vtxBase = (unsigned int) list->VtxBuffer.Size;
+            list->VtxBuffer.resize(list->VtxBuffer.Size + src->VtxBuffer.Size);
+            ImDrawVert *vtx = list->VtxBuffer.Data + vtxBase;
+            for (int i = 0; i < src->VtxBuffer.Size; i++) {
+                vtx[i] = src->VtxBuffer.Data[i];
+                vtx[i].pos.x += offset.x;
+                vtx[i].pos.y += offset.y;
+            }
+            for (const ImDrawCmd &cmd: src->CmdBuffer) {
+                if (cmd.UserCallback != nullptr || cmd.ElemCount == 0) {
+                    continue;
+                }
+                // 索引重新以合并后的列表为基准，VtxOffset 一并折算进去；
+                // 16位索引放不下时改用 VtxOffset(后端不支持时由 submit() 丢弃)
+                unsigned int idxOffset = (unsigned int) list->IdxBuffer.Size;
+                unsigned int base = vtxBase + cmd.VtxOffset;
+                unsigned int vtxOffset = 0;
+                if (sizeof(ImDrawIdx) == 2 && list->VtxBuffer.Size > 0x10000) {
+                    vtxOffset = base;
+                    base = 0;
+                }
+                list->IdxBuffer.resize(list->IdxBuffer.Size + (int) cmd.ElemCount);
+                const ImDrawIdx *srcIdx = src->IdxBuffer.Data + cmd.IdxOffset;
+                ImDrawIdx *idx = list->IdxBuffer.Data + idxOffset;
+                for (unsigned int i = 0; i < cmd.ElemCount; i++) {
+                    idx[i] = (ImDrawIdx) (srcIdx[i] + base);
+                }
+                ImVec4 clip(cmd.ClipRect.x + offset.x, cmd.ClipRect.y + offset.y, cmd.ClipRect.z + offset.x,
+                            cmd.ClipRect.w + offset.y);
+                if (list->CmdBuffer.Size > 0) {
+                    ImDrawCmd &prev = list->CmdBuffer.back();
+                    if (prev.TextureId == cmd.TextureId && prev.VtxOffset == vtxOffset &&
+                        memcmp(&prev.ClipRect, &clip, sizeof(clip)) == 0) {
+                        prev.ElemCount += cmd.ElemCount;
+                        continue;
+                    }
+                }
+                ImDrawCmd out;
+                out.ClipRect = clip;
+                out.TextureId = cmd.TextureId;
+                out.VtxOffset = vtxOffset;
+                out.IdxOffset = idxOffset;
+                out.ElemCount = cmd.ElemCount;
+                list->CmdBuffer.push_back(out);
+            }
+        }
+    }
+    submit();
+}
+
+const char *DrawListChannel::getName() const {
+    return name;
+}
+
+int DrawListChannel::getOrder() const {
+    return order;
+}
+
+DrawListQueue::DrawListQueue() = default;
+
+DrawListQueue::~DrawListQueue() {
+    // 此时不应再有生产线程使用通道
+    DrawListChannel *channel = channels.exchange(nullptr);
+    while (channel != nullptr) {
+        DrawListChannel *next = channel->next;
+        delete channel;
+        channel = next;
+    }
+}
+
+DrawListChannel *DrawListQueue::createChannel(const char *name, int order) {
+    auto *channel = new DrawListChannel(this, name, order, nextChannelId.fetch_add(1, std::memory_order_relaxed));
+    channel->next = channels.load(std::memory_order_relaxed);
+    while (!channels.compare_exchange_weak(channel->next, channel, std::memory_order_release,
+                                           std::memory_order_relaxed)) {
+    }
+    channelCount.fetch_add(1, std::memory_order_relaxed);
+    return channel;
+}
+
+void DrawListQueue::destroyChannel(DrawListChannel *channel) {
+    if (channel == nullptr) {
+        return;
+    }
+    IM_ASSERT(channel->queue == this);
+    if (channel->recording) {
+        channel->recording = false;
+        recorders.fetch_sub(1);
+    }
+    channel->closed.store(true, std::memory_order_release);
+}
+
+DrawListQueueStats DrawListQueue::getStats() const {
+    DrawListQueueStats stats;
+    stats.channels = channelCount.load(std::memory_order_relaxed);
+    stats.submitted = submitted.load(std::memory_order_relaxed);
+    stats.acquired = acquired.load(std::memory_order_relaxed);
+    stats.dropped = dropped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void DrawListQueue::updateSharedData(const ImDrawListSharedData &data, ImTextureID texture) {
+    bool attach = !attached.load(std::memory_order_relaxed);
+    // 快照只有渲染线程写，比较时不需要加锁；正常情况下只有窗口大小/字体变化时才会更新
+    if (!attach && fontTexture == texture && memcmp((const void *) &sharedData, (const void *) &data,
+                                                   sizeof(sharedData)) == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sharedMutex);
+        memcpy((void *) &sharedData, (const void *) &data, sizeof(sharedData));
+        fontTexture = texture;
+        if (attach) {
+            // 重新关联后旧上下文录制的列表(纹理/字体已失效)不再显示
+            generation++;
+        }
+        sharedVersion.fetch_add(1, std::memory_order_release);
+    }
+    if (attach) {
+        attached.store(true);
+    }
+}
+
+void DrawListQueue::detach() {
+    if (!attached.exchange(false)) {
+        return;
+    }
+    // 录制中的线程不会等待渲染线程，最多等它录完一帧
+    while (recorders.load() != 0) {
+        std::this_thread::yield();
+    }
+}
+
+void DrawListQueue::releaseClosedChannels() {
+    DrawListChannel *prev = nullptr;
+    DrawListChannel *channel = channels.load(std::memory_order_acquire);
+    while (channel != nullptr) {
+        DrawListChannel *next = channel->next;
+        if (!channel->closed.load(std::memory_order_acquire)) {
+            prev = channel;
+            channel = next;
+            continue;
+        }
+        // 生产线程只会在表头插入，表头以外的节点只有渲染线程修改
+        if (prev != nullptr) {
+            prev->next = next;
+        } else {
+            DrawListChannel *expected = channel;
+            if (!channels.compare_exchange_strong(expected, next, std::memory_order_acquire)) {
+                prev = expected;
+                while (prev->next != channel) {
+                    prev = prev->next;
+                }
+                prev->next = next;
+            }
+        }
+        delete channel;
+        channelCount.fetch_sub(1, std::memory_order_relaxed);
+        channel = next;
+    }
+}
+
+ImDrawData *DrawListQueue::splice(ImDrawData *drawData) {
+    PROFILE_ZONE("DrawListQueue::splice");
+    frameSpliced = false;
+    releaseClosedChannels();
+    frameChannels.resize(0);
+    for (DrawListChannel *channel = channels.load(std::memory_order_acquire);
+         channel != nullptr; channel = channel->next) {
+        frameChannels.push_back(channel);
+    }
+    if (frameChannels.Size == 0 || drawData == nullptr || !drawData->Valid) {
+        return drawData;
+    }
+    std::sort(frameChannels.begin(), frameChannels.end(), [](DrawListChannel *a, DrawListChannel *b) {
+        return a->order != b->order ? a->order < b->order : a->id < b->id;
+    });
+
+    frameLists.resize(0);
+    frameLists.reserve(drawData->CmdListsCount + frameChannels.Size);
+    for (int i = 0; i < drawData->CmdListsCount; i++) {
+        frameLists.push_back(drawData->CmdLists[i]);
+    }
+    int totalVtx = drawData->TotalVtxCount;
+    int totalIdx = drawData->TotalIdxCount;
+    for (DrawListChannel *channel: frameChannels) {
+        if (channel->ready.load(std::memory_order_relaxed) & DrawListChannel::READY_NEW) {
+            channel->front = channel->ready.exchange(channel->front, std::memory_order_acq_rel) & 3;
+            acquired.fetch_add(1, std::memory_order_relaxed);
+        }
+        ImDrawList *list = channel->lists[channel->front];
+        if (channel->listGenerations[channel->front] != generation || list->CmdBuffer.Size == 0 ||
+            list->IdxBuffer.Size == 0) {
+            continue;
+        }
+        frameLists.push_back(list);
+        totalVtx += list->VtxBuffer.Size;
+        totalIdx += list->IdxBuffer.Size;
+    }
+    if (frameLists.Size == drawData->CmdListsCount) {
+        return drawData;
+    }
+    frameDrawData = *drawData;
+    frameDrawData.CmdLists = frameLists.Data;
+    frameDrawData.CmdListsCount = frameLists.Size;
+    frameDrawData.TotalVtxCount = totalVtx;
+    frameDrawData.TotalIdxCount = totalIdx;
+    frameSpliced = true;
+    return &frameDrawData;
+}
+
+ImDrawData *DrawListQueue::getSplicedDrawData() {
+    return frameSpliced ? &frameDrawData : nullptr;
+}
@@ -0,0 +1,179 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/EglLayerBackend.h"
+#include "Android_draw/draw.h"
+
+// EGLDisplay 为进程内共享，最后一个图层销毁时才 eglTerminate
+static std::mutex g_DisplayMutex;
+static int g_DisplayRefs = 0;
+
+bool EglLayerBackend::create(const LayerConfig &layerConfig, LayerBackend *share) {
+    bool log = layerConfig.log;
+    gpuTimer = layerConfig.gpuTimer;
+    native_window = externFunction.createNativeWindow(layerConfig.name,
+                                                      layerConfig.width, layerConfig.height, false);
+    if (native_window == nullptr) {
+        printf("createNativeWindow error\n");
+        return false;
+    }
+    ANativeWindow_acquire(native_window);
+    {
+        std::lock_guard<std::mutex> lock(g_DisplayMutex);
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+        if (display == EGL_NO_DISPLAY) {
+            printf("eglGetDisplay error=%u\n", glGetError());
+            return false;
+        }
+        if (log) {
+            printf("eglGetDisplay ok\n");
+        }
+        if (g_DisplayRefs == 0 && eglInitialize(display, 0, 0) != EGL_TRUE) {
+            printf("eglInitialize error=%u\n", glGetError());
+            display = EGL_NO_DISPLAY;
+            return false;
+        }
+        g_DisplayRefs++;
+    }
+    if (log) {
+        printf("eglInitialize ok\n");
+    }
+    EGLint num_config = 0;
+    const EGLint attribList[] = {
+            EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+            EGL_BLUE_SIZE, 5,   //-->delete
+            EGL_GREEN_SIZE, 6,  //-->delete
+            EGL_RED_SIZE, 5,    //-->delete
+            EGL_BUFFER_SIZE, 32,  //-->new field
+            EGL_DEPTH_SIZE, 16,
+            EGL_STENCIL_SIZE, 8,
+            EGL_NONE
+    };
+    const EGLint attrib_list[] = {
+            EGL_CONTEXT_CLIENT_VERSION,
+            3,
+            EGL_NONE
+    };
+    if (eglChooseConfig(display, attribList, &config, 1, &num_config) != EGL_TRUE) {
+        printf("eglChooseConfig  error=%u\n", glGetError());
+        return false;
+    }
+    if (log) {
+        printf("eglChooseConfig ok num_config=%d\n", num_config);
+    }
+    EGLint egl_format;
+    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &egl_format);
+    ANativeWindow_setBuffersGeometry(native_window, 0, 0, egl_format);
+    // 共享上下文，图层之间可以共用纹理(视频帧、图片)
+    EGLContext shareContext = EGL_NO_CONTEXT;
+    if (share != nullptr) {
+        shareContext = ((EglLayerBackend *) share)->context;
+    }
+    context = eglCreateContext(display, config, shareContext, attrib_list);
+    if (context == EGL_NO_CONTEXT) {
+        printf("eglCreateContext  error = %u\n", glGetError());
+        return false;
+    }
+    if (log) {
+        printf("eglCreateContext ok\n");
+    }
+    surface = eglCreateWindowSurface(display, config, native_window, nullptr);
+    if (surface == EGL_NO_SURFACE) {
+        printf("eglCreateWindowSurface  error = %u\n", glGetError());
+        return false;
+    }
+    if (log) {
+        printf("eglCreateWindowSurface ok\n");
+    }
+    if (!makeCurrent()) {
+        printf("eglMakeCurrent  error = %u\n", glGetError());
+        return false;
+    }
+    if (log) {
+        printf("eglMakeCurrent ok\n");
+        printf("createNativeWindow ok\n");
+    }
+    return true;
+}
+
+void EglLayerBackend::destroy() {
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+        if (context != EGL_NO_CONTEXT) {
+            eglDestroyContext(display, context);
+        }
+        if (surface != EGL_NO_SURFACE) {
+            eglDestroySurface(display, surface);
+        }
+        std::lock_guard<std::mutex> lock(g_DisplayMutex);
+        if (--g_DisplayRefs == 0) {
+            eglTerminate(display);
+        }
+    }
+    display = EGL_NO_DISPLAY;
+    context = EGL_NO_CONTEXT;
+    surface = EGL_NO_SURFACE;
+    if (native_window != nullptr) {
+        ANativeWindow_release(native_window);
+        native_window = nullptr;
+    }
+}
+
+bool EglLayerBackend::makeCurrent() {
+    if (display == EGL_NO_DISPLAY) {
+        return false;
+    }
+    return eglMakeCurrent(display, surface, surface, context) == EGL_TRUE;
+}
+
+void EglLayerBackend::releaseCurrent() {
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+bool EglLayerBackend::initImGui() {
+    ImGui_ImplAndroid_Init(native_window);
+    if (!ImGui_ImplOpenGL3_Init("#version 300 es")) {
+        return false;
+    }
+    ImGui_ImplOpenGL3_SetGpuTimerEnabled(gpuTimer);
+    return true;
+}
+
+void EglLayerBackend::shutdownImGui() {
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui_ImplAndroid_Shutdown();
+}
+
+void EglLayerBackend::newFrame(uint32_t width, uint32_t height) {
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGui_ImplAndroid_NewFrame((int32_t) width, (int32_t) height);
+}
+
+void EglLayerBackend::renderDrawData(ImDrawData *drawData, uint32_t width, uint32_t height) {
+    glViewport(0, 0, (int) width, (int) height);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT); // GL_DEPTH_BUFFER_BIT
+    glFlush();
+    if (display == EGL_NO_DISPLAY) {
+        return;
+    }
+    ImGui_ImplOpenGL3_RenderDrawData(drawData);
+}
+
+void EglLayerBackend::present() {
+    if (display != EGL_NO_DISPLAY) {
+        eglSwapBuffers(display, surface);
+    }
+}
+
+ANativeWindow *EglLayerBackend::getNativeWindow() const {
+    return native_window;
+}
+
+EGLContext EglLayerBackend::getEglContext() const {
+    return context;
+}
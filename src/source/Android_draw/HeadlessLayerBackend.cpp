@@ -0,0 +1,267 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/HeadlessLayerBackend.h"
+#include <backends/imgui_impl_opengl3.h>
+#include <EGL/eglext.h>
+#include <mutex>
+#include <cstring>
+#include <cstdio>
+
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+#ifndef EGL_OPENGL_ES3_BIT_KHR
+#define EGL_OPENGL_ES3_BIT_KHR 0x00000040
+#endif
+
+typedef EGLDisplay (*GetPlatformDisplayFunc)(EGLenum platform, void *native_display, const EGLint *attrib_list);
+
+// 与 EglLayerBackend 相同，display 进程内共享
+static std::mutex g_DisplayMutex;
+static int g_DisplayRefs = 0;
+
+static bool hasExtension(const char *extensions, const char *name) {
+    if (extensions == nullptr) {
+        return false;
+    }
+    size_t len = strlen(name);
+    const char *p = extensions;
+    while ((p = strstr(p, name)) != nullptr) {
+        if ((p == extensions || p[-1] == ' ') && (p[len] == ' ' || p[len] == '\0')) {
+            return true;
+        }
+        p += len;
+    }
+    return false;
+}
+
+static EGLDisplay getHeadlessDisplay(bool log) {
+    const char *clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless")) {
+        auto getPlatformDisplay = (GetPlatformDisplayFunc) eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay != nullptr) {
+            EGLDisplay dpy = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (dpy != EGL_NO_DISPLAY) {
+                if (log) {
+                    printf("headless: EGL_MESA_platform_surfaceless\n");
+                }
+                return dpy;
+            }
+        }
+    }
+    if (log) {
+        printf("headless: default display + pbuffer\n");
+    }
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+bool HeadlessLayerBackend::create(const LayerConfig &layerConfig, LayerBackend *share) {
+    bool log = layerConfig.log;
+    width = layerConfig.width;
+    height = layerConfig.height;
+    gpuTimer = layerConfig.gpuTimer;
+    {
+        std::lock_guard<std::mutex> lock(g_DisplayMutex);
+        display = getHeadlessDisplay(log);
+        if (display == EGL_NO_DISPLAY) {
+            printf("eglGetDisplay error=%x\n", eglGetError());
+            return false;
+        }
+        if (g_DisplayRefs == 0 && eglInitialize(display, 0, 0) != EGL_TRUE) {
+            printf("eglInitialize error=%x\n", eglGetError());
+            display = EGL_NO_DISPLAY;
+            return false;
+        }
+        g_DisplayRefs++;
+    }
+    bool surfaceless = hasExtension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context");
+    EGLint num_config = 0;
+    const EGLint attribList[] = {
+            EGL_SURFACE_TYPE, surfaceless ? 0 : EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT_KHR,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_NONE
+    };
+    if (eglChooseConfig(display, attribList, &config, 1, &num_config) != EGL_TRUE || num_config == 0) {
+        printf("eglChooseConfig error=%x\n", eglGetError());
+        return false;
+    }
+    if (eglBindAPI(EGL_OPENGL_ES_API) != EGL_TRUE) {
+        printf("eglBindAPI error=%x\n", eglGetError());
+        return false;
+    }
+    const EGLint attrib_list[] = {
+            EGL_CONTEXT_CLIENT_VERSION,
+            3,
+            EGL_NONE
+    };
+    EGLContext shareContext = EGL_NO_CONTEXT;
+    if (share != nullptr) {
+        shareContext = ((HeadlessLayerBackend *) share)->context;
+    }
+    context = eglCreateContext(display, config, shareContext, attrib_list);
+    if (context == EGL_NO_CONTEXT) {
+        printf("eglCreateContext error=%x\n", eglGetError());
+        return false;
+    }
+    if (!surfaceless) {
+        const EGLint pbufferAttribs[] = {
+                EGL_WIDTH, 1,
+                EGL_HEIGHT, 1,
+                EGL_NONE
+        };
+        surface = eglCreatePbufferSurface(display, config, pbufferAttribs);
+        if (surface == EGL_NO_SURFACE) {
+            printf("eglCreatePbufferSurface error=%x\n", eglGetError());
+            return false;
+        }
+    }
+    if (!makeCurrent()) {
+        printf("eglMakeCurrent error=%x\n", eglGetError());
+        return false;
+    }
+    // 真正的渲染目标
+    glGenRenderbuffers(1, &colorbuffer);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorbuffer);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, (GLsizei) width, (GLsizei) height);
+    glGenFramebuffers(1, &framebuffer);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorbuffer);
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        printf("headless framebuffer incomplete\n");
+        return false;
+    }
+    if (log) {
+        printf("headless: %ux%u renderer:%s\n", width, height, (const char *) glGetString(GL_RENDERER));
+    }
+    return true;
+}
+
+void HeadlessLayerBackend::destroy() {
+    if (display == EGL_NO_DISPLAY) {
+        return;
+    }
+    if (context != EGL_NO_CONTEXT && makeCurrent()) {
+        if (framebuffer != 0) {
+            glDeleteFramebuffers(1, &framebuffer);
+        }
+        if (colorbuffer != 0) {
+            glDeleteRenderbuffers(1, &colorbuffer);
+        }
+    }
+    framebuffer = 0;
+    colorbuffer = 0;
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context != EGL_NO_CONTEXT) {
+        eglDestroyContext(display, context);
+    }
+    if (surface != EGL_NO_SURFACE) {
+        eglDestroySurface(display, surface);
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_DisplayMutex);
+        if (--g_DisplayRefs == 0) {
+            eglTerminate(display);
+        }
+    }
+    display = EGL_NO_DISPLAY;
+    context = EGL_NO_CONTEXT;
+    surface = EGL_NO_SURFACE;
+}
+
+bool HeadlessLayerBackend::makeCurrent() {
+    if (display == EGL_NO_DISPLAY) {
+        return false;
+    }
+    if (eglMakeCurrent(display, surface, surface, context) != EGL_TRUE) {
+        return false;
+    }
+    if (framebuffer != 0) {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    }
+    return true;
+}
+
+void HeadlessLayerBackend::releaseCurrent() {
+    if (display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+bool HeadlessLayerBackend::initImGui() {
+    ImGuiIO &io = ImGui::GetIO();
+    io.BackendPlatformName = "headless";
+    if (!ImGui_ImplOpenGL3_Init("#version 300 es")) {
+        return false;
+    }
+    ImGui_ImplOpenGL3_SetGpuTimerEnabled(gpuTimer);
+    return true;
+}
+
+void HeadlessLayerBackend::shutdownImGui() {
+    ImGui_ImplOpenGL3_Shutdown();
+    ImGui::GetIO().BackendPlatformName = NULL;
+}
+
+void HeadlessLayerBackend::newFrame(uint32_t w, uint32_t h) {
+    ImGui_ImplOpenGL3_NewFrame();
+    ImGuiIO &io = ImGui::GetIO();
+    io.DisplaySize = ImVec2((float) w, (float) h);
+    io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+    // 固定步长，保证回放结果可重复
+    io.DeltaTime = 1.0f / 60.0f;
+}
+
+void HeadlessLayerBackend::renderDrawData(ImDrawData *drawData, uint32_t w, uint32_t h) {
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, (int) w, (int) h);
+    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
+    ImGui_ImplOpenGL3_RenderDrawData(drawData);
+}
+
+void HeadlessLayerBackend::present() {
+    if (finishOnPresent) {
+        glFinish();
+    } else {
+        glFlush();
+    }
+}
+
+bool HeadlessLayerBackend::readPixels(std::vector<uint8_t> &out) {
+    if (framebuffer == 0) {
+        return false;
+    }
+    out.resize((size_t) width * height * 4);
+    std::vector<uint8_t> row((size_t) width * 4);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, (GLsizei) width, (GLsizei) height, GL_RGBA, GL_UNSIGNED_BYTE, out.data());
+    // GL 原点在左下角，翻转成从上到下
+    size_t stride = (size_t) width * 4;
+    for (uint32_t y = 0; y < height / 2; y++) {
+        uint8_t *top = out.data() + y * stride;
+        uint8_t *bottom = out.data() + (height - 1 - y) * stride;
+        memcpy(row.data(), top, stride);
+        memcpy(top, bottom, stride);
+        memcpy(bottom, row.data(), stride);
+    }
+    return true;
+}
+
+uint32_t HeadlessLayerBackend::getWidth() const {
+    return width;
+}
+
+uint32_t HeadlessLayerBackend::getHeight() const {
+    return height;
+}
+
+void HeadlessLayerBackend::setFinishOnPresent(bool finish) {
+    finishOnPresent = finish;
+}
@@ -0,0 +1,96 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/LayerScheduler.h"
+#include <ctime>
+
+LayerScheduler::LayerScheduler(LayerRenderMode mode, float fps) :
+        mode(mode), frameInterval(intervalOf(fps)), idleInterval(0), dirtyFrames(1),
+        lastFrameNs(0), nextDeadlineNs(0), frameCount(0) {
+}
+
+int64_t LayerScheduler::intervalOf(float fps) {
+    if (fps <= 0.0f) {
+        return 0;
+    }
+    return (int64_t) (1000000000.0 / fps);
+}
+
+int64_t LayerScheduler::nowNs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void LayerScheduler::setMode(LayerRenderMode m) {
+    mode = m;
+    markDirty(1);
+}
+
+LayerRenderMode LayerScheduler::getMode() const {
+    return (LayerRenderMode) mode.load();
+}
+
+void LayerScheduler::setFps(float fps) {
+    frameInterval = intervalOf(fps);
+}
+
+float LayerScheduler::getFps() const {
+    int64_t interval = frameInterval;
+    return interval > 0 ? (float) (1000000000.0 / (double) interval) : 0.0f;
+}
+
+void LayerScheduler::setIdleFps(float fps) {
+    idleInterval = intervalOf(fps);
+}
+
+void LayerScheduler::markDirty(int frames) {
+    int current = dirtyFrames.load();
+    while (current < frames && !dirtyFrames.compare_exchange_weak(current, frames)) {
+    }
+}
+
+bool LayerScheduler::isDirty() const {
+    return dirtyFrames.load() > 0;
+}
+
+bool LayerScheduler::shouldRender(int64_t now) const {
+    return nextWakeupNs(now) <= now;
+}
+
+int64_t LayerScheduler::nextWakeupNs(int64_t now) const {
+    if (frameCount == 0) {
+        return now;
+    }
+    int64_t deadline = nextDeadlineNs;
+    if (mode == LayerRender_Continuous || dirtyFrames > 0) {
+        return deadline;
+    }
+    // OnChange 且没有变化
+    int64_t idle = idleInterval;
+    if (idle <= 0) {
+        return NEVER;
+    }
+    int64_t idleDeadline = lastFrameNs + idle;
+    return idleDeadline > deadline ? idleDeadline : deadline;
+}
+
+void LayerScheduler::onFrameRendered(int64_t now) {
+    int64_t interval = frameInterval;
+    int64_t deadline = nextDeadlineNs + interval;
+    // 掉帧太多时重新对齐，避免连续补帧
+    if (frameCount == 0 || deadline + interval < now) {
+        deadline = now + interval;
+    }
+    nextDeadlineNs = deadline;
+    lastFrameNs = now;
+    frameCount++;
+    int current = dirtyFrames.load();
+    while (current > 0 && !dirtyFrames.compare_exchange_weak(current, current - 1)) {
+    }
+}
+
+uint64_t LayerScheduler::getFrameCount() const {
+    return frameCount;
+}
@@ -0,0 +1,381 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/OverlayLayer.h"
+#include "Android_draw/DrawListQueue.h"
+#include "Profiler.h"
+#include <backends/imgui_impl_android.h>
+#include <backends/imgui_impl_opengl3.h>
+#include <vector>
+#include <algorithm>
+#include <cstdio>
+
+// 所有已初始化的图层，用于分发触摸
+static std::mutex g_LayersMutex;
+static std::vector<OverlayLayer *> g_Layers;
+
+OverlayLayer::OverlayLayer(const LayerConfig &config, LayerBackend *backend) :
+        config(config), backend(backend), scheduler(config.mode, config.fps) {
+    scheduler.setIdleFps(config.idleFps);
+}
+
+OverlayLayer::~OverlayLayer() {
+    shutdown();
+    delete backend;
+}
+
+std::recursive_mutex &OverlayLayer::imguiMutex() {
+    static std::recursive_mutex mutex;
+    return mutex;
+}
+
+void OverlayLayer::registerLayer(OverlayLayer *layer) {
+    std::lock_guard<std::mutex> lock(g_LayersMutex);
+    g_Layers.push_back(layer);
+    std::stable_sort(g_Layers.begin(), g_Layers.end(), [](OverlayLayer *a, OverlayLayer *b) {
+        return a->config.zOrder > b->config.zOrder;
+    });
+}
+
+void OverlayLayer::unregisterLayer(OverlayLayer *layer) {
+    std::lock_guard<std::mutex> lock(g_LayersMutex);
+    g_Layers.erase(std::remove(g_Layers.begin(), g_Layers.end(), layer), g_Layers.end());
+}
+
+bool OverlayLayer::init(OverlayLayer *share) {
+    if (initialized) {
+        return true;
+    }
+    if (backend == nullptr) {
+        return false;
+    }
+    if (!backend->create(config, share != nullptr ? share->backend : nullptr)) {
+        printf("OverlayLayer %s: create backend failed\n", config.name);
+        backend->destroy();
+        return false;
+    }
+    {
+        std::lock_guard<std::recursive_mutex> lock(imguiMutex());
+        ImGuiContext *prev = ImGui::GetCurrentContext();
+        context = ImGui::CreateContext(config.fonts);
+        ImGui::SetCurrentContext(context);
+        ImGuiIO &io = ImGui::GetIO();
+        io.IniFilename = NULL;
+        ImGui::StyleColorsDark();
+        if (io.Fonts->Fonts.empty()) {
+            ImFontConfig font_cfg;
+            font_cfg.SizePixels = 22.0f;
+            if (config.sdfFont) {
+                io.Fonts->Flags |= ImFontAtlasFlags_SignedDistanceField;
+            }
+            io.Fonts->AddFontDefault(&font_cfg);
+        }
+        ImGui::GetStyle().ScaleAllSizes(3.0f);
+        bool ok = backend->initImGui();
+        ImGui::SetCurrentContext(prev != nullptr ? prev : context);
+        if (!ok) {
+            printf("OverlayLayer %s: init imgui backend failed\n", config.name);
+            ImGui::DestroyContext(context);
+            context = nullptr;
+            backend->destroy();
+            return false;
+        }
+    }
+    initialized = true;
+    registerLayer(this);
+    if (config.log) {
+        printf("OverlayLayer %s: %ux%u z:%d ok\n", config.name, config.width, config.height, config.zOrder);
+    }
+    return true;
+}
+
+void OverlayLayer::shutdown() {
+    if (!initialized) {
+        return;
+    }
+    stop();
+    unregisterLayer(this);
+    if (drawQueue != nullptr) {
+        // 等待后台线程录制完，之后队列里旧上下文的列表不再显示
+        drawQueue->detach();
+    }
+    backend->makeCurrent();
+    {
+        std::lock_guard<std::recursive_mutex> lock(imguiMutex());
+        ImGuiContext *prev = ImGui::GetCurrentContext();
+        ImGui::SetCurrentContext(context);
+        backend->shutdownImGui();
+        ImGui::DestroyContext(context);
+        ImGui::SetCurrentContext(prev != context ? prev : nullptr);
+        context = nullptr;
+    }
+    backend->destroy();
+    initialized = false;
+}
+
+void OverlayLayer::beginFrame() {
+    PROFILE_ZONE("OverlayLayer::beginFrame");
+    // GImGui 按线程保存，切换上下文不影响其他图层线程
+    prevContext = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(context);
+    applyInput();
+    {
+        // 后端第一帧从共享图集上传字体纹理并写 TexID，NewFrame 标记图集 Locked
+        std::lock_guard<std::recursive_mutex> lock(imguiMutex());
+        {
+            PROFILE_ZONE("backend newFrame");
+            backend->newFrame(config.width, config.height);
+        }
+        {
+            PROFILE_ZONE("ImGui::NewFrame");
+            ImGui::NewFrame();
+        }
+    }
+    if (drawQueue != nullptr) {
+        drawQueue->updateSharedData(*ImGui::GetDrawListSharedData(), ImGui::GetIO().Fonts->TexID);
+    }
+}
+
+void OverlayLayer::endFrame() {
+    PROFILE_ZONE("OverlayLayer::endFrame");
+    {
+        // EndFrame 解除共享图集的 Locked，Render 本身只读写图层自己的上下文
+        std::lock_guard<std::recursive_mutex> lock(imguiMutex());
+        ImGui::EndFrame();
+    }
+    {
+        PROFILE_ZONE("ImGui::Render");
+        ImGui::Render();
+    }
+    ImDrawData *drawData = ImGui::GetDrawData();
+    if (drawQueue != nullptr) {
+        drawData = drawQueue->splice(drawData);
+    }
+    {
+        PROFILE_ZONE("renderDrawData");
+        backend->renderDrawData(drawData, config.width, config.height);
+    }
+    publishRenderStats();
+    if (prevContext != nullptr && prevContext != context) {
+        ImGui::SetCurrentContext(prevContext);
+    }
+    prevContext = nullptr;
+    {
+        PROFILE_ZONE("present");
+        backend->present();
+    }
+    scheduler.onFrameRendered(LayerScheduler::nowNs());
+}
+
+// 最近一次 renderDrawData 的统计，来自当前上下文的 OpenGL3 渲染后端；后端没有初始化(mock)或还没画过时返回false
+static bool readRenderStats(LayerRenderStats &stats) {
+    ImGui_ImplOpenGL3_FrameStats frame;
+    if (!ImGui_ImplOpenGL3_GetFrameStats(&frame)) {
+        return false;
+    }
+    stats.frame = frame.FrameIndex;
+    stats.drawCalls = frame.DrawCalls;
+    stats.stateChanges = frame.StateChanges;
+    stats.textureBinds = frame.TextureBinds;
+    stats.bytesUploaded = frame.BytesUploaded;
+    stats.userCallbacks = frame.UserCallbacks;
+    stats.gpuTimeMs = frame.GpuTimeMs;
+    stats.gpuCallbackMs = -1.0f;
+    if (frame.GpuTimeMs >= 0.0f) {
+        stats.gpuCallbackMs = 0.0f;
+        for (int i = 0; i < frame.GpuCallbackCount; i++) {
+            stats.gpuCallbackMs += frame.GpuCallbackTimeMs[i];
+        }
+    }
+    stats.gpuLatency = frame.GpuFrameLatency;
+    return true;
+}
+
+void OverlayLayer::publishRenderStats() {
+    LayerRenderStats stats;
+    if (!readRenderStats(stats)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(statsMutex);
+        renderStats = stats;
+        hasRenderStats = true;
+    }
+#if defined(NATIVE_SURFACE_PROFILER)
+    if (!Profiler::isEnabled()) {
+        return;
+    }
+    char name[64];
+    snprintf(name, sizeof(name), "%s draw calls", config.name);
+    PROFILE_COUNTER(name, stats.drawCalls);
+    snprintf(name, sizeof(name), "%s state changes", config.name);
+    PROFILE_COUNTER(name, stats.stateChanges);
+    snprintf(name, sizeof(name), "%s texture binds", config.name);
+    PROFILE_COUNTER(name, stats.textureBinds);
+    snprintf(name, sizeof(name), "%s upload KB", config.name);
+    PROFILE_COUNTER(name, (double) stats.bytesUploaded / 1024.0);
+    if (stats.gpuTimeMs >= 0.0f) {
+        snprintf(name, sizeof(name), "%s gpu ms", config.name);
+        PROFILE_COUNTER(name, stats.gpuTimeMs);
+        snprintf(name, sizeof(name), "%s gpu callback ms", config.name);
+        PROFILE_COUNTER(name, stats.gpuCallbackMs);
+    }
+#endif
+}
+
+bool OverlayLayer::getRenderStats(LayerRenderStats &stats) const {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    stats = renderStats;
+    return hasRenderStats;
+}
+
+void OverlayLayer::renderFrame() {
+    beginFrame();
+    if (callback) {
+        callback(*this);
+    }
+    endFrame();
+}
+
+bool OverlayLayer::start(DrawCallback cb) {
+    if (!initialized || running) {
+        return false;
+    }
+    callback = std::move(cb);
+    // 上下文只能在一个线程生效，交给图层线程
+    backend->releaseCurrent();
+    running = true;
+    thread = std::thread(&OverlayLayer::renderLoop, this);
+    return true;
+}
+
+void OverlayLayer::stop() {
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCond.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+    backend->makeCurrent();
+}
+
+bool OverlayLayer::isRunning() const {
+    return running;
+}
+
+void OverlayLayer::renderLoop() {
+    PROFILE_THREAD(config.name);
+    backend->makeCurrent();
+    while (running) {
+        int64_t now = LayerScheduler::nowNs();
+        if (scheduler.shouldRender(now)) {
+            renderFrame();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        int64_t wakeup = scheduler.nextWakeupNs(now);
+        if (wakeup == LayerScheduler::NEVER) {
+            wakeCond.wait(lock, [this] { return !running || scheduler.isDirty(); });
+        } else {
+            wakeCond.wait_for(lock, std::chrono::nanoseconds(wakeup - now), [this] {
+                return !running || scheduler.shouldRender(LayerScheduler::nowNs());
+            });
+        }
+    }
+    backend->releaseCurrent();
+}
+
+void OverlayLayer::markDirty(int frames) {
+    scheduler.markDirty(frames);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCond.notify_all();
+}
+
+void OverlayLayer::setFps(float fps) {
+    scheduler.setFps(fps);
+    markDirty(1);
+}
+
+void OverlayLayer::setMode(LayerRenderMode mode) {
+    scheduler.setMode(mode);
+    markDirty(1);
+}
+
+LayerScheduler &OverlayLayer::getScheduler() {
+    return scheduler;
+}
+
+const LayerConfig &OverlayLayer::getConfig() const {
+    return config;
+}
+
+ImGuiContext *OverlayLayer::getContext() const {
+    return context;
+}
+
+LayerBackend *OverlayLayer::getBackend() const {
+    return backend;
+}
+
+uint32_t OverlayLayer::getWidth() const {
+    return config.width;
+}
+
+uint32_t OverlayLayer::getHeight() const {
+    return config.height;
+}
+
+void OverlayLayer::setDrawListQueue(DrawListQueue *queue) {
+    if (drawQueue != nullptr && drawQueue != queue) {
+        drawQueue->detach();
+    }
+    drawQueue = queue;
+}
+
+DrawListQueue *OverlayLayer::getDrawListQueue() const {
+    return drawQueue;
+}
+
+void OverlayLayer::dispatchInput(const ImGuInputEvent &event) {
+    // 持有图层列表锁直到分发结束，保证目标图层不会在分发过程中被销毁
+    std::lock_guard<std::mutex> layersLock(g_LayersMutex);
+    OverlayLayer *target = nullptr;
+    for (OverlayLayer *layer: g_Layers) {
+        if (layer->config.acceptInput) {
+            target = layer;
+            break;
+        }
+    }
+    if (target == nullptr) {
+        return;
+    }
+    {
+        // 目标图层可能正在自己的线程上绘制，不能直接改它的 ImGuiIO
+        std::lock_guard<std::mutex> lock(target->inputMutex);
+        target->pendingInput.push_back(event);
+    }
+    target->markDirty(3);
+}
+
+void OverlayLayer::applyInput() {
+    std::lock_guard<std::mutex> lock(inputMutex);
+    if (pendingInput.empty()) {
+        return;
+    }
+    ImGuiIO &io = ImGui::GetIO();
+    for (const ImGuInputEvent &event: pendingInput) {
+        if (event.type == IM_DOWN || event.type == IM_UP) {
+            io.MouseDown[0] = (event.type == IM_DOWN);
+        }
+        io.MousePos = event.pos;
+    }
+    pendingInput.clear();
+}
@@ -0,0 +1,141 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_draw/OverlayPanel.h"
+#include "Android_draw/DrawListQueue.h"
+#include "Profiler.h"
+
+OverlayPanel::OverlayPanel(const PanelConfig &config, DrawListQueue *queue, ImFontAtlas *fonts,
+                           const ImGuiStyle *style) :
+        config(config), queue(queue), scheduler(config.mode, config.fps) {
+    channel = queue->createChannel(config.name, config.order);
+    // 只创建不切换，当前线程原来的上下文不受影响
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    context = ImGui::CreateContext(fonts);
+    ImGui::SetCurrentContext(context);
+    ImGuiIO &io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    if (style != nullptr) {
+        ImGui::GetStyle() = *style;
+    } else {
+        ImGui::StyleColorsDark();
+    }
+    ImGui::SetCurrentContext(prev);
+}
+
+OverlayPanel::~OverlayPanel() {
+    stop();
+    queue->destroyChannel(channel);
+    ImGui::DestroyContext(context);
+}
+
+bool OverlayPanel::renderFrame() {
+    PROFILE_ZONE("OverlayPanel::renderFrame");
+    // 先登记录制，图层取消关联(重建)时等待本帧提交，期间字体图集不会被改动
+    ImDrawList *list = channel->begin();
+    if (list == nullptr) {
+        skippedCount.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    int64_t now = LayerScheduler::nowNs();
+    ImGuiContext *prev = ImGui::GetCurrentContext();
+    ImGui::SetCurrentContext(context);
+    ImGuiIO &io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(config.width, config.height);
+    if (lastFrameNs != 0 && now > lastFrameNs) {
+        io.DeltaTime = (float) (now - lastFrameNs) / 1e9f;
+    } else {
+        io.DeltaTime = 1.0f / (config.fps > 0.0f ? config.fps : 60.0f);
+    }
+    lastFrameNs = now;
+    ImGui::NewFrame();
+    if (callback) {
+        callback(*this);
+    }
+    ImGui::Render();
+    channel->submit(ImGui::GetDrawData(), ImVec2(config.x, config.y));
+    ImGui::SetCurrentContext(prev);
+    frameCount.fetch_add(1, std::memory_order_relaxed);
+    scheduler.onFrameRendered(LayerScheduler::nowNs());
+    return true;
+}
+
+bool OverlayPanel::start(DrawCallback cb) {
+    if (running) {
+        return false;
+    }
+    callback = std::move(cb);
+    running = true;
+    thread = std::thread(&OverlayPanel::renderLoop, this);
+    return true;
+}
+
+void OverlayPanel::stop() {
+    if (!running) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        running = false;
+    }
+    wakeCond.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+bool OverlayPanel::isRunning() const {
+    return running;
+}
+
+void OverlayPanel::renderLoop() {
+    PROFILE_THREAD(config.name);
+    while (running) {
+        int64_t now = LayerScheduler::nowNs();
+        if (scheduler.shouldRender(now)) {
+            if (!renderFrame()) {
+                // 跳过的帧不算绘制，按帧间隔等待图层恢复关联
+                scheduler.onFrameRendered(now);
+            }
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        int64_t wakeup = scheduler.nextWakeupNs(now);
+        if (wakeup == LayerScheduler::NEVER) {
+            wakeCond.wait(lock, [this] { return !running || scheduler.isDirty(); });
+        } else {
+            wakeCond.wait_for(lock, std::chrono::nanoseconds(wakeup - now), [this] {
+                return !running || scheduler.shouldRender(LayerScheduler::nowNs());
+            });
+        }
+    }
+}
+
+void OverlayPanel::markDirty(int frames) {
+    scheduler.markDirty(frames);
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wakeCond.notify_all();
+}
+
+LayerScheduler &OverlayPanel::getScheduler() {
+    return scheduler;
+}
+
+const PanelConfig &OverlayPanel::getConfig() const {
+    return config;
+}
+
+ImGuiContext *OverlayPanel::getContext() const {
+    return context;
+}
+
+uint64_t OverlayPanel::getFrameCount() const {
+    return frameCount;
+}
+
+uint64_t OverlayPanel::getSkippedCount() const {
+    return skippedCount;
+}
@@ -5,15 +5,40 @@
 #include "Android_draw/draw.h"
 
 // Var
-EGLDisplay display = EGL_NO_DISPLAY;
-EGLConfig config;
-EGLSurface surface = EGL_NO_SURFACE;
-ANativeWindow *native_window;
+#ifndef NATIVE_SURFACE_HEADLESS
 ExternFunction externFunction;
-EGLContext context = EGL_NO_CONTEXT;
+#endif
 MDisplayInfo displayInfo;
 uint32_t orientation = 0;
 bool g_Initialized = false;
+// 主图层，initDraw/drawBegin/drawEnd 操作的就是它
+static OverlayLayer *g_MainLayer = nullptr;
+// 后台线程绘制队列，主图层重建(横竖屏切换)时保留，通道不受影响
+static DrawListQueue g_DrawQueue;
+// 主图层与 OverlayPanel 共享的字体图集，主图层重建时保留(面板的上下文一直引用它)
+static ImFontAtlas *g_SharedFonts = nullptr;
+
+#if !__has_include(<font/Font.h>)
+// 自定义控件(imgui_widgets.cpp)引用的字体由 font/Font.h 提供，缺失时给出空定义
+ImFont *iconfont = nullptr;
+ImFont *info_little = nullptr;
+ImFont *two = nullptr;
+ImFont *three = nullptr;
+ImFont *tabsf = nullptr;
+ImFont *ee = nullptr;
+ImFont *themefont = nullptr;
+ImFont *info = nullptr;
+int binda = 0;
+ImDrawList *draw = nullptr;
+#endif
+
+static LayerBackend *newLayerBackend() {
+#ifdef NATIVE_SURFACE_HEADLESS
+    return new HeadlessLayerBackend();
+#else
+    return new EglLayerBackend();
+#endif
+}
 
 bool initDraw(bool log) {
     screen_config();
@@ -22,114 +47,98 @@ bool initDraw(bool log) {
 }
 
 bool initDraw(uint32_t _screen_x, uint32_t _screen_y, bool log) {
-    if (!init_egl(_screen_x, _screen_y, log)) {
+    if (g_Initialized) {
+        return true;
+    }
+    // drawBegin/drawEnd 必须在调用 initDraw 的线程上
+    PROFILE_THREAD("draw");
+    LayerConfig config;
+    config.name = "Ssage";
+    config.width = _screen_x;
+    config.height = _screen_y;
+    config.acceptInput = true;
+    config.log = log;
+    if (g_SharedFonts == nullptr) {
+        g_SharedFonts = IM_NEW(ImFontAtlas)();
+    }
+    config.fonts = g_SharedFonts;
+#if defined(NATIVE_SURFACE_PROFILER)
+    // 分析构建同时统计GPU耗时
+    config.gpuTimer = true;
+#endif
+    g_MainLayer = new OverlayLayer(config, newLayerBackend());
+    if (!g_MainLayer->init()) {
+        delete g_MainLayer;
+        g_MainLayer = nullptr;
         return false;
     }
-    return ImGui_init();
+    g_MainLayer->setDrawListQueue(&g_DrawQueue);
+    g_Initialized = true;
+    return true;
 }
 
-bool init_egl(uint32_t _screen_x, uint32_t _screen_y, bool log) {
-    native_window = externFunction.createNativeWindow("Ssage",
-                                                      _screen_x, _screen_y, false);
-    ANativeWindow_acquire(native_window);
-    display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    if (display == EGL_NO_DISPLAY) {
-        printf("eglGetDisplay error=%u\n", glGetError());
-        return false;
-    }
-    if (log) {
-        printf("eglGetDisplay ok\n");
-    }
-    if (eglInitialize(display, 0, 0) != EGL_TRUE) {
-        printf("eglInitialize error=%u\n", glGetError());
-        return false;
+OverlayLayer *createOverlayLayer(LayerConfig config, OverlayLayer *share) {
+    if (config.width == 0 || config.height == 0) {
+        if (displayInfo.width == 0) {
+            screen_config();
+        }
+        config.width = displayInfo.width;
+        config.height = displayInfo.height;
     }
-    if (log) {
-        printf("eglInitialize ok\n");
+    auto *layer = new OverlayLayer(config, newLayerBackend());
+    if (!layer->init(share != nullptr ? share : g_MainLayer)) {
+        delete layer;
+        return nullptr;
     }
-    EGLint num_config = 0;
-    const EGLint attribList[] = {
-            EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
-            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
-            EGL_BLUE_SIZE, 5,   //-->delete
-            EGL_GREEN_SIZE, 6,  //-->delete
-            EGL_RED_SIZE, 5,    //-->delete
-            EGL_BUFFER_SIZE, 32,  //-->new field
-            EGL_DEPTH_SIZE, 16,
-            EGL_STENCIL_SIZE, 8,
-            EGL_NONE
-    };
-    const EGLint attrib_list[] = {
-            EGL_CONTEXT_CLIENT_VERSION,
-            3,
-            EGL_NONE
-    };
+    return layer;
+}
 
-    if (log) {
-        printf("num_config=%d\n", num_config);
-    }
-    if (eglChooseConfig(display, attribList, &config, 1, &num_config) != EGL_TRUE) {
-        printf("eglChooseConfig  error=%u\n", glGetError());
-        return false;
-    }
-    if (log) {
-        printf("eglChooseConfig ok\n");
-    }
-    EGLint egl_format;
-    eglGetConfigAttrib(display, config, EGL_NATIVE_VISUAL_ID, &egl_format);
-    ANativeWindow_setBuffersGeometry(native_window, 0, 0, egl_format);
-    context = eglCreateContext(display, config, EGL_NO_CONTEXT, attrib_list);
-    if (context == EGL_NO_CONTEXT) {
-        printf("eglCreateContext  error = %u\n", glGetError());
-        return false;
-    }
-    if (log) {
-        printf("eglCreateContext ok\n");
-    }
-    surface = eglCreateWindowSurface(display, config, native_window, nullptr);
-    if (surface == EGL_NO_SURFACE) {
-        printf("eglCreateWindowSurface  error = %u\n", glGetError());
-        return false;
-    }
-    if (log) {
-        printf("eglCreateWindowSurface ok\n");
-    }
-    if (!eglMakeCurrent(display, surface, surface, context)) {
-        printf("eglMakeCurrent  error = %u\n", glGetError());
-        return false;
-    }
-    if (log) {
-        printf("eglMakeCurrent ok\n");
-        printf("createNativeWindow ok\n");
-    }
-    return true;
+OverlayLayer *getMainLayer() {
+    return g_MainLayer;
 }
 
-void screen_config() {
-    displayInfo = externFunction.getDisplayInfo();
+DrawListQueue *getDrawListQueue() {
+    return &g_DrawQueue;
 }
 
-bool ImGui_init() {
-    if (g_Initialized) {
-        return true;
+OverlayPanel *createOverlayPanel(const PanelConfig &config) {
+    if (g_MainLayer == nullptr) {
+        return nullptr;
+    }
+    ImGuiStyle style;
+    {
+        std::lock_guard<std::recursive_mutex> lock(OverlayLayer::imguiMutex());
+        ImGuiContext *prev = ImGui::GetCurrentContext();
+        ImGui::SetCurrentContext(g_MainLayer->getContext());
+        style = ImGui::GetStyle();
+        ImGui::SetCurrentContext(prev);
+    }
+    return new OverlayPanel(config, &g_DrawQueue, g_SharedFonts, &style);
+}
+
+void screen_config() {
+#ifdef NATIVE_SURFACE_HEADLESS
+    // 离屏构建没有屏幕，默认1080x2400竖屏，可用环境变量 HEADLESS_SIZE=宽x高 修改
+    if (displayInfo.width == 0) {
+        uint32_t w = 1080, h = 2400;
+        const char *size = getenv("HEADLESS_SIZE");
+        if (size != nullptr) {
+            sscanf(size, "%ux%u", &w, &h);
+        }
+        displayInfo = {w, h, 0};
     }
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
-    ImGuiIO &io = ImGui::GetIO();
-    io.IniFilename = NULL;
-    ImGui::StyleColorsDark();
-    ImGui_ImplAndroid_Init(native_window);
-    ImGui_ImplOpenGL3_Init("#version 300 es");
-    ImFontConfig font_cfg;
-    font_cfg.SizePixels = 22.0f;
-    io.Fonts->AddFontDefault(&font_cfg);
-    ImGui::GetStyle().ScaleAllSizes(3.0f);
-    g_Initialized = true;
-    return true;
+#else
+    displayInfo = externFunction.getDisplayInfo();
+#endif
 }
 
 void drawBegin() {
-    screen_config();
+    PROFILE_ZONE("drawBegin");
+    {
+        // 非离屏构建时是一次 binder 调用
+        PROFILE_ZONE("screen_config");
+        screen_config();
+    }
     if (orientation != displayInfo.orientation) {
 //        externFunction.setSurfaceWH(displayInfo.width, displayInfo.height);
         shutdown();
@@ -138,23 +147,15 @@ void drawBegin() {
         cout << " width:" << displayInfo.width << "height:" << displayInfo.height << " orientation:"
              << displayInfo.orientation << endl;
     }
-    ImGui_ImplOpenGL3_NewFrame();
-    ImGui_ImplAndroid_NewFrame((int32_t) displayInfo.width, (int32_t) displayInfo.height);
-    ImGui::NewFrame();
+    g_MainLayer->beginFrame();
 }
 
 void drawEnd() {
-    ImGuiIO &io = ImGui::GetIO();
-    glViewport(0.0f, 0.0f, (int) io.DisplaySize.x, (int) io.DisplaySize.y);
-    glClearColor(0.0f, 0.0f, 0.0f, 0.0f);
-    glClear(GL_COLOR_BUFFER_BIT); // GL_DEPTH_BUFFER_BIT
-    glFlush();
-    if (display == EGL_NO_DISPLAY) {
-        return;
+    {
+        PROFILE_ZONE("drawEnd");
+        g_MainLayer->endFrame();
     }
-    ImGui::Render();
-    ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-    eglSwapBuffers(display, surface);
+    PROFILE_FRAME();
 }
 
 
@@ -163,22 +164,7 @@ void shutdown() {
         return;
     }
     // Cleanup
-    ImGui_ImplOpenGL3_Shutdown();
-    ImGui_ImplAndroid_Shutdown();
-    ImGui::DestroyContext();
-    if (display != EGL_NO_DISPLAY) {
-        eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-        if (context != EGL_NO_CONTEXT) {
-            eglDestroyContext(display, context);
-        }
-        if (surface != EGL_NO_SURFACE) {
-            eglDestroySurface(display, surface);
-        }
-        eglTerminate(display);
-    }
-    display = EGL_NO_DISPLAY;
-    context = EGL_NO_CONTEXT;
-    surface = EGL_NO_SURFACE;
-    ANativeWindow_release(native_window);
+    delete g_MainLayer;
+    g_MainLayer = nullptr;
     g_Initialized = false;
 }
@@ -0,0 +1,94 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Android_touch/TouchParser.h"
+#include <linux/input.h>
+
+#define UP 0x0
+#define DOWN 0x1
+
+ImVec2 rotatePointx(uint32_t orientation, ImVec2 mxy, ImVec2 wh) {
+    if (orientation == 0) {
+        return mxy;
+    }
+    ImVec2 xy(mxy.x, mxy.y);
+    if (orientation == 3) {
+        xy.x = (float) wh.y - mxy.y;
+        xy.y = mxy.x;
+    } else if (orientation == 2) {
+        xy.x = (float) wh.x - mxy.x;
+        xy.y = (float) wh.y - mxy.y;
+    } else if (orientation == 1) {
+        xy.x = mxy.y;
+        xy.y = (float) wh.x - mxy.x;
+    }
+    return xy;
+}
+
+void TouchParser::setTouchSize(ImVec2 size) {
+    if (size.x > 0 && size.y > 0) {
+        touchSize = size;
+    }
+}
+
+void TouchParser::setDisplay(uint32_t displayWidth, uint32_t displayHeight, uint32_t displayOrientation) {
+    width = displayWidth;
+    height = displayHeight;
+    orientation = displayOrientation;
+}
+
+void TouchParser::reset() {
+    events.clear();
+    fingerIndex = 0;
+    eventX = eventY = 0;
+}
+
+bool TouchParser::push(uint16_t type, uint16_t code, int32_t value, ImGuInputEvent &out) {
+    if (!(type == EV_SYN && code == SYN_REPORT && value == 0)) {
+        events.push_back({type, code, value});
+        return false;
+    }
+    int status = IM_MOVE;
+    for (const TouchRawEvent &e: events) {
+        switch (e.type) {
+            case EV_KEY: {
+                if (e.code == BTN_TOUCH) {
+                    if (e.value == DOWN) {
+                        status = IM_DOWN;
+                    } else if (e.value == UP) {
+                        status = IM_UP;
+                        break;
+                    }
+                }
+                break;
+            }
+            case EV_ABS: {
+                if (e.code == ABS_MT_SLOT) {
+                    fingerIndex = e.value;
+                } else if (fingerIndex == 0) {
+                    if (e.code == ABS_MT_POSITION_X) {
+                        eventX = e.value;
+                    } else if (e.code == ABS_MT_POSITION_Y) {
+                        eventY = e.value;
+                    }
+                }
+            }
+        }
+    }
+    events.clear();
+    if (fingerIndex != 0) {
+        return false;
+    }
+    // 触摸屏坐标是竖屏的，横屏时宽高交换
+    uint32_t touchWidth = width, touchHeight = height;
+    if (orientation == 1 || orientation == 3) {
+        touchWidth = height;
+        touchHeight = width;
+    }
+    ImVec2 point = rotatePointx(orientation, {(float) eventX, (float) eventY}, touchSize);
+    out.fingerIndex = fingerIndex;
+    out.pos = ImVec2((point.x * (float) touchWidth) / touchSize.x, (point.y * (float) touchHeight) / touchSize.y);
+    out.type = status;
+    return true;
+}
@@ -2,6 +2,8 @@
 // Created by 泓清 on 2022/8/26.
 //
 #include "Android_touch/touch.h"
+#include "Profiler.h"
+#include <atomic>
 
 
 #define FROM_SCREEN 0x0
@@ -54,24 +56,6 @@ std::string getTouchScreenDevice() {
 }
 
 
-ImVec2 rotatePointx(uint32_t orientation, ImVec2 mxy, ImVec2 wh) {
-    if (orientation == 0) {
-        return mxy;
-    }
-    ImVec2 xy(mxy.x, mxy.y);
-    if (orientation == 3) {
-        xy.x = (float) wh.y - mxy.y;
-        xy.y = mxy.x;
-    } else if (orientation == 2) {
-        xy.x = (float) wh.x - mxy.x;
-        xy.y = (float) wh.y - mxy.y;
-    } else if (orientation == 1) {
-        xy.x = mxy.y;
-        xy.y = (float) wh.x - mxy.x;
-    }
-    return xy;
-}
-
 ImVec2 getTouchScreenDimension(int fd) {
     int abs_x[6], abs_y[6] = {0};
     ioctl(fd, EVIOCGABS(ABS_MT_POSITION_X), abs_x);
@@ -79,17 +63,15 @@ ImVec2 getTouchScreenDimension(int fd) {
     return {(float) abs_x[2], (float) abs_y[2]};
 }
 
-MDisplayInfo getTouchDisplyInfo() {
-    if (displayInfo.orientation == 0 || displayInfo.orientation == 2) {
-        return displayInfo;
-    } else {
-        return {displayInfo.height, displayInfo.width, displayInfo.orientation};
-    }
-}
-
 bool touchFlag = false;
+std::atomic<SessionWriter *> touchRecorder{nullptr};
+
+void touchSetRecorder(SessionWriter *writer) {
+    touchRecorder.store(writer);
+}
 
 void touch_config() {
+    PROFILE_THREAD("touch");
     std::string device = getTouchScreenDevice();
     // printf("touch event : %s\n",device.c_str());
     if (device.length() < 2) {
@@ -103,73 +85,32 @@ void touch_config() {
     }
     // 屏蔽触摸
 //    ioctl(touch_device_fd, EVIOCGRAB, GRAB);
-    // 触摸事件队列
-    vector<input_event> events;
-    // 手指编号
-    int fingerIndex = 0;
-    // 触摸位置
-    int eventX = 0, eventY = 0;
+    // 事件按 SYN_REPORT 分组解析，和回放共用 TouchParser
+    TouchParser parser;
+    // 录制时同一组事件一起写入
+    std::vector<SessionTouchEvent> recorded;
     input_event event{};
     ImVec2 touch_screen_size = getTouchScreenDimension(touch_device_fd);
+    parser.setTouchSize(touch_screen_size);
+    if (SessionWriter *recorder = touchRecorder.load()) {
+        recorder->writeTouchDevice((int) touch_screen_size.x, (int) touch_screen_size.y);
+    }
     while (touchFlag) {
         if (read(touch_device_fd, &event, sizeof(event)) > 0) {
-            if (event.type == EV_SYN && event.code == SYN_REPORT && event.value == 0) {
-                int status = IM_MOVE;
-                for (input_event e: events) {
-                    switch (e.type) {
-                        case EV_KEY: {
-                            if (e.code == BTN_TOUCH) {
-                                if (e.value == DOWN) {
-                                    status = IM_DOWN;
-                                } else if (e.value == UP) {
-                                    status = IM_UP;
-                                    break;
-                                }
-                            }
-                            break;
-                        }
-                        case EV_ABS: {
-                            if (e.code == ABS_MT_SLOT) {
-                                fingerIndex = e.value;
-                            } else if (fingerIndex == 0) {
-                                if (e.code == ABS_MT_POSITION_X) {
-                                    eventX = e.value;
-                                } else if (e.code == ABS_MT_POSITION_Y) {
-                                    eventY = e.value;
-                                }
-                            }
-                        }
-                    }
-                }
-
-                events.clear();
-
-                if (fingerIndex != 0) {
-                    continue;
-                }
-
-                MDisplayInfo mDisplayInfo = getTouchDisplyInfo();
-                ImVec2 point = rotatePointx(mDisplayInfo.orientation, {(float) eventX, (float) eventY},
-                                            touch_screen_size);
-                ImVec2 newEvent((point.x * (float) mDisplayInfo.width) / touch_screen_size.x,
-                                (point.y * (float) mDisplayInfo.height) / touch_screen_size.y);
-                ImGuInputEvent imGuInputEvent{};
-                imGuInputEvent.fingerIndex = fingerIndex;
-                imGuInputEvent.pos = newEvent;
-
-                if (status == IM_DOWN) {           // 按下
-//                        printf("down x:%f y:%f\n", newEvent.x, newEvent.y);
-                    imGuInputEvent.type = IM_DOWN;
-                } else if (status == IM_MOVE) {    // 移动
-//                        printf("move x:%f y:%f\n", newEvent.x, newEvent.y);
-                    imGuInputEvent.type = IM_MOVE;
-                } else {                           // 放开
-//                        printf("up\n");
-                    imGuInputEvent.type = IM_UP;
+            SessionWriter *recorder = touchRecorder.load();
+            if (recorder != nullptr) {
+                recorded.push_back({event.type, event.code, event.value});
+                if (event.type == EV_SYN && event.code == SYN_REPORT) {
+                    recorder->writeTouch(recorded.data(), (int) recorded.size());
+                    recorded.clear();
                 }
-                ImGui_ImplLinux_HandleInputEvent(imGuInputEvent);
-            } else {
-                events.push_back(event);
+            }
+            parser.setDisplay(displayInfo.width, displayInfo.height, displayInfo.orientation);
+            ImGuInputEvent imGuInputEvent{};
+            if (parser.push(event.type, event.code, event.value, imGuInputEvent)) {
+                PROFILE_ZONE("touch event");
+                // 分发给最上层接收触摸的图层
+                OverlayLayer::dispatchInput(imGuInputEvent);
             }
         }
         std::this_thread::sleep_for(0.0001s);
@@ -30,6 +30,7 @@
 #include <linux/input.h>
 #include "ImGui/backends/imgui_impl_android.h"
 #include <time.h>
+#include <string.h>
 #include <android/native_window.h>
 #include <android/input.h>
 #include <android/keycodes.h>
@@ -37,10 +38,19 @@
 
 
 // Android data
-static double g_Time = 0.0;
-static ANativeWindow *g_Window;
+// 保存在 io.BackendPlatformUserData 中，多个ImGui上下文(多图层)各自计时
+struct ImGui_ImplAndroid_Data {
+    ANativeWindow *Window;
+    double Time;
+
+    ImGui_ImplAndroid_Data() { memset((void *) this, 0, sizeof(*this)); }
+};
 static char g_LogTag[] = "ImGuiExample";
 
+static ImGui_ImplAndroid_Data *ImGui_ImplAndroid_GetBackendData() {
+    return ImGui::GetCurrentContext() ? (ImGui_ImplAndroid_Data *) ImGui::GetIO().BackendPlatformUserData : NULL;
+}
+
 static ImGuiKey ImGui_ImplAndroid_KeyCodeToImGuiKey(int32_t key_code) {
     switch (key_code) {
         case AKEYCODE_TAB:
@@ -441,25 +451,38 @@ int32_t ImGui_ImplLinux_HandleInputEvent(ImGuInputEvent event) {
 }
 
 bool ImGui_ImplAndroid_Init(ANativeWindow *window) {
-    g_Window = window;
-    g_Time = 0.0;
+    ImGuiIO &io = ImGui::GetIO();
+    IM_ASSERT(io.BackendPlatformUserData == NULL && "Already initialized a platform backend!");
+    ImGui_ImplAndroid_Data *bd = IM_NEW(ImGui_ImplAndroid_Data)();
+    bd->Window = window;
+    bd->Time = 0.0;
 
     // Setup backend capabilities flags
-    ImGuiIO &io = ImGui::GetIO();
+    io.BackendPlatformUserData = (void *) bd;
     io.BackendPlatformName = "imgui_impl_android";
 
     return true;
 }
 
 void ImGui_ImplAndroid_Shutdown() {
+    ImGui_ImplAndroid_Data *bd = ImGui_ImplAndroid_GetBackendData();
+    if (bd == NULL) {
+        return;
+    }
+    ImGuiIO &io = ImGui::GetIO();
+    io.BackendPlatformName = NULL;
+    io.BackendPlatformUserData = NULL;
+    IM_DELETE(bd);
 }
 
 void ImGui_ImplAndroid_NewFrame(int32_t window_width, int32_t window_height) {
     ImGuiIO &io = ImGui::GetIO();
+    ImGui_ImplAndroid_Data *bd = ImGui_ImplAndroid_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplAndroid_Init()?");
 
     // Setup display size (every frame to accommodate for window resizing)
-    //int32_t window_width = ANativeWindow_getWidth(g_Window);
-    //int32_t window_height = ANativeWindow_getHeight(g_Window);
+    //int32_t window_width = ANativeWindow_getWidth(bd->Window);
+    //int32_t window_height = ANativeWindow_getHeight(bd->Window);
     int display_width = window_width;
     int display_height = window_height;
 
@@ -472,6 +495,6 @@ void ImGui_ImplAndroid_NewFrame(int32_t window_width, int32_t window_height) {
     struct timespec current_timespec;
     clock_gettime(CLOCK_MONOTONIC, &current_timespec);
     double current_time = (double) (current_timespec.tv_sec) + (current_timespec.tv_nsec / 1000000000.0);
-    io.DeltaTime = g_Time > 0.0 ? (float) (current_time - g_Time) : (float) (1.0f / 60.0f);
-    g_Time = current_time;
+    io.DeltaTime = bd->Time > 0.0 ? (float) (current_time - bd->Time) : (float) (1.0f / 60.0f);
+    bd->Time = current_time;
 }
@@ -14,6 +14,9 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2026-10-19: OpenGL: Count draw calls, state changes, texture binds and uploaded bytes per frame, skipping redundant glBindTexture()/glScissor() calls. Optional GPU timing of each frame and user callback with GL_EXT_disjoint_timer_query on ES 3.0, read back asynchronously. Added ImGui_ImplOpenGL3_GetFrameStats(), ImGui_ImplOpenGL3_SetGpuTimerEnabled(), ImGui_ImplOpenGL3_HasGpuTimer().
+//  2026-10-19: OpenGL: Render font atlases built with ImFontAtlasFlags_SignedDistanceField: draw commands using io.Fonts->TexID threshold the distance field in the fragment shader ("Sdf" uniform).
+//  2026-10-19: OpenGL: Upload the font atlas as a GL_R8 texture swizzled to (1,1,1,R) on ES 3.0+/GL 3.3+ when IMGUI_USE_ALPHA8_FONT_ATLAS is defined (4x less texture memory). Added ImGui_ImplOpenGL3_GetFontsTextureBytes().
 //  2021-12-15: OpenGL: Using buffer orphaning + glBufferSubData(), seems to fix leaks with multi-viewports with some Intel HD drivers.
 //  2021-08-23: OpenGL: Fixed ES 3.0 shader ("#version 300 es") use normal precision floats to avoid wobbly rendering at HD resolutions.
 //  2021-08-19: OpenGL: Embed and use our own minimal GL loader (imgui_impl_opengl3_loader.h), removing requirement and support for third-party loader.
@@ -171,20 +174,50 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
 #endif
 
+// GL ES 3.0+ and Desktop GL 3.3+ have single channel GL_R8 textures with component swizzle
+#if defined(IMGUI_USE_ALPHA8_FONT_ATLAS) && !defined(IMGUI_IMPL_OPENGL_ES2) && defined(GL_TEXTURE_SWIZZLE_R)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_ALPHA8_FONTS
+#endif
+
 // Desktop GL use extension detection
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_EXTENSIONS
 #endif
 
+// GL ES 3.0 has core query objects, GL_EXT_disjoint_timer_query adds the GL_TIME_ELAPSED_EXT target (our desktop loader doesn't include query functions)
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+#ifndef GL_TIME_ELAPSED_EXT
+#define GL_TIME_ELAPSED_EXT                 0x88BF
+#endif
+#ifndef GL_GPU_DISJOINT_EXT
+#define GL_GPU_DISJOINT_EXT                 0x8FBB
+#endif
+#define IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES      4   // Frames in flight: results are polled, never waited for. A frame is not timed when its slot is still pending.
+#define IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS    16  // Queries per frame. Time elapsed queries can't nest, so ImGui draws are split around each user callback.
+
+struct ImGui_ImplOpenGL3_GpuTimerFrame
+{
+    GLuint          Queries[IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS];
+    int             CallbackIndex[IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS];   // -1 for ImGui draws, otherwise index of the user callback in the frame
+    int             QueryCount;
+    int             CallbackCount;
+    unsigned int    FrameIndex;
+    bool            Pending;
+};
+#endif
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
     GLuint          GlVersion;               // Extracted at runtime using GL_MAJOR_VERSION, GL_MINOR_VERSION queries (e.g. 320 for GL 3.2)
     char            GlslVersionString[32];   // Specified by user or detected based on compile time GL settings.
     GLuint          FontTexture;
+    size_t          FontTextureBytes;        // Size of the uploaded font atlas texture
     GLuint          ShaderHandle;
     GLint           AttribLocationTex;       // Uniforms location
     GLint           AttribLocationProjMtx;
+    GLint           AttribLocationSdf;
     GLuint          AttribLocationVtxPos;    // Vertex attributes location
     GLuint          AttribLocationVtxUV;
     GLuint          AttribLocationVtxColor;
@@ -192,6 +225,14 @@ struct ImGui_ImplOpenGL3_Data
     GLsizeiptr      VertexBufferSize;
     GLsizeiptr      IndexBufferSize;
     bool            HasClipOrigin;
+    bool            HasTimerQuery;           // GL_EXT_disjoint_timer_query
+    bool            GpuTimerEnabled;
+    ImGui_ImplOpenGL3_FrameStats FrameCounters; // Accumulated until the end of the next RenderDrawData() (font uploads happen in NewFrame)
+    ImGui_ImplOpenGL3_FrameStats FrameStats;    // Last completed frame
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    ImGui_ImplOpenGL3_GpuTimerFrame GpuTimerFrames[IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES];
+    ImGui_ImplOpenGL3_GpuTimerFrame* GpuTimerCurrent;
+#endif
 
     ImGui_ImplOpenGL3_Data() { memset(this, 0, sizeof(*this)); }
 };
@@ -280,6 +321,17 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
             bd->HasClipOrigin = true;
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    GLint num_es_extensions = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &num_es_extensions);
+    for (GLint i = 0; i < num_es_extensions; i++)
+    {
+        const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+        if (extension != NULL && strcmp(extension, "GL_EXT_disjoint_timer_query") == 0)
+            bd->HasTimerQuery = true;
+    }
+#endif
+    bd->FrameCounters.GpuTimeMs = -1.0f;
 
     return true;
 }
@@ -308,6 +360,7 @@ void    ImGui_ImplOpenGL3_NewFrame()
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    bd->FrameCounters.StateChanges++;
 
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
     glEnable(GL_BLEND);
@@ -356,6 +409,7 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
+    glUniform1f(bd->AttribLocationSdf, 0.0f);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
     if (bd->GlVersion >= 330)
@@ -378,6 +432,67 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+// Read back finished frames without waiting. Results of frames overlapping a disjoint event (GPU frequency change, context loss) are dropped.
+static void ImGui_ImplOpenGL3_PollGpuTimers(ImGui_ImplOpenGL3_Data* bd, unsigned int frame_index)
+{
+    GLint disjoint = 0;
+    glGetIntegerv(GL_GPU_DISJOINT_EXT, &disjoint);
+    ImGui_ImplOpenGL3_GpuTimerFrame* latest = NULL;
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES; n++)
+    {
+        ImGui_ImplOpenGL3_GpuTimerFrame* frame = &bd->GpuTimerFrames[n];
+        if (!frame->Pending)
+            continue;
+        GLuint available = GL_FALSE;
+        for (int q = 0; q < frame->QueryCount; q++)
+        {
+            glGetQueryObjectuiv(frame->Queries[q], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+        }
+        if (!available && !disjoint)
+            continue;
+        frame->Pending = false;
+        if (disjoint || !available || (latest != NULL && latest->FrameIndex > frame->FrameIndex))
+            continue;
+        latest = frame;
+    }
+    if (latest == NULL)
+        return;
+
+    ImGui_ImplOpenGL3_FrameStats* stats = &bd->FrameCounters;
+    GLuint64 total_ns = 0;
+    stats->GpuCallbackCount = 0;
+    for (int q = 0; q < latest->QueryCount; q++)
+    {
+        GLuint elapsed_ns = 0; // 32-bit nanoseconds are enough for a frame
+        glGetQueryObjectuiv(latest->Queries[q], GL_QUERY_RESULT, &elapsed_ns);
+        total_ns += elapsed_ns;
+        int callback = latest->CallbackIndex[q];
+        if (callback >= 0 && callback < IM_ARRAYSIZE(stats->GpuCallbackTimeMs))
+        {
+            stats->GpuCallbackTimeMs[callback] = (float)((double)elapsed_ns / 1e6);
+            stats->GpuCallbackCount = callback + 1;
+        }
+    }
+    stats->GpuTimeMs = (float)((double)total_ns / 1e6);
+    stats->GpuFrameLatency = (int)(frame_index - latest->FrameIndex);
+}
+
+static void ImGui_ImplOpenGL3_BeginGpuSegment(ImGui_ImplOpenGL3_Data* bd, int callback_index)
+{
+    ImGui_ImplOpenGL3_GpuTimerFrame* frame = bd->GpuTimerCurrent;
+    frame->CallbackIndex[frame->QueryCount] = callback_index;
+    glBeginQuery(GL_TIME_ELAPSED_EXT, frame->Queries[frame->QueryCount++]);
+}
+
+static void ImGui_ImplOpenGL3_EndGpuSegment()
+{
+    glEndQuery(GL_TIME_ELAPSED_EXT);
+}
+#endif
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -432,10 +547,45 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
+    // Per frame counters, published at the end of the frame
+    ImGui_ImplOpenGL3_FrameStats* stats = &bd->FrameCounters;
+    const unsigned int frame_index = bd->FrameStats.FrameIndex + 1;
+
+    // Time the frame on the GPU: poll frames submitted earlier, then start the first segment of this one
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    bd->GpuTimerCurrent = NULL;
+    if (bd->HasTimerQuery && bd->GpuTimerEnabled)
+    {
+        ImGui_ImplOpenGL3_PollGpuTimers(bd, frame_index);
+        ImGui_ImplOpenGL3_GpuTimerFrame* frame = &bd->GpuTimerFrames[frame_index % IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES];
+        if (!frame->Pending)
+        {
+            if (frame->Queries[0] == 0)
+                glGenQueries(IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS, frame->Queries);
+            frame->QueryCount = 0;
+            frame->CallbackCount = 0;
+            frame->FrameIndex = frame_index;
+            bd->GpuTimerCurrent = frame;
+            ImGui_ImplOpenGL3_BeginGpuSegment(bd, -1);
+        }
+    }
+#endif
+
+    // Skip redundant texture binds and scissor changes. Unknown again after a user callback.
+    bool bound_texture_valid = false;
+    GLuint bound_texture = 0;
+    bool scissor_valid = false;
+    GLint scissor[4] = { 0, 0, 0, 0 };
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
 
+    // Signed distance field font atlas: only draw commands sampling it enable the distance threshold in the shader
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    const bool sdf_atlas = (atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
+    bool sdf_enabled = false;
+
     // Render command lists
     for (int n = 0; n < draw_data->CmdListsCount; n++)
     {
@@ -456,6 +606,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         }
         glBufferSubData(GL_ARRAY_BUFFER, 0, vtx_buffer_size, (const GLvoid*)cmd_list->VtxBuffer.Data);
         glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, idx_buffer_size, (const GLvoid*)cmd_list->IdxBuffer.Data);
+        stats->BytesUploaded += (size_t)vtx_buffer_size + (size_t)idx_buffer_size;
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -465,9 +616,34 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
+                {
                     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    sdf_enabled = false;
+                }
                 else
+                {
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+                    // Time the callback in its own segment (the rest of the frame stays in one segment once the queries run out)
+                    ImGui_ImplOpenGL3_GpuTimerFrame* frame = bd->GpuTimerCurrent;
+                    const bool timed = frame != NULL && frame->QueryCount + 2 <= IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS;
+                    if (timed)
+                    {
+                        ImGui_ImplOpenGL3_EndGpuSegment();
+                        ImGui_ImplOpenGL3_BeginGpuSegment(bd, frame->CallbackCount++);
+                    }
+                    pcmd->UserCallback(cmd_list, pcmd);
+                    if (timed)
+                    {
+                        ImGui_ImplOpenGL3_EndGpuSegment();
+                        ImGui_ImplOpenGL3_BeginGpuSegment(bd, -1);
+                    }
+#else
                     pcmd->UserCallback(cmd_list, pcmd);
+#endif
+                    stats->UserCallbacks++;
+                }
+                bound_texture_valid = false;
+                scissor_valid = false;
             }
             else
             {
@@ -478,10 +654,33 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y));
+                const GLint box[4] = { (int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y) };
+                if (!scissor_valid || memcmp(box, scissor, sizeof(box)) != 0)
+                {
+                    glScissor(box[0], box[1], box[2], box[3]);
+                    memcpy(scissor, box, sizeof(box));
+                    scissor_valid = true;
+                    stats->StateChanges++;
+                }
 
                 // Bind texture, Draw
-                glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID());
+                const GLuint texture = (GLuint)(intptr_t)pcmd->GetTexID();
+                if (!bound_texture_valid || texture != bound_texture)
+                {
+                    glBindTexture(GL_TEXTURE_2D, texture);
+                    bound_texture = texture;
+                    bound_texture_valid = true;
+                    stats->TextureBinds++;
+                    stats->StateChanges++;
+                }
+                const bool sdf = sdf_atlas && pcmd->GetTexID() == atlas->TexID;
+                if (sdf != sdf_enabled)
+                {
+                    glUniform1f(bd->AttribLocationSdf, sdf ? 1.0f : 0.0f);
+                    sdf_enabled = sdf;
+                    stats->StateChanges++;
+                }
+                stats->DrawCalls++;
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
                     glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset);
@@ -492,6 +691,21 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         }
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    if (bd->GpuTimerCurrent != NULL)
+    {
+        ImGui_ImplOpenGL3_EndGpuSegment();
+        bd->GpuTimerCurrent->Pending = true;
+        bd->GpuTimerCurrent = NULL;
+    }
+#endif
+
+    // Publish the frame counters. GPU timings are kept until newer results are read back.
+    stats->FrameIndex = frame_index;
+    bd->FrameStats = *stats;
+    stats->DrawCalls = stats->StateChanges = stats->TextureBinds = stats->UserCallbacks = 0;
+    stats->BytesUploaded = 0;
+
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     glDeleteVertexArrays(1, &vertex_array_object);
@@ -533,11 +747,6 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
     ImGuiIO& io = ImGui::GetIO();
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
 
-    // Build texture atlas
-    unsigned char* pixels;
-    int width, height;
-    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
-
     // Upload texture to graphics system
     GLint last_texture;
     glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture);
@@ -548,7 +757,40 @@ bool ImGui_ImplOpenGL3_CreateFontsTexture()
 #ifdef GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 #endif
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+
+    // Build texture atlas
+    unsigned char* pixels;
+    int width, height;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_ALPHA8_FONTS
+#if defined(IMGUI_IMPL_OPENGL_ES3)
+    const bool use_alpha8 = bd->GlVersion >= 300;
+#else
+    const bool use_alpha8 = bd->GlVersion >= 330;
+#endif
+    if (use_alpha8)
+    {
+        // Single channel atlas sampled as (1,1,1,R): same output as the RGBA atlas in the shader, a quarter of the memory.
+        // Colored glyphs/custom rects written into GetTexDataAsRGBA32() are not supported in this mode.
+        io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
+        GLint last_unpack_alignment;
+        glGetIntegerv(GL_UNPACK_ALIGNMENT, &last_unpack_alignment);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_R, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_G, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_B, GL_ONE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_A, GL_RED);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, width, height, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, last_unpack_alignment);
+        bd->FontTextureBytes = (size_t)width * height;
+    }
+    else
+#endif
+    {
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);   // Load as RGBA 32-bit (75% of the memory is wasted, but default font is so small) because it is more likely to be compatible with user's existing shaders. If your ImTextureId represent a higher-level concept than just a GL texture id, consider calling GetTexDataAsAlpha8() instead to save on GPU memory.
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+        bd->FontTextureBytes = (size_t)width * height * 4;
+    }
+    bd->FrameCounters.BytesUploaded += bd->FontTextureBytes;
 
     // Store our identifier
     io.Fonts->SetTexID((ImTextureID)(intptr_t)bd->FontTexture);
@@ -568,9 +810,49 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
         glDeleteTextures(1, &bd->FontTexture);
         io.Fonts->SetTexID(0);
         bd->FontTexture = 0;
+        bd->FontTextureBytes = 0;
+    }
+}
+
+size_t ImGui_ImplOpenGL3_GetFontsTextureBytes()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    return bd ? bd->FontTextureBytes : 0;
+}
+
+bool ImGui_ImplOpenGL3_GetFrameStats(ImGui_ImplOpenGL3_FrameStats* out_stats)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    if (bd == NULL || bd->FrameStats.FrameIndex == 0)
+        return false;
+    *out_stats = bd->FrameStats;
+    return true;
+}
+
+void ImGui_ImplOpenGL3_SetGpuTimerEnabled(bool enabled)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    IM_ASSERT(bd != NULL && "Did you call ImGui_ImplOpenGL3_Init()?");
+    bd->GpuTimerEnabled = enabled;
+    if (!enabled)
+    {
+        // Don't report stale timings, now or when enabled again
+        bd->FrameCounters.GpuTimeMs = -1.0f;
+        bd->FrameCounters.GpuCallbackCount = 0;
+        bd->FrameCounters.GpuFrameLatency = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+        for (int n = 0; n < IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES; n++)
+            bd->GpuTimerFrames[n].Pending = false;
+#endif
     }
 }
 
+bool ImGui_ImplOpenGL3_HasGpuTimer()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    return bd != NULL && bd->HasTimerQuery;
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
@@ -683,47 +965,81 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
         "    gl_Position = ProjMtx * vec4(Position.xy,0,1);\n"
         "}\n";
 
+    // "Sdf" != 0: the texture alpha is a distance field (edge at 0.5), antialiased over one screen pixel at any scale
     const GLchar* fragment_shader_glsl_120 =
         "#ifdef GL_ES\n"
+        "#extension GL_OES_standard_derivatives : enable\n"
         "    precision mediump float;\n"
         "#endif\n"
         "uniform sampler2D Texture;\n"
+        "uniform float Sdf;\n"
         "varying vec2 Frag_UV;\n"
         "varying vec4 Frag_Color;\n"
         "void main()\n"
         "{\n"
-        "    gl_FragColor = Frag_Color * texture2D(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture2D(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0.0)\n"
+        "    {\n"
+        "#if defined(GL_ES) && !defined(GL_OES_standard_derivatives)\n"
+        "        float w = 0.1;\n"
+        "#else\n"
+        "        float w = max(0.7 * fwidth(tex.a), 0.002);\n"
+        "#endif\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    gl_FragColor = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_130 =
         "uniform sampler2D Texture;\n"
+        "uniform float Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0.0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 0.002);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_300_es =
         "precision mediump float;\n"
         "uniform sampler2D Texture;\n"
+        "uniform float Sdf;\n"
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0.0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 0.002);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     const GLchar* fragment_shader_glsl_410_core =
         "in vec2 Frag_UV;\n"
         "in vec4 Frag_Color;\n"
         "uniform sampler2D Texture;\n"
+        "uniform float Sdf;\n"
         "layout (location = 0) out vec4 Out_Color;\n"
         "void main()\n"
         "{\n"
-        "    Out_Color = Frag_Color * texture(Texture, Frag_UV.st);\n"
+        "    vec4 tex = texture(Texture, Frag_UV.st);\n"
+        "    if (Sdf != 0.0)\n"
+        "    {\n"
+        "        float w = max(0.7 * fwidth(tex.a), 0.002);\n"
+        "        tex.a = smoothstep(0.5 - w, 0.5 + w, tex.a);\n"
+        "    }\n"
+        "    Out_Color = Frag_Color * tex;\n"
         "}\n";
 
     // Select shaders matching our GLSL versions
@@ -777,6 +1093,7 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 
     bd->AttribLocationTex = glGetUniformLocation(bd->ShaderHandle, "Texture");
     bd->AttribLocationProjMtx = glGetUniformLocation(bd->ShaderHandle, "ProjMtx");
+    bd->AttribLocationSdf = glGetUniformLocation(bd->ShaderHandle, "Sdf");
     bd->AttribLocationVtxPos = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Position");
     bd->AttribLocationVtxUV = (GLuint)glGetAttribLocation(bd->ShaderHandle, "UV");
     bd->AttribLocationVtxColor = (GLuint)glGetAttribLocation(bd->ShaderHandle, "Color");
@@ -803,6 +1120,15 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
     if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
     if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_TIMER_QUERY
+    for (int n = 0; n < IMGUI_IMPL_OPENGL_GPU_TIMER_FRAMES; n++)
+    {
+        ImGui_ImplOpenGL3_GpuTimerFrame* frame = &bd->GpuTimerFrames[n];
+        if (frame->Queries[0] != 0)
+            glDeleteQueries(IMGUI_IMPL_OPENGL_GPU_TIMER_SEGMENTS, frame->Queries);
+        memset(frame, 0, sizeof(*frame));
+    }
+#endif
     ImGui_ImplOpenGL3_DestroyFontsTexture();
 }
 
@@ -823,6 +823,10 @@ CODE
 #else
 #include <stdint.h>     // intptr_t
 #endif
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+#include <mutex>        // std::mutex
+#include <atomic>       // std::atomic
+#endif
 
 // [Windows] On non-Visual Studio compilers, we default to IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS unless explicitly enabled
 #if defined(_WIN32) && !defined(_MSC_VER) && !defined(IMGUI_ENABLE_WIN32_DEFAULT_IME_FUNCTIONS) && !defined(IMGUI_DISABLE_WIN32_DEFAULT_IME_FUNCTIONS)
@@ -1008,14 +1012,325 @@ static void             UpdateViewportsNewFrame();
 //   - Future development aims to make this context pointer explicit to all calls. Also read https://github.com/ocornut/imgui/issues/586
 //   - If you need a finite number of contexts, you may compile and use multiple instances of the ImGui code from a different namespace.
 // - DLL users: read comments above.
-#ifndef GImGui
+#if defined(IMGUI_USE_THREAD_LOCAL_CONTEXT)
+thread_local ImGuiContext* GImGuiTLS = NULL;
+#elif !defined(GImGui)
 ImGuiContext*   GImGui = NULL;
 #endif
 
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use global/static e.g. ImVector<> instances you may need to keep them accessible during program destruction.
 // - DLL users: read comments above.
-#ifndef IMGUI_DISABLE_DEFAULT_ALLOCATORS
+#if !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS) && defined(IMGUI_USE_POOL_ALLOCATOR)
+// Size-class pools: each block has a 16 bytes header (class index + requested size) which keeps the 16 bytes alignment of malloc().
+// Slots are carved from 64 KB pages, blocks larger than the last class use malloc() directly.
+// Each thread keeps its own free list per class and allocates/frees without any lock. A thread that runs out of slots takes a batch
+// from the central list of that class (one mutex per class) or carves a new page, a thread holding too many free slots gives a batch back.
+// Blocks freed by another thread simply join that thread's free lists. Free lists of exiting threads go back to the central lists.
+struct ImPoolAllocatorHeader { ImU32 ClassIdx; ImU32 Size; ImU32 Pad[2]; };
+static const ImU32              GImPoolClassSizes[IM_POOL_ALLOCATOR_CLASS_COUNT] = { 16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096, 6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536 };
+static const ImU32              GImPoolLargeClass = 0xFFFF;
+static const size_t             GImPoolPageSize = 64 * 1024;    // At least 4 slots per page for the largest classes
+
+// Class index for each size rounded up to 32 bytes (the step of the 96 and 192 classes), up to the largest class
+struct ImPoolClassLut
+{
+    ImU8 Index[65536 / 32 + 1];
+    constexpr ImPoolClassLut() : Index()
+    {
+        for (ImU32 n = 0, class_idx = 0; n <= 65536 / 32; n++)
+        {
+            while (GImPoolClassSizes[class_idx] < n * 32)
+                class_idx++;
+            Index[n] = (ImU8)class_idx;
+        }
+    }
+};
+static constexpr ImPoolClassLut GImPoolClassLut;
+
+struct ImPoolCentralList
+{
+    std::mutex  Mutex;
+    void*       Head;
+    int         Count;
+};
+
+// Trivially constructible/destructible so it is zero-initialized without a TLS guard and stays usable after thread_local destructors ran.
+// Counters are only written by the owning thread (relaxed atomics so GetPoolAllocatorStats() can read them), they may go negative when blocks are freed by another thread.
+struct ImPoolThreadCache
+{
+    void*               FreeList[IM_POOL_ALLOCATOR_CLASS_COUNT];
+    int                 FreeCount[IM_POOL_ALLOCATOR_CLASS_COUNT];
+    std::atomic<int>    AllocCount;
+    std::atomic<int>    ActiveBytes;
+    std::atomic<int>    LargeActive;
+    std::atomic<int>    ClassActive[IM_POOL_ALLOCATOR_CLASS_COUNT];
+    ImPoolThreadCache*  Next;
+    bool                Registered;
+    bool                Retired;    // Thread is exiting: go through the central lists
+};
+struct ImPoolThreadExit { ~ImPoolThreadExit(); };
+
+static ImPoolCentralList                GImPoolCentral[IM_POOL_ALLOCATOR_CLASS_COUNT];
+static thread_local ImPoolThreadCache   GImPoolCache;
+static thread_local ImPoolThreadExit    GImPoolThreadExit;
+static std::mutex                       GImPoolStatsMutex;      // Protects GImPoolThreads and GImPoolStats, never taken by pooled allocations once warmed up
+static ImPoolThreadCache*               GImPoolThreads = NULL;  // Registered thread caches
+static ImGuiPoolAllocatorStats          GImPoolStats;           // Pages/large blocks + counters of exited threads
+
+static inline int   PoolSlotSize(ImU32 class_idx)                   { return (int)sizeof(ImPoolAllocatorHeader) + (int)GImPoolClassSizes[class_idx]; }
+static inline int   PoolSlotsPerPage(ImU32 class_idx)               { return ImMax((int)GImPoolPageSize / PoolSlotSize(class_idx), 4); }
+static inline void  PoolCount(std::atomic<int>& counter, int delta) { counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed); }
+
+// Sum of the live thread counters into 'stats' (which already holds the shared/exited counters). Requires GImPoolStatsMutex.
+static void PoolSumThreadsLocked(ImGuiPoolAllocatorStats* stats)
+{
+    for (ImPoolThreadCache* cache = GImPoolThreads; cache != NULL; cache = cache->Next)
+    {
+        stats->AllocCount += cache->AllocCount.load(std::memory_order_relaxed);
+        stats->ActiveBytes += cache->ActiveBytes.load(std::memory_order_relaxed);
+        stats->LargeActive += cache->LargeActive.load(std::memory_order_relaxed);
+        for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++)
+            stats->ClassActive[n] += cache->ClassActive[n].load(std::memory_order_relaxed);
+    }
+    GImPoolStats.PeakBytes = ImMax(GImPoolStats.PeakBytes, stats->ActiveBytes);
+    stats->PeakBytes = GImPoolStats.PeakBytes;
+}
+
+// The system allocated 'reserved_bytes' more (pool page or large block): sample the peak while we are on a slow path anyway
+static void PoolCountSystemAlloc(int reserved_bytes, int class_idx, int class_slots)
+{
+    std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+    GImPoolStats.ReservedBytes += reserved_bytes;
+    if (reserved_bytes > 0)
+        GImPoolStats.SystemAllocCount++;
+    if (class_idx >= 0)
+        GImPoolStats.ClassReserved[class_idx] += class_slots;
+    ImGuiPoolAllocatorStats stats = GImPoolStats;
+    PoolSumThreadsLocked(&stats);
+}
+
+static ImPoolThreadCache* PoolGetThreadCache()
+{
+    ImPoolThreadCache* cache = &GImPoolCache;
+    if (cache->Registered)
+        return cache;
+    if (cache->Retired)
+        return NULL;
+    IM_UNUSED(&GImPoolThreadExit); // First use on this thread: register the destructor which returns the free lists
+    std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+    cache->Next = GImPoolThreads;
+    GImPoolThreads = cache;
+    cache->Registered = true;
+    return cache;
+}
+
+// Detach the first 'count' slots of a free list, returns the last one
+static void* PoolSplitList(void* head, int count)
+{
+    void* tail = head;
+    for (int n = 1; n < count; n++)
+        tail = *(void**)tail;
+    return tail;
+}
+
+static void PoolPushCentral(ImU32 class_idx, void* head, void* tail, int count)
+{
+    ImPoolCentralList& central = GImPoolCentral[class_idx];
+    std::lock_guard<std::mutex> lock(central.Mutex);
+    *(void**)tail = central.Head;
+    central.Head = head;
+    central.Count += count;
+}
+
+static void* PoolAllocSlot(ImPoolThreadCache* cache, ImU32 class_idx)
+{
+    if (cache != NULL && cache->FreeList[class_idx] != NULL)
+    {
+        void* slot = cache->FreeList[class_idx];
+        cache->FreeList[class_idx] = *(void**)slot;
+        cache->FreeCount[class_idx]--;
+        return slot;
+    }
+
+    // Take one page worth of slots from the central list
+    ImPoolCentralList& central = GImPoolCentral[class_idx];
+    {
+        std::lock_guard<std::mutex> lock(central.Mutex);
+        if (central.Head != NULL)
+        {
+            void* slot = central.Head;
+            const int count = (cache != NULL) ? ImMin(PoolSlotsPerPage(class_idx), central.Count) : 1;
+            void* tail = PoolSplitList(slot, count);
+            central.Head = *(void**)tail;
+            central.Count -= count;
+            if (cache != NULL && count > 1)
+            {
+                cache->FreeList[class_idx] = *(void**)slot;
+                cache->FreeCount[class_idx] = count - 1;
+                *(void**)tail = NULL;
+            }
+            return slot;
+        }
+    }
+
+    // Carve a new page into slots, linked through their first bytes. The first slot is returned, the others go to the thread (or central) list.
+    const int slot_size = PoolSlotSize(class_idx);
+    const int slot_count = PoolSlotsPerPage(class_idx);
+    char* page = (char*)malloc((size_t)slot_size * slot_count);
+    if (page == NULL)
+        return NULL;
+    for (int n = 1; n < slot_count; n++)
+        *(void**)(page + slot_size * n) = (n + 1 < slot_count) ? page + slot_size * (n + 1) : NULL;
+    if (cache != NULL)
+    {
+        cache->FreeList[class_idx] = page + slot_size;
+        cache->FreeCount[class_idx] = slot_count - 1;
+    }
+    else
+    {
+        PoolPushCentral(class_idx, page + slot_size, page + slot_size * (slot_count - 1), slot_count - 1);
+    }
+    PoolCountSystemAlloc(slot_size * slot_count, (int)class_idx, slot_count);
+    return page;
+}
+
+static void PoolFreeSlot(ImPoolThreadCache* cache, ImU32 class_idx, void* slot)
+{
+    if (cache == NULL)
+    {
+        PoolPushCentral(class_idx, slot, slot, 1);
+        return;
+    }
+    *(void**)slot = cache->FreeList[class_idx];
+    cache->FreeList[class_idx] = slot;
+
+    // Keep at most two pages worth of free slots per class, give the oldest page worth back
+    const int batch = PoolSlotsPerPage(class_idx);
+    if (++cache->FreeCount[class_idx] <= batch * 2)
+        return;
+    void* keep_tail = PoolSplitList(cache->FreeList[class_idx], batch);
+    void* head = *(void**)keep_tail;
+    void* tail = PoolSplitList(head, cache->FreeCount[class_idx] - batch);
+    *(void**)keep_tail = NULL;
+    PoolPushCentral(class_idx, head, tail, cache->FreeCount[class_idx] - batch);
+    cache->FreeCount[class_idx] = batch;
+}
+
+ImPoolThreadExit::~ImPoolThreadExit()
+{
+    ImPoolThreadCache* cache = &GImPoolCache;
+    if (!cache->Registered)
+        return;
+    for (ImU32 class_idx = 0; class_idx < IM_POOL_ALLOCATOR_CLASS_COUNT; class_idx++)
+        if (cache->FreeCount[class_idx] > 0)
+        {
+            void* head = cache->FreeList[class_idx];
+            PoolPushCentral(class_idx, head, PoolSplitList(head, cache->FreeCount[class_idx]), cache->FreeCount[class_idx]);
+            cache->FreeList[class_idx] = NULL;
+            cache->FreeCount[class_idx] = 0;
+        }
+
+    // Unregister and keep the counters of this thread
+    std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+    for (ImPoolThreadCache** p = &GImPoolThreads; *p != NULL; p = &(*p)->Next)
+        if (*p == cache)
+        {
+            *p = cache->Next;
+            break;
+        }
+    GImPoolStats.AllocCount += cache->AllocCount.load(std::memory_order_relaxed);
+    GImPoolStats.ActiveBytes += cache->ActiveBytes.load(std::memory_order_relaxed);
+    GImPoolStats.LargeActive += cache->LargeActive.load(std::memory_order_relaxed);
+    for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++)
+        GImPoolStats.ClassActive[n] += cache->ClassActive[n].load(std::memory_order_relaxed);
+    cache->Registered = false;
+    cache->Retired = true;
+}
+
+// Counters of an allocation (delta = 1) or free (delta = -1)
+static void PoolCountBlock(ImPoolThreadCache* cache, ImU32 class_idx, int size, int delta)
+{
+    if (cache != NULL)
+    {
+        if (delta > 0)
+            PoolCount(cache->AllocCount, 1);
+        PoolCount(cache->ActiveBytes, size * delta);
+        PoolCount(class_idx == GImPoolLargeClass ? cache->LargeActive : cache->ClassActive[class_idx], delta);
+        return;
+    }
+    std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+    if (delta > 0)
+        GImPoolStats.AllocCount++;
+    GImPoolStats.ActiveBytes += size * delta;
+    if (class_idx == GImPoolLargeClass)
+        GImPoolStats.LargeActive += delta;
+    else
+        GImPoolStats.ClassActive[class_idx] += delta;
+}
+
+static void* MallocWrapper(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    ImU32 class_idx = IM_POOL_ALLOCATOR_CLASS_COUNT;
+    if (size <= 64)
+        class_idx = size <= 16 ? 0 : (ImU32)(size - 1) / 16;
+    else if (size <= 65536)
+        class_idx = GImPoolClassLut.Index[(size + 31) / 32];
+    ImPoolThreadCache* cache = PoolGetThreadCache();
+    ImPoolAllocatorHeader* header = NULL;
+    if (class_idx == IM_POOL_ALLOCATOR_CLASS_COUNT)
+    {
+        class_idx = GImPoolLargeClass;
+        if ((header = (ImPoolAllocatorHeader*)malloc(sizeof(ImPoolAllocatorHeader) + size)) != NULL)
+            PoolCountSystemAlloc((int)size, -1, 0);
+    }
+    else
+    {
+        header = (ImPoolAllocatorHeader*)PoolAllocSlot(cache, class_idx);
+    }
+    if (header == NULL)
+        return NULL;
+    header->ClassIdx = class_idx;
+    header->Size = (ImU32)size;
+    PoolCountBlock(cache, class_idx, (int)size, 1);
+    return header + 1;
+}
+
+static void FreeWrapper(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    if (ptr == NULL)
+        return;
+    ImPoolAllocatorHeader* header = (ImPoolAllocatorHeader*)ptr - 1;
+    ImPoolThreadCache* cache = PoolGetThreadCache();
+    // The free list link overwrites the header, read it first
+    const ImU32 class_idx = header->ClassIdx;
+    const int size = (int)header->Size;
+    PoolCountBlock(cache, class_idx, size, -1);
+    if (class_idx == GImPoolLargeClass)
+    {
+        free(header);
+        std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+        GImPoolStats.ReservedBytes -= size;
+    }
+    else
+    {
+        PoolFreeSlot(cache, class_idx, header);
+    }
+}
+
+void ImGui::GetPoolAllocatorStats(ImGuiPoolAllocatorStats* out_stats)
+{
+    {
+        std::lock_guard<std::mutex> lock(GImPoolStatsMutex);
+        *out_stats = GImPoolStats;
+        PoolSumThreadsLocked(out_stats);
+    }
+    for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++)
+        out_stats->ClassSize[n] = (int)GImPoolClassSizes[n];
+}
+#elif !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
 static void*   MallocWrapper(size_t size, void* user_data)    { IM_UNUSED(user_data); return malloc(size); }
 static void    FreeWrapper(void* ptr, void* user_data)        { IM_UNUSED(user_data); free(ptr); }
 #else
@@ -1680,6 +1995,8 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+#ifndef IMGUI_USE_CRC32C_HASH
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1750,6 +2067,113 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+#else // #ifndef IMGUI_USE_CRC32C_HASH
+
+// CRC32C (Castagnoli polynomial, see IMGUI_USE_CRC32C_HASH in imconfig.h)
+// - ARMv8 CRC32 / SSE4.2 instructions hash 8 bytes per instruction (enabled by the compiler flags: __ARM_FEATURE_CRC32 / __SSE4_2__,
+//   SSE4.2 is part of the Android x86_64 ABI).
+// - Fallback uses slice-by-8 tables (8KB, built at compile time so ImHashXXX functions stay usable by static constructors and thread-safe).
+// Same seeding as the CRC32 version: ImHashData(data, size, 0) is the standard CRC32C (e.g. 0xE3069283 for "123456789").
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)         { return __crc32cd(crc, v); }
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return __crc32cb(crc, v); }
+#elif defined(IMGUI_ENABLE_SSE) && defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_X64))
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)         { return (ImU32)_mm_crc32_u64(crc, v); }
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return _mm_crc32_u8(crc, v); }
+#else
+struct ImCrc32cLut { ImU32 Table[8][256]; };
+
+static constexpr ImCrc32cLut ImCrc32cBuildLut()
+{
+    ImCrc32cLut lut = {};
+    for (ImU32 n = 0; n < 256; n++)
+    {
+        ImU32 c = n;
+        for (int k = 0; k < 8; k++)
+            c = (c & 1) ? (c >> 1) ^ 0x82F63B78 : (c >> 1);
+        lut.Table[0][n] = c;
+    }
+    for (int t = 1; t < 8; t++)
+        for (int n = 0; n < 256; n++)
+            lut.Table[t][n] = (lut.Table[t - 1][n] >> 8) ^ lut.Table[0][lut.Table[t - 1][n] & 0xFF];
+    return lut;
+}
+
+static constexpr ImCrc32cLut GCrc32cLut = ImCrc32cBuildLut();
+
+// Slice-by-8: 8 bytes (little-endian) per step
+static inline ImU32 ImCrc32cU64(ImU32 crc, ImU64 v)
+{
+    const ImU32 (*lut)[256] = GCrc32cLut.Table;
+    const ImU32 lo = (ImU32)v ^ crc;
+    const ImU32 hi = (ImU32)(v >> 32);
+    return lut[7][lo & 0xFF] ^ lut[6][(lo >> 8) & 0xFF] ^ lut[5][(lo >> 16) & 0xFF] ^ lut[4][lo >> 24] ^
+           lut[3][hi & 0xFF] ^ lut[2][(hi >> 8) & 0xFF] ^ lut[1][(hi >> 16) & 0xFF] ^ lut[0][hi >> 24];
+}
+static inline ImU32 ImCrc32cU8(ImU32 crc, unsigned char v)  { return (crc >> 8) ^ GCrc32cLut.Table[0][(crc ^ v) & 0xFF]; }
+#endif
+
+static inline ImU32 ImCrc32c(ImU32 crc, const unsigned char* data, size_t data_size)
+{
+    for (; data_size >= 8; data += 8, data_size -= 8)
+    {
+        ImU64 v;
+        memcpy(&v, data, 8);
+        crc = ImCrc32cU64(crc, v);
+    }
+    while (data_size-- != 0)
+        crc = ImCrc32cU8(crc, *data++);
+    return crc;
+}
+
+// Known size hash
+// It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    return ~ImCrc32c(~seed, (const unsigned char*)data_p, data_size);
+}
+
+// Zero-terminated string hash, with support for ### to reset back to seed value
+// We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
+// Resetting to the seed on each ### is the same as hashing from the last ###, which we locate first without branching on the
+// string contents (8 bytes windows advancing by 6 so that every ### fits in a window), then hash the rest in one block.
+ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
+{
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const unsigned char* data = (const unsigned char*)data_p;
+    size_t last_window = 0;
+    ImU64 last_match = 0;
+    for (size_t k = 0; k + 2 < data_size; k += 6)
+    {
+        ImU64 v = 0; // Zero padding past the end never matches '#'
+        if (k + 8 <= data_size)
+            memcpy(&v, data + k, 8);
+        else if (data_size >= 8)
+            memcpy(&v, data + data_size - 8, 8), v >>= (k + 8 - data_size) * 8;
+        else
+            for (size_t n = k; n < data_size; n++)
+                v |= (ImU64)data[n] << ((n - k) * 8);
+        const ImU64 x = v ^ 0x2323232323232323ULL;                                                          // '#' bytes become zero
+        const ImU64 m = ~(((x & 0x7F7F7F7F7F7F7F7FULL) + 0x7F7F7F7F7F7F7F7FULL) | x | 0x7F7F7F7F7F7F7F7FULL); // High bit set for each '#' byte
+        const ImU64 match = m & (m >> 8) & (m >> 16);                                                        // High bit set where a ### starts
+        last_window = match ? k : last_window;
+        last_match = match ? match : last_match;
+    }
+    if (last_match != 0)
+    {
+        size_t n = 7;
+        while ((last_match & (0x80ULL << (n * 8))) == 0)
+            n--;
+        data += last_window + n;
+        data_size -= last_window + n;
+    }
+    return ~ImCrc32c(~seed, data, data_size);
+}
+
+#endif // #ifndef IMGUI_USE_CRC32C_HASH
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -2103,6 +2527,8 @@ void ImGui::ColorConvertHSVtoRGB(float h, float s, float v, float& out_r, float&
 // Helper: Key->value storage
 //-----------------------------------------------------------------------------
 
+#ifndef IMGUI_USE_HASHED_STORAGE
+
 // std::lower_bound but without the bullshit
 static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImGuiID key)
 {
@@ -2240,6 +2666,183 @@ void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
     it->val_p = val;
 }
 
+#else // #ifndef IMGUI_USE_HASHED_STORAGE
+
+// Data holds the pairs in insertion order, Index maps keys to them (Robin Hood linear probing, max load factor 3/4).
+// Keys are already hashes but sequential/low entropy IDs are possible (e.g. PushID(int)), so they are mixed before picking a slot.
+static inline ImU32 ImStorageHome(ImGuiID key, ImU32 mask)
+{
+    ImU32 h = key * 0x9E3779B1u;
+    return (h ^ (h >> 16)) & mask;
+}
+
+static void ImStorageIndexInsert(ImGuiStorage* storage, ImGuiID key, int data_idx)
+{
+    const ImU32 mask = (ImU32)storage->Index.Size - 1;
+    ImU64 slot = ((ImU64)key << 32) | (ImU32)(data_idx + 1);
+    ImU32 pos = ImStorageHome(key, mask);
+    for (ImU32 dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        ImU64& cur = storage->Index.Data[pos];
+        if (cur == 0)
+        {
+            cur = slot;
+            break;
+        }
+        // Steal the slot from entries closer to their home position, which keeps probe sequences short and lookups can stop early
+        const ImU32 cur_dist = (pos - ImStorageHome((ImGuiID)(cur >> 32), mask)) & mask;
+        if (cur_dist < dist)
+        {
+            ImSwap(cur, slot);
+            dist = cur_dist;
+        }
+    }
+    storage->IndexCount++;
+}
+
+static void ImStorageRebuildIndex(ImGuiStorage* storage)
+{
+    int capacity = 16;
+    while (capacity * 3 < (storage->Data.Size + 1) * 4)
+        capacity *= 2;
+    storage->Index.resize(capacity);
+    memset(storage->Index.Data, 0, (size_t)storage->Index.size_in_bytes());
+    storage->IndexCount = 0;
+    for (int n = 0; n < storage->Data.Size; n++)
+        ImStorageIndexInsert(storage, storage->Data[n].key, n);
+}
+
+static ImGuiStorage::ImGuiStoragePair* ImStorageFind(const ImGuiStorage* storage, ImGuiID key)
+{
+    if (storage->IndexCount != storage->Data.Size)
+        ImStorageRebuildIndex(const_cast<ImGuiStorage*>(storage));
+    if (storage->Index.Size == 0)
+        return NULL;
+    const ImU32 mask = (ImU32)storage->Index.Size - 1;
+    ImU32 pos = ImStorageHome(key, mask);
+    for (ImU32 dist = 0; ; pos = (pos + 1) & mask, dist++)
+    {
+        const ImU64 cur = storage->Index.Data[pos];
+        if (cur == 0)
+            return NULL;
+        const ImGuiID cur_key = (ImGuiID)(cur >> 32);
+        if (cur_key == key)
+            return &storage->Data.Data[(ImU32)cur - 1];
+        if (((pos - ImStorageHome(cur_key, mask)) & mask) < dist)
+            return NULL;
+    }
+}
+
+// Key must not be in the storage already
+static ImGuiStorage::ImGuiStoragePair* ImStorageAdd(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& pair)
+{
+    storage->Data.push_back(pair);
+    if ((storage->IndexCount + 1) * 4 > storage->Index.Size * 3)
+        ImStorageRebuildIndex(storage);
+    else
+        ImStorageIndexInsert(storage, pair.key, storage->Data.Size - 1);
+    return &storage->Data.back();
+}
+
+void ImGuiStorage::BuildSortByKey()
+{
+    struct StaticFunc
+    {
+        static int IMGUI_CDECL PairComparerByID(const void* lhs, const void* rhs)
+        {
+            if (((const ImGuiStoragePair*)lhs)->key > ((const ImGuiStoragePair*)rhs)->key) return +1;
+            if (((const ImGuiStoragePair*)lhs)->key < ((const ImGuiStoragePair*)rhs)->key) return -1;
+            return 0;
+        }
+    };
+    ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairComparerByID);
+    ImStorageRebuildIndex(this);
+}
+
+int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    return it ? it->val_i : default_val;
+}
+
+bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
+{
+    return GetInt(key, default_val ? 1 : 0) != 0;
+}
+
+float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    return it ? it->val_f : default_val;
+}
+
+void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    return it ? it->val_p : NULL;
+}
+
+// References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
+int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    if (!it)
+        it = ImStorageAdd(this, ImGuiStoragePair(key, default_val));
+    return &it->val_i;
+}
+
+bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
+{
+    return (bool*)GetIntRef(key, default_val ? 1 : 0);
+}
+
+float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    if (!it)
+        it = ImStorageAdd(this, ImGuiStoragePair(key, default_val));
+    return &it->val_f;
+}
+
+void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
+{
+    ImGuiStoragePair* it = ImStorageFind(this, key);
+    if (!it)
+        it = ImStorageAdd(this, ImGuiStoragePair(key, default_val));
+    return &it->val_p;
+}
+
+void ImGuiStorage::SetInt(ImGuiID key, int val)
+{
+    if (ImGuiStoragePair* it = ImStorageFind(this, key))
+        it->val_i = val;
+    else
+        ImStorageAdd(this, ImGuiStoragePair(key, val));
+}
+
+void ImGuiStorage::SetBool(ImGuiID key, bool val)
+{
+    SetInt(key, val ? 1 : 0);
+}
+
+void ImGuiStorage::SetFloat(ImGuiID key, float val)
+{
+    if (ImGuiStoragePair* it = ImStorageFind(this, key))
+        it->val_f = val;
+    else
+        ImStorageAdd(this, ImGuiStoragePair(key, val));
+}
+
+void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
+{
+    if (ImGuiStoragePair* it = ImStorageFind(this, key))
+        it->val_p = val;
+    else
+        ImStorageAdd(this, ImGuiStoragePair(key, val));
+}
+
+#endif // #ifndef IMGUI_USE_HASHED_STORAGE
+
 void ImGuiStorage::SetAllInt(int v)
 {
     for (int i = 0; i < Data.Size; i++)
@@ -2784,6 +3387,7 @@ void ImGui::PushStyleColor(ImGuiCol idx, ImU32 col)
     backup.BackupValue = g.Style.Colors[idx];
     g.ColorStack.push_back(backup);
     g.Style.Colors[idx] = ColorConvertU32ToFloat4(col);
+    g.RetainedStyleHashFrame = -1;
 }
 
 void ImGui::PushStyleColor(ImGuiCol idx, const ImVec4& col)
@@ -2794,6 +3398,7 @@ void ImGui::PushStyleColor(ImGuiCol idx, const ImVec4& col)
     backup.BackupValue = g.Style.Colors[idx];
     g.ColorStack.push_back(backup);
     g.Style.Colors[idx] = col;
+    g.RetainedStyleHashFrame = -1;
 }
 
 void ImGui::PopStyleColor(int count)
@@ -2806,6 +3411,7 @@ void ImGui::PopStyleColor(int count)
         g.ColorStack.pop_back();
         count--;
     }
+    g.RetainedStyleHashFrame = -1;
 }
 
 struct ImGuiStyleVarInfo
@@ -2861,6 +3467,7 @@ void ImGui::PushStyleVar(ImGuiStyleVar idx, float val)
         float* pvar = (float*)var_info->GetVarPtr(&g.Style);
         g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
         *pvar = val;
+        g.RetainedStyleHashFrame = -1;
         return;
     }
     IM_ASSERT(0 && "Called PushStyleVar() float variant but variable is not a float!");
@@ -2875,6 +3482,7 @@ void ImGui::PushStyleVar(ImGuiStyleVar idx, const ImVec2& val)
         ImVec2* pvar = (ImVec2*)var_info->GetVarPtr(&g.Style);
         g.StyleVarStack.push_back(ImGuiStyleMod(idx, *pvar));
         *pvar = val;
+        g.RetainedStyleHashFrame = -1;
         return;
     }
     IM_ASSERT(0 && "Called PushStyleVar() ImVec2 variant but variable is not a ImVec2!");
@@ -2894,6 +3502,7 @@ void ImGui::PopStyleVar(int count)
         g.StyleVarStack.pop_back();
         count--;
     }
+    g.RetainedStyleHashFrame = -1;
 }
 
 const char* ImGui::GetStyleColorName(ImGuiCol idx)
@@ -3371,6 +3980,7 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
+    window->Retained.ClearFreeMemory();
 }
 
 void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
@@ -3639,7 +4249,11 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
 void* ImGui::MemAlloc(size_t size)
 {
     if (ImGuiContext* ctx = GImGui)
+    {
         ctx->IO.MetricsActiveAllocations++;
+        ctx->FrameAllocCount++;
+        ctx->FrameAllocBytes += (int)size;
+    }
     return (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 }
 
@@ -3652,6 +4266,52 @@ void ImGui::MemFree(void* ptr)
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
 
+// Transient allocation, e.g. formatting buffers or temporary arrays which are only needed until the end of the frame.
+void* ImGui::MemAllocFrame(size_t size)
+{
+    ImGuiContext& g = *GImGui;
+    return g.FrameArena.Alloc(size);
+}
+
+void* ImGuiFrameArena::Alloc(size_t size)
+{
+    size = IM_MEMALIGN(size, 16);
+    Used += (int)size;
+    Peak = ImMax(Peak, Used);
+    if (Size + (int)size <= Capacity)
+    {
+        void* ptr = Data + Size;
+        Size += (int)size;
+        return ptr;
+    }
+    void* ptr = IM_ALLOC(size);
+    Overflow.push_back(ptr);
+    return ptr;
+}
+
+void ImGuiFrameArena::Reset()
+{
+    for (int n = 0; n < Overflow.Size; n++)
+        IM_FREE(Overflow[n]);
+    Overflow.resize(0);
+    if (Peak > Capacity)
+    {
+        // Grow once to the highest usage (+25%), following frames won't need any allocation
+        IM_FREE(Data);
+        Capacity = IM_MEMALIGN(Peak + Peak / 4, 4096);
+        Data = (char*)IM_ALLOC((size_t)Capacity);
+    }
+    Size = Used = 0;
+}
+
+void ImGuiFrameArena::ClearFreeMemory()
+{
+    Reset();
+    IM_FREE(Data);
+    Data = NULL;
+    Capacity = Peak = 0;
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -4283,8 +4943,16 @@ void ImGui::NewFrame()
     g.FrameCount += 1;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
+    g.IO.MetricsRetainedWindows = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
 
+    // Memory statistics of the previous frame, then release transient allocations
+    g.IO.MetricsFrameArenaBytes = g.FrameArena.Used;
+    g.FrameArena.Reset();
+    g.IO.MetricsFrameAllocations = g.FrameAllocCount;
+    g.IO.MetricsFrameAllocatedBytes = g.FrameAllocBytes;
+    g.FrameAllocCount = g.FrameAllocBytes = 0;
+
     // Calculate frame-rate for the user, as a purely luxurious feature
     g.FramerateSecPerFrameAccum += g.IO.DeltaTime - g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx];
     g.FramerateSecPerFrame[g.FramerateSecPerFrameIdx] = g.IO.DeltaTime;
@@ -4295,6 +4963,10 @@ void ImGui::NewFrame()
     UpdateViewportsNewFrame();
 
     // Setup current font and draw list shared data
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+    // A shared atlas may be read by contexts running on other threads at the same time: only its owner toggles the lock.
+    if (g.FontAtlasOwnedByContext)
+#endif
     g.IO.Fonts->Locked = true;
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
@@ -4307,7 +4979,7 @@ void ImGui::NewFrame()
     g.DrawListSharedData.InitialFlags = ImDrawListFlags_None;
     if (g.Style.AntiAliasedLines)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLines;
-    if (g.Style.AntiAliasedLinesUseTex && !(g.Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines))
+    if (g.Style.AntiAliasedLinesUseTex && !(g.Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedLinesUseTex;
     if (g.Style.AntiAliasedFill)
         g.DrawListSharedData.InitialFlags |= ImDrawListFlags_AntiAliasedFill;
@@ -4479,7 +5151,7 @@ void ImGui::Initialize(ImGuiContext* context)
     {
         ImGuiSettingsHandler ini_handler;
         ini_handler.TypeName = "Window";
-        ini_handler.TypeHash = ImHashStr("Window");
+        ini_handler.TypeHash = ImHashStrConst("Window");
         ini_handler.ClearAllFn = WindowSettingsHandler_ClearAll;
         ini_handler.ReadOpenFn = WindowSettingsHandler_ReadOpen;
         ini_handler.ReadLineFn = WindowSettingsHandler_ReadLine;
@@ -4560,6 +5232,7 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
     g.InputTextState.ClearFreeMemory();
+    g.FrameArena.ClearFreeMemory();
 
     g.SettingsWindows.clear();
     g.SettingsHandlers.clear();
@@ -4875,6 +5548,9 @@ void ImGui::EndFrame()
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
     // Unlock font atlas
+#ifdef IMGUI_USE_THREAD_LOCAL_CONTEXT
+    if (g.FontAtlasOwnedByContext)
+#endif
     g.IO.Fonts->Locked = false;
 
     // Clear Input data for next frame
@@ -6008,6 +6684,203 @@ static ImGuiWindow* ImGui::FindBlockingModal(ImGuiWindow* window)
     return NULL;
 }
 
+// Retained windows (see SetNextWindowRetained())
+// - The window decorations are rendered normally by Begin(), only the contents (everything between Begin() and End()) are retained.
+// - Recorded vertices are in absolute coordinates, so window position/size/scroll are part of the hash along with the user key and style.
+//   Modifying GetStyle() directly in the middle of a frame is not detected, use PushStyleColor()/PushStyleVar().
+// - Items are not submitted while replaying, so we submit normally whenever the window may be interacted with.
+static ImGuiID CalcWindowRetainedHash(ImGuiWindow* window, ImGuiID key)
+{
+    ImGuiContext& g = *GImGui;
+    struct
+    {
+        ImVec2              Pos, Size, Scroll, DisplaySize;
+        ImRect              InnerClipRect, WorkRect;    // Change with scrollbars and content size
+        const ImFont*       Font;
+        ImTextureID         TexId;
+        float               FontSize;
+        ImGuiWindowFlags    Flags;
+        ImDrawListFlags     DrawListFlags;
+        ImGuiItemFlags      ItemFlags;
+    } state;
+    memset(&state, 0, sizeof(state)); // Clear padding
+    state.Pos = window->Pos;
+    state.Size = window->Size;
+    state.Scroll = window->Scroll;
+    state.InnerClipRect = window->InnerClipRect;
+    state.WorkRect = window->WorkRect;
+    state.DisplaySize = g.IO.DisplaySize;
+    state.Font = g.Font;
+    state.TexId = g.Font->ContainerAtlas->TexID;
+    state.FontSize = g.FontSize;
+    state.Flags = window->Flags;
+    state.DrawListFlags = window->DrawList->Flags;
+    state.ItemFlags = g.CurrentItemFlags;
+    // Style is hashed once per frame, or again after being modified with Push/PopStyleXXX()
+    if (g.RetainedStyleHashFrame != g.FrameCount)
+    {
+        g.RetainedStyleHash = ImHashData(&g.Style, sizeof(g.Style));
+        g.RetainedStyleHashFrame = g.FrameCount;
+    }
+    ImGuiID hash = ImHashData(&key, sizeof(key), window->ID);
+    hash = ImHashData(&state, sizeof(state), hash ^ g.RetainedStyleHash);
+    return hash != 0 ? hash : 1;
+}
+
+static bool IsWindowRetainedReplayAllowed(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->Appearing || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 || window->HiddenFramesCannotSkipItems > 0 || g.LogEnabled)
+        return false;
+    if (g.HoveredWindow && ImGui::IsWindowChildOf(g.HoveredWindow, window, true))
+        return false;
+    if (g.ActiveId != 0 && g.ActiveIdWindow && ImGui::IsWindowChildOf(g.ActiveIdWindow, window, true))
+        return false;
+    if (g.NavWindow && !g.NavDisableHighlight && ImGui::IsWindowChildOf(g.NavWindow, window, true))
+        return false;
+    return window->DrawList->_Splitter._Count <= 1;
+}
+
+// Append recorded contents to the window draw list. Indices are rebased on the current vertex index.
+static bool ReplayWindowRetained(ImGuiWindow* window)
+{
+    ImGuiWindowRetainedCache& retained = window->Retained;
+    ImDrawList* draw_list = window->DrawList;
+    const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
+    if (sizeof(ImDrawIdx) == 2 && vtx_base + retained.VtxBuffer.Size > 0xFFFF)
+        return false;
+
+    const int vtx_start = draw_list->VtxBuffer.Size;
+    const int idx_start = draw_list->IdxBuffer.Size;
+    draw_list->VtxBuffer.resize(vtx_start + retained.VtxBuffer.Size);
+    draw_list->IdxBuffer.resize(idx_start + retained.IdxBuffer.Size);
+    if (retained.VtxBuffer.Size > 0)
+        memcpy(draw_list->VtxBuffer.Data + vtx_start, retained.VtxBuffer.Data, (size_t)retained.VtxBuffer.size_in_bytes());
+    ImDrawIdx* idx_dst = draw_list->IdxBuffer.Data + idx_start;
+    const ImDrawIdx* idx_src = retained.IdxBuffer.Data;
+    for (int n = 0; n < retained.IdxBuffer.Size; n++)
+        idx_dst[n] = (ImDrawIdx)(idx_src[n] + vtx_base);
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->_VtxCurrentIdx += (unsigned int)retained.VtxBuffer.Size;
+
+    for (int n = 0; n < retained.CmdBuffer.Size; n++)
+    {
+        const ImDrawCmd& src = retained.CmdBuffer[n];
+        ImDrawCmd* last = &draw_list->CmdBuffer.back();
+        const unsigned int idx_offset = (unsigned int)idx_start + src.IdxOffset;
+        if (src.UserCallback == NULL && last->UserCallback == NULL)
+        {
+            // Merge with the previous command when contiguous and sharing the same state
+            if (last->ElemCount == 0)
+            {
+                last->ClipRect = src.ClipRect;
+                last->TextureId = src.TextureId;
+                last->IdxOffset = idx_offset;
+                last->ElemCount = src.ElemCount;
+                continue;
+            }
+            if (memcmp(&last->ClipRect, &src.ClipRect, sizeof(ImVec4)) == 0 && last->TextureId == src.TextureId && last->IdxOffset + last->ElemCount == idx_offset)
+            {
+                last->ElemCount += src.ElemCount;
+                continue;
+            }
+        }
+        ImDrawCmd cmd = src;
+        cmd.VtxOffset = draw_list->_CmdHeader.VtxOffset;
+        cmd.IdxOffset = idx_offset;
+        draw_list->CmdBuffer.push_back(cmd);
+    }
+
+    // Leave a command matching _CmdHeader so following primitives don't end up in a replayed command
+    const ImDrawCmd* last = &draw_list->CmdBuffer.back();
+    if (last->UserCallback != NULL || memcmp(&last->ClipRect, &draw_list->_CmdHeader.ClipRect, sizeof(ImVec4)) != 0 || last->TextureId != draw_list->_CmdHeader.TextureId || last->VtxOffset != draw_list->_CmdHeader.VtxOffset)
+        draw_list->AddDrawCmd();
+    return true;
+}
+
+// Called at the end of the first Begin() of the frame
+static void UpdateWindowRetained(ImGuiWindow* window, ImGuiID key)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindowRetainedCache& retained = window->Retained;
+    retained.Key = key;
+    retained.Recording = retained.Replayed = false;
+    if (key == 0)
+    {
+        if (retained.Hash != 0)
+            retained.Clear();
+        return;
+    }
+    if (window->SkipItems)
+        return;
+
+    const ImGuiID hash = CalcWindowRetainedHash(window, key);
+    if (hash == retained.Hash && IsWindowRetainedReplayAllowed(window) && ReplayWindowRetained(window))
+    {
+        // Restore layout output so next frame content size and scrollbars are unchanged
+        window->DC.CursorMaxPos = retained.CursorMaxPos;
+        window->DC.IdealMaxPos = retained.IdealMaxPos;
+        window->SkipItems = true;
+        retained.Replayed = true;
+        g.IO.MetricsRetainedWindows++;
+        return;
+    }
+    ImDrawList* draw_list = window->DrawList;
+    retained.Hash = 0;
+    retained.RecordingHash = hash;
+    retained.Recording = true;
+    retained.VtxStart = draw_list->VtxBuffer.Size;
+    retained.IdxStart = draw_list->IdxBuffer.Size;
+    retained.CmdStart = draw_list->CmdBuffer.Size - 1;
+}
+
+// Called by End() before popping the inner clip rect
+static void RecordWindowRetained(ImGuiWindow* window)
+{
+    ImGuiWindowRetainedCache& retained = window->Retained;
+    ImDrawList* draw_list = window->DrawList;
+    retained.Recording = false;
+
+    // Child windows and split channels are not part of this draw list yet
+    if (window->DC.ChildWindows.Size > 0 || draw_list->_Splitter._Count > 1 || retained.CmdStart < 0 || retained.CmdStart >= draw_list->CmdBuffer.Size)
+        return;
+    const unsigned int vtx_offset = draw_list->CmdBuffer[retained.CmdStart].VtxOffset;
+    for (int n = retained.CmdStart + 1; n < draw_list->CmdBuffer.Size; n++)
+        if (draw_list->CmdBuffer[n].VtxOffset != vtx_offset)
+            return;
+
+    const int vtx_count = draw_list->VtxBuffer.Size - retained.VtxStart;
+    const int idx_count = draw_list->IdxBuffer.Size - retained.IdxStart;
+    retained.VtxBuffer.resize(vtx_count);
+    retained.IdxBuffer.resize(idx_count);
+    if (vtx_count > 0)
+        memcpy(retained.VtxBuffer.Data, draw_list->VtxBuffer.Data + retained.VtxStart, (size_t)vtx_count * sizeof(ImDrawVert));
+    const unsigned int idx_base = (unsigned int)retained.VtxStart - vtx_offset;
+    const ImDrawIdx* idx_src = draw_list->IdxBuffer.Data + retained.IdxStart;
+    for (int n = 0; n < idx_count; n++)
+        retained.IdxBuffer.Data[n] = (ImDrawIdx)(idx_src[n] - idx_base);
+
+    retained.CmdBuffer.resize(0);
+    for (int n = retained.CmdStart; n < draw_list->CmdBuffer.Size; n++)
+    {
+        ImDrawCmd cmd = draw_list->CmdBuffer[n];
+        if (cmd.UserCallback != NULL && n == retained.CmdStart)
+            continue;
+        const unsigned int idx_begin = ImMax(cmd.IdxOffset, (unsigned int)retained.IdxStart);
+        const unsigned int idx_end = cmd.IdxOffset + cmd.ElemCount;
+        if (idx_end <= idx_begin && cmd.UserCallback == NULL)
+            continue;
+        cmd.IdxOffset = idx_begin - (unsigned int)retained.IdxStart;
+        cmd.ElemCount = idx_end > idx_begin ? idx_end - idx_begin : 0;
+        cmd.VtxOffset = 0;
+        retained.CmdBuffer.push_back(cmd);
+    }
+    retained.CursorMaxPos = window->DC.CursorMaxPos;
+    retained.IdealMaxPos = window->DC.IdealMaxPos;
+    retained.Hash = retained.RecordingHash;
+}
+
 // Push a new Dear ImGui window to add widgets to.
 // - A default window called "Debug" is automatically stacked at the beginning of every frame so you can use widgets without explicitly calling a Begin/End pair.
 // - Begin/End can be called multiple times during the frame with the same window name to append content.
@@ -6040,6 +6913,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
     const int current_frame = g.FrameCount;
     const bool first_begin_of_the_frame = (window->LastFrameActive != current_frame);
+    const ImGuiID retained_key = (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasRetained) ? g.NextWindowData.RetainedKeyVal : 0;
     window->IsFallbackWindow = (g.CurrentWindowStack.Size == 0 && g.WithinFrameScopeWithImplicitWindow);
 
     // Update the Appearing flag
@@ -6672,6 +7546,15 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
             if (window->AutoFitFramesX <= 0 && window->AutoFitFramesY <= 0 && window->HiddenFramesCannotSkipItems <= 0)
                 skip_items = true;
         window->SkipItems = skip_items;
+
+        // Retained window: replay last frame contents instead of submitting items again
+        UpdateWindowRetained(window, retained_key);
+    }
+    else if (window->Retained.Key != 0)
+    {
+        // Appending to a retained window: recorded contents would be incomplete
+        window->Retained.Recording = false;
+        window->Retained.Hash = 0;
     }
 
     return !window->SkipItems;
@@ -6697,6 +7580,8 @@ void ImGui::End()
     // Close anything that is open
     if (window->DC.CurrentColumns)
         EndColumns();
+    if (window->Retained.Recording)
+        RecordWindowRetained(window);
     PopClipRect();   // Inner window clip rectangle
 
     // Stop logging
@@ -6942,6 +7827,7 @@ void ImGui::BeginDisabled(bool disabled)
         g.CurrentItemFlags |= ImGuiItemFlags_Disabled;
     g.ItemFlagsStack.push_back(g.CurrentItemFlags);
     g.DisabledStackSize++;
+    g.RetainedStyleHashFrame = -1;
 }
 
 void ImGui::EndDisabled()
@@ -6955,6 +7841,7 @@ void ImGui::EndDisabled()
     g.CurrentItemFlags = g.ItemFlagsStack.back();
     if (was_disabled && (g.CurrentItemFlags & ImGuiItemFlags_Disabled) == 0)
         g.Style.Alpha = g.DisabledAlphaBackup; //PopStyleVar();
+    g.RetainedStyleHashFrame = -1;
 }
 
 // FIXME: Look into renaming this once we have settled the new Focus/Activation/TabStop system.
@@ -7342,6 +8229,13 @@ void ImGui::SetNextWindowBgAlpha(float alpha)
     g.NextWindowData.BgAlphaVal = alpha;
 }
 
+void ImGui::SetNextWindowRetained(ImGuiID key)
+{
+    ImGuiContext& g = *GImGui;
+    g.NextWindowData.Flags |= ImGuiNextWindowDataFlags_HasRetained;
+    g.NextWindowData.RetainedKeyVal = key;
+}
+
 ImDrawList* ImGui::GetWindowDrawList()
 {
     ImGuiWindow* window = GetCurrentWindow();
@@ -11093,7 +11987,7 @@ bool ImGui::BeginDragDropSource(ImGuiDragDropFlags flags)
     else
     {
         window = NULL;
-        source_id = ImHashStr("#SourceExtern");
+        source_id = ImHashStrConst("#SourceExtern");
         source_drag_active = true;
     }
 
@@ -12193,6 +13087,21 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
     Text("%d visible windows, %d active allocations", io.MetricsRenderWindows, io.MetricsActiveAllocations);
+    Text("Last frame: %d allocations (%d bytes), frame arena %d bytes (capacity %d, peak %d)", io.MetricsFrameAllocations, io.MetricsFrameAllocatedBytes, io.MetricsFrameArenaBytes, g.FrameArena.Capacity, g.FrameArena.Peak);
+#if defined(IMGUI_USE_POOL_ALLOCATOR) && !defined(IMGUI_DISABLE_DEFAULT_ALLOCATORS)
+    {
+        ImGuiPoolAllocatorStats pool_stats;
+        GetPoolAllocatorStats(&pool_stats);
+        if (TreeNode("PoolAllocator", "Pool allocator: %d bytes active (peak %d), %d bytes reserved, %d malloc() calls", pool_stats.ActiveBytes, pool_stats.PeakBytes, pool_stats.ReservedBytes, pool_stats.SystemAllocCount))
+        {
+            for (int n = 0; n < IM_POOL_ALLOCATOR_CLASS_COUNT; n++)
+                if (pool_stats.ClassReserved[n] > 0)
+                    BulletText("%4d bytes: %d/%d slots", pool_stats.ClassSize[n], pool_stats.ClassActive[n], pool_stats.ClassReserved[n]);
+            BulletText("Large: %d blocks", pool_stats.LargeActive);
+            TreePop();
+        }
+    }
+#endif
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
     Separator();
@@ -12829,7 +13738,11 @@ void ImGui::DebugNodeFont(ImFont* font)
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
+#ifdef IMGUI_USE_HASHED_STORAGE
+    if (!TreeNode(label, "%s: %d entries, %d bytes, %d index slots", label, storage->Data.Size, storage->Data.size_in_bytes() + storage->Index.size_in_bytes(), storage->Index.Size))
+#else
     if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+#endif
         return;
     for (int n = 0; n < storage->Data.Size; n++)
     {
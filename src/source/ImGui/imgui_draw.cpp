@@ -381,6 +381,7 @@ ImDrawListSharedData::ImDrawListSharedData()
         ArcFastVtx[i] = ImVec2(ImCos(a), ImSin(a));
     }
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
+    TessellationSimd = true;
 }
 
 void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
@@ -718,7 +719,376 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+// Anti-aliased lines with an integer thickness use the baked lines texture (2 vertices per point instead of 3 or 4)
+static inline bool ImPolylineUseTexture(const ImDrawList* draw_list, float thickness)
+{
+    const int integer_thickness = (int)thickness;
+    const float fractional_thickness = thickness - integer_thickness;
+    return (draw_list->Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (draw_list->_FringeScale == 1.0f);
+}
+
+// SIMD tessellation of anti-aliased AddPolyline() and AddConvexPolyFilled() (SSE2 on x86, NEON on arm64)
+// - One pass over the points computes segment normals, miter normals and edge positions of 2 points per 128-bit register
+//   (x0 y0 x1 y1) and writes the vertices directly (pos+uv as one 16 bytes store, then col), without temporary buffers.
+// - Indices are written from a per-segment pattern added to the first vertex index (16-bit indices only).
+// - Every value goes through the same float operations as IM_NORMALIZE2F_OVER_ZERO()/IM_FIXNORMAL2F() in the scalar paths
+//   (_mm_rsqrt_ps() matches the _mm_rsqrt_ss() of ImRsqrt(), NEON sqrt/div are IEEE like its 1.0f/sqrtf()), so the output is
+//   bit-identical. ImDrawListSharedData::TessellationSimd = false selects the scalar paths (to compare against them).
+#if (defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SIMD_TESSELLATION
+
+#if defined(IMGUI_ENABLE_SSE)
+typedef __m128  ImTessF4;   // 2 points
+typedef __m128i ImTessU16;  // 8 indices
+static inline ImTessF4  ImTessLoad2(const ImVec2* p)                        { return _mm_loadu_ps(&p->x); }
+static inline ImTessF4  ImTessLoadPair(const ImVec2* lo, const ImVec2* hi)  { return _mm_loadh_pi(_mm_loadl_pi(_mm_setzero_ps(), (const __m64*)lo), (const __m64*)hi); }
+static inline ImTessF4  ImTessLoad1(const ImVec2* p)                        { return _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)p); }
+static inline ImTessF4  ImTessSet(float x, float y)                         { return _mm_setr_ps(x, y, x, y); }
+static inline ImTessF4  ImTessAdd(ImTessF4 a, ImTessF4 b)                   { return _mm_add_ps(a, b); }
+static inline ImTessF4  ImTessSub(ImTessF4 a, ImTessF4 b)                   { return _mm_sub_ps(a, b); }
+static inline ImTessF4  ImTessMul(ImTessF4 a, ImTessF4 b)                   { return _mm_mul_ps(a, b); }
+static inline ImTessF4  ImTessMin(ImTessF4 a, ImTessF4 b)                   { return _mm_min_ps(a, b); }
+static inline ImTessF4  ImTessRsqrt(ImTessF4 a)                             { return _mm_rsqrt_ps(a); }
+static inline ImTessF4  ImTessRcp(ImTessF4 a)                               { return _mm_div_ps(_mm_set1_ps(1.0f), a); }
+static inline ImTessF4  ImTessSwapXY(ImTessF4 a)                            { return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1)); }
+static inline ImTessF4  ImTessLoLo(ImTessF4 a, ImTessF4 b)                  { return _mm_movelh_ps(a, b); }                             // a.lo, b.lo
+static inline ImTessF4  ImTessHiLo(ImTessF4 a, ImTessF4 b)                  { return _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 3, 2)); }   // a.hi, b.lo
+static inline ImTessF4  ImTessHiHi(ImTessF4 a, ImTessF4 b)                  { return _mm_movehl_ps(b, a); }                             // a.hi, b.hi
+// Lanes where a > b take v, others take 1.0f (multiplying by 1.0f leaves values untouched like the scalar 'if')
+static inline ImTessF4  ImTessSelectGt(ImTessF4 a, ImTessF4 b, ImTessF4 v)  { const __m128 mask = _mm_cmpgt_ps(a, b); return _mm_or_ps(_mm_and_ps(mask, v), _mm_andnot_ps(mask, _mm_set1_ps(1.0f))); }
+static inline void      ImTessStore4(float* dst, ImTessF4 v)                { _mm_storeu_ps(dst, v); }
+static inline ImTessU16 ImTessLoadIdx(const ImU16* p)                       { return _mm_loadu_si128((const __m128i*)p); }
+static inline ImTessU16 ImTessSetIdx(unsigned int idx)                      { return _mm_set1_epi16((short)idx); }
+static inline void      ImTessStoreIdx8(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { _mm_storeu_si128((__m128i*)dst, _mm_add_epi16(pattern, base)); }
+static inline void      ImTessStoreIdx4(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { _mm_storel_epi64((__m128i*)dst, _mm_add_epi16(pattern, base)); }
+static inline void      ImTessStoreIdx2(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { const int v = _mm_cvtsi128_si32(_mm_add_epi16(pattern, base)); memcpy(dst, &v, 4); }
+#else
+typedef float32x4_t ImTessF4;
+typedef uint16x8_t  ImTessU16;
+static inline ImTessF4  ImTessLoad2(const ImVec2* p)                        { return vld1q_f32(&p->x); }
+static inline ImTessF4  ImTessLoadPair(const ImVec2* lo, const ImVec2* hi)  { return vcombine_f32(vld1_f32(&lo->x), vld1_f32(&hi->x)); }
+static inline ImTessF4  ImTessLoad1(const ImVec2* p)                        { return vcombine_f32(vld1_f32(&p->x), vdup_n_f32(0.0f)); }
+static inline ImTessF4  ImTessSet(float x, float y)                         { const float v[4] = { x, y, x, y }; return vld1q_f32(v); }
+static inline ImTessF4  ImTessAdd(ImTessF4 a, ImTessF4 b)                   { return vaddq_f32(a, b); }
+static inline ImTessF4  ImTessSub(ImTessF4 a, ImTessF4 b)                   { return vsubq_f32(a, b); }
+static inline ImTessF4  ImTessMul(ImTessF4 a, ImTessF4 b)                   { return vmulq_f32(a, b); }
+static inline ImTessF4  ImTessMin(ImTessF4 a, ImTessF4 b)                   { return vminq_f32(a, b); }
+static inline ImTessF4  ImTessRsqrt(ImTessF4 a)                             { return vdivq_f32(vdupq_n_f32(1.0f), vsqrtq_f32(a)); }
+static inline ImTessF4  ImTessRcp(ImTessF4 a)                               { return vdivq_f32(vdupq_n_f32(1.0f), a); }
+static inline ImTessF4  ImTessSwapXY(ImTessF4 a)                            { return vrev64q_f32(a); }
+static inline ImTessF4  ImTessLoLo(ImTessF4 a, ImTessF4 b)                  { return vcombine_f32(vget_low_f32(a), vget_low_f32(b)); }
+static inline ImTessF4  ImTessHiLo(ImTessF4 a, ImTessF4 b)                  { return vcombine_f32(vget_high_f32(a), vget_low_f32(b)); }
+static inline ImTessF4  ImTessHiHi(ImTessF4 a, ImTessF4 b)                  { return vcombine_f32(vget_high_f32(a), vget_high_f32(b)); }
+static inline ImTessF4  ImTessSelectGt(ImTessF4 a, ImTessF4 b, ImTessF4 v)  { return vbslq_f32(vcgtq_f32(a, b), v, vdupq_n_f32(1.0f)); }
+static inline void      ImTessStore4(float* dst, ImTessF4 v)                { vst1q_f32(dst, v); }
+static inline ImTessU16 ImTessLoadIdx(const ImU16* p)                       { return vld1q_u16(p); }
+static inline ImTessU16 ImTessSetIdx(unsigned int idx)                      { return vdupq_n_u16((ImU16)idx); }
+static inline void      ImTessStoreIdx8(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { vst1q_u16((ImU16*)dst, vaddq_u16(pattern, base)); }
+static inline void      ImTessStoreIdx4(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { vst1_u16((ImU16*)dst, vget_low_u16(vaddq_u16(pattern, base))); }
+static inline void      ImTessStoreIdx2(ImDrawIdx* dst, ImTessU16 pattern, ImTessU16 base) { const ImU32 v = vgetq_lane_u32(vreinterpretq_u32_u16(vaddq_u16(pattern, base)), 0); memcpy(dst, &v, 4); }
+#endif
+
+// IM_NORMALIZE2F_OVER_ZERO(p2 - p1) then (dy, -dx): normal of the segment p1 -> p2, for each point of the register
+static inline ImTessF4 ImTessNormals(ImTessF4 p1, ImTessF4 p2)
+{
+    ImTessF4 d = ImTessSub(p2, p1);
+    ImTessF4 d2 = ImTessMul(d, d);
+    d2 = ImTessAdd(d2, ImTessSwapXY(d2));
+    d = ImTessMul(d, ImTessSelectGt(d2, ImTessSet(0.0f, 0.0f), ImTessRsqrt(d2)));
+    return ImTessMul(ImTessSwapXY(d), ImTessSet(1.0f, -1.0f));
+}
+
+// IM_FIXNORMAL2F((n0 + n1) * 0.5f): miter normal between the normals of two consecutive segments
+static inline ImTessF4 ImTessMiter(ImTessF4 n0, ImTessF4 n1)
+{
+    ImTessF4 dm = ImTessMul(ImTessAdd(n0, n1), ImTessSet(0.5f, 0.5f));
+    ImTessF4 d2 = ImTessMul(dm, dm);
+    d2 = ImTessAdd(d2, ImTessSwapXY(d2));
+    return ImTessMul(dm, ImTessSelectGt(d2, ImTessSet(0.000001f, 0.000001f), ImTessMin(ImTessRcp(d2), ImTessSet(IM_FIXNORMAL2F_MAX_INVLEN2, IM_FIXNORMAL2F_MAX_INVLEN2))));
+}
+
+// Vertex with the position of the low/high point of 'p'
+static inline void ImTessWriteVtxLo(ImDrawVert* vtx, ImTessF4 p, ImTessF4 uv, ImU32 col) { ImTessStore4(&vtx->pos.x, ImTessLoLo(p, uv)); vtx->col = col; }
+static inline void ImTessWriteVtxHi(ImDrawVert* vtx, ImTessF4 p, ImTessF4 uv, ImU32 col) { ImTessStore4(&vtx->pos.x, ImTessHiLo(p, uv)); vtx->col = col; }
+
+enum ImTessMode
+{
+    ImTessMode_LineTextured,    // [PATH 1] 2 vertices per point: left/right edges
+    ImTessMode_LineThin,        // [PATH 2] 3 vertices per point: center, left/right AA edges
+    ImTessMode_LineThick,       // [PATH 3] 4 vertices per point: outer/inner edges on both sides
+    ImTessMode_Fill,            // AddConvexPolyFilled(): 2 vertices per point: inner, outer AA edge
+};
+
+struct ImTessParams
+{
+    ImTessF4    Uv0, Uv1;       // (u, v, u, v) of the first/other vertices
+    ImTessF4    Scale0, Scale1; // Miter normal scale to the outer/inner edge
+    ImU32       Col, ColTrans;
+};
+
+// Vertices of the low point (and of the high point when 'two') of 'p', 'dm' being their miter normals
+template<int MODE>
+static inline ImDrawVert* ImTessWritePoints(ImDrawVert* vtx, ImTessF4 p, ImTessF4 dm, const ImTessParams& params, bool two)
+{
+    if (MODE == ImTessMode_LineTextured)
+    {
+        const ImTessF4 d = ImTessMul(dm, params.Scale0);
+        const ImTessF4 left = ImTessAdd(p, d), right = ImTessSub(p, d);
+        ImTessWriteVtxLo(vtx + 0, left, params.Uv0, params.Col);
+        ImTessWriteVtxLo(vtx + 1, right, params.Uv1, params.Col);
+        if (two)
+        {
+            ImTessWriteVtxHi(vtx + 2, left, params.Uv0, params.Col);
+            ImTessWriteVtxHi(vtx + 3, right, params.Uv1, params.Col);
+        }
+        return vtx + (two ? 4 : 2);
+    }
+    if (MODE == ImTessMode_LineThin)
+    {
+        const ImTessF4 d = ImTessMul(dm, params.Scale0);
+        const ImTessF4 left = ImTessAdd(p, d), right = ImTessSub(p, d);
+        ImTessWriteVtxLo(vtx + 0, p, params.Uv0, params.Col);
+        ImTessWriteVtxLo(vtx + 1, left, params.Uv0, params.ColTrans);
+        ImTessWriteVtxLo(vtx + 2, right, params.Uv0, params.ColTrans);
+        if (two)
+        {
+            ImTessWriteVtxHi(vtx + 3, p, params.Uv0, params.Col);
+            ImTessWriteVtxHi(vtx + 4, left, params.Uv0, params.ColTrans);
+            ImTessWriteVtxHi(vtx + 5, right, params.Uv0, params.ColTrans);
+        }
+        return vtx + (two ? 6 : 3);
+    }
+    if (MODE == ImTessMode_LineThick)
+    {
+        const ImTessF4 d_out = ImTessMul(dm, params.Scale0), d_in = ImTessMul(dm, params.Scale1);
+        const ImTessF4 left_out = ImTessAdd(p, d_out), left_in = ImTessAdd(p, d_in), right_in = ImTessSub(p, d_in), right_out = ImTessSub(p, d_out);
+        ImTessWriteVtxLo(vtx + 0, left_out, params.Uv0, params.ColTrans);
+        ImTessWriteVtxLo(vtx + 1, left_in, params.Uv0, params.Col);
+        ImTessWriteVtxLo(vtx + 2, right_in, params.Uv0, params.Col);
+        ImTessWriteVtxLo(vtx + 3, right_out, params.Uv0, params.ColTrans);
+        if (two)
+        {
+            ImTessWriteVtxHi(vtx + 4, left_out, params.Uv0, params.ColTrans);
+            ImTessWriteVtxHi(vtx + 5, left_in, params.Uv0, params.Col);
+            ImTessWriteVtxHi(vtx + 6, right_in, params.Uv0, params.Col);
+            ImTessWriteVtxHi(vtx + 7, right_out, params.Uv0, params.ColTrans);
+        }
+        return vtx + (two ? 8 : 4);
+    }
+    // ImTessMode_Fill
+    const ImTessF4 d = ImTessMul(dm, params.Scale0);
+    const ImTessF4 inner = ImTessSub(p, d), outer = ImTessAdd(p, d);
+    ImTessWriteVtxLo(vtx + 0, inner, params.Uv0, params.Col);
+    ImTessWriteVtxLo(vtx + 1, outer, params.Uv0, params.ColTrans);
+    if (two)
+    {
+        ImTessWriteVtxHi(vtx + 2, inner, params.Uv0, params.Col);
+        ImTessWriteVtxHi(vtx + 3, outer, params.Uv0, params.ColTrans);
+    }
+    return vtx + (two ? 4 : 2);
+}
+
+// Vertices of all points. The vertices of a point use the miter normal between its incoming and outgoing segments, like the scalar
+// paths (the first point of an open line uses the normal of the first segment, the last one the normal of the last segment, fixed).
+template<int MODE>
+static ImDrawVert* ImTessWriteAllPoints(ImDrawVert* vtx, const ImVec2* points, const int points_count, bool closed, const ImTessParams& params)
+{
+    const int count = closed ? points_count : points_count - 1;
+    ImTessF4 n; // Normal of the segment starting at the last written point, in the high half
+    if (closed)
+    {
+        n = ImTessNormals(ImTessLoadPair(&points[points_count - 1], &points[0]), ImTessLoad2(&points[0]));
+        vtx = ImTessWritePoints<MODE>(vtx, ImTessLoad1(&points[0]), ImTessMiter(n, ImTessHiHi(n, n)), params, false);
+    }
+    else
+    {
+        n = ImTessNormals(ImTessLoad1(&points[0]), ImTessLoad1(&points[1]));
+        vtx = ImTessWritePoints<MODE>(vtx, ImTessLoad1(&points[0]), n, params, false);
+        n = ImTessLoLo(n, n);
+    }
+    int i = 1;
+    for (; i + 2 < points_count; i += 2)
+    {
+        const ImTessF4 p = ImTessLoad2(&points[i]);
+        const ImTessF4 n_next = ImTessNormals(p, ImTessLoad2(&points[i + 1]));
+        vtx = ImTessWritePoints<MODE>(vtx, p, ImTessMiter(ImTessHiLo(n, n_next), n_next), params, true);
+        n = n_next;
+    }
+    for (; i < points_count; i++)
+    {
+        const ImTessF4 p = ImTessLoad1(&points[i]);
+        const ImTessF4 n_next = (i < count) ? ImTessNormals(p, ImTessLoad1(&points[(i + 1 == points_count) ? 0 : i + 1])) : ImTessHiHi(n, n);
+        vtx = ImTessWritePoints<MODE>(vtx, p, ImTessMiter(ImTessHiLo(n, n_next), n_next), params, false);
+        n = ImTessLoLo(n_next, n_next);
+    }
+    return vtx;
+}
+
+// Indices of each line segment relative to its first vertex (the segment ends at +VTX_COUNT), padded for 8 lanes loads
+static const ImU16 GTessIdxLineTextured[24] = { 2, 0, 1, 3, 1, 2 };
+static const ImU16 GTessIdxLineThin[24] = { 3, 0, 2, 2, 5, 3, 4, 1, 0, 0, 3, 4 };
+static const ImU16 GTessIdxLineThick[24] = { 5, 1, 2, 2, 6, 5, 5, 1, 0, 0, 4, 5, 6, 2, 3, 3, 7, 6 };
+
+template<int MODE>
+static void ImTessPolyline(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
+{
+    const int vtx_per_point = (MODE == ImTessMode_LineTextured) ? 2 : (MODE == ImTessMode_LineThin) ? 3 : 4;
+    const int idx_per_segment = (MODE == ImTessMode_LineTextured) ? 6 : (MODE == ImTessMode_LineThin) ? 12 : 18;
+    const int count = closed ? points_count : points_count - 1;
+    const float AA_SIZE = draw_list->_FringeScale;
+    const ImVec2 opaque_uv = draw_list->_Data->TexUvWhitePixel;
+
+    ImTessParams params;
+    params.Col = col;
+    params.ColTrans = col & ~IM_COL32_A_MASK;
+    if (MODE == ImTessMode_LineTextured)
+    {
+        const ImVec4 tex_uvs = draw_list->_Data->TexUvLines[(int)thickness];
+        params.Uv0 = ImTessSet(tex_uvs.x, tex_uvs.y);
+        params.Uv1 = ImTessSet(tex_uvs.z, tex_uvs.w);
+        const float half_draw_size = (thickness * 0.5f) + 1;
+        params.Scale0 = params.Scale1 = ImTessSet(half_draw_size, half_draw_size);
+    }
+    else
+    {
+        params.Uv0 = params.Uv1 = ImTessSet(opaque_uv.x, opaque_uv.y);
+        const float half_inner_thickness = (thickness - AA_SIZE) * 0.5f;
+        const float scale_out = (MODE == ImTessMode_LineThin) ? AA_SIZE : (half_inner_thickness + AA_SIZE);
+        params.Scale0 = ImTessSet(scale_out, scale_out);
+        params.Scale1 = ImTessSet(half_inner_thickness, half_inner_thickness);
+    }
+    draw_list->_VtxWritePtr = ImTessWriteAllPoints<MODE>(draw_list->_VtxWritePtr, points, points_count, closed, params);
+
+    // Indices, the last segment of a closed line ends at the first point
+    const ImU16* pattern = (MODE == ImTessMode_LineTextured) ? GTessIdxLineTextured : (MODE == ImTessMode_LineThin) ? GTessIdxLineThin : GTessIdxLineThick;
+    const ImTessU16 pattern0 = ImTessLoadIdx(pattern), pattern1 = ImTessLoadIdx(pattern + 8), pattern2 = ImTessLoadIdx(pattern + 16);
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+    unsigned int idx1 = draw_list->_VtxCurrentIdx;
+    const int linear_count = (count == points_count) ? count - 1 : count;
+    for (int i1 = 0; i1 < linear_count; i1++, idx1 += vtx_per_point, idx_write += idx_per_segment)
+    {
+        const ImTessU16 base = ImTessSetIdx(idx1);
+        if (MODE == ImTessMode_LineTextured)
+        {
+            ImTessStoreIdx4(idx_write, pattern0, base);
+            ImTessStoreIdx2(idx_write + 4, ImTessLoadIdx(pattern + 4), base);
+        }
+        else if (MODE == ImTessMode_LineThin)
+        {
+            ImTessStoreIdx8(idx_write, pattern0, base);
+            ImTessStoreIdx4(idx_write + 8, pattern1, base);
+        }
+        else
+        {
+            ImTessStoreIdx8(idx_write, pattern0, base);
+            ImTessStoreIdx8(idx_write + 8, pattern1, base);
+            ImTessStoreIdx2(idx_write + 16, pattern2, base);
+        }
+    }
+    if (linear_count < count)
+    {
+        const unsigned int idx2 = draw_list->_VtxCurrentIdx;
+        for (int n = 0; n < idx_per_segment; n++)
+            idx_write[n] = (ImDrawIdx)((pattern[n] >= vtx_per_point) ? (idx2 + pattern[n] - vtx_per_point) : (idx1 + pattern[n]));
+        idx_write += idx_per_segment;
+    }
+    draw_list->_IdxWritePtr = idx_write;
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)(points_count * vtx_per_point);
+}
+
+// Anti-aliased AddConvexPolyFilled(), space must have been reserved
+static void ImTessConvexPolyFilled(ImDrawList* draw_list, const ImVec2* points, const int points_count, ImU32 col)
+{
+    const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+    const float AA_SIZE = draw_list->_FringeScale;
+    const unsigned int vtx_inner_idx = draw_list->_VtxCurrentIdx;
+    ImDrawIdx* idx_write = draw_list->_IdxWritePtr;
+
+    // Fill: triangles (inner 0, inner i - 1, inner i), 4 per iteration
+    static const ImU16 fan_pattern[16] = { 0, 0, 2, 0, 2, 4, 0, 4, 6, 0, 6, 8 };
+    static const ImU16 fan_mask[16] = { 0, 0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF, 0, 0xFFFF, 0xFFFF };
+    int i = 2;
+    for (; i + 4 <= points_count; i += 4, idx_write += 12)
+    {
+        // + vtx_inner_idx on every index, + (i - 1) * 2 on the non-zero ones
+        const ImTessU16 base = ImTessSetIdx(vtx_inner_idx);
+#if defined(IMGUI_ENABLE_SSE)
+        const __m128i offset = _mm_set1_epi16((short)((i - 1) << 1));
+        ImTessStoreIdx8(idx_write, _mm_add_epi16(ImTessLoadIdx(fan_pattern), _mm_and_si128(offset, ImTessLoadIdx(fan_mask))), base);
+        ImTessStoreIdx4(idx_write + 8, _mm_add_epi16(ImTessLoadIdx(fan_pattern + 8), _mm_and_si128(offset, ImTessLoadIdx(fan_mask + 8))), base);
+#else
+        const uint16x8_t offset = vdupq_n_u16((ImU16)((i - 1) << 1));
+        ImTessStoreIdx8(idx_write, vaddq_u16(ImTessLoadIdx(fan_pattern), vandq_u16(offset, ImTessLoadIdx(fan_mask))), base);
+        ImTessStoreIdx4(idx_write + 8, vaddq_u16(ImTessLoadIdx(fan_pattern + 8), vandq_u16(offset, ImTessLoadIdx(fan_mask + 8))), base);
+#endif
+    }
+    for (; i < points_count; i++, idx_write += 3)
+    {
+        idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + ((i - 1) << 1)); idx_write[2] = (ImDrawIdx)(vtx_inner_idx + (i << 1));
+    }
+
+    // Fringes: between the edges of point i - 1 and point i, the first one between the last point and point 0
+    const unsigned int vtx_outer_idx = vtx_inner_idx + 1;
+    const int last = points_count - 1;
+    idx_write[0] = (ImDrawIdx)(vtx_inner_idx); idx_write[1] = (ImDrawIdx)(vtx_inner_idx + (last << 1)); idx_write[2] = (ImDrawIdx)(vtx_outer_idx + (last << 1));
+    idx_write[3] = (ImDrawIdx)(vtx_outer_idx + (last << 1)); idx_write[4] = (ImDrawIdx)(vtx_outer_idx); idx_write[5] = (ImDrawIdx)(vtx_inner_idx);
+    idx_write += 6;
+    static const ImU16 fringe_pattern[16] = { 2, 0, 1, 1, 3, 2 };
+    const ImTessU16 pattern = ImTessLoadIdx(fringe_pattern);
+    for (int i1 = 1; i1 < points_count; i1++, idx_write += 6)
+    {
+        const ImTessU16 base = ImTessSetIdx(vtx_inner_idx + ((i1 - 1) << 1));
+        ImTessStoreIdx4(idx_write, pattern, base);
+        ImTessStoreIdx2(idx_write + 4, ImTessLoadIdx(fringe_pattern + 4), base);
+    }
+    draw_list->_IdxWritePtr = idx_write;
+
+    ImTessParams params;
+    params.Uv0 = params.Uv1 = ImTessSet(uv.x, uv.y);
+    params.Scale0 = params.Scale1 = ImTessSet(AA_SIZE * 0.5f, AA_SIZE * 0.5f);
+    params.Col = col;
+    params.ColTrans = col & ~IM_COL32_A_MASK;
+    draw_list->_VtxWritePtr = ImTessWriteAllPoints<ImTessMode_Fill>(draw_list->_VtxWritePtr, points, points_count, true, params);
+    draw_list->_VtxCurrentIdx += (ImDrawIdx)(points_count * 2);
+}
+#endif // #if (defined(IMGUI_ENABLE_SSE) || defined(IMGUI_ENABLE_NEON)) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+
+// Number of indices/vertices written by AddPolyline(), so that batches can be reserved at once
+void ImDrawList::_CalcPolylinePrimCount(int points_count, ImDrawFlags flags, float thickness, int* out_idx_count, int* out_vtx_count) const
+{
+    if (points_count < 2)
+    {
+        *out_idx_count = *out_vtx_count = 0;
+        return;
+    }
+    const int count = (flags & ImDrawFlags_Closed) ? points_count : points_count - 1;
+    if (Flags & ImDrawListFlags_AntiAliasedLines)
+    {
+        const bool thick_line = (thickness > _FringeScale);
+        const bool use_texture = ImPolylineUseTexture(this, ImMax(thickness, 1.0f));
+        *out_idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
+        *out_vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
+    }
+    else
+    {
+        *out_idx_count = count * 6;
+        *out_vtx_count = count * 4;
+    }
+}
+
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
+{
+    if (points_count < 2)
+        return;
+
+    int idx_count, vtx_count;
+    _CalcPolylinePrimCount(points_count, flags, thickness, &idx_count, &vtx_count);
+    PrimReserve(idx_count, vtx_count);
+    _PolylineNoReserve(points, points_count, col, flags, thickness);
+}
+
+// Write the vertices/indices of AddPolyline(), space must have been reserved with PrimReserve() (see _CalcPolylinePrimCount())
+void ImDrawList::_PolylineNoReserve(const ImVec2* points, const int points_count, ImU32 col, ImDrawFlags flags, float thickness)
 {
     if (points_count < 2)
         return;
@@ -737,19 +1107,29 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         // Thicknesses <1.0 should behave like thickness 1.0
         thickness = ImMax(thickness, 1.0f);
         const int integer_thickness = (int)thickness;
-        const float fractional_thickness = thickness - integer_thickness;
 
         // Do we want to draw this line using a texture?
         // - For now, only draw integer-width lines using textures to avoid issues with the way scaling occurs, could be improved.
         // - If AA_SIZE is not 1.0f we cannot use the texture path.
-        const bool use_texture = (Flags & ImDrawListFlags_AntiAliasedLinesUseTex) && (integer_thickness < IM_DRAWLIST_TEX_LINES_WIDTH_MAX) && (fractional_thickness <= 0.00001f) && (AA_SIZE == 1.0f);
+        const bool use_texture = ImPolylineUseTexture(this, thickness);
 
         // We should never hit this, because NewFrame() doesn't set ImDrawListFlags_AntiAliasedLinesUseTex unless ImFontAtlasFlags_NoBakedLines is off
-        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & ImFontAtlasFlags_NoBakedLines));
+        IM_ASSERT_PARANOID(!use_texture || !(_Data->Font->ContainerAtlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)));
+
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+        if (_Data->TessellationSimd && sizeof(ImDrawIdx) == 2)
+        {
+            if (use_texture)
+                ImTessPolyline<ImTessMode_LineTextured>(this, points, points_count, col, closed, thickness);
+            else if (!thick_line)
+                ImTessPolyline<ImTessMode_LineThin>(this, points, points_count, col, closed, thickness);
+            else
+                ImTessPolyline<ImTessMode_LineThick>(this, points, points_count, col, closed, thickness);
+            return;
+        }
+#endif
 
-        const int idx_count = use_texture ? (count * 6) : (thick_line ? count * 18 : count * 12);
         const int vtx_count = use_texture ? (points_count * 2) : (thick_line ? points_count * 4 : points_count * 3);
-        PrimReserve(idx_count, vtx_count);
 
         // Temporary buffer
         // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
@@ -942,11 +1322,7 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
     }
     else
     {
-        // [PATH 4] Non texture-based, Non anti-aliased lines
-        const int idx_count = count * 6;
-        const int vtx_count = count * 4;    // FIXME-OPT: Not sharing edges
-        PrimReserve(idx_count, vtx_count);
-
+        // [PATH 4] Non texture-based, Non anti-aliased lines (count * 4 vertices, FIXME-OPT: Not sharing edges)
         for (int i1 = 0; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
@@ -990,6 +1366,14 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         const int vtx_count = (points_count * 2);
         PrimReserve(idx_count, vtx_count);
 
+#ifdef IMGUI_ENABLE_SIMD_TESSELLATION
+        if (_Data->TessellationSimd && sizeof(ImDrawIdx) == 2)
+        {
+            ImTessConvexPolyFilled(this, points, points_count, col);
+            return;
+        }
+#endif
+
         // Add indexes for fill
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
@@ -1636,6 +2020,144 @@ void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, c
     AddText(NULL, 0.0f, pos, col, text_begin, text_end);
 }
 
+// Stroke 'count' consecutive paths stored in _Path (points_counts[i] points each), then clear the path.
+// Paths are grouped so that PrimReserve() switches VtxOffset before the same item as individual AddPolyline() calls would.
+void ImDrawList::_PathStrokeBatch(const int* points_counts, const ImU32* cols, int count, ImDrawFlags flags, float thickness)
+{
+    const bool split_vtx_offset = sizeof(ImDrawIdx) == 2 && (Flags & ImDrawListFlags_AllowVtxOffset);
+    const ImVec2* points = _Path.Data;
+    int i = 0;
+    while (i < count)
+    {
+        int idx_total = 0, vtx_total = 0, group_end = i;
+        for (; group_end < count; group_end++)
+        {
+            int idx_count, vtx_count;
+            _CalcPolylinePrimCount(points_counts[group_end], flags, thickness, &idx_count, &vtx_count);
+            if (split_vtx_offset && group_end > i && _VtxCurrentIdx + vtx_total + vtx_count >= (1 << 16))
+                break;
+            idx_total += idx_count;
+            vtx_total += vtx_count;
+        }
+        PrimReserve(idx_total, vtx_total);
+        for (; i < group_end; i++)
+        {
+            _PolylineNoReserve(points, points_counts[i], cols[i], flags, thickness);
+            points += points_counts[i];
+        }
+    }
+    _Path.Size = 0;
+}
+
+// Same as AddRect() with no rounding for each item
+void ImDrawList::AddRectsBatch(const ImVec2* p_min, const ImVec2* p_max, const ImU32* cols, int count, float thickness)
+{
+    const ImVec2 offset_max = (Flags & ImDrawListFlags_AntiAliasedLines) ? ImVec2(0.50f, 0.50f) : ImVec2(0.49f, 0.49f);
+    int points_counts[IM_DRAWLIST_BATCH_SIZE];
+    ImU32 batch_cols[IM_DRAWLIST_BATCH_SIZE];
+    PathClear();
+    for (int i = 0; i < count;)
+    {
+        int n = 0;
+        for (; i < count && n < IM_DRAWLIST_BATCH_SIZE; i++)
+        {
+            if ((cols[i] & IM_COL32_A_MASK) == 0)
+                continue;
+            const ImVec2 a = p_min[i] + ImVec2(0.50f, 0.50f);
+            const ImVec2 b = p_max[i] - offset_max;
+            _Path.resize(_Path.Size + 4);
+            ImVec2* out = _Path.Data + _Path.Size - 4;
+            out[0] = a;
+            out[1] = ImVec2(b.x, a.y);
+            out[2] = b;
+            out[3] = ImVec2(a.x, b.y);
+            points_counts[n] = 4;
+            batch_cols[n++] = cols[i];
+        }
+        _PathStrokeBatch(points_counts, batch_cols, n, ImDrawFlags_Closed, thickness);
+    }
+}
+
+// Same as AddLine() for each item
+void ImDrawList::AddLinesBatch(const ImVec2* p1, const ImVec2* p2, const ImU32* cols, int count, float thickness)
+{
+    int points_counts[IM_DRAWLIST_BATCH_SIZE];
+    ImU32 batch_cols[IM_DRAWLIST_BATCH_SIZE];
+    PathClear();
+    for (int i = 0; i < count;)
+    {
+        int n = 0;
+        for (; i < count && n < IM_DRAWLIST_BATCH_SIZE; i++)
+        {
+            if ((cols[i] & IM_COL32_A_MASK) == 0)
+                continue;
+            _Path.resize(_Path.Size + 2);
+            ImVec2* out = _Path.Data + _Path.Size - 2;
+            out[0] = p1[i] + ImVec2(0.5f, 0.5f);
+            out[1] = p2[i] + ImVec2(0.5f, 0.5f);
+            points_counts[n] = 2;
+            batch_cols[n++] = cols[i];
+        }
+        _PathStrokeBatch(points_counts, batch_cols, n, 0, thickness);
+    }
+}
+
+// Same as AddCircle() for each item
+void ImDrawList::AddCirclesBatch(const ImVec2* centers, const float* radii, const ImU32* cols, int count, int num_segments, float thickness)
+{
+    int points_counts[IM_DRAWLIST_BATCH_SIZE];
+    ImU32 batch_cols[IM_DRAWLIST_BATCH_SIZE];
+    if (num_segments > 0)
+        num_segments = ImClamp(num_segments, 3, IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_MAX);
+    const float a_max = (IM_PI * 2.0f) * ((float)num_segments - 1.0f) / (float)num_segments;
+    PathClear();
+    for (int i = 0; i < count;)
+    {
+        int n = 0;
+        for (; i < count && n < IM_DRAWLIST_BATCH_SIZE; i++)
+        {
+            if ((cols[i] & IM_COL32_A_MASK) == 0 || radii[i] <= 0.0f)
+                continue;
+            const int path_size = _Path.Size;
+            if (num_segments <= 0)
+            {
+                _PathArcToFastEx(centers[i], radii[i] - 0.5f, 0, IM_DRAWLIST_ARCFAST_SAMPLE_MAX, 0);
+                _Path.Size--;
+            }
+            else
+            {
+                PathArcTo(centers[i], radii[i] - 0.5f, 0.0f, a_max, num_segments - 1);
+            }
+            points_counts[n] = _Path.Size - path_size;
+            batch_cols[n++] = cols[i];
+        }
+        _PathStrokeBatch(points_counts, batch_cols, n, ImDrawFlags_Closed, thickness);
+    }
+}
+
+// Same as AddText() for each item. RenderText() reserves 4 vertices/6 indices per character and gives back the unused ones,
+// so we grow the buffers once for the whole batch and the per-item reservations never reallocate.
+void ImDrawList::AddTextBatch(const ImVec2* pos, const char* const* texts, const ImU32* cols, int count)
+{
+    const ImFont* font = _Data->Font;
+    IM_ASSERT(font->ContainerAtlas->TexID == _CmdHeader.TextureId);  // Use high-level ImGui::PushFont() or low-level ImDrawList::PushTextureId() to change font.
+
+    int chars_count = 0;
+    for (int i = 0; i < count; i++)
+        if (cols[i] & IM_COL32_A_MASK)
+            chars_count += (int)strlen(texts[i]);
+    VtxBuffer.reserve(VtxBuffer.Size + chars_count * 4);
+    IdxBuffer.reserve(IdxBuffer.Size + chars_count * 6);
+
+    const ImVec4 clip_rect = _CmdHeader.ClipRect;
+    for (int i = 0; i < count; i++)
+    {
+        if ((cols[i] & IM_COL32_A_MASK) == 0 || texts[i][0] == 0)
+            continue;
+        font->RenderText(this, _Data->FontSize, pos[i], cols[i], clip_rect, texts[i], NULL, 0.0f, false);
+    }
+}
+
 void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col)
 {
     if ((col & IM_COL32_A_MASK) == 0)
@@ -2005,6 +2527,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexSdfPadding = 4;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -2370,6 +2893,43 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Rasterize packed glyphs as signed distance fields and fill the stbtt_packedchar data that stbtt_PackFontRangesRenderIntoRects() would have written.
+// Distance is encoded as 128 + dist * (128 / TexSdfPadding), so 0 and 255 are TexSdfPadding pixels outside/inside the outline.
+static void ImFontAtlasBuildRenderSdfGlyphs(ImFontAtlas* atlas, ImFontBuildSrcData* src_tmp, const ImFontConfig& cfg)
+{
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(&src_tmp->FontInfo, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(&src_tmp->FontInfo, -cfg.SizePixels);
+    const int sdf_padding = atlas->TexSdfPadding;
+    for (int glyph_i = 0; glyph_i < src_tmp->GlyphsCount; glyph_i++)
+    {
+        const stbrp_rect& r = src_tmp->Rects[glyph_i];
+        stbtt_packedchar& pc = src_tmp->PackedChars[glyph_i];
+        const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp->FontInfo, src_tmp->GlyphsList[glyph_i]);
+        int advance, lsb;
+        stbtt_GetGlyphHMetrics(&src_tmp->FontInfo, glyph_index_in_font, &advance, &lsb);
+        pc.xadvance = scale * advance;
+        if (!r.was_packed)
+            continue;
+
+        int w = 0, h = 0, xoff = 0, yoff = 0;
+        unsigned char* sdf_pixels = stbtt_GetGlyphSDF(&src_tmp->FontInfo, scale, glyph_index_in_font, sdf_padding, 128, 128.0f / sdf_padding, &w, &h, &xoff, &yoff);
+        if (sdf_pixels == NULL)
+            continue; // Empty glyph (e.g. space): zero-sized quad, advance only
+        IM_ASSERT(w <= r.w && h <= r.h);
+        for (int y = 0; y < h; y++)
+            memcpy(atlas->TexPixelsAlpha8 + (r.y + y) * atlas->TexWidth + r.x, sdf_pixels + y * w, (size_t)w);
+        stbtt_FreeSDF(sdf_pixels, NULL);
+
+        pc.x0 = (unsigned short)r.x;
+        pc.y0 = (unsigned short)r.y;
+        pc.x1 = (unsigned short)(r.x + w);
+        pc.y1 = (unsigned short)(r.y + h);
+        pc.xoff = (float)xoff;
+        pc.yoff = (float)yoff;
+        pc.xoff2 = (float)(xoff + w);
+        pc.yoff2 = (float)(yoff + h);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
@@ -2473,6 +3033,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     memset(buf_packedchars.Data, 0, (size_t)buf_packedchars.size_in_bytes());
 
     // 4. Gather glyphs sizes so we can pack them in our virtual canvas.
+    const bool sdf = (atlas->Flags & ImFontAtlasFlags_SignedDistanceField) != 0;
     int total_surface = 0;
     int buf_rects_out_n = 0;
     int buf_packedchars_out_n = 0;
@@ -2505,6 +3066,16 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             int x0, y0, x1, y1;
             const int glyph_index_in_font = stbtt_FindGlyphIndex(&src_tmp.FontInfo, src_tmp.GlyphsList[glyph_i]);
             IM_ASSERT(glyph_index_in_font != 0);
+            if (sdf)
+            {
+                // Distance fields are sampled smoothly at any scale: no oversampling, but room for the distance range around the glyph (matches stbtt_GetGlyphSDF)
+                stbtt_GetGlyphBitmapBox(&src_tmp.FontInfo, glyph_index_in_font, scale, scale, &x0, &y0, &x1, &y1);
+                const int sdf_padding = (x0 == x1 || y0 == y1) ? 0 : atlas->TexSdfPadding * 2;
+                src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + sdf_padding + padding);
+                src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + sdf_padding + padding);
+                total_surface += src_tmp.Rects[glyph_i].w * src_tmp.Rects[glyph_i].h;
+                continue;
+            }
             stbtt_GetGlyphBitmapBoxSubpixel(&src_tmp.FontInfo, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
             src_tmp.Rects[glyph_i].w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
             src_tmp.Rects[glyph_i].h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
@@ -2561,6 +3132,13 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         if (src_tmp.GlyphsCount == 0)
             continue;
 
+        if (sdf)
+        {
+            ImFontAtlasBuildRenderSdfGlyphs(atlas, &src_tmp, cfg);
+            src_tmp.Rects = NULL;
+            continue;
+        }
+
         stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
 
         // Apply multiply operator
@@ -2735,7 +3313,7 @@ static void ImFontAtlasBuildRenderDefaultTexData(ImFontAtlas* atlas)
 
 static void ImFontAtlasBuildRenderLinesTexData(ImFontAtlas* atlas)
 {
-    if (atlas->Flags & ImFontAtlasFlags_NoBakedLines)
+    if (atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField))
         return;
 
     // This generates a triangular shape in the texture, with the various line widths stacked on top of each other to allow interpolation between them
@@ -2800,7 +3378,7 @@ void ImFontAtlasBuildInit(ImFontAtlas* atlas)
     // The +2 here is to give space for the end caps, whilst height +1 is to accommodate the fact we have a zero-width row
     if (atlas->PackIdLines < 0)
     {
-        if (!(atlas->Flags & ImFontAtlasFlags_NoBakedLines))
+        if (!(atlas->Flags & (ImFontAtlasFlags_NoBakedLines | ImFontAtlasFlags_SignedDistanceField)))
             atlas->PackIdLines = atlas->AddCustomRectRegular(IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 2, IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1);
     }
 }
@@ -14,6 +14,7 @@ Index of this file:
 // [SECTION] Tables: Columns width management
 // [SECTION] Tables: Drawing
 // [SECTION] Tables: Sorting
+// [SECTION] Tables: Data source
 // [SECTION] Tables: Headers
 // [SECTION] Tables: Context Menu
 // [SECTION] Tables: Settings (.ini data)
@@ -2788,6 +2789,150 @@ void ImGui::TableSortSpecsBuild(ImGuiTable* table)
     table->SortSpecs.SpecsCount = table->SortSpecsCount;
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] Tables: Data source
+//-------------------------------------------------------------------------
+// - TableSetDataSource()
+// - TableGetDataSourceRow()
+// - TableSubmitDataSourceRows()
+// - TableDataSourceBuildRows() [Internal]
+//-------------------------------------------------------------------------
+
+int ImGui::TableSetDataSource(const ImGuiTableDataSource* source)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && "Need to call TableSetDataSource() after BeginTable()!");
+    IM_ASSERT(source != NULL && source->RowCount >= 0);
+    table->DataSource = *source;
+
+    // Identify sort specs by content: SpecsDirty belongs to the user and may be cleared elsewhere
+    ImGuiTableSortSpecs* sort_specs = source->CompareRows ? TableGetSortSpecs() : NULL;
+    ImGuiID sort_hash = 0;
+    if (sort_specs != NULL)
+        for (int n = 0; n < sort_specs->SpecsCount; n++)
+        {
+            const ImGuiTableColumnSortSpecs* spec = &sort_specs->Specs[n];
+            const ImU32 key[3] = { spec->ColumnUserID, (ImU32)spec->ColumnIndex, (ImU32)spec->SortDirection };
+            sort_hash = ImHashData(key, sizeof(key), sort_hash);
+        }
+
+    if (!table->IsDataSourceValid || table->DataSourceVersion != source->DataVersion || table->DataSourceRowCount != source->RowCount || table->DataSourceSortHash != sort_hash)
+    {
+        TableDataSourceBuildRows(table, sort_specs);
+        table->DataSourceVersion = source->DataVersion;
+        table->DataSourceRowCount = source->RowCount;
+        table->DataSourceSortHash = sort_hash;
+        table->IsDataSourceValid = true;
+        if (sort_specs != NULL)
+            sort_specs->SpecsDirty = false;
+    }
+    return table->DataSourceRows.Size;
+}
+
+int ImGui::TableGetDataSourceRow(int display_n)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && table->IsDataSourceValid && "Need to call TableSetDataSource() first!");
+    IM_ASSERT(display_n >= 0 && display_n < table->DataSourceRows.Size);
+    return table->DataSourceRows.Data[display_n];
+}
+
+void ImGui::TableSubmitDataSourceRows(float items_height)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    IM_ASSERT(table != NULL && table->IsDataSourceValid && "Need to call TableSetDataSource() first!");
+    IM_ASSERT(table->DataSource.SubmitRow != NULL);
+
+    // Rows may create new tables which can reallocate the pool: fetch the table by index after each user callback
+    const int table_idx = g.Tables.GetIndex(table);
+    ImGuiListClipper clipper;
+    clipper.Begin(table->DataSourceRows.Size, items_height);
+    while (clipper.Step())
+    {
+        table = g.Tables.GetByIndex(table_idx);
+        const ImGuiTableDataSource source = table->DataSource;
+        if (source.FetchRows != NULL && clipper.DisplayEnd > clipper.DisplayStart)
+            source.FetchRows(source.UserData, table->DataSourceRows.Data + clipper.DisplayStart, clipper.DisplayEnd - clipper.DisplayStart);
+        for (int display_n = clipper.DisplayStart; display_n < clipper.DisplayEnd; display_n++)
+        {
+            TableNextRow();
+            source.SubmitRow(source.UserData, g.Tables.GetByIndex(table_idx)->DataSourceRows.Data[display_n]);
+        }
+    }
+}
+
+// Compare two rows with each sort spec in order, SortDirection applied
+static int TableDataSourceCompareRows(const ImGuiTableDataSource* source, const ImGuiTableSortSpecs* sort_specs, int row_a, int row_b)
+{
+    for (int n = 0; n < sort_specs->SpecsCount; n++)
+    {
+        const ImGuiTableColumnSortSpecs* spec = &sort_specs->Specs[n];
+        const int delta = source->CompareRows(source->UserData, spec, row_a, row_b);
+        if (delta != 0)
+            return (spec->SortDirection == ImGuiSortDirection_Descending) ? -delta : delta;
+    }
+    return 0;
+}
+
+// Filter rows, then sort them with a stable merge sort (rows comparing equal keep their data order, no qsort() context pointer needed).
+void ImGui::TableDataSourceBuildRows(ImGuiTable* table, const ImGuiTableSortSpecs* sort_specs)
+{
+    const ImGuiTableDataSource* source = &table->DataSource;
+    ImVector<int>& rows = table->DataSourceRows;
+    rows.resize(source->RowCount);
+    int count = 0;
+    for (int row = 0; row < source->RowCount; row++)
+        if (source->FilterRow == NULL || source->FilterRow(source->UserData, row))
+            rows.Data[count++] = row;
+    rows.resize(count);
+    if (sort_specs == NULL || sort_specs->SpecsCount == 0 || count < 2)
+        return;
+
+    // Insertion sort small runs, then merge runs of doubling width between the two buffers
+    const int RUN = 16;
+    for (int start = 0; start < count; start += RUN)
+    {
+        const int end = ImMin(start + RUN, count);
+        for (int i = start + 1; i < end; i++)
+        {
+            const int row = rows.Data[i];
+            int j = i;
+            for (; j > start && TableDataSourceCompareRows(source, sort_specs, row, rows.Data[j - 1]) < 0; j--)
+                rows.Data[j] = rows.Data[j - 1];
+            rows.Data[j] = row;
+        }
+    }
+    // Merge buffer only lives until the end of this call: take it from the frame arena (no MemAlloc()/MemFree() when rows change every frame)
+    int* src = rows.Data;
+    int* dst = (int*)MemAllocFrame((size_t)count * sizeof(int));
+    for (int width = RUN; width < count; width *= 2)
+    {
+        for (int lo = 0; lo < count; lo += width * 2)
+        {
+            const int mid = ImMin(lo + width, count);
+            const int hi = ImMin(lo + width * 2, count);
+            if (mid == hi || TableDataSourceCompareRows(source, sort_specs, src[mid - 1], src[mid]) <= 0)
+            {
+                memcpy(dst + lo, src + lo, (size_t)(hi - lo) * sizeof(int)); // Already in order
+                continue;
+            }
+            int i = lo, j = mid, k = lo;
+            while (i < mid && j < hi)
+                dst[k++] = (TableDataSourceCompareRows(source, sort_specs, src[j], src[i]) < 0) ? src[j++] : src[i++];
+            while (i < mid)
+                dst[k++] = src[i++];
+            while (j < hi)
+                dst[k++] = src[j++];
+        }
+        ImSwap(src, dst);
+    }
+    if (src != rows.Data)
+        memcpy(rows.Data, src, (size_t)count * sizeof(int));
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] Tables: Headers
 //-------------------------------------------------------------------------
@@ -3438,7 +3583,7 @@ void ImGui::TableSettingsInstallHandler(ImGuiContext* context)
     ImGuiContext& g = *context;
     ImGuiSettingsHandler ini_handler;
     ini_handler.TypeName = "Table";
-    ini_handler.TypeHash = ImHashStr("Table");
+    ini_handler.TypeHash = ImHashStrConst("Table");
     ini_handler.ClearAllFn = TableSettingsHandler_ClearAll;
     ini_handler.ReadOpenFn = TableSettingsHandler_ReadOpen;
     ini_handler.ReadLineFn = TableSettingsHandler_ReadLine;
@@ -3476,6 +3621,8 @@ void ImGui::TableGcCompactTransientBuffers(ImGuiTable* table)
     table->SortSpecs.Specs = NULL;
     table->SortSpecsMulti.clear();
     table->IsSortSpecsDirty = true; // FIXME: shouldn't have to leak into user performing a sort
+    table->DataSourceRows.clear();
+    table->IsDataSourceValid = false;
     table->ColumnsNames.clear();
     table->MemoryCompacted = true;
     for (int n = 0; n < table->ColumnsCount; n++)
@@ -71,6 +71,11 @@ ExternFunction::ExternFunction() {
         funcPointer.func_runRecord = dlsym(handle, "_Z9runRecordPbPFvPhmE");
         funcPointer.func_stopRecord = dlsym(handle, "_Z10stopRecordv");
         funcPointer.func_getRecordNativeWindow = dlsym(handle, "_Z21getRecordNativeWindowv");
+        funcPointer.func_initRecordConfig = dlsym(handle, "_Z16initRecordConfigPK12RecordConfig");
+        funcPointer.func_initRawCapture = dlsym(handle, "_Z14initRawCapturejjii");
+        funcPointer.func_acquireRawFrame = dlsym(handle, "_Z15acquireRawFrameP8RawFramei");
+        funcPointer.func_releaseRawFrame = dlsym(handle, "_Z15releaseRawFrameP8RawFrame");
+        funcPointer.func_stopRawCapture = dlsym(handle, "_Z14stopRawCapturev");
     }
 
 }
@@ -140,6 +145,26 @@ void ExternFunction::initRecord(const char *bitRate, float fps,
             (bitRate, fps, videoWidth, videoHeight);
 }
 
+/**
+ * h264 录屏
+ * 录屏初始化，裁剪和缩放在虚拟屏幕的投影里完成，编码器只处理输出大小的画面
+ * @param config 裁剪区域(屏幕坐标)、输出大小或缩放、跳帧
+ * @return
+ */
+bool ExternFunction::initRecord(const RecordConfig &config) {
+    if (funcPointer.func_initRecordConfig != nullptr) {
+        return ((bool (*)(const RecordConfig *)) (funcPointer.func_initRecordConfig))(&config);
+    }
+    // 旧版本的库只支持整个屏幕
+    if (config.cropWidth != 0 || config.cropHeight != 0 || config.cropX != 0 || config.cropY != 0 ||
+        config.scale != 1.0f || config.frameSkip > 1) {
+        printf("record config not supported by level:%d\n", get_android_api_level());
+        return false;
+    }
+    initRecord(config.bitRate, config.fps, config.videoWidth, config.videoHeight);
+    return true;
+}
+
 /**
  * 获取录屏window(有bug暂时无用)
  * @return
@@ -162,4 +187,63 @@ void ExternFunction::runRecord(bool *flag, void (*callback)(uint8_t *, size_t))
  */
 void ExternFunction::stopRecord() {
     ((void (*)()) (funcPointer.func_stopRecord))();
-}
\ No newline at end of file
+}
+
+/**
+ * 原始帧采集初始化，虚拟屏幕直接输出到 AImageReader，不经过编码器
+ * @param width 帧宽度，设置0为默认屏幕宽
+ * @param height 帧高度，设置0为默认屏幕高
+ * @param format RawFrame_RGBA_8888 或 RawFrame_YUV_420_888
+ * @param maxImages 调用方最多同时持有的帧数
+ * @return
+ */
+bool ExternFunction::initRawCapture(uint32_t width, uint32_t height, int32_t format, int32_t maxImages) {
+    if (!hasRawCapture()) {
+        printf("raw capture not supported by level:%d\n", get_android_api_level());
+        return false;
+    }
+    return ((bool (*)(uint32_t, uint32_t, int32_t, int32_t)) (funcPointer.func_initRawCapture))
+            (width, height, format, maxImages);
+}
+
+/**
+ * 取最新的一帧
+ * @param frame
+ * @param timeoutMs 没有新帧时的最长等待时间
+ * @return
+ */
+bool ExternFunction::acquireRawFrame(RawFrame *frame, int32_t timeoutMs) {
+    if (funcPointer.func_acquireRawFrame == nullptr) {
+        return false;
+    }
+    return ((bool (*)(RawFrame *, int32_t)) (funcPointer.func_acquireRawFrame))(frame, timeoutMs);
+}
+
+/**
+ * 释放帧
+ * @param frame
+ */
+void ExternFunction::releaseRawFrame(RawFrame *frame) {
+    if (funcPointer.func_releaseRawFrame == nullptr) {
+        return;
+    }
+    ((void (*)(RawFrame *)) (funcPointer.func_releaseRawFrame))(frame);
+}
+
+/**
+ * 原始帧采集结束调用
+ */
+void ExternFunction::stopRawCapture() {
+    if (funcPointer.func_stopRawCapture == nullptr) {
+        return;
+    }
+    ((void (*)()) (funcPointer.func_stopRawCapture))();
+}
+
+/**
+ * 库是否导出了原始帧采集的全部符号
+ */
+bool ExternFunction::hasRawCapture() {
+    return funcPointer.func_initRawCapture != nullptr && funcPointer.func_acquireRawFrame != nullptr &&
+           funcPointer.func_releaseRawFrame != nullptr && funcPointer.func_stopRawCapture != nullptr;
+}
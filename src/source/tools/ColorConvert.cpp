@@ -0,0 +1,256 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "ColorConvert.h"
+#include "Profiler.h"
+#include <cstddef>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define COLOR_CONVERT_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define COLOR_CONVERT_SSE2
+#include <emmintrin.h>
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+#endif
+
+// Q14 系数
+static const int COEF_RV = 22970;       // 1.402
+static const int COEF_GU = -5638;       // -0.34414
+static const int COEF_GV = -11700;      // -0.71414
+static const int COEF_BU = 29032;       // 1.772
+static const int COEF_ROUND = 1 << 13;
+
+// 每种顺序中 R/G/B 的位置
+struct ChannelLayout {
+    int r;
+    int g;
+    int b;
+    int channels;
+};
+
+static ChannelLayout channelLayout(ColorConvertOrder order) {
+    switch (order) {
+        case ColorConvert_RGB:
+            return {0, 1, 2, 3};
+        case ColorConvert_BGRA:
+            return {2, 1, 0, 4};
+        case ColorConvert_RGBA:
+            return {0, 1, 2, 4};
+        case ColorConvert_BGR:
+        default:
+            return {2, 1, 0, 3};
+    }
+}
+
+static inline uint8_t clampByte(int value) {
+    return (uint8_t) (value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+// 转换一行中 [x, width) 的像素
+static void convertRowScalar(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, int x, int width,
+                             const ChannelLayout &layout) {
+    for (; x < width; x++) {
+        int du = u[x >> 1] - 128;
+        int dv = v[x >> 1] - 128;
+        int luma = y[x];
+        uint8_t *pixel = dst + x * layout.channels;
+        pixel[layout.r] = clampByte(luma + ((COEF_RV * dv + COEF_ROUND) >> 14));
+        pixel[layout.g] = clampByte(luma + ((COEF_GU * du + COEF_GV * dv + COEF_ROUND) >> 14));
+        pixel[layout.b] = clampByte(luma + ((COEF_BU * du + COEF_ROUND) >> 14));
+        if (layout.channels == 4) {
+            pixel[3] = 255;
+        }
+    }
+}
+
+#if defined(COLOR_CONVERT_NEON)
+
+// 每次16个像素(8个色度样本)，vrshrn 的舍入和标量的 (x + 8192) >> 14 一致
+static int convertRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, int width,
+                          const ChannelLayout &layout) {
+    const uint8x8_t bias = vdup_n_u8(128);
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        int16x8_t du = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(u + (x >> 1)), bias));
+        int16x8_t dv = vreinterpretq_s16_u16(vsubl_u8(vld1_u8(v + (x >> 1)), bias));
+
+        int16x8_t rTerm = vcombine_s16(vrshrn_n_s32(vmull_n_s16(vget_low_s16(dv), COEF_RV), 14),
+                                       vrshrn_n_s32(vmull_n_s16(vget_high_s16(dv), COEF_RV), 14));
+        int32x4_t gLow = vmlal_n_s16(vmull_n_s16(vget_low_s16(du), COEF_GU), vget_low_s16(dv), COEF_GV);
+        int32x4_t gHigh = vmlal_n_s16(vmull_n_s16(vget_high_s16(du), COEF_GU), vget_high_s16(dv), COEF_GV);
+        int16x8_t gTerm = vcombine_s16(vrshrn_n_s32(gLow, 14), vrshrn_n_s32(gHigh, 14));
+        int16x8_t bTerm = vcombine_s16(vrshrn_n_s32(vmull_n_s16(vget_low_s16(du), COEF_BU), 14),
+                                       vrshrn_n_s32(vmull_n_s16(vget_high_s16(du), COEF_BU), 14));
+
+        // 每个色度样本对应两个像素
+        int16x8x2_t r = vzipq_s16(rTerm, rTerm);
+        int16x8x2_t g = vzipq_s16(gTerm, gTerm);
+        int16x8x2_t b = vzipq_s16(bTerm, bTerm);
+
+        uint8x16_t luma = vld1q_u8(y + x);
+        int16x8_t yLow = vreinterpretq_s16_u16(vmovl_u8(vget_low_u8(luma)));
+        int16x8_t yHigh = vreinterpretq_s16_u16(vmovl_u8(vget_high_u8(luma)));
+        uint8x16_t red = vcombine_u8(vqmovun_s16(vqaddq_s16(yLow, r.val[0])), vqmovun_s16(vqaddq_s16(yHigh, r.val[1])));
+        uint8x16_t green = vcombine_u8(vqmovun_s16(vqaddq_s16(yLow, g.val[0])),
+                                       vqmovun_s16(vqaddq_s16(yHigh, g.val[1])));
+        uint8x16_t blue = vcombine_u8(vqmovun_s16(vqaddq_s16(yLow, b.val[0])),
+                                      vqmovun_s16(vqaddq_s16(yHigh, b.val[1])));
+
+        if (layout.channels == 4) {
+            uint8x16x4_t pixels;
+            pixels.val[layout.r] = red;
+            pixels.val[layout.g] = green;
+            pixels.val[layout.b] = blue;
+            pixels.val[3] = vdupq_n_u8(255);
+            vst4q_u8(dst + x * 4, pixels);
+        } else {
+            uint8x16x3_t pixels;
+            pixels.val[layout.r] = red;
+            pixels.val[layout.g] = green;
+            pixels.val[layout.b] = blue;
+            vst3q_u8(dst + x * 3, pixels);
+        }
+    }
+    return x;
+}
+
+#elif defined(COLOR_CONVERT_SSE2)
+
+// 4个 (d, 1) 对和 (coef, 8192) 做 madd，得到 coef * d + 8192
+static inline __m128i termPairs(__m128i low, __m128i high, __m128i coef) {
+    __m128i termLow = _mm_srai_epi32(_mm_madd_epi16(low, coef), 14);
+    __m128i termHigh = _mm_srai_epi32(_mm_madd_epi16(high, coef), 14);
+    return _mm_packs_epi32(termLow, termHigh);
+}
+
+static inline __m128i addTerm(__m128i yLow, __m128i yHigh, __m128i term) {
+    return _mm_packus_epi16(_mm_adds_epi16(yLow, _mm_unpacklo_epi16(term, term)),
+                            _mm_adds_epi16(yHigh, _mm_unpackhi_epi16(term, term)));
+}
+
+// 每次16个像素(8个色度样本)
+static int convertRowSimd(const uint8_t *y, const uint8_t *u, const uint8_t *v, uint8_t *dst, int width,
+                          const ChannelLayout &layout) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i bias = _mm_set1_epi16(128);
+    const __m128i one = _mm_set1_epi16(1);
+    const __m128i coefR = _mm_set1_epi32((COEF_ROUND << 16) | COEF_RV);
+    const __m128i coefB = _mm_set1_epi32((COEF_ROUND << 16) | COEF_BU);
+    const __m128i coefG = _mm_set1_epi32((int) (((uint32_t) (uint16_t) COEF_GV << 16) | (uint16_t) COEF_GU));
+    const __m128i round = _mm_set1_epi32(COEF_ROUND);
+    const __m128i alpha = _mm_set1_epi8((char) 0xff);
+#if defined(__SSSE3__)
+    // 去掉每个像素的第4个字节
+    const __m128i pack3 = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+#endif
+    int x = 0;
+    for (; x + 16 <= width; x += 16) {
+        __m128i du = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (u + (x >> 1))), zero), bias);
+        __m128i dv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *) (v + (x >> 1))), zero), bias);
+
+        __m128i rTerm = termPairs(_mm_unpacklo_epi16(dv, one), _mm_unpackhi_epi16(dv, one), coefR);
+        __m128i bTerm = termPairs(_mm_unpacklo_epi16(du, one), _mm_unpackhi_epi16(du, one), coefB);
+        __m128i gLow = _mm_add_epi32(_mm_madd_epi16(_mm_unpacklo_epi16(du, dv), coefG), round);
+        __m128i gHigh = _mm_add_epi32(_mm_madd_epi16(_mm_unpackhi_epi16(du, dv), coefG), round);
+        __m128i gTerm = _mm_packs_epi32(_mm_srai_epi32(gLow, 14), _mm_srai_epi32(gHigh, 14));
+
+        __m128i luma = _mm_loadu_si128((const __m128i *) (y + x));
+        __m128i yLow = _mm_unpacklo_epi8(luma, zero);
+        __m128i yHigh = _mm_unpackhi_epi8(luma, zero);
+        __m128i channels[4];
+        channels[layout.r] = addTerm(yLow, yHigh, rTerm);
+        channels[layout.g] = addTerm(yLow, yHigh, gTerm);
+        channels[layout.b] = addTerm(yLow, yHigh, bTerm);
+        channels[3] = alpha;
+
+        // 交错成每像素4字节: 每个寄存器4个像素
+        __m128i c01Low = _mm_unpacklo_epi8(channels[0], channels[1]);
+        __m128i c01High = _mm_unpackhi_epi8(channels[0], channels[1]);
+        __m128i c23Low = _mm_unpacklo_epi8(channels[2], channels[3]);
+        __m128i c23High = _mm_unpackhi_epi8(channels[2], channels[3]);
+        __m128i pixels[4] = {_mm_unpacklo_epi16(c01Low, c23Low), _mm_unpackhi_epi16(c01Low, c23Low),
+                             _mm_unpacklo_epi16(c01High, c23High), _mm_unpackhi_epi16(c01High, c23High)};
+        if (layout.channels == 4) {
+            __m128i *out = (__m128i *) (dst + x * 4);
+            for (int i = 0; i < 4; i++) {
+                _mm_storeu_si128(out + i, pixels[i]);
+            }
+            continue;
+        }
+#if defined(__SSSE3__)
+        __m128i a = _mm_shuffle_epi8(pixels[0], pack3);
+        __m128i b = _mm_shuffle_epi8(pixels[1], pack3);
+        __m128i c = _mm_shuffle_epi8(pixels[2], pack3);
+        __m128i d = _mm_shuffle_epi8(pixels[3], pack3);
+        __m128i *out = (__m128i *) (dst + x * 3);
+        _mm_storeu_si128(out, _mm_or_si128(a, _mm_slli_si128(b, 12)));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(b, 4), _mm_slli_si128(c, 8)));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(c, 8), _mm_slli_si128(d, 4)));
+#else
+        alignas(16) uint8_t temp[64];
+        for (int i = 0; i < 4; i++) {
+            _mm_store_si128((__m128i *) temp + i, pixels[i]);
+        }
+        uint8_t *out = dst + x * 3;
+        for (int i = 0; i < 16; i++) {
+            out[i * 3] = temp[i * 4];
+            out[i * 3 + 1] = temp[i * 4 + 1];
+            out[i * 3 + 2] = temp[i * 4 + 2];
+        }
+#endif
+    }
+    return x;
+}
+
+#else
+
+static int convertRowSimd(const uint8_t *, const uint8_t *, const uint8_t *, uint8_t *, int, const ChannelLayout &) {
+    return 0;
+}
+
+#endif
+
+void ColorConvert::yuv420pToRgb(const uint8_t *y, int yStride, const uint8_t *u, int uStride, const uint8_t *v,
+                                int vStride, uint8_t *dst, int dstStride, int width, int height,
+                                ColorConvertOrder order) {
+    PROFILE_ZONE("ColorConvert::yuv420pToRgb");
+    ChannelLayout layout = channelLayout(order);
+    for (int row = 0; row < height; row++) {
+        const uint8_t *yRow = y + (size_t) row * yStride;
+        const uint8_t *uRow = u + (size_t) (row >> 1) * uStride;
+        const uint8_t *vRow = v + (size_t) (row >> 1) * vStride;
+        uint8_t *dstRow = dst + (size_t) row * dstStride;
+        int x = convertRowSimd(yRow, uRow, vRow, dstRow, width, layout);
+        convertRowScalar(yRow, uRow, vRow, dstRow, x, width, layout);
+    }
+}
+
+void ColorConvert::yuv420pToRgbScalar(const uint8_t *y, int yStride, const uint8_t *u, int uStride,
+                                      const uint8_t *v, int vStride, uint8_t *dst, int dstStride, int width,
+                                      int height, ColorConvertOrder order) {
+    ChannelLayout layout = channelLayout(order);
+    for (int row = 0; row < height; row++) {
+        convertRowScalar(y + (size_t) row * yStride, u + (size_t) (row >> 1) * uStride,
+                         v + (size_t) (row >> 1) * vStride, dst + (size_t) row * dstStride, 0, width, layout);
+    }
+}
+
+const char *ColorConvert::simdName() {
+#if defined(COLOR_CONVERT_NEON)
+    return "neon";
+#elif defined(COLOR_CONVERT_SSE2) && defined(__SSSE3__)
+    return "ssse3";
+#elif defined(COLOR_CONVERT_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+int ColorConvert::channels(ColorConvertOrder order) {
+    return channelLayout(order).channels;
+}
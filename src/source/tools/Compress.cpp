@@ -0,0 +1,475 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Compress.h"
+#include "Profiler.h"
+#include <zlib.h>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+static const int LZ4_MIN_MATCH = 4;
+static const int LZ4_LAST_LITERALS = 5;         // 最后5个字节必须是字面量
+static const int LZ4_MATCH_LIMIT = 12;          // 距离结尾12字节以内不再开始匹配
+static const int LZ4_MAX_OFFSET = 65535;
+static const int LZ4_HASH_BITS = 12;
+static const size_t LZ4_WINDOW = 64 * 1024;     // 流模式保留的字典
+static const size_t LZ4_HISTORY_LIMIT = 256 * 1024; // 历史超过它时搬回最近的64KB
+
+// Z_SYNC_FLUSH 输出末尾固定的空块
+static const uint8_t ZLIB_SYNC_TAIL[4] = {0x00, 0x00, 0xff, 0xff};
+
+static inline uint32_t read32(const uint8_t *p) {
+    uint32_t value;
+    memcpy(&value, p, 4);
+    return value;
+}
+
+static inline uint32_t lz4Hash(uint32_t sequence) {
+    return (sequence * 2654435761u) >> (32 - LZ4_HASH_BITS);
+}
+
+static inline uint8_t *lz4WriteLength(uint8_t *op, int length) {
+    for (; length >= 255; length -= 255) {
+        *op++ = 255;
+    }
+    *op++ = (uint8_t) length;
+    return op;
+}
+
+/**
+ * 压缩 base[start, end)，匹配可以引用 base[lowLimit, start) 里的字典
+ * 哈希表里的位置只是候选(可能是上一次调用留下的)，使用前比较4个字节，不需要每次清空
+ */
+static int lz4CompressBlock(const uint8_t *base, int start, int end, int lowLimit, uint8_t *dst, int dstCapacity,
+                            int32_t *table) {
+    uint8_t *op = dst;
+    uint8_t *oend = dst + dstCapacity;
+    int anchor = start;
+    int ip = start;
+    int matchEnd = end - LZ4_LAST_LITERALS;
+    int matchStartLimit = end - LZ4_MATCH_LIMIT;
+    while (ip <= matchStartLimit) {
+        uint32_t sequence = read32(base + ip);
+        uint32_t hash = lz4Hash(sequence);
+        int candidate = table[hash];
+        table[hash] = ip;
+        if (candidate < lowLimit || candidate >= ip || ip - candidate > LZ4_MAX_OFFSET ||
+            read32(base + candidate) != sequence) {
+            // 连续没有匹配时步长逐渐变大(不可压缩的数据很快跳过)
+            ip += 1 + ((ip - anchor) >> 6);
+            continue;
+        }
+        while (ip > anchor && candidate > lowLimit && base[ip - 1] == base[candidate - 1]) {
+            ip--;
+            candidate--;
+        }
+        int length = LZ4_MIN_MATCH;
+        while (ip + length < matchEnd && base[ip + length] == base[candidate + length]) {
+            length++;
+        }
+        int literals = ip - anchor;
+        int matchLength = length - LZ4_MIN_MATCH;
+        if (op + 1 + literals / 255 + 1 + literals + 2 + matchLength / 255 + 1 > oend) {
+            return -1;
+        }
+        uint8_t *token = op++;
+        if (literals >= 15) {
+            *token = 15 << 4;
+            op = lz4WriteLength(op, literals - 15);
+        } else {
+            *token = (uint8_t) (literals << 4);
+        }
+        memcpy(op, base + anchor, (size_t) literals);
+        op += literals;
+        int offset = ip - candidate;
+        *op++ = (uint8_t) (offset & 0xff);
+        *op++ = (uint8_t) (offset >> 8);
+        if (matchLength >= 15) {
+            *token |= 15;
+            op = lz4WriteLength(op, matchLength - 15);
+        } else {
+            *token |= (uint8_t) matchLength;
+        }
+        ip += length;
+        anchor = ip;
+        if (ip - 2 >= start && ip + 2 <= end) {
+            table[lz4Hash(read32(base + ip - 2))] = ip - 2;
+        }
+    }
+    int literals = end - anchor;
+    if (op + 1 + literals / 255 + 1 + literals > oend) {
+        return -1;
+    }
+    uint8_t *token = op++;
+    if (literals >= 15) {
+        *token = 15 << 4;
+        op = lz4WriteLength(op, literals - 15);
+    } else {
+        *token = (uint8_t) (literals << 4);
+    }
+    memcpy(op, base + anchor, (size_t) literals);
+    op += literals;
+    return (int) (op - dst);
+}
+
+/**
+ * 解压到 out[start, start + capacity)，匹配可以引用 out[0, start) 里的字典
+ * 所有长度和偏移都检查边界，损坏的数据返回-1
+ */
+static int lz4DecompressBlock(const uint8_t *src, int srcLen, uint8_t *out, size_t start, size_t capacity) {
+    const uint8_t *ip = src;
+    const uint8_t *iend = src + srcLen;
+    uint8_t *op = out + start;
+    uint8_t *oend = op + capacity;
+    while (ip < iend) {
+        unsigned token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15) {
+            unsigned value;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                value = *ip++;
+                literals += value;
+            } while (value == 255);
+        }
+        if (literals > (size_t) (iend - ip) || literals > (size_t) (oend - op)) {
+            return -1;
+        }
+        memcpy(op, ip, literals);
+        op += literals;
+        ip += literals;
+        if (ip >= iend) {
+            break;
+        }
+        if (iend - ip < 2) {
+            return -1;
+        }
+        size_t offset = ip[0] | (ip[1] << 8);
+        ip += 2;
+        if (offset == 0 || offset > (size_t) (op - out)) {
+            return -1;
+        }
+        size_t length = token & 15;
+        if (length == 15) {
+            unsigned value;
+            do {
+                if (ip >= iend) {
+                    return -1;
+                }
+                value = *ip++;
+                length += value;
+            } while (value == 255);
+        }
+        length += LZ4_MIN_MATCH;
+        if (length > (size_t) (oend - op)) {
+            return -1;
+        }
+        const uint8_t *match = op - offset;
+        if (offset >= length) {
+            memcpy(op, match, length);
+            op += length;
+        } else {
+            // 重叠的匹配(重复的短模式)逐字节复制
+            for (size_t i = 0; i < length; i++) {
+                *op++ = *match++;
+            }
+        }
+    }
+    return (int) (op - (out + start));
+}
+
+// 流模式的历史: 超过上限时只保留最近的64KB，哈希表里的位置跟着平移
+static void lz4Compact(std::vector<uint8_t> &history, size_t &size, size_t incoming, int32_t *table) {
+    if (size + incoming <= LZ4_HISTORY_LIMIT || size <= LZ4_WINDOW) {
+        return;
+    }
+    size_t shift = size - LZ4_WINDOW;
+    memmove(history.data(), history.data() + shift, LZ4_WINDOW);
+    size = LZ4_WINDOW;
+    if (table != nullptr) {
+        for (int i = 0; i < (1 << LZ4_HASH_BITS); i++) {
+            table[i] = table[i] >= (int32_t) shift ? table[i] - (int32_t) shift : -1;
+        }
+    }
+}
+
+CompressContext::CompressContext(int zlibLevel) : zlibLevel(std::max(1, std::min(9, zlibLevel))) {
+    lz4Table.assign(1 << LZ4_HASH_BITS, -1);
+}
+
+CompressContext::~CompressContext() {
+    if (deflater != nullptr) {
+        deflateEnd(deflater);
+        delete deflater;
+    }
+    if (inflater != nullptr) {
+        inflateEnd(inflater);
+        delete inflater;
+    }
+}
+
+bool CompressContext::initDeflate() {
+    if (deflater != nullptr) {
+        return true;
+    }
+    deflater = new z_stream();
+    // raw deflate(windowBits 为负)，不带zlib头和adler32，长度和算法记在 DataEnc 头里
+    if (deflateInit2(deflater, zlibLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        printf("CompressContext: deflateInit2 failed\n");
+        delete deflater;
+        deflater = nullptr;
+        return false;
+    }
+    return true;
+}
+
+bool CompressContext::initInflate() {
+    if (inflater != nullptr) {
+        return true;
+    }
+    inflater = new z_stream();
+    if (inflateInit2(inflater, -15) != Z_OK) {
+        printf("CompressContext: inflateInit2 failed\n");
+        delete inflater;
+        inflater = nullptr;
+        return false;
+    }
+    return true;
+}
+
+int CompressContext::deflateData(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity) {
+    if (!initDeflate()) {
+        return -1;
+    }
+    if (!streaming) {
+        deflateReset(deflater);
+    }
+    deflater->next_in = (Bytef *) src;
+    deflater->avail_in = (uInt) srcLen;
+    deflater->next_out = dst;
+    deflater->avail_out = (uInt) dstCapacity;
+    if (!streaming) {
+        if (deflate(deflater, Z_FINISH) != Z_STREAM_END) {
+            printf("CompressContext: deflate output larger than %d\n", dstCapacity);
+            return -1;
+        }
+        return dstCapacity - (int) deflater->avail_out;
+    }
+    if (srcLen == 0) {
+        return 0;
+    }
+    // 输出缓冲有剩余才说明 flush 完整
+    int err = deflate(deflater, Z_SYNC_FLUSH);
+    int length = dstCapacity - (int) deflater->avail_out;
+    if (err != Z_OK || deflater->avail_in != 0 || deflater->avail_out == 0 || length < 4 ||
+        memcmp(dst + length - 4, ZLIB_SYNC_TAIL, 4) != 0) {
+        printf("CompressContext: deflate stream failed (%d), resetStream required\n", err);
+        return -1;
+    }
+    // 去掉固定的4字节，解压时补回
+    return length - 4;
+}
+
+int CompressContext::inflateData(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity) {
+    if (!initInflate()) {
+        return -1;
+    }
+    if (!streaming) {
+        inflateReset(inflater);
+    }
+    inflater->next_in = (Bytef *) src;
+    inflater->avail_in = (uInt) srcLen;
+    inflater->next_out = dst;
+    inflater->avail_out = (uInt) dstCapacity;
+    if (!streaming) {
+        int err = inflate(inflater, Z_FINISH);
+        if (err != Z_STREAM_END) {
+            printf("CompressContext: inflate failed (%d)\n", err);
+            return -1;
+        }
+        return dstCapacity - (int) inflater->avail_out;
+    }
+    if (srcLen == 0) {
+        return 0;
+    }
+    int err = inflate(inflater, Z_SYNC_FLUSH);
+    if ((err != Z_OK && err != Z_BUF_ERROR) || inflater->avail_in != 0) {
+        printf("CompressContext: inflate stream failed (%d), resetStream required\n", err);
+        return -1;
+    }
+    inflater->next_in = (Bytef *) ZLIB_SYNC_TAIL;
+    inflater->avail_in = 4;
+    err = inflate(inflater, Z_SYNC_FLUSH);
+    if ((err != Z_OK && err != Z_BUF_ERROR) || inflater->avail_in != 0) {
+        printf("CompressContext: inflate stream failed (%d), resetStream required\n", err);
+        return -1;
+    }
+    return dstCapacity - (int) inflater->avail_out;
+}
+
+int CompressContext::lz4Compress(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity) {
+    if (!streaming) {
+        return lz4CompressBlock(src, 0, srcLen, 0, dst, dstCapacity, lz4Table.data());
+    }
+    // 新数据接在历史后面压缩，匹配可以引用前面64KB
+    lz4Compact(lz4EncodeHistory, lz4EncodeSize, (size_t) srcLen, lz4Table.data());
+    size_t start = lz4EncodeSize;
+    if (lz4EncodeHistory.size() < start + srcLen) {
+        // 一次分配到上限，之后在原地追加
+        lz4EncodeHistory.resize(std::max(start + srcLen, LZ4_HISTORY_LIMIT));
+    }
+    memcpy(lz4EncodeHistory.data() + start, src, (size_t) srcLen);
+    int lowLimit = start > (size_t) LZ4_MAX_OFFSET ? (int) start - LZ4_MAX_OFFSET : 0;
+    int length = lz4CompressBlock(lz4EncodeHistory.data(), (int) start, (int) start + srcLen, lowLimit, dst,
+                                  dstCapacity, lz4Table.data());
+    if (length >= 0) {
+        lz4EncodeSize = start + srcLen;
+    }
+    return length;
+}
+
+int CompressContext::lz4Decompress(const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity) {
+    if (!streaming) {
+        return lz4DecompressBlock(src, srcLen, dst, 0, (size_t) dstCapacity);
+    }
+    lz4Compact(lz4DecodeHistory, lz4DecodeSize, (size_t) dstCapacity, nullptr);
+    size_t start = lz4DecodeSize;
+    if (lz4DecodeHistory.size() < start + dstCapacity) {
+        lz4DecodeHistory.resize(std::max(start + dstCapacity, LZ4_HISTORY_LIMIT));
+    }
+    int length = lz4DecompressBlock(src, srcLen, lz4DecodeHistory.data(), start, (size_t) dstCapacity);
+    if (length >= 0) {
+        memcpy(dst, lz4DecodeHistory.data() + start, (size_t) length);
+        lz4DecodeSize = start + length;
+    }
+    return length;
+}
+
+int CompressContext::compress(CompressCodec codec, const uint8_t *src, int srcLen, uint8_t *dst, int dstCapacity) {
+    PROFILE_ZONE("CompressContext::compress");
+    int64_t start = Profiler::nowNs();
+    int length = -1;
+    if (srcLen < 0 || (srcLen > 0 && src == nullptr) || dst == nullptr) {
+        printf("CompressContext: invalid input\n");
+    } else if (codec == Compress_None) {
+        if (srcLen <= dstCapacity) {
+            memcpy(dst, src, (size_t) srcLen);
+            length = srcLen;
+        }
+    } else if (codec == Compress_Zlib) {
+        length = deflateData(src, srcLen, dst, dstCapacity);
+    } else if (codec == Compress_Lz4) {
+        length = lz4Compress(src, srcLen, dst, dstCapacity);
+    } else {
+        printf("CompressContext: unknown codec %d\n", codec);
+    }
+    stats.compressCalls++;
+    if (length < 0) {
+        stats.errors++;
+    } else {
+        stats.inputBytes += (uint64_t) srcLen;
+        stats.outputBytes += (uint64_t) length;
+    }
+    stats.compressMs += (double) (Profiler::nowNs() - start) / 1e6;
+    return length;
+}
+
+int CompressContext::decompress(CompressCodec codec, const uint8_t *src, int srcLen, uint8_t *dst,
+                                int dstCapacity) {
+    PROFILE_ZONE("CompressContext::decompress");
+    int64_t start = Profiler::nowNs();
+    int length = -1;
+    if (srcLen < 0 || (srcLen > 0 && src == nullptr) || dst == nullptr) {
+        printf("CompressContext: invalid input\n");
+    } else if (codec == Compress_None) {
+        if (srcLen <= dstCapacity) {
+            memcpy(dst, src, (size_t) srcLen);
+            length = srcLen;
+        }
+    } else if (codec == Compress_Zlib) {
+        length = inflateData(src, srcLen, dst, dstCapacity);
+    } else if (codec == Compress_Lz4) {
+        length = lz4Decompress(src, srcLen, dst, dstCapacity);
+        if (length < 0) {
+            printf("CompressContext: corrupt lz4 data\n");
+        }
+    } else {
+        printf("CompressContext: unknown codec %d\n", codec);
+    }
+    stats.decompressCalls++;
+    if (length < 0) {
+        stats.errors++;
+    }
+    stats.decompressMs += (double) (Profiler::nowNs() - start) / 1e6;
+    return length;
+}
+
+int CompressContext::compressFrame(CompressCodec codec, const FrameBuffer &frame, uint8_t *dst, int dstCapacity) {
+    return compress(codec, frame.data, (int) frame.size, dst, dstCapacity);
+}
+
+bool CompressContext::decompressFrame(CompressCodec codec, const uint8_t *src, int srcLen, FrameBuffer &frame) {
+    int length = decompress(codec, src, srcLen, frame.data, (int) frame.size);
+    if (length != (int) frame.size) {
+        printf("CompressContext: frame %dx%d expects %zu bytes, got %d\n", frame.width, frame.height, frame.size,
+               length);
+        return false;
+    }
+    return true;
+}
+
+void CompressContext::setStreaming(bool enable) {
+    if (streaming != enable) {
+        streaming = enable;
+        resetStream();
+    }
+}
+
+bool CompressContext::isStreaming() const {
+    return streaming;
+}
+
+void CompressContext::resetStream() {
+    if (deflater != nullptr) {
+        deflateReset(deflater);
+    }
+    if (inflater != nullptr) {
+        inflateReset(inflater);
+    }
+    lz4EncodeSize = 0;
+    lz4DecodeSize = 0;
+}
+
+CompressStats CompressContext::getStats() const {
+    return stats;
+}
+
+int CompressContext::bound(CompressCodec codec, int srcLen) {
+    switch (codec) {
+        case Compress_Zlib:
+            // 流模式的 flush 多几个字节
+            return (int) compressBound((uLong) srcLen) + 16;
+        case Compress_Lz4:
+            return srcLen + srcLen / 255 + 16;
+        case Compress_None:
+        default:
+            return srcLen;
+    }
+}
+
+const char *CompressContext::getCodecName(CompressCodec codec) {
+    switch (codec) {
+        case Compress_None:
+            return "none";
+        case Compress_Zlib:
+            return "zlib";
+        case Compress_Lz4:
+            return "lz4";
+        default:
+            return "unknown";
+    }
+}
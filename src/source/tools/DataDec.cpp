@@ -3,9 +3,11 @@
 //
 
 #include "DataDec.h"
+#include "DataEnc.h"
 #include "ByteUtils.h"
 
 #include <cstring>
+#include <cstdio>
 
 DataDec::DataDec() {
 }
@@ -106,7 +108,42 @@ int DataDec::getCount() {
 }
 
 int DataDec::getLength() {
-    return getInt(8);
+    return getInt(8) & DataEnc::LENGTH_MASK;
+}
+
+CompressCodec DataDec::getCodec() {
+    return (CompressCodec) ((unsigned) getInt(8) >> DataEnc::CODEC_SHIFT);
+}
+
+bool DataDec::decompress(CompressContext &context) {
+    CompressCodec codec = getCodec();
+    if (codec == Compress_None) {
+        return true;
+    }
+    int length = getLength();
+    int rawLength = getInt(HEADER_LEN);
+    if (length < 4 || HEADER_LEN + length > m_byteLen || rawLength < 0 || rawLength > DataEnc::LENGTH_MASK) {
+        printf("DataDec: bad compressed packet %d -> %d\n", length, rawLength);
+        return false;
+    }
+    m_decoded.resize(HEADER_LEN + rawLength);
+    memcpy(m_decoded.data(), m_bytes, HEADER_LEN);
+    int decoded = context.decompress(codec, (uint8_t *) m_bytes + HEADER_LEN + 4, length - 4,
+                                     (uint8_t *) m_decoded.data() + HEADER_LEN, rawLength);
+    if (decoded != rawLength) {
+        printf("DataDec: %s packet decoded %d of %d bytes\n", CompressContext::getCodecName(codec), decoded,
+               rawLength);
+        return false;
+    }
+    ByteUtils::intToBytes(rawLength, m_decoded.data(), 8);
+    m_bytes = m_decoded.data();
+    m_byteLen = (int) m_decoded.size();
+    index = HEADER_LEN;
+    return true;
+}
+
+mbyte *DataDec::getData() {
+    return m_bytes;
 }
 
 void DataDec::skip(int off) {
@@ -6,6 +6,7 @@
 #include "ByteUtils.h"
 #include <unistd.h>
 #include <cstring>
+#include <cstdio>
 
 
 DataEnc::DataEnc() {
@@ -108,13 +109,48 @@ int DataEnc::getDataLen() {
 
 void DataEnc::reset() {
     index = HEADER_LEN;
+    m_codec = Compress_None;
 }
 
 mbyte *DataEnc::getData() {
-    setLength(index - HEADER_LEN);
+    setLength((index - HEADER_LEN) | (m_codec << CODEC_SHIFT));
     return m_bytes;
 }
 
+bool DataEnc::compress(CompressContext &context, CompressCodec codec) {
+    int length = index - HEADER_LEN;
+    if (m_codec != Compress_None) {
+        printf("DataEnc: already compressed\n");
+        return false;
+    }
+    if (codec == Compress_None || length <= 0) {
+        return true;
+    }
+    m_packed.resize(4 + CompressContext::bound(codec, length));
+    int packed = context.compress(codec, (uint8_t *) m_bytes + HEADER_LEN, length, (uint8_t *) m_packed.data() + 4,
+                                  (int) m_packed.size() - 4);
+    if (packed < 0) {
+        return false;
+    }
+    // 流模式下压缩端已经记住了这段数据，必须发送压缩后的数据，接收端才能保持同步
+    if (packed + 4 >= length && !context.isStreaming()) {
+        return true;
+    }
+    if (HEADER_LEN + packed + 4 > m_byteLen) {
+        printf("DataEnc: compressed data larger than buffer\n");
+        return false;
+    }
+    ByteUtils::intToBytes(length, m_packed.data(), 0);
+    memcpy(m_bytes + HEADER_LEN, m_packed.data(), (size_t) packed + 4);
+    index = HEADER_LEN + packed + 4;
+    m_codec = codec;
+    return true;
+}
+
+CompressCodec DataEnc::getCodec() const {
+    return m_codec;
+}
+
 DataEnc &DataEnc::putInt(int val, int i) {
     if ((i + 4) <= m_byteLen) {
         ByteUtils::intToBytes(val, m_bytes, i);
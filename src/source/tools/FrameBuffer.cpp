@@ -0,0 +1,271 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "FrameBuffer.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+
+static const size_t FRAME_BUFFER_ALIGN = 64;
+
+static size_t alignUp(size_t value, size_t align) {
+    return (value + align - 1) / align * align;
+}
+
+// 池和缓冲共享的状态，池销毁后还有引用的缓冲靠它判断直接释放
+struct FrameBufferShared {
+    std::mutex mutex;
+    std::vector<FrameBuffer *> freeBuffers;
+    std::vector<FrameBuffer *> allBuffers;
+    FrameBufferStats stats;
+    int maxFree = 0;
+    bool closed = false;
+
+    void destroy(FrameBuffer *buffer) {
+        stats.allocatedBytes -= buffer->capacity;
+        stats.freed++;
+        allBuffers.erase(std::find(allBuffers.begin(), allBuffers.end(), buffer));
+        free(buffer->data);
+        delete buffer;
+    }
+
+    /**
+     * 最后一个引用释放时调用，放回空闲列表，池已销毁或空闲缓冲已满时释放
+     */
+    void recycle(FrameBuffer *buffer) {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.releases++;
+        stats.outstanding--;
+        if (closed || (int) freeBuffers.size() >= maxFree) {
+            destroy(buffer);
+            return;
+        }
+        freeBuffers.push_back(buffer);
+    }
+};
+
+// 按格式计算各平面的行宽和偏移，平面起始按64字节对齐
+static size_t computeLayout(FrameBufferFormat format, int width, int height, int strideAlign, int strides[3],
+                            size_t offsets[3], int *planeCount) {
+    int bpp = FrameBuffer::bytesPerPixel(format);
+    strides[0] = (int) alignUp((size_t) width, (size_t) strideAlign) * bpp;
+    offsets[0] = 0;
+    size_t size = (size_t) strides[0] * height;
+    if (format != FrameBuffer_YUV420P) {
+        strides[1] = strides[2] = 0;
+        offsets[1] = offsets[2] = 0;
+        *planeCount = 1;
+        return size;
+    }
+    int chromaWidth = (width + 1) / 2, chromaHeight = (height + 1) / 2;
+    for (int i = 1; i < 3; i++) {
+        strides[i] = (int) alignUp((size_t) chromaWidth, (size_t) strideAlign);
+        offsets[i] = alignUp(size, FRAME_BUFFER_ALIGN);
+        size = offsets[i] + (size_t) strides[i] * chromaHeight;
+    }
+    *planeCount = 3;
+    return size;
+}
+
+int FrameBuffer::bytesPerPixel(FrameBufferFormat format) {
+    switch (format) {
+        case FrameBuffer_RGB24:
+        case FrameBuffer_BGR24:
+            return 3;
+        case FrameBuffer_RGBA:
+            return 4;
+        case FrameBuffer_YUV420P:
+        case FrameBuffer_GRAY8:
+        default:
+            return 1;
+    }
+}
+
+const char *FrameBuffer::getFormatName(FrameBufferFormat format) {
+    switch (format) {
+        case FrameBuffer_YUV420P:
+            return "YUV420P";
+        case FrameBuffer_RGB24:
+            return "RGB24";
+        case FrameBuffer_BGR24:
+            return "BGR24";
+        case FrameBuffer_RGBA:
+            return "RGBA";
+        case FrameBuffer_GRAY8:
+            return "GRAY8";
+        default:
+            return "unknown";
+    }
+}
+
+FrameBufferRef::FrameBufferRef(const FrameBufferRef &other) : buffer(other.buffer) {
+    if (buffer != nullptr) {
+        buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+FrameBufferRef::FrameBufferRef(FrameBufferRef &&other) noexcept: buffer(other.buffer) {
+    other.buffer = nullptr;
+}
+
+FrameBufferRef &FrameBufferRef::operator=(const FrameBufferRef &other) {
+    if (this != &other) {
+        if (other.buffer != nullptr) {
+            other.buffer->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        buffer = other.buffer;
+    }
+    return *this;
+}
+
+FrameBufferRef &FrameBufferRef::operator=(FrameBufferRef &&other) noexcept {
+    if (this != &other) {
+        reset();
+        buffer = other.buffer;
+        other.buffer = nullptr;
+    }
+    return *this;
+}
+
+FrameBufferRef::~FrameBufferRef() {
+    reset();
+}
+
+void FrameBufferRef::reset() {
+    if (buffer == nullptr) {
+        return;
+    }
+    // 最后一个引用负责回收，其他线程对像素的读写都在这之前完成
+    if (buffer->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        // 缓冲可能在 recycle 里被释放，先拿住共享状态
+        std::shared_ptr<FrameBufferShared> owner = buffer->owner;
+        owner->recycle(buffer);
+    }
+    buffer = nullptr;
+}
+
+int FrameBufferRef::useCount() const {
+    return buffer != nullptr ? buffer->refs.load(std::memory_order_relaxed) : 0;
+}
+
+FrameBuffer *FrameBufferRef::detach() {
+    FrameBuffer *detached = buffer;
+    buffer = nullptr;
+    return detached;
+}
+
+FrameBufferRef FrameBufferRef::adopt(FrameBuffer *buffer) {
+    return FrameBufferRef(buffer);
+}
+
+FrameBufferRef FrameBufferRef::retain(FrameBuffer *buffer) {
+    if (buffer != nullptr) {
+        buffer->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+    return FrameBufferRef(buffer);
+}
+
+FrameBufferPool::FrameBufferPool(int maxFree, int strideAlign) :
+        shared(std::make_shared<FrameBufferShared>()), strideAlign(strideAlign > 0 ? strideAlign : 1) {
+    shared->maxFree = maxFree > 0 ? maxFree : 0;
+}
+
+FrameBufferPool::~FrameBufferPool() {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    shared->closed = true;
+    for (FrameBuffer *buffer: shared->freeBuffers) {
+        shared->destroy(buffer);
+    }
+    shared->freeBuffers.clear();
+}
+
+FrameBufferRef FrameBufferPool::acquire(FrameBufferFormat format, int width, int height) {
+    PROFILE_ZONE("FrameBufferPool::acquire");
+    if (width <= 0 || height <= 0) {
+        return {};
+    }
+    int strides[3];
+    size_t offsets[3];
+    int planeCount;
+    size_t size = computeLayout(format, width, height, strideAlign, strides, offsets, &planeCount);
+
+    FrameBuffer *buffer = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        std::vector<FrameBuffer *> &freeBuffers = shared->freeBuffers;
+        // 同格式同尺寸优先，其次任何容量足够的
+        auto found = std::find_if(freeBuffers.begin(), freeBuffers.end(), [&](FrameBuffer *candidate) {
+            return candidate->format == format && candidate->width == width && candidate->height == height;
+        });
+        if (found == freeBuffers.end()) {
+            found = std::find_if(freeBuffers.begin(), freeBuffers.end(), [&](FrameBuffer *candidate) {
+                return candidate->capacity >= size + FRAME_BUFFER_ALIGN;
+            });
+        }
+        if (found != freeBuffers.end()) {
+            buffer = *found;
+            freeBuffers.erase(found);
+            shared->stats.reuses++;
+        } else if (!freeBuffers.empty() && (int) freeBuffers.size() >= shared->maxFree) {
+            // 空闲缓冲都太小，释放最旧的一块给新尺寸腾位置
+            shared->destroy(freeBuffers.front());
+            freeBuffers.erase(freeBuffers.begin());
+        }
+    }
+
+    if (buffer == nullptr) {
+        size_t capacity = alignUp(size + FRAME_BUFFER_ALIGN, FRAME_BUFFER_ALIGN);
+        void *data = nullptr;
+        if (posix_memalign(&data, FRAME_BUFFER_ALIGN, capacity) != 0) {
+            printf("FrameBufferPool: failed to allocate %zu bytes\n", capacity);
+            return {};
+        }
+        buffer = new FrameBuffer();
+        buffer->data = (uint8_t *) data;
+        buffer->capacity = capacity;
+        buffer->owner = shared;
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->allBuffers.push_back(buffer);
+        shared->stats.allocations++;
+        shared->stats.allocatedBytes += capacity;
+    }
+
+    buffer->format = format;
+    buffer->width = width;
+    buffer->height = height;
+    buffer->planeCount = planeCount;
+    for (int i = 0; i < 3; i++) {
+        buffer->planes[i] = i < planeCount ? buffer->data + offsets[i] : nullptr;
+        buffer->strides[i] = strides[i];
+    }
+    buffer->size = size;
+    buffer->seq = 0;
+    buffer->timestampNs = 0;
+    buffer->refs.store(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        FrameBufferStats &stats = shared->stats;
+        stats.outstanding++;
+        stats.maxOutstanding = std::max(stats.maxOutstanding, stats.outstanding);
+    }
+    return FrameBufferRef::adopt(buffer);
+}
+
+bool FrameBufferPool::owns(const FrameBuffer *buffer) const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return std::find(shared->allBuffers.begin(), shared->allBuffers.end(), buffer) != shared->allBuffers.end();
+}
+
+FrameBufferStats FrameBufferPool::getStats() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    FrameBufferStats stats = shared->stats;
+    stats.freeCount = (int) shared->freeBuffers.size();
+    return stats;
+}
+
+int FrameBufferPool::getStrideAlign() const {
+    return strideAlign;
+}
@@ -0,0 +1,123 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "FrameBufferViews.h"
+#include <cstdio>
+#include <cerrno>
+
+// av_buffer_create 的 free 回调: 接回 detach 交出的引用并释放
+static void releaseFrameBuffer(void *opaque, uint8_t *) {
+    FrameBufferRef::adopt((FrameBuffer *) opaque).reset();
+}
+
+static bool attachBuffer(FrameBufferRef buffer, AVFrame *frame) {
+    AVBufferRef *ref = av_buffer_create(buffer->data, (int) buffer->capacity, releaseFrameBuffer, buffer.get(), 0);
+    if (ref == nullptr) {
+        return false;
+    }
+    for (int i = 0; i < 3; i++) {
+        frame->data[i] = buffer->planes[i];
+        frame->linesize[i] = buffer->strides[i];
+    }
+    frame->buf[0] = ref;
+    // 引用交给 AVBufferRef，free 回调里接回
+    buffer.detach();
+    return true;
+}
+
+AVPixelFormat FrameBufferViews::toAVPixelFormat(FrameBufferFormat format) {
+    switch (format) {
+        case FrameBuffer_YUV420P:
+            return AV_PIX_FMT_YUV420P;
+        case FrameBuffer_RGB24:
+            return AV_PIX_FMT_RGB24;
+        case FrameBuffer_BGR24:
+            return AV_PIX_FMT_BGR24;
+        case FrameBuffer_RGBA:
+            return AV_PIX_FMT_RGBA;
+        case FrameBuffer_GRAY8:
+            return AV_PIX_FMT_GRAY8;
+        default:
+            return AV_PIX_FMT_NONE;
+    }
+}
+
+bool FrameBufferViews::toAVFrame(const FrameBufferRef &buffer, AVFrame *frame) {
+    if (!buffer || frame == nullptr || frame->buf[0] != nullptr) {
+        return false;
+    }
+    if (!attachBuffer(buffer, frame)) {
+        return false;
+    }
+    frame->format = toAVPixelFormat(buffer->format);
+    frame->width = buffer->width;
+    frame->height = buffer->height;
+    return true;
+}
+
+FrameBufferRef FrameBufferViews::fromAVFrame(const FrameBufferPool &pool, const AVFrame *frame) {
+    if (frame == nullptr || frame->buf[0] == nullptr) {
+        return {};
+    }
+    auto *buffer = (FrameBuffer *) av_buffer_get_opaque(frame->buf[0]);
+    // 默认分配器的 opaque 不是 FrameBuffer，先按地址确认再访问
+    if (!pool.owns(buffer)) {
+        return {};
+    }
+    return FrameBufferRef::retain(buffer);
+}
+
+cv::Mat FrameBufferViews::toMat(const FrameBufferRef &buffer, int plane) {
+    if (!buffer || plane < 0 || plane >= buffer->planeCount) {
+        return {};
+    }
+    int rows = buffer->height, cols = buffer->width, type;
+    switch (buffer->format) {
+        case FrameBuffer_RGB24:
+        case FrameBuffer_BGR24:
+            type = CV_8UC3;
+            break;
+        case FrameBuffer_RGBA:
+            type = CV_8UC4;
+            break;
+        case FrameBuffer_YUV420P:
+            if (plane > 0) {
+                rows = (rows + 1) / 2;
+                cols = (cols + 1) / 2;
+            }
+            type = CV_8UC1;
+            break;
+        case FrameBuffer_GRAY8:
+        default:
+            type = CV_8UC1;
+            break;
+    }
+    return {rows, cols, type, buffer->planes[plane], (size_t) buffer->strides[plane]};
+}
+
+int FrameBufferViews::getBuffer2(AVCodecContext *ctx, AVFrame *frame, int flags) {
+    auto *pool = (FrameBufferPool *) ctx->opaque;
+    if (pool == nullptr || !(ctx->codec->capabilities & AV_CODEC_CAP_DR1) ||
+        (frame->format != AV_PIX_FMT_YUV420P && frame->format != AV_PIX_FMT_YUVJ420P)) {
+        return avcodec_default_get_buffer2(ctx, frame, flags);
+    }
+    // 解码器按对齐后的宽高写入(宏块边缘)，行宽对齐要求不能超过池的对齐
+    int width = frame->width, height = frame->height;
+    int linesizeAlign[AV_NUM_DATA_POINTERS];
+    avcodec_align_dimensions2(ctx, &width, &height, linesizeAlign);
+    for (int i = 0; i < 3; i++) {
+        if (pool->getStrideAlign() % linesizeAlign[i] != 0) {
+            return avcodec_default_get_buffer2(ctx, frame, flags);
+        }
+    }
+    FrameBufferRef buffer = pool->acquire(FrameBuffer_YUV420P, width, height);
+    if (!buffer || !attachBuffer(buffer, frame)) {
+        printf("FrameBufferViews: failed to allocate %dx%d decode buffer\n", width, height);
+        return AVERROR(ENOMEM);
+    }
+    // 平面按对齐后的大小分配，宽高记录有效画面
+    buffer->width = frame->width;
+    buffer->height = frame->height;
+    return 0;
+}
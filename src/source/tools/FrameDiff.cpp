@@ -0,0 +1,347 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "FrameDiff.h"
+#include "Profiler.h"
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define FRAME_DIFF_NEON
+#include <arm_neon.h>
+#elif defined(__SSE2__)
+#define FRAME_DIFF_SSE2
+#include <emmintrin.h>
+#endif
+
+bool FrameDiffResult::intersects(int x, int y, int w, int h) const {
+    if (dirtyTiles == 0 || w <= 0 || h <= 0 || tileSize <= 0) {
+        return false;
+    }
+    int col0 = std::max(0, x / tileSize), row0 = std::max(0, y / tileSize);
+    int col1 = std::min(tileCols - 1, (x + w - 1) / tileSize);
+    int row1 = std::min(tileRows - 1, (y + h - 1) / tileSize);
+    for (int row = row0; row <= row1; row++) {
+        for (int col = col0; col <= col1; col++) {
+            if (isDirty(col, row)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+uint32_t FrameDiff::sadScalar(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak) {
+    uint32_t sum = 0;
+    int maxDiff = *peak;
+    for (int i = 0; i < n; i++) {
+        int diff = a[i] > b[i] ? a[i] - b[i] : b[i] - a[i];
+        sum += (uint32_t) diff;
+        maxDiff = std::max(maxDiff, diff);
+    }
+    *peak = (uint8_t) maxDiff;
+    return sum;
+}
+
+#if defined(FRAME_DIFF_NEON)
+
+uint32_t FrameDiff::sad(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak) {
+    uint32x4_t total = vdupq_n_u32(0);
+    uint8x16_t maxDiff = vdupq_n_u8(0);
+    int i = 0;
+    while (i + 16 <= n) {
+        // 16位累加每次每个通道最多加 2*255，64次以内不会溢出
+        uint16x8_t acc = vdupq_n_u16(0);
+        int end = std::min(n, i + 64 * 16);
+        for (; i + 16 <= end; i += 16) {
+            uint8x16_t diff = vabdq_u8(vld1q_u8(a + i), vld1q_u8(b + i));
+            acc = vpadalq_u8(acc, diff);
+            maxDiff = vmaxq_u8(maxDiff, diff);
+        }
+        total = vpadalq_u16(total, acc);
+    }
+    uint32_t lanes[4];
+    uint8_t peaks[16];
+    vst1q_u32(lanes, total);
+    vst1q_u8(peaks, maxDiff);
+    uint8_t maxValue = *peak;
+    for (uint8_t value: peaks) {
+        maxValue = std::max(maxValue, value);
+    }
+    *peak = maxValue;
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] + sadScalar(a + i, b + i, n - i, peak);
+}
+
+#elif defined(FRAME_DIFF_SSE2)
+
+uint32_t FrameDiff::sad(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak) {
+    __m128i total = _mm_setzero_si128();
+    __m128i maxDiff = _mm_setzero_si128();
+    int i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m128i va = _mm_loadu_si128((const __m128i *) (a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *) (b + i));
+        // psadbw 得到两个64位的和，饱和减法的或就是每个字节的绝对差
+        total = _mm_add_epi64(total, _mm_sad_epu8(va, vb));
+        maxDiff = _mm_max_epu8(maxDiff, _mm_or_si128(_mm_subs_epu8(va, vb), _mm_subs_epu8(vb, va)));
+    }
+    uint8_t peaks[16];
+    _mm_storeu_si128((__m128i *) peaks, maxDiff);
+    uint8_t maxValue = *peak;
+    for (uint8_t value: peaks) {
+        maxValue = std::max(maxValue, value);
+    }
+    *peak = maxValue;
+    uint32_t sum = (uint32_t) _mm_cvtsi128_si32(total) + (uint32_t) _mm_cvtsi128_si32(_mm_srli_si128(total, 8));
+    return sum + sadScalar(a + i, b + i, n - i, peak);
+}
+
+#else
+
+uint32_t FrameDiff::sad(const uint8_t *a, const uint8_t *b, int n, uint8_t *peak) {
+    return sadScalar(a, b, n, peak);
+}
+
+#endif
+
+const char *FrameDiff::simdName() {
+#if defined(FRAME_DIFF_NEON)
+    return "neon";
+#elif defined(FRAME_DIFF_SSE2)
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+FrameDiff::FrameDiff(const FrameDiffOptions &options) : options(options) {
+    this->options.tileSize = std::max(4, options.tileSize);
+    this->options.rowStep = std::max(1, std::min(options.rowStep, this->options.tileSize));
+}
+
+void FrameDiff::resize(int width, int height, int bytesPerPixel) {
+    this->bytesPerPixel = bytesPerPixel;
+    referenceStride = width * bytesPerPixel;
+    reference.assign((size_t) referenceStride * height, 0);
+    result.width = width;
+    result.height = height;
+    result.tileSize = options.tileSize;
+    result.tileCols = (width + options.tileSize - 1) / options.tileSize;
+    result.tileRows = (height + options.tileSize - 1) / options.tileSize;
+    result.dirty.assign((size_t) result.tileCols * result.tileRows, 0);
+    phase = 0;
+}
+
+void FrameDiff::reset() {
+    reference.clear();
+    result = FrameDiffResult();
+    bytesPerPixel = 0;
+    phase = 0;
+}
+
+const FrameDiffResult &FrameDiff::update(const uint8_t *data, int stride, int width, int height, int bytesPerPixel) {
+    PROFILE_ZONE("FrameDiff::update");
+    int64_t start = Profiler::nowNs();
+    if (data == nullptr || width <= 0 || height <= 0 || bytesPerPixel <= 0 || stride < width * bytesPerPixel) {
+        printf("FrameDiff: invalid frame %dx%d stride %d\n", width, height, stride);
+        result.changed = false;
+        result.dirtyTiles = 0;
+        return result;
+    }
+    int tileSize = options.tileSize;
+    size_t rowBytes = (size_t) width * bytesPerPixel;
+    bool first = reference.empty() || width != result.width || height != result.height ||
+                 bytesPerPixel != this->bytesPerPixel;
+    if (first) {
+        resize(width, height, bytesPerPixel);
+        for (int y = 0; y < height; y++) {
+            memcpy(&reference[(size_t) y * referenceStride], data + (size_t) y * stride, rowBytes);
+        }
+        std::fill(result.dirty.begin(), result.dirty.end(), 1);
+        result.dirtyTiles = (int) result.dirty.size();
+    } else {
+        int cols = result.tileCols;
+        std::vector<uint32_t> sums(cols);
+        std::vector<uint8_t> peaks(cols);
+        result.dirtyTiles = 0;
+        for (int row = 0; row < result.tileRows; row++) {
+            int y0 = row * tileSize, y1 = std::min(height, y0 + tileSize);
+            std::fill(sums.begin(), sums.end(), 0);
+            std::fill(peaks.begin(), peaks.end(), 0);
+            // 整行顺序读，每行按块累加，块内的采样行数相同
+            int sampledRows = 0;
+            int firstRow = y0 + std::min(phase, y1 - y0 - 1);
+            for (int y = firstRow; y < y1; y += options.rowStep) {
+                const uint8_t *current = data + (size_t) y * stride;
+                const uint8_t *previous = &reference[(size_t) y * referenceStride];
+                for (int col = 0; col < cols; col++) {
+                    int x0 = col * tileSize * bytesPerPixel;
+                    int bytes = std::min(tileSize, width - col * tileSize) * bytesPerPixel;
+                    sums[col] += sad(current + x0, previous + x0, bytes, &peaks[col]);
+                }
+                sampledRows++;
+            }
+            stats.comparedBytes += (uint64_t) sampledRows * rowBytes;
+            for (int col = 0; col < cols; col++) {
+                int tileWidth = std::min(tileSize, width - col * tileSize);
+                float samples = (float) (sampledRows * tileWidth * bytesPerPixel);
+                bool dirty = (float) sums[col] >= options.meanThreshold * samples ||
+                             peaks[col] >= options.peakThreshold;
+                result.dirty[row * cols + col] = dirty ? 1 : 0;
+                if (!dirty) {
+                    continue;
+                }
+                result.dirtyTiles++;
+                // 参考帧只在脏块处跟上当前帧
+                size_t x0 = (size_t) col * tileSize * bytesPerPixel;
+                for (int y = y0; y < y1; y++) {
+                    memcpy(&reference[(size_t) y * referenceStride + x0], data + (size_t) y * stride + x0,
+                           (size_t) tileWidth * bytesPerPixel);
+                }
+            }
+        }
+        phase = (phase + 1) % options.rowStep;
+    }
+    result.reset = first;
+    result.changed = result.dirtyTiles > 0;
+
+    // 脏块外接矩形
+    int minCol = result.tileCols, minRow = result.tileRows, maxCol = -1, maxRow = -1;
+    if (result.changed) {
+        for (int row = 0; row < result.tileRows; row++) {
+            for (int col = 0; col < result.tileCols; col++) {
+                if (result.isDirty(col, row)) {
+                    minCol = std::min(minCol, col);
+                    maxCol = std::max(maxCol, col);
+                    minRow = std::min(minRow, row);
+                    maxRow = std::max(maxRow, row);
+                }
+            }
+        }
+        result.dirtyX = minCol * tileSize;
+        result.dirtyY = minRow * tileSize;
+        result.dirtyWidth = std::min(width, (maxCol + 1) * tileSize) - result.dirtyX;
+        result.dirtyHeight = std::min(height, (maxRow + 1) * tileSize) - result.dirtyY;
+    } else {
+        result.dirtyX = result.dirtyY = result.dirtyWidth = result.dirtyHeight = 0;
+    }
+
+    stats.frames++;
+    if (result.changed) {
+        stats.changedFrames++;
+    } else {
+        stats.unchangedFrames++;
+    }
+    stats.dirtyTiles += (uint64_t) result.dirtyTiles;
+    stats.lastMs = (double) (Profiler::nowNs() - start) / 1e6;
+    stats.totalMs += stats.lastMs;
+    return result;
+}
+
+const FrameDiffResult &FrameDiff::update(const FrameBuffer &buffer) {
+    return update(buffer.planes[0], buffer.strides[0], buffer.width, buffer.height,
+                  FrameBuffer::bytesPerPixel(buffer.format));
+}
+
+const FrameDiffResult &FrameDiff::update(const RawFrame &frame) {
+    // YUV_420_888 的Y平面 pixelStride 总是1
+    int pixelBytes = frame.format == RawFrame_RGBA_8888 ? 4 : 1;
+    return update(frame.planes[0], frame.rowStride[0], (int) frame.width, (int) frame.height, pixelBytes);
+}
+
+const FrameDiffResult &FrameDiff::getResult() const {
+    return result;
+}
+
+FrameDiffStats FrameDiff::getStats() const {
+    return stats;
+}
+
+const FrameDiffOptions &FrameDiff::getOptions() const {
+    return options;
+}
+
+int FrameDiff::packDirtyMap(const FrameDiffResult &result, uint8_t *out, int capacity) {
+    int count = (int) result.dirty.size();
+    int bytes = (count + 7) / 8;
+    if (bytes > capacity) {
+        return -1;
+    }
+    memset(out, 0, (size_t) bytes);
+    for (int i = 0; i < count; i++) {
+        if (result.dirty[i]) {
+            out[i >> 3] |= (uint8_t) (1 << (i & 7));
+        }
+    }
+    return bytes;
+}
+
+int FrameDiff::unpackDirtyMap(const uint8_t *in, int length, int tileCols, int tileRows,
+                              std::vector<uint8_t> &dirty) {
+    int count = tileCols * tileRows;
+    if (count <= 0 || length < (count + 7) / 8) {
+        return -1;
+    }
+    dirty.resize((size_t) count);
+    int dirtyTiles = 0;
+    for (int i = 0; i < count; i++) {
+        dirty[i] = (uint8_t) ((in[i >> 3] >> (i & 7)) & 1);
+        dirtyTiles += dirty[i];
+    }
+    return dirtyTiles;
+}
+
+size_t FrameDiff::gatherTiles(const std::vector<uint8_t> &dirty, int tileSize, const uint8_t *data, int stride,
+                              int width, int height, int bytesPerPixel, uint8_t *out) {
+    int cols = (width + tileSize - 1) / tileSize;
+    int rows = (height + tileSize - 1) / tileSize;
+    if ((int) dirty.size() < cols * rows) {
+        return 0;
+    }
+    size_t offset = 0;
+    for (int row = 0; row < rows; row++) {
+        int y0 = row * tileSize, y1 = std::min(height, y0 + tileSize);
+        for (int col = 0; col < cols; col++) {
+            if (!dirty[row * cols + col]) {
+                continue;
+            }
+            size_t x0 = (size_t) col * tileSize * bytesPerPixel;
+            size_t bytes = (size_t) std::min(tileSize, width - col * tileSize) * bytesPerPixel;
+            for (int y = y0; y < y1; y++) {
+                if (out != nullptr) {
+                    memcpy(out + offset, data + (size_t) y * stride + x0, bytes);
+                }
+                offset += bytes;
+            }
+        }
+    }
+    return offset;
+}
+
+size_t FrameDiff::scatterTiles(const std::vector<uint8_t> &dirty, int tileSize, const uint8_t *in, size_t length,
+                               uint8_t *data, int stride, int width, int height, int bytesPerPixel) {
+    size_t needed = gatherTiles(dirty, tileSize, nullptr, stride, width, height, bytesPerPixel, nullptr);
+    if (needed == 0 || needed > length) {
+        return 0;
+    }
+    int cols = (width + tileSize - 1) / tileSize;
+    int rows = (height + tileSize - 1) / tileSize;
+    size_t offset = 0;
+    for (int row = 0; row < rows; row++) {
+        int y0 = row * tileSize, y1 = std::min(height, y0 + tileSize);
+        for (int col = 0; col < cols; col++) {
+            if (!dirty[row * cols + col]) {
+                continue;
+            }
+            size_t x0 = (size_t) col * tileSize * bytesPerPixel;
+            size_t bytes = (size_t) std::min(tileSize, width - col * tileSize) * bytesPerPixel;
+            for (int y = y0; y < y1; y++) {
+                memcpy(data + (size_t) y * stride + x0, in + offset, bytes);
+                offset += bytes;
+            }
+        }
+    }
+    return offset;
+}
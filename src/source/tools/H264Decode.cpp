@@ -3,6 +3,9 @@
 //
 
 #include "H264Decoder.h"
+#include "FrameBufferViews.h"
+#include "ColorConvert.h"
+#include "Profiler.h"
 
 
 void H264Decoder::init() {
@@ -19,6 +22,9 @@ void H264Decoder::init() {
         fprintf(stderr, "Could not allocate video codec context\n");
         exit(1);
     }
+    // 解码输出直接分配在 yuvPool 里
+    c->opaque = &yuvPool;
+    c->get_buffer2 = FrameBufferViews::getBuffer2;
     if (avcodec_open2(c, codec, NULL) < 0) {
         fprintf(stderr, "Could not open codec\n");
         exit(1);
@@ -29,8 +35,6 @@ void H264Decoder::init() {
         exit(1);
     }
     frame_count = 0;
-    //存储解码后转换的RGB数据
-    pFrameRGB = av_frame_alloc();
 }
 
 int ScaleYUVImgToRGB(int nSrcW, int nSrcH, uint8_t *src_data, int *linesize, int nDstW, int nDstH) {
@@ -74,13 +78,17 @@ int ScaleYUVImgToRGB(int nSrcW, int nSrcH, uint8_t *src_data, int *linesize, int
 }
 
 void H264Decoder::decode(unsigned char *inputbuf, size_t size) {
+    PROFILE_ZONE("H264Decoder::decode");
 
     avpkt.size = size;
     if (avpkt.size == 0)
         return;
     avpkt.data = inputbuf;
     int len, got_frame;
-    len = avcodec_decode_video2(c, frame, &got_frame, &avpkt);
+    {
+        PROFILE_ZONE("avcodec_decode_video2");
+        len = avcodec_decode_video2(c, frame, &got_frame, &avpkt);
+    }
 
     if (len < 0) {
         ready = false;
@@ -88,30 +96,9 @@ void H264Decoder::decode(unsigned char *inputbuf, size_t size) {
         frame_count++;
         return;
     }
-    if (out_buffer == nullptr) {
-        RGBsize = avpicture_get_size(AV_PIX_FMT_RGB24, c->width,
-                                     c->height);
-        out_buffer = (uint8_t *) av_malloc(RGBsize);
-        avpicture_fill((AVPicture *) pFrameRGB, out_buffer, AV_PIX_FMT_RGB24,
-                       c->width, c->height);
-        img_convert_ctx =
-                sws_getContext(c->width, c->height, c->pix_fmt,
-                               c->width, c->height,
-                               AV_PIX_FMT_RGB24,
-                               SWS_BICUBIC,
-                               NULL, NULL, NULL);
-        width = c->width;
-        height = c->height;
-        printf("decode width: %d height: %d\n", width, height);
-    }
-
-    if (got_frame) {
-        ready = true;
-        sws_scale(img_convert_ctx, (const uint8_t *const *) frame->data,
-                  frame->linesize, 0, c->height, pFrameRGB->data, pFrameRGB->linesize);
+    ready = got_frame && convertFrame();
+    if (ready) {
         frame_count++;
-    } else {
-        ready = false;
     }
     if (avpkt.data) {
         avpkt.size -= len;
@@ -124,14 +111,66 @@ H264Decoder::H264Decoder() {
     init();
 }
 
+bool H264Decoder::convertFrame() {
+    if (width != frame->width || height != frame->height) {
+        width = frame->width;
+        height = frame->height;
+        printf("decode width: %d height: %d\n", width, height);
+    }
+    // 上一帧的引用还在其他线程时不会被覆盖，池里取一块新的
+    FrameBufferRef rgb = rgbPool.acquire(FrameBuffer_RGB24, width, height);
+    if (!rgb) {
+        return false;
+    }
+    if (frame->format == AV_PIX_FMT_YUV420P || frame->format == AV_PIX_FMT_YUVJ420P) {
+        ColorConvert::yuv420pToRgb(frame->data[0], frame->linesize[0], frame->data[1], frame->linesize[1],
+                                   frame->data[2], frame->linesize[2], rgb->planes[0], rgb->strides[0],
+                                   width, height, ColorConvert_RGB);
+    } else {
+        PROFILE_ZONE("sws_scale");
+        img_convert_ctx = sws_getCachedContext(img_convert_ctx, width, height, (AVPixelFormat) frame->format,
+                                               width, height, AV_PIX_FMT_RGB24, SWS_BICUBIC,
+                                               NULL, NULL, NULL);
+        if (img_convert_ctx == nullptr) {
+            return false;
+        }
+        sws_scale(img_convert_ctx, (const uint8_t *const *) frame->data, frame->linesize, 0, height,
+                  rgb->planes, rgb->strides);
+    }
+    rgb->seq = (uint64_t) frame_count;
+    rgbFrame = std::move(rgb);
+    // 解码器还会把这一帧当参考帧，只读持有
+    yuvFrame = FrameBufferViews::fromAVFrame(yuvPool, frame);
+    if (yuvFrame) {
+        yuvFrame->seq = (uint64_t) frame_count;
+    }
+    return true;
+}
+
 uint8_t *H264Decoder::getDecBuffer() {
-    if (ready) {
-        return out_buffer;
+    if (ready && rgbFrame) {
+        return rgbFrame->planes[0];
     } else {
         return nullptr;
     }
 }
 
+FrameBufferRef H264Decoder::getFrame() const {
+    return rgbFrame;
+}
+
+FrameBufferRef H264Decoder::getYuvFrame() const {
+    return yuvFrame;
+}
+
+FrameBufferStats H264Decoder::getRgbStats() const {
+    return rgbPool.getStats();
+}
+
+FrameBufferStats H264Decoder::getYuvStats() const {
+    return yuvPool.getStats();
+}
+
 int H264Decoder::getWidth() const {
     return width;
 }
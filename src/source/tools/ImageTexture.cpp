@@ -3,27 +3,367 @@
 //
 
 #include "ImageTexture.h"
+#include <cstdio>
+#include <cstring>
+#include <vector>
 
+std::atomic<size_t> ImageTexture::totalMemoryBytes{0};
+
+struct ImageTextureFormatInfo {
+    const char *name;
+    GLenum internalFormat;
+    int blockWidth;
+    int blockHeight;
+    int blockBytes;     // 压缩格式每块字节数，未压缩格式每像素字节数
+};
+
+static const ImageTextureFormatInfo g_FormatInfos[ImageTexture_FormatCount] = {
+        {"RGB",       GL_RGB8,                          1, 1, 3},
+        {"RGBA",      GL_RGBA8,                         1, 1, 4},
+        {"BGR",       GL_RGB8,                          1, 1, 3},
+        {"BGRA",      GL_RGBA8,                         1, 1, 4},
+        {"GRAY",      GL_R8,                            1, 1, 1},
+        {"ETC2 RGB",  GL_COMPRESSED_RGB8_ETC2,          4, 4, 8},
+        {"ETC2 RGBA", GL_COMPRESSED_RGBA8_ETC2_EAC,     4, 4, 16},
+        {"ASTC 4x4",  GL_COMPRESSED_RGBA_ASTC_4x4,      4, 4, 16},
+        {"ASTC 6x6",  GL_COMPRESSED_RGBA_ASTC_6x6,      6, 6, 16},
+        {"ASTC 8x8",  GL_COMPRESSED_RGBA_ASTC_8x8,      8, 8, 16},
+};
+
+static bool isCompressed(ImageTextureFormat format) {
+    return format >= ImageTexture_ETC2_RGB && format < ImageTexture_FormatCount;
+}
 
 ImageTexture::~ImageTexture() {
     glBindTexture(GL_TEXTURE_2D, 0);  // unbind texture
     glDeleteTextures(1, &my_opengl_texture);
+    setMemoryBytes(0);
 }
+
+ImageTexture::ImageTexture() = default;
+
 ImageTexture::ImageTexture(uint8_t *buffer, int width, int height) {
     setBuffer(buffer, width, height);
 };
 
-void ImageTexture::setBuffer(uint8_t *buffer, int width, int height) {
-    glGenTextures(1, &my_opengl_texture);
+bool ImageTexture::prepareTexture() {
+    if (my_opengl_texture == 0) {
+        glGenTextures(1, &my_opengl_texture);
+    }
     glBindTexture(GL_TEXTURE_2D, my_opengl_texture);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, width, height, 0, GL_RGB,
-                 GL_UNSIGNED_BYTE, buffer);
+    return my_opengl_texture != 0;
+}
+
+static const GLint g_IdentitySwizzle[4] = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+
+void ImageTexture::setSwizzle(const GLint swizzle[4]) {
+    static const GLenum names[4] = {GL_TEXTURE_SWIZZLE_R, GL_TEXTURE_SWIZZLE_G, GL_TEXTURE_SWIZZLE_B,
+                                    GL_TEXTURE_SWIZZLE_A};
+    for (int i = 0; i < 4; i++) {
+        if (swizzle[i] != swizzleState[i]) {
+            glTexParameteri(GL_TEXTURE_2D, names[i], swizzle[i]);
+            swizzleState[i] = swizzle[i];
+        }
+    }
+}
+
+// 未压缩格式的上传格式和通道映射(BGR 按RGB上传后交换R/B)
+static void uploadFormat(ImageTextureFormat format, GLenum *glFormat, GLint swizzle[4]) {
+    GLint identity[4] = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+    memcpy(swizzle, identity, sizeof(identity));
+    switch (format) {
+        case ImageTexture_RGBA:
+            *glFormat = GL_RGBA;
+            break;
+        case ImageTexture_BGR:
+            *glFormat = GL_RGB;
+            swizzle[0] = GL_BLUE;
+            swizzle[2] = GL_RED;
+            break;
+        case ImageTexture_BGRA:
+            *glFormat = GL_RGBA;
+            swizzle[0] = GL_BLUE;
+            swizzle[2] = GL_RED;
+            break;
+        case ImageTexture_GRAY:
+            *glFormat = GL_RED;
+            swizzle[1] = swizzle[2] = GL_RED;
+            swizzle[3] = GL_ONE;
+            break;
+        case ImageTexture_RGB:
+        default:
+            *glFormat = GL_RGB;
+            break;
+    }
+}
+
+void ImageTexture::setMemoryBytes(size_t bytes) {
+    totalMemoryBytes += bytes;
+    totalMemoryBytes -= memoryBytes;
+    memoryBytes = bytes;
+}
+
+void ImageTexture::setBuffer(uint8_t *buffer, int width, int height) {
+    setPixels(ImageTexture_RGB, buffer, width, height);
+}
+
+bool ImageTexture::setPixels(ImageTextureFormat format, const uint8_t *pixels, int width, int height) {
+    if (format < 0 || format >= ImageTexture_FormatCount) {
+        return false;
+    }
+    return setPixels(format, pixels, width, height, width * g_FormatInfos[format].blockBytes);
+}
+
+bool ImageTexture::setPixels(ImageTextureFormat format, const uint8_t *pixels, int width, int height,
+                             int rowStride) {
+    if (format < 0 || isCompressed(format) || rowStride % g_FormatInfos[format].blockBytes != 0) {
+        return false;
+    }
+    // 同尺寸同格式只更新内容，纹理存储不变
+    bool update = my_opengl_texture != 0 && width == this->width && height == this->height &&
+                  format == this->format;
+    if (!prepareTexture()) {
+        return false;
+    }
+    GLenum glFormat;
+    GLint swizzle[4];
+    uploadFormat(format, &glFormat, swizzle);
+    int rowLength = rowStride / g_FormatInfos[format].blockBytes;
+    // RGB 行宽不一定是4的倍数
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowLength == width ? 0 : rowLength);
+    if (update) {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, glFormat, GL_UNSIGNED_BYTE, pixels);
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, (GLint) g_FormatInfos[format].internalFormat, width, height, 0, glFormat,
+                     GL_UNSIGNED_BYTE, pixels);
+    }
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    setSwizzle(swizzle);
+    this->width = width;
+    this->height = height;
+    this->format = format;
+    setMemoryBytes(compressedSize(format, width, height));
+    return true;
+}
+
+bool ImageTexture::updateRegion(ImageTextureFormat format, const uint8_t *pixels, int rowStride, int x, int y,
+                                int width, int height) {
+    if (my_opengl_texture == 0 || format != this->format || isCompressed(format) ||
+        rowStride % g_FormatInfos[format].blockBytes != 0 || x < 0 || y < 0 || width <= 0 || height <= 0 ||
+        x + width > this->width || y + height > this->height) {
+        return false;
+    }
+    GLenum glFormat;
+    GLint swizzle[4];
+    uploadFormat(format, &glFormat, swizzle);
+    glBindTexture(GL_TEXTURE_2D, my_opengl_texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, rowStride / g_FormatInfos[format].blockBytes);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, glFormat, GL_UNSIGNED_BYTE,
+                    pixels + (size_t) y * rowStride + (size_t) x * g_FormatInfos[format].blockBytes);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    return true;
+}
+
+bool ImageTexture::setFrame(const FrameBufferRef &frame) {
+    if (!frame) {
+        return false;
+    }
+    ImageTextureFormat textureFormat;
+    switch (frame->format) {
+        case FrameBuffer_RGB24:
+            textureFormat = ImageTexture_RGB;
+            break;
+        case FrameBuffer_BGR24:
+            textureFormat = ImageTexture_BGR;
+            break;
+        case FrameBuffer_RGBA:
+            textureFormat = ImageTexture_RGBA;
+            break;
+        case FrameBuffer_GRAY8:
+        case FrameBuffer_YUV420P:
+            textureFormat = ImageTexture_GRAY;
+            break;
+        default:
+            printf("ImageTexture: frame format %s not supported\n", FrameBuffer::getFormatName(frame->format));
+            return false;
+    }
+    return setPixels(textureFormat, frame->planes[0], frame->width, frame->height, frame->strides[0]);
+}
+
+bool ImageTexture::setCompressed(ImageTextureFormat format, const uint8_t *data, size_t size, int width, int height) {
+    if (!isCompressed(format) || size != compressedSize(format, width, height)) {
+        printf("ImageTexture: %s %dx%d expects %zu bytes, got %zu\n", getFormatName(format), width, height,
+               compressedSize(format, width, height), size);
+        return false;
+    }
+    if (!isFormatSupported(format) || !prepareTexture()) {
+        printf("ImageTexture: %s not supported\n", getFormatName(format));
+        return false;
+    }
+    setSwizzle(g_IdentitySwizzle);
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, g_FormatInfos[format].internalFormat, width, height, 0, (GLsizei) size,
+                           data);
+    if (glGetError() != GL_NO_ERROR) {
+        return false;
+    }
+    this->width = width;
+    this->height = height;
+    this->format = format;
+    setMemoryBytes(size);
+    return true;
+}
+
+static ImageTextureFormat findFormat(GLenum internalFormat) {
+    for (int i = ImageTexture_ETC2_RGB; i < ImageTexture_FormatCount; i++) {
+        if (g_FormatInfos[i].internalFormat == internalFormat) {
+            return (ImageTextureFormat) i;
+        }
+    }
+    return ImageTexture_FormatCount;
+}
+
+bool ImageTexture::loadCompressed(const uint8_t *data, size_t size) {
+    static const uint8_t ktxIdentifier[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+    static const uint32_t astcMagic = 0x5CA1AB13;
+    if (size >= 16 && memcmp(data, &astcMagic, 4) == 0) {
+        // .astc: magic, 块宽高深各1字节, 宽高深各3字节(小端)，之后是块数据
+        int blockWidth = data[4], blockHeight = data[5];
+        int w = data[7] | data[8] << 8 | data[9] << 16;
+        int h = data[10] | data[11] << 8 | data[12] << 16;
+        for (int i = ImageTexture_ASTC_4x4; i < ImageTexture_FormatCount; i++) {
+            if (g_FormatInfos[i].blockWidth == blockWidth && g_FormatInfos[i].blockHeight == blockHeight) {
+                return setCompressed((ImageTextureFormat) i, data + 16, size - 16, w, h);
+            }
+        }
+        printf("ImageTexture: unsupported astc block %dx%d\n", blockWidth, blockHeight);
+        return false;
+    }
+    if (size < 64 || memcmp(data, ktxIdentifier, sizeof(ktxIdentifier)) != 0) {
+        printf("ImageTexture: not a ktx/astc file\n");
+        return false;
+    }
+    // KTX 1.1 头: 13个uint32，只支持小端、2D、单层
+    uint32_t header[13];
+    memcpy(header, data + 12, sizeof(header));
+    uint32_t internalFormat = header[4], w = header[6], h = header[7];
+    uint32_t levels = header[11] == 0 ? 1 : header[11], keyValueBytes = header[12];
+    ImageTextureFormat textureFormat = findFormat(internalFormat);
+    if (header[0] != 0x04030201 || header[1] != 0 || textureFormat == ImageTexture_FormatCount || header[8] > 1 ||
+        header[9] > 1 || header[10] != 1) {
+        printf("ImageTexture: unsupported ktx (format 0x%X)\n", internalFormat);
+        return false;
+    }
+    size_t offset = 64 + keyValueBytes;
+    size_t total = 0;
+    for (uint32_t level = 0; level < levels; level++) {
+        int levelWidth = (int) (w >> level) > 0 ? (int) (w >> level) : 1;
+        int levelHeight = (int) (h >> level) > 0 ? (int) (h >> level) : 1;
+        uint32_t imageSize;
+        if (offset + 4 > size) {
+            return false;
+        }
+        memcpy(&imageSize, data + offset, 4);
+        offset += 4;
+        if (offset + imageSize > size) {
+            return false;
+        }
+        if (level == 0) {
+            if (!setCompressed(textureFormat, data + offset, imageSize, levelWidth, levelHeight)) {
+                return false;
+            }
+        } else {
+            glCompressedTexImage2D(GL_TEXTURE_2D, (GLint) level, internalFormat, levelWidth, levelHeight, 0,
+                                   (GLsizei) imageSize, data + offset);
+        }
+        total += imageSize;
+        offset += (imageSize + 3) & ~3u;
+    }
+    if (levels > 1) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint) levels - 1);
+    }
+    setMemoryBytes(total);
+    return true;
+}
+
+bool ImageTexture::loadCompressedFile(const char *path) {
+    FILE *file = fopen(path, "rb");
+    if (file == nullptr) {
+        printf("ImageTexture: open %s failed\n", path);
+        return false;
+    }
+    std::vector<uint8_t> data;
+    uint8_t buffer[16384];
+    size_t count;
+    while ((count = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + count);
+    }
+    fclose(file);
+    return loadCompressed(data.data(), data.size());
 }
 
 void *ImageTexture::getOpenglTexture() const {
     return (void *) (intptr_t) my_opengl_texture;
 }
 
+int ImageTexture::getWidth() const {
+    return width;
+}
+
+int ImageTexture::getHeight() const {
+    return height;
+}
+
+ImageTextureFormat ImageTexture::getFormat() const {
+    return format;
+}
+
+size_t ImageTexture::getMemoryBytes() const {
+    return memoryBytes;
+}
+
+size_t ImageTexture::getTotalMemoryBytes() {
+    return totalMemoryBytes;
+}
+
+bool ImageTexture::isFormatSupported(ImageTextureFormat format) {
+    if (format < 0 || format >= ImageTexture_FormatCount) {
+        return false;
+    }
+    if (!isCompressed(format)) {
+        return true;
+    }
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+    std::vector<GLint> formats((size_t) count);
+    if (count > 0) {
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    }
+    for (GLint supported: formats) {
+        if ((GLenum) supported == g_FormatInfos[format].internalFormat) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ImageTexture::compressedSize(ImageTextureFormat format, int width, int height) {
+    if (format < 0 || format >= ImageTexture_FormatCount || width <= 0 || height <= 0) {
+        return 0;
+    }
+    const ImageTextureFormatInfo &info = g_FormatInfos[format];
+    size_t blocksX = (size_t) (width + info.blockWidth - 1) / info.blockWidth;
+    size_t blocksY = (size_t) (height + info.blockHeight - 1) / info.blockHeight;
+    return blocksX * blocksY * info.blockBytes;
+}
+
+const char *ImageTexture::getFormatName(ImageTextureFormat format) {
+    return format >= 0 && format < ImageTexture_FormatCount ? g_FormatInfos[format].name : "unknown";
+}
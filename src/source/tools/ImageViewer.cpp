@@ -8,74 +8,119 @@
 #include <touch.h>
 #include <draw.h>
 
-ImageViewer::ImageViewer() {
+ImageViewer::ImageViewer() : gain(1.0f) {
     if (!initDraw(false)) {
         return;
     }
     Init_touch_config();
-    gain = 1.0f;
+    layer = getMainLayer();
+    // 渲染线程只在有新帧或触摸时重绘，纹理在这个线程的GL上下文里创建和上传
+    layer->setMode(LayerRender_OnChange);
+    layer->start([this](OverlayLayer &) {
+        showMainContents();
+        textures.upload();
+        textures.draw();
+    });
 }
 
 float ImageViewer::getGain() {
     return gain;
 }
 
+// Mat 的类型对应的纹理格式和存放拷贝的缓冲格式(BGRA 放在同样4字节的 RGBA 缓冲里)，不支持的类型返回false
+static bool matFormat(const cv::Mat &frame, ImageTextureFormat *format, FrameBufferFormat *bufferFormat) {
+    switch (frame.type()) {
+        case CV_8UC3:
+            *format = ImageTexture_BGR;
+            *bufferFormat = FrameBuffer_BGR24;
+            return true;
+        case CV_8UC4:
+            *format = ImageTexture_BGRA;
+            *bufferFormat = FrameBuffer_RGBA;
+            return true;
+        case CV_8UC1:
+            *format = ImageTexture_GRAY;
+            *bufferFormat = FrameBuffer_GRAY8;
+            return true;
+        default:
+            return false;
+    }
+}
+
+void ImageViewer::imshow(string frame_name, cv::Mat &frame, uint64_t version) {
+    ImageTextureFormat format;
+    FrameBufferFormat bufferFormat;
+    if (frame.empty() || !matFormat(frame, &format, &bufferFormat)) {
+        if (log) {
+            printf("ImageViewer: %s unsupported mat type %d\n", frame_name.c_str(), frame.type());
+        }
+        return;
+    }
+    // 静态图片不用每次拷贝
+    if (textures.skipUnchanged(frame_name, frame.data, version)) {
+        return;
+    }
+    // 调用方之后会改写 frame(video.read 解码到同一块数据)，上传的是发布时的拷贝
+    FrameBufferRef buffer = frames.acquire(bufferFormat, frame.cols, frame.rows);
+    if (!buffer) {
+        return;
+    }
+    cv::Mat copy(frame.rows, frame.cols, frame.type(), buffer->planes[0], (size_t) buffer->strides[0]);
+    frame.copyTo(copy);
+    TextureFrame textureFrame = TextureFrame::fromFrameBuffer(buffer);
+    textureFrame.format = format;
+    textureFrame.version = version;
+    textureFrame.source = frame.data;
+    textures.publish(frame_name, std::move(textureFrame));
+}
 
 void ImageViewer::imshow(string frame_name, cv::Mat &frame) {
-    frame_names.push_back(frame_name);
-    frames.push_back(&frame);
+    imshow(std::move(frame_name), frame, 0);
 }
 
 void ImageViewer::imshow(cv::Mat &frame) {
-    imshow("image:" + to_string(frames.size()), frame);
+    imshow("image:" + to_string(unnamed++), frame);
+}
+
+void ImageViewer::imshow(string frame_name, const FrameBufferRef &frame) {
+    if (!frame) {
+        return;
+    }
+    textures.publish(frame_name, TextureFrame::fromFrameBuffer(frame));
 }
 
 void ImageViewer::showMainContents() {
     ImGui::Begin("Main");
-    ImGui::SliderFloat("gain", &gain, 0.0f, 2.0f, "%.3f");
+    float value = gain;
+    ImGui::SliderFloat("gain", &value, 0.0f, 2.0f, "%.3f");
+    gain = value;
     ImGui::Text("IsWindowFocused = %d", ImGui::IsWindowFocused(ImGuiFocusedFlags_AnyWindow));
     ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate,
                 ImGui::GetIO().Framerate);
     ImGui::Text("height: %.0f width: %.0f", ImGui::GetWindowHeight(), ImGui::GetWindowWidth());
+    TextureCacheStats stats = textures.getStats();
+    ImGui::Text("uploads: %llu replaced: %llu unchanged: %llu", (unsigned long long) stats.uploads,
+                (unsigned long long) stats.replaced, (unsigned long long) stats.unchanged);
     ImGui::End();
 }
 
 void ImageViewer::show() {
-    drawBegin();
-    showMainContents();
-    // initialize textures
-    vector<ImageTexture *> my_textures;
-    for (int i = 0; i < frames.size(); i++) {
-        my_textures.push_back(new ImageTexture());
-    }
-
-    // imshow windows
-    for (int i = 0; i < frames.size(); i++) {
-        cv::Mat *frame = frames[i];
-        string window_name;
-        if (frame_names.size() <= i) {
-            window_name = "image:" + to_string(i);
-        } else {
-            window_name = frame_names[i];
-        }
-        ImGui::Begin(window_name.c_str());
-        my_textures[i]->setBuffer(frame->data, frame->cols, frame->rows);
-        ImVec2 imVec2 = ImVec2((float) frame->cols, (float) frame->rows);
-        ImGui::Image((ImTextureID) my_textures[i]->getOpenglTexture(), imVec2);
-        ImGui::End();
-    }
-
-    drawEnd();
-    // clear resources
-    for (int i = 0; i < frames.size(); i++) {
-        delete my_textures[i];
+    unnamed = 0;
+    if (layer != nullptr) {
+        layer->markDirty(1);
     }
+}
 
-    frame_names.clear();
-    frames.clear();
-    my_textures.clear();
+TextureCacheStats ImageViewer::getStats() const {
+    return textures.getStats();
 }
 
 void ImageViewer::shutdown() {
+    if (layer != nullptr) {
+        // 停止渲染线程后GL上下文回到当前线程，在这里释放纹理
+        layer->stop();
+        textures.clear();
+        layer = nullptr;
+    }
     ::shutdown();
-}
\ No newline at end of file
+}
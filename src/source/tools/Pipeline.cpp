@@ -0,0 +1,312 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Pipeline.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <utility>
+
+void PipelineFrame::reset() {
+    seq = 0;
+    startNs = 0;
+    dropped = false;
+    for (FrameBufferRef &buffer: buffers) {
+        buffer.reset();
+    }
+    userData.reset();
+}
+
+Pipeline::Pipeline(ThreadPool &pool) : pool(pool) {
+    source.name = "source";
+}
+
+Pipeline::~Pipeline() {
+    stop();
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] {
+        return inFlight == 0;
+    });
+}
+
+void Pipeline::setSource(const std::string &name, PipelineStageFunc func) {
+    source.name = name;
+    source.mode = PipelineStage_Serial;
+    source.func = std::move(func);
+}
+
+void Pipeline::addStage(const std::string &name, PipelineStageMode mode, PipelineStageFunc func) {
+    std::unique_ptr<Stage> stage(new Stage());
+    stage->name = name;
+    stage->mode = mode;
+    stage->func = std::move(func);
+    stages.push_back(std::move(stage));
+}
+
+ThreadPool &Pipeline::getPool() {
+    return pool;
+}
+
+void Pipeline::stop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = true;
+    cond.notify_all();
+}
+
+void Pipeline::resetRun() {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopped = false;
+    stats = PipelineStats();
+    source.stats = PipelineStageStats();
+    for (std::unique_ptr<Stage> &stage: stages) {
+        stage->nextSeq = 0;
+        stage->busy = false;
+        stage->waiting.clear();
+        stage->running = 0;
+        stage->stats = PipelineStageStats();
+    }
+}
+
+bool Pipeline::callStage(Stage &stage, Token *token) {
+    PROFILE_ZONE("Pipeline::stage");
+    int64_t start = Profiler::nowNs();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stage.stats.waitNs += start - token->arriveNs;
+        stage.running++;
+        if (stage.running > stage.stats.maxConcurrent) {
+            stage.stats.maxConcurrent = stage.running;
+        }
+    }
+    bool ok = stage.func(token->frame);
+    int64_t elapsed = Profiler::nowNs() - start;
+    std::lock_guard<std::mutex> lock(mutex);
+    stage.running--;
+    if (!ok && &stage == &source) {
+        // 源阶段返回false是没有更多帧，不算一帧
+        return false;
+    }
+    stage.stats.frames++;
+    stage.stats.busyNs += elapsed;
+    if (elapsed > stage.stats.maxNs) {
+        stage.stats.maxNs = elapsed;
+    }
+    if (!ok) {
+        stage.stats.dropped++;
+    }
+    return ok;
+}
+
+void Pipeline::arrive(Token *token, size_t index) {
+    if (index == stages.size()) {
+        finish(token);
+        return;
+    }
+    Stage &stage = *stages[index];
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        token->arriveNs = Profiler::nowNs();
+        if (stage.mode == PipelineStage_Serial) {
+            // 前一帧还在处理或者前面的帧还没到，按序号排队
+            if (stage.busy || token->frame.seq != stage.nextSeq) {
+                stage.waiting[token->frame.seq] = token;
+                return;
+            }
+            stage.busy = true;
+        }
+    }
+    pool.submit([this, token, index] {
+        execute(token, index);
+    });
+}
+
+void Pipeline::execute(Token *token, size_t index) {
+    Stage &stage = *stages[index];
+    // 丢弃的帧不再调用阶段函数，但仍然经过串行阶段，保证后面的序号连续
+    if (!token->frame.dropped && !callStage(stage, token)) {
+        token->frame.dropped = true;
+    }
+    if (stage.mode == PipelineStage_Serial) {
+        Token *next = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stage.nextSeq++;
+            stage.busy = false;
+            auto it = stage.waiting.find(stage.nextSeq);
+            if (it != stage.waiting.end()) {
+                next = it->second;
+                stage.waiting.erase(it);
+                stage.busy = true;
+            }
+        }
+        if (next != nullptr) {
+            pool.submit([this, next, index] {
+                execute(next, index);
+            });
+        }
+    }
+    arrive(token, index + 1);
+}
+
+void Pipeline::finish(Token *token) {
+    int64_t latency = Profiler::nowNs() - token->frame.startNs;
+    bool dropped = token->frame.dropped;
+    // 在锁外释放帧缓冲(会进 FrameBufferPool 的锁)
+    token->frame.reset();
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.frames++;
+    if (dropped) {
+        stats.dropped++;
+    } else {
+        stats.latencyNs += latency;
+        if (latency > stats.maxLatencyNs) {
+            stats.maxLatencyNs = latency;
+        }
+    }
+    freeTokens.push_back(token);
+    inFlight--;
+    cond.notify_all();
+}
+
+uint64_t Pipeline::run(int maxInFlight) {
+    if (!source.func) {
+        printf("Pipeline: no source\n");
+        return 0;
+    }
+    if (maxInFlight < 1) {
+        maxInFlight = 1;
+    }
+    resetRun();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        while ((int) tokens.size() < maxInFlight) {
+            tokens.emplace_back(new Token());
+        }
+        freeTokens.clear();
+        for (int i = 0; i < maxInFlight; i++) {
+            freeTokens.push_back(tokens[i].get());
+        }
+    }
+    int64_t start = Profiler::nowNs();
+    uint64_t seq = 0;
+    while (true) {
+        Token *token;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [this] {
+                return stopped || !freeTokens.empty();
+            });
+            if (stopped) {
+                break;
+            }
+            token = freeTokens.back();
+            freeTokens.pop_back();
+        }
+        token->frame.seq = seq;
+        token->frame.startNs = Profiler::nowNs();
+        token->arriveNs = token->frame.startNs;
+        if (!callStage(source, token)) {
+            token->frame.reset();
+            std::lock_guard<std::mutex> lock(mutex);
+            freeTokens.push_back(token);
+            break;
+        }
+        seq++;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight++;
+            if (inFlight > stats.maxInFlight) {
+                stats.maxInFlight = inFlight;
+            }
+        }
+        arrive(token, 0);
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] {
+        return inFlight == 0;
+    });
+    stats.wallNs = Profiler::nowNs() - start;
+    return stats.frames;
+}
+
+uint64_t Pipeline::runSequential() {
+    if (!source.func) {
+        printf("Pipeline: no source\n");
+        return 0;
+    }
+    resetRun();
+    Token token;
+    int64_t start = Profiler::nowNs();
+    uint64_t seq = 0;
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (stopped) {
+                break;
+            }
+            inFlight = 1;
+            stats.maxInFlight = 1;
+        }
+        token.frame.seq = seq;
+        token.frame.startNs = Profiler::nowNs();
+        token.arriveNs = token.frame.startNs;
+        if (!callStage(source, &token)) {
+            token.frame.reset();
+            std::lock_guard<std::mutex> lock(mutex);
+            inFlight = 0;
+            break;
+        }
+        seq++;
+        for (std::unique_ptr<Stage> &stage: stages) {
+            token.arriveNs = Profiler::nowNs();
+            if (!token.frame.dropped && !callStage(*stage, &token)) {
+                token.frame.dropped = true;
+            }
+        }
+        int64_t latency = Profiler::nowNs() - token.frame.startNs;
+        bool dropped = token.frame.dropped;
+        token.frame.reset();
+        std::lock_guard<std::mutex> lock(mutex);
+        inFlight = 0;
+        stats.frames++;
+        if (dropped) {
+            stats.dropped++;
+        } else {
+            stats.latencyNs += latency;
+            if (latency > stats.maxLatencyNs) {
+                stats.maxLatencyNs = latency;
+            }
+        }
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.wallNs = Profiler::nowNs() - start;
+    return stats.frames;
+}
+
+PipelineStats Pipeline::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    PipelineStats result = stats;
+    result.stages.clear();
+    result.stages.push_back(source.stats);
+    result.stages.back().name = source.name;
+    result.stages.back().mode = source.mode;
+    for (const std::unique_ptr<Stage> &stage: stages) {
+        result.stages.push_back(stage->stats);
+        result.stages.back().name = stage->name;
+        result.stages.back().mode = stage->mode;
+    }
+    return result;
+}
+
+void Pipeline::printStats() const {
+    PipelineStats result = getStats();
+    printf("pipeline: %llu frames (%llu dropped) %.1f fps, latency avg %.2f ms max %.2f ms, in flight max %d\n",
+           (unsigned long long) result.frames, (unsigned long long) result.dropped, result.fps(),
+           result.avgLatencyMs(), (double) result.maxLatencyNs / 1e6, result.maxInFlight);
+    for (const PipelineStageStats &stage: result.stages) {
+        printf("  %-12s %-8s %6llu frames  avg %7.3f ms  max %7.3f ms  wait %7.3f ms  concurrent %d\n",
+               stage.name.c_str(), stage.mode == PipelineStage_Serial ? "serial" : "parallel",
+               (unsigned long long) stage.frames, stage.avgMs(), (double) stage.maxNs / 1e6, stage.avgWaitMs(),
+               stage.maxConcurrent);
+    }
+}
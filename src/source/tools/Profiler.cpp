@@ -0,0 +1,557 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "Profiler.h"
+#include <imgui.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <mutex>
+#include <algorithm>
+#include <cfloat>
+#include <unistd.h>
+#include <sys/syscall.h>
+
+std::atomic<bool> Profiler::enabled{true};
+thread_local ProfileRing *Profiler::currentRing = nullptr;
+
+// 线程缓冲链表，只增不减(线程结束后缓冲标记为空闲，由新线程复用)
+static std::atomic<ProfileRing *> g_Rings{nullptr};
+static std::mutex g_RingsMutex;
+
+// 帧结束时间(计数器)
+static const int FRAME_MARK_COUNT = 256;
+static std::atomic<uint64_t> g_FrameMarks[FRAME_MARK_COUNT];
+static std::atomic<uint64_t> g_FrameMarkHead{0};
+
+// 计数器，每个保留最近 COUNTER_SAMPLES 次取值
+static const int COUNTER_COUNT = 64;
+static const int COUNTER_SAMPLES = 256;
+
+struct ProfileCounter {
+    char name[48];
+    ProfileCounterSample samples[COUNTER_SAMPLES];
+    uint64_t head;
+};
+
+static ProfileCounter g_Counters[COUNTER_COUNT];
+static int g_CounterCount = 0;
+static std::mutex g_CountersMutex;
+
+// 计数器与 CLOCK_MONOTONIC 的换算: ns = baseNs + (ticks - baseTicks) * nsPerTick
+struct ProfileClock {
+    uint64_t baseTicks;
+    int64_t baseNs;
+    std::atomic<double> nsPerTick{1.0};
+    std::atomic<uint64_t> refinedTicks{0};
+
+    ProfileClock() {
+        baseNs = Profiler::nowNs();
+        baseTicks = Profiler::ticks();
+#if defined(__aarch64__)
+        uint64_t frequency;
+        asm volatile("mrs %0, cntfrq_el0" : "=r"(frequency));
+        nsPerTick = 1e9 / (double) frequency;
+#elif defined(__x86_64__) || defined(__i386__)
+        // rdtsc 频率未知，先用1ms粗略校准，之后每次读取时用更长的间隔修正
+        int64_t ns;
+        while ((ns = Profiler::nowNs()) - baseNs < 1000000) {
+        }
+        nsPerTick = (double) (ns - baseNs) / (double) (Profiler::ticks() - baseTicks);
+#endif
+        refinedTicks = baseTicks;
+    }
+
+    // 距离上次修正超过100ms时，用启动以来的整个区间重新计算频率
+    void refine(uint64_t now) {
+#if defined(__x86_64__) || defined(__i386__)
+        uint64_t last = refinedTicks.load(std::memory_order_relaxed);
+        if ((double) (now - last) * nsPerTick.load(std::memory_order_relaxed) < 100000000.0 ||
+            !refinedTicks.compare_exchange_strong(last, now)) {
+            return;
+        }
+        int64_t ns = Profiler::nowNs();
+        uint64_t ticks = Profiler::ticks();
+        if (ticks > baseTicks) {
+            nsPerTick = (double) (ns - baseNs) / (double) (ticks - baseTicks);
+        }
+#else
+        (void) now;
+#endif
+    }
+};
+
+static ProfileClock &profileClock() {
+    static ProfileClock clock;
+    return clock;
+}
+
+// 程序启动时完成校准，不放到第一次读取时
+static ProfileClock &g_ProfileClockInit = profileClock();
+
+int64_t Profiler::ticksToNs(uint64_t ticks) {
+    ProfileClock &clock = profileClock();
+    clock.refine(ticks);
+    double delta = (double) (int64_t) (ticks - clock.baseTicks) * clock.nsPerTick.load(std::memory_order_relaxed);
+    return clock.baseNs + (int64_t) delta;
+}
+
+int64_t Profiler::nowNs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void Profiler::setEnabled(bool enable) {
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+// 线程结束时把缓冲交还
+struct ProfileRingOwner {
+    ~ProfileRingOwner() {
+        Profiler::setThreadName(nullptr);
+    }
+};
+
+ProfileRing *Profiler::acquireRing() {
+    static thread_local ProfileRingOwner owner;
+    (void) owner;
+    std::lock_guard<std::mutex> lock(g_RingsMutex);
+    ProfileRing *ring = nullptr;
+    for (ProfileRing *it = g_Rings.load(); it != nullptr; it = it->next) {
+        if (!it->active.load()) {
+            ring = it;
+            break;
+        }
+    }
+    if (ring == nullptr) {
+        ring = new ProfileRing();
+        ring->next = g_Rings.load();
+        g_Rings.store(ring);
+    }
+    ring->tid = (int) syscall(SYS_gettid);
+    snprintf(ring->name, sizeof(ring->name), "thread %d", ring->tid.load());
+    ring->depth = 0;
+    // 复用的缓冲里还有上一个线程的记录，不算到新线程名下
+    ring->base = ring->head.load();
+    ring->active = true;
+    currentRing = ring;
+    return ring;
+}
+
+void Profiler::releaseRing() {
+    ProfileRing *ring = currentRing;
+    if (ring == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(g_RingsMutex);
+    ring->active = false;
+    currentRing = nullptr;
+}
+
+void Profiler::setThreadName(const char *name) {
+    if (name == nullptr) {
+        releaseRing();
+        return;
+    }
+    ProfileRing *ring = threadRing();
+    std::lock_guard<std::mutex> lock(g_RingsMutex);
+    snprintf(ring->name, sizeof(ring->name), "%s", name);
+}
+
+void Profiler::frameMark() {
+    if (!isEnabled()) {
+        return;
+    }
+    uint64_t index = g_FrameMarkHead.load(std::memory_order_relaxed);
+    g_FrameMarks[index % FRAME_MARK_COUNT].store(ticks(), std::memory_order_relaxed);
+    g_FrameMarkHead.store(index + 1, std::memory_order_release);
+}
+
+int Profiler::getFrameTimes(int64_t *frameEndNs, int count) {
+    uint64_t head = g_FrameMarkHead.load(std::memory_order_acquire);
+    count = (int) std::min<uint64_t>((uint64_t) std::min(count, FRAME_MARK_COUNT - 1), head);
+    for (int i = 0; i < count; i++) {
+        uint64_t index = head - count + i;
+        frameEndNs[i] = ticksToNs(g_FrameMarks[index % FRAME_MARK_COUNT].load(std::memory_order_relaxed));
+    }
+    return count;
+}
+
+void Profiler::collect(std::vector<ProfileThreadEvents> &out, int64_t sinceNs) {
+    profileClock().refine(ticks());
+    out.clear();
+    for (ProfileRing *ring = g_Rings.load(); ring != nullptr; ring = ring->next) {
+        uint64_t head = ring->head.load(std::memory_order_acquire);
+        if (head == 0) {
+            continue;
+        }
+        out.emplace_back();
+        ProfileThreadEvents &thread = out.back();
+        {
+            std::lock_guard<std::mutex> lock(g_RingsMutex);
+            thread.tid = ring->tid;
+            memcpy(thread.name, ring->name, sizeof(thread.name));
+        }
+        uint64_t base = ring->base.load();
+        uint64_t first = head > ProfileRing::CAPACITY ? head - ProfileRing::CAPACITY : 0;
+        first = std::max(first, base);
+        if (first >= head) {
+            out.pop_back();
+            continue;
+        }
+        thread.events.reserve((size_t) (head - first));
+        for (uint64_t i = first; i < head; i++) {
+            const ProfileRing::Slot &slot = ring->slots[i & (ProfileRing::CAPACITY - 1)];
+            ProfileEvent event{};
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.startNs = ticksToNs(slot.start.load(std::memory_order_relaxed));
+            event.endNs = ticksToNs(slot.end.load(std::memory_order_relaxed));
+            event.depth = (int) slot.depth.load(std::memory_order_relaxed);
+            thread.events.push_back(event);
+        }
+        // 拷贝期间写入线程可能已经覆盖了最旧的几条(正在写的下标 head 会覆盖 head - CAPACITY)
+        std::atomic_thread_fence(std::memory_order_acquire);
+        uint64_t after = ring->head.load(std::memory_order_relaxed);
+        uint64_t valid = after + 1 > ProfileRing::CAPACITY ? after + 1 - ProfileRing::CAPACITY : 0;
+        size_t skip = valid > first ? (size_t) std::min<uint64_t>(valid - first, head - first) : 0;
+        thread.overwritten = first + skip - base;
+        thread.events.erase(thread.events.begin(), thread.events.begin() + (long) skip);
+        thread.events.erase(std::remove_if(thread.events.begin(), thread.events.end(), [sinceNs](const ProfileEvent &e) {
+            return e.endNs < sinceNs;
+        }), thread.events.end());
+        std::sort(thread.events.begin(), thread.events.end(), [](const ProfileEvent &a, const ProfileEvent &b) {
+            return a.startNs != b.startNs ? a.startNs < b.startNs : a.depth < b.depth;
+        });
+    }
+    std::sort(out.begin(), out.end(), [](const ProfileThreadEvents &a, const ProfileThreadEvents &b) {
+        return a.tid < b.tid;
+    });
+}
+
+static ProfileCounter *findCounter(const char *name) {
+    for (int i = 0; i < g_CounterCount; i++) {
+        if (strncmp(g_Counters[i].name, name, sizeof(g_Counters[i].name) - 1) == 0) {
+            return &g_Counters[i];
+        }
+    }
+    return nullptr;
+}
+
+void Profiler::setCounter(const char *name, double value) {
+    if (!isEnabled() || name == nullptr) {
+        return;
+    }
+    int64_t ns = nowNs();
+    std::lock_guard<std::mutex> lock(g_CountersMutex);
+    ProfileCounter *counter = findCounter(name);
+    if (counter == nullptr) {
+        if (g_CounterCount == COUNTER_COUNT) {
+            return;
+        }
+        counter = &g_Counters[g_CounterCount++];
+        snprintf(counter->name, sizeof(counter->name), "%s", name);
+        counter->head = 0;
+    }
+    counter->samples[counter->head % COUNTER_SAMPLES] = {ns, value};
+    counter->head++;
+}
+
+bool Profiler::getCounter(const char *name, double &value) {
+    std::lock_guard<std::mutex> lock(g_CountersMutex);
+    const ProfileCounter *counter = findCounter(name);
+    if (counter == nullptr) {
+        return false;
+    }
+    value = counter->samples[(counter->head - 1) % COUNTER_SAMPLES].value;
+    return true;
+}
+
+void Profiler::collectCounters(std::vector<ProfileCounterTrack> &out, int64_t sinceNs) {
+    std::lock_guard<std::mutex> lock(g_CountersMutex);
+    out.resize((size_t) g_CounterCount);
+    for (int i = 0; i < g_CounterCount; i++) {
+        const ProfileCounter &counter = g_Counters[i];
+        ProfileCounterTrack &track = out[(size_t) i];
+        memcpy(track.name, counter.name, sizeof(track.name));
+        track.samples.clear();
+        uint64_t first = counter.head > COUNTER_SAMPLES ? counter.head - COUNTER_SAMPLES : 0;
+        for (uint64_t n = first; n < counter.head; n++) {
+            const ProfileCounterSample &sample = counter.samples[n % COUNTER_SAMPLES];
+            if (sample.ns >= sinceNs) {
+                track.samples.push_back(sample);
+            }
+        }
+    }
+}
+
+static void writeJsonString(FILE *file, const char *text) {
+    fputc('"', file);
+    for (const char *c = text != nullptr ? text : ""; *c != '\0'; c++) {
+        if (*c == '"' || *c == '\\') {
+            fputc('\\', file);
+        }
+        if ((unsigned char) *c >= 0x20) {
+            fputc(*c, file);
+        }
+    }
+    fputc('"', file);
+}
+
+bool Profiler::exportChromeTrace(const char *path) {
+    std::vector<ProfileThreadEvents> threads;
+    collect(threads);
+    std::vector<ProfileCounterTrack> counters;
+    collectCounters(counters);
+    FILE *file = fopen(path, "w");
+    if (file == nullptr) {
+        printf("Profiler: open %s failed\n", path);
+        return false;
+    }
+    int pid = (int) getpid();
+    bool first = true;
+    fprintf(file, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+    for (const ProfileThreadEvents &thread: threads) {
+        fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"args\":{\"name\":",
+                first ? "" : ",\n", pid, thread.tid);
+        writeJsonString(file, thread.name);
+        fprintf(file, "}}");
+        first = false;
+        for (const ProfileEvent &event: thread.events) {
+            fprintf(file, ",\n{\"name\":");
+            writeJsonString(file, event.name);
+            fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%d}",
+                    (double) event.startNs / 1000.0, (double) (event.endNs - event.startNs) / 1000.0, pid,
+                    thread.tid);
+        }
+    }
+    // 计数器在 trace 中显示为进程级的折线
+    for (const ProfileCounterTrack &counter: counters) {
+        for (const ProfileCounterSample &sample: counter.samples) {
+            fprintf(file, "%s{\"name\":", first ? "" : ",\n");
+            first = false;
+            writeJsonString(file, counter.name);
+            fprintf(file, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":%d,\"args\":{\"value\":%.6g}}",
+                    (double) sample.ns / 1000.0, pid, sample.value);
+        }
+    }
+    fprintf(file, "\n]}\n");
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+// 时间线窗口状态(只在绘制线程使用)
+struct ProfilerWindowState {
+    bool paused = false;
+    int frames = 3;
+    int64_t rangeStart = 0;
+    int64_t rangeEnd = 0;
+    std::vector<ProfileThreadEvents> threads;
+    std::vector<ProfileCounterTrack> counters;
+    char exportPath[128] = "/data/local/tmp/trace.json";
+    char exportStatus[160] = {};
+};
+
+struct ProfileZoneTotal {
+    const char *name;
+    int count;
+    int64_t totalNs;
+    int64_t maxNs;
+};
+
+static ImU32 zoneColor(const char *name) {
+    // 同名区段颜色固定
+    uint32_t hash = 2166136261u;
+    for (const char *c = name != nullptr ? name : ""; *c != '\0'; c++) {
+        hash = (hash ^ (uint8_t) *c) * 16777619u;
+    }
+    return ImColor::HSV((float) (hash % 360) / 360.0f, 0.55f, 0.75f);
+}
+
+void Profiler::showWindow(bool *open) {
+    static ProfilerWindowState state;
+    if (!ImGui::Begin("Profiler", open)) {
+        ImGui::End();
+        return;
+    }
+    bool enable = isEnabled();
+    if (ImGui::Checkbox("Enabled", &enable)) {
+        setEnabled(enable);
+    }
+    ImGui::SameLine();
+    ImGui::Checkbox("Pause", &state.paused);
+    ImGui::SameLine();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 6.0f);
+    ImGui::SliderInt("Frames", &state.frames, 1, 16);
+
+    if (!state.paused) {
+        int64_t frameEnds[17];
+        int count = getFrameTimes(frameEnds, state.frames + 1);
+        if (count >= 2) {
+            state.rangeStart = frameEnds[0];
+            state.rangeEnd = frameEnds[count - 1];
+        } else {
+            // 没有帧标记时显示最近50ms
+            state.rangeEnd = nowNs();
+            state.rangeStart = state.rangeEnd - 50000000;
+        }
+        collect(state.threads, state.rangeStart);
+        collectCounters(state.counters);
+    }
+    double rangeMs = (double) (state.rangeEnd - state.rangeStart) / 1e6;
+    ImGui::Text("%.3f ms (%.3f ms/frame)", rangeMs, rangeMs / state.frames);
+
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 14.0f);
+    ImGui::InputText("##path", state.exportPath, sizeof(state.exportPath));
+    ImGui::SameLine();
+    if (ImGui::Button("Export trace")) {
+        bool ok = exportChromeTrace(state.exportPath);
+        snprintf(state.exportStatus, sizeof(state.exportStatus), "%s %s", ok ? "saved" : "failed", state.exportPath);
+    }
+    if (state.exportStatus[0] != '\0') {
+        ImGui::TextUnformatted(state.exportStatus);
+    }
+
+    // 时间线: 每个线程一组，按嵌套层级一行
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    float rowHeight = ImGui::GetTextLineHeight() + 4.0f;
+    float width = ImGui::GetContentRegionAvail().x;
+    double scale = state.rangeEnd > state.rangeStart ? width / (double) (state.rangeEnd - state.rangeStart) : 0.0;
+    const ProfileEvent *hovered = nullptr;
+    for (const ProfileThreadEvents &thread: state.threads) {
+        int maxDepth = -1;
+        for (const ProfileEvent &event: thread.events) {
+            if (event.startNs < state.rangeEnd) {
+                maxDepth = std::max(maxDepth, event.depth);
+            }
+        }
+        if (maxDepth < 0) {
+            continue;
+        }
+        ImGui::Text("%s (%d)", thread.name, thread.tid);
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size(width, rowHeight * (float) (maxDepth + 1));
+        ImGui::InvisibleButton(thread.name, size);
+        drawList->AddRectFilled(origin, ImVec2(origin.x + size.x, origin.y + size.y), IM_COL32(40, 40, 40, 255));
+        // 同一行里不足1像素的区段合并，区段很多时顶点数不会跟着涨
+        std::vector<float> lastX((size_t) maxDepth + 1, -FLT_MAX);
+        for (const ProfileEvent &event: thread.events) {
+            if (event.startNs >= state.rangeEnd) {
+                continue;
+            }
+            float x0 = origin.x + (float) ((double) (std::max(event.startNs, state.rangeStart) - state.rangeStart) * scale);
+            float x1 = origin.x + (float) ((double) (std::min(event.endNs, state.rangeEnd) - state.rangeStart) * scale);
+            x1 = std::max(x1, x0 + 1.0f);
+            float &rowX = lastX[(size_t) event.depth];
+            if (x1 <= rowX + 1.0f) {
+                continue;
+            }
+            x0 = std::max(x0, rowX);
+            rowX = x1;
+            float y0 = origin.y + rowHeight * (float) event.depth;
+            ImVec2 p0(x0, y0 + 1.0f), p1(x1, y0 + rowHeight - 1.0f);
+            drawList->AddRectFilled(p0, p1, zoneColor(event.name));
+            if (x1 - x0 > ImGui::GetFontSize() * 2.0f) {
+                ImVec4 clip(x0, p0.y, x1, p1.y);
+                drawList->AddText(nullptr, 0.0f, ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32_WHITE, event.name, nullptr,
+                                  0.0f, &clip);
+            }
+            if (ImGui::IsMouseHoveringRect(p0, p1)) {
+                hovered = &event;
+            }
+        }
+    }
+    if (hovered != nullptr) {
+        ImGui::BeginTooltip();
+        ImGui::Text("%s %.3f ms", hovered->name, (double) (hovered->endNs - hovered->startNs) / 1e6);
+        ImGui::EndTooltip();
+    }
+
+    // 按名称汇总(范围内结束的区段)
+    std::vector<ProfileZoneTotal> totals;
+    for (const ProfileThreadEvents &thread: state.threads) {
+        for (const ProfileEvent &event: thread.events) {
+            if (event.endNs > state.rangeEnd) {
+                continue;
+            }
+            int64_t duration = event.endNs - event.startNs;
+            auto it = std::find_if(totals.begin(), totals.end(), [&event](const ProfileZoneTotal &total) {
+                return total.name == event.name;
+            });
+            if (it == totals.end()) {
+                totals.push_back({event.name, 1, duration, duration});
+            } else {
+                it->count++;
+                it->totalNs += duration;
+                it->maxNs = std::max(it->maxNs, duration);
+            }
+        }
+    }
+    std::sort(totals.begin(), totals.end(), [](const ProfileZoneTotal &a, const ProfileZoneTotal &b) {
+        return a.totalNs > b.totalNs;
+    });
+    if (ImGui::BeginTable("zones", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("zone");
+        ImGui::TableSetupColumn("count");
+        ImGui::TableSetupColumn("total ms");
+        ImGui::TableSetupColumn("avg us");
+        ImGui::TableSetupColumn("max us");
+        ImGui::TableHeadersRow();
+        for (const ProfileZoneTotal &total: totals) {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(total.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", total.count);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", (double) total.totalNs / 1e6);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", (double) total.totalNs / total.count / 1e3);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f", (double) total.maxNs / 1e3);
+        }
+        ImGui::EndTable();
+    }
+
+    // 计数器: 最新值和最近的取值曲线
+    if (!state.counters.empty() && ImGui::BeginTable("counters", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("counter");
+        ImGui::TableSetupColumn("value");
+        ImGui::TableSetupColumn("min");
+        ImGui::TableSetupColumn("max");
+        ImGui::TableSetupColumn("history", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        std::vector<float> values;
+        for (const ProfileCounterTrack &counter: state.counters) {
+            if (counter.samples.empty()) {
+                continue;
+            }
+            values.clear();
+            double minValue = DBL_MAX, maxValue = -DBL_MAX;
+            for (const ProfileCounterSample &sample: counter.samples) {
+                values.push_back((float) sample.value);
+                minValue = std::min(minValue, sample.value);
+                maxValue = std::max(maxValue, sample.value);
+            }
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(counter.name);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.6g", counter.samples.back().value);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.6g", minValue);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.6g", maxValue);
+            ImGui::TableNextColumn();
+            ImGui::PushID(counter.name);
+            ImGui::SetNextItemWidth(-FLT_MIN);
+            ImGui::PlotLines("##history", values.data(), (int) values.size(), 0, nullptr, (float) minValue,
+                             (float) maxValue, ImVec2(0, ImGui::GetTextLineHeight()));
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
@@ -0,0 +1,362 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "RawFramePool.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <chrono>
+
+static int64_t monotonicNs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+#if defined(__ANDROID__)
+
+ExternRawFrameSource::ExternRawFrameSource(ExternFunction *externFunction, int maxImages) :
+        externFunction(externFunction), maxImages(maxImages) {
+}
+
+bool ExternRawFrameSource::acquire(RawFrame &frame, int timeoutMs) {
+    return externFunction->acquireRawFrame(&frame, timeoutMs);
+}
+
+void ExternRawFrameSource::release(RawFrame &frame) {
+    externFunction->releaseRawFrame(&frame);
+}
+
+int ExternRawFrameSource::getMaxImages() const {
+    return maxImages;
+}
+
+#endif
+
+// 行宽按64字节对齐，和 gralloc 分配的缓冲一样 rowStride 大于有效宽度
+static int32_t alignStride(uint32_t bytes) {
+    return (int32_t) ((bytes + 63) & ~63u);
+}
+
+SyntheticFrameSource::SyntheticFrameSource(uint32_t width, uint32_t height, int32_t format, int maxImages,
+                                           float fps) :
+        width(width), height(height), format(format), maxImages(maxImages), fps(fps) {
+    buffers.resize((size_t) maxImages + 2);
+    for (Buffer &buffer: buffers) {
+        RawFrame &frame = buffer.frame;
+        frame.width = width;
+        frame.height = height;
+        frame.format = format;
+        size_t offsets[3] = {0, 0, 0};
+        size_t size;
+        if (format == RawFrame_YUV_420_888) {
+            // I420: Y 平面全尺寸，U/V 平面宽高各一半
+            frame.planeCount = 3;
+            frame.rowStride[0] = alignStride(width);
+            frame.rowStride[1] = frame.rowStride[2] = alignStride(width / 2);
+            frame.pixelStride[0] = frame.pixelStride[1] = frame.pixelStride[2] = 1;
+            offsets[1] = (size_t) frame.rowStride[0] * height;
+            offsets[2] = offsets[1] + (size_t) frame.rowStride[1] * (height / 2);
+            size = offsets[2] + (size_t) frame.rowStride[2] * (height / 2);
+        } else {
+            frame.planeCount = 1;
+            frame.rowStride[0] = alignStride(width * 4);
+            frame.pixelStride[0] = 4;
+            size = (size_t) frame.rowStride[0] * height;
+        }
+        buffer.data.resize(size);
+        for (int i = 0; i < frame.planeCount; i++) {
+            frame.planes[i] = buffer.data.data() + offsets[i];
+        }
+    }
+}
+
+SyntheticFrameSource::~SyntheticFrameSource() {
+    stop();
+    if (acquiredCount != 0) {
+        printf("SyntheticFrameSource destroyed with %d frames still acquired\n", acquiredCount);
+    }
+}
+
+bool SyntheticFrameSource::start() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (running || fps <= 0.0f || width < 16 || height < 2) {
+        return false;
+    }
+    running = true;
+    thread = std::thread(&SyntheticFrameSource::producerLoop, this);
+    return true;
+}
+
+void SyntheticFrameSource::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    cond.notify_all();
+    if (thread.joinable()) {
+        thread.join();
+    }
+}
+
+uint8_t SyntheticFrameSource::patternByte(uint64_t seq, int plane) {
+    return (uint8_t) (seq * 31 + (uint64_t) plane * 85 + 7);
+}
+
+void SyntheticFrameSource::fill(Buffer &buffer, uint64_t seq) {
+    PROFILE_ZONE("SyntheticFrameSource::fill");
+    RawFrame &frame = buffer.frame;
+    for (int i = 0; i < frame.planeCount; i++) {
+        uint32_t rows = i == 0 ? height : height / 2;
+        size_t rowBytes = (size_t) (i == 0 ? width : width / 2) * frame.pixelStride[i];
+        uint8_t value = patternByte(seq, i);
+        for (uint32_t y = 0; y < rows; y++) {
+            uint8_t *row = frame.planes[i] + (size_t) frame.rowStride[i] * y;
+            memcpy(row, &seq, sizeof(seq));
+            memset(row + sizeof(seq), value, rowBytes - sizeof(seq));
+        }
+    }
+}
+
+bool SyntheticFrameSource::checkPattern(const RawFrame &frame, uint64_t *seq) {
+    uint64_t first = 0;
+    for (int i = 0; i < frame.planeCount; i++) {
+        uint32_t rows = i == 0 ? frame.height : frame.height / 2;
+        size_t rowBytes = (size_t) (i == 0 ? frame.width : frame.width / 2) * frame.pixelStride[i];
+        for (uint32_t y = 0; y < rows; y++) {
+            const uint8_t *row = frame.planes[i] + (size_t) frame.rowStride[i] * y;
+            uint64_t rowSeq;
+            memcpy(&rowSeq, row, sizeof(rowSeq));
+            if (i == 0 && y == 0) {
+                first = rowSeq;
+            }
+            uint8_t value = patternByte(first, i);
+            if (rowSeq != first || row[sizeof(rowSeq)] != value || row[rowBytes - 1] != value) {
+                return false;
+            }
+        }
+    }
+    if (seq != nullptr) {
+        *seq = first;
+    }
+    return true;
+}
+
+void SyntheticFrameSource::producerLoop() {
+    PROFILE_THREAD("raw producer");
+    int64_t interval = (int64_t) (1e9f / fps);
+    int64_t next = monotonicNs();
+    uint64_t seq = 0;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        int64_t now = monotonicNs();
+        if (now < next) {
+            cond.wait_for(lock, std::chrono::nanoseconds(next - now));
+            continue;
+        }
+        // 落后太多时不补帧
+        next = next + interval > now ? next + interval : now + interval;
+        int index = -1;
+        for (size_t i = 0; i < buffers.size(); i++) {
+            if (buffers[i].state == Buffer_Free) {
+                index = (int) i;
+                break;
+            }
+        }
+        if (index < 0) {
+            producerDropped++;
+            continue;
+        }
+        Buffer &buffer = buffers[index];
+        buffer.state = Buffer_Dequeued;
+        seq++;
+        lock.unlock();
+        fill(buffer, seq);
+        buffer.frame.timestampNs = monotonicNs();
+        lock.lock();
+        if (queued >= 0) {
+            buffers[queued].state = Buffer_Free;
+            replaced++;
+        }
+        queued = index;
+        buffer.state = Buffer_Queued;
+        produced++;
+        cond.notify_all();
+    }
+}
+
+bool SyntheticFrameSource::acquire(RawFrame &frame, int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (acquiredCount >= maxImages) {
+        return false;
+    }
+    cond.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] { return !running || queued >= 0; });
+    if (!running || queued < 0) {
+        return false;
+    }
+    Buffer &buffer = buffers[queued];
+    queued = -1;
+    buffer.state = Buffer_Acquired;
+    acquiredCount++;
+    frame = buffer.frame;
+    frame.image = &buffer;
+    return true;
+}
+
+void SyntheticFrameSource::release(RawFrame &frame) {
+    if (frame.image == nullptr) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    static_cast<Buffer *>(frame.image)->state = Buffer_Free;
+    acquiredCount--;
+    frame.image = nullptr;
+}
+
+int SyntheticFrameSource::getMaxImages() const {
+    return maxImages;
+}
+
+uint64_t SyntheticFrameSource::getProducedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return produced;
+}
+
+uint64_t SyntheticFrameSource::getProducerDroppedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return producerDropped;
+}
+
+uint64_t SyntheticFrameSource::getReplacedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return replaced;
+}
+
+int SyntheticFrameSource::getAcquiredCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return acquiredCount;
+}
+
+RawFrameRef::RawFrameRef(const RawFrameRef &other) : slot(other.slot) {
+    if (slot != nullptr) {
+        slot->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+RawFrameRef::RawFrameRef(RawFrameRef &&other) noexcept: slot(other.slot) {
+    other.slot = nullptr;
+}
+
+RawFrameRef &RawFrameRef::operator=(const RawFrameRef &other) {
+    if (this != &other) {
+        if (other.slot != nullptr) {
+            other.slot->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        reset();
+        slot = other.slot;
+    }
+    return *this;
+}
+
+RawFrameRef &RawFrameRef::operator=(RawFrameRef &&other) noexcept {
+    if (this != &other) {
+        reset();
+        slot = other.slot;
+        other.slot = nullptr;
+    }
+    return *this;
+}
+
+RawFrameRef::~RawFrameRef() {
+    reset();
+}
+
+void RawFrameRef::reset() {
+    if (slot == nullptr) {
+        return;
+    }
+    // 最后一个引用负责还帧，之前其他线程对帧内存的读取都在这之前完成
+    if (slot->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        slot->pool->releaseSlot(slot);
+    }
+    slot = nullptr;
+}
+
+const RawFrame *RawFrameRef::get() const {
+    return slot != nullptr ? &slot->frame : nullptr;
+}
+
+int RawFrameRef::useCount() const {
+    return slot != nullptr ? slot->refs.load(std::memory_order_relaxed) : 0;
+}
+
+RawFramePool::RawFramePool(RawFrameSource *source, int maxOutstanding) : source(source) {
+    int maxImages = source->getMaxImages();
+    // 超过来源上限的部分来源也会拒绝，直接限制在来源上限之内
+    this->maxOutstanding = maxOutstanding > 0 && maxOutstanding < maxImages ? maxOutstanding : maxImages;
+    slots.reset(new RawFrameRef::Slot[this->maxOutstanding]);
+    for (int i = this->maxOutstanding - 1; i >= 0; i--) {
+        slots[i].pool = this;
+        freeSlots.push_back(&slots[i]);
+    }
+}
+
+RawFramePool::~RawFramePool() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (stats.outstanding != 0) {
+        printf("RawFramePool destroyed with %d frames still referenced, waiting for them\n", stats.outstanding);
+        releasedCond.wait(lock, [this] { return stats.outstanding == 0; });
+    }
+}
+
+RawFrameRef RawFramePool::acquire(int timeoutMs) {
+    PROFILE_ZONE("RawFramePool::acquire");
+    RawFrameRef::Slot *slot;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (freeSlots.empty()) {
+            stats.dropped++;
+            return {};
+        }
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+    // 等待来源时不持有锁，其他线程可以同时释放帧
+    if (!source->acquire(slot->frame, timeoutMs)) {
+        std::lock_guard<std::mutex> lock(mutex);
+        freeSlots.push_back(slot);
+        stats.timeouts++;
+        return {};
+    }
+    slot->refs.store(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.acquired++;
+        stats.outstanding++;
+        if (stats.outstanding > stats.maxOutstanding) {
+            stats.maxOutstanding = stats.outstanding;
+        }
+    }
+    return RawFrameRef(slot);
+}
+
+void RawFramePool::releaseSlot(RawFrameRef::Slot *slot) {
+    source->release(slot->frame);
+    std::lock_guard<std::mutex> lock(mutex);
+    freeSlots.push_back(slot);
+    stats.released++;
+    stats.outstanding--;
+    // 持有锁通知: 析构函数要等这里解锁才能返回，之后不再访问池
+    releasedCond.notify_all();
+}
+
+RawFramePoolStats RawFramePool::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stats;
+}
+
+int RawFramePool::getMaxOutstanding() const {
+    return maxOutstanding;
+}
@@ -0,0 +1,158 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "RawVideoFile.h"
+
+// 第 plane 个平面每行的字节数和行数(YUV420P 色度平面宽高向上取整)
+static void planeGeometry(FrameBufferFormat format, int plane, int width, int height, int *rowBytes, int *rows) {
+    if (format == FrameBuffer_YUV420P && plane > 0) {
+        *rowBytes = (width + 1) / 2;
+        *rows = (height + 1) / 2;
+        return;
+    }
+    *rowBytes = width * FrameBuffer::bytesPerPixel(format);
+    *rows = height;
+}
+
+static int planeCount(FrameBufferFormat format) {
+    return format == FrameBuffer_YUV420P ? 3 : 1;
+}
+
+size_t RawVideoReader::frameSize(FrameBufferFormat format, int width, int height) {
+    size_t size = 0;
+    for (int plane = 0; plane < planeCount(format); plane++) {
+        int rowBytes, rows;
+        planeGeometry(format, plane, width, height, &rowBytes, &rows);
+        size += (size_t) rowBytes * rows;
+    }
+    return size;
+}
+
+RawVideoReader::~RawVideoReader() {
+    close();
+}
+
+bool RawVideoReader::open(const char *path, FrameBufferFormat format, int width, int height) {
+    close();
+    if (width <= 0 || height <= 0) {
+        printf("RawVideoReader: invalid size %dx%d\n", width, height);
+        return false;
+    }
+    file = fopen(path, "rb");
+    if (file == nullptr) {
+        printf("RawVideoReader: open %s failed\n", path);
+        return false;
+    }
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    frameCount = (int) ((size_t) length / frameSize(format, width, height));
+    frameIndex = 0;
+    return true;
+}
+
+FrameBufferRef RawVideoReader::read(FrameBufferPool &pool) {
+    if (file == nullptr || frameCount == 0) {
+        return FrameBufferRef();
+    }
+    if (frameIndex == (uint64_t) frameCount) {
+        if (!loop) {
+            return FrameBufferRef();
+        }
+        fseek(file, 0, SEEK_SET);
+        frameIndex = 0;
+    }
+    FrameBufferRef buffer = pool.acquire(format, width, height);
+    if (!buffer) {
+        return buffer;
+    }
+    for (int plane = 0; plane < buffer->planeCount; plane++) {
+        int rowBytes, rows;
+        planeGeometry(format, plane, width, height, &rowBytes, &rows);
+        uint8_t *dst = buffer->planes[plane];
+        if (buffer->strides[plane] == rowBytes) {
+            // 没有行对齐时整个平面一次读完
+            if (fread(dst, 1, (size_t) rowBytes * rows, file) != (size_t) rowBytes * rows) {
+                printf("RawVideoReader: short read at frame %llu\n", (unsigned long long) frameIndex);
+                return FrameBufferRef();
+            }
+            continue;
+        }
+        for (int y = 0; y < rows; y++) {
+            if (fread(dst + (size_t) y * buffer->strides[plane], 1, rowBytes, file) != (size_t) rowBytes) {
+                printf("RawVideoReader: short read at frame %llu\n", (unsigned long long) frameIndex);
+                return FrameBufferRef();
+            }
+        }
+    }
+    buffer->seq = frameIndex++;
+    return buffer;
+}
+
+void RawVideoReader::setLoop(bool loop) {
+    this->loop = loop;
+}
+
+void RawVideoReader::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+    frameCount = 0;
+    frameIndex = 0;
+}
+
+int RawVideoReader::getFrameCount() const {
+    return frameCount;
+}
+
+RawVideoWriter::~RawVideoWriter() {
+    close();
+}
+
+bool RawVideoWriter::open(const char *path, FrameBufferFormat format, int width, int height) {
+    close();
+    file = fopen(path, "wb");
+    if (file == nullptr) {
+        printf("RawVideoWriter: open %s failed\n", path);
+        return false;
+    }
+    this->format = format;
+    this->width = width;
+    this->height = height;
+    return true;
+}
+
+bool RawVideoWriter::write(const FrameBuffer &buffer) {
+    if (file == nullptr) {
+        return false;
+    }
+    if (buffer.format != format || buffer.width != width || buffer.height != height) {
+        printf("RawVideoWriter: frame %s %dx%d does not match %s %dx%d\n", FrameBuffer::getFormatName(buffer.format),
+               buffer.width, buffer.height, FrameBuffer::getFormatName(format), width, height);
+        return false;
+    }
+    for (int plane = 0; plane < buffer.planeCount; plane++) {
+        int rowBytes, rows;
+        planeGeometry(format, plane, width, height, &rowBytes, &rows);
+        for (int y = 0; y < rows; y++) {
+            if (fwrite(buffer.planes[plane] + (size_t) y * buffer.strides[plane], 1, rowBytes, file) !=
+                (size_t) rowBytes) {
+                printf("RawVideoWriter: write failed\n");
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void RawVideoWriter::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
@@ -0,0 +1,38 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "RecordPacket.h"
+#include "DataEnc.h"
+
+int buildTilesPacket(const FrameDiffResult &diff, const uint8_t *pixels, int rowStride, std::vector<mbyte> &packet,
+                     CompressContext *context, CompressCodec codec) {
+    int width = diff.width, height = diff.height;
+    int mapLength = ((int) diff.dirty.size() + 7) / 8;
+    size_t tilePixels = 0;
+    if (diff.changed) {
+        tilePixels = FrameDiff::gatherTiles(diff.dirty, diff.tileSize, pixels, rowStride, width, height, 4, nullptr);
+    }
+    size_t dataSize = diff.changed ? RECORD_TILES_HEADER + mapLength + tilePixels : 0;
+    if (dataSize > (size_t) DataEnc::LENGTH_MASK) {
+        printf("tiles packet too large: %zu\n", dataSize);
+        return -1;
+    }
+    packet.resize(DataEnc::headerSize() + dataSize);
+    DataEnc dataEnc(packet.data(), (int) packet.size());
+    dataEnc.setCmd(diff.changed ? RecordPacket_Tiles : RecordPacket_Unchanged);
+    dataEnc.setCount(diff.dirtyTiles);
+    if (diff.changed) {
+        dataEnc.putInt(width).putInt(height).putInt(diff.tileSize).putInt(4).putInt(mapLength);
+        auto *payload = (uint8_t *) packet.data() + DataEnc::headerSize() + RECORD_TILES_HEADER;
+        FrameDiff::packDirtyMap(diff, payload, mapLength);
+        FrameDiff::gatherTiles(diff.dirty, diff.tileSize, pixels, rowStride, width, height, 4, payload + mapLength);
+    }
+    dataEnc.setDataIndex((int) dataSize);
+    if (context != nullptr && !dataEnc.compress(*context, codec)) {
+        return -1;
+    }
+    dataEnc.getData();
+    packet.resize((size_t) dataEnc.getDataLen());
+    return dataEnc.getDataLen();
+}
@@ -0,0 +1,141 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "RecordReceiver.h"
+#include "Profiler.h"
+#include <algorithm>
+
+static double elapsedMs(int64_t startNs) {
+    return (double) (Profiler::nowNs() - startNs) / 1000000.0;
+}
+
+bool RecordReceiver::hasH264Decoder() {
+#ifdef NATIVE_SURFACE_FFMPEG
+    return true;
+#else
+    return false;
+#endif
+}
+
+void RecordReceiver::resetStream() {
+    compress.resetStream();
+}
+
+ImageTexture &RecordReceiver::getTexture() {
+    return texture;
+}
+
+FrameBufferRef RecordReceiver::getCanvas() const {
+    return canvas;
+}
+
+RecordReceiverStats RecordReceiver::getStats() const {
+    return stats;
+}
+
+bool RecordReceiver::handlePacket(mbyte *packet, int length, RecordPacketTiming *timing) {
+    PROFILE_ZONE("RecordReceiver::handlePacket");
+    RecordPacketTiming local;
+    RecordPacketTiming &t = timing != nullptr ? *timing : local;
+    t = RecordPacketTiming();
+    if (length < DataDec::headerSize()) {
+        stats.errors++;
+        return false;
+    }
+    stats.packets++;
+    stats.bytes += (uint64_t) length;
+    dataDec.setData(packet, length);
+    int64_t start = Profiler::nowNs();
+    if (!dataDec.decompress(compress)) {
+        // 流模式的压缩状态已经和发送端不一致，之后的包只能重新开始
+        compress.resetStream();
+        stats.errors++;
+        return false;
+    }
+    t.decompressMs = elapsedMs(start);
+    mbyte *data = dataDec.getData();
+    int dataLength = DataDec::headerSize() + dataDec.getLength();
+    int cmd = dataDec.getCmd();
+    // 没有变化的帧不解码不上传，只重画上一帧
+    if (cmd == RecordPacket_Unchanged) {
+        stats.unchangedPackets++;
+        return true;
+    }
+    if (cmd == RecordPacket_Tiles) {
+        stats.tilesPackets++;
+        bool ok = applyTiles(data, dataLength, t);
+        if (!ok) {
+            stats.errors++;
+        }
+        return ok;
+    }
+    stats.h264Packets++;
+#ifdef NATIVE_SURFACE_FFMPEG
+    start = Profiler::nowNs();
+    decoder.decode((unsigned char *) (data + DataDec::headerSize()), (size_t) (dataLength - DataDec::headerSize()));
+    FrameBufferRef frame = decoder.getFrame();
+    t.decodeMs = elapsedMs(start);
+    if (frame) {
+        start = Profiler::nowNs();
+        texture.setFrame(frame);
+        t.uploadMs = elapsedMs(start);
+    }
+#else
+    stats.undecoded++;
+#endif
+    return true;
+}
+
+// 把脏块写进画布，只上传脏块的外接矩形
+bool RecordReceiver::applyTiles(mbyte *data, int length, RecordPacketTiming &timing) {
+    int64_t start = Profiler::nowNs();
+    DataDec tilesDec(data, length);
+    int width = tilesDec.getInt(), height = tilesDec.getInt(), tileSize = tilesDec.getInt();
+    int bytesPerPixel = tilesDec.getInt(), mapLength = tilesDec.getInt();
+    if (width <= 0 || height <= 0 || tileSize <= 0 || bytesPerPixel != 4 ||
+        mapLength < 0 || RECORD_TILES_HEADER + mapLength > length - DataDec::headerSize()) {
+        printf("bad tiles packet %dx%d tile %d\n", width, height, tileSize);
+        return false;
+    }
+    int tileCols = (width + tileSize - 1) / tileSize, tileRows = (height + tileSize - 1) / tileSize;
+    auto *map = (const uint8_t *) data + DataDec::headerSize() + RECORD_TILES_HEADER;
+    if (FrameDiff::unpackDirtyMap(map, mapLength, tileCols, tileRows, dirty) <= 0) {
+        return false;
+    }
+    if (!canvas || canvas->width != width || canvas->height != height) {
+        canvas = canvasPool.acquire(FrameBuffer_RGBA, width, height);
+        if (!canvas) {
+            return false;
+        }
+    }
+    size_t pixelLength = (size_t) (length - DataDec::headerSize() - RECORD_TILES_HEADER - mapLength);
+    if (FrameDiff::scatterTiles(dirty, tileSize, map + mapLength, pixelLength, canvas->planes[0],
+                                canvas->strides[0], width, height, 4) == 0) {
+        printf("tiles packet too short\n");
+        return false;
+    }
+    // 外接矩形
+    int minCol = tileCols, minRow = tileRows, maxCol = -1, maxRow = -1;
+    for (int row = 0; row < tileRows; row++) {
+        for (int col = 0; col < tileCols; col++) {
+            if (dirty[row * tileCols + col]) {
+                minCol = std::min(minCol, col);
+                maxCol = std::max(maxCol, col);
+                minRow = std::min(minRow, row);
+                maxRow = std::max(maxRow, row);
+            }
+        }
+    }
+    int64_t uploadStart = Profiler::nowNs();
+    int x = minCol * tileSize, y = minRow * tileSize;
+    int w = std::min(width, (maxCol + 1) * tileSize) - x, h = std::min(height, (maxRow + 1) * tileSize) - y;
+    bool ok = texture.updateRegion(ImageTexture_RGBA, canvas->planes[0], canvas->strides[0], x, y, w, h);
+    if (!ok) {
+        // 第一帧或尺寸变化，整幅上传
+        ok = texture.setFrame(canvas);
+    }
+    timing.decodeMs = (double) (uploadStart - start) / 1000000.0;
+    timing.uploadMs = elapsedMs(uploadStart);
+    return ok;
+}
@@ -0,0 +1,430 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "ScreenRecognizer.h"
+#include "Profiler.h"
+#include <opencv2/imgproc.hpp>
+#include <cmath>
+#include <cstdio>
+
+struct ScreenRecognizer::Template {
+    int id = -1;
+    std::string name;
+    float threshold = 0.0f;
+    cv::Rect region;
+    std::vector<cv::Mat> pyramid;       // CV_8U，0 为原图
+    cv::Mat zeroMean;                   // 原图去均值的模板(CV_32F)，用于原位置打分
+    double norm = 0.0;
+    int coarseLevel = 0;
+    cv::Mat coarseZeroMean;             // 粗搜索层去均值的模板(CV_32F)
+    double coarseNorm = 0.0;            // 去均值后的二范数
+    cv::Size spectrumSize;              // 缓存的频谱对应的DFT尺寸
+    cv::Mat spectrum;
+    // 上一帧的命中位置
+    bool tracking = false;
+    cv::Rect last;
+};
+
+struct ScreenRecognizer::Level {
+    cv::Mat image;                      // CV_8U 灰度
+    // 这一帧有模板需要粗搜索时才计算
+    bool prepared = false;
+    cv::Size dftSize;
+    cv::Mat padded;                     // CV_32F，补零到 dftSize
+    cv::Mat spectrum;                   // CCS 打包的实数DFT
+    cv::Mat sum;                        // 积分图(CV_64F)
+    cv::Mat sqsum;
+    // 每个模板复用的中间结果
+    cv::Mat product;
+    cv::Mat correlation;
+    cv::Mat score;
+
+    void prepare();
+};
+
+static double elapsedMs(int64_t start) {
+    return (double) (Profiler::nowNs() - start) / 1e6;
+}
+
+ScreenRecognizer::ScreenRecognizer(const ScreenRecognizerOptions &options) : options(options) {
+    if (this->options.levels < 1) {
+        this->options.levels = 1;
+    }
+}
+
+ScreenRecognizer::~ScreenRecognizer() = default;
+
+bool ScreenRecognizer::toGray(const cv::Mat &src, cv::Mat &gray) {
+    switch (src.type()) {
+        case CV_8UC1:
+            gray = src;
+            return true;
+        case CV_8UC3:
+            cv::cvtColor(src, gray, cv::COLOR_BGR2GRAY);
+            return true;
+        case CV_8UC4:
+            cv::cvtColor(src, gray, cv::COLOR_BGRA2GRAY);
+            return true;
+        default:
+            return false;
+    }
+}
+
+int ScreenRecognizer::addTemplate(const std::string &name, const cv::Mat &image, float threshold,
+                                  const cv::Rect &region) {
+    std::unique_ptr<Template> templ(new Template());
+    cv::Mat gray;
+    if (image.empty() || !toGray(image, gray)) {
+        printf("ScreenRecognizer: %s unsupported template type %d\n", name.c_str(), image.type());
+        stats.rejectedTemplates++;
+        return -1;
+    }
+    if (gray.cols < 4 || gray.rows < 4) {
+        printf("ScreenRecognizer: %s template too small %dx%d\n", name.c_str(), gray.cols, gray.rows);
+        stats.rejectedTemplates++;
+        return -1;
+    }
+    templ->pyramid.push_back(gray.clone());
+    // 缩小到最小边不小于 minCoarseSize 为止
+    while ((int) templ->pyramid.size() < options.levels) {
+        const cv::Mat &top = templ->pyramid.back();
+        if ((top.cols + 1) / 2 < options.minCoarseSize || (top.rows + 1) / 2 < options.minCoarseSize) {
+            break;
+        }
+        cv::Mat down;
+        cv::pyrDown(top, down);
+        templ->pyramid.push_back(down);
+    }
+    templ->coarseLevel = (int) templ->pyramid.size() - 1;
+    templ->pyramid[0].convertTo(templ->zeroMean, CV_32F);
+    templ->zeroMean -= cv::mean(templ->zeroMean)[0];
+    templ->norm = cv::norm(templ->zeroMean, cv::NORM_L2);
+    templ->pyramid.back().convertTo(templ->coarseZeroMean, CV_32F);
+    templ->coarseZeroMean -= cv::mean(templ->coarseZeroMean)[0];
+    templ->coarseNorm = cv::norm(templ->coarseZeroMean, cv::NORM_L2);
+    if (templ->coarseNorm < 1.0) {
+        // 纯色模板的相关系数没有意义
+        printf("ScreenRecognizer: %s template is flat\n", name.c_str());
+        stats.rejectedTemplates++;
+        return -1;
+    }
+    templ->id = nextId++;
+    templ->name = name;
+    templ->threshold = threshold > 0.0f ? threshold : options.threshold;
+    templ->region = region;
+    int id = templ->id;
+    templates.push_back(std::move(templ));
+    // 上一帧的结果不包含新模板，下一帧不能沿用
+    lastFrameSize = cv::Size();
+    return id;
+}
+
+void ScreenRecognizer::removeTemplate(int id) {
+    for (auto it = templates.begin(); it != templates.end(); ++it) {
+        if ((*it)->id == id) {
+            templates.erase(it);
+            lastFrameSize = cv::Size();
+            return;
+        }
+    }
+}
+
+int ScreenRecognizer::getTemplateCount() const {
+    return (int) templates.size();
+}
+
+void ScreenRecognizer::resetTracking() {
+    for (std::unique_ptr<Template> &templ: templates) {
+        templ->tracking = false;
+    }
+    lastFrameSize = cv::Size();
+}
+
+ScreenRecognizerStats ScreenRecognizer::getStats() const {
+    return stats;
+}
+
+const ScreenRecognizerOptions &ScreenRecognizer::getOptions() const {
+    return options;
+}
+
+void ScreenRecognizer::buildPyramid(const cv::Mat &gray) {
+    while ((int) levels.size() < options.levels) {
+        levels.emplace_back(new Level());
+    }
+    levels[0]->image = gray;
+    for (int i = 0; i < options.levels; i++) {
+        if (i > 0) {
+            // 和上一帧尺寸相同时 pyrDown 复用输出的内存
+            cv::pyrDown(levels[i - 1]->image, levels[i]->image);
+        }
+        levels[i]->prepared = false;
+    }
+}
+
+// 帧这一层的频谱和积分图，这一帧第一个需要的模板计算，之后所有模板共用
+void ScreenRecognizer::Level::prepare() {
+    dftSize = cv::Size(cv::getOptimalDFTSize(image.cols), cv::getOptimalDFTSize(image.rows));
+    padded.create(dftSize, CV_32F);
+    cv::Mat roi = padded(cv::Rect(0, 0, image.cols, image.rows));
+    image.convertTo(roi, CV_32F);
+    if (dftSize.width > image.cols) {
+        padded(cv::Rect(image.cols, 0, dftSize.width - image.cols, image.rows)).setTo(0);
+    }
+    if (dftSize.height > image.rows) {
+        padded(cv::Rect(0, image.rows, dftSize.width, dftSize.height - image.rows)).setTo(0);
+    }
+    cv::dft(padded, spectrum, 0, image.rows);
+    cv::integral(image, sum, sqsum, CV_64F, CV_64F);
+    prepared = true;
+}
+
+void ScreenRecognizer::prepareSpectrum(Template &templ, Level &level) {
+    if (templ.spectrumSize == level.dftSize && !templ.spectrum.empty()) {
+        return;
+    }
+    // 模板补零到帧的DFT尺寸，帧尺寸不变时一直复用
+    cv::Mat padded = cv::Mat::zeros(level.dftSize, CV_32F);
+    templ.coarseZeroMean.copyTo(padded(cv::Rect(0, 0, templ.coarseZeroMean.cols, templ.coarseZeroMean.rows)));
+    cv::dft(padded, templ.spectrum, 0, templ.coarseZeroMean.rows);
+    templ.spectrumSize = level.dftSize;
+}
+
+void ScreenRecognizer::coarseSearch(Template &templ, std::vector<cv::Point> &candidates) {
+    candidates.clear();
+    Level &level = *levels[templ.coarseLevel];
+    const cv::Mat &image = level.image;
+    int tw = templ.coarseZeroMean.cols;
+    int th = templ.coarseZeroMean.rows;
+    if (image.cols < tw || image.rows < th) {
+        return;
+    }
+    if (!level.prepared) {
+        level.prepare();
+        stats.frameSpectra++;
+    }
+    prepareSpectrum(templ, level);
+    stats.fftCorrelations++;
+
+    // 互相关: IDFT(F * conj(T))，左上角 (W-tw+1)x(H-th+1) 是有效区域(DFT尺寸不小于帧，不会回绕)
+    int rw = image.cols - tw + 1;
+    int rh = image.rows - th + 1;
+    cv::mulSpectrums(level.spectrum, templ.spectrum, level.product, 0, true);
+    cv::idft(level.product, level.correlation, cv::DFT_SCALE | cv::DFT_REAL_OUTPUT, rh);
+
+    // 归一化: R = sum(T' * I) / (|T'| * sqrt(sum(I^2) - sum(I)^2 / N))
+    double area = (double) tw * th;
+    level.score.create(rh, rw, CV_32F);
+    for (int y = 0; y < rh; y++) {
+        const float *corr = level.correlation.ptr<float>(y);
+        const double *s0 = level.sum.ptr<double>(y);
+        const double *s1 = level.sum.ptr<double>(y + th);
+        const double *q0 = level.sqsum.ptr<double>(y);
+        const double *q1 = level.sqsum.ptr<double>(y + th);
+        float *out = level.score.ptr<float>(y);
+        for (int x = 0; x < rw; x++) {
+            double sum = s1[x + tw] - s1[x] - s0[x + tw] + s0[x];
+            double sqsum = q1[x + tw] - q1[x] - q0[x + tw] + q0[x];
+            double variance = sqsum - sum * sum / area;
+            out[x] = variance > 1e-3 ? (float) (corr[x] / (templ.coarseNorm * std::sqrt(variance))) : 0.0f;
+        }
+    }
+
+    // 限定区域之外的位置不算
+    cv::Mat score = level.score;
+    cv::Point offset(0, 0);
+    if (templ.region.area() > 0) {
+        int scale = 1 << templ.coarseLevel;
+        cv::Rect region(templ.region.x / scale, templ.region.y / scale,
+                        (templ.region.width + scale - 1) / scale - tw + 1,
+                        (templ.region.height + scale - 1) / scale - th + 1);
+        region &= cv::Rect(0, 0, rw, rh);
+        if (region.area() <= 0) {
+            return;
+        }
+        score = level.score(region);
+        offset = region.tl();
+    }
+
+    // 取最高的几个峰，每取一个抑制周围半个模板大小的邻域
+    float coarseThreshold = templ.threshold - options.coarseSlack;
+    for (int i = 0; i < options.maxCandidates; i++) {
+        double maxValue;
+        cv::Point maxLoc;
+        cv::minMaxLoc(score, nullptr, &maxValue, nullptr, &maxLoc);
+        if (maxValue < coarseThreshold) {
+            break;
+        }
+        candidates.push_back(maxLoc + offset);
+        cv::Rect suppress(maxLoc.x - tw / 2, maxLoc.y - th / 2, tw, th);
+        score(suppress & cv::Rect(0, 0, score.cols, score.rows)).setTo(-1.0f);
+    }
+}
+
+bool ScreenRecognizer::refine(Template &templ, const cv::Rect &window, ScreenMatch &match) {
+    const cv::Mat &image = levels[0]->image;
+    const cv::Mat &full = templ.pyramid[0];
+    cv::Rect bounds(0, 0, image.cols, image.rows);
+    if (templ.region.area() > 0) {
+        bounds &= templ.region;
+    }
+    cv::Rect clipped = window & bounds;
+    if (clipped.width < full.cols || clipped.height < full.rows) {
+        return false;
+    }
+    stats.refinements++;
+    cv::Mat result;
+    cv::matchTemplate(image(clipped), full, result, cv::TM_CCOEFF_NORMED);
+    double maxValue;
+    cv::Point maxLoc;
+    cv::minMaxLoc(result, nullptr, &maxValue, nullptr, &maxLoc);
+    if ((float) maxValue > match.score) {
+        match.score = (float) maxValue;
+        match.rect = cv::Rect(clipped.x + maxLoc.x, clipped.y + maxLoc.y, full.cols, full.rows);
+    }
+    return maxValue >= templ.threshold;
+}
+
+// 模板放在 rect 上的相关系数(TM_CCOEFF_NORMED 的单个位置)
+float ScreenRecognizer::scoreAt(const Template &templ, const cv::Rect &rect) const {
+    const cv::Mat &image = levels[0]->image;
+    if ((rect & cv::Rect(0, 0, image.cols, image.rows)) != rect) {
+        return 0.0f;
+    }
+    double sum = 0.0, sqsum = 0.0, cross = 0.0;
+    for (int y = 0; y < rect.height; y++) {
+        const uint8_t *row = image.ptr<uint8_t>(rect.y + y) + rect.x;
+        const float *t = templ.zeroMean.ptr<float>(y);
+        float rowCross = 0.0f;
+        int rowSum = 0, rowSqsum = 0;
+        for (int x = 0; x < rect.width; x++) {
+            int value = row[x];
+            rowSum += value;
+            rowSqsum += value * value;
+            rowCross += t[x] * (float) value;
+        }
+        sum += rowSum;
+        sqsum += rowSqsum;
+        cross += rowCross;
+    }
+    double variance = sqsum - sum * sum / ((double) rect.width * rect.height);
+    return variance > 1e-3 ? (float) (cross / (templ.norm * std::sqrt(variance))) : 0.0f;
+}
+
+const std::vector<ScreenMatch> &ScreenRecognizer::recognize(const cv::Mat &frame) {
+    return recognize(frame, nullptr);
+}
+
+const std::vector<ScreenMatch> &ScreenRecognizer::recognize(const cv::Mat &frame, const FrameDiffResult *diff) {
+    PROFILE_ZONE("ScreenRecognizer::recognize");
+    int64_t start = Profiler::nowNs();
+    // 差异结果必须和这一帧同尺寸，上一帧的结果必须覆盖全部模板
+    bool reuse = diff != nullptr && !diff->reset && diff->width == frame.cols && diff->height == frame.rows &&
+                 frame.size() == lastFrameSize && results.size() == templates.size();
+    stats.lastPyramidMs = 0.0;
+    stats.lastCoarseMs = 0.0;
+    stats.lastRefineMs = 0.0;
+    if (reuse && !diff->changed) {
+        stats.frames++;
+        stats.skippedFrames++;
+        stats.lastTotalMs = elapsedMs(start);
+        return results;
+    }
+    std::vector<ScreenMatch> previous;
+    if (reuse) {
+        previous.swap(results);
+    }
+    results.clear();
+    lastFrameSize = cv::Size();
+    cv::Mat gray;
+    if (frame.empty() || !toGray(frame, gray)) {
+        printf("ScreenRecognizer: unsupported frame type %d\n", frame.type());
+        return results;
+    }
+    buildPyramid(gray);
+    lastFrameSize = frame.size();
+    stats.frames++;
+    stats.lastPyramidMs = elapsedMs(start);
+
+    std::vector<cv::Point> candidates;
+    for (size_t i = 0; i < templates.size(); i++) {
+        std::unique_ptr<Template> &templ = templates[i];
+        ScreenMatch match;
+        match.id = templ->id;
+        match.name = templ->name;
+        // 命中位置没有脏块时图标没有变化；没命中的模板只有限定区域里没有脏块时才能沿用
+        if (!previous.empty()) {
+            const ScreenMatch &last = previous[i];
+            const cv::Rect &area = last.found ? last.rect : templ->region;
+            if (area.area() > 0 && !diff->intersects(area.x, area.y, area.width, area.height)) {
+                stats.unchangedHits++;
+                results.push_back(last);
+                continue;
+            }
+        }
+        // 先看上一帧的位置，再在附近找
+        if (templ->tracking) {
+            int64_t roiStart = Profiler::nowNs();
+            float still = scoreAt(*templ, templ->last);
+            if (still >= options.stillScore && still >= templ->threshold) {
+                match.found = match.tracked = true;
+                match.score = still;
+                match.rect = templ->last;
+                stats.stillHits++;
+                stats.lastRefineMs += elapsedMs(roiStart);
+                results.push_back(match);
+                continue;
+            }
+            stats.roiSearches++;
+            cv::Rect window(templ->last.x - options.roiMargin, templ->last.y - options.roiMargin,
+                            templ->last.width + options.roiMargin * 2, templ->last.height + options.roiMargin * 2);
+            match.found = refine(*templ, window, match);
+            match.tracked = match.found;
+            if (match.found) {
+                stats.roiHits++;
+            }
+            stats.lastRefineMs += elapsedMs(roiStart);
+        }
+        if (!match.found) {
+            int64_t coarseStart = Profiler::nowNs();
+            stats.fullSearches++;
+            coarseSearch(*templ, candidates);
+            int64_t refineStart = Profiler::nowNs();
+            stats.lastCoarseMs += (double) (refineStart - coarseStart) / 1e6;
+            // 粗搜索层的一个像素对应原图 2^level 个像素，细化窗口多留一圈
+            int scale = 1 << templ->coarseLevel;
+            int margin = scale + 2;
+            for (const cv::Point &candidate: candidates) {
+                cv::Rect window(candidate.x * scale - margin, candidate.y * scale - margin,
+                                templ->pyramid[0].cols + margin * 2, templ->pyramid[0].rows + margin * 2);
+                if (refine(*templ, window, match)) {
+                    match.found = true;
+                }
+            }
+            stats.lastRefineMs += elapsedMs(refineStart);
+        }
+        templ->tracking = match.found;
+        if (match.found) {
+            templ->last = match.rect;
+        }
+        results.push_back(match);
+    }
+    stats.lastTotalMs = elapsedMs(start);
+    return results;
+}
+
+ScreenMatch ScreenRecognizer::matchFull(const cv::Mat &frameGray, const cv::Mat &templGray) {
+    ScreenMatch match;
+    if (frameGray.cols < templGray.cols || frameGray.rows < templGray.rows) {
+        return match;
+    }
+    cv::Mat result;
+    cv::matchTemplate(frameGray, templGray, result, cv::TM_CCOEFF_NORMED);
+    double maxValue;
+    cv::Point maxLoc;
+    cv::minMaxLoc(result, nullptr, &maxValue, nullptr, &maxLoc);
+    match.score = (float) maxValue;
+    match.rect = cv::Rect(maxLoc.x, maxLoc.y, templGray.cols, templGray.rows);
+    return match;
+}
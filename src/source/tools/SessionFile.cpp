@@ -0,0 +1,248 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "SessionFile.h"
+#include "ByteUtils.h"
+#include "TimeTools.h"
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+
+static const char SESSION_MAGIC[4] = {'N', 'S', 'S', 'N'};
+static const int SESSION_HEADER = 16;
+static const int RECORD_HEADER = 16;
+// 单条记录的上限(数据包接收缓冲是4M)，超过认为文件损坏
+static const int RECORD_MAX_LENGTH = 64 * 1024 * 1024;
+
+static int64_t monotonicUs() {
+    struct timespec ts{};
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+SessionWriter::~SessionWriter() {
+    close();
+}
+
+bool SessionWriter::open(const char *path) {
+    close();
+    std::lock_guard<std::mutex> lock(mutex);
+    file = fopen(path, "wb");
+    if (file == nullptr) {
+        printf("SessionWriter: open %s failed\n", path);
+        return false;
+    }
+    mbyte header[SESSION_HEADER];
+    memcpy(header, SESSION_MAGIC, 4);
+    ByteUtils::intToBytes(VERSION, header, 4);
+    ByteUtils::longToBytes(TimeTools::getCurrentTime(), header, 8);
+    if (fwrite(header, 1, SESSION_HEADER, file) != SESSION_HEADER) {
+        printf("SessionWriter: write %s failed\n", path);
+        fclose(file);
+        file = nullptr;
+        return false;
+    }
+    startUs = monotonicUs();
+    lastUs = 0;
+    records = 0;
+    return true;
+}
+
+bool SessionWriter::isOpen() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return file != nullptr;
+}
+
+int64_t SessionWriter::elapsedUs() const {
+    return monotonicUs() - startUs;
+}
+
+bool SessionWriter::write(int64_t timeUs, SessionRecordType type, const uint8_t *data, int length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr || length < 0 || length > RECORD_MAX_LENGTH) {
+        return false;
+    }
+    // 在锁里取时间，多个线程写入时文件里的时间也不会倒退
+    if (timeUs < 0) {
+        timeUs = elapsedUs();
+    }
+    timeUs = std::max(timeUs, lastUs);
+    lastUs = timeUs;
+    mbyte header[RECORD_HEADER];
+    ByteUtils::longToBytes(timeUs, header, 0);
+    ByteUtils::intToBytes(type, header, 8);
+    ByteUtils::intToBytes(length, header, 12);
+    if (fwrite(header, 1, RECORD_HEADER, file) != RECORD_HEADER ||
+        (length > 0 && fwrite(data, 1, (size_t) length, file) != (size_t) length)) {
+        printf("SessionWriter: write failed, recording stopped\n");
+        fclose(file);
+        file = nullptr;
+        return false;
+    }
+    records++;
+    return true;
+}
+
+bool SessionWriter::writePacket(const uint8_t *packet, int length, int64_t timeUs) {
+    return write(timeUs, SessionRecord_Packet, packet, length);
+}
+
+bool SessionWriter::writeTouch(const SessionTouchEvent *events, int count, int64_t timeUs) {
+    std::vector<mbyte> data((size_t) count * 8);
+    for (int i = 0; i < count; i++) {
+        ByteUtils::intToBytes((events[i].type << 16) | events[i].code, data.data(), i * 8);
+        ByteUtils::intToBytes(events[i].value, data.data(), i * 8 + 4);
+    }
+    return write(timeUs, SessionRecord_Touch, (const uint8_t *) data.data(), (int) data.size());
+}
+
+bool SessionWriter::writeDisplay(uint32_t width, uint32_t height, uint32_t orientation, int64_t timeUs) {
+    mbyte data[12];
+    ByteUtils::intToBytes((int) width, data, 0);
+    ByteUtils::intToBytes((int) height, data, 4);
+    ByteUtils::intToBytes((int) orientation, data, 8);
+    return write(timeUs, SessionRecord_Display, (const uint8_t *) data, sizeof(data));
+}
+
+bool SessionWriter::writeTouchDevice(int maxX, int maxY, int64_t timeUs) {
+    mbyte data[8];
+    ByteUtils::intToBytes(maxX, data, 0);
+    ByteUtils::intToBytes(maxY, data, 4);
+    return write(timeUs, SessionRecord_TouchDevice, (const uint8_t *) data, sizeof(data));
+}
+
+uint64_t SessionWriter::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return records;
+}
+
+void SessionWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+SessionReader::~SessionReader() {
+    close();
+}
+
+bool SessionReader::open(const char *path) {
+    close();
+    file = fopen(path, "rb");
+    if (file == nullptr) {
+        printf("SessionReader: open %s failed\n", path);
+        return false;
+    }
+    mbyte header[SESSION_HEADER];
+    if (fread(header, 1, SESSION_HEADER, file) != SESSION_HEADER || memcmp(header, SESSION_MAGIC, 4) != 0) {
+        printf("SessionReader: %s is not a session file\n", path);
+        close();
+        return false;
+    }
+    int version = ByteUtils::bytesToInt(header, 4);
+    if (version != SessionWriter::VERSION) {
+        printf("SessionReader: unsupported version %d\n", version);
+        close();
+        return false;
+    }
+    startTimeMs = ByteUtils::bytesToLong(header, 8);
+    lastTimeUs = 0;
+    corrupt = false;
+    return true;
+}
+
+bool SessionReader::next(SessionRecord &record) {
+    if (file == nullptr || corrupt) {
+        return false;
+    }
+    mbyte header[RECORD_HEADER];
+    size_t got = fread(header, 1, RECORD_HEADER, file);
+    if (got != RECORD_HEADER) {
+        // 录制中断时最后一条记录可能不完整
+        corrupt = got != 0;
+        return false;
+    }
+    int64_t timeUs = ByteUtils::bytesToLong(header, 0);
+    int type = ByteUtils::bytesToInt(header, 8);
+    int length = ByteUtils::bytesToInt(header, 12);
+    if (timeUs < lastTimeUs || type < SessionRecord_Packet || type > SessionRecord_TouchDevice || length < 0 ||
+        length > RECORD_MAX_LENGTH) {
+        printf("SessionReader: bad record type %d length %d at %lld us\n", type, length, (long long) timeUs);
+        corrupt = true;
+        return false;
+    }
+    record.timeUs = timeUs;
+    record.type = (SessionRecordType) type;
+    record.data.resize((size_t) length);
+    if (length > 0 && fread(record.data.data(), 1, (size_t) length, file) != (size_t) length) {
+        corrupt = true;
+        return false;
+    }
+    lastTimeUs = timeUs;
+    return true;
+}
+
+bool SessionReader::rewind() {
+    if (file == nullptr || fseek(file, SESSION_HEADER, SEEK_SET) != 0) {
+        return false;
+    }
+    lastTimeUs = 0;
+    corrupt = false;
+    return true;
+}
+
+bool SessionReader::isCorrupt() const {
+    return corrupt;
+}
+
+int64_t SessionReader::getStartTimeMs() const {
+    return startTimeMs;
+}
+
+void SessionReader::close() {
+    if (file != nullptr) {
+        fclose(file);
+        file = nullptr;
+    }
+}
+
+bool SessionReader::parseDisplay(const SessionRecord &record, uint32_t &width, uint32_t &height,
+                                 uint32_t &orientation) {
+    if (record.type != SessionRecord_Display || record.data.size() != 12) {
+        return false;
+    }
+    auto *data = (mbyte *) record.data.data();
+    width = (uint32_t) ByteUtils::bytesToInt(data, 0);
+    height = (uint32_t) ByteUtils::bytesToInt(data, 4);
+    orientation = (uint32_t) ByteUtils::bytesToInt(data, 8);
+    return true;
+}
+
+bool SessionReader::parseTouchDevice(const SessionRecord &record, int &maxX, int &maxY) {
+    if (record.type != SessionRecord_TouchDevice || record.data.size() != 8) {
+        return false;
+    }
+    auto *data = (mbyte *) record.data.data();
+    maxX = ByteUtils::bytesToInt(data, 0);
+    maxY = ByteUtils::bytesToInt(data, 4);
+    return true;
+}
+
+int SessionReader::parseTouch(const SessionRecord &record, std::vector<SessionTouchEvent> &events) {
+    if (record.type != SessionRecord_Touch || record.data.size() % 8 != 0) {
+        return -1;
+    }
+    auto *data = (mbyte *) record.data.data();
+    int count = (int) record.data.size() / 8;
+    events.resize((size_t) count);
+    for (int i = 0; i < count; i++) {
+        auto typeCode = (uint32_t) ByteUtils::bytesToInt(data, i * 8);
+        events[i].type = (uint16_t) (typeCode >> 16);
+        events[i].code = (uint16_t) typeCode;
+        events[i].value = ByteUtils::bytesToInt(data, i * 8 + 4);
+    }
+    return count;
+}
@@ -0,0 +1,390 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "SessionReplay.h"
+#include "FrameDiff.h"
+#include "RecordPacket.h"
+#include "Profiler.h"
+#include "draw.h"
+#include <linux/input.h>
+#include <sys/resource.h>
+#include <algorithm>
+#include <thread>
+#include <chrono>
+
+// 合成会话的触摸屏坐标范围
+static const int SYNTHETIC_TOUCH_RANGE = 10000;
+
+enum ReplayStage {
+    ReplayStage_Read = 0,
+    ReplayStage_Decompress,
+    ReplayStage_Decode,
+    ReplayStage_Upload,
+    ReplayStage_Render,
+    ReplayStage_Touch,
+    ReplayStage_Latency,
+    ReplayStage_Count
+};
+
+static const char *const REPLAY_STAGE_NAMES[ReplayStage_Count] = {
+        "read", "decompress", "decode", "upload", "render", "touch", "latency"
+};
+
+static double nsToMs(int64_t ns) {
+    return (double) ns / 1000000.0;
+}
+
+static double cpuTimeMs() {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return (double) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000.0 +
+           (double) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000.0;
+}
+
+static long peakRssKb() {
+    struct rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static long currentRssKb() {
+    FILE *fp = fopen("/proc/self/statm", "r");
+    if (fp == nullptr) {
+        return 0;
+    }
+    long pages = 0, resident = 0;
+    if (fscanf(fp, "%ld %ld", &pages, &resident) != 2) {
+        resident = 0;
+    }
+    fclose(fp);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+static ReplayStageStats stageStats(const char *name, std::vector<double> &values) {
+    ReplayStageStats stats;
+    stats.name = name;
+    stats.count = values.size();
+    if (values.empty()) {
+        return stats;
+    }
+    std::sort(values.begin(), values.end());
+    double sum = 0.0;
+    for (double v: values) {
+        sum += v;
+    }
+    auto at = [&values](double p) {
+        return values[(size_t) (p * (double) (values.size() - 1) + 0.5)];
+    };
+    stats.avgMs = sum / (double) values.size();
+    stats.p50Ms = at(0.5);
+    stats.p99Ms = at(0.99);
+    stats.maxMs = values.back();
+    return stats;
+}
+
+SessionReplay::SessionReplay(const SessionReplayOptions &options) : options(options) {
+}
+
+RecordReceiver &SessionReplay::getReceiver() {
+    return receiver;
+}
+
+bool SessionReplay::getLastTouch(ImGuInputEvent &event) const {
+    event = lastTouch;
+    return hasTouch;
+}
+
+void SessionReplay::renderFrame() {
+    drawBegin();
+    ImageTexture &texture = receiver.getTexture();
+    ImGui::Begin("replay");
+    ImVec2 size((float) texture.getWidth(), (float) texture.getHeight());
+    ImGui::SetWindowSize(ImVec2(size.x + 100, size.y + 100));
+    ImGui::Image((ImTextureID) texture.getOpenglTexture(), size);
+    ImGui::End();
+    drawEnd();
+}
+
+bool SessionReplay::run(const char *path, SessionReplayReport &report) {
+    PROFILE_ZONE("SessionReplay::run");
+    report = SessionReplayReport();
+    report.session = path;
+    report.speed = options.speed;
+    SessionReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+    std::vector<double> samples[ReplayStage_Count];
+    std::vector<SessionTouchEvent> touchEvents;
+    SessionRecord record;
+    uint32_t width = 0, height = 0, orientation = 0;
+    bool displayKnown = false;
+    double cpuStart = cpuTimeMs();
+    int64_t wallStart = Profiler::nowNs();
+    for (int loop = 0; loop < std::max(1, options.loops); loop++) {
+        if (loop > 0) {
+            reader.rewind();
+            receiver.resetStream();
+        }
+        touchParser.reset();
+        int64_t loopStart = Profiler::nowNs();
+        int64_t lastTimeUs = 0;
+        while (true) {
+            int64_t readStart = Profiler::nowNs();
+            if (!reader.next(record)) {
+                break;
+            }
+            int64_t readEnd = Profiler::nowNs();
+            samples[ReplayStage_Read].push_back(nsToMs(readEnd - readStart));
+            lastTimeUs = record.timeUs;
+            // 按录制的时间到达，最快模式下读到就算到达
+            int64_t arrival = readStart;
+            if (options.speed > 0.0) {
+                arrival = loopStart + (int64_t) ((double) record.timeUs * 1000.0 / options.speed);
+                int64_t wait = arrival - Profiler::nowNs();
+                if (wait > 0) {
+                    std::this_thread::sleep_for(std::chrono::nanoseconds(wait));
+                }
+            }
+            switch (record.type) {
+                case SessionRecord_Packet: {
+                    RecordPacketTiming timing;
+                    receiver.handlePacket((mbyte *) record.data.data(), (int) record.data.size(), &timing);
+                    samples[ReplayStage_Decompress].push_back(timing.decompressMs);
+                    samples[ReplayStage_Decode].push_back(timing.decodeMs);
+                    samples[ReplayStage_Upload].push_back(timing.uploadMs);
+                    if (options.render) {
+                        int64_t renderStart = Profiler::nowNs();
+                        renderFrame();
+                        samples[ReplayStage_Render].push_back(nsToMs(Profiler::nowNs() - renderStart));
+                    }
+                    samples[ReplayStage_Latency].push_back(nsToMs(Profiler::nowNs() - arrival));
+                    report.frames++;
+                    break;
+                }
+                case SessionRecord_Touch: {
+                    int count = SessionReader::parseTouch(record, touchEvents);
+                    if (count < 0) {
+                        break;
+                    }
+                    int64_t touchStart = Profiler::nowNs();
+                    touchParser.setDisplay(width, height, orientation);
+                    for (const SessionTouchEvent &e: touchEvents) {
+                        ImGuInputEvent event{};
+                        if (touchParser.push(e.type, e.code, e.value, event)) {
+                            OverlayLayer::dispatchInput(event);
+                            lastTouch = event;
+                            hasTouch = true;
+                            report.touchDispatched++;
+                        }
+                    }
+                    samples[ReplayStage_Touch].push_back(nsToMs(Profiler::nowNs() - touchStart));
+                    report.touchEvents += (uint64_t) count;
+                    break;
+                }
+                case SessionRecord_Display: {
+                    uint32_t w, h, o;
+                    if (SessionReader::parseDisplay(record, w, h, o) &&
+                        (!displayKnown || w != width || h != height || o != orientation)) {
+                        // 离屏窗口大小固定，屏幕信息只影响触摸坐标换算
+                        if (displayKnown) {
+                            report.displayChanges++;
+                        }
+                        width = w;
+                        height = h;
+                        orientation = o;
+                        displayKnown = true;
+                    }
+                    break;
+                }
+                case SessionRecord_TouchDevice: {
+                    int maxX, maxY;
+                    if (SessionReader::parseTouchDevice(record, maxX, maxY)) {
+                        touchParser.setTouchSize(ImVec2((float) maxX, (float) maxY));
+                    }
+                    break;
+                }
+            }
+        }
+        report.sessionMs += (double) lastTimeUs / 1000.0;
+        if (reader.isCorrupt()) {
+            report.corrupt = true;
+            break;
+        }
+    }
+    report.wallMs = nsToMs(Profiler::nowNs() - wallStart);
+    report.cpuMs = cpuTimeMs() - cpuStart;
+    report.cpuPercent = report.wallMs > 0.0 ? report.cpuMs * 100.0 / report.wallMs : 0.0;
+    report.fps = report.wallMs > 0.0 ? (double) report.frames * 1000.0 / report.wallMs : 0.0;
+    report.rssKb = currentRssKb();
+    report.peakRssKb = std::max(report.rssKb, peakRssKb());
+    report.receiver = receiver.getStats();
+    for (int stage = 0; stage < ReplayStage_Count; stage++) {
+        report.stages.push_back(stageStats(REPLAY_STAGE_NAMES[stage], samples[stage]));
+    }
+    return true;
+}
+
+void SessionReplay::printReport(const SessionReplayReport &report, FILE *out) {
+    const RecordReceiverStats &r = report.receiver;
+    char speed[32] = "max";
+    if (report.speed > 0.0) {
+        snprintf(speed, sizeof(speed), "%.2fx", report.speed);
+    }
+    fprintf(out, "session %s speed %s\n", report.session.c_str(), speed);
+    fprintf(out, "  frames %llu in %.1f ms (recorded %.1f ms) fps %.1f cpu %.1f ms (%.1f%%) rss %ld KB peak %ld KB\n",
+            (unsigned long long) report.frames, report.wallMs, report.sessionMs, report.fps, report.cpuMs,
+            report.cpuPercent, report.rssKb, report.peakRssKb);
+    fprintf(out, "  packets %llu (%.1f KB) h264 %llu tiles %llu unchanged %llu undecoded %llu errors %llu\n",
+            (unsigned long long) r.packets, (double) r.bytes / 1024.0, (unsigned long long) r.h264Packets,
+            (unsigned long long) r.tilesPackets, (unsigned long long) r.unchangedPackets,
+            (unsigned long long) r.undecoded, (unsigned long long) r.errors);
+    fprintf(out, "  touch events %llu dispatched %llu display changes %llu%s\n",
+            (unsigned long long) report.touchEvents, (unsigned long long) report.touchDispatched,
+            (unsigned long long) report.displayChanges, report.corrupt ? " (truncated)" : "");
+    fprintf(out, "  %-12s %8s %9s %9s %9s %9s\n", "stage", "count", "avg ms", "p50 ms", "p99 ms", "max ms");
+    for (const ReplayStageStats &stage: report.stages) {
+        fprintf(out, "  %-12s %8llu %9.3f %9.3f %9.3f %9.3f\n", stage.name.c_str(), (unsigned long long) stage.count,
+                stage.avgMs, stage.p50Ms, stage.p99Ms, stage.maxMs);
+    }
+    fflush(out);
+}
+
+bool SessionReplay::writeJson(const SessionReplayReport &report, const char *path) {
+    FILE *fp = fopen(path, "w");
+    if (fp == nullptr) {
+        printf("SessionReplay: open %s failed\n", path);
+        return false;
+    }
+    const RecordReceiverStats &r = report.receiver;
+    std::string session;
+    for (char c: report.session) {
+        if (c == '"' || c == '\\') {
+            session += '\\';
+        }
+        session += c;
+    }
+    fprintf(fp, "{\n  \"session\": \"%s\",\n  \"speed\": %.3f,\n  \"wall_ms\": %.3f,\n  \"session_ms\": %.3f,\n",
+            session.c_str(), report.speed, report.wallMs, report.sessionMs);
+    fprintf(fp, "  \"frames\": %llu,\n  \"fps\": %.3f,\n  \"cpu_ms\": %.3f,\n  \"cpu_percent\": %.3f,\n"
+                "  \"rss_kb\": %ld,\n  \"peak_rss_kb\": %ld,\n",
+            (unsigned long long) report.frames, report.fps, report.cpuMs, report.cpuPercent, report.rssKb,
+            report.peakRssKb);
+    fprintf(fp, "  \"packets\": %llu,\n  \"bytes\": %llu,\n  \"h264_packets\": %llu,\n  \"tiles_packets\": %llu,\n"
+                "  \"unchanged_packets\": %llu,\n  \"undecoded\": %llu,\n  \"errors\": %llu,\n",
+            (unsigned long long) r.packets, (unsigned long long) r.bytes, (unsigned long long) r.h264Packets,
+            (unsigned long long) r.tilesPackets, (unsigned long long) r.unchangedPackets,
+            (unsigned long long) r.undecoded, (unsigned long long) r.errors);
+    fprintf(fp, "  \"touch_events\": %llu,\n  \"touch_dispatched\": %llu,\n  \"display_changes\": %llu,\n"
+                "  \"truncated\": %s,\n  \"stages\": {\n",
+            (unsigned long long) report.touchEvents, (unsigned long long) report.touchDispatched,
+            (unsigned long long) report.displayChanges, report.corrupt ? "true" : "false");
+    for (size_t i = 0; i < report.stages.size(); i++) {
+        const ReplayStageStats &stage = report.stages[i];
+        fprintf(fp, "    \"%s\": {\"count\": %llu, \"avg_ms\": %.4f, \"p50_ms\": %.4f, \"p99_ms\": %.4f,"
+                    " \"max_ms\": %.4f}%s\n", stage.name.c_str(), (unsigned long long) stage.count, stage.avgMs,
+                stage.p50Ms, stage.p99Ms, stage.maxMs, i + 1 < report.stages.size() ? "," : "");
+    }
+    fprintf(fp, "  }\n}\n");
+    bool ok = ferror(fp) == 0;
+    fclose(fp);
+    return ok;
+}
+
+// 合成画面: 静止的背景，一个移动的方块(每4帧停一帧，产生没有变化的帧)，顶部每30帧变化一次的状态条
+static void drawSyntheticFrame(std::vector<uint8_t> &rgba, int width, int height, int frame) {
+    int step = frame - frame / 4;
+    for (int y = 0; y < height; y++) {
+        uint8_t *row = rgba.data() + (size_t) y * width * 4;
+        for (int x = 0; x < width; x++) {
+            row[x * 4] = (uint8_t) (x * 255 / width);
+            row[x * 4 + 1] = (uint8_t) (y * 255 / height);
+            row[x * 4 + 2] = (uint8_t) (((x >> 4) ^ (y >> 4)) & 1 ? 160 : 96);
+            row[x * 4 + 3] = 255;
+        }
+    }
+    auto fill = [&](int x0, int y0, int w, int h, uint8_t r, uint8_t g, uint8_t b) {
+        for (int y = std::max(0, y0); y < std::min(height, y0 + h); y++) {
+            uint8_t *row = rgba.data() + (size_t) y * width * 4;
+            for (int x = std::max(0, x0); x < std::min(width, x0 + w); x++) {
+                row[x * 4] = r;
+                row[x * 4 + 1] = g;
+                row[x * 4 + 2] = b;
+            }
+        }
+    };
+    int box = std::max(8, std::min(width, height) / 8);
+    int travel = std::max(1, width - box);
+    fill((step * 8) % travel, height / 3, box, box, (uint8_t) (step * 7), 40, (uint8_t) (255 - step * 3));
+    fill(0, 0, std::min(width, 96), std::min(height, 16), 255, (uint8_t) (step / 30 * 50), 0);
+}
+
+bool SessionReplay::writeSynthetic(const char *path, const SyntheticSessionConfig &config,
+                                   std::vector<uint8_t> *lastFrame) {
+    if (config.width <= 0 || config.height <= 0 || config.frames <= 0 || config.fps <= 0.0) {
+        printf("SessionReplay: bad synthetic config %dx%d %d frames\n", config.width, config.height, config.frames);
+        return false;
+    }
+    SessionWriter writer;
+    if (!writer.open(path)) {
+        return false;
+    }
+    // 记录的时间由帧号决定，和生成的速度无关
+    auto frameUs = (int64_t) (1000000.0 / config.fps);
+    bool ok = writer.writeDisplay((uint32_t) config.width, (uint32_t) config.height, 0, 0);
+    if (config.touch) {
+        ok = ok && writer.writeTouchDevice(SYNTHETIC_TOUCH_RANGE, SYNTHETIC_TOUCH_RANGE, 0);
+    }
+    std::vector<uint8_t> rgba((size_t) config.width * config.height * 4);
+    std::vector<mbyte> packet;
+    CompressContext compress;
+    FrameDiff frameDiff;
+    // 拖动手势: 第 downFrame 帧按下，从左到右移动，倒数第 downFrame 帧抬起
+    int downFrame = std::min(4, config.frames / 4), upFrame = config.frames - 1 - downFrame;
+    std::vector<SessionTouchEvent> events;
+    for (int frame = 0; frame < config.frames && ok; frame++) {
+        int64_t timeUs = frame * frameUs;
+        if (config.rotate && frame == config.frames / 2) {
+            ok = writer.writeDisplay((uint32_t) config.height, (uint32_t) config.width, 1, timeUs);
+        }
+        drawSyntheticFrame(rgba, config.width, config.height, frame);
+        const FrameDiffResult &diff = frameDiff.update(rgba.data(), config.width * 4, config.width, config.height, 4);
+        int length = buildTilesPacket(diff, rgba.data(), config.width * 4, packet,
+                                      config.codec != Compress_None ? &compress : nullptr, config.codec);
+        // 数据包在帧时间的后半段收完
+        ok = ok && length > 0 && writer.writePacket((const uint8_t *) packet.data(), length, timeUs + frameUs / 2);
+        if (!config.touch || frame < downFrame || frame > upFrame || upFrame <= downFrame) {
+            continue;
+        }
+        events.clear();
+        int x = SYNTHETIC_TOUCH_RANGE / 5 +
+                (SYNTHETIC_TOUCH_RANGE * 3 / 5) * (frame - downFrame) / (upFrame - downFrame);
+        int y = SYNTHETIC_TOUCH_RANGE / 2;
+        if (frame == downFrame) {
+            events.push_back({EV_ABS, ABS_MT_SLOT, 0});
+            events.push_back({EV_ABS, ABS_MT_TRACKING_ID, 1});
+        }
+        if (frame == upFrame) {
+            events.push_back({EV_ABS, ABS_MT_TRACKING_ID, -1});
+            events.push_back({EV_KEY, BTN_TOUCH, 0});
+        } else {
+            events.push_back({EV_ABS, ABS_MT_POSITION_X, x});
+            events.push_back({EV_ABS, ABS_MT_POSITION_Y, y});
+            if (frame == downFrame) {
+                events.push_back({EV_KEY, BTN_TOUCH, 1});
+            }
+        }
+        events.push_back({EV_SYN, SYN_REPORT, 0});
+        ok = writer.writeTouch(events.data(), (int) events.size(), timeUs + frameUs / 4);
+    }
+    writer.close();
+    if (!ok) {
+        printf("SessionReplay: write %s failed\n", path);
+        return false;
+    }
+    if (lastFrame != nullptr) {
+        lastFrame->swap(rgba);
+    }
+    return true;
+}
@@ -3,6 +3,7 @@
 //
 
 #include "TCPClient.h"
+#include "Profiler.h"
 
 #include <utility>
 
@@ -39,10 +40,12 @@ bool TCPClient::connect() {
 
 
 ssize_t TCPClient::send(const void *buff, int len, int flag) const {
+    PROFILE_ZONE("TCPClient::send");
     return ::send(tcp_fd, static_cast<const char *>(buff), len, flag);
 }
 
 ssize_t TCPClient::recv(void *buff, int len, int flag) const {
+    PROFILE_ZONE("TCPClient::recv");
     return ::recv(tcp_fd, static_cast<char *>(buff), len, flag);
 }
 
@@ -52,6 +55,7 @@ ssize_t TCPClient::recvo(void *buff, size_t len, int flag) const {
 
 
 ssize_t TCPClient::recvo(void *buff, int index, size_t len, int flag) const {
+    PROFILE_ZONE("TCPClient::recvo");
     auto *tempBuff = (unsigned char *) buff;
     int totalRecv = 0;
     int off = index;
@@ -3,6 +3,7 @@
 //
 
 #include "TCPServer.h"
+#include "Profiler.h"
 
 TCPServer::~TCPServer() {
     close();
@@ -35,6 +36,7 @@ TCPServer::TCPServer(int port) : port(port) {
 }
 
 TCPClient *TCPServer::accept() {
+    PROFILE_ZONE("TCPServer::accept");
     int newClient = ::accept(tcp_fd, nullptr, nullptr);
     if (-1 == newClient) {
         puts("acept error!");
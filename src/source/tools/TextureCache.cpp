@@ -0,0 +1,183 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "TextureCache.h"
+#include "Profiler.h"
+#include <imgui.h>
+#include <utility>
+
+TextureFrame TextureFrame::fromFrameBuffer(const FrameBufferRef &buffer) {
+    TextureFrame frame;
+    if (!buffer) {
+        return frame;
+    }
+    switch (buffer->format) {
+        case FrameBuffer_RGB24:
+            frame.format = ImageTexture_RGB;
+            break;
+        case FrameBuffer_BGR24:
+            frame.format = ImageTexture_BGR;
+            break;
+        case FrameBuffer_RGBA:
+            frame.format = ImageTexture_RGBA;
+            break;
+        case FrameBuffer_GRAY8:
+        case FrameBuffer_YUV420P:
+        default:
+            // YUV420P 只显示Y平面
+            frame.format = ImageTexture_GRAY;
+            break;
+    }
+    frame.pixels = buffer->planes[0];
+    frame.width = buffer->width;
+    frame.height = buffer->height;
+    frame.stride = buffer->strides[0];
+    frame.keepAlive = std::make_shared<FrameBufferRef>(buffer);
+    return frame;
+}
+
+TextureCache::~TextureCache() {
+    clear();
+}
+
+TextureCache::Window *TextureCache::findWindow(const std::string &name) {
+    for (std::unique_ptr<Window> &window: windows) {
+        if (!window->removed && window->name == name) {
+            return window.get();
+        }
+    }
+    return nullptr;
+}
+
+bool TextureCache::publish(const std::string &name, TextureFrame frame) {
+    // 被替换的帧在锁外释放(释放 FrameBufferRef 会进池的锁)
+    TextureFrame replaced;
+    const void *source = frame.source != nullptr ? frame.source : frame.pixels;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stats.published++;
+        Window *window = findWindow(name);
+        if (window == nullptr) {
+            windows.emplace_back(new Window());
+            window = windows.back().get();
+            window->name = name;
+        } else if (frame.version != 0 && source == window->lastSource && frame.version == window->lastVersion) {
+            stats.unchanged++;
+            return false;
+        }
+        if (window->dirty) {
+            stats.replaced++;
+        }
+        window->lastSource = source;
+        window->lastVersion = frame.version;
+        replaced = std::move(window->pending);
+        window->pending = std::move(frame);
+        window->dirty = true;
+    }
+    return true;
+}
+
+bool TextureCache::skipUnchanged(const std::string &name, const void *source, uint64_t version) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Window *window = findWindow(name);
+    if (version == 0 || window == nullptr || source != window->lastSource || version != window->lastVersion) {
+        return false;
+    }
+    stats.published++;
+    stats.unchanged++;
+    return true;
+}
+
+void TextureCache::remove(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Window *window = findWindow(name);
+    if (window != nullptr) {
+        window->removed = true;
+    }
+}
+
+int TextureCache::upload() {
+    PROFILE_ZONE("TextureCache::upload");
+    std::vector<std::pair<Window *, TextureFrame>> work;
+    std::vector<std::unique_ptr<Window>> removed;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (auto it = windows.begin(); it != windows.end();) {
+            Window *window = it->get();
+            if (window->removed) {
+                removed.push_back(std::move(*it));
+                it = windows.erase(it);
+                continue;
+            }
+            if (window->dirty) {
+                work.emplace_back(window, std::move(window->pending));
+                window->pending = TextureFrame();
+                window->dirty = false;
+            }
+            ++it;
+        }
+    }
+    // 纹理在渲染线程释放
+    removed.clear();
+    int uploads = 0;
+    for (auto &item: work) {
+        Window *window = item.first;
+        const TextureFrame &frame = item.second;
+        if (!window->texture) {
+            window->texture.reset(new ImageTexture());
+        }
+        // 同尺寸同格式时 ImageTexture 只更新内容
+        if (window->texture->setPixels(frame.format, frame.pixels, frame.width, frame.height, frame.stride)) {
+            window->width = frame.width;
+            window->height = frame.height;
+            uploads++;
+        }
+    }
+    work.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    stats.uploads += uploads;
+    return uploads;
+}
+
+void TextureCache::draw() {
+    std::vector<Window *> visible;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (std::unique_ptr<Window> &window: windows) {
+            if (!window->removed) {
+                visible.push_back(window.get());
+            }
+        }
+    }
+    for (Window *window: visible) {
+        if (!window->texture) {
+            continue;
+        }
+        ImGui::Begin(window->name.c_str());
+        ImGui::Image((ImTextureID) window->texture->getOpenglTexture(),
+                     ImVec2((float) window->width, (float) window->height));
+        ImGui::End();
+    }
+}
+
+void TextureCache::clear() {
+    std::vector<std::unique_ptr<Window>> old;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        old.swap(windows);
+    }
+}
+
+TextureCacheStats TextureCache::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    TextureCacheStats result = stats;
+    result.windows = (int) windows.size();
+    return result;
+}
+
+ImageTexture *TextureCache::getTexture(const std::string &name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    Window *window = findWindow(name);
+    return window != nullptr ? window->texture.get() : nullptr;
+}
@@ -0,0 +1,236 @@
+//
+// Created by fgsqme on 2026/10/19.
+//
+
+#include "ThreadPool.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <chrono>
+
+// 当前线程所属的池和编号(一个线程只属于一个池)
+static thread_local const ThreadPool *t_Pool = nullptr;
+static thread_local int t_WorkerIndex = -1;
+
+ThreadPool::ThreadPool(int threads) {
+    if (threads <= 0) {
+        threads = (int) std::thread::hardware_concurrency();
+        if (threads <= 0) {
+            threads = 1;
+        }
+    }
+    for (int i = 0; i < threads; i++) {
+        workers.emplace_back(new Worker());
+    }
+    for (int i = 0; i < threads; i++) {
+        workers[i]->thread = std::thread(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    sleepCond.notify_all();
+    for (std::unique_ptr<Worker> &worker: workers) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+int ThreadPool::currentWorker() const {
+    return t_Pool == this ? t_WorkerIndex : -1;
+}
+
+void ThreadPool::submit(std::function<void()> task) {
+    int self = currentWorker();
+    // 工作线程提交的任务留在自己的队列，其他线程提交的轮流分配
+    int index = self >= 0 ? self : (int) (nextWorker.fetch_add(1, std::memory_order_relaxed) % workers.size());
+    {
+        std::lock_guard<std::mutex> lock(workers[index]->mutex);
+        workers[index]->tasks.push_back(std::move(task));
+    }
+    submitted.fetch_add(1, std::memory_order_relaxed);
+    {
+        // 在 sleepMutex 下增加计数，工作线程检查计数和进入等待之间不会漏掉通知
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        pending.fetch_add(1, std::memory_order_release);
+    }
+    sleepCond.notify_one();
+}
+
+bool ThreadPool::popTask(int self, Task &task, bool *isStolen) {
+    int count = (int) workers.size();
+    if (self >= 0) {
+        Worker &own = *workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            *isStolen = false;
+            return true;
+        }
+    }
+    int start = self >= 0 ? self + 1 : 0;
+    for (int i = 0; i < count; i++) {
+        int victim = (start + i) % count;
+        if (victim == self) {
+            continue;
+        }
+        Worker &other = *workers[victim];
+        std::lock_guard<std::mutex> lock(other.mutex);
+        if (!other.tasks.empty()) {
+            task = std::move(other.tasks.front());
+            other.tasks.pop_front();
+            pending.fetch_sub(1, std::memory_order_relaxed);
+            *isStolen = self >= 0;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::execute(Task &task) {
+    task();
+    task = nullptr;
+    executed.fetch_add(1, std::memory_order_relaxed);
+}
+
+void ThreadPool::workerLoop(int index) {
+    t_Pool = this;
+    t_WorkerIndex = index;
+    char name[32];
+    snprintf(name, sizeof(name), "pool%d", index);
+    PROFILE_THREAD(name);
+    Task task;
+    while (true) {
+        bool isStolen = false;
+        if (popTask(index, task, &isStolen)) {
+            if (isStolen) {
+                stolen.fetch_add(1, std::memory_order_relaxed);
+            }
+            execute(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCond.wait(lock, [this] {
+            return stopping || pending.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && pending.load(std::memory_order_acquire) == 0) {
+            break;
+        }
+    }
+    t_Pool = nullptr;
+    t_WorkerIndex = -1;
+}
+
+bool ThreadPool::runOne() {
+    Task task;
+    bool isStolen = false;
+    int self = currentWorker();
+    if (!popTask(self, task, &isStolen)) {
+        return false;
+    }
+    if (isStolen) {
+        stolen.fetch_add(1, std::memory_order_relaxed);
+    }
+    helped.fetch_add(1, std::memory_order_relaxed);
+    execute(task);
+    return true;
+}
+
+void ThreadPool::parallelFor(int begin, int end, int grain, const std::function<void(int, int)> &fn) {
+    if (end <= begin) {
+        return;
+    }
+    if (grain < 1) {
+        grain = 1;
+    }
+    if (end - begin <= grain) {
+        fn(begin, end);
+        return;
+    }
+    TaskGroup group(*this);
+    // 第一段留给调用方自己执行，其余分给池
+    for (int start = begin + grain; start < end; start += grain) {
+        int stop = start + grain < end ? start + grain : end;
+        group.run([&fn, start, stop] {
+            fn(start, stop);
+        });
+    }
+    fn(begin, begin + grain);
+    group.wait();
+}
+
+void ThreadPool::parallelTiles(int width, int height, int tileWidth, int tileHeight,
+                               const std::function<void(const TileRect &)> &fn) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+    if (tileWidth <= 0 || tileWidth > width) {
+        tileWidth = width;
+    }
+    if (tileHeight <= 0 || tileHeight > height) {
+        tileHeight = height;
+    }
+    int columns = (width + tileWidth - 1) / tileWidth;
+    int rows = (height + tileHeight - 1) / tileHeight;
+    parallelFor(0, columns * rows, 1, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            TileRect tile;
+            tile.x0 = (i % columns) * tileWidth;
+            tile.y0 = (i / columns) * tileHeight;
+            tile.x1 = tile.x0 + tileWidth < width ? tile.x0 + tileWidth : width;
+            tile.y1 = tile.y0 + tileHeight < height ? tile.y0 + tileHeight : height;
+            fn(tile);
+        }
+    });
+}
+
+int ThreadPool::getThreadCount() const {
+    return (int) workers.size();
+}
+
+ThreadPoolStats ThreadPool::getStats() const {
+    ThreadPoolStats stats;
+    stats.submitted = submitted.load(std::memory_order_relaxed);
+    stats.executed = executed.load(std::memory_order_relaxed);
+    stats.stolen = stolen.load(std::memory_order_relaxed);
+    stats.helped = helped.load(std::memory_order_relaxed);
+    return stats;
+}
+
+TaskGroup::TaskGroup(ThreadPool &pool) : pool(pool) {
+}
+
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+void TaskGroup::run(std::function<void()> task) {
+    remaining.fetch_add(1, std::memory_order_relaxed);
+    pool.submit([this, task = std::move(task)] {
+        task();
+        // 在锁里减少计数，wait 返回(组被销毁)之前最后一个任务已经放开了锁
+        std::lock_guard<std::mutex> lock(mutex);
+        if (remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            cond.notify_all();
+        }
+    });
+}
+
+void TaskGroup::wait() {
+    while (remaining.load(std::memory_order_acquire) > 0) {
+        if (pool.runOne()) {
+            continue;
+        }
+        // 这组剩下的任务都在其他线程上执行，等通知；超时后再看看有没有新任务可以帮忙
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait_for(lock, std::chrono::milliseconds(1), [this] {
+            return remaining.load(std::memory_order_acquire) == 0;
+        });
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+}
@@ -18,6 +18,8 @@
 
 #include <ctime>
 #include <cstring>
+#include <sys/time.h>
+#include <sys/select.h>
 
 #endif
 
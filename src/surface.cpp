@@ -21,10 +21,14 @@ int main(int argc, char *argv[]) {
         drawBegin();
         static bool show_demo_window = false;
         static bool show_another_window = false;
+        static bool show_profiler_window = false;
 
         if (show_demo_window) {
             ImGui::ShowDemoWindow(&show_demo_window);
         }
+        if (show_profiler_window) {
+            Profiler::showWindow(&show_profiler_window);
+        }
         { // 2. Show a simple window that we create ourselves. We use a Begin/End pair to created a named window.
             static float f = 0.0f;
             static int counter = 0;
@@ -34,6 +38,7 @@ int main(int argc, char *argv[]) {
                     "This is some useful text.");               // Display some text (you can use a format strings too)
             ImGui::Checkbox("Demo Window", &show_demo_window);      // Edit bools storing our window open/close state
             ImGui::Checkbox("Another Window", &show_another_window);
+            ImGui::Checkbox("Profiler", &show_profiler_window);
             ImGui::SliderFloat("float", &f, 0.0f, 1.0f);            // Edit 1 float using a slider from 0.0f to 1.0f
             ImGui::ColorEdit4("clear color", (float *) &clear_color); // Edit 3 floats representing a color
             if (ImGui::Button("Button")) {
@@ -12,14 +12,13 @@ extern "C"
 #include "opencv2/core.hpp"
 #include "opencv2/imgproc.hpp"
 #include <opencv2/opencv.hpp>
+#include "ColorConvert.h"
 
 
 
 
 void AVFrame2Img(AVFrame *pFrame, cv::Mat &img);
 
-void Yuv420p2Rgb32(const uchar *yuvBuffer_in, const uchar *rgbBuffer_out, int width, int height);
-
 using namespace std;
 using namespace cv;
 
@@ -128,78 +127,22 @@ int main1(int argc, char *argv[]) {
     return 0;
 }
 
-void Yuv420p2Rgb32(const uchar *yuvBuffer_in, const uchar *rgbBuffer_out, int width, int height) {
-    uchar *yuvBuffer = (uchar *) yuvBuffer_in;
-    uchar *rgb32Buffer = (uchar *) rgbBuffer_out;
-
-    int channels = 3;
-
-    for (int y = 0; y < height; y++) {
-        for (int x = 0; x < width; x++) {
-            int index = y * width + x;
-
-            int indexY = y * width + x;
-            int indexU = width * height + y / 2 * width / 2 + x / 2;
-            int indexV = width * height + width * height / 4 + y / 2 * width / 2 + x / 2;
-
-            uchar Y = yuvBuffer[indexY];
-            uchar U = yuvBuffer[indexU];
-            uchar V = yuvBuffer[indexV];
-
-            int R = Y + 1.402 * (V - 128);
-            int G = Y - 0.34413 * (U - 128) - 0.71414 * (V - 128);
-            int B = Y + 1.772 * (U - 128);
-            R = (R < 0) ? 0 : R;
-            G = (G < 0) ? 0 : G;
-            B = (B < 0) ? 0 : B;
-            R = (R > 255) ? 255 : R;
-            G = (G > 255) ? 255 : G;
-            B = (B > 255) ? 255 : B;
-
-            rgb32Buffer[(y * width + x) * channels + 2] = uchar(R);
-            rgb32Buffer[(y * width + x) * channels + 1] = uchar(G);
-            rgb32Buffer[(y * width + x) * channels + 0] = uchar(B);
-        }
-    }
-}
-
 void AVFrame2Img(AVFrame *pFrame, cv::Mat &img) {
     int frameHeight = pFrame->height;
     int frameWidth = pFrame->width;
-    int channels = 3;
-    //输出图像分配内存
-    img = cv::Mat::zeros(frameHeight, frameWidth, CV_8UC3);
-    Mat output = cv::Mat::zeros(frameHeight, frameWidth, CV_8U);
-
-    //创建保存yuv数据的buffer
-    uchar *pDecodedBuffer = (uchar *) malloc(frameHeight * frameWidth * sizeof(uchar) * channels);
-
-    //从AVFrame中获取yuv420p数据，并保存到buffer
-    int i, j, k;
-    //拷贝y分量
-    for (i = 0; i < frameHeight; i++) {
-        memcpy(pDecodedBuffer + frameWidth * i,
-               pFrame->data[0] + pFrame->linesize[0] * i,
-               frameWidth);
-    }
-    //拷贝u分量
-    for (j = 0; j < frameHeight / 2; j++) {
-        memcpy(pDecodedBuffer + frameWidth * i + frameWidth / 2 * j,
-               pFrame->data[1] + pFrame->linesize[1] * j,
-               frameWidth / 2);
-    }
-    //拷贝v分量
-    for (k = 0; k < frameHeight / 2; k++) {
-        memcpy(pDecodedBuffer + frameWidth * i + frameWidth / 2 * j + frameWidth / 2 * k,
-               pFrame->data[2] + pFrame->linesize[2] * k,
-               frameWidth / 2);
-    }
+    //输出图像大小不变时 create 直接复用已有内存
+    static Mat output;
+    img.create(frameHeight, frameWidth, CV_8UC3);
+    output.create(frameHeight, frameWidth, CV_8U);
 
-    //将buffer中的yuv420p数据转换为RGB;
-    Yuv420p2Rgb32(pDecodedBuffer, img.data, frameWidth, frameHeight);
+    //直接按 linesize 读取AVFrame中的yuv420p平面转换为BGR，不再拷贝到中间buffer
+    ColorConvert::yuv420pToRgb(pFrame->data[0], pFrame->linesize[0],
+                               pFrame->data[1], pFrame->linesize[1],
+                               pFrame->data[2], pFrame->linesize[2],
+                               img.data, (int) img.step, frameWidth, frameHeight, ColorConvert_BGR);
 
     //简单处理，这里用了canny来进行二值化
-    cvtColor(img, output, COLOR_RGB2GRAY);
+    cvtColor(img, output, COLOR_BGR2GRAY);
     waitKey(2);
     Canny(img, output, 50, 50 * 2);
     waitKey(2);
@@ -207,8 +150,4 @@ void AVFrame2Img(AVFrame *pFrame, cv::Mat &img) {
     waitKey(10);
     // 测试函数
     // imwrite("test.jpg",img);
-    //释放buffer
-    free(pDecodedBuffer);
-    img.release();
-    output.release();
 }
\ No newline at end of file
@@ -22,12 +22,21 @@ int gzCompress(const char *src, int srcLen, char *dest, int destLen) {
         c_stream.next_out = (Bytef *) dest;
         c_stream.avail_out = destLen;
         while (c_stream.avail_in != 0 && c_stream.total_out < destLen) {
-            if (deflate(&c_stream, Z_NO_FLUSH) != Z_OK) return -1;
+            if (deflate(&c_stream, Z_NO_FLUSH) != Z_OK) {
+                deflateEnd(&c_stream);
+                return -1;
+            }
+        }
+        if (c_stream.avail_in != 0) {
+            deflateEnd(&c_stream);
+            return -1;
         }
-        if (c_stream.avail_in != 0) return c_stream.avail_in;
         for (;;) {
             if ((err = deflate(&c_stream, Z_FINISH)) == Z_STREAM_END) break;
-            if (err != Z_OK) return -1;
+            if (err != Z_OK) {
+                deflateEnd(&c_stream);
+                return -1;
+            }
         }
         if (deflateEnd(&c_stream) != Z_OK) return -1;
         return c_stream.total_out;
@@ -36,8 +45,8 @@ int gzCompress(const char *src, int srcLen, char *dest, int destLen) {
 }
 
 
-// gzDecompress: do the decompressing
-int gzDecompress(const char *src, int srcLen, const char *dst, int dstLen) {
+// gzDecompress: do the decompressing，成功返回解压后的字节数，失败返回zlib错误码(负数)
+int gzDecompress(const char *src, int srcLen, char *dst, int dstLen) {
     z_stream strm;
     strm.zalloc = NULL;
     strm.zfree = NULL;
@@ -56,13 +65,13 @@ int gzDecompress(const char *src, int srcLen, const char *dst, int dstLen) {
             ret = strm.total_out;
         } else {
             inflateEnd(&strm);
-            return err;
+            // 输出缓冲不够时 inflate 返回 Z_BUF_ERROR/Z_OK，都不是成功
+            return err < 0 ? err : Z_BUF_ERROR;
         }
     } else {
-        inflateEnd(&strm);
         return err;
     }
     inflateEnd(&strm);
-    return err;
+    return ret;
 }
 